@@ -74,13 +74,13 @@ bool qsc_acp_generate(uint8_t* output, size_t length)
 	if (res == false)
 	{
 		/* fall-back to system provider */
-		res = qsc_csp_generate(cust, sizeof(cust));
+		res = qsc_csp_pool_generate(cust, sizeof(cust));
 	}
 
 	if (res == true)
 	{
-		/* generate primary key using system random provider */
-		res = qsc_csp_generate(key, sizeof(key));
+		/* generate primary key using the batched system random provider */
+		res = qsc_csp_pool_generate(key, sizeof(key));
 	}
 
 	if (res == true)
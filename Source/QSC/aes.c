@@ -1,4 +1,5 @@
 #include "aes.h"
+#include "async.h"
 #include "intutils.h"
 #include "memutils.h"
 
@@ -83,6 +84,43 @@
 #	define HBA_NAME_SIZE 33ULL
 #endif
 
+/* ctr mode position */
+
+static size_t aes_ctr_resume(qsc_aes_state* state, uint8_t* output, const uint8_t* input, size_t length, bool bigendian)
+{
+	uint8_t tmpb[QSC_AES_BLOCK_SIZE] = { 0 };
+	size_t i;
+	size_t rlen;
+
+	rlen = 0;
+
+	if (state->position != 0 && length != 0)
+	{
+		/* finish the counter block that a seek positioned the stream within */
+		qsc_aes_ecb_encrypt_block(state, tmpb, state->nonce);
+		rlen = qsc_intutils_min(length, QSC_AES_BLOCK_SIZE - state->position);
+
+		for (i = 0; i < rlen; ++i)
+		{
+			output[i] = tmpb[state->position + i] ^ input[i];
+		}
+
+		if (bigendian == true)
+		{
+			qsc_intutils_be8increment(state->nonce, QSC_AES_BLOCK_SIZE);
+		}
+		else
+		{
+			qsc_intutils_le8increment(state->nonce, QSC_AES_BLOCK_SIZE);
+		}
+
+		state->position = 0;
+		qsc_memutils_clear(tmpb, sizeof(tmpb));
+	}
+
+	return rlen;
+}
+
 /* aes-ni and table-based fallback functions */
 
 #if defined(QSC_SYSTEM_AESNI_ENABLED)
@@ -278,6 +316,7 @@ void qsc_aes_initialize(qsc_aes_state* state, const qsc_aes_keyparams* keyparams
 		state->nonce = keyparams->nonce;
 	}
 
+	state->position = 0;
 	qsc_memutils_clear((uint8_t*)state->roundkeys, sizeof(state->roundkeys));
 
 	if (ctype == qsc_aes_cipher_256)
@@ -516,7 +555,8 @@ void qsc_aes_ctrbe_transform(qsc_aes_state* state, uint8_t* output, const uint8_
 	__m128i otp;
 	size_t oft;
 
-	oft = 0;
+	oft = aes_ctr_resume(state, output, input, length, true);
+	length -= oft;
 
 #if defined(QSC_SYSTEM_HAS_AVX512)
 
@@ -591,7 +631,9 @@ void qsc_aes_ctrbe_transform(qsc_aes_state* state, uint8_t* output, const uint8_
 		qsc_intutils_be8increment(state->nonce, QSC_AES_BLOCK_SIZE);
 
 		aes_encrypt_block(state, &otp, &nce);
-		inp = _mm_loadu_si128((const __m128i*)(input + oft));
+		/* load the partial block through the temp array, a full-width load would read past the input */
+		qsc_memutils_copy(tmpb, (input + oft), length);
+		inp = _mm_load_si128((const __m128i*)tmpb);
 		otp = _mm_xor_si128(inp, otp);
 
 		_mm_storeu_si128((__m128i*)tmpb, otp);
@@ -610,7 +652,8 @@ void qsc_aes_ctrle_transform(qsc_aes_state* state, uint8_t* output, const uint8_
 	__m128i otp;
 	size_t oft;
 
-	oft = 0;
+	oft = aes_ctr_resume(state, output, input, length, false);
+	length -= oft;
 
 #if defined(QSC_SYSTEM_HAS_AVX512)
 
@@ -681,7 +724,9 @@ void qsc_aes_ctrle_transform(qsc_aes_state* state, uint8_t* output, const uint8_
 		qsc_intutils_le8increment(state->nonce, QSC_AES_BLOCK_SIZE);
 
 		aes_encrypt_block(state, &otp, &nce);
-		inp = _mm_loadu_si128((const __m128i*)(input + oft));
+		/* load the partial block through the temp array, a full-width load would read past the input */
+		qsc_memutils_copy(tmpb, (input + oft), length);
+		inp = _mm_load_si128((const __m128i*)tmpb);
 		otp = _mm_xor_si128(inp, otp);
 
 		_mm_storeu_si128((__m128i*)tmpb, otp);
@@ -731,6 +776,7 @@ void qsc_aes_dispose(qsc_aes_state* state)
 		qsc_memutils_clear((uint8_t*)state->roundkeysw, sizeof(state->roundkeysw));
 #endif
 		state->roundkeylen = 0;
+		state->position = 0;
 	}
 }
 
@@ -1126,6 +1172,7 @@ void qsc_aes_initialize(qsc_aes_state* state, const qsc_aes_keyparams* keyparams
 		state->nonce = keyparams->nonce;
 	}
 
+	state->position = 0;
 	qsc_memutils_clear((uint8_t*)state->roundkeys, sizeof(state->roundkeys));
 
 	if (ctype == qsc_aes_cipher_256)
@@ -1251,18 +1298,21 @@ void qsc_aes_ctrbe_transform(qsc_aes_state* state, uint8_t* output, const uint8_
 	assert(input != NULL);
 	assert(output != NULL);
 
+	uint8_t tmpk[QSC_AES_BLOCK_SIZE] = { 0 };
 	size_t i;
 	size_t oft;
 
-	oft = 0;
+	oft = aes_ctr_resume(state, output, input, length, true);
+	length -= oft;
 
 	while (length >= QSC_AES_BLOCK_SIZE)
 	{
-		aes_encrypt_block(state, output + oft, state->nonce);
+		/* encrypt to a temporary block so the input and output may overlap */
+		aes_encrypt_block(state, tmpk, state->nonce);
 
 		for (i = 0; i < QSC_AES_BLOCK_SIZE; ++i)
 		{
-			output[oft + i] ^= input[oft + i];
+			output[oft + i] = tmpk[i] ^ input[oft + i];
 		}
 
 		qsc_intutils_be8increment(state->nonce, QSC_AES_BLOCK_SIZE);
@@ -1295,7 +1345,8 @@ void qsc_aes_ctrle_transform(qsc_aes_state* state, uint8_t* output, const uint8_
 	size_t i;
 	size_t oft;
 
-	oft = 0;
+	oft = aes_ctr_resume(state, output, input, length, false);
+	length -= oft;
 
 	while (length >= QSC_AES_BLOCK_SIZE)
 	{
@@ -1355,11 +1406,144 @@ void qsc_aes_dispose(qsc_aes_state* state)
 	{
 		qsc_memutils_clear((uint8_t*)state->roundkeys, sizeof(state->roundkeys));
 		state->roundkeylen = 0;
+		state->position = 0;
 	}
 }
 
 #endif
 
+/* parallel ctr mode */
+
+typedef struct
+{
+	const qsc_aes_state* state;				/* the caller's cipher state */
+	uint8_t* output;						/* the output array */
+	const uint8_t* input;					/* the input array */
+	size_t length;							/* the total number of bytes */
+	size_t chunk;							/* the number of bytes per thread */
+	bool done[QSC_ASYNC_PARALLEL_MAX];		/* the completed ranges */
+} aes_parallel_state;
+
+static void aes_ctrbe_parallel_task(void* context, size_t index)
+{
+	aes_parallel_state* pstate;
+	uint8_t nonce[QSC_AES_BLOCK_SIZE] = { 0 };
+	qsc_aes_state lstate;
+	size_t oft;
+
+	pstate = (aes_parallel_state*)context;
+	oft = index * pstate->chunk;
+
+	if (oft < pstate->length)
+	{
+		/* copy the round keys and start the counter at this range */
+		qsc_memutils_copy(&lstate, pstate->state, sizeof(qsc_aes_state));
+		qsc_memutils_copy(nonce, pstate->state->nonce, QSC_AES_BLOCK_SIZE);
+		qsc_intutils_be8add(nonce, QSC_AES_BLOCK_SIZE, (uint64_t)(oft / QSC_AES_BLOCK_SIZE));
+		lstate.nonce = nonce;
+
+		qsc_aes_ctrbe_transform(&lstate, pstate->output + oft, pstate->input + oft, qsc_intutils_min(pstate->chunk, pstate->length - oft));
+		qsc_memutils_secure_erase(&lstate, sizeof(qsc_aes_state));
+	}
+
+	pstate->done[index] = true;
+}
+
+void qsc_aes_ctrbe_transform_parallel(qsc_aes_state* state, uint8_t* output, const uint8_t* input, size_t length, size_t threads)
+{
+	assert(state != NULL);
+	assert(input != NULL);
+	assert(output != NULL);
+
+	aes_parallel_state pstate;
+	size_t nblk;
+	size_t oft;
+	size_t i;
+
+	if (state->position != 0)
+	{
+		/* finish the partial block left by a seek before dividing the input */
+		oft = qsc_intutils_min(length, QSC_AES_BLOCK_SIZE - state->position);
+		qsc_aes_ctrbe_transform(state, output, input, oft);
+		output += oft;
+		input += oft;
+		length -= oft;
+	}
+
+	if (threads == 0)
+	{
+		threads = qsc_async_processor_count();
+	}
+
+	threads = qsc_intutils_min(threads, length / QSC_ASYNC_PARALLEL_MINIMUM);
+	threads = qsc_intutils_min(threads, QSC_ASYNC_PARALLEL_MAX);
+
+	if (threads <= 1)
+	{
+		qsc_aes_ctrbe_transform(state, output, input, length);
+	}
+	else
+	{
+		qsc_memutils_clear(&pstate, sizeof(pstate));
+		nblk = (length + QSC_AES_BLOCK_SIZE - 1) / QSC_AES_BLOCK_SIZE;
+		pstate.state = state;
+		pstate.output = output;
+		pstate.input = input;
+		pstate.length = length;
+		pstate.chunk = ((nblk + threads - 1) / threads) * QSC_AES_BLOCK_SIZE;
+
+		qsc_async_parallel_for(&aes_ctrbe_parallel_task, &pstate, threads);
+
+		/* transform any range whose thread could not be launched */
+		for (i = 0; i < threads; ++i)
+		{
+			if (pstate.done[i] == false)
+			{
+				aes_ctrbe_parallel_task(&pstate, i);
+			}
+		}
+
+		/* leave the counter where a single call would have left it */
+		qsc_intutils_be8add(state->nonce, QSC_AES_BLOCK_SIZE, (uint64_t)nblk);
+	}
+}
+
+/* ctr mode seek */
+
+void qsc_aes_ctrbe_seek(qsc_aes_state* state, const uint8_t nonce[QSC_AES_BLOCK_SIZE], uint64_t offset)
+{
+	assert(state != NULL);
+	assert(nonce != NULL);
+
+	if (state != NULL && nonce != NULL)
+	{
+		if (state->nonce != nonce)
+		{
+			qsc_memutils_copy(state->nonce, nonce, QSC_AES_BLOCK_SIZE);
+		}
+
+		qsc_intutils_be8add(state->nonce, QSC_AES_BLOCK_SIZE, offset / QSC_AES_BLOCK_SIZE);
+		state->position = (size_t)(offset % QSC_AES_BLOCK_SIZE);
+	}
+}
+
+void qsc_aes_ctrle_seek(qsc_aes_state* state, const uint8_t nonce[QSC_AES_BLOCK_SIZE], uint64_t offset)
+{
+	assert(state != NULL);
+	assert(nonce != NULL);
+
+	if (state != NULL && nonce != NULL)
+	{
+		if (state->nonce != nonce)
+		{
+			qsc_memutils_copy(state->nonce, nonce, QSC_AES_BLOCK_SIZE);
+		}
+
+		qsc_intutils_le8add(state->nonce, QSC_AES_BLOCK_SIZE, offset / QSC_AES_BLOCK_SIZE);
+		state->position = (size_t)(offset % QSC_AES_BLOCK_SIZE);
+	}
+}
+
 /* pkcs7 padding */
 
 void qsc_pkcs7_add_padding(uint8_t* input, size_t length)
@@ -235,6 +235,7 @@ QSC_EXPORT_API typedef struct
 	size_t roundkeylen;				/*!< [size_t] Number of round-key elements */
 	size_t rounds;					/*!< [size_t] Number of transformation rounds */
 	uint8_t* nonce;					/*!< [uint8_t*] Pointer to the nonce or initialization vector */
+	size_t position;				/*!< [size_t] Byte offset within the current counter block, set by a ctr seek */
 } qsc_aes_state;
 
 /* Function Declarations */
@@ -373,6 +374,25 @@ QSC_EXPORT_API size_t qsc_pkcs7_padding_length(const uint8_t* input);
  */
 QSC_EXPORT_API void qsc_aes_ctrbe_transform(qsc_aes_state* state, uint8_t* output, const uint8_t* input, size_t length);
 
+/**
+ * \brief Transform data using AES in big-endian Counter (CTR) mode, dividing the work across threads.
+ *
+ * The input is split into contiguous ranges, and each thread transforms one range with a copy of the state
+ * whose counter is advanced to the start of that range. The output and the final counter are identical to
+ * a single call to qsc_aes_ctrbe_transform. Inputs smaller than QSC_ASYNC_PARALLEL_MINIMUM per thread use fewer threads.
+ *
+ * \param state:   [struct] Pointer to an initialized qsc_aes_state structure.
+ * \param output:  [uint8_t*] Pointer to the buffer where the transformed data will be stored.
+ * \param input:   [const uint8_t*] Pointer to the input data.
+ * \param length:  [size_t] Number of bytes to process.
+ * \param threads: [size_t] The maximum number of threads; zero uses one thread per processor core.
+ *
+ * \warning The state must be initialized by qsc_aes_initialize.
+ *
+ * \sa qsc_aes_ctrbe_transform
+ */
+QSC_EXPORT_API void qsc_aes_ctrbe_transform_parallel(qsc_aes_state* state, uint8_t* output, const uint8_t* input, size_t length, size_t threads);
+
 /**
  * \brief Transform data using AES in Counter (CTR) mode with Little Endian counter incrementation.
  *
@@ -389,6 +409,39 @@ QSC_EXPORT_API void qsc_aes_ctrbe_transform(qsc_aes_state* state, uint8_t* outpu
  */
 QSC_EXPORT_API void qsc_aes_ctrle_transform(qsc_aes_state* state, uint8_t* output, const uint8_t* input, size_t length);
 
+/**
+ * \brief Position a big endian Counter (CTR) mode key-stream at a byte offset.
+ *
+ * Sets the counter to the initial nonce plus the number of whole blocks in the offset, and the position
+ * within that block to the remainder. The next call to qsc_aes_ctrbe_transform begins at that byte of the key-stream,
+ * so a range of a message may be decrypted without generating the key-stream that precedes it.
+ *
+ * \param state:  [struct] Pointer to an initialized qsc_aes_state structure.
+ * \param nonce:  [const uint8_t*] The initial nonce the message was transformed with; copied to the state nonce.
+ * \param offset: [uint64_t] The byte offset into the key-stream.
+ *
+ * \warning The state must be initialized by qsc_aes_initialize.
+ *
+ * \sa qsc_aes_ctrbe_transform
+ */
+QSC_EXPORT_API void qsc_aes_ctrbe_seek(qsc_aes_state* state, const uint8_t nonce[QSC_AES_BLOCK_SIZE], uint64_t offset);
+
+/**
+ * \brief Position a little endian Counter (CTR) mode key-stream at a byte offset.
+ *
+ * Sets the counter to the initial nonce plus the number of whole blocks in the offset, and the position
+ * within that block to the remainder. The next call to qsc_aes_ctrle_transform begins at that byte of the key-stream.
+ *
+ * \param state:  [struct] Pointer to an initialized qsc_aes_state structure.
+ * \param nonce:  [const uint8_t*] The initial nonce the message was transformed with; copied to the state nonce.
+ * \param offset: [uint64_t] The byte offset into the key-stream.
+ *
+ * \warning The state must be initialized by qsc_aes_initialize.
+ *
+ * \sa qsc_aes_ctrle_transform
+ */
+QSC_EXPORT_API void qsc_aes_ctrle_seek(qsc_aes_state* state, const uint8_t nonce[QSC_AES_BLOCK_SIZE], uint64_t offset);
+
 /* ECB Mode */
 
 /**
@@ -2,6 +2,12 @@
 #include "cpuidex.h"
 #include "memutils.h"
 #include <stdlib.h>
+#if defined(QSC_SYSTEM_AVX_INTRINSICS)
+#   include "intrinsics.h"
+#endif
+#if defined(QSC_SYSTEM_OS_POSIX)
+#   include <sched.h>
+#endif
 
 #if defined(QSC_SYSTEM_OS_WINDOWS)
     /* Windows-specific thread function definitions */
@@ -50,8 +56,11 @@ bool qsc_async_parallel_for(void (*task)(void *context, size_t index), void* con
 
         if (threads != NULL && tasks != NULL)
         {
+            size_t count;
+
             qsc_memutils_clear(threads, nthreads * sizeof(qsc_thread));
             qsc_memutils_clear(tasks, nthreads * sizeof(async_thread_task_t));
+            count = 0;
             res = true;
 
             /* Process each task on a new thread */
@@ -76,10 +85,11 @@ bool qsc_async_parallel_for(void (*task)(void *context, size_t index), void* con
                     break;
                 }
 #endif
+                ++count;
             }
 
-            /* Wait for all threads to finish */
-            for (size_t i = 0; i < nthreads; ++i)
+            /* Wait for the launched threads to finish */
+            for (size_t i = 0; i < count; ++i)
             {
 #if defined(QSC_SYSTEM_OS_WINDOWS)
                 if (threads[i] != NULL)
@@ -100,6 +110,28 @@ bool qsc_async_parallel_for(void (*task)(void *context, size_t index), void* con
     return res;
 }
 
+int32_t qsc_async_atomic_load(volatile int32_t* value)
+{
+    assert(value != NULL);
+
+#if defined(QSC_SYSTEM_COMPILER_MSC)
+    return (int32_t)InterlockedCompareExchange((volatile LONG*)value, 0, 0);
+#else
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+void qsc_async_atomic_store(volatile int32_t* value, int32_t x)
+{
+    assert(value != NULL);
+
+#if defined(QSC_SYSTEM_COMPILER_MSC)
+    InterlockedExchange((volatile LONG*)value, (LONG)x);
+#else
+    __atomic_store_n(value, x, __ATOMIC_RELEASE);
+#endif
+}
+
 void qsc_async_launch_thread(void (*func)(void*), void* state)
 {
     assert(func != NULL);
@@ -221,6 +253,48 @@ size_t qsc_async_processor_count(void)
     return cpus;
 }
 
+void qsc_async_spinlock_lock(volatile int32_t* lock)
+{
+    assert(lock != NULL);
+
+    uint32_t spins;
+
+    spins = 0U;
+
+#if defined(QSC_SYSTEM_COMPILER_MSC)
+    while (InterlockedExchange((volatile LONG*)lock, 1) != 0)
+#else
+    while (__atomic_exchange_n(lock, 1, __ATOMIC_ACQUIRE) != 0)
+#endif
+    {
+        /* spin briefly, then yield so a preempted holder can finish */
+        ++spins;
+
+        if (spins < QSC_ASYNC_SPIN_LIMIT)
+        {
+#if defined(QSC_SYSTEM_AVX_INTRINSICS)
+            _mm_pause();
+#endif
+        }
+        else
+        {
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+            SwitchToThread();
+#elif defined(QSC_SYSTEM_OS_POSIX)
+            sched_yield();
+#endif
+            spins = 0U;
+        }
+    }
+}
+
+void qsc_async_spinlock_unlock(volatile int32_t* lock)
+{
+    assert(lock != NULL);
+
+    qsc_async_atomic_store(lock, 0);
+}
+
 qsc_thread qsc_async_thread_create(void (*func)(void*), void* state)
 {
     assert(func != NULL);
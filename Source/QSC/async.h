@@ -99,8 +99,40 @@ QSC_CPLUSPLUS_ENABLED_START
  */
 #define QSC_ASYNC_PARALLEL_MAX 128ULL
 
+/*!
+ * \def QSC_ASYNC_PARALLEL_MINIMUM
+ * \brief The minimum number of bytes assigned to each thread when a transform is split across threads.
+ */
+#define QSC_ASYNC_PARALLEL_MINIMUM 0x10000ULL
+
+/*!
+ * \def QSC_ASYNC_SPIN_LIMIT
+ * \brief The number of failed spin lock attempts before the waiting thread yields its time slice.
+ */
+#define QSC_ASYNC_SPIN_LIMIT 64U
+
 /* Function Declarations */
 
+/**
+ * \brief Atomically load a shared flag or counter.
+ *
+ * The load has acquire ordering; writes published by a matching qsc_async_atomic_store are visible after it returns.
+ *
+ * \param value:    [volatile int32_t*] Pointer to the shared value.
+ * \return          [int32_t] The current value.
+ */
+QSC_EXPORT_API int32_t qsc_async_atomic_load(volatile int32_t* value);
+
+/**
+ * \brief Atomically store a shared flag or counter.
+ *
+ * The store has release ordering; writes made before it are visible to a thread that loads the new value.
+ *
+ * \param value:    [volatile int32_t*] Pointer to the shared value.
+ * \param x:        [int32_t] The value to store.
+ */
+QSC_EXPORT_API void qsc_async_atomic_store(volatile int32_t* value, int32_t x);
+
 /**
  * \brief Launch a function on a new thread.
  *
@@ -177,6 +209,18 @@ QSC_EXPORT_API void qsc_async_mutex_unlock(qsc_mutex mtx);
  */
 QSC_EXPORT_API void qsc_async_mutex_unlock_ex(qsc_mutex mtx);
 
+/**
+ * \brief Run a task on a set of threads and wait for all of them to complete.
+ *
+ * The task is called once on each thread, with the shared context and the thread index (0 to nthreads-1).
+ *
+ * \param task:     [void (*)(void*, size_t)] Pointer to the task function.
+ * \param context:  [void*] Pointer to the context passed to every task.
+ * \param nthreads: [size_t] The number of threads to launch.
+ * \return          [bool] Returns true if every thread was launched; if false, the tasks that were launched have completed.
+ */
+QSC_EXPORT_API bool qsc_async_parallel_for(void (*task)(void* context, size_t index), void* context, size_t nthreads);
+
 /**
  * \brief Get the number of processor cores available.
  *
@@ -186,6 +230,23 @@ QSC_EXPORT_API void qsc_async_mutex_unlock_ex(qsc_mutex mtx);
  */
 QSC_EXPORT_API size_t qsc_async_processor_count(void);
 
+/**
+ * \brief Acquire a spin lock.
+ *
+ * Spins on the lock word, pausing between attempts, and yields the time slice after QSC_ASYNC_SPIN_LIMIT attempts
+ * so a preempted holder can finish. Intended for short critical sections; the lock word must be initialized to zero.
+ *
+ * \param lock:     [volatile int32_t*] Pointer to the lock word.
+ */
+QSC_EXPORT_API void qsc_async_spinlock_lock(volatile int32_t* lock);
+
+/**
+ * \brief Release a spin lock.
+ *
+ * \param lock:     [volatile int32_t*] Pointer to the lock word, acquired with qsc_async_spinlock_lock.
+ */
+QSC_EXPORT_API void qsc_async_spinlock_unlock(volatile int32_t* lock);
+
 /**
  * \brief Create a thread with one parameter.
  *
@@ -0,0 +1,698 @@
+#include "asyncio.h"
+#include "fileutils.h"
+#include "intutils.h"
+#include "memutils.h"
+
+#if defined(QSC_ASYNCIO_URING)
+#	include <linux/io_uring.h>
+#	include <sys/mman.h>
+#	include <sys/syscall.h>
+#	include <sys/uio.h>
+#	include <unistd.h>
+#endif
+
+/* the largest transfer the kernel performs in a single read or write */
+#define ASYNCIO_TRANSFER_MAX 0x7FFFF000ULL
+/* the number of opcode entries requested from the io_uring probe */
+#define ASYNCIO_PROBE_OPS 256ULL
+
+#if defined(QSC_ASYNCIO_URING)
+static int32_t asyncio_uring_setup(uint32_t entries, struct io_uring_params* params)
+{
+	return (int32_t)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int32_t asyncio_uring_enter(int32_t handle, uint32_t submit, uint32_t complete, uint32_t flags)
+{
+	return (int32_t)syscall(__NR_io_uring_enter, handle, submit, complete, flags, NULL, 0);
+}
+
+static int32_t asyncio_uring_register(int32_t handle, uint32_t opcode, const void* args, uint32_t count)
+{
+	return (int32_t)syscall(__NR_io_uring_register, handle, opcode, args, count);
+}
+
+static bool asyncio_uring_probe(const qsc_asyncio_state* state)
+{
+	/* the queued operations; read, write, send, and receive require kernel 5.6, on older kernels the ring is created but rejects them */
+	const uint8_t ops[] = { IORING_OP_READ, IORING_OP_WRITE, IORING_OP_READ_FIXED, IORING_OP_WRITE_FIXED, IORING_OP_RECV, IORING_OP_SEND };
+	struct io_uring_probe* prb;
+	size_t plen;
+	bool res;
+
+	res = false;
+	plen = sizeof(struct io_uring_probe) + (ASYNCIO_PROBE_OPS * sizeof(struct io_uring_probe_op));
+	prb = (struct io_uring_probe*)qsc_memutils_malloc(plen);
+
+	if (prb != NULL)
+	{
+		qsc_memutils_clear(prb, plen);
+
+		/* the probe itself is unavailable before kernel 5.6, which also selects the synchronous path */
+		if (asyncio_uring_register(state->handle, IORING_REGISTER_PROBE, prb, (uint32_t)ASYNCIO_PROBE_OPS) == 0)
+		{
+			res = true;
+
+			for (size_t i = 0; i < sizeof(ops); ++i)
+			{
+				if (ops[i] > prb->last_op || ops[i] >= prb->ops_len || (prb->ops[ops[i]].flags & IO_URING_OP_SUPPORTED) == 0)
+				{
+					res = false;
+					break;
+				}
+			}
+		}
+
+		qsc_memutils_alloc_free(prb);
+	}
+
+	return res;
+}
+
+static void asyncio_uring_destroy(qsc_asyncio_state* state)
+{
+	if (state->sqes != NULL)
+	{
+		munmap(state->sqes, state->sqelen);
+		state->sqes = NULL;
+	}
+
+	if (state->cqring != NULL)
+	{
+		munmap(state->cqring, state->cqrlen);
+		state->cqring = NULL;
+	}
+
+	if (state->sqring != NULL)
+	{
+		munmap(state->sqring, state->sqrlen);
+		state->sqring = NULL;
+	}
+
+	if (state->handle >= 0)
+	{
+		close(state->handle);
+		state->handle = -1;
+	}
+
+	state->uring = false;
+	state->fixed = false;
+}
+
+static bool asyncio_uring_create(qsc_asyncio_state* state)
+{
+	struct io_uring_params prms;
+	uint8_t* psq;
+	uint8_t* pcq;
+	bool res;
+
+	res = false;
+	qsc_memutils_clear(&prms, sizeof(prms));
+	state->handle = asyncio_uring_setup((uint32_t)state->entries, &prms);
+
+	if (state->handle >= 0)
+	{
+		state->sqrlen = prms.sq_off.array + (prms.sq_entries * sizeof(uint32_t));
+		state->cqrlen = prms.cq_off.cqes + (prms.cq_entries * sizeof(struct io_uring_cqe));
+		state->sqelen = prms.sq_entries * sizeof(struct io_uring_sqe);
+
+		psq = (uint8_t*)mmap(NULL, state->sqrlen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, state->handle, IORING_OFF_SQ_RING);
+		pcq = (uint8_t*)mmap(NULL, state->cqrlen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, state->handle, IORING_OFF_CQ_RING);
+		state->sqes = mmap(NULL, state->sqelen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, state->handle, IORING_OFF_SQES);
+		state->sqring = (psq != MAP_FAILED) ? psq : NULL;
+		state->cqring = (pcq != MAP_FAILED) ? pcq : NULL;
+		state->sqes = (state->sqes != MAP_FAILED) ? state->sqes : NULL;
+
+		if (state->sqring != NULL && state->cqring != NULL && state->sqes != NULL && asyncio_uring_probe(state) == true)
+		{
+			state->sqhead = (uint32_t*)(psq + prms.sq_off.head);
+			state->sqtail = (uint32_t*)(psq + prms.sq_off.tail);
+			state->sqarray = (uint32_t*)(psq + prms.sq_off.array);
+			state->sqmask = *(uint32_t*)(psq + prms.sq_off.ring_mask);
+			state->cqhead = (uint32_t*)(pcq + prms.cq_off.head);
+			state->cqtail = (uint32_t*)(pcq + prms.cq_off.tail);
+			state->cqmask = *(uint32_t*)(pcq + prms.cq_off.ring_mask);
+			state->cqes = pcq + prms.cq_off.cqes;
+
+			/* reserve a sparse fixed descriptor table, filled as descriptors are registered */
+			state->fixed = (asyncio_uring_register(state->handle, IORING_REGISTER_FILES, state->files, (uint32_t)QSC_ASYNCIO_REGISTER_MAX) == 0);
+			state->uring = true;
+			res = true;
+		}
+		else
+		{
+			asyncio_uring_destroy(state);
+		}
+	}
+
+	return res;
+}
+
+static bool asyncio_uring_queue(qsc_asyncio_state* state, uint8_t opcode, int32_t fd, uint8_t* buffer, size_t length, size_t position, size_t slot)
+{
+	struct io_uring_sqe* sqe;
+	uint32_t head;
+	uint32_t tail;
+	uint32_t idx;
+	bool res;
+
+	res = false;
+	tail = *state->sqtail;
+	head = __atomic_load_n(state->sqhead, __ATOMIC_ACQUIRE);
+
+	if (tail - head <= state->sqmask)
+	{
+		idx = tail & state->sqmask;
+		sqe = &((struct io_uring_sqe*)state->sqes)[idx];
+		qsc_memutils_clear(sqe, sizeof(struct io_uring_sqe));
+
+		sqe->opcode = opcode;
+		sqe->fd = fd;
+		sqe->addr = (uint64_t)(uintptr_t)buffer;
+		sqe->len = (uint32_t)qsc_intutils_min(length, ASYNCIO_TRANSFER_MAX);
+		sqe->off = (uint64_t)position;
+		sqe->user_data = (uint64_t)slot;
+
+		if (state->fixed == true)
+		{
+			for (size_t i = 0; i < state->fcount; ++i)
+			{
+				if (state->files[i] == fd)
+				{
+					sqe->fd = (int32_t)i;
+					sqe->flags |= IOSQE_FIXED_FILE;
+					break;
+				}
+			}
+		}
+
+		/* file transfers inside a registered buffer use the pinned pages */
+		if (opcode == IORING_OP_READ || opcode == IORING_OP_WRITE)
+		{
+			for (size_t i = 0; i < state->bcount; ++i)
+			{
+				if (buffer >= state->buffers[i] && buffer + sqe->len <= state->buffers[i] + state->buflens[i])
+				{
+					sqe->opcode = (opcode == IORING_OP_READ) ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+					sqe->buf_index = (uint16_t)i;
+					break;
+				}
+			}
+		}
+
+		state->sqarray[idx] = idx;
+		__atomic_store_n(state->sqtail, tail + 1, __ATOMIC_RELEASE);
+		res = true;
+	}
+
+	return res;
+}
+
+static size_t asyncio_uring_reap(qsc_asyncio_state* state, qsc_asyncio_completion* completions, size_t count)
+{
+	const struct io_uring_cqe* cqe;
+	const qsc_asyncio_request* preq;
+	uint32_t head;
+	uint32_t tail;
+	size_t res;
+
+	res = 0;
+	head = *state->cqhead;
+	tail = __atomic_load_n(state->cqtail, __ATOMIC_ACQUIRE);
+
+	while (head != tail && res < count)
+	{
+		cqe = &((const struct io_uring_cqe*)state->cqes)[head & state->cqmask];
+		preq = &state->requests[cqe->user_data];
+		completions[res].context = preq->context;
+		completions[res].operation = preq->operation;
+		completions[res].result = (int64_t)cqe->res;
+		state->slots[state->scount] = (size_t)cqe->user_data;
+		++state->scount;
+		--state->inflight;
+		++head;
+		++res;
+	}
+
+	__atomic_store_n(state->cqhead, head, __ATOMIC_RELEASE);
+
+	return res;
+}
+#endif
+
+static bool asyncio_queue(qsc_asyncio_state* state, qsc_asyncio_operations operation, FILE* fp, const qsc_socket* sock, uint8_t* buffer, size_t length, size_t position, void* context)
+{
+	qsc_asyncio_request* preq;
+	size_t slot;
+	bool res;
+
+	res = false;
+
+	if (state->queued + state->inflight < state->entries)
+	{
+#if defined(QSC_ASYNCIO_URING)
+		if (state->uring == true)
+		{
+			uint8_t opcode;
+			int32_t fd;
+
+			slot = state->slots[state->scount - 1];
+
+			if (fp != NULL)
+			{
+				opcode = (operation == qsc_asyncio_operation_file_read) ? IORING_OP_READ : IORING_OP_WRITE;
+				fd = fileno(fp);
+			}
+			else
+			{
+				opcode = (operation == qsc_asyncio_operation_socket_receive) ? IORING_OP_RECV : IORING_OP_SEND;
+				fd = (int32_t)sock->connection;
+			}
+
+			res = asyncio_uring_queue(state, opcode, fd, buffer, length, position, slot);
+
+			if (res == true)
+			{
+				--state->scount;
+			}
+		}
+		else
+#endif
+		{
+			/* the synchronous path executes requests in submission order */
+			slot = state->queued;
+			res = true;
+		}
+
+		if (res == true)
+		{
+			preq = &state->requests[slot];
+			preq->context = context;
+			preq->fp = fp;
+			preq->sock = sock;
+			preq->buffer = buffer;
+			preq->length = length;
+			preq->position = position;
+			preq->operation = operation;
+			++state->queued;
+		}
+	}
+
+	return res;
+}
+
+static int64_t asyncio_execute(const qsc_asyncio_request* preq)
+{
+	int64_t res;
+
+	switch (preq->operation)
+	{
+		case qsc_asyncio_operation_file_read:
+		{
+			res = (int64_t)qsc_fileutils_read((char*)preq->buffer, preq->length, preq->position, preq->fp);
+			break;
+		}
+		case qsc_asyncio_operation_file_write:
+		{
+			res = (int64_t)qsc_fileutils_write((const char*)preq->buffer, preq->length, preq->position, preq->fp);
+			break;
+		}
+		case qsc_asyncio_operation_socket_receive:
+		{
+			res = (int64_t)qsc_socket_receive(preq->sock, preq->buffer, preq->length, qsc_socket_receive_flag_none);
+			break;
+		}
+		case qsc_asyncio_operation_socket_send:
+		{
+			res = (int64_t)qsc_socket_send(preq->sock, preq->buffer, preq->length, qsc_socket_send_flag_none);
+			break;
+		}
+		default:
+		{
+			res = -1;
+		}
+	}
+
+	return res;
+}
+
+bool qsc_asyncio_initialize(qsc_asyncio_state* state, size_t entries)
+{
+	assert(state != NULL);
+	assert(entries != 0);
+
+	bool res;
+
+	res = false;
+
+	if (state != NULL && entries != 0)
+	{
+		qsc_memutils_clear(state, sizeof(qsc_asyncio_state));
+		state->handle = -1;
+		state->entries = qsc_intutils_min(entries, QSC_ASYNCIO_ENTRIES_MAX);
+
+		for (size_t i = 0; i < QSC_ASYNCIO_REGISTER_MAX; ++i)
+		{
+			state->files[i] = -1;
+		}
+
+		state->requests = (qsc_asyncio_request*)qsc_memutils_malloc(state->entries * sizeof(qsc_asyncio_request));
+		state->completions = (qsc_asyncio_completion*)qsc_memutils_malloc(state->entries * sizeof(qsc_asyncio_completion));
+		state->slots = (size_t*)qsc_memutils_malloc(state->entries * sizeof(size_t));
+
+		if (state->requests != NULL && state->completions != NULL && state->slots != NULL)
+		{
+			for (size_t i = 0; i < state->entries; ++i)
+			{
+				state->slots[i] = state->entries - 1 - i;
+			}
+
+			state->scount = state->entries;
+#if defined(QSC_ASYNCIO_URING)
+			asyncio_uring_create(state);
+#endif
+			res = true;
+		}
+		else
+		{
+			qsc_asyncio_dispose(state);
+		}
+	}
+
+	return res;
+}
+
+void qsc_asyncio_dispose(qsc_asyncio_state* state)
+{
+	assert(state != NULL);
+
+	if (state != NULL)
+	{
+#if defined(QSC_ASYNCIO_URING)
+		asyncio_uring_destroy(state);
+#endif
+
+		if (state->requests != NULL)
+		{
+			qsc_memutils_alloc_free(state->requests);
+		}
+
+		if (state->completions != NULL)
+		{
+			qsc_memutils_alloc_free(state->completions);
+		}
+
+		if (state->slots != NULL)
+		{
+			qsc_memutils_alloc_free(state->slots);
+		}
+
+		qsc_memutils_clear(state, sizeof(qsc_asyncio_state));
+		state->handle = -1;
+	}
+}
+
+bool qsc_asyncio_register_buffers(qsc_asyncio_state* state, uint8_t* const* buffers, const size_t* lengths, size_t count)
+{
+	assert(state != NULL);
+	assert(buffers != NULL);
+	assert(lengths != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (state != NULL && buffers != NULL && lengths != NULL && count <= QSC_ASYNCIO_REGISTER_MAX)
+	{
+		res = true;
+
+#if defined(QSC_ASYNCIO_URING)
+		if (state->uring == true)
+		{
+			struct iovec iov[QSC_ASYNCIO_REGISTER_MAX];
+
+			if (state->bcount != 0)
+			{
+				asyncio_uring_register(state->handle, IORING_UNREGISTER_BUFFERS, NULL, 0);
+				state->bcount = 0;
+			}
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				iov[i].iov_base = buffers[i];
+				iov[i].iov_len = lengths[i];
+			}
+
+			res = (count == 0 || asyncio_uring_register(state->handle, IORING_REGISTER_BUFFERS, iov, (uint32_t)count) == 0);
+		}
+#endif
+
+		if (res == true)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				state->buffers[i] = buffers[i];
+				state->buflens[i] = lengths[i];
+			}
+
+			state->bcount = count;
+		}
+	}
+
+	return res;
+}
+
+static bool asyncio_register_descriptor(qsc_asyncio_state* state, int32_t fd)
+{
+	bool res;
+
+	res = false;
+
+	if (state->fcount < QSC_ASYNCIO_REGISTER_MAX && fd >= 0)
+	{
+		res = true;
+
+#if defined(QSC_ASYNCIO_URING)
+		if (state->fixed == true)
+		{
+			struct io_uring_files_update upd;
+
+			qsc_memutils_clear(&upd, sizeof(upd));
+			upd.offset = (uint32_t)state->fcount;
+			upd.fds = (uint64_t)(uintptr_t)&fd;
+			res = (asyncio_uring_register(state->handle, IORING_REGISTER_FILES_UPDATE, &upd, 1) == 1);
+		}
+#endif
+
+		if (res == true)
+		{
+			state->files[state->fcount] = fd;
+			++state->fcount;
+		}
+	}
+
+	return res;
+}
+
+bool qsc_asyncio_register_file(qsc_asyncio_state* state, FILE* fp)
+{
+	assert(state != NULL);
+	assert(fp != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (state != NULL && fp != NULL)
+	{
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+		res = asyncio_register_descriptor(state, (int32_t)_fileno(fp));
+#else
+		res = asyncio_register_descriptor(state, (int32_t)fileno(fp));
+#endif
+	}
+
+	return res;
+}
+
+bool qsc_asyncio_register_socket(qsc_asyncio_state* state, const qsc_socket* sock)
+{
+	assert(state != NULL);
+	assert(sock != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (state != NULL && sock != NULL)
+	{
+		res = asyncio_register_descriptor(state, (int32_t)sock->connection);
+	}
+
+	return res;
+}
+
+bool qsc_asyncio_file_read(qsc_asyncio_state* state, FILE* fp, uint8_t* output, size_t length, size_t position, void* context)
+{
+	assert(state != NULL);
+	assert(fp != NULL);
+	assert(output != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (state != NULL && fp != NULL && output != NULL && length != 0)
+	{
+		res = asyncio_queue(state, qsc_asyncio_operation_file_read, fp, NULL, output, length, position, context);
+	}
+
+	return res;
+}
+
+bool qsc_asyncio_file_write(qsc_asyncio_state* state, FILE* fp, const uint8_t* input, size_t length, size_t position, void* context)
+{
+	assert(state != NULL);
+	assert(fp != NULL);
+	assert(input != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (state != NULL && fp != NULL && input != NULL && length != 0)
+	{
+		res = asyncio_queue(state, qsc_asyncio_operation_file_write, fp, NULL, (uint8_t*)input, length, position, context);
+	}
+
+	return res;
+}
+
+bool qsc_asyncio_socket_receive(qsc_asyncio_state* state, const qsc_socket* sock, uint8_t* output, size_t length, void* context)
+{
+	assert(state != NULL);
+	assert(sock != NULL);
+	assert(output != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (state != NULL && sock != NULL && output != NULL && length != 0)
+	{
+		res = asyncio_queue(state, qsc_asyncio_operation_socket_receive, NULL, sock, output, length, 0, context);
+	}
+
+	return res;
+}
+
+bool qsc_asyncio_socket_send(qsc_asyncio_state* state, const qsc_socket* sock, const uint8_t* input, size_t length, void* context)
+{
+	assert(state != NULL);
+	assert(sock != NULL);
+	assert(input != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (state != NULL && sock != NULL && input != NULL && length != 0)
+	{
+		res = asyncio_queue(state, qsc_asyncio_operation_socket_send, NULL, sock, (uint8_t*)input, length, 0, context);
+	}
+
+	return res;
+}
+
+size_t qsc_asyncio_submit(qsc_asyncio_state* state)
+{
+	assert(state != NULL);
+
+	size_t res;
+
+	res = 0;
+
+	if (state != NULL && state->queued != 0)
+	{
+#if defined(QSC_ASYNCIO_URING)
+		if (state->uring == true)
+		{
+			int32_t cnt;
+
+			cnt = asyncio_uring_enter(state->handle, (uint32_t)state->queued, 0, 0);
+
+			if (cnt > 0)
+			{
+				res = (size_t)cnt;
+			}
+		}
+		else
+#endif
+		{
+			size_t pos;
+
+			for (size_t i = 0; i < state->queued; ++i)
+			{
+				pos = (state->chead + state->inflight + i) % state->entries;
+				state->completions[pos].context = state->requests[i].context;
+				state->completions[pos].operation = state->requests[i].operation;
+				state->completions[pos].result = asyncio_execute(&state->requests[i]);
+			}
+
+			res = state->queued;
+		}
+
+		state->queued -= res;
+		state->inflight += res;
+	}
+
+	return res;
+}
+
+size_t qsc_asyncio_wait(qsc_asyncio_state* state, qsc_asyncio_completion* completions, size_t count, size_t minimum)
+{
+	assert(state != NULL);
+	assert(completions != NULL);
+
+	size_t res;
+
+	res = 0;
+
+	if (state != NULL && completions != NULL && count != 0)
+	{
+		qsc_asyncio_submit(state);
+		minimum = qsc_intutils_min(qsc_intutils_min(minimum, count), state->inflight);
+
+#if defined(QSC_ASYNCIO_URING)
+		if (state->uring == true)
+		{
+			while (true)
+			{
+				res += asyncio_uring_reap(state, completions + res, count - res);
+
+				if (res >= minimum)
+				{
+					break;
+				}
+
+				if (asyncio_uring_enter(state->handle, 0, (uint32_t)(minimum - res), IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+				{
+					break;
+				}
+			}
+		}
+		else
+#endif
+		{
+			while (res < count && state->inflight != 0)
+			{
+				completions[res] = state->completions[state->chead];
+				state->chead = (state->chead + 1) % state->entries;
+				--state->inflight;
+				++res;
+			}
+		}
+	}
+
+	return res;
+}
@@ -0,0 +1,325 @@
+/*
+ * 2025 Quantum Resistant Cryptographic Solutions Corporation
+ * All Rights Reserved.
+ *
+ * NOTICE: This software and all accompanying materials are the exclusive 
+ * property of Quantum Resistant Cryptographic Solutions Corporation (QRCS).
+ * The intellectual and technical concepts contained within this implementation 
+ * are proprietary to QRCS and its authorized licensors and are protected under 
+ * applicable U.S. and international copyright, patent, and trade secret laws.
+ *
+ * CRYPTOGRAPHIC STANDARDS:
+ * - This software includes implementations of cryptographic algorithms such as 
+ *   SHA3, AES, and others. These algorithms are public domain or standardized 
+ *   by organizations such as NIST and are NOT the property of QRCS.
+ * - However, all source code, optimizations, and implementations in this library 
+ *   are original works of QRCS and are protected under this license.
+ *
+ * RESTRICTIONS:
+ * - Redistribution, modification, or unauthorized distribution of this software, 
+ *   in whole or in part, is strictly prohibited.
+ * - This software is provided for non-commercial, educational, and research 
+ *   purposes only. Commercial use in any form is expressly forbidden.
+ * - Licensing and authorized distribution are solely at the discretion of QRCS.
+ * - Any use of this software implies acceptance of these restrictions.
+ *
+ * DISCLAIMER:
+ * This software is provided "as is," without warranty of any kind, express or 
+ * implied, including but not limited to warranties of merchantability or fitness 
+ * for a particular purpose. QRCS disclaims all liability for any direct, indirect, 
+ * incidental, or consequential damages resulting from the use or misuse of this software.
+ *
+ * FULL LICENSE:
+ * This software is subject to the **Quantum Resistant Cryptographic Solutions 
+ * Proprietary License (QRCS-PL)**. The complete license terms are included 
+ * in the LICENSE.txt file distributed with this software.
+ *
+ * Written by: John G. Underhill
+ * Contact: john.underhill@protonmail.com
+ */
+
+#ifndef QSC_ASYNCIO_H
+#define QSC_ASYNCIO_H
+
+#include "common.h"
+#include "socketbase.h"
+#include <stdio.h>
+
+QSC_CPLUSPLUS_ENABLED_START
+
+/**
+ * \file asyncio.h
+ * \brief Asynchronous completion based socket and file I/O.
+ *
+ * \details
+ * This header defines a completion API for batching socket and file transfers. Operations are queued
+ * with the read, write, send, and receive functions, handed to the kernel in one call with qsc_asyncio_submit,
+ * and their results collected with qsc_asyncio_wait. Each operation carries a caller supplied context pointer
+ * that is returned with its completion record.
+ *
+ * On Linux the queue is an io_uring instance: requests are written to a shared submission ring, and results
+ * are read from the completion ring without a system call per operation. Buffers registered with
+ * qsc_asyncio_register_buffers are pinned by the kernel, and file reads and writes that fall inside a registered buffer
+ * use the fixed-buffer operations. Files and sockets registered with qsc_asyncio_register_file and qsc_asyncio_register_socket
+ * are referenced through the fixed descriptor table, avoiding the descriptor lookup on every request.
+ * Registration is an optimization only; unregistered buffers and descriptors are accepted by every operation.
+ *
+ * If io_uring is not available (restricted containers, or other operating systems), or the kernel does not support
+ * every queued operation (the opcodes are probed when the queue is created, and require kernel 5.6 or later), the same API
+ * runs each queued operation synchronously on submit, using the blocking socket and file functions.
+ * The qsc_asyncio_state.uring member reports which path is active.
+ *
+ * File operations address the file by position and bypass the stdio stream buffer;
+ * flush a FILE stream before queuing operations on it, and do not mix buffered and queued I/O on the same stream.
+ * Buffers must remain valid until the operation's completion has been returned by qsc_asyncio_wait.
+ *
+ * \code
+ * qsc_asyncio_state io;
+ * qsc_asyncio_completion cmp[2];
+ *
+ * if (qsc_asyncio_initialize(&io, 64) == true)
+ * {
+ *     qsc_asyncio_file_read(&io, fp, block, sizeof(block), 0, &ctx1);
+ *     qsc_asyncio_socket_send(&io, &sock, header, sizeof(header), &ctx2);
+ *     qsc_asyncio_submit(&io);
+ *
+ *     // wait for both operations to complete
+ *     qsc_asyncio_wait(&io, cmp, 2, 2);
+ *     qsc_asyncio_dispose(&io);
+ * }
+ * \endcode
+ *
+ * \section asyncio_links Reference Links:
+ * - <a href="https://man7.org/linux/man-pages/man7/io_uring.7.html">io_uring(7) Linux Manual Page</a>
+ * - <a href="https://kernel.dk/io_uring.pdf">Efficient IO with io_uring</a>
+ */
+
+/*!
+* \def QSC_ASYNCIO_URING
+* \brief The Linux io_uring interface is available to the asynchronous I/O queue
+*/
+#if defined(QSC_SYSTEM_OS_LINUX)
+#	define QSC_ASYNCIO_URING
+#endif
+
+/*!
+* \def QSC_ASYNCIO_ENTRIES_MAX
+* \brief The maximum number of queue entries
+*/
+#define QSC_ASYNCIO_ENTRIES_MAX 4096ULL
+
+/*!
+* \def QSC_ASYNCIO_REGISTER_MAX
+* \brief The maximum number of registered buffers or descriptors
+*/
+#define QSC_ASYNCIO_REGISTER_MAX 64ULL
+
+/*** Enumerations ***/
+
+/*! \enum qsc_asyncio_operations
+* \brief The asynchronous operation types
+*/
+typedef enum
+{
+	qsc_asyncio_operation_none = 0x00U,						/*!< No operation was specified */
+	qsc_asyncio_operation_file_read = 0x01U,				/*!< A positioned file read */
+	qsc_asyncio_operation_file_write = 0x02U,				/*!< A positioned file write */
+	qsc_asyncio_operation_socket_receive = 0x03U,			/*!< A socket receive */
+	qsc_asyncio_operation_socket_send = 0x04U				/*!< A socket send */
+} qsc_asyncio_operations;
+
+/*** Structures ***/
+
+/*! \struct qsc_asyncio_completion
+* \brief An operation completion record.
+*/
+typedef struct
+{
+	void* context;											/*!< The caller supplied operation context */
+	int64_t result;											/*!< The number of bytes transferred, or a negative error code */
+	qsc_asyncio_operations operation;						/*!< The completed operation type */
+} qsc_asyncio_completion;
+
+/*! \struct qsc_asyncio_request
+* \brief A queued operation record.
+*/
+typedef struct
+{
+	void* context;											/*!< The caller supplied operation context */
+	FILE* fp;												/*!< The file stream for file operations */
+	const qsc_socket* sock;									/*!< The socket for socket operations */
+	uint8_t* buffer;										/*!< The operation buffer */
+	size_t length;											/*!< The number of bytes to transfer */
+	size_t position;										/*!< The file position */
+	qsc_asyncio_operations operation;						/*!< The operation type */
+} qsc_asyncio_request;
+
+/*! \struct qsc_asyncio_state
+* \brief The asynchronous I/O queue state.
+*/
+typedef struct
+{
+	qsc_asyncio_request* requests;							/*!< The request slots */
+	size_t* slots;											/*!< The io_uring free request slot stack */
+	qsc_asyncio_completion* completions;					/*!< The synchronous path completion queue */
+	uint8_t* buffers[QSC_ASYNCIO_REGISTER_MAX];				/*!< The registered buffer addresses */
+	size_t buflens[QSC_ASYNCIO_REGISTER_MAX];				/*!< The registered buffer lengths */
+	int32_t files[QSC_ASYNCIO_REGISTER_MAX];				/*!< The registered descriptor table */
+	void* sqring;											/*!< The mapped submission ring */
+	void* cqring;											/*!< The mapped completion ring */
+	void* sqes;												/*!< The mapped submission entries */
+	void* cqes;												/*!< The completion entries */
+	uint32_t* sqhead;										/*!< The submission ring head index */
+	uint32_t* sqtail;										/*!< The submission ring tail index */
+	uint32_t* sqarray;										/*!< The submission ring index array */
+	uint32_t* cqhead;										/*!< The completion ring head index */
+	uint32_t* cqtail;										/*!< The completion ring tail index */
+	uint32_t sqmask;										/*!< The submission ring index mask */
+	uint32_t cqmask;										/*!< The completion ring index mask */
+	size_t sqrlen;											/*!< The submission ring mapping length */
+	size_t cqrlen;											/*!< The completion ring mapping length */
+	size_t sqelen;											/*!< The submission entries mapping length */
+	size_t bcount;											/*!< The number of registered buffers */
+	size_t fcount;											/*!< The number of registered descriptors */
+	size_t entries;											/*!< The queue depth */
+	size_t queued;											/*!< The number of operations queued and not submitted */
+	size_t inflight;										/*!< The number of operations submitted and not reaped */
+	size_t scount;											/*!< The number of free request slots */
+	size_t chead;											/*!< The synchronous path completion read index */
+	int32_t handle;											/*!< The io_uring descriptor */
+	bool fixed;												/*!< The fixed descriptor table is registered */
+	bool uring;												/*!< The io_uring path is active */
+} qsc_asyncio_state;
+
+/*** Function Prototypes ***/
+
+/**
+* \brief Initialize the asynchronous I/O queue.
+* Uses io_uring when it is available, otherwise the synchronous fallback.
+*
+* \param state:		[qsc_asyncio_state*] A pointer to the queue state
+* \param entries:	[size_t] The queue depth, the maximum number of outstanding operations
+*
+* \return			[bool] Returns true if the queue was initialized
+*/
+QSC_EXPORT_API bool qsc_asyncio_initialize(qsc_asyncio_state* state, size_t entries);
+
+/**
+* \brief Release the queue, its kernel resources and registrations.
+* Outstanding operations should be reaped with qsc_asyncio_wait before the queue is disposed.
+*
+* \param state:		[qsc_asyncio_state*] A pointer to the queue state
+*/
+QSC_EXPORT_API void qsc_asyncio_dispose(qsc_asyncio_state* state);
+
+/**
+* \brief Register a set of buffers with the kernel.
+* Replaces any previous buffer registration. Buffers must remain valid until the queue is disposed.
+*
+* \param state:		[qsc_asyncio_state*] A pointer to the queue state
+* \param buffers:	[uint8_t* const*] An array of buffer pointers
+* \param lengths:	[const size_t*] An array of buffer lengths
+* \param count:		[size_t] The number of buffers, at most QSC_ASYNCIO_REGISTER_MAX
+*
+* \return			[bool] Returns true if the buffers were registered
+*/
+QSC_EXPORT_API bool qsc_asyncio_register_buffers(qsc_asyncio_state* state, uint8_t* const* buffers, const size_t* lengths, size_t count);
+
+/**
+* \brief Add a file to the fixed descriptor table
+*
+* \param state:		[qsc_asyncio_state*] A pointer to the queue state
+* \param fp:		[FILE*] The file stream
+*
+* \return			[bool] Returns true if the descriptor was registered
+*/
+QSC_EXPORT_API bool qsc_asyncio_register_file(qsc_asyncio_state* state, FILE* fp);
+
+/**
+* \brief Add a socket to the fixed descriptor table
+*
+* \param state:		[qsc_asyncio_state*] A pointer to the queue state
+* \param sock:		[const qsc_socket*] The connected socket
+*
+* \return			[bool] Returns true if the descriptor was registered
+*/
+QSC_EXPORT_API bool qsc_asyncio_register_socket(qsc_asyncio_state* state, const qsc_socket* sock);
+
+/**
+* \brief Queue a positioned file read
+*
+* \param state:		[qsc_asyncio_state*] A pointer to the queue state
+* \param fp:		[FILE*] The file stream
+* \param output:	[uint8_t*] The destination buffer
+* \param length:	[size_t] The number of bytes to read
+* \param position:	[size_t] The file position to read from
+* \param context:	[void*] The caller supplied context returned with the completion
+*
+* \return			[bool] Returns true if the operation was queued, false if the queue is full
+*/
+QSC_EXPORT_API bool qsc_asyncio_file_read(qsc_asyncio_state* state, FILE* fp, uint8_t* output, size_t length, size_t position, void* context);
+
+/**
+* \brief Queue a positioned file write
+*
+* \param state:		[qsc_asyncio_state*] A pointer to the queue state
+* \param fp:		[FILE*] The file stream
+* \param input:		[const uint8_t*] The source buffer
+* \param length:	[size_t] The number of bytes to write
+* \param position:	[size_t] The file position to write to
+* \param context:	[void*] The caller supplied context returned with the completion
+*
+* \return			[bool] Returns true if the operation was queued, false if the queue is full
+*/
+QSC_EXPORT_API bool qsc_asyncio_file_write(qsc_asyncio_state* state, FILE* fp, const uint8_t* input, size_t length, size_t position, void* context);
+
+/**
+* \brief Queue a socket receive
+*
+* \param state:		[qsc_asyncio_state*] A pointer to the queue state
+* \param sock:		[const qsc_socket*] The connected socket
+* \param output:	[uint8_t*] The destination buffer
+* \param length:	[size_t] The maximum number of bytes to receive
+* \param context:	[void*] The caller supplied context returned with the completion
+*
+* \return			[bool] Returns true if the operation was queued, false if the queue is full
+*/
+QSC_EXPORT_API bool qsc_asyncio_socket_receive(qsc_asyncio_state* state, const qsc_socket* sock, uint8_t* output, size_t length, void* context);
+
+/**
+* \brief Queue a socket send
+*
+* \param state:		[qsc_asyncio_state*] A pointer to the queue state
+* \param sock:		[const qsc_socket*] The connected socket
+* \param input:		[const uint8_t*] The source buffer
+* \param length:	[size_t] The number of bytes to send
+* \param context:	[void*] The caller supplied context returned with the completion
+*
+* \return			[bool] Returns true if the operation was queued, false if the queue is full
+*/
+QSC_EXPORT_API bool qsc_asyncio_socket_send(qsc_asyncio_state* state, const qsc_socket* sock, const uint8_t* input, size_t length, void* context);
+
+/**
+* \brief Submit the queued operations
+*
+* \param state:		[qsc_asyncio_state*] A pointer to the queue state
+*
+* \return			[size_t] The number of operations submitted
+*/
+QSC_EXPORT_API size_t qsc_asyncio_submit(qsc_asyncio_state* state);
+
+/**
+* \brief Collect completed operations, blocking until at least a minimum number have completed
+*
+* \param state:		[qsc_asyncio_state*] A pointer to the queue state
+* \param completions:	[qsc_asyncio_completion*] The array receiving the completion records
+* \param count:		[size_t] The maximum number of completions to return
+* \param minimum:	[size_t] The minimum number of completions to wait for, zero does not block
+*
+* \return			[size_t] The number of completion records returned
+*/
+QSC_EXPORT_API size_t qsc_asyncio_wait(qsc_asyncio_state* state, qsc_asyncio_completion* completions, size_t count, size_t minimum);
+
+QSC_CPLUSPLUS_ENABLED_END
+
+#endif
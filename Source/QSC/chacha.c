@@ -1,4 +1,5 @@
 #include "chacha.h"
+#include "async.h"
 #include "intutils.h"
 #include "memutils.h"
 
@@ -30,6 +31,16 @@ static void chacha_increment(qsc_chacha_state* ctx)
 	}
 }
 
+static void chacha_advance(qsc_chacha_state* ctx, uint64_t blocks)
+{
+	uint64_t ctr;
+
+	ctr = ((uint64_t)ctx->state[13] << 32) | ctx->state[12];
+	ctr += blocks;
+	ctx->state[12] = (uint32_t)ctr;
+	ctx->state[13] = (uint32_t)(ctr >> 32);
+}
+
 static void chacha_permute_p512c(const qsc_chacha_state* ctx, uint8_t* output)
 {
 	uint32_t x0;
@@ -155,6 +166,33 @@ static void chacha_permute_p512c(const qsc_chacha_state* ctx, uint8_t* output)
 	qsc_intutils_le32to8(output + 60, x15 + ctx->state[15]);
 }
 
+static size_t chacha_resume(qsc_chacha_state* ctx, uint8_t* output, const uint8_t* input, size_t length)
+{
+	uint8_t tmp[QSC_CHACHA_BLOCK_SIZE] = { 0 };
+	size_t i;
+	size_t rlen;
+
+	rlen = 0;
+
+	if (ctx->position != 0 && length != 0)
+	{
+		/* finish the block that a seek positioned the stream within */
+		chacha_permute_p512c(ctx, tmp);
+		chacha_increment(ctx);
+		rlen = qsc_intutils_min(length, QSC_CHACHA_BLOCK_SIZE - ctx->position);
+
+		for (i = 0; i < rlen; ++i)
+		{
+			output[i] = tmp[ctx->position + i] ^ input[i];
+		}
+
+		ctx->position = 0;
+		qsc_memutils_clear(tmp, sizeof(tmp));
+	}
+
+	return rlen;
+}
+
 #if defined(QSC_SYSTEM_HAS_AVX512)
 
 typedef struct
@@ -686,6 +724,7 @@ void qsc_chacha_dispose(qsc_chacha_state* ctx)
 	assert(ctx != NULL);
 
 	qsc_memutils_clear((uint8_t*)ctx->state, sizeof(ctx->state));
+	ctx->position = 0;
 }
 
 void qsc_chacha_initialize(qsc_chacha_state* ctx, const qsc_chacha_keyparams* keyparams)
@@ -733,6 +772,21 @@ void qsc_chacha_initialize(qsc_chacha_state* ctx, const qsc_chacha_keyparams* ke
 		ctx->state[14] = qsc_intutils_le8to32(keyparams->nonce);
 		ctx->state[15] = qsc_intutils_le8to32(keyparams->nonce + 4);
 	}
+
+	ctx->position = 0;
+}
+
+void qsc_chacha_seek(qsc_chacha_state* ctx, uint64_t offset)
+{
+	assert(ctx != NULL);
+
+	if (ctx != NULL)
+	{
+		ctx->state[12] = 0;
+		ctx->state[13] = 0;
+		chacha_advance(ctx, offset / QSC_CHACHA_BLOCK_SIZE);
+		ctx->position = (size_t)(offset % QSC_CHACHA_BLOCK_SIZE);
+	}
 }
 
 void qsc_chacha_transform(qsc_chacha_state* ctx, uint8_t* output, const uint8_t* input, size_t length)
@@ -744,7 +798,8 @@ void qsc_chacha_transform(qsc_chacha_state* ctx, uint8_t* output, const uint8_t*
 	size_t i;
 	size_t oft;
 
-	oft = 0;
+	oft = chacha_resume(ctx, output, input, length);
+	length -= oft;
 
 #if defined(QSC_SYSTEM_HAS_AVX512)
 
@@ -893,26 +948,122 @@ void qsc_chacha_transform(qsc_chacha_state* ctx, uint8_t* output, const uint8_t*
 
 	if (length != 0)
 	{
+		uint8_t tmp[QSC_CHACHA_BLOCK_SIZE] = { 0 };
+
+		/* the key-stream is generated in a temporary block so the input and output may overlap */
 		while (length >= QSC_CHACHA_BLOCK_SIZE)
 		{
-			chacha_permute_p512c(ctx, (output + oft));
+			chacha_permute_p512c(ctx, tmp);
 			chacha_increment(ctx);
-			qsc_memutils_xor((output + oft), (input + oft), QSC_CHACHA_BLOCK_SIZE);
+
+			for (i = 0; i < QSC_CHACHA_BLOCK_SIZE; ++i)
+			{
+				output[oft + i] = tmp[i] ^ input[oft + i];
+			}
+
 			oft += QSC_CHACHA_BLOCK_SIZE;
 			length -= QSC_CHACHA_BLOCK_SIZE;
 		}
 
 		if (length != 0)
 		{
-			uint8_t tmp[QSC_CHACHA_BLOCK_SIZE] = { 0 };
 			chacha_permute_p512c(ctx, tmp);
 			chacha_increment(ctx);
-			qsc_memutils_copy((output + oft), tmp, length);
 
-			for (i = oft; i < oft + length; ++i)
+			for (i = 0; i < length; ++i)
+			{
+				output[oft + i] = tmp[i] ^ input[oft + i];
+			}
+		}
+
+		qsc_memutils_clear(tmp, sizeof(tmp));
+	}
+}
+
+typedef struct
+{
+	const qsc_chacha_state* ctx;			/* the caller's cipher state */
+	uint8_t* output;						/* the output array */
+	const uint8_t* input;					/* the input array */
+	size_t length;							/* the total number of bytes */
+	size_t chunk;							/* the number of bytes per thread */
+	bool done[QSC_ASYNC_PARALLEL_MAX];		/* the completed ranges */
+} chacha_parallel_state;
+
+static void chacha_parallel_task(void* context, size_t index)
+{
+	chacha_parallel_state* pstate;
+	qsc_chacha_state lctx;
+	size_t oft;
+
+	pstate = (chacha_parallel_state*)context;
+	oft = index * pstate->chunk;
+
+	if (oft < pstate->length)
+	{
+		qsc_memutils_copy(&lctx, pstate->ctx, sizeof(qsc_chacha_state));
+		chacha_advance(&lctx, (uint64_t)(oft / QSC_CHACHA_BLOCK_SIZE));
+		qsc_chacha_transform(&lctx, pstate->output + oft, pstate->input + oft, qsc_intutils_min(pstate->chunk, pstate->length - oft));
+		qsc_memutils_secure_erase(lctx.state, sizeof(lctx.state));
+	}
+
+	pstate->done[index] = true;
+}
+
+void qsc_chacha_transform_parallel(qsc_chacha_state* ctx, uint8_t* output, const uint8_t* input, size_t length, size_t threads)
+{
+	assert(ctx != NULL);
+	assert(output != NULL);
+	assert(input != NULL);
+
+	chacha_parallel_state pstate;
+	size_t nblk;
+	size_t oft;
+	size_t i;
+
+	if (ctx->position != 0)
+	{
+		/* finish the partial block left by a seek before dividing the input */
+		oft = qsc_intutils_min(length, QSC_CHACHA_BLOCK_SIZE - ctx->position);
+		qsc_chacha_transform(ctx, output, input, oft);
+		output += oft;
+		input += oft;
+		length -= oft;
+	}
+
+	if (threads == 0)
+	{
+		threads = qsc_async_processor_count();
+	}
+
+	threads = qsc_intutils_min(threads, length / QSC_ASYNC_PARALLEL_MINIMUM);
+	threads = qsc_intutils_min(threads, QSC_ASYNC_PARALLEL_MAX);
+
+	if (threads <= 1)
+	{
+		qsc_chacha_transform(ctx, output, input, length);
+	}
+	else
+	{
+		qsc_memutils_clear(&pstate, sizeof(pstate));
+		nblk = (length + QSC_CHACHA_BLOCK_SIZE - 1) / QSC_CHACHA_BLOCK_SIZE;
+		pstate.ctx = ctx;
+		pstate.output = output;
+		pstate.input = input;
+		pstate.length = length;
+		pstate.chunk = ((nblk + threads - 1) / threads) * QSC_CHACHA_BLOCK_SIZE;
+
+		qsc_async_parallel_for(&chacha_parallel_task, &pstate, threads);
+
+		/* transform any range whose thread could not be launched */
+		for (i = 0; i < threads; ++i)
+		{
+			if (pstate.done[i] == false)
 			{
-				output[i] ^= input[i];
+				chacha_parallel_task(&pstate, i);
 			}
 		}
+
+		chacha_advance(ctx, (uint64_t)nblk);
 	}
 }
@@ -116,6 +116,7 @@ QSC_CPLUSPLUS_ENABLED_START
 QSC_EXPORT_API typedef struct
 {
     uint32_t state[16]; /*!< [uint32_t] The internal state array used by the cipher. */
+    size_t position;    /*!< [size_t] The byte offset within the current block, set by qsc_chacha_seek. */
 } qsc_chacha_state;
 
 /*!
@@ -151,6 +152,18 @@ QSC_EXPORT_API void qsc_chacha_dispose(qsc_chacha_state* ctx);
  */
 QSC_EXPORT_API void qsc_chacha_initialize(qsc_chacha_state* ctx, const qsc_chacha_keyparams* keyparams);
 
+/**
+ * \brief Position the ChaCha20 key-stream at a byte offset from the start of the message.
+ *
+ * Sets the block counter to the number of whole blocks in the offset, and the position within that block
+ * to the remainder. The next call to qsc_chacha_transform begins at that byte of the key-stream,
+ * so a range of a message may be decrypted without generating the key-stream that precedes it.
+ *
+ * \param ctx:          [qsc_chacha_state*] Pointer to an initialized ChaCha20 state structure.
+ * \param offset:       [uint64_t] The byte offset into the key-stream.
+ */
+QSC_EXPORT_API void qsc_chacha_seek(qsc_chacha_state* ctx, uint64_t offset);
+
 /**
  * \brief Process a block of input data using the ChaCha20 cipher.
  *
@@ -164,6 +177,21 @@ QSC_EXPORT_API void qsc_chacha_initialize(qsc_chacha_state* ctx, const qsc_chach
  */
 QSC_EXPORT_API void qsc_chacha_transform(qsc_chacha_state* ctx, uint8_t* output, const uint8_t* input, size_t length);
 
+/**
+ * \brief Process a large block of input data with the ChaCha20 cipher, dividing the work across threads.
+ *
+ * The input is split into contiguous ranges, and each thread transforms one range with a copy of the state
+ * whose block counter is advanced to the start of that range. The output and the final counter are identical
+ * to a single call to qsc_chacha_transform. Inputs smaller than QSC_ASYNC_PARALLEL_MINIMUM per thread use fewer threads.
+ *
+ * \param ctx:          [qsc_chacha_state*] Pointer to the ChaCha20 state structure.
+ * \param output:       [uint8_t*] Pointer to the output byte array.
+ * \param input:        [const uint8_t*] Pointer to the input byte array.
+ * \param length:       [size_t] The number of bytes to process.
+ * \param threads:      [size_t] The maximum number of threads; zero uses one thread per processor core.
+ */
+QSC_EXPORT_API void qsc_chacha_transform_parallel(qsc_chacha_state* ctx, uint8_t* output, const uint8_t* input, size_t length, size_t threads);
+
 QSC_CPLUSPLUS_ENABLED_END
 
 #endif
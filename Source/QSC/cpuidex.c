@@ -415,13 +415,47 @@ static void cpuidex_arm_features(qsc_cpuidex_cpu_features* features)
 
 static void cpuidex_cpu_info(uint32_t info[4], const uint32_t infotype)
 {
+	/* sub-leaf zero is explicit; leaf 7 reports the extended features there */
 #if defined(QSC_SYSTEM_COMPILER_MSC)
-	__cpuid((int32_t*)info, infotype);
+	__cpuidex((int32_t*)info, (int32_t)infotype, 0);
 #elif defined(QSC_SYSTEM_COMPILER_GCC)
-	__get_cpuid(infotype, &info[0], &info[1], &info[2], &info[3]);
+	__get_cpuid_count(infotype, 0, &info[0], &info[1], &info[2], &info[3]);
 #endif
 }
 
+static bool cpuidex_has_avx512f(void)
+{
+	bool res;
+
+#if defined(QSC_SYSTEM_COMPILER_GCC)
+	/* the builtin also checks that the OS saves the opmask and zmm register state */
+	__builtin_cpu_init();
+	res = (__builtin_cpu_supports("avx512f") != 0);
+#else
+	uint32_t info[4] = { 0 };
+
+	res = false;
+	cpuidex_cpu_info(info, 0x00000000UL);
+
+	if (info[0] >= 0x00000007UL)
+	{
+		cpuidex_cpu_info(info, 0x00000001UL);
+
+		if ((info[2] & (CPUID_ECX_XSAVE | CPUID_ECX_OSXSAVE)) == (CPUID_ECX_XSAVE | CPUID_ECX_OSXSAVE))
+		{
+			const uint32_t xmask = XCR0_SSE | XCR0_AVX | XCR0_OPMASK | XCR0_ZMM_HI256 | XCR0_HI16_ZMM;
+			uint32_t xcr0;
+
+			xcr0 = (uint32_t)_xgetbv(0);
+			cpuidex_cpu_info(info, 0x00000007UL);
+			res = ((info[1] & CPUID_EBX_AVX512F) != 0x00000000UL && (xcr0 & xmask) == xmask);
+		}
+	}
+#endif
+
+	return res;
+}
+
 static uint32_t cpuidex_read_bits(uint32_t value, int32_t index, int32_t length)
 {
 	int32_t mask = ((1L << length) - 1) << index;
@@ -522,6 +556,19 @@ static void cpuidex_cpu_topology(qsc_cpuidex_cpu_features* features)
 		features->cacheline = cpuidex_read_bits(info[2], 24, 8);
 	}
 
+	/* the SHA extensions use only the XMM state, so they are reported at every build level */
+	cpuidex_cpu_info(info, 0x00000000UL);
+
+	if (info[0] >= 0x00000007UL)
+	{
+		qsc_memutils_clear(info, sizeof(info));
+		cpuidex_cpu_info(info, 0x00000007UL);
+		features->sha256 = ((info[1] & CPUID_EBX_SHA2) != 0x00000000UL);
+	}
+
+	/* AVX-512 is reported at every build level so runtime-selected kernels can probe it */
+	features->avx512f = cpuidex_has_avx512f();
+
 	if (features->avx == true)
 	{
 #if defined(QSC_SYSTEM_HAS_AVX2)
@@ -539,27 +586,8 @@ static void cpuidex_cpu_topology(qsc_cpuidex_cpu_features* features)
 
 		features->adx = ((info[1] & CPUID_EBX_ADX) != 0x00000000UL);
 		features->avx2 = havx2 && ((uint32_t)_xgetbv(0) & 0x000000E6UL) != 0x00000000UL;
-		features->sha256 = ((info[1] & CPUID_EBX_SHA2) != 0x00000000UL);
 #endif
 
-#if defined(QSC_SYSTEM_HAS_AVX512)
-		bool havx512;
-#	if defined(QSC_SYSTEM_COMPILER_GCC)
-		havx512 = __builtin_cpu_supports("avx512f") != 0;
-#	else
-		havx512 = ((info[1] & CPUID_EBX_AVX512F) != 0x00000000UL);
-#	endif
-		if (havx512 == true)
-		{
-			uint32_t xcr2 = (uint32_t)_xgetbv(0);
-
-			if ((xcr2 & (XCR0_OPMASK | XCR0_ZMM_HI256 | XCR0_HI16_ZMM)) ==
-				(XCR0_OPMASK | XCR0_ZMM_HI256 | XCR0_HI16_ZMM))
-			{
-				features->avx512f = true;
-			}
-		}
-#endif
 	}
 }
 
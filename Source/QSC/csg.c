@@ -193,3 +193,278 @@ void qsc_csg_update(qsc_csg_state* ctx, const uint8_t* seed, size_t seedlen)
 	/* re-fill the buffer */
 	csg_fill_buffer(ctx);
 }
+
+/* wide generator */
+
+static void csg_wide_lane_load(const qsc_csg_wide_state* ctx, size_t lane, uint64_t* state)
+{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	uint64_t tmp[QSC_CSG_WIDE_LANES];
+
+	for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		_mm512_storeu_si512((__m512i*)tmp, ctx->statew[i]);
+		state[i] = tmp[lane];
+	}
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+	uint64_t tmp[QSC_CSG_WIDE_LANES / 2];
+
+	for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		_mm256_storeu_si256((__m256i*)tmp, ctx->statew[lane / 4][i]);
+		state[i] = tmp[lane % 4];
+	}
+#else
+	qsc_memutils_copy(state, ctx->state[lane], sizeof(ctx->state[lane]));
+#endif
+}
+
+static void csg_wide_lane_store(qsc_csg_wide_state* ctx, size_t lane, const uint64_t* state)
+{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	uint64_t tmp[QSC_CSG_WIDE_LANES];
+
+	for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		_mm512_storeu_si512((__m512i*)tmp, ctx->statew[i]);
+		tmp[lane] = state[i];
+		ctx->statew[i] = _mm512_loadu_si512((const __m512i*)tmp);
+	}
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+	uint64_t tmp[QSC_CSG_WIDE_LANES / 2];
+
+	for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		_mm256_storeu_si256((__m256i*)tmp, ctx->statew[lane / 4][i]);
+		tmp[lane % 4] = state[i];
+		ctx->statew[lane / 4][i] = _mm256_loadu_si256((const __m256i*)tmp);
+	}
+#else
+	qsc_memutils_copy(ctx->state[lane], state, sizeof(ctx->state[lane]));
+#endif
+}
+
+static void csg_wide_squeeze(qsc_csg_wide_state* ctx, uint8_t* output)
+{
+	/* permute every lane, then write one rate block from each lane in lane order */
+	const size_t WORDS = ctx->rate / sizeof(uint64_t);
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	uint64_t tmp[QSC_CSG_WIDE_LANES];
+
+	qsc_keccak_permute_p8x1600(ctx->statew, QSC_KECCAK_PERMUTATION_ROUNDS);
+
+	for (size_t i = 0; i < WORDS; ++i)
+	{
+		_mm512_storeu_si512((__m512i*)tmp, ctx->statew[i]);
+
+		for (size_t j = 0; j < QSC_CSG_WIDE_LANES; ++j)
+		{
+			qsc_intutils_le64to8(output + (j * ctx->rate) + (i * sizeof(uint64_t)), tmp[j]);
+		}
+	}
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+	uint64_t tmp[QSC_CSG_WIDE_LANES / 2];
+
+	qsc_keccak_permute_p4x1600(ctx->statew[0], QSC_KECCAK_PERMUTATION_ROUNDS);
+	qsc_keccak_permute_p4x1600(ctx->statew[1], QSC_KECCAK_PERMUTATION_ROUNDS);
+
+	for (size_t g = 0; g < 2; ++g)
+	{
+		for (size_t i = 0; i < WORDS; ++i)
+		{
+			_mm256_storeu_si256((__m256i*)tmp, ctx->statew[g][i]);
+
+			for (size_t j = 0; j < QSC_CSG_WIDE_LANES / 2; ++j)
+			{
+				qsc_intutils_le64to8(output + (((g * 4) + j) * ctx->rate) + (i * sizeof(uint64_t)), tmp[j]);
+			}
+		}
+	}
+#else
+	for (size_t j = 0; j < QSC_CSG_WIDE_LANES; ++j)
+	{
+		qsc_keccak_permute_p1600c(ctx->state[j], QSC_KECCAK_PERMUTATION_ROUNDS);
+
+		for (size_t i = 0; i < WORDS; ++i)
+		{
+			qsc_intutils_le64to8(output + (j * ctx->rate) + (i * sizeof(uint64_t)), ctx->state[j][i]);
+		}
+	}
+#endif
+}
+
+static void csg_wide_fill_buffer(qsc_csg_wide_state* ctx)
+{
+	csg_wide_squeeze(ctx, ctx->cache);
+
+	/* reset cache counters */
+	ctx->crmd = ctx->rate * QSC_CSG_WIDE_LANES;
+	ctx->cpos = 0;
+}
+
+static void csg_wide_absorb(qsc_csg_wide_state* ctx, const uint8_t* seed, size_t seedlen)
+{
+	qsc_keccak_state kstate = { 0 };
+	qsc_keccak_rate rate;
+
+	rate = (ctx->rate == QSC_KECCAK_512_RATE) ? qsc_keccak_rate_512 : qsc_keccak_rate_256;
+
+	/* absorb the seed into each lane, exactly as the single-lane update would */
+	for (size_t i = 0; i < QSC_CSG_WIDE_LANES; ++i)
+	{
+		csg_wide_lane_load(ctx, i, kstate.state);
+		qsc_cshake_update(&kstate, rate, seed, seedlen);
+		csg_wide_lane_store(ctx, i, kstate.state);
+	}
+
+	qsc_keccak_dispose(&kstate);
+}
+
+static void csg_wide_auto_reseed(qsc_csg_wide_state* ctx)
+{
+	uint8_t prand[QSC_CSG_512_SEED_SIZE] = { 0 };
+	size_t plen;
+
+	if (ctx->pres && ctx->bctr >= QSC_CSG_RESEED_THRESHHOLD)
+	{
+		/* add a random seed to every lane */
+		plen = (ctx->rate == QSC_KECCAK_512_RATE) ? QSC_CSG_512_SEED_SIZE : QSC_CSG_256_SEED_SIZE;
+		qsc_acp_generate(prand, plen);
+		csg_wide_absorb(ctx, prand, plen);
+		qsc_memutils_clear(prand, sizeof(prand));
+
+		/* re-fill the buffer and reset counter */
+		csg_wide_fill_buffer(ctx);
+		ctx->bctr = 0;
+	}
+}
+
+void qsc_csg_wide_dispose(qsc_csg_wide_state* ctx)
+{
+	assert(ctx != NULL);
+
+	if (ctx != NULL)
+	{
+#if defined(QSC_SYSTEM_HAS_AVX512) || defined(QSC_SYSTEM_HAS_AVX2)
+		qsc_memutils_clear(ctx->statew, sizeof(ctx->statew));
+#else
+		qsc_memutils_clear(ctx->state, sizeof(ctx->state));
+#endif
+		qsc_memutils_clear(ctx->cache, sizeof(ctx->cache));
+		ctx->bctr = 0;
+		ctx->cpos = 0;
+		ctx->crmd = 0;
+		ctx->rate = 0;
+		ctx->pres = false;
+	}
+}
+
+void qsc_csg_wide_initialize(qsc_csg_wide_state* ctx, const uint8_t* seed, size_t seedlen, const uint8_t* info, size_t infolen, bool predres)
+{
+	assert(ctx != NULL);
+	assert(seed != NULL);
+	assert(seedlen == QSC_CSG_256_SEED_SIZE || seedlen == QSC_CSG_512_SEED_SIZE);
+
+	uint8_t cust[sizeof(uint64_t) + QSC_CSG_512_SEED_SIZE] = { 0 };
+	qsc_keccak_state kstate = { 0 };
+	qsc_keccak_rate rate;
+	size_t clen;
+
+	if (seedlen == QSC_CSG_512_SEED_SIZE)
+	{
+		ctx->rate = QSC_KECCAK_512_RATE;
+		rate = qsc_keccak_rate_512;
+	}
+	else
+	{
+		ctx->rate = QSC_KECCAK_256_RATE;
+		rate = qsc_keccak_rate_256;
+	}
+
+	qsc_intutils_clear8(ctx->cache, sizeof(ctx->cache));
+	ctx->bctr = 0;
+	ctx->cpos = 0;
+	ctx->pres = predres;
+	clen = sizeof(uint64_t);
+
+	if (ctx->pres)
+	{
+		/* add a random seed to the customization of every lane */
+		qsc_acp_generate(cust + sizeof(uint64_t), seedlen);
+		clen += seedlen;
+	}
+
+	/* each lane is a cSHAKE instance customized with its lane index */
+	for (size_t i = 0; i < QSC_CSG_WIDE_LANES; ++i)
+	{
+		qsc_intutils_le64to8(cust, (uint64_t)i);
+		qsc_cshake_initialize(&kstate, rate, seed, seedlen, info, infolen, cust, clen);
+		csg_wide_lane_store(ctx, i, kstate.state);
+	}
+
+	qsc_keccak_dispose(&kstate);
+	qsc_memutils_clear(cust, sizeof(cust));
+
+	/* cache the first lane blocks */
+	csg_wide_fill_buffer(ctx);
+}
+
+void qsc_csg_wide_generate(qsc_csg_wide_state* ctx, uint8_t* output, size_t otplen)
+{
+	assert(ctx != NULL);
+	assert(output != NULL);
+
+	const size_t BLKLEN = ctx->rate * QSC_CSG_WIDE_LANES;
+	size_t rmdlen;
+
+	ctx->bctr += otplen;
+
+	/* copy and erase the remaining bytes from the cache */
+	rmdlen = qsc_intutils_min(ctx->crmd, otplen);
+
+	if (rmdlen != 0)
+	{
+		qsc_memutils_copy(output, ctx->cache + ctx->cpos, rmdlen);
+		qsc_memutils_clear(ctx->cache + ctx->cpos, rmdlen);
+		ctx->crmd -= rmdlen;
+		ctx->cpos += rmdlen;
+		output += rmdlen;
+		otplen -= rmdlen;
+	}
+
+	/* squeeze whole lane blocks directly into the output */
+	while (otplen >= BLKLEN)
+	{
+		csg_wide_squeeze(ctx, output);
+		output += BLKLEN;
+		otplen -= BLKLEN;
+	}
+
+	if (otplen != 0)
+	{
+		csg_wide_fill_buffer(ctx);
+		qsc_memutils_copy(output, ctx->cache, otplen);
+		qsc_memutils_clear(ctx->cache, otplen);
+		ctx->crmd -= otplen;
+		ctx->cpos += otplen;
+	}
+
+	/* reseed check */
+	csg_wide_auto_reseed(ctx);
+}
+
+void qsc_csg_wide_update(qsc_csg_wide_state* ctx, const uint8_t* seed, size_t seedlen)
+{
+	assert(ctx != NULL);
+	assert(seed != NULL);
+
+	if (ctx != NULL && seed != NULL)
+	{
+		/* absorb and permute */
+		csg_wide_absorb(ctx, seed, seedlen);
+
+		/* re-fill the buffer */
+		csg_wide_fill_buffer(ctx);
+	}
+}
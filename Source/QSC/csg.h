@@ -77,6 +77,12 @@ QSC_CPLUSPLUS_ENABLED_START
  * so that the generator can be reused without re-initialization in an online configuration. The generator can also be updated
  * with new seed material.
  *
+ * The wide variant (qsc_csg_wide_*) runs QSC_CSG_WIDE_LANES independently keyed cSHAKE lanes, permuted together
+ * with the 8-way AVX-512 or 4-way AVX2 Keccak permutations when available. Lane i is keyed with the seed, the info
+ * string as the cSHAKE name, and a customization string holding the lane index (and the predictive resistance seed).
+ * The output is one rate block from each lane in lane order, repeated, and is identical on every instruction set.
+ * Reseeding and predictive resistance behave as in the single-lane generator.
+ *
  * \section csg_links Reference Links:
  * - <a href="https://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.202.pdf">FIPS 202: SHA-3 Standard</a>
  * - <a href="https://csrc.nist.gov/publications/detail/sp/800-90a/rev-1/final">NIST Special Publication 800-90A</a>
@@ -117,6 +123,35 @@ QSC_EXPORT_API typedef struct
     bool pres;                          /*!< The predictive resistance flag. */
 } qsc_csg_state;
 
+/*!
+ * \def QSC_CSG_WIDE_LANES
+ * \brief The number of cSHAKE lanes in the wide generator.
+ */
+#define QSC_CSG_WIDE_LANES 8ULL
+
+/*!
+ * \struct qsc_csg_wide_state
+ * \brief The wide CSG state structure.
+ *
+ * This structure holds the lane states and output cache of the multi-lane CSG generator.
+ */
+QSC_EXPORT_API typedef struct
+{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+    __m512i statew[QSC_KECCAK_STATE_SIZE];                          /*!< The AVX512 lane states. */
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+    __m256i statew[2][QSC_KECCAK_STATE_SIZE];                       /*!< The AVX2 lane states. */
+#else
+    uint64_t state[QSC_CSG_WIDE_LANES][QSC_KECCAK_STATE_SIZE];      /*!< The lane states. */
+#endif
+    uint8_t cache[QSC_CSG_WIDE_LANES * QSC_KECCAK_256_RATE];        /*!< The cache buffer. */
+    size_t bctr;                                                    /*!< The bytes counter. */
+    size_t cpos;                                                    /*!< The cache position. */
+    size_t crmd;                                                    /*!< The cache remainder. */
+    size_t rate;                                                    /*!< The absorption rate. */
+    bool pres;                                                      /*!< The predictive resistance flag. */
+} qsc_csg_wide_state;
+
 /**
  * \brief Dispose of the DRBG state.
  *
@@ -163,6 +198,47 @@ QSC_EXPORT_API void qsc_csg_generate(qsc_csg_state* ctx, uint8_t* output, size_t
  */
 QSC_EXPORT_API void qsc_csg_update(qsc_csg_state* ctx, const uint8_t* seed, size_t seedlen);
 
+/**
+ * \brief Dispose of the wide DRBG state.
+ *
+ * \param ctx:      [qsc_csg_wide_state*] Pointer to the wide DRBG state structure.
+ */
+QSC_EXPORT_API void qsc_csg_wide_dispose(qsc_csg_wide_state* ctx);
+
+/**
+ * \brief Initialize the wide pseudo-random provider state with a seed and optional personalization string.
+ *
+ * The seed must be either 32 bytes (cSHAKE-256 lanes) or 64 bytes (cSHAKE-512 lanes).
+ *
+ * \param ctx:      [qsc_csg_wide_state*] Pointer to the wide DRBG state structure.
+ * \param seed:     [const uint8_t*] Pointer to the random seed.
+ * \param seedlen:  [size_t] The length of the seed in bytes.
+ * \param info:     [const uint8_t*] Pointer to the optional personalization string.
+ * \param infolen:  [size_t] The length of the personalization string in bytes.
+ * \param predres:  [bool] Enable predictive resistance; if true, random bytes are injected periodically.
+ */
+QSC_EXPORT_API void qsc_csg_wide_initialize(qsc_csg_wide_state* ctx, const uint8_t* seed, size_t seedlen, const uint8_t* info, size_t infolen, bool predres);
+
+/**
+ * \brief Generate pseudo-random bytes from all lanes of the wide DRBG.
+ *
+ * Whole multiples of the lane block are squeezed directly into the output.
+ *
+ * \param ctx:      [qsc_csg_wide_state*] Pointer to the wide DRBG state structure.
+ * \param output:   [uint8_t*] Pointer to the output array for pseudo-random bytes.
+ * \param otplen:   [size_t] The number of bytes to generate.
+ */
+QSC_EXPORT_API void qsc_csg_wide_generate(qsc_csg_wide_state* ctx, uint8_t* output, size_t otplen);
+
+/**
+ * \brief Update every lane of the wide DRBG with new seed material.
+ *
+ * \param ctx:      [qsc_csg_wide_state*] Pointer to the wide DRBG state structure.
+ * \param seed:     [const uint8_t*] Pointer to the update seed.
+ * \param seedlen:  [size_t] The length of the update seed in bytes.
+ */
+QSC_EXPORT_API void qsc_csg_wide_update(qsc_csg_wide_state* ctx, const uint8_t* seed, size_t seedlen);
+
 QSC_CPLUSPLUS_ENABLED_END
 
 #endif
@@ -1,4 +1,7 @@
 #include "csp.h"
+#include "async.h"
+#include "intutils.h"
+#include "memutils.h"
 
 #if defined(QSC_SYSTEM_OS_WINDOWS)
 #	include <Windows.h>
@@ -15,71 +18,287 @@
 #	include <stdio.h>
 #	include <sys/types.h>
 #	include <unistd.h>
+#	include <pthread.h>
+#	if defined(QSC_SYSTEM_OS_LINUX)
+#		include <sys/syscall.h>
+#	endif
 #	if !defined(O_NOCTTY)
 #		define O_NOCTTY 0
 #	endif
+#	if !defined(O_CLOEXEC)
+#		define O_CLOEXEC 0
+#	endif
 #endif
 
 #if defined(__OpenBSD__) || defined(__CloudABI__) || defined(__wasi__)
 #	define HAVE_SAFE_ARC4RANDOM
 #endif
 
-bool qsc_csp_generate(uint8_t* output, size_t length)
-{
-	assert(output != 0);
-	assert(length <= QSC_CSP_SEED_MAX);
+#if defined(QSC_SYSTEM_OS_LINUX) && defined(SYS_getrandom)
+#	define CSP_HAVE_GETRANDOM
+#endif
 
-	bool res;
+typedef struct
+{
+	uint8_t pool[QSC_CSP_POOL_SIZE];	/* the batched entropy */
+	size_t prem;						/* the number of unread bytes at the end of the pool */
+	volatile int32_t lock;				/* the pool spin lock */
+#if defined(QSC_SYSTEM_OS_POSIX)
+	bool atfork;						/* set once the fork handler is registered */
+#endif
+} csp_pool_state;
 
-	res = true;
+static csp_pool_state csp_pool;
 
 #if defined(QSC_SYSTEM_OS_WINDOWS)
 
+static volatile HCRYPTPROV csp_provider;
+
+static bool csp_system_generate(uint8_t* output, size_t length)
+{
 	HCRYPTPROV hprov;
+	DWORD blen;
+	bool res;
 
-	if (CryptAcquireContextW(&hprov, 0, 0, PROV_RSA_FULL, (CRYPT_VERIFYCONTEXT | CRYPT_SILENT)) == true)
+	res = true;
+	hprov = csp_provider;
+
+	if (hprov == 0)
 	{
-		if (CryptGenRandom(hprov, (DWORD)length, output) == false)
+		/* acquire the provider once and keep it for the lifetime of the process */
+		if (CryptAcquireContextW(&hprov, 0, 0, PROV_RSA_FULL, (CRYPT_VERIFYCONTEXT | CRYPT_SILENT)) == TRUE)
+		{
+			if (InterlockedCompareExchangePointer((PVOID volatile*)&csp_provider, (PVOID)hprov, NULL) != NULL)
+			{
+				CryptReleaseContext(hprov, 0);
+				hprov = csp_provider;
+			}
+		}
+		else
 		{
 			res = false;
 		}
 	}
-	else
-	{
-		res = false;
-	}
 
-	if (hprov != 0)
+	while (res == true && length != 0U)
 	{
-		CryptReleaseContext(hprov, 0);
+		blen = (DWORD)qsc_intutils_min(length, QSC_CSP_SEED_MAX);
+
+		if (CryptGenRandom(hprov, blen, output) == FALSE)
+		{
+			res = false;
+		}
+
+		output += blen;
+		length -= blen;
 	}
 
+	return res;
+}
+
 #elif defined(HAVE_SAFE_ARC4RANDOM)
 
+static bool csp_system_generate(uint8_t* output, size_t length)
+{
 	arc4random_buf(output, length);
 
+	return true;
+}
+
 #else
 
-	int32_t fd = open("/dev/urandom", O_RDONLY);
+static volatile int32_t csp_device = -1;
 
-	if (fd <= 0)
+static int32_t csp_device_open(void)
+{
+	int32_t fd;
+	int32_t prev;
+
+	fd = csp_device;
+
+	if (fd < 0)
 	{
-		res = false;
+		/* open the device once; a thread that loses the race closes its own descriptor */
+		do
+		{
+			fd = open("/dev/urandom", O_RDONLY | O_NOCTTY | O_CLOEXEC);
+		} while (fd < 0 && errno == EINTR);
+
+		if (fd >= 0)
+		{
+			prev = __sync_val_compare_and_swap(&csp_device, -1, fd);
+
+			if (prev != -1)
+			{
+				close(fd);
+				fd = prev;
+			}
+		}
 	}
-	else
+
+	return fd;
+}
+
+static bool csp_device_read(uint8_t* output, size_t length)
+{
+	ssize_t r;
+	int32_t fd;
+	bool res;
+
+	res = false;
+	fd = csp_device_open();
+
+	if (fd >= 0)
 	{
-		int32_t r = read(fd, output, length);
+		res = true;
 
-		if (r != length)
+		/* reads may be interrupted or return fewer bytes than requested */
+		while (length != 0U)
 		{
-			res = false;
+			r = read(fd, output, qsc_intutils_min(length, QSC_CSP_SEED_MAX));
+
+			if (r > 0)
+			{
+				output += (size_t)r;
+				length -= (size_t)r;
+			}
+			else if (r < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			else
+			{
+				res = false;
+				break;
+			}
+		}
+	}
+
+	return res;
+}
+
+static bool csp_system_generate(uint8_t* output, size_t length)
+{
+	bool res;
+
+#if defined(CSP_HAVE_GETRANDOM)
+	long r;
+
+	res = true;
+
+	while (length != 0U)
+	{
+		r = syscall(SYS_getrandom, output, qsc_intutils_min(length, QSC_CSP_SEED_MAX), 0U);
+
+		if (r > 0)
+		{
+			output += (size_t)r;
+			length -= (size_t)r;
+		}
+		else if (r < 0 && errno == EINTR)
+		{
+			continue;
 		}
+		else
+		{
+			/* a kernel without getrandom, or a seccomp filter that blocks it */
+			res = csp_device_read(output, length);
+			break;
+		}
+	}
+#else
+	res = csp_device_read(output, length);
+#endif
+
+	return res;
+}
+
+#endif
 
-		close(fd);
+#if defined(QSC_SYSTEM_OS_POSIX)
+static void csp_pool_fork_child(void)
+{
+	/* the child must never hand out bytes the parent may also use */
+	qsc_memutils_secure_erase(csp_pool.pool, sizeof(csp_pool.pool));
+	csp_pool.prem = 0U;
+	csp_pool.lock = 0;
+}
+#endif
+
+bool qsc_csp_generate(uint8_t* output, size_t length)
+{
+	assert(output != 0);
+
+	bool res;
+
+	res = false;
+
+	if (output != NULL)
+	{
+		res = csp_system_generate(output, length);
 	}
 
+	return res;
+}
+
+bool qsc_csp_pool_generate(uint8_t* output, size_t length)
+{
+	assert(output != 0);
+
+	size_t blen;
+	size_t poft;
+	bool res;
+
+	res = false;
+
+	if (output != NULL)
+	{
+		if (length > QSC_CSP_POOL_SIZE / 2U)
+		{
+			/* large requests would drain the pool; take them from the system directly */
+			res = csp_system_generate(output, length);
+		}
+		else
+		{
+			res = true;
+			qsc_async_spinlock_lock(&csp_pool.lock);
+
+#if defined(QSC_SYSTEM_OS_POSIX)
+			if (csp_pool.atfork == false)
+			{
+				csp_pool.atfork = (pthread_atfork(NULL, NULL, &csp_pool_fork_child) == 0);
+			}
 #endif
 
+			while (res == true && length != 0U)
+			{
+				if (csp_pool.prem == 0U)
+				{
+					res = csp_system_generate(csp_pool.pool, QSC_CSP_POOL_SIZE);
+
+					if (res == true)
+					{
+						csp_pool.prem = QSC_CSP_POOL_SIZE;
+					}
+				}
+
+				if (res == true)
+				{
+					/* hand out the next bytes and erase them from the pool */
+					poft = QSC_CSP_POOL_SIZE - csp_pool.prem;
+					blen = qsc_intutils_min(length, csp_pool.prem);
+					qsc_memutils_copy(output, csp_pool.pool + poft, blen);
+					qsc_memutils_clear(csp_pool.pool + poft, blen);
+					csp_pool.prem -= blen;
+					output += blen;
+					length -= blen;
+				}
+			}
+
+			qsc_async_spinlock_unlock(&csp_pool.lock);
+		}
+	}
+
 	return res;
 }
 
@@ -88,7 +307,7 @@ uint16_t qsc_csp_uint16()
 	uint8_t arr[sizeof(uint16_t)] = { 0 };
 	uint16_t num;
 
-	qsc_csp_generate(arr, sizeof(arr));
+	qsc_csp_pool_generate(arr, sizeof(arr));
 
 	num = (((uint16_t)arr[1]) | 
 		(uint16_t)((uint16_t)arr[0] << 8U));
@@ -101,7 +320,7 @@ uint32_t qsc_csp_uint32()
 	uint8_t arr[sizeof(uint32_t)] = { 0 };
 	uint32_t num;
 
-	qsc_csp_generate(arr, sizeof(arr));
+	qsc_csp_pool_generate(arr, sizeof(arr));
 
 	num = (uint32_t)(arr[3]) |
 		(((uint32_t)(arr[2])) << 8) |
@@ -116,7 +335,7 @@ uint64_t qsc_csp_uint64()
 	uint8_t arr[sizeof(uint64_t)] = { 0 };
 	uint64_t num;
 
-	qsc_csp_generate(arr, sizeof(arr));
+	qsc_csp_pool_generate(arr, sizeof(arr));
 
 	num = (uint64_t)(arr[7]) |
 		(((uint64_t)(arr[6])) << 8) |
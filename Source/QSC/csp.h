@@ -55,9 +55,16 @@ QSC_SYSTEM_CONDITION_IGNORE(5105)
  * \details
  * This header provides the interface for the Cryptographic System Entropy Provider.
  * It offers access to pseudo-random data generated by the system's entropy source.
- * On Windows systems, the provider uses the CryptGenRandom API; on POSIX systems,
- * it reads from the /dev/urandom device. In environments where arc4random_buf is available,
- * that function is used directly.
+ * On Windows systems, the provider uses the CryptGenRandom API through a provider handle that is 
+ * acquired once. On Linux it uses the getrandom system call. On other POSIX systems, or when getrandom 
+ * is unavailable, it reads from a /dev/urandom descriptor that is opened once and cached. Interrupted 
+ * and short reads are retried until the request is filled. In environments where arc4random_buf is 
+ * available, that function is used directly.
+ *
+ * Small requests can be served from a batched entropy pool with qsc_csp_pool_generate(). The pool 
+ * is refilled with one system call per QSC_CSP_POOL_SIZE bytes, erases each byte as it is handed out, 
+ * and is discarded in the child after a fork. The auto entropy provider and the DRBG reseed paths 
+ * draw from this pool.
  *
  * Example Usage:
  * \code
@@ -82,20 +89,27 @@ QSC_SYSTEM_CONDITION_IGNORE(5105)
 
 /*!
  * \def QSC_CSP_SEED_MAX
- * \brief The maximum number of seed bytes that can be extracted from a single generate call.
+ * \brief The maximum number of bytes requested from the system in a single call.
+ * Larger requests are split into several calls.
  */
 #define QSC_CSP_SEED_MAX 1024000ULL
 
+/*!
+ * \def QSC_CSP_POOL_SIZE
+ * \brief The size of the batched entropy pool.
+ */
+#define QSC_CSP_POOL_SIZE 4096ULL
+
 /**
  * \brief Retrieve pseudo-random bytes from the system entropy provider.
  *
  * This function fills the provided output array with pseudo-random bytes sourced from
  * the operating system's entropy mechanism. On Windows systems, it utilizes the CryptGenRandom
- * function from the Windows API, whereas on Posix systems it reads from the /dev/urandom device.
- * In environments supporting arc4random_buf, that function is used directly.
+ * function from the Windows API, on Linux the getrandom system call, and on other Posix systems
+ * a cached /dev/urandom descriptor. In environments supporting arc4random_buf, that function is used directly.
  *
  * \param output:	[uint8_t*] Pointer to the byte array where the random data will be stored.
- * \param length:	[size_t] The number of random bytes to generate. Must not exceed QSC_CSP_SEED_MAX.
+ * \param length:	[size_t] The number of random bytes to generate.
  *
  * \return			[bool] Returns true if the random data was successfully generated; otherwise, false.
  *
@@ -103,15 +117,31 @@ QSC_SYSTEM_CONDITION_IGNORE(5105)
  */
 QSC_EXPORT_API bool qsc_csp_generate(uint8_t* output, size_t length);
 
+/**
+ * \brief Retrieve pseudo-random bytes from the batched system entropy pool.
+ *
+ * Requests are served from a pool refilled by qsc_csp_generate(), amortizing the system call
+ * across many small requests. Bytes are erased from the pool as they are returned. Requests larger
+ * than half the pool are passed directly to the system provider. The function is thread-safe.
+ *
+ * \param output:	[uint8_t*] Pointer to the byte array where the random data will be stored.
+ * \param length:	[size_t] The number of random bytes to generate.
+ *
+ * \return			[bool] Returns true if the random data was successfully generated; otherwise, false.
+ *
+ * \see qsc_csp_generate()
+ */
+QSC_EXPORT_API bool qsc_csp_pool_generate(uint8_t* output, size_t length);
+
 /**
  * \brief Generate a random 16-bit unsigned integer.
  *
  * This function generates a pseudo-random 16-bit unsigned integer by retrieving the appropriate
- * number of bytes from the system entropy provider.
+ * number of bytes from the batched system entropy pool.
  *
  * \return			[uint16_t] Returns the pseudo-random 16-bit unsigned integer.
  *
- * \see qsc_csp_generate()
+ * \see qsc_csp_pool_generate()
  */
 QSC_EXPORT_API uint16_t qsc_csp_uint16(void);
 
@@ -119,11 +149,11 @@ QSC_EXPORT_API uint16_t qsc_csp_uint16(void);
  * \brief Generate a random 32-bit unsigned integer.
  *
  * This function generates a pseudo-random 32-bit unsigned integer by retrieving the appropriate
- * number of bytes from the system entropy provider.
+ * number of bytes from the batched system entropy pool.
  *
  * \return			[uint32_t] Returns the pseudo-random 32-bit unsigned integer.
  *
- * \see qsc_csp_generate()
+ * \see qsc_csp_pool_generate()
  */
 QSC_EXPORT_API uint32_t qsc_csp_uint32(void);
 
@@ -131,11 +161,11 @@ QSC_EXPORT_API uint32_t qsc_csp_uint32(void);
  * \brief Generate a random 64-bit unsigned integer.
  *
  * This function generates a pseudo-random 64-bit unsigned integer by retrieving the appropriate
- * number of bytes from the system entropy provider.
+ * number of bytes from the batched system entropy pool.
  *
  * \return			[uint64_t] Returns the pseudo-random 64-bit unsigned integer.
  *
- * \see qsc_csp_generate()
+ * \see qsc_csp_pool_generate()
  */
 QSC_EXPORT_API uint64_t qsc_csp_uint64(void);
 
@@ -1,4 +1,5 @@
 #include "csx.h"
+#include "async.h"
 #include "intutils.h"
 #include "memutils.h"
 #if defined(QSC_SYSTEM_HAS_AVX)
@@ -52,6 +53,16 @@ static void csx_increment(qsc_csx_state* ctx)
 	}
 }
 
+static void csx_advance(qsc_csx_state* ctx, uint64_t blocks)
+{
+	ctx->state[12] += blocks;
+
+	if (ctx->state[12] < blocks)
+	{
+		++ctx->state[13];
+	}
+}
+
 static void csx_permute_p1024c(const qsc_csx_state* ctx, uint8_t* output)
 {
 	uint64_t X0 = ctx->state[0];
@@ -541,11 +552,39 @@ static void csx_mac_update(qsc_csx_state* ctx, const uint8_t* input, size_t leng
 #endif
 }
 
+static size_t csx_resume(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input, size_t length)
+{
+	uint8_t tmp[QSC_CSX_BLOCK_SIZE] = { 0 };
+	size_t i;
+	size_t rlen;
+
+	rlen = 0;
+
+	if (ctx->position != 0 && length != 0)
+	{
+		/* finish the block that a seek positioned the stream within */
+		csx_permute_p1024c(ctx, tmp);
+		csx_increment(ctx);
+		rlen = qsc_intutils_min(length, QSC_CSX_BLOCK_SIZE - ctx->position);
+
+		for (i = 0; i < rlen; ++i)
+		{
+			output[i] = tmp[ctx->position + i] ^ input[i];
+		}
+
+		ctx->position = 0;
+		qsc_memutils_clear(tmp, sizeof(tmp));
+	}
+
+	return rlen;
+}
+
 static void csx_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input, size_t length)
 {
 	size_t oft;
 
-	oft = 0;
+	oft = csx_resume(ctx, output, input, length);
+	length -= oft;
 
 #if defined(QSC_SYSTEM_HAS_AVX512)
 
@@ -655,6 +694,87 @@ static void csx_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* in
 	}
 }
 
+typedef struct
+{
+	const qsc_csx_state* ctx;				/* the caller's cipher state */
+	uint8_t* output;						/* the output array */
+	const uint8_t* input;					/* the input array */
+	size_t length;							/* the total number of bytes */
+	size_t chunk;							/* the number of bytes per thread */
+	bool done[QSC_ASYNC_PARALLEL_MAX];		/* the completed ranges */
+} csx_parallel_state;
+
+static void csx_parallel_task(void* context, size_t index)
+{
+	csx_parallel_state* pstate;
+	qsc_csx_state lctx;
+	size_t oft;
+
+	pstate = (csx_parallel_state*)context;
+	oft = index * pstate->chunk;
+
+	if (oft < pstate->length)
+	{
+		qsc_memutils_copy(lctx.state, pstate->ctx->state, sizeof(lctx.state));
+		lctx.position = 0;
+		csx_advance(&lctx, (uint64_t)(oft / QSC_CSX_BLOCK_SIZE));
+		csx_transform(&lctx, pstate->output + oft, pstate->input + oft, qsc_intutils_min(pstate->chunk, pstate->length - oft));
+		qsc_memutils_secure_erase(lctx.state, sizeof(lctx.state));
+	}
+
+	pstate->done[index] = true;
+}
+
+static void csx_transform_parallel(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input, size_t length, size_t threads)
+{
+	csx_parallel_state pstate;
+	size_t nblk;
+	size_t oft;
+	size_t i;
+
+	/* finish the partial block left by a seek before dividing the input */
+	oft = csx_resume(ctx, output, input, length);
+	output += oft;
+	input += oft;
+	length -= oft;
+
+	if (threads == 0)
+	{
+		threads = qsc_async_processor_count();
+	}
+
+	threads = qsc_intutils_min(threads, length / QSC_ASYNC_PARALLEL_MINIMUM);
+	threads = qsc_intutils_min(threads, QSC_ASYNC_PARALLEL_MAX);
+
+	if (threads <= 1)
+	{
+		csx_transform(ctx, output, input, length);
+	}
+	else
+	{
+		qsc_memutils_clear(&pstate, sizeof(pstate));
+		nblk = (length + QSC_CSX_BLOCK_SIZE - 1) / QSC_CSX_BLOCK_SIZE;
+		pstate.ctx = ctx;
+		pstate.output = output;
+		pstate.input = input;
+		pstate.length = length;
+		pstate.chunk = ((nblk + threads - 1) / threads) * QSC_CSX_BLOCK_SIZE;
+
+		qsc_async_parallel_for(&csx_parallel_task, &pstate, threads);
+
+		/* transform any range whose thread could not be launched */
+		for (i = 0; i < threads; ++i)
+		{
+			if (pstate.done[i] == false)
+			{
+				csx_parallel_task(&pstate, i);
+			}
+		}
+
+		csx_advance(ctx, (uint64_t)nblk);
+	}
+}
+
 static void csx_load_key(qsc_csx_state* ctx, const uint8_t* key, const uint8_t* nonce, const uint8_t* code)
 {
 #if defined(QSC_SYSTEM_IS_LITTLE_ENDIAN)
@@ -725,6 +845,7 @@ void qsc_csx_dispose(qsc_csx_state* ctx)
 		qsc_intutils_clear64(ctx->state, QSC_CSX_STATE_SIZE);
 		ctx->counter = 0;
 		ctx->encrypt = false;
+		ctx->position = 0;
 	}
 }
 
@@ -736,6 +857,7 @@ void qsc_csx_initialize(qsc_csx_state* ctx, const qsc_csx_keyparams* keyparams,
 
 	ctx->counter = 0;
 	ctx->encrypt = encryption;
+	ctx->position = 0;
 
 #if defined(QSC_CSX_AUTHENTICATED)
 
@@ -830,12 +952,8 @@ void qsc_csx_store_nonce(const qsc_csx_state* ctx, uint8_t nonce[QSC_CSX_NONCE_S
 	qsc_intutils_le64to8(nonce + sizeof(uint64_t), ctx->state[13]);
 }
 
-bool qsc_csx_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input, size_t length)
+static bool csx_authenticated_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input, size_t length, size_t threads)
 {
-	assert(ctx != NULL);
-	assert(output != NULL);
-	assert(input != NULL);
-
 	bool res;
 
 #if defined(QSC_CSX_AUTHENTICATED)
@@ -856,7 +974,7 @@ bool qsc_csx_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input
 	if (ctx->encrypt)
 	{
 		/* use the transform to generate the key-stream and encrypt the data  */
-		csx_transform(ctx, output, input, length);
+		csx_transform_parallel(ctx, output, input, length, threads);
 
 		/* update the mac with the cipher-text */
 		csx_mac_update(ctx, output, length);
@@ -879,14 +997,14 @@ bool qsc_csx_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input
 		if (qsc_intutils_verify(code, input + length, QSC_CSX_MAC_SIZE) == 0)
 		{
 			/* generate the key-stream and decrypt the array */
-			csx_transform(ctx, output, input, length);
+			csx_transform_parallel(ctx, output, input, length, threads);
 			res = true;
 		}
 	}
 
 #else
 
-	csx_transform(ctx, output, input, length);
+	csx_transform_parallel(ctx, output, input, length, threads);
 	res = true;
 
 #endif
@@ -894,6 +1012,56 @@ bool qsc_csx_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input
 	return res;
 }
 
+void qsc_csx_seek(qsc_csx_state* ctx, const uint8_t nonce[QSC_CSX_NONCE_SIZE], uint64_t offset)
+{
+	assert(ctx != NULL);
+	assert(nonce != NULL);
+
+	if (ctx != NULL && nonce != NULL)
+	{
+		ctx->state[12] = qsc_intutils_le8to64(nonce);
+		ctx->state[13] = qsc_intutils_le8to64(nonce + sizeof(uint64_t));
+		csx_advance(ctx, offset / QSC_CSX_BLOCK_SIZE);
+		ctx->position = (size_t)(offset % QSC_CSX_BLOCK_SIZE);
+	}
+}
+
+bool qsc_csx_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input, size_t length)
+{
+	assert(ctx != NULL);
+	assert(output != NULL);
+	assert(input != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (ctx != NULL && output != NULL && input != NULL)
+	{
+		res = csx_authenticated_transform(ctx, output, input, length, 1);
+	}
+
+	return res;
+}
+
+bool qsc_csx_transform_parallel(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input, size_t length, size_t threads)
+{
+	assert(ctx != NULL);
+	assert(output != NULL);
+	assert(input != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (ctx != NULL && output != NULL && input != NULL)
+	{
+		res = csx_authenticated_transform(ctx, output, input, length, threads);
+	}
+
+	return res;
+}
+
 bool qsc_csx_extended_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input, size_t length, bool finalize)
 {
 	assert(ctx != NULL);
@@ -202,6 +202,7 @@ QSC_EXPORT_API typedef struct
 	qsc_keccak_state kstate;			/*!< the KMAC state structure */
 #endif
 	uint64_t counter;					/*!< the processed bytes counter */
+	size_t position;					/*!< the byte offset within the current block, set by a seek */
 	bool encrypt;						/*!< the transformation mode; true for encryption */
 } qsc_csx_state;
 
@@ -250,6 +251,20 @@ QSC_EXPORT_API void qsc_csx_set_associated(qsc_csx_state* ctx, const uint8_t* da
 */
 QSC_EXPORT_API void qsc_csx_store_nonce(const qsc_csx_state* ctx, uint8_t nonce[QSC_CSX_NONCE_SIZE]);
 
+/**
+* \brief Position the key-stream at a byte offset from the start of a message.
+* The counter is set to the initial nonce plus the number of whole blocks in the offset,
+* and the position within that block to the remainder; the next transform begins at that byte of the key-stream.
+*
+* \warning In authenticated mode the MAC is computed from the seek position over the bytes that follow,
+* so a seek is only meaningful when each range is encrypted and authenticated as its own message.
+*
+* \param ctx:			[struct] The cipher state structure
+* \param nonce:			[const] The initial nonce the message was transformed with
+* \param offset:		[uint64_t] The byte offset into the key-stream
+*/
+QSC_EXPORT_API void qsc_csx_seek(qsc_csx_state* ctx, const uint8_t nonce[QSC_CSX_NONCE_SIZE], uint64_t offset);
+
 /**
 * \brief Transform an array of bytes.
 * In encryption mode, the input plain-text is encrypted and then an authentication MAC code is appended to the cipher-text.
@@ -267,6 +282,24 @@ QSC_EXPORT_API void qsc_csx_store_nonce(const qsc_csx_state* ctx, uint8_t nonce[
 */
 QSC_EXPORT_API bool qsc_csx_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input, size_t length);
 
+/**
+* \brief Transform an array of bytes, generating the key-stream on multiple threads.
+* The input is divided into contiguous ranges of blocks, each generated from a copy of the state
+* with the counter advanced to the start of its range; the MAC is computed sequentially.
+* The output, MAC code, and final nonce are identical to those of qsc_csx_transform.
+*
+* \warning The cipher must be initialized before this function can be called
+*
+* \param ctx:			[struct] The cipher state structure
+* \param output:		[uint8_t*] A pointer to the output array
+* \param input:			[const] A pointer to the input array
+* \param length:		[size_t] The number of bytes to transform
+* \param threads:		[size_t] The maximum number of threads; zero uses one thread per processor core
+*
+* \return:				[bool] Returns true if the cipher has been transformed the data successfully, false on failure
+*/
+QSC_EXPORT_API bool qsc_csx_transform_parallel(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input, size_t length, size_t threads);
+
 /**
 * \brief A multi-call transform for a large array of bytes, such as required by file encryption.
 * This call can be used to transform and authenticate a very large array of bytes (+1GB).
@@ -0,0 +1,618 @@
+#include "ctsort.h"
+#if defined(QSC_SYSTEM_AVX_INTRINSICS)
+#	include "intrinsics.h"
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+#	define CTSORT_INT32_LANES 16
+#	define CTSORT_UINT64_LANES 8
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+#	define CTSORT_INT32_LANES 8
+#	define CTSORT_UINT64_LANES 4
+#endif
+
+static void ctsort_int32_minmax(int32_t* a, int32_t* b)
+{
+	int32_t ab;
+	int32_t c;
+
+	ab = *b ^ *a;
+	c = (int32_t)((uint32_t)*b - (uint32_t)*a);
+	c ^= ab & (c ^ *b);
+	c >>= 31;
+	c &= ab;
+	*a ^= c;
+	*b ^= c;
+}
+
+static void ctsort_uint64_minmax(uint64_t* a, uint64_t* b)
+{
+	uint64_t c;
+
+	/* c is set if b is less than a */
+	c = *b ^ ((*b ^ *a) | ((*b - *a) ^ *a));
+	c >>= 63;
+	c = ~c + 1;
+	c &= *a ^ *b;
+	*a ^= c;
+	*b ^= c;
+}
+
+#if !defined(CTSORT_INT32_LANES)
+
+/* The portable path uses the djbsort merge network, which requires fewer
+   compare-exchange operations than a bitonic sort when executed one pair at a time */
+
+static void ctsort_int32_network(int32_t* x, size_t n)
+{
+	size_t top;
+	size_t i;
+
+	top = 1;
+
+	while (top < n - top)
+	{
+		top += top;
+	}
+
+	for (size_t p = top; p > 0; p >>= 1)
+	{
+		for (i = 0; i < n - p; ++i)
+		{
+			if ((i & p) == 0)
+			{
+				ctsort_int32_minmax(&x[i], &x[i + p]);
+			}
+		}
+
+		i = 0;
+
+		for (size_t q = top; q > p; q >>= 1)
+		{
+			for (; i < n - q; ++i)
+			{
+				if ((i & p) == 0)
+				{
+					int32_t a = x[i + p];
+
+					for (size_t r = q; r > p; r >>= 1)
+					{
+						ctsort_int32_minmax(&a, &x[i + r]);
+					}
+
+					x[i + p] = a;
+				}
+			}
+		}
+	}
+}
+
+static void ctsort_uint64_network(uint64_t* x, size_t n)
+{
+	size_t top;
+	size_t i;
+
+	top = 1;
+
+	while (top < n - top)
+	{
+		top += top;
+	}
+
+	for (size_t p = top; p > 0; p >>= 1)
+	{
+		for (i = 0; i < n - p; ++i)
+		{
+			if ((i & p) == 0)
+			{
+				ctsort_uint64_minmax(&x[i], &x[i + p]);
+			}
+		}
+
+		i = 0;
+
+		for (size_t q = top; q > p; q >>= 1)
+		{
+			for (; i < n - q; ++i)
+			{
+				if ((i & p) == 0)
+				{
+					uint64_t a = x[i + p];
+
+					for (size_t r = q; r > p; r >>= 1)
+					{
+						ctsort_uint64_minmax(&a, &x[i + r]);
+					}
+
+					x[i + p] = a;
+				}
+			}
+		}
+	}
+}
+
+#else
+
+/* The vectorized path is a bitonic sort in which every compare-exchange places the minimum at the lower index.
+   Each merge of width k begins with a 'flip' stage that pairs index i with i ^ (k - 1), followed by
+   half-cleaner stages that pair i with i ^ j for j = k/4 .. 1. Every stage is a set of independent
+   compare-exchanges, so W adjacent pairs are processed with one vector min/max.
+   Positions at or above n are treated as holding the maximum value, so any pair whose upper index
+   is outside the array is a no-op and is skipped; the schedule depends only on n. */
+
+static size_t ctsort_network_size(size_t n)
+{
+	size_t top;
+
+	top = 1;
+
+	while (top < n)
+	{
+		top <<= 1;
+	}
+
+	return top;
+}
+
+static void ctsort_int32_flip_scalar(int32_t* x, size_t n, size_t start, size_t end, size_t k)
+{
+	size_t hi;
+
+	for (size_t i = start; i < end; ++i)
+	{
+		hi = i ^ (k - 1);
+
+		if ((i & (k >> 1)) == 0 && hi < n)
+		{
+			ctsort_int32_minmax(&x[i], &x[hi]);
+		}
+	}
+}
+
+static void ctsort_int32_clean_scalar(int32_t* x, size_t n, size_t start, size_t end, size_t j)
+{
+	for (size_t i = start; i < end; ++i)
+	{
+		if ((i & j) == 0 && i + j < n)
+		{
+			ctsort_int32_minmax(&x[i], &x[i + j]);
+		}
+	}
+}
+
+static void ctsort_uint64_flip_scalar(uint64_t* x, size_t n, size_t start, size_t end, size_t k)
+{
+	size_t hi;
+
+	for (size_t i = start; i < end; ++i)
+	{
+		hi = i ^ (k - 1);
+
+		if ((i & (k >> 1)) == 0 && hi < n)
+		{
+			ctsort_uint64_minmax(&x[i], &x[hi]);
+		}
+	}
+}
+
+static void ctsort_uint64_clean_scalar(uint64_t* x, size_t n, size_t start, size_t end, size_t j)
+{
+	for (size_t i = start; i < end; ++i)
+	{
+		if ((i & j) == 0 && i + j < n)
+		{
+			ctsort_uint64_minmax(&x[i], &x[i + j]);
+		}
+	}
+}
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+static void ctsort_int32_pair_vector(int32_t* lo, int32_t* hi)
+{
+	__m512i a;
+	__m512i b;
+
+	a = _mm512_loadu_si512((const __m512i*)lo);
+	b = _mm512_loadu_si512((const __m512i*)hi);
+	_mm512_storeu_si512((__m512i*)lo, _mm512_min_epi32(a, b));
+	_mm512_storeu_si512((__m512i*)hi, _mm512_max_epi32(a, b));
+}
+
+static void ctsort_int32_flip_vector(int32_t* lo, int32_t* hi)
+{
+	const __m512i rev = _mm512_setr_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+	__m512i a;
+	__m512i b;
+
+	a = _mm512_loadu_si512((const __m512i*)lo);
+	b = _mm512_permutexvar_epi32(rev, _mm512_loadu_si512((const __m512i*)hi));
+	_mm512_storeu_si512((__m512i*)lo, _mm512_min_epi32(a, b));
+	_mm512_storeu_si512((__m512i*)hi, _mm512_permutexvar_epi32(rev, _mm512_max_epi32(a, b)));
+}
+
+static void ctsort_int32_inner_vector(int32_t* x, size_t n, size_t dist, size_t bit, bool flip)
+{
+	const __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	__m512i idx;
+	__m512i v;
+	__m512i p;
+	__mmask16 msk;
+
+	/* partner lanes are lane ^ dist, lanes with the selector bit set receive the maximum */
+	idx = _mm512_xor_si512(lane, _mm512_set1_epi32((int32_t)dist));
+	msk = _mm512_test_epi32_mask(lane, _mm512_set1_epi32((int32_t)bit));
+
+	for (size_t i = 0; i < n; i += CTSORT_INT32_LANES)
+	{
+		if (i + CTSORT_INT32_LANES <= n)
+		{
+			v = _mm512_loadu_si512((const __m512i*)(x + i));
+			p = _mm512_permutexvar_epi32(idx, v);
+			v = _mm512_mask_blend_epi32(msk, _mm512_min_epi32(v, p), _mm512_max_epi32(v, p));
+			_mm512_storeu_si512((__m512i*)(x + i), v);
+		}
+		else if (flip == true)
+		{
+			ctsort_int32_flip_scalar(x, n, i, n, bit << 1);
+		}
+		else
+		{
+			ctsort_int32_clean_scalar(x, n, i, n, dist);
+		}
+	}
+}
+
+static void ctsort_uint64_pair_vector(uint64_t* lo, uint64_t* hi)
+{
+	__m512i a;
+	__m512i b;
+
+	a = _mm512_loadu_si512((const __m512i*)lo);
+	b = _mm512_loadu_si512((const __m512i*)hi);
+	_mm512_storeu_si512((__m512i*)lo, _mm512_min_epu64(a, b));
+	_mm512_storeu_si512((__m512i*)hi, _mm512_max_epu64(a, b));
+}
+
+static void ctsort_uint64_flip_vector(uint64_t* lo, uint64_t* hi)
+{
+	const __m512i rev = _mm512_setr_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+	__m512i a;
+	__m512i b;
+
+	a = _mm512_loadu_si512((const __m512i*)lo);
+	b = _mm512_permutexvar_epi64(rev, _mm512_loadu_si512((const __m512i*)hi));
+	_mm512_storeu_si512((__m512i*)lo, _mm512_min_epu64(a, b));
+	_mm512_storeu_si512((__m512i*)hi, _mm512_permutexvar_epi64(rev, _mm512_max_epu64(a, b)));
+}
+
+static void ctsort_uint64_inner_vector(uint64_t* x, size_t n, size_t dist, size_t bit, bool flip)
+{
+	const __m512i lane = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+	__m512i idx;
+	__m512i v;
+	__m512i p;
+	__mmask8 msk;
+
+	idx = _mm512_xor_si512(lane, _mm512_set1_epi64((int64_t)dist));
+	msk = _mm512_test_epi64_mask(lane, _mm512_set1_epi64((int64_t)bit));
+
+	for (size_t i = 0; i < n; i += CTSORT_UINT64_LANES)
+	{
+		if (i + CTSORT_UINT64_LANES <= n)
+		{
+			v = _mm512_loadu_si512((const __m512i*)(x + i));
+			p = _mm512_permutexvar_epi64(idx, v);
+			v = _mm512_mask_blend_epi64(msk, _mm512_min_epu64(v, p), _mm512_max_epu64(v, p));
+			_mm512_storeu_si512((__m512i*)(x + i), v);
+		}
+		else if (flip == true)
+		{
+			ctsort_uint64_flip_scalar(x, n, i, n, bit << 1);
+		}
+		else
+		{
+			ctsort_uint64_clean_scalar(x, n, i, n, dist);
+		}
+	}
+}
+
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+
+static void ctsort_int32_pair_vector(int32_t* lo, int32_t* hi)
+{
+	__m256i a;
+	__m256i b;
+
+	a = _mm256_loadu_si256((const __m256i*)lo);
+	b = _mm256_loadu_si256((const __m256i*)hi);
+	_mm256_storeu_si256((__m256i*)lo, _mm256_min_epi32(a, b));
+	_mm256_storeu_si256((__m256i*)hi, _mm256_max_epi32(a, b));
+}
+
+static void ctsort_int32_flip_vector(int32_t* lo, int32_t* hi)
+{
+	const __m256i rev = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+	__m256i a;
+	__m256i b;
+
+	a = _mm256_loadu_si256((const __m256i*)lo);
+	b = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*)hi), rev);
+	_mm256_storeu_si256((__m256i*)lo, _mm256_min_epi32(a, b));
+	_mm256_storeu_si256((__m256i*)hi, _mm256_permutevar8x32_epi32(_mm256_max_epi32(a, b), rev));
+}
+
+static void ctsort_int32_inner_vector(int32_t* x, size_t n, size_t dist, size_t bit, bool flip)
+{
+	const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	__m256i idx;
+	__m256i msk;
+	__m256i sel;
+	__m256i v;
+	__m256i p;
+
+	/* partner lanes are lane ^ dist, lanes with the selector bit set receive the maximum */
+	idx = _mm256_xor_si256(lane, _mm256_set1_epi32((int32_t)dist));
+	sel = _mm256_set1_epi32((int32_t)bit);
+	msk = _mm256_cmpeq_epi32(_mm256_and_si256(lane, sel), sel);
+
+	for (size_t i = 0; i < n; i += CTSORT_INT32_LANES)
+	{
+		if (i + CTSORT_INT32_LANES <= n)
+		{
+			v = _mm256_loadu_si256((const __m256i*)(x + i));
+			p = _mm256_permutevar8x32_epi32(v, idx);
+			v = _mm256_blendv_epi8(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), msk);
+			_mm256_storeu_si256((__m256i*)(x + i), v);
+		}
+		else if (flip == true)
+		{
+			ctsort_int32_flip_scalar(x, n, i, n, bit << 1);
+		}
+		else
+		{
+			ctsort_int32_clean_scalar(x, n, i, n, dist);
+		}
+	}
+}
+
+static void ctsort_uint64_minmax_vector(__m256i* a, __m256i* b)
+{
+	const __m256i sgn = _mm256_set1_epi64x((int64_t)0x8000000000000000ULL);
+	__m256i gt;
+	__m256i t;
+
+	/* AVX2 has no unsigned 64-bit compare, bias both operands by the sign bit */
+	gt = _mm256_cmpgt_epi64(_mm256_xor_si256(*a, sgn), _mm256_xor_si256(*b, sgn));
+	t = _mm256_blendv_epi8(*a, *b, gt);
+	*b = _mm256_blendv_epi8(*b, *a, gt);
+	*a = t;
+}
+
+static void ctsort_uint64_pair_vector(uint64_t* lo, uint64_t* hi)
+{
+	__m256i a;
+	__m256i b;
+
+	a = _mm256_loadu_si256((const __m256i*)lo);
+	b = _mm256_loadu_si256((const __m256i*)hi);
+	ctsort_uint64_minmax_vector(&a, &b);
+	_mm256_storeu_si256((__m256i*)lo, a);
+	_mm256_storeu_si256((__m256i*)hi, b);
+}
+
+static void ctsort_uint64_flip_vector(uint64_t* lo, uint64_t* hi)
+{
+	__m256i a;
+	__m256i b;
+
+	a = _mm256_loadu_si256((const __m256i*)lo);
+	b = _mm256_permute4x64_epi64(_mm256_loadu_si256((const __m256i*)hi), 0x1B);
+	ctsort_uint64_minmax_vector(&a, &b);
+	_mm256_storeu_si256((__m256i*)lo, a);
+	_mm256_storeu_si256((__m256i*)hi, _mm256_permute4x64_epi64(b, 0x1B));
+}
+
+static void ctsort_uint64_inner_vector(uint64_t* x, size_t n, size_t dist, size_t bit, bool flip)
+{
+	const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	__m256i idx;
+	__m256i msk;
+	__m256i sel;
+	__m256i v;
+	__m256i p;
+	__m256i q;
+
+	/* permute 64-bit lanes as pairs of 32-bit words: word w maps to 2 * ((w / 2) ^ dist) + (w % 2) */
+	idx = _mm256_xor_si256(lane, _mm256_set1_epi32((int32_t)(dist << 1)));
+	sel = _mm256_set1_epi32((int32_t)(bit << 1));
+	msk = _mm256_cmpeq_epi32(_mm256_and_si256(lane, sel), sel);
+
+	for (size_t i = 0; i < n; i += CTSORT_UINT64_LANES)
+	{
+		if (i + CTSORT_UINT64_LANES <= n)
+		{
+			v = _mm256_loadu_si256((const __m256i*)(x + i));
+			p = _mm256_permutevar8x32_epi32(v, idx);
+			q = v;
+			ctsort_uint64_minmax_vector(&q, &p);
+			v = _mm256_blendv_epi8(q, p, msk);
+			_mm256_storeu_si256((__m256i*)(x + i), v);
+		}
+		else if (flip == true)
+		{
+			ctsort_uint64_flip_scalar(x, n, i, n, bit << 1);
+		}
+		else
+		{
+			ctsort_uint64_clean_scalar(x, n, i, n, dist);
+		}
+	}
+}
+
+#endif
+
+static void ctsort_int32_flip(int32_t* x, size_t n, size_t k)
+{
+	size_t hi;
+
+	if ((k >> 1) >= CTSORT_INT32_LANES)
+	{
+		for (size_t i = 0; i < n; i += CTSORT_INT32_LANES)
+		{
+			if ((i & (k >> 1)) == 0)
+			{
+				/* the partners of the lanes i..i+W-1 are the descending run ending at i ^ (k - 1) */
+				hi = i ^ (k - 1);
+
+				if (hi < n)
+				{
+					ctsort_int32_flip_vector(x + i, x + hi - (CTSORT_INT32_LANES - 1));
+				}
+				else
+				{
+					ctsort_int32_flip_scalar(x, n, i, i + CTSORT_INT32_LANES, k);
+				}
+			}
+		}
+	}
+	else
+	{
+		ctsort_int32_inner_vector(x, n, k - 1, k >> 1, true);
+	}
+}
+
+static void ctsort_int32_clean(int32_t* x, size_t n, size_t j)
+{
+	if (j >= CTSORT_INT32_LANES)
+	{
+		for (size_t i = 0; i < n; i += CTSORT_INT32_LANES)
+		{
+			if ((i & j) == 0)
+			{
+				if (i + j + CTSORT_INT32_LANES <= n)
+				{
+					ctsort_int32_pair_vector(x + i, x + i + j);
+				}
+				else
+				{
+					ctsort_int32_clean_scalar(x, n, i, i + CTSORT_INT32_LANES, j);
+				}
+			}
+		}
+	}
+	else
+	{
+		ctsort_int32_inner_vector(x, n, j, j, false);
+	}
+}
+
+static void ctsort_uint64_flip(uint64_t* x, size_t n, size_t k)
+{
+	size_t hi;
+
+	if ((k >> 1) >= CTSORT_UINT64_LANES)
+	{
+		for (size_t i = 0; i < n; i += CTSORT_UINT64_LANES)
+		{
+			if ((i & (k >> 1)) == 0)
+			{
+				hi = i ^ (k - 1);
+
+				if (hi < n)
+				{
+					ctsort_uint64_flip_vector(x + i, x + hi - (CTSORT_UINT64_LANES - 1));
+				}
+				else
+				{
+					ctsort_uint64_flip_scalar(x, n, i, i + CTSORT_UINT64_LANES, k);
+				}
+			}
+		}
+	}
+	else
+	{
+		ctsort_uint64_inner_vector(x, n, k - 1, k >> 1, true);
+	}
+}
+
+static void ctsort_uint64_clean(uint64_t* x, size_t n, size_t j)
+{
+	if (j >= CTSORT_UINT64_LANES)
+	{
+		for (size_t i = 0; i < n; i += CTSORT_UINT64_LANES)
+		{
+			if ((i & j) == 0)
+			{
+				if (i + j + CTSORT_UINT64_LANES <= n)
+				{
+					ctsort_uint64_pair_vector(x + i, x + i + j);
+				}
+				else
+				{
+					ctsort_uint64_clean_scalar(x, n, i, i + CTSORT_UINT64_LANES, j);
+				}
+			}
+		}
+	}
+	else
+	{
+		ctsort_uint64_inner_vector(x, n, j, j, false);
+	}
+}
+
+static void ctsort_int32_network(int32_t* x, size_t n)
+{
+	size_t top;
+
+	top = ctsort_network_size(n);
+
+	for (size_t k = 2; k <= top; k <<= 1)
+	{
+		ctsort_int32_flip(x, n, k);
+
+		for (size_t j = k >> 2; j > 0; j >>= 1)
+		{
+			ctsort_int32_clean(x, n, j);
+		}
+	}
+}
+
+static void ctsort_uint64_network(uint64_t* x, size_t n)
+{
+	size_t top;
+
+	top = ctsort_network_size(n);
+
+	for (size_t k = 2; k <= top; k <<= 1)
+	{
+		ctsort_uint64_flip(x, n, k);
+
+		for (size_t j = k >> 2; j > 0; j >>= 1)
+		{
+			ctsort_uint64_clean(x, n, j);
+		}
+	}
+}
+
+#endif
+
+void qsc_ctsort_int32(int32_t* x, size_t n)
+{
+	assert(x != NULL);
+
+	if (x != NULL && n > 1)
+	{
+		ctsort_int32_network(x, n);
+	}
+}
+
+void qsc_ctsort_uint64(uint64_t* x, size_t n)
+{
+	assert(x != NULL);
+
+	if (x != NULL && n > 1)
+	{
+		ctsort_uint64_network(x, n);
+	}
+}
@@ -0,0 +1,96 @@
+/*
+ * 2025 Quantum Resistant Cryptographic Solutions Corporation
+ * All Rights Reserved.
+ *
+ * NOTICE: This software and all accompanying materials are the exclusive 
+ * property of Quantum Resistant Cryptographic Solutions Corporation (QRCS).
+ * The intellectual and technical concepts contained within this implementation 
+ * are proprietary to QRCS and its authorized licensors and are protected under 
+ * applicable U.S. and international copyright, patent, and trade secret laws.
+ *
+ * CRYPTOGRAPHIC STANDARDS:
+ * - This software includes implementations of cryptographic algorithms such as 
+ *   SHA3, AES, and others. These algorithms are public domain or standardized 
+ *   by organizations such as NIST and are NOT the property of QRCS.
+ * - However, all source code, optimizations, and implementations in this library 
+ *   are original works of QRCS and are protected under this license.
+ *
+ * RESTRICTIONS:
+ * - Redistribution, modification, or unauthorized distribution of this software, 
+ *   in whole or in part, is strictly prohibited.
+ * - This software is provided for non-commercial, educational, and research 
+ *   purposes only. Commercial use in any form is expressly forbidden.
+ * - Licensing and authorized distribution are solely at the discretion of QRCS.
+ * - Any use of this software implies acceptance of these restrictions.
+ *
+ * DISCLAIMER:
+ * This software is provided "as is," without warranty of any kind, express or 
+ * implied, including but not limited to warranties of merchantability or fitness 
+ * for a particular purpose. QRCS disclaims all liability for any direct, indirect, 
+ * incidental, or consequential damages resulting from the use or misuse of this software.
+ *
+ * FULL LICENSE:
+ * This software is subject to the **Quantum Resistant Cryptographic Solutions 
+ * Proprietary License (QRCS-PL)**. The complete license terms are included 
+ * in the LICENSE.txt file distributed with this software.
+ *
+ * Written by: John G. Underhill
+ * Contact: john.underhill@protonmail.com
+ */
+
+#ifndef QSC_CTSORT_H
+#define QSC_CTSORT_H
+
+#include "common.h"
+
+QSC_CPLUSPLUS_ENABLED_START
+
+/**
+ * \file ctsort.h
+ * \brief Constant-time integer sorting networks.
+ *
+ * \details
+ * This header defines data-oblivious sorting functions for arrays of 32-bit signed
+ * and 64-bit unsigned integers. The functions implement a bitonic sorting network, in which the
+ * sequence of compare-exchange operations and memory accesses depends only on the array length,
+ * never on the array contents. This makes the functions suitable for sorting secret data,
+ * such as the permutations generated during McEliece key generation, and the fixed-weight
+ * vectors sampled by NTRU.
+ *
+ * Arrays whose length is not a power of two are sorted as though they were padded with
+ * maximum values; comparisons against the virtual padding are omitted, so no additional
+ * memory is required. When the library is compiled with AVX2 or AVX-512 support, the
+ * compare-exchange stages are executed with vector minimum/maximum instructions across
+ * 8 or 16 lanes (32-bit), or 4 or 8 lanes (64-bit), with in-register permutations used for
+ * the short-distance stages.
+ *
+ * \code
+ * // Example usage for sorting an array of 32-bit integers:
+ * int32_t arr[10] = { 34, -7, 23, 0, 5, -3, 12, 99, -45, 8 };
+ * qsc_ctsort_int32(arr, 10);
+ * \endcode
+ *
+ * \section ctsort_links Reference Links:
+ * - <a href="https://sorting.cr.yp.to/">djbsort: Constant-time sorting</a>
+ * - <a href="https://doi.org/10.1145/1468075.1468121">Batcher: Sorting Networks and their Applications</a>
+ */
+
+/**
+ * \brief Sort an array of 32-bit signed integers in ascending order, in constant time.
+ *
+ * \param x:		[int32_t*] The array of 32-bit signed integers to sort.
+ * \param n:		[size_t] The number of elements in the array.
+ */
+QSC_EXPORT_API void qsc_ctsort_int32(int32_t* x, size_t n);
+
+/**
+ * \brief Sort an array of 64-bit unsigned integers in ascending order, in constant time.
+ *
+ * \param x:		[uint64_t*] The array of 64-bit unsigned integers to sort.
+ * \param n:		[size_t] The number of elements in the array.
+ */
+QSC_EXPORT_API void qsc_ctsort_uint64(uint64_t* x, size_t n);
+
+QSC_CPLUSPLUS_ENABLED_END
+
+#endif
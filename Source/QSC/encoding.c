@@ -2,6 +2,807 @@
 #include "memutils.h"
 #include "stringutils.h"
 #include <stdio.h>
+#include <string.h>
+
+#define ENCODING_PEM_LINE_SIZE 64U
+#define ENCODING_PEM_LINE_BYTES 48U
+
+static const char encoding_base64_table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static const uint8_t encoding_base64_dectbl[256] =
+{
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+	0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+	0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+	0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+static const char encoding_hex_table[] = "0123456789ABCDEF";
+
+/* base64 and hex kernels */
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+static __m256i encoding_base64_lookup_avx2(__m256i indices)
+{
+	const __m256i SHFLUT = _mm256_setr_epi8(
+		'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+		'0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+		'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+		'0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+	__m256i lt26;
+	__m256i res;
+
+	/* map each 6-bit index to the offset that translates it into its ascii character */
+	res = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+	lt26 = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+	res = _mm256_or_si256(res, _mm256_and_si256(lt26, _mm256_set1_epi8(13)));
+	res = _mm256_shuffle_epi8(SHFLUT, res);
+
+	return _mm256_add_epi8(res, indices);
+}
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+static __m512i encoding_base64_lookup_avx512(__m512i indices)
+{
+	const __m512i SHFLUT = _mm512_broadcast_i32x4(_mm_setr_epi8(
+		'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+		'0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0));
+	__mmask64 lt26;
+	__m512i res;
+
+	res = _mm512_subs_epu8(indices, _mm512_set1_epi8(51));
+	lt26 = _mm512_cmpgt_epi8_mask(_mm512_set1_epi8(26), indices);
+	res = _mm512_mask_mov_epi8(res, lt26, _mm512_set1_epi8(13));
+	res = _mm512_shuffle_epi8(SHFLUT, res);
+
+	return _mm512_add_epi8(res, indices);
+}
+#endif
+
+static size_t encoding_base64_encode_blocks(char* output, const uint8_t* input, size_t inplen)
+{
+	size_t i;
+
+	i = 0;
+
+#if !defined(QSC_SYSTEM_HAS_AVX2) && !defined(QSC_SYSTEM_HAS_AVX512)
+	(void)output;
+	(void)input;
+	(void)inplen;
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	/* each 128-bit lane holds 12 input bytes; lanes 1-3 are loaded 4 bytes early to avoid reading past the input */
+	const __m512i SHF512 = _mm512_add_epi8(_mm512_broadcast_i32x4(_mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10)),
+		_mm512_set_epi32(0x04040404, 0x04040404, 0x04040404, 0x04040404, 0x04040404, 0x04040404, 0x04040404, 0x04040404,
+			0x04040404, 0x04040404, 0x04040404, 0x04040404, 0, 0, 0, 0));
+
+	while (inplen - i >= 48U)
+	{
+		__m512i t0;
+		__m512i t1;
+		__m512i v;
+
+		v = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i*)(input + i)));
+		v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)(input + i + 8U)), 1);
+		v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)(input + i + 20U)), 2);
+		v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)(input + i + 32U)), 3);
+		v = _mm512_shuffle_epi8(v, SHF512);
+
+		/* split each 24-bit group into four 6-bit indices */
+		t0 = _mm512_mulhi_epu16(_mm512_and_si512(v, _mm512_set1_epi32(0x0FC0FC00)), _mm512_set1_epi32(0x04000040));
+		t1 = _mm512_mullo_epi16(_mm512_and_si512(v, _mm512_set1_epi32(0x003F03F0)), _mm512_set1_epi32(0x01000010));
+		v = encoding_base64_lookup_avx512(_mm512_or_si512(t0, t1));
+		_mm512_storeu_si512((__m512i*)(output + ((i / 3U) * 4U)), v);
+		i += 48U;
+	}
+
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+	const __m256i SHF256 = _mm256_setr_epi8(
+		1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+		5, 4, 6, 5, 8, 7, 9, 8, 11, 10, 12, 11, 14, 13, 15, 14);
+
+	while (inplen - i >= 24U)
+	{
+		__m256i t0;
+		__m256i t1;
+		__m256i v;
+
+		v = _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(input + i)));
+		v = _mm256_inserti128_si256(v, _mm_loadu_si128((const __m128i*)(input + i + 8U)), 1);
+		v = _mm256_shuffle_epi8(v, SHF256);
+
+		t0 = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+		t1 = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+		v = encoding_base64_lookup_avx2(_mm256_or_si256(t0, t1));
+		_mm256_storeu_si256((__m256i*)(output + ((i / 3U) * 4U)), v);
+		i += 24U;
+	}
+
+#endif
+
+	return i;
+}
+
+static size_t encoding_base64_encode_run(char* output, const uint8_t* input, size_t inplen)
+{
+	size_t i;
+	size_t j;
+	uint32_t v;
+
+	/* encode the bulk with the vector kernels, then the remaining groups and padding */
+	i = encoding_base64_encode_blocks(output, input, inplen);
+	j = (i / 3U) * 4U;
+
+	for (; inplen - i >= 3U; i += 3U, j += 4U)
+	{
+		v = ((uint32_t)input[i] << 16) | ((uint32_t)input[i + 1U] << 8) | input[i + 2U];
+		output[j] = encoding_base64_table[(v >> 18) & 0x3FU];
+		output[j + 1U] = encoding_base64_table[(v >> 12) & 0x3FU];
+		output[j + 2U] = encoding_base64_table[(v >> 6) & 0x3FU];
+		output[j + 3U] = encoding_base64_table[v & 0x3FU];
+	}
+
+	if (i < inplen)
+	{
+		v = (uint32_t)input[i] << 16;
+
+		if (inplen - i == 2U)
+		{
+			v |= (uint32_t)input[i + 1U] << 8;
+		}
+
+		output[j] = encoding_base64_table[(v >> 18) & 0x3FU];
+		output[j + 1U] = encoding_base64_table[(v >> 12) & 0x3FU];
+		output[j + 2U] = (inplen - i == 2U) ? encoding_base64_table[(v >> 6) & 0x3FU] : '=';
+		output[j + 3U] = '=';
+		j += 4U;
+	}
+
+	return j;
+}
+
+static size_t encoding_base64_decode_blocks(uint8_t* output, const char* input, size_t count)
+{
+	size_t q;
+
+	q = 0;
+
+#if !defined(QSC_SYSTEM_HAS_AVX2) && !defined(QSC_SYSTEM_HAS_AVX512)
+	(void)output;
+	(void)input;
+	(void)count;
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	const __m512i LUTLO512 = _mm512_broadcast_i32x4(_mm_setr_epi8(
+		0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A));
+	const __m512i LUTHI512 = _mm512_broadcast_i32x4(_mm_setr_epi8(
+		0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10));
+	const __m512i LUTROLL512 = _mm512_broadcast_i32x4(_mm_setr_epi8(
+		0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+	const __m512i PACK512 = _mm512_broadcast_i32x4(_mm_setr_epi8(
+		2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+	const __m512i PERM512 = _mm512_set_epi32(15, 15, 15, 15, 14, 13, 12, 10, 9, 8, 6, 5, 4, 2, 1, 0);
+
+	while (count - q >= 16U)
+	{
+		__mmask64 slash;
+		__m512i hin;
+		__m512i v;
+
+		v = _mm512_loadu_si512((const __m512i*)(input + (q * 4U)));
+		hin = _mm512_and_si512(_mm512_srli_epi32(v, 4), _mm512_set1_epi8(0x2F));
+
+		/* stop at the first block holding a character outside the alphabet, including padding */
+		if (_mm512_test_epi8_mask(_mm512_shuffle_epi8(LUTLO512, _mm512_and_si512(v, _mm512_set1_epi8(0x2F))), _mm512_shuffle_epi8(LUTHI512, hin)) != 0)
+		{
+			break;
+		}
+
+		slash = _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8(0x2F));
+		hin = _mm512_mask_sub_epi8(hin, slash, hin, _mm512_set1_epi8(1));
+		v = _mm512_add_epi8(v, _mm512_shuffle_epi8(LUTROLL512, hin));
+
+		/* merge four 6-bit values into three bytes per 32-bit word, then compact the words */
+		v = _mm512_maddubs_epi16(v, _mm512_set1_epi32(0x01400140));
+		v = _mm512_madd_epi16(v, _mm512_set1_epi32(0x00011000));
+		v = _mm512_shuffle_epi8(v, PACK512);
+		v = _mm512_permutexvar_epi32(PERM512, v);
+		_mm512_mask_storeu_epi8(output + (q * 3U), 0x0000FFFFFFFFFFFFULL, v);
+		q += 16U;
+	}
+
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+	const __m256i LUTLO256 = _mm256_setr_epi8(
+		0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+		0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+	const __m256i LUTHI256 = _mm256_setr_epi8(
+		0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+		0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+	const __m256i LUTROLL256 = _mm256_setr_epi8(
+		0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+	const __m256i PACK256 = _mm256_setr_epi8(
+		2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+		2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+	while (count - q >= 8U)
+	{
+		__m256i hin;
+		__m256i v;
+
+		v = _mm256_loadu_si256((const __m256i*)(input + (q * 4U)));
+		hin = _mm256_and_si256(_mm256_srli_epi32(v, 4), _mm256_set1_epi8(0x2F));
+
+		if (_mm256_testz_si256(_mm256_shuffle_epi8(LUTLO256, _mm256_and_si256(v, _mm256_set1_epi8(0x2F))), _mm256_shuffle_epi8(LUTHI256, hin)) == 0)
+		{
+			break;
+		}
+
+		hin = _mm256_add_epi8(hin, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x2F)));
+		v = _mm256_add_epi8(v, _mm256_shuffle_epi8(LUTROLL256, hin));
+
+		v = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+		v = _mm256_madd_epi16(v, _mm256_set1_epi32(0x00011000));
+		v = _mm256_shuffle_epi8(v, PACK256);
+		v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+		_mm_storeu_si128((__m128i*)(output + (q * 3U)), _mm256_castsi256_si128(v));
+		_mm_storel_epi64((__m128i*)(output + (q * 3U) + 16U), _mm256_extracti128_si256(v, 1));
+		q += 8U;
+	}
+
+#endif
+
+	return q;
+}
+
+static bool encoding_base64_decode_quartets(uint8_t* output, const char* input, size_t count)
+{
+	const char* pinp;
+	uint8_t a;
+	uint8_t b;
+	uint8_t c;
+	uint8_t d;
+	size_t q;
+	bool res;
+
+	/* decode unpadded four character groups; the vector kernels stop at any character they cannot decode */
+	q = encoding_base64_decode_blocks(output, input, count);
+	res = true;
+
+	for (; q < count; ++q)
+	{
+		pinp = input + (q * 4U);
+		a = encoding_base64_dectbl[(uint8_t)pinp[0]];
+		b = encoding_base64_dectbl[(uint8_t)pinp[1]];
+		c = encoding_base64_dectbl[(uint8_t)pinp[2]];
+		d = encoding_base64_dectbl[(uint8_t)pinp[3]];
+
+		/* characters outside the alphabet map to 0xFF */
+		if (((a | b | c | d) & 0xC0U) != 0U)
+		{
+			res = false;
+			break;
+		}
+
+		output[q * 3U] = (uint8_t)((a << 2) | (b >> 4));
+		output[(q * 3U) + 1U] = (uint8_t)((b << 4) | (c >> 2));
+		output[(q * 3U) + 2U] = (uint8_t)((c << 6) | d);
+	}
+
+	return res;
+}
+
+static size_t encoding_base64_decode_final(uint8_t output[3], const char input[4])
+{
+	uint8_t a;
+	uint8_t b;
+	uint8_t c;
+	uint8_t d;
+	size_t res;
+
+	/* the final group may be padded as xx== or xxx= */
+	a = encoding_base64_dectbl[(uint8_t)input[0]];
+	b = encoding_base64_dectbl[(uint8_t)input[1]];
+	c = (input[2] == '=' && input[3] == '=') ? 0U : encoding_base64_dectbl[(uint8_t)input[2]];
+	d = (input[3] == '=') ? 0U : encoding_base64_dectbl[(uint8_t)input[3]];
+	res = (input[3] != '=') ? 3U : (input[2] != '=') ? 2U : 1U;
+
+	if (((a | b | c | d) & 0xC0U) != 0U)
+	{
+		res = 0;
+	}
+	else
+	{
+		output[0] = (uint8_t)((a << 2) | (b >> 4));
+		output[1] = (uint8_t)((b << 4) | (c >> 2));
+		output[2] = (uint8_t)((c << 6) | d);
+	}
+
+	return res;
+}
+
+static size_t encoding_hex_encode_blocks(char* output, const uint8_t* input, size_t inplen)
+{
+	size_t i;
+
+	i = 0;
+
+#if !defined(QSC_SYSTEM_HAS_AVX2) && !defined(QSC_SYSTEM_HAS_AVX512)
+	(void)output;
+	(void)input;
+	(void)inplen;
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	const __m512i HEX512 = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i*)encoding_hex_table));
+	const __m512i LOIDX = _mm512_set_epi64(11, 10, 3, 2, 9, 8, 1, 0);
+	const __m512i HIIDX = _mm512_set_epi64(15, 14, 7, 6, 13, 12, 5, 4);
+
+	while (inplen - i >= 64U)
+	{
+		__m512i hi;
+		__m512i lo;
+		__m512i v;
+
+		v = _mm512_loadu_si512((const __m512i*)(input + i));
+		hi = _mm512_shuffle_epi8(HEX512, _mm512_and_si512(_mm512_srli_epi16(v, 4), _mm512_set1_epi8(0x0F)));
+		lo = _mm512_shuffle_epi8(HEX512, _mm512_and_si512(v, _mm512_set1_epi8(0x0F)));
+		v = _mm512_unpacklo_epi8(hi, lo);
+		hi = _mm512_unpackhi_epi8(hi, lo);
+		_mm512_storeu_si512((__m512i*)(output + (i * 2U)), _mm512_permutex2var_epi64(v, LOIDX, hi));
+		_mm512_storeu_si512((__m512i*)(output + (i * 2U) + 64U), _mm512_permutex2var_epi64(v, HIIDX, hi));
+		i += 64U;
+	}
+
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+	const __m256i HEX256 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)encoding_hex_table));
+
+	while (inplen - i >= 32U)
+	{
+		__m256i hi;
+		__m256i lo;
+		__m256i v;
+
+		v = _mm256_loadu_si256((const __m256i*)(input + i));
+		hi = _mm256_shuffle_epi8(HEX256, _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F)));
+		lo = _mm256_shuffle_epi8(HEX256, _mm256_and_si256(v, _mm256_set1_epi8(0x0F)));
+		v = _mm256_unpacklo_epi8(hi, lo);
+		hi = _mm256_unpackhi_epi8(hi, lo);
+		_mm256_storeu_si256((__m256i*)(output + (i * 2U)), _mm256_permute2x128_si256(v, hi, 0x20));
+		_mm256_storeu_si256((__m256i*)(output + (i * 2U) + 32U), _mm256_permute2x128_si256(v, hi, 0x31));
+		i += 32U;
+	}
+
+#endif
+
+	return i;
+}
+
+static size_t encoding_hex_decode_blocks(uint8_t* output, const char* input, size_t count)
+{
+	size_t i;
+
+	i = 0;
+
+#if !defined(QSC_SYSTEM_HAS_AVX2) && !defined(QSC_SYSTEM_HAS_AVX512)
+	(void)output;
+	(void)input;
+	(void)count;
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	while (count - i >= 32U)
+	{
+		__mmask64 alp;
+		__mmask64 dig;
+		__m512i a;
+		__m512i d;
+		__m512i v;
+
+		v = _mm512_loadu_si512((const __m512i*)(input + (i * 2U)));
+		d = _mm512_sub_epi8(v, _mm512_set1_epi8('0'));
+		a = _mm512_sub_epi8(_mm512_or_si512(v, _mm512_set1_epi8(0x20)), _mm512_set1_epi8('a'));
+		dig = _mm512_cmple_epu8_mask(d, _mm512_set1_epi8(9));
+		alp = _mm512_cmple_epu8_mask(a, _mm512_set1_epi8(5));
+
+		if ((dig | alp) != 0xFFFFFFFFFFFFFFFFULL)
+		{
+			break;
+		}
+
+		v = _mm512_mask_blend_epi8(dig, _mm512_add_epi8(a, _mm512_set1_epi8(10)), d);
+		v = _mm512_maddubs_epi16(v, _mm512_set1_epi16(0x0110));
+		_mm256_storeu_si256((__m256i*)(output + i), _mm512_cvtepi16_epi8(v));
+		i += 32U;
+	}
+
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+	while (count - i >= 16U)
+	{
+		__m256i a;
+		__m256i d;
+		__m256i dig;
+		__m256i v;
+
+		v = _mm256_loadu_si256((const __m256i*)(input + (i * 2U)));
+		d = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+		a = _mm256_sub_epi8(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+		dig = _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(9)), d);
+
+		/* every character must be a decimal digit or a letter from a to f in either case */
+		if (_mm256_movemask_epi8(_mm256_or_si256(dig, _mm256_cmpeq_epi8(_mm256_min_epu8(a, _mm256_set1_epi8(5)), a))) != -1)
+		{
+			break;
+		}
+
+		v = _mm256_blendv_epi8(_mm256_add_epi8(a, _mm256_set1_epi8(10)), d, dig);
+		v = _mm256_maddubs_epi16(v, _mm256_set1_epi16(0x0110));
+		v = _mm256_permute4x64_epi64(_mm256_packus_epi16(v, v), 0xD8);
+		_mm_storeu_si128((__m128i*)(output + i), _mm256_castsi256_si128(v));
+		i += 16U;
+	}
+
+#endif
+
+	return i;
+}
+
+static bool encoding_hex_nibble(char c, uint8_t* nibble)
+{
+	bool res;
+
+	res = true;
+
+	if (c >= '0' && c <= '9')
+	{
+		*nibble = (uint8_t)(c - '0');
+	}
+	else if (c >= 'A' && c <= 'F')
+	{
+		*nibble = (uint8_t)(c - 'A' + 10);
+	}
+	else if (c >= 'a' && c <= 'f')
+	{
+		*nibble = (uint8_t)(c - 'a' + 10);
+	}
+	else
+	{
+		res = false;
+	}
+
+	return res;
+}
+
+/* pem reader */
+
+typedef struct
+{
+	uint8_t* output;		/* the decoded output array */
+	size_t otplen;			/* the output array length */
+	size_t total;			/* the number of bytes written */
+	char carry[4];			/* a partial group split across lines */
+	size_t ccount;			/* the number of characters in the partial group */
+	char pending[4];		/* the last complete group, held back in case it is padded */
+	bool haspending;		/* the pending group is set */
+	bool valid;				/* no decoding error has occurred */
+} encoding_pem_reader;
+
+static void encoding_pem_flush(encoding_pem_reader* rdr)
+{
+	if (rdr->haspending == true && rdr->valid == true)
+	{
+		if (rdr->total + 3U <= rdr->otplen && encoding_base64_decode_quartets(rdr->output + rdr->total, rdr->pending, 1U) == true)
+		{
+			rdr->total += 3U;
+		}
+		else
+		{
+			rdr->valid = false;
+		}
+	}
+
+	rdr->haspending = false;
+}
+
+static void encoding_pem_feed(encoding_pem_reader* rdr, const char* input, size_t inplen)
+{
+	size_t i;
+	size_t q;
+
+	if (rdr->valid == false)
+	{
+		return;
+	}
+
+	i = 0;
+
+	/* complete a group carried over from the previous line */
+	while (rdr->ccount != 0U && i < inplen)
+	{
+		rdr->carry[rdr->ccount] = input[i];
+		++rdr->ccount;
+		++i;
+
+		if (rdr->ccount == 4U)
+		{
+			encoding_pem_flush(rdr);
+			qsc_memutils_copy(rdr->pending, rdr->carry, sizeof(rdr->pending));
+			rdr->haspending = true;
+			rdr->ccount = 0U;
+		}
+	}
+
+	q = (inplen - i) / 4U;
+
+	if (q != 0U && rdr->valid == true)
+	{
+		/* decode the run in place, holding back its last group */
+		encoding_pem_flush(rdr);
+
+		if (rdr->total + ((q - 1U) * 3U) <= rdr->otplen && encoding_base64_decode_quartets(rdr->output + rdr->total, input + i, q - 1U) == true)
+		{
+			rdr->total += (q - 1U) * 3U;
+			qsc_memutils_copy(rdr->pending, input + i + ((q - 1U) * 4U), sizeof(rdr->pending));
+			rdr->haspending = true;
+		}
+		else
+		{
+			rdr->valid = false;
+		}
+
+		i += q * 4U;
+	}
+
+	/* an invalid run is not decoded, so never carry more than the remainder of one group */
+	while (i < inplen && rdr->ccount < sizeof(rdr->carry))
+	{
+		rdr->carry[rdr->ccount] = input[i];
+		++rdr->ccount;
+		++i;
+	}
+}
+
+static bool encoding_pem_finalize(encoding_pem_reader* rdr)
+{
+	uint8_t tmp[3] = { 0 };
+	size_t dlen;
+
+	if (rdr->ccount != 0U && rdr->valid == true)
+	{
+		/* pad a final group that was written without padding */
+		if (rdr->ccount >= 2U)
+		{
+			encoding_pem_flush(rdr);
+
+			while (rdr->ccount < 4U)
+			{
+				rdr->carry[rdr->ccount] = '=';
+				++rdr->ccount;
+			}
+
+			qsc_memutils_copy(rdr->pending, rdr->carry, sizeof(rdr->pending));
+			rdr->haspending = true;
+		}
+		else
+		{
+			rdr->valid = false;
+		}
+	}
+
+	if (rdr->haspending == true && rdr->valid == true)
+	{
+		dlen = encoding_base64_decode_final(tmp, rdr->pending);
+
+		if (dlen != 0U && rdr->total + dlen <= rdr->otplen)
+		{
+			qsc_memutils_copy(rdr->output + rdr->total, tmp, dlen);
+			rdr->total += dlen;
+		}
+		else
+		{
+			rdr->valid = false;
+		}
+	}
+
+	return (rdr->valid == true && rdr->total != 0U);
+}
+
+static bool encoding_der_read_header(const uint8_t* buffer, size_t buflen, qsc_encoding_der_view* view)
+{
+    size_t clen;
+    size_t lnum;
+    size_t pos;
+    uint32_t tnum;
+    uint8_t b;
+    bool res;
+
+    clen = 0U;
+    pos = 0U;
+    res = false;
+
+    if (buflen >= 2U)
+    {
+        b = buffer[0U];
+        tnum = b & 0x1FU;
+        pos = 1U;
+
+        if (tnum == 0x1FU)
+        {
+            /* a long-form tag number must be minimal, fit in four bytes, and be greater than 30 */
+            tnum = 0U;
+            res = (buffer[pos] != 0x80U);
+
+            while (res == true)
+            {
+                if (pos >= buflen || pos > 4U)
+                {
+                    res = false;
+                }
+                else
+                {
+                    tnum = (tnum << 7) | (buffer[pos] & 0x7FU);
+                    ++pos;
+
+                    if ((buffer[pos - 1U] & 0x80U) == 0U)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            res = (res == true && tnum >= 31U);
+        }
+        else
+        {
+            res = true;
+        }
+
+        if (res == true)
+        {
+            res = false;
+
+            /* the length must be definite and in its shortest form */
+            if (pos < buflen)
+            {
+                lnum = buffer[pos];
+                ++pos;
+
+                if ((lnum & 0x80U) == 0U)
+                {
+                    clen = lnum;
+                    res = true;
+                }
+                else
+                {
+                    lnum &= 0x7FU;
+
+                    if (lnum != 0U && lnum <= sizeof(size_t) && buflen - pos >= lnum && buffer[pos] != 0U)
+                    {
+                        for (size_t i = 0U; i < lnum; ++i)
+                        {
+                            clen = (clen << 8) | buffer[pos + i];
+                        }
+
+                        pos += lnum;
+                        res = (clen >= 128U);
+                    }
+                }
+
+                res = (res == true && buflen - pos >= clen);
+            }
+        }
+
+        if (res == true)
+        {
+            view->encoded = buffer;
+            view->enclen = pos + clen;
+            view->value = buffer + pos;
+            view->length = clen;
+            view->tagnumber = tnum;
+            view->tagclass = b & 0xC0U;
+            view->constructed = ((b & 0x20U) != 0U);
+        }
+    }
+
+    return res;
+}
+
+static bool encoding_der_content_size(const qsc_encoding_ber_element* element, size_t* length)
+{
+    size_t clen;
+    size_t total;
+    bool res;
+
+    res = false;
+
+    if (element != NULL && element->indefinite == false)
+    {
+        if (element->constructed == true)
+        {
+            res = true;
+            total = 0U;
+
+            for (size_t i = 0U; i < element->ccount; ++i)
+            {
+                if (encoding_der_content_size(element->children[i], &clen) == false)
+                {
+                    res = false;
+                    break;
+                }
+
+                total += qsc_encoding_der_element_size(element->children[i]->tagnumber, clen);
+            }
+
+            *length = total;
+        }
+        else
+        {
+            *length = element->length;
+            res = (element->length == 0U || element->value != NULL);
+        }
+    }
+
+    return res;
+}
+
+static bool encoding_der_write_element(qsc_encoding_der_writer* writer, const qsc_encoding_ber_element* element)
+{
+    size_t clen;
+    bool res;
+
+    res = false;
+
+    /* the content size of each level is computed before its header is written, so no staging buffer is needed */
+    if (encoding_der_content_size(element, &clen) == true)
+    {
+        if (element->constructed == true)
+        {
+            res = qsc_encoding_der_writer_header(writer, element->tagclass, true, element->tagnumber, clen);
+
+            for (size_t i = 0U; res == true && i < element->ccount; ++i)
+            {
+                res = encoding_der_write_element(writer, element->children[i]);
+            }
+        }
+        else
+        {
+            res = qsc_encoding_der_writer_element(writer, element->tagclass, element->tagnumber, element->value, clen);
+        }
+    }
+
+    return res;
+}
 
 qsc_encoding_ber_element* qsc_encoding_ber_decode_element(const uint8_t* buffer, size_t buflen, size_t* consumed)
 {
@@ -670,65 +1471,28 @@ bool qsc_encoding_base64_decode(uint8_t* output, size_t otplen, const char* inpu
     assert(input != NULL);
     assert(inplen != 0);
 
-	const static int32_t DECTBL[] = 
-	{
-		62, -1, -1, -1, 63, 52, 53, 54, 55, 56, 57, 58,
-		59, 60, 61, -1, -1, -1, -1, -1, -1, -1, 0, 1, 2, 3, 4, 5,
-		6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20,
-		21, 22, 23, 24, 25, -1, -1, -1, -1, -1, -1, 26, 27, 28,
-		29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42,
-		43, 44, 45, 46, 47, 48, 49, 50, 51 
-	};
-
-	size_t i;
-	size_t j;
-	int32_t v;
+	uint8_t tmp[3] = { 0 };
+	size_t cnt;
+	size_t dlen;
 	bool res;
 
     res = false;
 
-    if (output != NULL && input != NULL && inplen != 0)
+    if (output != NULL && input != NULL && inplen != 0 && inplen % 4 == 0)
     {
-        res = true;
-
-        if (input != NULL && output != NULL)
+        if (otplen >= qsc_encoding_base64_decoded_size(input, inplen))
         {
-            if (otplen < qsc_encoding_base64_decoded_size(input, inplen) || inplen % 4 != 0)
-            {
-                res = false;
-            }
+            cnt = inplen / 4;
 
-            if (res == true)
+            /* only the last group may carry padding */
+            if (encoding_base64_decode_quartets(output, input, cnt - 1) == true)
             {
-                for (i = 0; i < inplen; i++)
-                {
-                    if (qsc_encoding_base64_is_valid_char(input[i]) == false)
-                    {
-                        res = false;
-                        break;
-                    }
-                }
+                dlen = encoding_base64_decode_final(tmp, input + inplen - 4);
 
-                if (res == true)
+                if (dlen != 0)
                 {
-                    for (i = 0, j = 0; i < inplen; i += 4, j += 3)
-                    {
-                        v = DECTBL[input[i] - 43];
-                        v = ((uint32_t)v << 6) | DECTBL[input[i + 1] - 43];
-                        v = input[i + 2] == '=' ? (uint32_t)v << 6 : ((uint32_t)v << 6) | DECTBL[input[i + 2] - 43];
-                        v = input[i + 3] == '=' ? (uint32_t)v << 6 : ((uint32_t)v << 6) | DECTBL[input[i + 3] - 43];
-                        output[j] = (v >> 16) & 0xFF;
-
-                        if (input[i + 2] != '=')
-                        {
-                            output[j + 1] = (v >> 8) & 0xFF;
-                        }
-
-                        if (input[i + 3] != '=')
-                        {
-                            output[j + 2] = v & 0xFF;
-                        }
-                    }
+                    qsc_memutils_copy(output + ((cnt - 1) * 3), tmp, dlen);
+                    res = true;
                 }
             }
         }
@@ -766,223 +1530,394 @@ size_t qsc_encoding_base64_decoded_size(const char* input, size_t length)
 		}
 	}
 
-	return res;
+	return res;
+}
+
+void qsc_encoding_base64_encode(char* output, size_t otplen, const uint8_t* input, size_t inplen)
+{
+    assert(output != NULL);
+    assert(otplen != 0);
+    assert(input != NULL);
+    assert(inplen != 0);
+
+	if (output != NULL && input != NULL && inplen != 0 && qsc_encoding_base64_encoded_size(inplen) <= otplen)
+	{
+		encoding_base64_encode_run(output, input, inplen);
+	}
+}
+
+size_t qsc_encoding_base64_encoded_size(size_t length)
+{
+    assert(length != 0);
+
+	size_t ret;
+
+	ret = length;
+
+	if (length % 3 != 0)
+	{
+		ret += 3 - (length % 3);
+	}
+
+	ret /= 3;
+	ret *= 4;
+
+	return ret;
+}
+
+bool qsc_encoding_base64_is_valid_char(char value)
+{
+	bool res;
+
+	if (value >= '0' && value <= '9')
+	{
+		res = true;
+	}
+	else if (value >= 'A' && value <= 'Z')
+	{
+		res = true;
+	}
+	else if (value >= 'a' && value <= 'z')
+	{
+		res = true;
+	}
+	else if (value == '+' || value == '/' || value == '=')
+	{
+		res = true;
+	}
+	else
+	{
+		res = false;
+	}
+
+	return res;
+}
+
+qsc_encoding_ber_element* qsc_encoding_der_decode_element(const uint8_t* buffer, size_t buflen, size_t* consumed)
+{
+    assert(buffer != NULL);
+    assert(buflen != 0);
+    assert(consumed != NULL);
+
+    qsc_encoding_ber_element* elem;
+
+    elem = NULL;
+
+    if (buffer != NULL && buflen != 0 && consumed != NULL)
+    {
+        elem = qsc_encoding_ber_decode_element(buffer, buflen, consumed);
+
+        if (elem != NULL)
+        {
+            if (elem->indefinite == true)
+            {
+                /* DER disallows indefinite lengths */
+                encoding_ber_free_element(elem);
+                elem = NULL;
+            }
+        }
+    }
+
+    return elem;
+}
+
+size_t qsc_encoding_der_encode_element(qsc_encoding_ber_element* element, uint8_t* buffer, size_t buflen)
+{
+    assert(element != NULL);
+    assert(buffer != NULL);
+    assert(buflen != 0);
+
+    qsc_encoding_der_writer writer;
+    size_t total;
+
+    total = 0U;
+
+    if (element != NULL && buffer != NULL && buflen != 0U)
+    {
+        qsc_encoding_der_writer_initialize(&writer, buffer, buflen);
+
+        if (encoding_der_write_element(&writer, element) == true)
+        {
+            total = qsc_encoding_der_writer_finalize(&writer);
+        }
+    }
+
+    return total;
+}
+
+size_t qsc_encoding_der_element_size(uint32_t tagnum, size_t length)
+{
+    return qsc_encoding_der_header_size(tagnum, length) + length;
+}
+
+size_t qsc_encoding_der_header_size(uint32_t tagnum, size_t length)
+{
+    size_t res;
+
+    /* the identifier and the first length octet */
+    res = 2U;
+
+    if (tagnum >= 31U)
+    {
+        for (uint32_t t = tagnum; t != 0U; t >>= 7)
+        {
+            ++res;
+        }
+    }
+
+    if (length >= 128U)
+    {
+        for (size_t t = length; t != 0U; t >>= 8)
+        {
+            ++res;
+        }
+    }
+
+    return res;
+}
+
+bool qsc_encoding_der_reader_enter(const qsc_encoding_der_view* view, qsc_encoding_der_reader* child)
+{
+    assert(view != NULL);
+    assert(child != NULL);
+
+    bool res;
+
+    res = false;
+
+    if (view != NULL && child != NULL && view->constructed == true)
+    {
+        qsc_encoding_der_reader_initialize(child, view->value, view->length);
+        res = true;
+    }
+
+    return res;
+}
+
+bool qsc_encoding_der_reader_expect(qsc_encoding_der_reader* reader, uint8_t tagclass, uint32_t tagnum, qsc_encoding_der_view* view)
+{
+    assert(reader != NULL);
+    assert(view != NULL);
+
+    bool res;
+
+    res = false;
+
+    if (qsc_encoding_der_reader_peek(reader, view) == true)
+    {
+        if (view->tagclass == tagclass && view->tagnumber == tagnum)
+        {
+            reader->position += view->enclen;
+            res = true;
+        }
+    }
+
+    return res;
 }
 
-void qsc_encoding_base64_encode(char* output, size_t otplen, const uint8_t* input, size_t inplen)
+void qsc_encoding_der_reader_initialize(qsc_encoding_der_reader* reader, const uint8_t* buffer, size_t buflen)
 {
-    assert(output != NULL);
-    assert(otplen != 0);
-    assert(input != NULL);
-    assert(inplen != 0);
+    assert(reader != NULL);
 
-	const char ENCTBL[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    if (reader != NULL)
+    {
+        reader->buffer = buffer;
+        reader->length = (buffer != NULL) ? buflen : 0U;
+        reader->position = 0U;
+    }
+}
 
-	size_t i;
-	size_t j;
-	size_t v;
+bool qsc_encoding_der_reader_next(qsc_encoding_der_reader* reader, qsc_encoding_der_view* view)
+{
+    assert(reader != NULL);
+    assert(view != NULL);
 
-	if (output != NULL && input != NULL && inplen != 0 && qsc_encoding_base64_encoded_size(inplen) <= otplen)
-	{
-		for (i = 0, j = 0; i < inplen; i += 3, j += 4)
-		{
-			v = input[i];
-			v = i + 1 < inplen ? v << 8 | input[i + 1] : v << 8;
-			v = i + 2 < inplen ? v << 8 | input[i + 2] : v << 8;
+    bool res;
 
-			output[j] = ENCTBL[(v >> 18) & 0x3F];
-			output[j + 1] = ENCTBL[(v >> 12) & 0x3F];
+    res = qsc_encoding_der_reader_peek(reader, view);
 
-			if (i + 1 < inplen)
-			{
-				output[j + 2] = ENCTBL[(v >> 6) & 0x3F];
-			}
-			else
-			{
-				output[j + 2] = '=';
-			}
+    if (res == true)
+    {
+        reader->position += view->enclen;
+    }
 
-			if (i + 2 < inplen)
-			{
-				output[j + 3] = ENCTBL[v & 0x3F];
-			}
-			else
-			{
-				output[j + 3] = '=';
-			}
-		}
-	}
+    return res;
 }
 
-size_t qsc_encoding_base64_encoded_size(size_t length)
+bool qsc_encoding_der_reader_peek(const qsc_encoding_der_reader* reader, qsc_encoding_der_view* view)
 {
-    assert(length != 0);
-
-	size_t ret;
+    assert(reader != NULL);
+    assert(view != NULL);
 
-	ret = length;
+    bool res;
 
-	if (length % 3 != 0)
-	{
-		ret += 3 - (length % 3);
-	}
+    res = false;
 
-	ret /= 3;
-	ret *= 4;
+    if (reader != NULL && view != NULL && reader->position < reader->length)
+    {
+        res = encoding_der_read_header(reader->buffer + reader->position, reader->length - reader->position, view);
+    }
 
-	return ret;
+    return res;
 }
 
-bool qsc_encoding_base64_is_valid_char(char value)
+size_t qsc_encoding_der_reader_remaining(const qsc_encoding_der_reader* reader)
 {
-	bool res;
+    assert(reader != NULL);
 
-	if (value >= '0' && value <= '9')
-	{
-		res = true;
-	}
-	else if (value >= 'A' && value <= 'Z')
-	{
-		res = true;
-	}
-	else if (value >= 'a' && value <= 'z')
-	{
-		res = true;
-	}
-	else if (value == '+' || value == '/' || value == '=')
-	{
-		res = true;
-	}
-	else
-	{
-		res = false;
-	}
+    size_t res;
 
-	return res;
+    res = 0U;
+
+    if (reader != NULL)
+    {
+        res = reader->length - reader->position;
+    }
+
+    return res;
 }
 
-qsc_encoding_ber_element* qsc_encoding_der_decode_element(const uint8_t* buffer, size_t buflen, size_t* consumed)
+bool qsc_encoding_der_writer_element(qsc_encoding_der_writer* writer, uint8_t tagclass, uint32_t tagnum, const uint8_t* value, size_t length)
 {
-    assert(buffer != NULL);
-    assert(buflen != 0);
-    assert(consumed != NULL);
+    assert(writer != NULL);
 
-    qsc_encoding_ber_element* elem;
+    bool res;
 
-    elem = NULL;
+    res = false;
 
-    if (buffer != NULL && buflen != 0 && consumed != NULL)
+    if (writer != NULL && (value != NULL || length == 0U))
     {
-        elem = qsc_encoding_ber_decode_element(buffer, buflen, consumed);
-
-        if (elem != NULL)
+        if (qsc_encoding_der_writer_header(writer, tagclass, false, tagnum, length) == true)
         {
-            if (elem->indefinite == true)
+            if (writer->length - writer->position >= length)
             {
-                /* DER disallows indefinite lengths */
-                encoding_ber_free_element(elem);
-                elem = NULL;
+                if (length != 0U)
+                {
+                    qsc_memutils_copy(writer->buffer + writer->position, value, length);
+                }
+
+                writer->position += length;
+                res = true;
             }
         }
     }
 
-    return elem;
+    if (res == false && writer != NULL)
+    {
+        writer->valid = false;
+    }
+
+    return res;
 }
 
-size_t qsc_encoding_der_encode_element(qsc_encoding_ber_element* element, uint8_t* buffer, size_t buflen)
+size_t qsc_encoding_der_writer_finalize(const qsc_encoding_der_writer* writer)
 {
-    uint8_t* contbuf;
-    const size_t TEMP_BUF_SIZE = 4096U;
-    size_t total;
-    size_t taglen;
-    size_t lfield;
-    size_t contlen;
-    bool bcond;
+    assert(writer != NULL);
 
-    contlen = 0U;
-    lfield = 0U;
-    taglen = 0U;
-    total = 0U;
+    size_t res;
 
-    if (element != NULL && buffer != NULL && buflen != 0U)
+    res = 0U;
+
+    if (writer != NULL && writer->valid == true)
     {
-        /* For constructed elements, recursively encode each child element into a temporary buffer.
-        * Here we allocate a temporary buffer. In a real implementation, you may wish to compute the
-        * required size dynamically or reuse an allocation strategy.
-        */
-        contbuf = (uint8_t*)qsc_memutils_malloc(TEMP_BUF_SIZE);
+        res = writer->position;
+    }
 
-        if (contbuf != NULL)
-        {
-            /* DER does not allow indefinite-length encoding. */
-            if (element->indefinite == false)
-            {
-                /* Encode the tag using the BER tag encoding routine */
-                taglen = qsc_encoding_ber_encode_tag(element->tagclass, element->constructed, element->tagnumber, buffer, buflen);
+    return res;
+}
 
-                if ((taglen != 0U) && (taglen <= buflen))
-                {
-                    bcond = true;
-                    total += taglen;
+bool qsc_encoding_der_writer_header(qsc_encoding_der_writer* writer, uint8_t tagclass, bool constructed, uint32_t tagnum, size_t length)
+{
+    assert(writer != NULL);
 
-                    if (element->constructed == true)
-                    {
-                        contlen = 0U;
+    uint8_t* pbuf;
+    size_t cnt;
+    size_t hlen;
+    bool res;
 
-                        for (size_t i = 0U; i < element->ccount; i++)
-                        {
-                            size_t clen;
+    res = false;
 
-                            clen = qsc_encoding_der_encode_element(element->children[i], contbuf + contlen, TEMP_BUF_SIZE - contlen);
-                            
-                            if (clen == 0U)
-                            {
-                                bcond = false;
-                                break;
-                            }
+    if (writer != NULL && writer->valid == true)
+    {
+        hlen = qsc_encoding_der_header_size(tagnum, length);
 
-                            contlen += clen;
-                        }
-                    }
-                    else
-                    {
-                        /* For primitive elements, the content is the raw value. */
-                        contlen = element->length;
-                    }
+        if (writer->length - writer->position >= hlen)
+        {
+            pbuf = writer->buffer + writer->position;
+            writer->position += hlen;
+            *pbuf = (uint8_t)((tagclass & 0xC0U) | (constructed == true ? 0x20U : 0x00U));
 
-                    if (bcond == true)
-                    {
-                        /* Encode the length field (definite-length only) */
-                        lfield = qsc_encoding_ber_encode_length(contlen, buffer + total, buflen - total);
+            if (tagnum < 31U)
+            {
+                *pbuf |= (uint8_t)tagnum;
+                ++pbuf;
+            }
+            else
+            {
+                /* base-128 tag number, big-endian with continuation bits */
+                *pbuf |= 0x1FU;
+                ++pbuf;
+                cnt = 0U;
 
-                        if (lfield != 0U && (total + lfield) <= buflen)
-                        {
-                            total += lfield;
+                for (uint32_t t = tagnum; t != 0U; t >>= 7)
+                {
+                    ++cnt;
+                }
 
-                            /* Copy the content bytes into the output buffer */
-                            if ((total + contlen) <= buflen)
-                            {
-                                if (element->constructed == true)
-                                {
-                                    qsc_memutils_copy(buffer + total, contbuf, contlen);
-                                }
-                                else
-                                {
-                                    qsc_memutils_copy(buffer + total, element->value, contlen);
-                                }
+                while (cnt != 0U)
+                {
+                    --cnt;
+                    *pbuf = (uint8_t)(((tagnum >> (7U * cnt)) & 0x7FU) | (cnt != 0U ? 0x80U : 0x00U));
+                    ++pbuf;
+                }
+            }
 
-                                total += contlen;
-                            }
-                        }
-                    }
+            if (length < 128U)
+            {
+                *pbuf = (uint8_t)length;
+            }
+            else
+            {
+                cnt = 0U;
+
+                for (size_t t = length; t != 0U; t >>= 8)
+                {
+                    ++cnt;
                 }
 
-                qsc_memutils_alloc_free(contbuf);
+                *pbuf = (uint8_t)(0x80U | cnt);
+                ++pbuf;
+
+                while (cnt != 0U)
+                {
+                    --cnt;
+                    *pbuf = (uint8_t)(length >> (8U * cnt));
+                    ++pbuf;
+                }
             }
+
+            res = true;
+        }
+        else
+        {
+            writer->valid = false;
         }
     }
 
-    return total;
+    return res;
+}
+
+void qsc_encoding_der_writer_initialize(qsc_encoding_der_writer* writer, uint8_t* buffer, size_t buflen)
+{
+    assert(writer != NULL);
+
+    if (writer != NULL)
+    {
+        writer->buffer = buffer;
+        writer->length = (buffer != NULL) ? buflen : 0U;
+        writer->position = 0U;
+        writer->valid = (buffer != NULL);
+    }
 }
 
 bool qsc_encoding_hex_decode(const char* input, size_t inplen, uint8_t* output, size_t otplen, size_t* declen)
@@ -993,63 +1928,27 @@ bool qsc_encoding_hex_decode(const char* input, size_t inplen, uint8_t* output,
     assert(otplen != 0);
     assert(declen != NULL);
 
+    uint8_t nibble1;
+    uint8_t nibble2;
     size_t req;
     bool res;
 
     req = inplen / 2;
     res = false;
 
-    if (inplen % 2 == 0 && req >= otplen && input != NULL && output != NULL && declen != NULL)
+    if (inplen % 2 == 0 && otplen >= req && input != NULL && output != NULL && declen != NULL)
     {
         res = true;
 
-        for (size_t i = 0; i < req; i++)
+        for (size_t i = encoding_hex_decode_blocks(output, input, req); i < req; i++)
         {
-            char c1;
-            char c2;
-            uint8_t nibble1;
-            uint8_t nibble2;
-
-            c1 = input[2 * i];
-            c2 = input[2 * i + 1];
-
-            if (c1 >= '0' && c1 <= '9')
-            {
-                nibble1 = c1 - '0';
-            }
-            else if (c1 >= 'A' && c1 <= 'F')
-            {
-                nibble1 = c1 - 'A' + 10;
-            }
-            else if (c1 >= 'a' && c1 <= 'f')
-            {
-                nibble1 = c1 - 'a' + 10;
-            }
-            else
-            {
-                res = false;
-                break;
-            }
-
-            if (c2 >= '0' && c2 <= '9')
-            {
-                nibble2 = c2 - '0';
-            }
-            else if (c2 >= 'A' && c2 <= 'F')
-            {
-                nibble2 = c2 - 'A' + 10;
-            }
-            else if (c2 >= 'a' && c2 <= 'f')
-            {
-                nibble2 = c2 - 'a' + 10;
-            }
-            else
+            if (encoding_hex_nibble(input[2 * i], &nibble1) == false || encoding_hex_nibble(input[2 * i + 1], &nibble2) == false)
             {
                 res = false;
                 break;
             }
 
-            output[i] = (nibble1 << 4) | nibble2;
+            output[i] = (uint8_t)((nibble1 << 4) | nibble2);
         }
 
         *declen = req;
@@ -1071,12 +1970,10 @@ bool qsc_encoding_hex_encode(const uint8_t* input, size_t inplen, char* output,
 
     if (output != NULL && input != NULL && otplen >= (inplen * 2) + 1)
     {
-        static const char hex_digits[] = "0123456789ABCDEF";
-
-        for (size_t i = 0; i < inplen; i++)
+        for (size_t i = encoding_hex_encode_blocks(output, input, inplen); i < inplen; i++)
         {
-            output[2 * i] = hex_digits[(input[i] >> 4) & 0x0F];
-            output[2 * i + 1] = hex_digits[input[i] & 0x0F];
+            output[2 * i] = encoding_hex_table[(input[i] >> 4) & 0x0F];
+            output[2 * i + 1] = encoding_hex_table[input[i] & 0x0F];
         }
 
         output[inplen * 2] = '\0';
@@ -1088,204 +1985,132 @@ bool qsc_encoding_hex_encode(const uint8_t* input, size_t inplen, char* output,
 
 bool qsc_encoding_pem_decode(const char* input, uint8_t* output, size_t otplen, size_t* declen)
 {
+    encoding_pem_reader rdr;
+    const char* lend;
+    const char* lpos;
     const char* lstart;
-    const char* ppos;
-    char* b64data;
-    size_t linelen;
-    size_t pinplen;
-    size_t b64idx;
-    char ch;
+    const char* pend;
+    size_t rlen;
     bool res;
 
-    b64idx = 0U;
-    pinplen = 0U;
     res = false;
 
     if ((input != NULL) && (output != NULL) && (otplen != 0U))
     {
-        pinplen = qsc_stringutils_string_size(input);
-        b64data = qsc_memutils_malloc(pinplen + 1U);
-
-        if (b64data != NULL)
+        qsc_memutils_clear(&rdr, sizeof(rdr));
+        rdr.output = output;
+        rdr.otplen = otplen;
+        rdr.valid = true;
+        lstart = input;
+        pend = input + qsc_stringutils_string_size(input);
+
+        /* decode each body line directly into the output, skipping the header and footer lines */
+        while (lstart < pend && rdr.valid == true)
         {
-            b64idx = 0U;
-            lstart = input;
-            ppos = input;
+            lend = (const char*)memchr(lstart, '\n', (size_t)(pend - lstart));
 
-            /* process the PEM input line by line */
-            while (*ppos != '\0')
+            if (lend == NULL)
             {
-                if (*ppos == '\n')
-                {
-                    linelen = (size_t)(ppos - lstart);
-
-                    if (linelen > 0U)
-                    {
-                        /* skip the line if its first non-whitespace character is '-' */
-                        if (lstart[0] != '-')
-                        {
-                            for (size_t i = 0U; i < linelen; i++)
-                            {
-                                ch = lstart[i];
-
-                                if ((ch != ' ') && (ch != '\r') && (ch != '\t'))
-                                {
-                                    b64data[b64idx] = ch;
-                                    ++b64idx;
-                                }
-                            }
-                        }
-                    }
-
-                    lstart = ppos + 1;
-                }
-
-                ++ppos;
+                lend = pend;
             }
 
-            /* process any final line (if there is no trailing newline) */
-            if (lstart < ppos)
+            if (lstart[0] != '-')
             {
-                linelen = (size_t)(ppos - lstart);
+                lpos = lstart;
 
-                if (linelen > 0U)
+                /* feed each run of characters between whitespace */
+                while (lpos < lend && rdr.valid == true)
                 {
-                    if (lstart[0] != '-')
-                    {
-                        for (size_t i = 0U; i < linelen; i++)
-                        {
-                            ch = lstart[i];
+                    rlen = 0U;
 
-                            if ((ch != ' ') && (ch != '\r') && (ch != '\t'))
-                            {
-                                b64data[b64idx] = ch;
-                                ++b64idx;
-                            }
-                        }
+                    while ((lpos + rlen < lend) && (lpos[rlen] != ' ') && (lpos[rlen] != '\r') && (lpos[rlen] != '\t'))
+                    {
+                        ++rlen;
                     }
-                }
-            }
-
-            b64data[b64idx] = '\0';
-
-            /* pad the Base64 string if necessary so that its length is a multiple of 4 */
-            {
-                size_t pad;
-                size_t rmd;
-
-                rmd = b64idx % 4;
-
-                if (rmd != 0U)
-                {
-                    pad = 4U - rmd;
 
-                    /* assuming our temporary buffer is large enough */
-                    for (size_t i = 0U; i < pad; i++)
+                    if (rlen != 0U)
                     {
-                        b64data[b64idx] = '=';
-                        ++b64idx;
+                        encoding_pem_feed(&rdr, lpos, rlen);
                     }
 
-                    b64data[b64idx] = '\0';
+                    lpos += rlen + 1U;
                 }
             }
 
-            /* determine the expected decoded size */
-            {
-                size_t dexp;
-
-                dexp = qsc_encoding_base64_decoded_size(b64data, b64idx);
-
-                if (dexp <= otplen)
-                {
-                    res = qsc_encoding_base64_decode(output, otplen, b64data, b64idx);
+            lstart = lend + 1;
+        }
 
-                    if (declen != NULL)
-                    {
-                        *declen = dexp;
-                    }
-                }
-            }
+        res = encoding_pem_finalize(&rdr);
 
-            qsc_memutils_alloc_free(b64data);
+        if (res == true && declen != NULL)
+        {
+            *declen = rdr.total;
         }
     }
 
     return res;
 }
 
-bool qsc_encoding_pem_encode(const char* label, char* output, size_t otplen, const uint8_t* data, size_t data_len)
+bool qsc_encoding_pem_encode(const char* label, char* output, size_t otplen, const uint8_t* data, size_t datalen)
 {
-    /* insert newline every 64 base64 characters */
-    const size_t LINE_LENGTH = 64;
     char header[128];
     char footer[128];
-    char* b64data;
-    size_t b64len;
     size_t cnklen;
     size_t pidx;
     int32_t hdrlen;
     int32_t ftrlen;
     bool res;
 
-    /* create header and footer lines */
-    hdrlen = snprintf(header, sizeof(header), "-----BEGIN %s-----\n", label);
-    ftrlen = snprintf(footer, sizeof(footer), "-----END %s-----\n", label);
-    b64data = NULL;
     res = false;
 
-    if (hdrlen != 0 && ftrlen != 0)
+    if (label != NULL && output != NULL && data != NULL && datalen != 0U)
     {
-        /* compute the length required for Base64 encoding */
-        b64len = qsc_encoding_base64_encoded_size(data_len);
-        /* allocate a temporary buffer for the Base64 encoded data */
-        /* +1 for null terminator */
-        b64data = qsc_memutils_malloc(b64len + 1);
+        /* create header and footer lines */
+        hdrlen = snprintf(header, sizeof(header), "-----BEGIN %s-----\n", label);
+        ftrlen = snprintf(footer, sizeof(footer), "-----END %s-----\n", label);
 
-        if (b64data != NULL)
+        if (hdrlen > 0 && ftrlen > 0 && (size_t)hdrlen < sizeof(header) && (size_t)ftrlen < sizeof(footer) &&
+            qsc_encoding_pem_encoded_size(label, datalen) <= otplen)
         {
-            qsc_memutils_clear(b64data, b64len + 1);
-            qsc_encoding_base64_encode(b64data, b64len + 1, data, data_len);
-            pidx = 0;
+            qsc_memutils_copy(output, header, (size_t)hdrlen);
+            pidx = (size_t)hdrlen;
 
-            /* write the header line */
-            if (pidx + hdrlen < otplen)
+            /* encode each line of the body straight into the output, inserting the line breaks inline */
+            for (size_t i = 0; i < datalen; i += ENCODING_PEM_LINE_BYTES)
             {
-                qsc_memutils_copy(output + pidx, header, hdrlen);
-                pidx += hdrlen;
+                cnklen = (datalen - i >= ENCODING_PEM_LINE_BYTES) ? ENCODING_PEM_LINE_BYTES : (datalen - i);
+                pidx += encoding_base64_encode_run(output + pidx, data + i, cnklen);
+                output[pidx] = '\n';
+                ++pidx;
+            }
 
-                /* write the base64 data, inserting newline characters every LINE_LENGTH characters */
-                for (size_t i = 0; i < b64len; i += LINE_LENGTH)
-                {
-                    cnklen = (b64len - i >= LINE_LENGTH) ? LINE_LENGTH : (b64len - i);
+            qsc_memutils_copy(output + pidx, footer, (size_t)ftrlen);
+            pidx += (size_t)ftrlen;
+            output[pidx] = '\0';
+            res = true;
+        }
+    }
 
-                    if (pidx + cnklen + 1 < otplen)
-                    {
-                        qsc_memutils_copy(output + pidx, b64data + i, cnklen);
-                        pidx += cnklen;
-                        output[pidx] = '\n';
-                        ++pidx;
-                    }
-                }
+    return res;
+}
 
-                /* append the footer */
-                if (pidx + ftrlen < otplen)
-                {
-                    qsc_memutils_copy(output + pidx, footer, ftrlen);
-                    pidx += ftrlen;
+size_t qsc_encoding_pem_encoded_size(const char* label, size_t datalen)
+{
+    assert(label != NULL);
 
-                    /* null-terminate the output */
-                    if (pidx < otplen)
-                    {
-                        output[pidx] = '\0';
-                    }
-                    
-                    res = true;
-                }
-            }
+    size_t b64len;
+    size_t lablen;
+    size_t res;
 
-            qsc_memutils_alloc_free(b64data);
-        }
+    res = 0U;
+
+    if (label != NULL && datalen != 0U)
+    {
+        /* the header and footer, the base64 body with a line break per line, and the null terminator */
+        lablen = qsc_stringutils_string_size(label);
+        b64len = qsc_encoding_base64_encoded_size(datalen);
+        res = (sizeof("-----BEGIN -----\n") - 1U) + (sizeof("-----END -----\n") - 1U) + (lablen * 2U);
+        res += b64len + ((b64len + ENCODING_PEM_LINE_SIZE - 1U) / ENCODING_PEM_LINE_SIZE) + 1U;
     }
 
     return res;
@@ -221,9 +221,54 @@ QSC_EXPORT_API typedef struct qsc_encoding_ber_element
     size_t ccount;          /*!< The number of child elements pointed to by the children array. */
 } qsc_encoding_ber_element;
 
+/*!
+ * \brief A view of a DER element within the buffer it was read from.
+ *
+ * The view holds pointers into the caller's buffer rather than copies, so it is only valid
+ * for as long as that buffer is unchanged. No memory is allocated when reading elements.
+ */
+QSC_EXPORT_API typedef struct qsc_encoding_der_view
+{
+    const uint8_t* encoded; /*!< Pointer to the first byte of the element's tag. */
+    size_t enclen;          /*!< The total length of the element, including the tag and length fields. */
+    const uint8_t* value;   /*!< Pointer to the first byte of the element's contents. */
+    size_t length;          /*!< The length of the element's contents. */
+    uint32_t tagnumber;     /*!< The tag number. */
+    uint8_t tagclass;       /*!< The tag class (e.g., QSC_ENCODING_BER_CLASS_UNIVERSAL). */
+    bool constructed;       /*!< true if the element is constructed; its contents can be read with qsc_encoding_der_reader_enter. */
+} qsc_encoding_der_view;
+
+/*!
+ * \brief A cursor over a sequence of DER elements.
+ */
+QSC_EXPORT_API typedef struct qsc_encoding_der_reader
+{
+    const uint8_t* buffer;  /*!< The DER encoded buffer. */
+    size_t length;          /*!< The length of the buffer. */
+    size_t position;        /*!< The offset of the next element. */
+} qsc_encoding_der_reader;
+
+/*!
+ * \brief A single-pass DER writer over a caller supplied buffer.
+ *
+ * Constructed elements are written by emitting the header with the precomputed length of their contents
+ * (see qsc_encoding_der_element_size), followed by the child elements.
+ */
+QSC_EXPORT_API typedef struct qsc_encoding_der_writer
+{
+    uint8_t* buffer;        /*!< The output buffer. */
+    size_t length;          /*!< The length of the output buffer. */
+    size_t position;        /*!< The number of bytes written. */
+    bool valid;             /*!< Cleared if a write did not fit in the buffer. */
+} qsc_encoding_der_writer;
+
 /*!
  * \brief Decodes a Base64 string to a byte array.
  *
+ * \details
+ * The input length must be a multiple of four, and padding is only accepted in the final group.
+ * Groups are validated and decoded in 256 or 512-bit blocks when AVX2 or AVX-512 is available.
+ *
  * \param output:	[uint8_t*] The byte array receiving the decoded output.
  * \param otplen:	[size_t] The size of the output byte array.
  * \param input:	[const char*] The Base64 encoded input string.
@@ -400,9 +445,9 @@ QSC_EXPORT_API qsc_encoding_ber_element* qsc_encoding_der_decode_element(const u
  * length, the encoding fails.
  *
  * For primitive elements, the value is taken from element->value.
- * For constructed elements, the function recursively encodes all child elements into a
- * temporary buffer, computes the total content length, and then encodes the tag and
- * definite-length followed by the content.
+ * For constructed elements, the content length is computed from the child elements before
+ * the tag and definite-length are written, and the children are then encoded directly into
+ * the output buffer, without a temporary buffer.
  *
  * \param element  [qsc_encoding_ber_element*] Pointer to the element to be encoded.
  * \param buffer   [uint8_t*] Pointer to the output buffer.
@@ -412,6 +457,140 @@ QSC_EXPORT_API qsc_encoding_ber_element* qsc_encoding_der_decode_element(const u
  */
 QSC_EXPORT_API size_t qsc_encoding_der_encode_element(qsc_encoding_ber_element* element, uint8_t* buffer, size_t buflen);
 
+/*!
+ * \brief Gets the total encoded size of a DER element.
+ *
+ * \param tagnum       [uint32_t] The tag number.
+ * \param length       [size_t] The length of the element's contents.
+ *
+ * \return             [size_t] Returns the size of the tag, length, and contents fields.
+ */
+QSC_EXPORT_API size_t qsc_encoding_der_element_size(uint32_t tagnum, size_t length);
+
+/*!
+ * \brief Gets the size of a DER element's tag and length fields.
+ *
+ * \param tagnum       [uint32_t] The tag number.
+ * \param length       [size_t] The length of the element's contents.
+ *
+ * \return             [size_t] Returns the size of the header.
+ */
+QSC_EXPORT_API size_t qsc_encoding_der_header_size(uint32_t tagnum, size_t length);
+
+/*!
+ * \brief Initializes a reader over the contents of a constructed element.
+ *
+ * \param view         [const qsc_encoding_der_view*] The constructed element.
+ * \param child        [qsc_encoding_der_reader*] The reader to initialize over the element's contents.
+ *
+ * \return             [bool] Returns true if the element is constructed.
+ */
+QSC_EXPORT_API bool qsc_encoding_der_reader_enter(const qsc_encoding_der_view* view, qsc_encoding_der_reader* child);
+
+/*!
+ * \brief Reads the next element if it has the expected tag.
+ *
+ * \details
+ * The reader only advances if the tag matches, so this can be used to read OPTIONAL fields.
+ *
+ * \param reader       [qsc_encoding_der_reader*] The reader.
+ * \param tagclass     [uint8_t] The expected tag class.
+ * \param tagnum       [uint32_t] The expected tag number.
+ * \param view         [qsc_encoding_der_view*] Receives the element.
+ *
+ * \return             [bool] Returns true if a valid element with the expected tag was read.
+ */
+QSC_EXPORT_API bool qsc_encoding_der_reader_expect(qsc_encoding_der_reader* reader, uint8_t tagclass, uint32_t tagnum, qsc_encoding_der_view* view);
+
+/*!
+ * \brief Initializes a DER reader.
+ *
+ * \param reader       [qsc_encoding_der_reader*] The reader.
+ * \param buffer       [const uint8_t*] The DER encoded buffer; it must remain unchanged while views into it are in use.
+ * \param buflen       [size_t] The length of the buffer.
+ */
+QSC_EXPORT_API void qsc_encoding_der_reader_initialize(qsc_encoding_der_reader* reader, const uint8_t* buffer, size_t buflen);
+
+/*!
+ * \brief Reads the next element and advances the reader past it.
+ *
+ * \details
+ * Indefinite lengths, lengths and tag numbers that are not in their shortest form,
+ * and elements that extend past the end of the buffer are rejected.
+ *
+ * \param reader       [qsc_encoding_der_reader*] The reader.
+ * \param view         [qsc_encoding_der_view*] Receives the element.
+ *
+ * \return             [bool] Returns true if a valid element was read.
+ */
+QSC_EXPORT_API bool qsc_encoding_der_reader_next(qsc_encoding_der_reader* reader, qsc_encoding_der_view* view);
+
+/*!
+ * \brief Reads the next element without advancing the reader.
+ *
+ * \param reader       [const qsc_encoding_der_reader*] The reader.
+ * \param view         [qsc_encoding_der_view*] Receives the element.
+ *
+ * \return             [bool] Returns true if a valid element was read.
+ */
+QSC_EXPORT_API bool qsc_encoding_der_reader_peek(const qsc_encoding_der_reader* reader, qsc_encoding_der_view* view);
+
+/*!
+ * \brief Gets the number of unread bytes.
+ *
+ * \param reader       [const qsc_encoding_der_reader*] The reader.
+ *
+ * \return             [size_t] Returns the number of bytes remaining.
+ */
+QSC_EXPORT_API size_t qsc_encoding_der_reader_remaining(const qsc_encoding_der_reader* reader);
+
+/*!
+ * \brief Writes a primitive element.
+ *
+ * \param writer       [qsc_encoding_der_writer*] The writer.
+ * \param tagclass     [uint8_t] The tag class.
+ * \param tagnum       [uint32_t] The tag number.
+ * \param value        [const uint8_t*] The element's contents; may be NULL if length is zero.
+ * \param length       [size_t] The length of the contents.
+ *
+ * \return             [bool] Returns true if the element fit in the buffer.
+ */
+QSC_EXPORT_API bool qsc_encoding_der_writer_element(qsc_encoding_der_writer* writer, uint8_t tagclass, uint32_t tagnum, const uint8_t* value, size_t length);
+
+/*!
+ * \brief Gets the number of bytes written.
+ *
+ * \param writer       [const qsc_encoding_der_writer*] The writer.
+ *
+ * \return             [size_t] Returns the encoded length, or zero if any write did not fit in the buffer.
+ */
+QSC_EXPORT_API size_t qsc_encoding_der_writer_finalize(const qsc_encoding_der_writer* writer);
+
+/*!
+ * \brief Writes an element's tag and length fields.
+ *
+ * \details
+ * For a constructed element, the length is the precomputed total size of the child elements that follow.
+ *
+ * \param writer       [qsc_encoding_der_writer*] The writer.
+ * \param tagclass     [uint8_t] The tag class.
+ * \param constructed  [bool] Set to true for a constructed element.
+ * \param tagnum       [uint32_t] The tag number.
+ * \param length       [size_t] The length of the element's contents.
+ *
+ * \return             [bool] Returns true if the header fit in the buffer.
+ */
+QSC_EXPORT_API bool qsc_encoding_der_writer_header(qsc_encoding_der_writer* writer, uint8_t tagclass, bool constructed, uint32_t tagnum, size_t length);
+
+/*!
+ * \brief Initializes a DER writer.
+ *
+ * \param writer       [qsc_encoding_der_writer*] The writer.
+ * \param buffer       [uint8_t*] The output buffer.
+ * \param buflen       [size_t] The length of the output buffer.
+ */
+QSC_EXPORT_API void qsc_encoding_der_writer_initialize(qsc_encoding_der_writer* writer, uint8_t* buffer, size_t buflen);
+
 /*!
  * \brief Decodes a hexadecimal string into binary data.
  *
@@ -440,6 +619,10 @@ QSC_EXPORT_API bool qsc_encoding_hex_encode(const uint8_t* input, size_t inplen,
 /*!
  *  \brief Decodes a PEM-formatted string into binary data.
  *
+ * \details
+ * The body is decoded line by line directly into the output buffer in a single pass, without an intermediate copy.
+ * Header and footer lines are skipped, and spaces, tabs, and carriage returns are ignored.
+ *
  * \param input:	[const char*] A null-terminated PEM string (including header/footer).
  * \param output:	[uint8_t*] Buffer to receive decoded binary data.
  * \param otplen	[size_t] Length of the output buffer.
@@ -452,6 +635,9 @@ QSC_EXPORT_API bool qsc_encoding_pem_decode(const char* input, uint8_t* output,
 /*!
  * \brief Encodes binary data in PEM format.
  *
+ * \details
+ * Each 64 character line is encoded directly into the output buffer; use qsc_encoding_pem_encoded_size to size the buffer.
+ *
  * \param label		[const char*] The string label title.
  * \param output	[char*] Buffer to receive the PEM text.
  * \param otplen	[size_t] Length of the output buffer.
@@ -462,6 +648,16 @@ QSC_EXPORT_API bool qsc_encoding_pem_decode(const char* input, uint8_t* output,
  */
 QSC_EXPORT_API bool qsc_encoding_pem_encode(const char* label, char* output, size_t otplen, const uint8_t* data, size_t datalen);
 
+/*!
+ * \brief Gets the size of the character array required to PEM encode binary data.
+ *
+ * \param label		[const char*] The string label title.
+ * \param datalen	[size_t] Length of the binary data.
+ *
+ * \return          [size_t] Returns the PEM text length, including the header, footer, line breaks, and null terminator.
+ */
+QSC_EXPORT_API size_t qsc_encoding_pem_encoded_size(const char* label, size_t datalen);
+
 QSC_CPLUSPLUS_ENABLED_END
 
 #endif
@@ -23,6 +23,31 @@ void qsc_falcon_generate_keypair(uint8_t* publickey, uint8_t* privatekey, bool (
 #endif
 }
 
+bool qsc_falcon_generate_keypair_workspace(uint8_t* publickey, uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t), uint8_t* workspace, size_t wslen)
+{
+	assert(publickey != NULL);
+	assert(privatekey != NULL);
+	assert(rng_generate != NULL);
+	assert(workspace != NULL);
+	assert(wslen >= QSC_FALCON_WORKSPACE_SIZE);
+	assert(((uintptr_t)workspace % sizeof(uint64_t)) == 0U);
+
+	bool res;
+
+	res = false;
+
+	if (publickey != NULL && privatekey != NULL && rng_generate != NULL && workspace != NULL && wslen >= QSC_FALCON_WORKSPACE_SIZE && ((uintptr_t)workspace % sizeof(uint64_t)) == 0U)
+	{
+#if defined(QSC_FALCON_AVX2)
+		res = (qsc_falcon_avx2_generate_keypair_workspace(publickey, privatekey, rng_generate, workspace) == 0);
+#else
+		res = (qsc_falcon_ref_generate_keypair_workspace(publickey, privatekey, rng_generate, workspace) == 0);
+#endif
+	}
+
+	return res;
+}
+
 void qsc_falcon_sign(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t))
 {
 	assert(signedmsg != NULL);
@@ -38,6 +63,33 @@ void qsc_falcon_sign(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message
 #endif
 }
 
+bool qsc_falcon_sign_workspace(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t), uint8_t* workspace, size_t wslen)
+{
+	assert(signedmsg != NULL);
+	assert(smsglen != NULL);
+	assert(message != NULL);
+	assert(privatekey != NULL);
+	assert(rng_generate != NULL);
+	assert(workspace != NULL);
+	assert(wslen >= QSC_FALCON_WORKSPACE_SIZE);
+	assert(((uintptr_t)workspace % sizeof(uint64_t)) == 0U);
+
+	bool res;
+
+	res = false;
+
+	if (signedmsg != NULL && smsglen != NULL && message != NULL && privatekey != NULL && rng_generate != NULL && workspace != NULL && wslen >= QSC_FALCON_WORKSPACE_SIZE && ((uintptr_t)workspace % sizeof(uint64_t)) == 0U)
+	{
+#if defined(QSC_FALCON_AVX2)
+		res = (qsc_falcon_avx2_sign_workspace(signedmsg, smsglen, message, msglen, privatekey, rng_generate, workspace) == 0);
+#else
+		res = (qsc_falcon_ref_sign_workspace(signedmsg, smsglen, message, msglen, privatekey, rng_generate, workspace) == 0);
+#endif
+	}
+
+	return res;
+}
+
 bool qsc_falcon_verify(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey)
 {
 	assert(message != NULL);
@@ -55,3 +107,34 @@ bool qsc_falcon_verify(uint8_t* message, size_t* msglen, const uint8_t* signedms
 
 	return res;
 }
+
+bool qsc_falcon_verify_workspace(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey, uint8_t* workspace, size_t wslen)
+{
+	assert(message != NULL);
+	assert(msglen != NULL);
+	assert(signedmsg != NULL);
+	assert(publickey != NULL);
+	assert(workspace != NULL);
+	assert(wslen >= QSC_FALCON_WORKSPACE_SIZE);
+	assert(((uintptr_t)workspace % sizeof(uint64_t)) == 0U);
+
+	bool res;
+
+	res = false;
+
+	if (message != NULL && msglen != NULL && signedmsg != NULL && publickey != NULL && workspace != NULL && wslen >= QSC_FALCON_WORKSPACE_SIZE && ((uintptr_t)workspace % sizeof(uint64_t)) == 0U)
+	{
+#if defined(QSC_FALCON_AVX2)
+		res = qsc_falcon_avx2_open_workspace(message, msglen, signedmsg, smsglen, publickey, workspace);
+#else
+		res = qsc_falcon_ref_open_workspace(message, msglen, signedmsg, smsglen, publickey, workspace);
+#endif
+	}
+
+	return res;
+}
+
+size_t qsc_falcon_workspace_size(void)
+{
+	return (size_t)QSC_FALCON_WORKSPACE_SIZE;
+}
@@ -117,6 +117,18 @@ QSC_CPLUSPLUS_ENABLED_START
 	#error "The Falcon parameter set is invalid!"
 #endif
 
+/*!
+ * \def QSC_FALCON_WORKSPACE_SIZE
+ * \brief [uint8_t] The byte size of the temporary workspace used by the key generation, signing, and verification functions.
+ */
+#if defined(QSC_FALCON_S3SHAKE256F512)
+	#define QSC_FALCON_WORKSPACE_SIZE (72ULL * 512ULL)
+#elif defined(QSC_FALCON_S5SHAKE256F1024)
+	#define QSC_FALCON_WORKSPACE_SIZE (72ULL * 1024ULL)
+#else
+	#error "The Falcon parameter set is invalid!"
+#endif
+
 /*!
  * \def QSC_FALCON_ALGNAME
  * \brief [char*] The formal algorithm name.
@@ -134,6 +146,26 @@ QSC_CPLUSPLUS_ENABLED_START
  */
 QSC_EXPORT_API void qsc_falcon_generate_keypair(uint8_t* publickey, uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t));
 
+/**
+ * \brief Generates a Falcon public/private key-pair, using a caller supplied workspace for the temporary values.
+ *
+ * \details
+ * The workspace can be reused across calls, so repeated operations run without large stack frames.
+ * It holds secret intermediate values, and should be erased with qsc_memutils_secure_erase before it is released.
+ *
+ * \warning Arrays must be sized to QSC_FALCON_PUBLICKEY_SIZE and QSC_FALCON_PRIVATEKEY_SIZE.
+ * The workspace must be 8-byte aligned.
+ *
+ * \param publickey:	[uint8_t*] Pointer to the public verification-key array.
+ * \param privatekey:	[uint8_t*] Pointer to the private signature-key array.
+ * \param rng_generate:	[bool (*)(uint8_t*, size_t)] Pointer to the random generator function.
+ * \param workspace:	[uint8_t*] Pointer to the workspace.
+ * \param wslen:		[size_t] The workspace length, at least qsc_falcon_workspace_size() bytes.
+ *
+ * \return				[bool] Returns true for success, false if the workspace is too small or misaligned, or key generation failed.
+ */
+QSC_EXPORT_API bool qsc_falcon_generate_keypair_workspace(uint8_t* publickey, uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t), uint8_t* workspace, size_t wslen);
+
 /**
  * \brief Signs a message and returns an array containing the signature followed by the message.
  *
@@ -148,6 +180,25 @@ QSC_EXPORT_API void qsc_falcon_generate_keypair(uint8_t* publickey, uint8_t* pri
  */
 QSC_EXPORT_API void qsc_falcon_sign(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t));
 
+/**
+ * \brief Signs a message using a caller supplied workspace for the temporary values.
+ *
+ * \warning The signed message array must be sized to the size of the message plus QSC_FALCON_SIGNATURE_SIZE.
+ * The workspace must be 8-byte aligned, and holds secret intermediate values after the call.
+ *
+ * \param signedmsg:	[uint8_t*] Pointer to the signed-message array.
+ * \param smsglen:		[size_t*] Pointer to the signed message length.
+ * \param message:		[const uint8_t*] Pointer to the message array.
+ * \param msglen:		[size_t] The message array length.
+ * \param privatekey:	[const uint8_t*] Pointer to the private signature-key.
+ * \param rng_generate: [bool (*)(uint8_t*, size_t)] Pointer to the random generator function.
+ * \param workspace:	[uint8_t*] Pointer to the workspace.
+ * \param wslen:		[size_t] The workspace length, at least qsc_falcon_workspace_size() bytes.
+ *
+ * \return				[bool] Returns true for success, false if the workspace is too small or misaligned, or signing failed.
+ */
+QSC_EXPORT_API bool qsc_falcon_sign_workspace(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t), uint8_t* workspace, size_t wslen);
+
 /**
  * \brief Verifies a signature-message pair with the public key.
  *
@@ -161,6 +212,28 @@ QSC_EXPORT_API void qsc_falcon_sign(uint8_t* signedmsg, size_t* smsglen, const u
  */
 QSC_EXPORT_API bool qsc_falcon_verify(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey);
 
+/**
+ * \brief Verifies a signature-message pair with the public key, using a caller supplied workspace for the temporary values.
+ *
+ * \param message:		[uint8_t*] Pointer to the message output array.
+ * \param msglen:		[size_t*] Pointer to the message length.
+ * \param signedmsg:	[const uint8_t*] Pointer to the signed message array.
+ * \param smsglen:		[size_t] The signed message length.
+ * \param publickey:	[const uint8_t*] Pointer to the public verification-key array.
+ * \param workspace:	[uint8_t*] Pointer to the 8-byte aligned workspace.
+ * \param wslen:		[size_t] The workspace length, at least qsc_falcon_workspace_size() bytes.
+ *
+ * \return				[bool] Returns true for success, false if the workspace is too small or misaligned, or the signature is invalid.
+ */
+QSC_EXPORT_API bool qsc_falcon_verify_workspace(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey, uint8_t* workspace, size_t wslen);
+
+/**
+ * \brief Gets the size of the workspace used by the workspace variants of the Falcon functions.
+ *
+ * \return				[size_t] Returns the workspace size in bytes.
+ */
+QSC_EXPORT_API size_t qsc_falcon_workspace_size(void);
+
 QSC_CPLUSPLUS_ENABLED_END
 
 #endif
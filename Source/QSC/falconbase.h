@@ -276,6 +276,15 @@ extern const uint32_t falcon_l2bound[FALCON_L2BOUND_SIZE];
 */
 int32_t qsc_falcon_ref_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t));
 
+/**
+* \brief Generates a key-pair using a caller supplied temporary buffer.
+*
+* \param b:	[uint8_t*] The temporary buffer, at least FALCON_KEYGEN_TEMP_9 (512) or FALCON_KEYGEN_TEMP_10 (1024) bytes
+*
+* \return		[int32_t] Returns 0 for success
+*/
+int32_t qsc_falcon_ref_generate_keypair_workspace(uint8_t* pk, uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t), uint8_t* b);
+
 /**
 * \brief Takes the message as input and returns an array containing the signature followed by the message
 *
@@ -290,6 +299,15 @@ int32_t qsc_falcon_ref_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_gen
 */
 int32_t qsc_falcon_ref_sign(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t));
 
+/**
+* \brief Signs a message using a caller supplied temporary buffer.
+*
+* \param b:	[uint8_t*] The temporary buffer, at least 72 * N bytes
+*
+* \return		[int32_t] Returns 0 for success
+*/
+int32_t qsc_falcon_ref_sign_workspace(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t), uint8_t* b);
+
 /**
 * \brief Verifies a signature-message pair with the public key.
 *
@@ -303,6 +321,15 @@ int32_t qsc_falcon_ref_sign(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t
 */
 bool qsc_falcon_ref_open(uint8_t* m, size_t* mlen, const uint8_t* sm, size_t smlen, const uint8_t* pk);
 
+/**
+* \brief Verifies a signature-message pair using a caller supplied temporary buffer.
+*
+* \param b:	[uint8_t*] The temporary buffer, at least 2 * N bytes
+*
+* \return		[bool] Returns true for success
+*/
+bool qsc_falcon_ref_open_workspace(uint8_t* m, size_t* mlen, const uint8_t* sm, size_t smlen, const uint8_t* pk, uint8_t* b);
+
 QSC_CPLUSPLUS_ENABLED_END
 
 /* \endcond */
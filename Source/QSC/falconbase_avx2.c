@@ -8771,6 +8771,12 @@ static void falcon_sign_dyn(int16_t* sig, qsc_keccak_state* kctx, const int8_t*
 int32_t qsc_falcon_avx2_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
 {
 	uint8_t b[FALCON_KEYGEN_TEMP_9];
+
+	return qsc_falcon_avx2_generate_keypair_workspace(pk, sk, rng_generate, b);
+}
+
+int32_t qsc_falcon_avx2_generate_keypair_workspace(uint8_t* pk, uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t), uint8_t* b)
+{
 	int8_t f[512];
 	int8_t g[512];
 	int8_t F[512];
@@ -8840,8 +8846,14 @@ int32_t qsc_falcon_avx2_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_ge
 
 int32_t qsc_falcon_avx2_sign(uint8_t *sm, size_t *smlen, const uint8_t *m, size_t mlen, const uint8_t *sk, bool (*rng_generate)(uint8_t*, size_t))
 {
-	int16_t sig[512];
 	uint8_t b[72 * 512];
+
+	return qsc_falcon_avx2_sign_workspace(sm, smlen, m, mlen, sk, rng_generate, b);
+}
+
+int32_t qsc_falcon_avx2_sign_workspace(uint8_t *sm, size_t *smlen, const uint8_t *m, size_t mlen, const uint8_t *sk, bool (*rng_generate)(uint8_t*, size_t), uint8_t* b)
+{
+	int16_t sig[512];
 	int8_t f[512];
 	int8_t g[512];
 	int8_t F[512];
@@ -8954,11 +8966,17 @@ int32_t qsc_falcon_avx2_sign(uint8_t *sm, size_t *smlen, const uint8_t *m, size_
 }
 
 bool qsc_falcon_avx2_open(uint8_t *m, size_t *mlen, const uint8_t *sm, size_t smlen, const uint8_t *pk)
+{
+	uint8_t b[2 * 512];
+
+	return qsc_falcon_avx2_open_workspace(m, mlen, sm, smlen, pk, b);
+}
+
+bool qsc_falcon_avx2_open_workspace(uint8_t *m, size_t *mlen, const uint8_t *sm, size_t smlen, const uint8_t *pk, uint8_t* b)
 {
 	uint16_t h[512];
 	uint16_t hm[512];
 	int16_t sig[512];
-	uint8_t b[2 * 512];
 	const uint8_t* esig;
 	qsc_keccak_state kctx;
 	size_t msglen;
@@ -9041,8 +9059,14 @@ bool qsc_falcon_avx2_open(uint8_t *m, size_t *mlen, const uint8_t *sm, size_t sm
 
 int32_t qsc_falcon_avx2_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
 {
-	uint16_t h[1024];
 	uint8_t b[FALCON_KEYGEN_TEMP_10];
+
+	return qsc_falcon_avx2_generate_keypair_workspace(pk, sk, rng_generate, b);
+}
+
+int32_t qsc_falcon_avx2_generate_keypair_workspace(uint8_t* pk, uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t), uint8_t* b)
+{
+	uint16_t h[1024];
 	int8_t f[1024];
 	int8_t g[1024];
 	int8_t F[1024];
@@ -9112,8 +9136,14 @@ int32_t qsc_falcon_avx2_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_ge
 
 int32_t qsc_falcon_avx2_sign(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
 {
-	int16_t sig[1024] = { 0 };
 	uint8_t b[72 * 1024];
+
+	return qsc_falcon_avx2_sign_workspace(sm, smlen, m, mlen, sk, rng_generate, b);
+}
+
+int32_t qsc_falcon_avx2_sign_workspace(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t), uint8_t* b)
+{
+	int16_t sig[1024] = { 0 };
 	int8_t f[1024];
 	int8_t g[1024];
 	int8_t F[1024];
@@ -9224,11 +9254,17 @@ int32_t qsc_falcon_avx2_sign(uint8_t* sm, size_t* smlen, const uint8_t* m, size_
 }
 
 bool qsc_falcon_avx2_open(uint8_t* m, size_t* mlen, const uint8_t* sm, size_t smlen, const uint8_t* pk)
+{
+	uint8_t b[2 * 1024];
+
+	return qsc_falcon_avx2_open_workspace(m, mlen, sm, smlen, pk, b);
+}
+
+bool qsc_falcon_avx2_open_workspace(uint8_t* m, size_t* mlen, const uint8_t* sm, size_t smlen, const uint8_t* pk, uint8_t* b)
 {
 	uint16_t h[1024];
 	uint16_t hm[1024];
 	int16_t sig[1024];
-	uint8_t b[2 * 1024];
 	const uint8_t* esig;
 	qsc_keccak_state kctx;
 	size_t siglen;
@@ -0,0 +1,637 @@
+#include "filecrypto.h"
+#include "async.h"
+#include "csp.h"
+#include "fileutils.h"
+#include "intutils.h"
+#include "memutils.h"
+#include "stringutils.h"
+
+typedef void (*filecrypto_cipher)(void* state, uint8_t* output, const uint8_t* input, size_t length);
+
+static void filecrypto_aes_ctrbe(void* state, uint8_t* output, const uint8_t* input, size_t length)
+{
+	qsc_aes_ctrbe_transform((qsc_aes_state*)state, output, input, length);
+}
+
+static void filecrypto_chacha(void* state, uint8_t* output, const uint8_t* input, size_t length)
+{
+	qsc_chacha_transform((qsc_chacha_state*)state, output, input, length);
+}
+
+static size_t filecrypto_segment_next(const qsc_fileutils_mapped_file* map, size_t offset)
+{
+	size_t slen;
+
+	slen = qsc_intutils_min(map->length - offset, QSC_FILECRYPTO_SEGMENT_SIZE);
+
+	/* start reading the following segment while this one is processed */
+	if (offset + slen < map->length)
+	{
+		qsc_fileutils_map_advise(map, offset + slen, QSC_FILECRYPTO_SEGMENT_SIZE, qsc_fileutils_map_advice_willneed);
+	}
+
+	return slen;
+}
+
+static void filecrypto_keccak_update(qsc_keccak_state* ctx, qsc_keccak_rate rate, const qsc_fileutils_mapped_file* map, bool kmac)
+{
+	size_t oft;
+	size_t slen;
+
+	oft = 0U;
+
+	while (oft < map->length)
+	{
+		slen = filecrypto_segment_next(map, oft);
+
+		if (kmac == true)
+		{
+			qsc_kmac_update(ctx, rate, map->data + oft, slen);
+		}
+		else
+		{
+			qsc_sha3_update(ctx, rate, map->data + oft, slen);
+		}
+
+		oft += slen;
+	}
+}
+
+static bool filecrypto_transform(filecrypto_cipher cipher, void* state, const char* inpath, const char* outpath)
+{
+	qsc_fileutils_mapped_file imap;
+	qsc_fileutils_mapped_file omap;
+	size_t oft;
+	size_t slen;
+	bool inplace;
+	bool res;
+
+	res = false;
+	inplace = qsc_stringutils_strings_equal(inpath, outpath);
+
+	if (qsc_fileutils_map(&imap, inpath, inplace, qsc_fileutils_map_advice_sequential) == true)
+	{
+		if (inplace == true)
+		{
+			omap = imap;
+			res = true;
+		}
+		else
+		{
+			res = qsc_fileutils_map_create(&omap, outpath, imap.length);
+		}
+
+		if (res == true)
+		{
+			oft = 0U;
+
+			while (oft < imap.length)
+			{
+				slen = filecrypto_segment_next(&imap, oft);
+				cipher(state, omap.data + oft, imap.data + oft, slen);
+				oft += slen;
+			}
+
+			if (inplace == false)
+			{
+				res = qsc_fileutils_map_flush(&omap);
+				qsc_fileutils_unmap(&omap);
+			}
+		}
+
+		qsc_fileutils_unmap(&imap);
+	}
+
+	return res;
+}
+
+static const uint8_t filecrypto_magic[4U] = { 0x51U, 0x53U, 0x43U, 0x46U };
+
+typedef struct
+{
+	const qsc_filecrypto_header* header;	/* the file header */
+	const uint8_t* hdrser;					/* the serialized header, the associated data of each segment */
+	const qsc_fileutils_mapped_file* imap;	/* the input file view */
+	const uint8_t* key;						/* the cipher key */
+	size_t keylen;							/* the cipher key length */
+	uint8_t* output;						/* the output segments array */
+	const uint8_t* input;					/* the input segments array */
+	size_t first;							/* the first segment processed by this worker */
+	size_t stride;							/* the number of workers */
+	size_t count;							/* the total number of segments */
+	bool encrypt;							/* the transformation direction */
+	bool result;							/* the worker result */
+} filecrypto_worker_state;
+
+static size_t filecrypto_mac_size(size_t keylen)
+{
+	return (keylen == QSC_RCS512_KEY_SIZE) ? QSC_RCS512_MAC_SIZE : QSC_RCS256_MAC_SIZE;
+}
+
+static void filecrypto_header_serialize(uint8_t* output, const qsc_filecrypto_header* header)
+{
+	qsc_memutils_clear(output, QSC_FILECRYPTO_HEADER_SIZE);
+	qsc_memutils_copy(output, filecrypto_magic, sizeof(filecrypto_magic));
+	output[4U] = header->version;
+	output[5U] = header->cipher;
+	output[6U] = header->maclen;
+	qsc_intutils_le32to8(output + 8U, header->segment);
+	qsc_intutils_le64to8(output + 16U, header->length);
+	qsc_memutils_copy(output + 24U, header->nonce, QSC_RCS_NONCE_SIZE);
+}
+
+static bool filecrypto_header_deserialize(qsc_filecrypto_header* header, const uint8_t* input, size_t flen)
+{
+	size_t mlen;
+	size_t scnt;
+	bool res;
+
+	res = false;
+
+	if (flen >= QSC_FILECRYPTO_HEADER_SIZE && qsc_memutils_are_equal(input, filecrypto_magic, sizeof(filecrypto_magic)) == true)
+	{
+		header->version = input[4U];
+		header->cipher = input[5U];
+		header->maclen = input[6U];
+		header->segment = qsc_intutils_le8to32(input + 8U);
+		header->length = qsc_intutils_le8to64(input + 16U);
+		qsc_memutils_copy(header->nonce, input + 24U, QSC_RCS_NONCE_SIZE);
+
+		if (header->version == QSC_FILECRYPTO_VERSION && header->segment != 0U && header->segment <= QSC_FILECRYPTO_SEGMENT_SIZE &&
+			((header->cipher == (uint8_t)RCS256 && header->maclen == QSC_RCS256_MAC_SIZE) || 
+			(header->cipher == (uint8_t)RCS512 && header->maclen == QSC_RCS512_MAC_SIZE)) &&
+			header->length <= (uint64_t)(flen - QSC_FILECRYPTO_HEADER_SIZE))
+		{
+			/* the header fields are not authenticated yet; the bytes after the plain-text must hold exactly one mac code per segment,
+			   compared by division so a forged length or segment cannot wrap the file size */
+			mlen = flen - QSC_FILECRYPTO_HEADER_SIZE - (size_t)header->length;
+			scnt = (size_t)(header->length / header->segment) + ((header->length % header->segment != 0U) ? 1U : 0U);
+			res = (mlen % header->maclen == 0U && mlen / header->maclen == scnt);
+		}
+	}
+
+	return res;
+}
+
+static bool filecrypto_segment_transform(const filecrypto_worker_state* state, size_t index, uint8_t* output, const uint8_t* input, size_t length)
+{
+	uint8_t nonce[QSC_RCS_NONCE_SIZE] = { 0U };
+	qsc_rcs_keyparams kp = { 0 };
+	qsc_rcs_state ctx;
+	bool res;
+
+	/* the segment index is added to the upper 64 bits of the nonce; the cipher counter uses the lower bits */
+	qsc_memutils_copy(nonce, state->header->nonce, QSC_RCS_NONCE_SIZE);
+	qsc_intutils_le64to8(nonce + 24U, qsc_intutils_le8to64(nonce + 24U) + (uint64_t)index);
+
+	kp.key = state->key;
+	kp.keylen = state->keylen;
+	kp.nonce = nonce;
+
+	qsc_rcs_initialize(&ctx, &kp, state->encrypt);
+	qsc_rcs_set_associated(&ctx, state->hdrser, QSC_FILECRYPTO_HEADER_SIZE);
+	res = qsc_rcs_transform(&ctx, output, input, length);
+	qsc_rcs_dispose(&ctx);
+
+	return res;
+}
+
+static void filecrypto_segment_worker(void* state)
+{
+	filecrypto_worker_state* pws;
+	size_t cseg;
+	size_t ilen;
+	size_t olen;
+	size_t plen;
+	size_t poft;
+	size_t i;
+
+	pws = (filecrypto_worker_state*)state;
+	cseg = (size_t)pws->header->segment + pws->header->maclen;
+	ilen = pws->encrypt ? pws->header->segment : cseg;
+	olen = pws->encrypt ? cseg : pws->header->segment;
+	pws->result = true;
+
+	for (i = pws->first; i < pws->count; i += pws->stride)
+	{
+		poft = i * (size_t)pws->header->segment;
+		plen = qsc_intutils_min((size_t)pws->header->length - poft, (size_t)pws->header->segment);
+
+		/* fault in the next segment of this worker while the current one is processed */
+		if (i + pws->stride < pws->count)
+		{
+			qsc_fileutils_map_advise(pws->imap, (size_t)(pws->input - pws->imap->data) + ((i + pws->stride) * ilen), ilen, qsc_fileutils_map_advice_willneed);
+		}
+
+		if (filecrypto_segment_transform(pws, i, pws->output + (i * olen), pws->input + (i * ilen), plen) == false)
+		{
+			pws->result = false;
+			break;
+		}
+	}
+}
+
+static bool filecrypto_segments_process(filecrypto_worker_state* tstate, size_t threads)
+{
+	filecrypto_worker_state wstate[QSC_FILECRYPTO_THREADS_MAX];
+	qsc_thread handles[QSC_FILECRYPTO_THREADS_MAX];
+	size_t i;
+	bool res;
+
+	if (threads == 0U)
+	{
+		threads = qsc_async_processor_count();
+	}
+
+	threads = qsc_intutils_min(threads, QSC_FILECRYPTO_THREADS_MAX);
+	threads = qsc_intutils_min(threads, tstate->count);
+	res = true;
+
+	if (threads <= 1U)
+	{
+		tstate->first = 0U;
+		tstate->stride = 1U;
+		filecrypto_segment_worker(tstate);
+		res = tstate->result;
+	}
+	else
+	{
+		for (i = 0U; i < threads; ++i)
+		{
+			wstate[i] = *tstate;
+			wstate[i].first = i;
+			wstate[i].stride = threads;
+			handles[i] = qsc_async_thread_create(&filecrypto_segment_worker, &wstate[i]);
+		}
+
+		qsc_async_thread_wait_all(handles, threads);
+
+		for (i = 0U; i < threads; ++i)
+		{
+			res = res && wstate[i].result;
+		}
+	}
+
+	return res;
+}
+
+bool qsc_filecrypto_aes_ctrbe_transform(qsc_aes_state* state, const char* inpath, const char* outpath)
+{
+	assert(state != NULL);
+	assert(inpath != NULL);
+	assert(outpath != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (state != NULL && inpath != NULL && outpath != NULL)
+	{
+		res = filecrypto_transform(&filecrypto_aes_ctrbe, state, inpath, outpath);
+	}
+
+	return res;
+}
+
+bool qsc_filecrypto_chacha_transform(qsc_chacha_state* ctx, const char* inpath, const char* outpath)
+{
+	assert(ctx != NULL);
+	assert(inpath != NULL);
+	assert(outpath != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (ctx != NULL && inpath != NULL && outpath != NULL)
+	{
+		res = filecrypto_transform(&filecrypto_chacha, ctx, inpath, outpath);
+	}
+
+	return res;
+}
+
+bool qsc_filecrypto_decrypt(const uint8_t* key, size_t keylen, const char* inpath, const char* outpath, size_t threads)
+{
+	assert(key != NULL);
+	assert(keylen == QSC_RCS256_KEY_SIZE || keylen == QSC_RCS512_KEY_SIZE);
+	assert(inpath != NULL);
+	assert(outpath != NULL);
+
+	filecrypto_worker_state wstate = { 0 };
+	qsc_filecrypto_header header;
+	qsc_fileutils_mapped_file imap;
+	qsc_fileutils_mapped_file omap;
+	bool res;
+
+	res = false;
+
+	if (key != NULL && (keylen == QSC_RCS256_KEY_SIZE || keylen == QSC_RCS512_KEY_SIZE) && inpath != NULL && outpath != NULL)
+	{
+		if (qsc_fileutils_map(&imap, inpath, false, qsc_fileutils_map_advice_sequential) == true)
+		{
+			if (filecrypto_header_deserialize(&header, imap.data, imap.length) == true && 
+				header.maclen == filecrypto_mac_size(keylen) && header.cipher == (uint8_t)((keylen == QSC_RCS512_KEY_SIZE) ? RCS512 : RCS256))
+			{
+				if (qsc_fileutils_map_create(&omap, outpath, (size_t)header.length) == true)
+				{
+					wstate.header = &header;
+					wstate.hdrser = imap.data;
+					wstate.imap = &imap;
+					wstate.key = key;
+					wstate.keylen = keylen;
+					wstate.output = omap.data;
+					wstate.input = imap.data + QSC_FILECRYPTO_HEADER_SIZE;
+					wstate.count = (size_t)((header.length + header.segment - 1U) / header.segment);
+					wstate.encrypt = false;
+
+					res = filecrypto_segments_process(&wstate, threads);
+
+					if (res == true)
+					{
+						res = qsc_fileutils_map_flush(&omap);
+					}
+
+					qsc_fileutils_unmap(&omap);
+
+					if (res == false)
+					{
+						/* do not leave a partially decrypted file behind */
+						qsc_fileutils_delete(outpath);
+					}
+				}
+			}
+
+			qsc_fileutils_unmap(&imap);
+		}
+	}
+
+	return res;
+}
+
+bool qsc_filecrypto_decrypt_range(uint8_t* output, size_t offset, size_t length, const uint8_t* key, size_t keylen, const char* fpath)
+{
+	assert(output != NULL);
+	assert(key != NULL);
+	assert(keylen == QSC_RCS256_KEY_SIZE || keylen == QSC_RCS512_KEY_SIZE);
+	assert(fpath != NULL);
+
+	filecrypto_worker_state wstate = { 0 };
+	qsc_filecrypto_header header;
+	qsc_fileutils_mapped_file imap;
+	uint8_t* tmps;
+	size_t cseg;
+	size_t i;
+	size_t plen;
+	size_t poft;
+	size_t sbeg;
+	size_t slen;
+	bool res;
+
+	res = false;
+
+	if (output != NULL && key != NULL && (keylen == QSC_RCS256_KEY_SIZE || keylen == QSC_RCS512_KEY_SIZE) && fpath != NULL)
+	{
+		if (qsc_fileutils_map(&imap, fpath, false, qsc_fileutils_map_advice_random) == true)
+		{
+			if (filecrypto_header_deserialize(&header, imap.data, imap.length) == true && 
+				header.maclen == filecrypto_mac_size(keylen) && offset <= header.length && length <= header.length - offset)
+			{
+				tmps = (uint8_t*)qsc_memutils_malloc(header.segment);
+
+				if (tmps != NULL)
+				{
+					wstate.header = &header;
+					wstate.hdrser = imap.data;
+					wstate.key = key;
+					wstate.keylen = keylen;
+					wstate.encrypt = false;
+					cseg = (size_t)header.segment + header.maclen;
+					res = true;
+
+					for (i = offset / header.segment; length != 0U; ++i)
+					{
+						poft = i * (size_t)header.segment;
+						plen = qsc_intutils_min((size_t)header.length - poft, (size_t)header.segment);
+						sbeg = offset - poft;
+						slen = qsc_intutils_min(plen - sbeg, length);
+
+						if (sbeg == 0U && slen == plen)
+						{
+							/* the range covers the segment; decrypt directly to the output */
+							res = filecrypto_segment_transform(&wstate, i, output, imap.data + QSC_FILECRYPTO_HEADER_SIZE + (i * cseg), plen);
+						}
+						else
+						{
+							res = filecrypto_segment_transform(&wstate, i, tmps, imap.data + QSC_FILECRYPTO_HEADER_SIZE + (i * cseg), plen);
+							qsc_memutils_copy(output, tmps + sbeg, slen);
+						}
+
+						if (res == false)
+						{
+							break;
+						}
+
+						output += slen;
+						offset += slen;
+						length -= slen;
+					}
+
+					qsc_memutils_secure_erase(tmps, header.segment);
+					qsc_memutils_alloc_free(tmps);
+				}
+			}
+
+			qsc_fileutils_unmap(&imap);
+		}
+	}
+
+	return res;
+}
+
+bool qsc_filecrypto_encrypt(const uint8_t* key, size_t keylen, const char* inpath, const char* outpath, size_t threads)
+{
+	assert(key != NULL);
+	assert(keylen == QSC_RCS256_KEY_SIZE || keylen == QSC_RCS512_KEY_SIZE);
+	assert(inpath != NULL);
+	assert(outpath != NULL);
+
+	uint8_t hdrser[QSC_FILECRYPTO_HEADER_SIZE] = { 0U };
+	filecrypto_worker_state wstate = { 0 };
+	qsc_filecrypto_header header = { 0 };
+	qsc_fileutils_mapped_file imap;
+	qsc_fileutils_mapped_file omap;
+	size_t clen;
+	bool res;
+
+	res = false;
+
+	if (key != NULL && (keylen == QSC_RCS256_KEY_SIZE || keylen == QSC_RCS512_KEY_SIZE) && inpath != NULL && outpath != NULL)
+	{
+		if (qsc_fileutils_map(&imap, inpath, false, qsc_fileutils_map_advice_sequential) == true)
+		{
+			header.version = QSC_FILECRYPTO_VERSION;
+			header.cipher = (uint8_t)((keylen == QSC_RCS512_KEY_SIZE) ? RCS512 : RCS256);
+			header.maclen = (uint8_t)filecrypto_mac_size(keylen);
+			header.segment = (uint32_t)QSC_FILECRYPTO_SEGMENT_SIZE;
+			header.length = (uint64_t)imap.length;
+
+			if (qsc_csp_generate(header.nonce, sizeof(header.nonce)) == true)
+			{
+				filecrypto_header_serialize(hdrser, &header);
+				wstate.count = (imap.length + header.segment - 1U) / header.segment;
+				clen = QSC_FILECRYPTO_HEADER_SIZE + imap.length + (wstate.count * header.maclen);
+
+				if (qsc_fileutils_map_create(&omap, outpath, clen) == true)
+				{
+					qsc_memutils_copy(omap.data, hdrser, sizeof(hdrser));
+					wstate.header = &header;
+					wstate.hdrser = hdrser;
+					wstate.imap = &imap;
+					wstate.key = key;
+					wstate.keylen = keylen;
+					wstate.output = omap.data + QSC_FILECRYPTO_HEADER_SIZE;
+					wstate.input = imap.data;
+					wstate.encrypt = true;
+
+					res = filecrypto_segments_process(&wstate, threads);
+
+					if (res == true)
+					{
+						res = qsc_fileutils_map_flush(&omap);
+					}
+
+					qsc_fileutils_unmap(&omap);
+				}
+			}
+
+			qsc_fileutils_unmap(&imap);
+		}
+	}
+
+	return res;
+}
+
+bool qsc_filecrypto_header_read(qsc_filecrypto_header* header, const char* fpath)
+{
+	assert(header != NULL);
+	assert(fpath != NULL);
+
+	uint8_t hdrser[QSC_FILECRYPTO_HEADER_SIZE] = { 0U };
+	FILE* fp;
+	bool res;
+
+	res = false;
+
+	if (header != NULL && fpath != NULL)
+	{
+		fp = qsc_fileutils_open(fpath, qsc_fileutils_mode_read, true);
+
+		if (fp != NULL)
+		{
+			if (qsc_fileutils_read((char*)hdrser, sizeof(hdrser), 0U, fp) == sizeof(hdrser))
+			{
+				res = filecrypto_header_deserialize(header, hdrser, qsc_fileutils_get_size(fpath));
+			}
+
+			qsc_fileutils_close(fp);
+		}
+	}
+
+	return res;
+}
+
+bool qsc_filecrypto_kmac_compute(uint8_t* output, size_t outlen, qsc_keccak_rate rate, const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen, const char* fpath)
+{
+	assert(output != NULL);
+	assert(key != NULL);
+	assert(fpath != NULL);
+
+	qsc_fileutils_mapped_file map;
+	qsc_keccak_state ctx;
+	bool res;
+
+	res = false;
+
+	if (output != NULL && key != NULL && fpath != NULL)
+	{
+		if (qsc_fileutils_map(&map, fpath, false, qsc_fileutils_map_advice_sequential) == true)
+		{
+			qsc_kmac_initialize(&ctx, rate, key, keylen, custom, custlen);
+			filecrypto_keccak_update(&ctx, rate, &map, true);
+			qsc_kmac_finalize(&ctx, rate, output, outlen);
+			qsc_keccak_dispose(&ctx);
+			qsc_fileutils_unmap(&map);
+			res = true;
+		}
+	}
+
+	return res;
+}
+
+bool qsc_filecrypto_sha3_compute(uint8_t* output, qsc_keccak_rate rate, const char* fpath)
+{
+	assert(output != NULL);
+	assert(fpath != NULL);
+
+	qsc_fileutils_mapped_file map;
+	qsc_keccak_state ctx;
+	bool res;
+
+	res = false;
+
+	if (output != NULL && fpath != NULL)
+	{
+		if (qsc_fileutils_map(&map, fpath, false, qsc_fileutils_map_advice_sequential) == true)
+		{
+			qsc_sha3_initialize(&ctx);
+			filecrypto_keccak_update(&ctx, rate, &map, false);
+			qsc_sha3_finalize(&ctx, rate, output);
+			qsc_keccak_dispose(&ctx);
+			qsc_fileutils_unmap(&map);
+			res = true;
+		}
+	}
+
+	return res;
+}
+
+bool qsc_filecrypto_shake_compute(uint8_t* output, size_t outlen, qsc_keccak_rate rate, const char* fpath)
+{
+	assert(output != NULL);
+	assert(fpath != NULL);
+
+	uint8_t hash[QSC_KECCAK_STATE_BYTE_SIZE] = { 0U };
+	const uint8_t empty[1U] = { 0U };
+	qsc_fileutils_mapped_file map;
+	qsc_keccak_state ctx;
+	size_t nblocks;
+	bool res;
+
+	res = false;
+
+	if (output != NULL && fpath != NULL)
+	{
+		if (qsc_fileutils_map(&map, fpath, false, qsc_fileutils_map_advice_sequential) == true)
+		{
+			/* shake absorbs the entire message in one call; the sequential hint drives the read-ahead */
+			qsc_shake_initialize(&ctx, rate, (map.data != NULL) ? map.data : empty, map.length);
+			nblocks = outlen / (size_t)rate;
+			qsc_shake_squeezeblocks(&ctx, rate, output, nblocks);
+			output += (nblocks * (size_t)rate);
+			outlen -= (nblocks * (size_t)rate);
+
+			if (outlen != 0U)
+			{
+				qsc_shake_squeezeblocks(&ctx, rate, hash, 1U);
+				qsc_memutils_copy(output, hash, outlen);
+			}
+
+			qsc_keccak_dispose(&ctx);
+			qsc_fileutils_unmap(&map);
+			res = true;
+		}
+	}
+
+	return res;
+}
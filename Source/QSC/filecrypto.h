@@ -0,0 +1,251 @@
+/*
+ * 2025 Quantum Resistant Cryptographic Solutions Corporation
+ * All Rights Reserved.
+ *
+ * NOTICE: This software and all accompanying materials are the exclusive 
+ * property of Quantum Resistant Cryptographic Solutions Corporation (QRCS).
+ * The intellectual and technical concepts contained within this implementation 
+ * are proprietary to QRCS and its authorized licensors and are protected under 
+ * applicable U.S. and international copyright, patent, and trade secret laws.
+ *
+ * CRYPTOGRAPHIC STANDARDS:
+ * - This software includes implementations of cryptographic algorithms such as 
+ *   SHA3, AES, and others. These algorithms are public domain or standardized 
+ *   by organizations such as NIST and are NOT the property of QRCS.
+ * - However, all source code, optimizations, and implementations in this library 
+ *   are original works of QRCS and are protected under this license.
+ *
+ * RESTRICTIONS:
+ * - Redistribution, modification, or unauthorized distribution of this software, 
+ *   in whole or in part, is strictly prohibited.
+ * - This software is provided for non-commercial, educational, and research 
+ *   purposes only. Commercial use in any form is expressly forbidden.
+ * - Licensing and authorized distribution are solely at the discretion of QRCS.
+ * - Any use of this software implies acceptance of these restrictions.
+ *
+ * DISCLAIMER:
+ * This software is provided "as is," without warranty of any kind, express or 
+ * implied, including but not limited to warranties of merchantability or fitness 
+ * for a particular purpose. QRCS disclaims all liability for any direct, indirect, 
+ * incidental, or consequential damages resulting from the use or misuse of this software.
+ *
+ * FULL LICENSE:
+ * This software is subject to the **Quantum Resistant Cryptographic Solutions 
+ * Proprietary License (QRCS-PL)**. The complete license terms are included 
+ * in the LICENSE.txt file distributed with this software.
+ *
+ * Written by: John G. Underhill
+ * Contact: john.underhill@protonmail.com
+ */
+
+#ifndef QSC_FILECRYPTO_H
+#define QSC_FILECRYPTO_H
+
+#include "common.h"
+#include "aes.h"
+#include "chacha.h"
+#include "rcs.h"
+#include "sha3.h"
+
+QSC_CPLUSPLUS_ENABLED_START
+
+/**
+ * \file filecrypto.h
+ * \brief Hashing, MAC, and stream cipher functions that operate directly on files.
+ *
+ * \details
+ * These functions map the file into memory with qsc_fileutils_map and pass the mapped view to the
+ * SHA3, SHAKE, KMAC, AES-CTR and ChaCha functions. This avoids reading the file through
+ * an intermediate buffer. The view is mapped with a sequential access hint, so the kernel reads
+ * ahead of the permutation or cipher.
+ *
+ * The cipher transforms write their output to a second mapped file that is created at the input size.
+ * If the input and output paths are the same, the file is mapped read-write once and transformed in place.
+ * Each cipher state must be initialized with a key and nonce before the call. The state is left
+ * positioned after the last block, so that multiple files can be processed as one stream.
+ * The authenticated stream ciphers (CSX and RCS) finalize a MAC tag over the message
+ * and are not supported by these functions.
+ *
+ * The encrypt and decrypt functions implement a segmented authenticated file format for files larger than memory.
+ * A 64-byte header holds a format identifier, the segment size, the plain-text length, and a random file nonce.
+ * The plain-text is divided into fixed-size segments, and each segment is encrypted with RCS and followed by its MAC code.
+ * The nonce of each segment is the file nonce with the segment index added to its upper 64 bits,
+ * and the header is the associated data of every segment. A segment moved to another position, or taken from
+ * another file, fails authentication. Truncating the file changes the length bound by the header.
+ * Segments are independent, so they are processed by a set of worker threads directly between the mapped
+ * input and output views. Each worker holds a single segment in flight, so the memory used stays
+ * constant regardless of the file size. Any range of the plain-text can be decrypted with qsc_filecrypto_decrypt_range,
+ * which authenticates and decrypts only the segments that overlap the range.
+ *
+ * \code
+ * uint8_t hash[QSC_SHA3_256_HASH_SIZE];
+ *
+ * if (qsc_filecrypto_sha3_compute(hash, qsc_keccak_rate_256, "archive.bin") == true)
+ * {
+ *     // hash contains the SHA3-256 digest of the file
+ * }
+ * \endcode
+ *
+ * \code
+ * // encrypt a file using all available processor cores
+ * if (qsc_filecrypto_encrypt(key, QSC_RCS256_KEY_SIZE, "backup.tar", "backup.tar.enc", 0) == true)
+ * {
+ *     // decrypt 4096 bytes at offset 1000000 without decrypting the rest of the file
+ *     qsc_filecrypto_decrypt_range(block, 1000000, 4096, key, QSC_RCS256_KEY_SIZE, "backup.tar.enc");
+ * }
+ * \endcode
+ *
+ * \section filecrypto_links Reference Links:
+ * - <a href="https://man7.org/linux/man-pages/man2/mmap.2.html">mmap(2) Linux Manual Page</a>
+ * - <a href="https://man7.org/linux/man-pages/man2/madvise.2.html">madvise(2) Linux Manual Page</a>
+ * - <a href="https://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.202.pdf">SHA3 Fips202</a>
+ */
+
+/*!
+* \def QSC_FILECRYPTO_SEGMENT_SIZE
+* \brief The number of bytes processed between read-ahead hints, and the segment size of the encrypted file format.
+* A header that declares a larger segment is rejected.
+*/
+#define QSC_FILECRYPTO_SEGMENT_SIZE 0x100000ULL
+
+/*!
+* \def QSC_FILECRYPTO_HEADER_SIZE
+* \brief The size of the serialized encrypted file header in bytes
+*/
+#define QSC_FILECRYPTO_HEADER_SIZE 64ULL
+
+/*!
+* \def QSC_FILECRYPTO_THREADS_MAX
+* \brief The maximum number of worker threads used by the file encryption functions
+*/
+#define QSC_FILECRYPTO_THREADS_MAX 64ULL
+
+/*!
+* \def QSC_FILECRYPTO_VERSION
+* \brief The encrypted file format version
+*/
+#define QSC_FILECRYPTO_VERSION 0x01U
+
+/*!
+* \struct qsc_filecrypto_header
+* \brief The encrypted file header
+*/
+QSC_EXPORT_API typedef struct
+{
+	uint8_t nonce[QSC_RCS_NONCE_SIZE];		/*!< The random file nonce */
+	uint64_t length;						/*!< The plain-text length in bytes */
+	uint32_t segment;						/*!< The plain-text segment size in bytes */
+	uint8_t cipher;							/*!< The cipher type; RCS-256 or RCS-512 */
+	uint8_t maclen;							/*!< The MAC code length appended to each segment */
+	uint8_t version;						/*!< The format version */
+} qsc_filecrypto_header;
+
+/**
+* \brief Transform a file with AES in big-endian counter mode.
+* The state must be initialized with qsc_aes_initialize before this call.
+*
+* \param state:		[qsc_aes_state*] The initialized AES state structure
+* \param inpath:	[const char*] The full path to the input file
+* \param outpath:	[const char*] The full path to the output file; may be the same as the input path
+* \return			[bool] Returns true if the file was transformed
+*/
+QSC_EXPORT_API bool qsc_filecrypto_aes_ctrbe_transform(qsc_aes_state* state, const char* inpath, const char* outpath);
+
+/**
+* \brief Transform a file with the ChaCha stream cipher.
+* The state must be initialized with qsc_chacha_initialize before this call.
+*
+* \param ctx:		[qsc_chacha_state*] The initialized ChaCha state structure
+* \param inpath:	[const char*] The full path to the input file
+* \param outpath:	[const char*] The full path to the output file; may be the same as the input path
+* \return			[bool] Returns true if the file was transformed
+*/
+QSC_EXPORT_API bool qsc_filecrypto_chacha_transform(qsc_chacha_state* ctx, const char* inpath, const char* outpath);
+
+/**
+* \brief Decrypt and authenticate a file created by qsc_filecrypto_encrypt.
+* If any segment fails authentication, the output file is deleted and the function returns false.
+*
+* \param key:		[const uint8_t*] The RCS cipher key; 32 bytes for RCS-256, or 64 bytes for RCS-512
+* \param keylen:	[size_t] The key length in bytes
+* \param inpath:	[const char*] The full path to the encrypted file
+* \param outpath:	[const char*] The full path to the plain-text output file
+* \param threads:	[size_t] The number of worker threads; zero uses one thread per processor core
+* \return			[bool] Returns true if every segment was authenticated and decrypted
+*/
+QSC_EXPORT_API bool qsc_filecrypto_decrypt(const uint8_t* key, size_t keylen, const char* inpath, const char* outpath, size_t threads);
+
+/**
+* \brief Decrypt a range of plain-text bytes from an encrypted file.
+* Only the segments overlapping the range are read, authenticated, and decrypted.
+*
+* \param output:	[uint8_t*] The plain-text output array
+* \param offset:	[size_t] The plain-text offset of the first byte
+* \param length:	[size_t] The number of bytes to decrypt
+* \param key:		[const uint8_t*] The RCS cipher key
+* \param keylen:	[size_t] The key length in bytes
+* \param fpath:		[const char*] The full path to the encrypted file
+* \return			[bool] Returns true if the range is within the file and every overlapping segment was authenticated
+*/
+QSC_EXPORT_API bool qsc_filecrypto_decrypt_range(uint8_t* output, size_t offset, size_t length, const uint8_t* key, size_t keylen, const char* fpath);
+
+/**
+* \brief Encrypt a file to the segmented authenticated format.
+*
+* \param key:		[const uint8_t*] The RCS cipher key; 32 bytes for RCS-256, or 64 bytes for RCS-512
+* \param keylen:	[size_t] The key length in bytes
+* \param inpath:	[const char*] The full path to the plain-text file
+* \param outpath:	[const char*] The full path to the encrypted output file
+* \param threads:	[size_t] The number of worker threads; zero uses one thread per processor core
+* \return			[bool] Returns true if the file was encrypted
+*/
+QSC_EXPORT_API bool qsc_filecrypto_encrypt(const uint8_t* key, size_t keylen, const char* inpath, const char* outpath, size_t threads);
+
+/**
+* \brief Read and validate the header of an encrypted file.
+*
+* \param header:	[qsc_filecrypto_header*] The header structure receiving the values
+* \param fpath:		[const char*] The full path to the encrypted file
+* \return			[bool] Returns true if the header is valid and the file size matches the header
+*/
+QSC_EXPORT_API bool qsc_filecrypto_header_read(qsc_filecrypto_header* header, const char* fpath);
+
+/**
+* \brief Compute a KMAC code over the contents of a file.
+*
+* \param output:	[uint8_t*] The output MAC code array
+* \param outlen:	[size_t] The number of MAC code bytes to generate
+* \param rate:		[qsc_keccak_rate] The KMAC rate; 128, 256, or 512
+* \param key:		[const uint8_t*] The MAC key array
+* \param keylen:	[size_t] The number of key bytes
+* \param custom:	[const uint8_t*] The customization string array, can be NULL
+* \param custlen:	[size_t] The number of customization string bytes
+* \param fpath:		[const char*] The full path to the file
+* \return			[bool] Returns true if the file was read and the code computed
+*/
+QSC_EXPORT_API bool qsc_filecrypto_kmac_compute(uint8_t* output, size_t outlen, qsc_keccak_rate rate, const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen, const char* fpath);
+
+/**
+* \brief Compute the SHA3 hash of a file.
+*
+* \param output:	[uint8_t*] The output hash array; 32 bytes for SHA3-256, 64 bytes for SHA3-512
+* \param rate:		[qsc_keccak_rate] The SHA3 rate; 256 or 512
+* \param fpath:		[const char*] The full path to the file
+* \return			[bool] Returns true if the file was read and the hash computed
+*/
+QSC_EXPORT_API bool qsc_filecrypto_sha3_compute(uint8_t* output, qsc_keccak_rate rate, const char* fpath);
+
+/**
+* \brief Generate SHAKE output seeded with the contents of a file.
+*
+* \param output:	[uint8_t*] The output array
+* \param outlen:	[size_t] The number of output bytes to generate
+* \param rate:		[qsc_keccak_rate] The SHAKE rate; 128, 256, or 512
+* \param fpath:		[const char*] The full path to the file
+* \return			[bool] Returns true if the file was read and the output generated
+*/
+QSC_EXPORT_API bool qsc_filecrypto_shake_compute(uint8_t* output, size_t outlen, qsc_keccak_rate rate, const char* fpath);
+
+QSC_CPLUSPLUS_ENABLED_END
+
+#endif
@@ -1,3 +1,7 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+	/* required for the copy_file_range declaration */
+#	define _GNU_SOURCE
+#endif
 #include "fileutils.h"
 #if defined(QSC_DEBUG_MODE)
 #	include "consoleutils.h"
@@ -17,6 +21,9 @@
 #	include <stdio.h>
 #	include <sys/types.h>
 #	include <dirent.h>
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
 #	include <unistd.h>
 #endif
 
@@ -92,6 +99,38 @@ static bool file_has_access(const char* fpath, qsc_fileutils_access_rights level
 	return (err == 0);
 }
 
+#if defined(QSC_SYSTEM_OS_LINUX)
+static bool fileutils_write_all(int32_t fd, const char* input, size_t length)
+{
+	ssize_t wlen;
+	bool res;
+
+	res = true;
+
+	while (length != 0U)
+	{
+		wlen = write(fd, input, length);
+
+		if (wlen > 0)
+		{
+			input += wlen;
+			length -= (size_t)wlen;
+		}
+		else if (wlen < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		else
+		{
+			res = false;
+			break;
+		}
+	}
+
+	return res;
+}
+#endif
+
 bool qsc_fileutils_append_to_file(const char* fpath, const char* stream, size_t length)
 {
 	assert(fpath != NULL);
@@ -376,35 +415,123 @@ bool qsc_fileutils_file_copy(const char* inpath, const char* outpath)
 	assert(inpath != NULL);
 	assert(outpath != NULL);
 
-	char* pfs;
 	size_t len;
+	size_t tot;
+
+	len = 0U;
+	tot = 0U;
 
 	if (inpath != NULL && outpath != NULL)
 	{
-		len = qsc_fileutils_get_size(inpath);
+#if defined(QSC_SYSTEM_OS_LINUX)
+		struct stat fst;
+		char* pfs;
+		ssize_t rlen;
+		int32_t ifd;
+		int32_t ofd;
+
+		ifd = open(inpath, O_RDONLY);
+
+		if (ifd >= 0)
+		{
+			if (fstat(ifd, &fst) == 0)
+			{
+				len = (size_t)fst.st_size;
+				ofd = open(outpath, O_WRONLY | O_CREAT | O_TRUNC, (mode_t)(fst.st_mode & 0777U));
+
+				if (ofd >= 0)
+				{
+					/* copy in the kernel; no data is moved through user space */
+					while (tot < len)
+					{
+						rlen = copy_file_range(ifd, NULL, ofd, NULL, len - tot, 0U);
+
+						if (rlen > 0)
+						{
+							tot += (size_t)rlen;
+						}
+						else if (rlen < 0 && errno == EINTR)
+						{
+							continue;
+						}
+						else
+						{
+							break;
+						}
+					}
+
+					if (tot < len)
+					{
+						/* unsupported by the file system (EXDEV, ENOSYS, EOPNOTSUPP); continue from the current offsets */
+						pfs = (char*)qsc_memutils_malloc(QSC_FILEUTILS_COPY_SIZE);
+
+						if (pfs != NULL)
+						{
+							while (tot < len)
+							{
+								rlen = read(ifd, pfs, QSC_FILEUTILS_COPY_SIZE);
+
+								if (rlen <= 0 || fileutils_write_all(ofd, pfs, (size_t)rlen) == false)
+								{
+									break;
+								}
 
-		if (len > 0)
+								tot += (size_t)rlen;
+							}
+
+							qsc_memutils_alloc_free(pfs);
+						}
+					}
+
+					close(ofd);
+				}
+			}
+
+			close(ifd);
+		}
+#else
+		FILE* ifp;
+		FILE* ofp;
+		char* pfs;
+		size_t rlen;
+
+		ifp = qsc_fileutils_open(inpath, qsc_fileutils_mode_read, true);
+
+		if (ifp != NULL)
 		{
-			pfs = (char*)qsc_memutils_malloc(len);
+			len = qsc_fileutils_get_size(inpath);
+			ofp = qsc_fileutils_open(outpath, qsc_fileutils_mode_write, true);
 
-			if (pfs != NULL)
+			if (ofp != NULL)
 			{
-				len = qsc_fileutils_copy_file_to_stream(inpath, pfs, len);
+				pfs = (char*)qsc_memutils_malloc(QSC_FILEUTILS_COPY_SIZE);
 
-				if (len > 0)
+				if (pfs != NULL)
 				{
-					if (qsc_fileutils_copy_stream_to_file(outpath, pfs, len) == false)
+					while (tot < len)
 					{
-						len = 0;
+						rlen = fread(pfs, sizeof(char), QSC_FILEUTILS_COPY_SIZE, ifp);
+
+						if (rlen == 0U || fwrite(pfs, sizeof(char), rlen, ofp) != rlen)
+						{
+							break;
+						}
+
+						tot += rlen;
 					}
+
+					qsc_memutils_alloc_free(pfs);
 				}
 
-				qsc_memutils_alloc_free(pfs);
+				fclose(ofp);
 			}
+
+			fclose(ifp);
 		}
+#endif
 	}
 
-	return (len != 0);
+	return (len != 0U && tot == len);
 }
 
 bool qsc_fileutils_get_access(const char* fpath, qsc_fileutils_access_rights level)
@@ -833,6 +960,421 @@ size_t qsc_fileutils_list_files(char* result, size_t reslen, const char* directo
 	return sctr;
 }
 
+void qsc_fileutils_line_reader_close(qsc_fileutils_line_reader* reader)
+{
+	assert(reader != NULL);
+
+	if (reader != NULL)
+	{
+		if (reader->fp != NULL)
+		{
+			fclose(reader->fp);
+		}
+
+		if (reader->buffer != NULL)
+		{
+			qsc_memutils_alloc_free(reader->buffer);
+		}
+
+		qsc_memutils_clear(reader, sizeof(qsc_fileutils_line_reader));
+	}
+}
+
+int64_t qsc_fileutils_line_reader_next(qsc_fileutils_line_reader* reader, const char** line)
+{
+	assert(reader != NULL);
+	assert(line != NULL);
+
+	const char* pnl;
+	char* tmpb;
+	size_t rlen;
+	size_t scan;
+	int64_t res;
+
+	res = -1;
+
+	if (reader != NULL && line != NULL && reader->buffer != NULL)
+	{
+		*line = NULL;
+		scan = reader->position;
+
+		while (true)
+		{
+			pnl = (const char*)memchr(reader->buffer + scan, '\n', reader->length - scan);
+
+			if (pnl != NULL)
+			{
+				rlen = (size_t)(pnl - (reader->buffer + reader->position));
+				*line = reader->buffer + reader->position;
+				reader->position += rlen + 1U;
+				break;
+			}
+
+			if (reader->eof == true)
+			{
+				/* the last line has no terminator */
+				rlen = reader->length - reader->position;
+
+				if (rlen != 0U)
+				{
+					*line = reader->buffer + reader->position;
+					reader->position = reader->length;
+				}
+
+				break;
+			}
+
+			/* move the partial line to the front of the buffer */
+			rlen = reader->length - reader->position;
+
+			if (reader->position != 0U)
+			{
+				qsc_memutils_move(reader->buffer, reader->buffer + reader->position, rlen);
+				reader->position = 0U;
+				reader->length = rlen;
+			}
+
+			/* one byte is always reserved for the zero terminator */
+			if (reader->length == reader->capacity - 1U)
+			{
+				tmpb = (char*)qsc_memutils_realloc(reader->buffer, reader->capacity * 2U);
+
+				if (tmpb == NULL)
+				{
+					break;
+				}
+
+				reader->buffer = tmpb;
+				reader->capacity *= 2U;
+			}
+
+			scan = reader->length;
+			rlen = fread(reader->buffer + reader->length, sizeof(char), reader->capacity - 1U - reader->length, reader->fp);
+			reader->length += rlen;
+
+			if (rlen == 0U)
+			{
+				reader->eof = true;
+			}
+		}
+
+		if (*line != NULL)
+		{
+			if (rlen != 0U && (*line)[rlen - 1U] == '\r')
+			{
+				--rlen;
+			}
+
+			((char*)*line)[rlen] = '\0';
+			++reader->line;
+			res = (int64_t)rlen;
+		}
+	}
+
+	return res;
+}
+
+bool qsc_fileutils_line_reader_open(qsc_fileutils_line_reader* reader, const char* fpath)
+{
+	assert(reader != NULL);
+	assert(fpath != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (reader != NULL && fpath != NULL)
+	{
+		qsc_memutils_clear(reader, sizeof(qsc_fileutils_line_reader));
+		reader->fp = qsc_fileutils_open(fpath, qsc_fileutils_mode_read, true);
+
+		if (reader->fp != NULL)
+		{
+			reader->buffer = (char*)qsc_memutils_malloc(QSC_FILEUTILS_LINE_BUFFER_SIZE);
+
+			if (reader->buffer != NULL)
+			{
+				reader->capacity = QSC_FILEUTILS_LINE_BUFFER_SIZE;
+				res = true;
+			}
+			else
+			{
+				qsc_fileutils_line_reader_close(reader);
+			}
+		}
+	}
+
+	return res;
+}
+
+static void fileutils_map_reset(qsc_fileutils_mapped_file* map)
+{
+	map->data = NULL;
+	map->length = 0U;
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+	map->handle = (intptr_t)INVALID_HANDLE_VALUE;
+	map->section = 0;
+#else
+	map->handle = -1;
+	map->section = 0;
+#endif
+	map->writable = false;
+}
+
+static void fileutils_map_hint(uint8_t* address, size_t length, qsc_fileutils_map_advice advice)
+{
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+	WIN32_MEMORY_RANGE_ENTRY range;
+
+	/* sequential and random hints are applied at open with the scan flags */
+	if (advice == qsc_fileutils_map_advice_willneed)
+	{
+		range.VirtualAddress = address;
+		range.NumberOfBytes = length;
+		PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+	}
+#else
+	uintptr_t base;
+	size_t page;
+	int32_t flag;
+
+	/* madvise requires a page aligned base address */
+	page = (size_t)sysconf(_SC_PAGESIZE);
+	base = (uintptr_t)address & ~(uintptr_t)(page - 1U);
+	length += (size_t)((uintptr_t)address - base);
+
+	switch (advice)
+	{
+		case qsc_fileutils_map_advice_sequential:
+			flag = MADV_SEQUENTIAL;
+			break;
+		case qsc_fileutils_map_advice_random:
+			flag = MADV_RANDOM;
+			break;
+		case qsc_fileutils_map_advice_willneed:
+			flag = MADV_WILLNEED;
+			break;
+		default:
+			flag = MADV_NORMAL;
+	}
+
+	madvise((void*)base, length, flag);
+#endif
+}
+
+static bool fileutils_map_view(qsc_fileutils_mapped_file* map, size_t length)
+{
+	bool res;
+
+	res = false;
+	map->length = length;
+
+	if (length == 0U)
+	{
+		/* an empty file cannot be mapped, but it is a valid (empty) view */
+		res = true;
+	}
+	else
+	{
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+		HANDLE hmap;
+
+		hmap = CreateFileMappingA((HANDLE)map->handle, NULL, map->writable ? PAGE_READWRITE : PAGE_READONLY, 
+			(DWORD)((uint64_t)length >> 32U), (DWORD)((uint64_t)length & 0xFFFFFFFFULL), NULL);
+
+		if (hmap != NULL)
+		{
+			map->section = (intptr_t)hmap;
+			map->data = (uint8_t*)MapViewOfFile(hmap, map->writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, length);
+			res = (map->data != NULL);
+		}
+#else
+		void* addr;
+
+		addr = mmap(NULL, length, map->writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, (int32_t)map->handle, 0);
+
+		if (addr != MAP_FAILED)
+		{
+			map->data = (uint8_t*)addr;
+			res = true;
+		}
+#endif
+	}
+
+	return res;
+}
+
+bool qsc_fileutils_map(qsc_fileutils_mapped_file* map, const char* fpath, bool writable, qsc_fileutils_map_advice advice)
+{
+	assert(map != NULL);
+	assert(fpath != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (map != NULL && fpath != NULL)
+	{
+		fileutils_map_reset(map);
+		map->writable = writable;
+
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+		LARGE_INTEGER flen;
+		HANDLE hfile;
+		DWORD flags;
+
+		flags = FILE_ATTRIBUTE_NORMAL;
+
+		if (advice == qsc_fileutils_map_advice_sequential)
+		{
+			flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+		}
+		else if (advice == qsc_fileutils_map_advice_random)
+		{
+			flags |= FILE_FLAG_RANDOM_ACCESS;
+		}
+
+		hfile = CreateFileA(fpath, writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, flags, NULL);
+
+		if (hfile != INVALID_HANDLE_VALUE)
+		{
+			map->handle = (intptr_t)hfile;
+
+			if (GetFileSizeEx(hfile, &flen) == TRUE)
+			{
+				res = fileutils_map_view(map, (size_t)flen.QuadPart);
+			}
+		}
+#else
+		struct stat fst;
+		int32_t fd;
+
+		fd = open(fpath, writable ? O_RDWR : O_RDONLY);
+
+		if (fd >= 0)
+		{
+			map->handle = fd;
+
+			if (fstat(fd, &fst) == 0)
+			{
+				res = fileutils_map_view(map, (size_t)fst.st_size);
+			}
+		}
+#endif
+
+		if (res == true)
+		{
+			if (map->data != NULL && advice != qsc_fileutils_map_advice_normal)
+			{
+				fileutils_map_hint(map->data, map->length, advice);
+			}
+		}
+		else
+		{
+			qsc_fileutils_unmap(map);
+		}
+	}
+
+	return res;
+}
+
+void qsc_fileutils_map_advise(const qsc_fileutils_mapped_file* map, size_t offset, size_t length, qsc_fileutils_map_advice advice)
+{
+	assert(map != NULL);
+
+	if (map != NULL && map->data != NULL && offset < map->length)
+	{
+		if (length == 0U || length > map->length - offset)
+		{
+			length = map->length - offset;
+		}
+
+		fileutils_map_hint(map->data + offset, length, advice);
+	}
+}
+
+bool qsc_fileutils_map_create(qsc_fileutils_mapped_file* map, const char* fpath, size_t length)
+{
+	assert(map != NULL);
+	assert(fpath != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (map != NULL && fpath != NULL)
+	{
+		fileutils_map_reset(map);
+		map->writable = true;
+
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+		LARGE_INTEGER flen;
+		HANDLE hfile;
+
+		hfile = CreateFileA(fpath, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+
+		if (hfile != INVALID_HANDLE_VALUE)
+		{
+			map->handle = (intptr_t)hfile;
+			flen.QuadPart = (LONGLONG)length;
+
+			if (SetFilePointerEx(hfile, flen, NULL, FILE_BEGIN) == TRUE && SetEndOfFile(hfile) == TRUE)
+			{
+				res = fileutils_map_view(map, length);
+			}
+		}
+#else
+		int32_t fd;
+
+		fd = open(fpath, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+		if (fd >= 0)
+		{
+			map->handle = fd;
+
+			if (ftruncate(fd, (off_t)length) == 0)
+			{
+				res = fileutils_map_view(map, length);
+			}
+		}
+#endif
+
+		if (res == false)
+		{
+			qsc_fileutils_unmap(map);
+		}
+	}
+
+	return res;
+}
+
+bool qsc_fileutils_map_flush(const qsc_fileutils_mapped_file* map)
+{
+	assert(map != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (map != NULL)
+	{
+		if (map->data == NULL || map->writable == false)
+		{
+			res = true;
+		}
+		else
+		{
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+			res = (FlushViewOfFile(map->data, map->length) == TRUE && FlushFileBuffers((HANDLE)map->handle) == TRUE);
+#else
+			res = (msync(map->data, map->length, MS_SYNC) == 0);
+#endif
+		}
+	}
+
+	return res;
+}
+
 FILE* qsc_fileutils_open(const char* fpath, qsc_fileutils_mode mode, bool binary)
 {
 	assert(fpath != NULL);
@@ -914,73 +1456,28 @@ int64_t qsc_fileutils_read_line(const char* fpath, char* buffer, size_t buflen,
 	assert(buffer != NULL);
 	assert(buflen != 0);
 
+	qsc_fileutils_line_reader rdr;
+	const char* line;
 	int64_t pln;
 
 	pln = 0;
 
 	if (fpath != NULL && buffer != NULL && buflen != 0)
 	{
-		FILE* fp;
-		char* sbuf;
-		errno_t err;
-		size_t ctr;
-		size_t len;
-		size_t pos;
-
-		ctr = 0;
-		pos = 0;
-
-#if defined(QSC_SYSTEM_OS_WINDOWS)
-		err = fopen_s(&fp, fpath, "r");
-#else
-		fp = fopen(fpath, "r");
-		err = (fp != NULL) ? 0 : -1;
-#endif
-
-		if (fp != NULL && err == 0)
+		if (qsc_fileutils_line_reader_open(&rdr, fpath) == true)
 		{
-			len = qsc_fileutils_get_size(fpath);
-
-			if (len > 0)
+			do
 			{
-				sbuf = (char*)qsc_memutils_malloc(len);
-				qsc_memutils_clear(sbuf, len);
-
-				if (sbuf != NULL)
-				{
-					len = fread(sbuf, sizeof(char), len, fp);
-
-					if (len > 0)
-					{
-						while (true)
-						{
-							pln = qsc_stringutils_find_string(sbuf + pos, "\n");
-
-							if (pln == QSC_STRINGUTILS_TOKEN_NOT_FOUND || ctr > linenum)
-							{
-								break;
-							}
-
-							if (ctr == linenum)
-							{
-								if (pln > 0)
-								{
-									qsc_memutils_copy(buffer, sbuf + pos, (size_t)pln <= buflen ? (size_t)pln : buflen);
-								}
-
-								break;
-							}
-
-							pos += pln + 1;
-							++ctr;
-						};
-					}
+				pln = qsc_fileutils_line_reader_next(&rdr, &line);
+			}
+			while (pln >= 0 && rdr.line <= linenum);
 
-					qsc_memutils_alloc_free(sbuf);
-				}
+			if (pln > 0)
+			{
+				qsc_memutils_copy(buffer, line, (size_t)pln <= buflen ? (size_t)pln : buflen);
 			}
 
-			fclose(fp);
+			qsc_fileutils_line_reader_close(&rdr);
 		}
 	}
 
@@ -1106,6 +1603,48 @@ bool qsc_fileutils_truncate_file(FILE* fp, size_t length)
 	return res;
 }
 
+void qsc_fileutils_unmap(qsc_fileutils_mapped_file* map)
+{
+	assert(map != NULL);
+
+	if (map != NULL)
+	{
+		if (map->data != NULL && map->writable == true)
+		{
+			qsc_fileutils_map_flush(map);
+		}
+
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+		if (map->data != NULL)
+		{
+			UnmapViewOfFile(map->data);
+		}
+
+		if (map->section != 0)
+		{
+			CloseHandle((HANDLE)map->section);
+		}
+
+		if ((HANDLE)map->handle != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle((HANDLE)map->handle);
+		}
+#else
+		if (map->data != NULL)
+		{
+			munmap(map->data, map->length);
+		}
+
+		if (map->handle >= 0)
+		{
+			close((int32_t)map->handle);
+		}
+#endif
+
+		fileutils_map_reset(map);
+	}
+}
+
 bool qsc_fileutils_valid_path(const char* fpath)
 {
 	assert(fpath != NULL);
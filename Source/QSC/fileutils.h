@@ -75,6 +75,18 @@ QSC_CPLUSPLUS_ENABLED_START
  */
 #define QSC_FILEUTILS_CHUNK_SIZE 4096ULL
 
+/*!
+ * \def QSC_FILEUTILS_COPY_SIZE
+ * \brief [size_t] The block size used when a file copy falls back to buffered reads and writes.
+ */
+#define QSC_FILEUTILS_COPY_SIZE 0x100000ULL
+
+/*!
+ * \def QSC_FILEUTILS_LINE_BUFFER_SIZE
+ * \brief [size_t] The initial buffer size of a line reader; the buffer grows to fit longer lines.
+ */
+#define QSC_FILEUTILS_LINE_BUFFER_SIZE 0x10000ULL
+
 /*!
  * \def QSC_FILEUTILS_MAX_EXTENSION
  * \brief [size_t] The maximum file extension size.
@@ -138,6 +150,46 @@ typedef enum
     qsc_fileutils_mode_append_update = 0x06U    /*!< Open file for update in append mode. */
 } qsc_fileutils_mode;
 
+/*!
+ * \enum qsc_fileutils_map_advice
+ * \brief Enumerates the access pattern hints passed to the kernel for a mapped file.
+ */
+typedef enum
+{
+    qsc_fileutils_map_advice_normal = 0x00U,        /*!< No special treatment. */
+    qsc_fileutils_map_advice_sequential = 0x01U,    /*!< Pages will be read in order; read ahead aggressively. */
+    qsc_fileutils_map_advice_random = 0x02U,        /*!< Pages will be read in random order; disable read ahead. */
+    qsc_fileutils_map_advice_willneed = 0x03U       /*!< The range will be accessed soon; fault it in ahead of use. */
+} qsc_fileutils_map_advice;
+
+/*!
+ * \struct qsc_fileutils_mapped_file
+ * \brief A memory mapped view of a file.
+ */
+QSC_EXPORT_API typedef struct
+{
+    uint8_t* data;                  /*!< The mapped view, NULL for an empty file. */
+    size_t length;                  /*!< The length of the mapped view in bytes. */
+    intptr_t handle;                /*!< The platform file handle or descriptor. */
+    intptr_t section;               /*!< The platform mapping object handle (Windows only). */
+    bool writable;                  /*!< The view was mapped for writing. */
+} qsc_fileutils_mapped_file;
+
+/*!
+ * \struct qsc_fileutils_line_reader
+ * \brief A buffered reader that returns the lines of a file in a single pass.
+ */
+QSC_EXPORT_API typedef struct
+{
+    FILE* fp;                       /*!< The open file stream. */
+    char* buffer;                   /*!< The line buffer, reused across reads. */
+    size_t capacity;                /*!< The allocated size of the buffer. */
+    size_t position;                /*!< The offset of the first unread byte in the buffer. */
+    size_t length;                  /*!< The number of valid bytes in the buffer. */
+    size_t line;                    /*!< The number of lines returned so far. */
+    bool eof;                       /*!< The end of the file has been reached. */
+} qsc_fileutils_line_reader;
+
 /**
  * \brief Append an array of characters to a file.
  *
@@ -217,6 +269,9 @@ QSC_EXPORT_API bool qsc_fileutils_erase(const char* fpath);
 /**
  * \brief Copy a file to a new location.
  *
+ * The file is copied in a single pass with bounded memory. On Linux the copy is done in the kernel with copy_file_range,
+ * and on other systems, or when the file systems do not support it, in QSC_FILEUTILS_COPY_SIZE blocks.
+ *
  * \param inpath:       [const char*] The full fpath to the input file.
  * \param outpath:      [const char*] The full fpath to the output file.
  * \return              [bool] Returns true if the file was copied.
@@ -300,6 +355,75 @@ QSC_EXPORT_API bool qsc_fileutils_get_working_directory(char* fpath);
  */
 QSC_EXPORT_API size_t qsc_fileutils_list_files(char* result, size_t reslen, const char* directory);
 
+/**
+ * \brief Close a line reader, release its buffer, and close the file.
+ *
+ * \param reader:       [qsc_fileutils_line_reader*] The line reader structure.
+ */
+QSC_EXPORT_API void qsc_fileutils_line_reader_close(qsc_fileutils_line_reader* reader);
+
+/**
+ * \brief Read the next line from a line reader.
+ *
+ * The line terminator (LF or CRLF) is removed and the line is zero terminated.
+ * The returned pointer references the reader's buffer, and is valid until the next call to this function.
+ *
+ * \param reader:       [qsc_fileutils_line_reader*] The line reader structure.
+ * \param line:         [const char**] Receives a pointer to the line.
+ * \return              [int64_t] Returns the length of the line, or -1 at the end of the file.
+ */
+QSC_EXPORT_API int64_t qsc_fileutils_line_reader_next(qsc_fileutils_line_reader* reader, const char** line);
+
+/**
+ * \brief Open a file for line by line reading.
+ *
+ * \param reader:       [qsc_fileutils_line_reader*] The line reader structure.
+ * \param fpath:        [const char*] The full path to the file.
+ * \return              [bool] Returns true if the file was opened.
+ */
+QSC_EXPORT_API bool qsc_fileutils_line_reader_open(qsc_fileutils_line_reader* reader, const char* fpath);
+
+/**
+ * \brief Map a file into memory.
+ *
+ * The view covers the entire file. An empty file maps successfully with a NULL data pointer and a zero length.
+ *
+ * \param map:          [qsc_fileutils_mapped_file*] The mapped file structure.
+ * \param fpath:        [const char*] The full path to the file.
+ * \param writable:     [bool] Map the file read-write (true), or read-only (false).
+ * \param advice:       [qsc_fileutils_map_advice] The expected access pattern.
+ * \return              [bool] Returns true if the file was mapped.
+ */
+QSC_EXPORT_API bool qsc_fileutils_map(qsc_fileutils_mapped_file* map, const char* fpath, bool writable, qsc_fileutils_map_advice advice);
+
+/**
+ * \brief Apply an access pattern hint to a range of a mapped file.
+ *
+ * \param map:          [const qsc_fileutils_mapped_file*] The mapped file structure.
+ * \param offset:       [size_t] The starting offset within the view.
+ * \param length:       [size_t] The length of the range.
+ * \param advice:       [qsc_fileutils_map_advice] The expected access pattern.
+ */
+QSC_EXPORT_API void qsc_fileutils_map_advise(const qsc_fileutils_mapped_file* map, size_t offset, size_t length, qsc_fileutils_map_advice advice);
+
+/**
+ * \brief Create or truncate a file to a fixed size and map it read-write.
+ *
+ * \param map:          [qsc_fileutils_mapped_file*] The mapped file structure.
+ * \param fpath:        [const char*] The full path to the file.
+ * \param length:       [size_t] The file size in bytes.
+ * \return              [bool] Returns true if the file was created and mapped.
+ */
+QSC_EXPORT_API bool qsc_fileutils_map_create(qsc_fileutils_mapped_file* map, const char* fpath, size_t length);
+
+/**
+ * \brief Flush the modified pages of a writable mapping to the file.
+ *
+ * \param map:          [const qsc_fileutils_mapped_file*] The mapped file structure.
+ * \return              [bool] Returns true if the pages were written.
+ */
+QSC_EXPORT_API bool qsc_fileutils_map_flush(const qsc_fileutils_mapped_file* map);
+
 /**
  * \brief Close a file.
  *
@@ -370,6 +494,8 @@ QSC_EXPORT_API bool qsc_fileutils_seekto(FILE* fp, size_t position);
 /**
  * \brief Read a line of text from a file.
  *
+ * The file is scanned from the start on each call; use a qsc_fileutils_line_reader to iterate over many lines.
+ *
  * \param fpath:        [const char*] The full fpath to the file.
  * \param buffer:       [char*] The string buffer.
  * \param buflen:       [size_t] The size of the string buffer.
@@ -387,6 +513,15 @@ QSC_EXPORT_API int64_t qsc_fileutils_read_line(const char* fpath, char* buffer,
  */
 QSC_EXPORT_API bool qsc_fileutils_truncate_file(FILE* fp, size_t length);
 
+/**
+ * \brief Unmap a mapped file and close its handles.
+ *
+ * A writable view is flushed before it is released.
+ *
+ * \param map:          [qsc_fileutils_mapped_file*] The mapped file structure.
+ */
+QSC_EXPORT_API void qsc_fileutils_unmap(qsc_fileutils_mapped_file* map);
+
 /**
  * \brief Checks if the fpath is valid.
  *
@@ -23,6 +23,7 @@ static void csg_auto_reseed(qsc_hcg_state* ctx)
 		qsc_sha512_update(&sstate, prnd, QSC_HCG_KEY_SIZE);
 		/* update the key */
 		qsc_sha512_finalize(&sstate, ctx->key);
+		qsc_hmac512_prefix_initialize(&ctx->kstate, ctx->key, QSC_HCG_KEY_SIZE);
 		ctx->rpos = 0;
 	}
 }
@@ -33,8 +34,8 @@ static void hcg_fill_buffer(qsc_hcg_state* ctx, uint8_t* buffer)
 
 	/* increment the nonce counter */
 	qsc_intutils_be8increment(ctx->nonce, QSC_HCG_NONCE_SIZE);
-	/* initialize HMAC */
-	qsc_hmac512_initialize(&hstate, ctx->key, QSC_HCG_KEY_SIZE);
+	/* start the MAC from the cached keyed prefix */
+	qsc_hmac512_prefix_clone(&ctx->kstate, &hstate);
 	/* update the MAC with the nonce */
 	qsc_hmac512_update(&hstate, ctx->nonce, QSC_HCG_NONCE_SIZE);
 	/* update the MAC with the info */
@@ -58,6 +59,7 @@ void qsc_hcg_dispose(qsc_hcg_state* ctx)
 
 	if (ctx != NULL)
 	{
+		qsc_hmac512_prefix_dispose(&ctx->kstate);
 		qsc_memutils_clear(ctx->info, QSC_HCG_MAX_INFO_SIZE);
 		qsc_memutils_clear(ctx->key, QSC_HCG_KEY_SIZE);
 		qsc_memutils_clear(ctx->nonce, QSC_HCG_NONCE_SIZE);
@@ -113,6 +115,7 @@ void qsc_hcg_initialize(qsc_hcg_state* ctx, const uint8_t* seed, size_t seedlen,
 
 		/* generate the key */
 		qsc_hmac512_finalize(&hstate, ctx->key);
+		qsc_hmac512_prefix_initialize(&ctx->kstate, ctx->key, QSC_HCG_KEY_SIZE);
 	}
 }
 
@@ -164,6 +167,7 @@ void qsc_hcg_update(qsc_hcg_state* ctx, const uint8_t* seed, size_t seedlen)
 
 		/* update the key */
 		qsc_sha512_finalize(&sstate, ctx->key);
+		qsc_hmac512_prefix_initialize(&ctx->kstate, ctx->key, QSC_HCG_KEY_SIZE);
 	}
 }
 
@@ -133,6 +133,7 @@ QSC_CPLUSPLUS_ENABLED_START
  */
 QSC_EXPORT_API typedef struct
 {
+    qsc_hmac512_prefix_state kstate;        /*!< The keyed HMAC prefix, rebuilt when the key changes. */
     uint8_t key[QSC_HCG_KEY_SIZE];          /*!< The key cache. */
     uint8_t info[QSC_HCG_MAX_INFO_SIZE];    /*!< The info string. */
     uint8_t nonce[QSC_HCG_NONCE_SIZE];      /*!< The nonce array. */
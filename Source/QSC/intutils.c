@@ -22,6 +22,26 @@ bool qsc_intutils_are_equal8(const uint8_t* a, const uint8_t* b, size_t length)
 	return status;
 }
 
+void qsc_intutils_be8add(uint8_t* output, size_t otplen, uint64_t value)
+{
+	assert(output != NULL);
+
+	uint64_t carry;
+	uint64_t sum;
+	size_t i;
+
+	carry = value;
+	i = otplen;
+
+	while (i != 0 && carry != 0)
+	{
+		--i;
+		sum = (uint64_t)output[i] + (carry & 0xFFU);
+		output[i] = (uint8_t)sum;
+		carry = (carry >> 8) + (sum >> 8);
+	}
+}
+
 void qsc_intutils_be8increment(uint8_t* output, size_t otplen)
 {
 	assert(output != NULL);
@@ -499,11 +519,37 @@ void qsc_intutils_bin_to_hex(const uint8_t* input, char* hexstr, size_t inplen)
 	};
 
 	size_t ctr;
+	size_t i;
 	int32_t vct;
 
 	ctr = 0;
+	i = 0;
 
-	for (size_t i = 0; i < inplen; ++i)
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+	/* nibble lookups through a byte shuffle, interleaved into character pairs */
+	const __m256i HEX256 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)ENCODING_TABLE));
+
+	while (inplen - i >= 32U)
+	{
+		__m256i hi;
+		__m256i lo;
+		__m256i v;
+
+		v = _mm256_loadu_si256((const __m256i*)(input + i));
+		hi = _mm256_shuffle_epi8(HEX256, _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F)));
+		lo = _mm256_shuffle_epi8(HEX256, _mm256_and_si256(v, _mm256_set1_epi8(0x0F)));
+		v = _mm256_unpacklo_epi8(hi, lo);
+		hi = _mm256_unpackhi_epi8(hi, lo);
+		_mm256_storeu_si256((__m256i*)(hexstr + ctr), _mm256_permute2x128_si256(v, hi, 0x20));
+		_mm256_storeu_si256((__m256i*)(hexstr + ctr + 32U), _mm256_permute2x128_si256(v, hi, 0x31));
+		ctr += 64U;
+		i += 32U;
+	}
+
+#endif
+
+	for (; i < inplen; ++i)
 	{
 		vct = input[i];
 		hexstr[ctr] = ENCODING_TABLE[vct >> 4];
@@ -539,6 +585,26 @@ void qsc_intutils_hex_to_bin(const char* hexstr, uint8_t* output, size_t outlen)
 	}
 }
 
+void qsc_intutils_le8add(uint8_t* output, size_t otplen, uint64_t value)
+{
+	assert(output != NULL);
+
+	uint64_t carry;
+	uint64_t sum;
+	size_t i;
+
+	carry = value;
+	i = 0;
+
+	while (i < otplen && carry != 0)
+	{
+		sum = (uint64_t)output[i] + (carry & 0xFFU);
+		output[i] = (uint8_t)sum;
+		carry = (carry >> 8) + (sum >> 8);
+		++i;
+	}
+}
+
 void qsc_intutils_le8increment(uint8_t* output, size_t otplen)
 {
 	assert(output != NULL);
@@ -189,6 +189,15 @@ QSC_EXPORT_API void qsc_intutils_be32to8(uint8_t* output, uint32_t value);
  */
 QSC_EXPORT_API void qsc_intutils_be64to8(uint8_t* output, uint64_t value);
 
+/**
+ * \brief Add a 64-bit value to an 8-bit integer array as a segmented big-endian integer.
+ *
+ * \param output:	[uint8_t*] The counter array.
+ * \param otplen:	[size_t] The length of the counter array.
+ * \param value:	[uint64_t] The value to add.
+ */
+QSC_EXPORT_API void qsc_intutils_be8add(uint8_t* output, size_t otplen, uint64_t value);
+
 /**
  * \brief Increment an 8-bit integer array as a segmented big-endian integer.
  *
@@ -411,6 +420,15 @@ QSC_EXPORT_API void qsc_intutils_hex_to_bin(const char* hexstr, uint8_t* output,
  */
 QSC_EXPORT_API void qsc_intutils_bin_to_hex(const uint8_t* input, char* hexstr, size_t inplen);
 
+/**
+ * \brief Add a 64-bit value to an 8-bit integer array as a segmented little-endian integer.
+ *
+ * \param output:	[uint8_t*] The counter array.
+ * \param otplen:	[size_t] The length of the counter array.
+ * \param value:	[uint64_t] The value to add.
+ */
+QSC_EXPORT_API void qsc_intutils_le8add(uint8_t* output, size_t otplen, uint64_t value);
+
 /**
  * \brief Increment an 8-bit integer array as a segmented little-endian integer.
  *
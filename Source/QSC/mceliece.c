@@ -77,3 +77,29 @@ void qsc_mceliece_generate_keypair(uint8_t* publickey, uint8_t* privatekey, bool
 		qsc_mceliece_ref_generate_keypair(publickey, privatekey, rng_generate);
 	}
 }
+
+bool qsc_mceliece_generate_keypair_workspace(uint8_t* publickey, uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t), uint8_t* workspace, size_t wslen)
+{
+	assert(publickey != NULL);
+	assert(privatekey != NULL);
+	assert(rng_generate != NULL);
+	assert(workspace != NULL);
+	assert(wslen >= qsc_mceliece_ref_workspace_size());
+	assert(((uintptr_t)workspace % sizeof(uint64_t)) == 0U);
+
+	bool res;
+
+	res = false;
+
+	if (publickey != NULL && privatekey != NULL && rng_generate != NULL && workspace != NULL && wslen >= qsc_mceliece_ref_workspace_size() && ((uintptr_t)workspace % sizeof(uint64_t)) == 0U)
+	{
+		res = (qsc_mceliece_ref_generate_keypair_workspace(publickey, privatekey, rng_generate, workspace) == 0);
+	}
+
+	return res;
+}
+
+size_t qsc_mceliece_workspace_size(void)
+{
+	return qsc_mceliece_ref_workspace_size();
+}
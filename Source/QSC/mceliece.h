@@ -253,6 +253,34 @@ QSC_EXPORT_API void qsc_mceliece_encrypt(uint8_t* secret, uint8_t* ciphertext, c
  */
 QSC_EXPORT_API void qsc_mceliece_generate_keypair(uint8_t* publickey, uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t));
 
+/**
+ * \brief Generates a McEliece public/private key pair, using a caller supplied workspace.
+ *
+ * \details
+ * Key generation needs a work matrix of over a megabyte for the larger parameter sets.
+ * Callers that generate many keys can allocate it once, and reuse it across calls;
+ * qsc_memutils_large_alloc maps it on huge pages where the system supports them.
+ * The workspace holds secret intermediate values, and should be erased with qsc_memutils_secure_erase before it is released.
+ * The workspace variant covers the reference implementation (mceliecebase.c) used by this api;
+ * the AVX2 implementation (mceliecebase_avx2.c) has no workspace variant.
+ *
+ * \param publickey:	[uint8_t*] Pointer to the output public key array (size QSC_MCELIECE_PUBLICKEY_SIZE).
+ * \param privatekey:	[uint8_t*] Pointer to the output private key array (size QSC_MCELIECE_PRIVATEKEY_SIZE).
+ * \param rng_generate: [bool (*)(uint8_t*, size_t)] Pointer to a random generator function.
+ * \param workspace:	[uint8_t*] Pointer to the 8-byte aligned workspace.
+ * \param wslen:		[size_t] The workspace length, at least qsc_mceliece_workspace_size() bytes.
+ *
+ * \return				[bool] Returns true for success, false if the workspace is too small or misaligned.
+ */
+QSC_EXPORT_API bool qsc_mceliece_generate_keypair_workspace(uint8_t* publickey, uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t), uint8_t* workspace, size_t wslen);
+
+/**
+ * \brief Gets the size of the workspace used by qsc_mceliece_generate_keypair_workspace.
+ *
+ * \return				[size_t] Returns the workspace size in bytes.
+ */
+QSC_EXPORT_API size_t qsc_mceliece_workspace_size(void);
+
 QSC_CPLUSPLUS_ENABLED_END
 
 #endif
@@ -1,4 +1,5 @@
 #include "mceliecebase.h"
+#include "ctsort.h"
 #include "intutils.h"
 #include "memutils.h"
 #include "sha3.h"
@@ -66,6 +67,10 @@
 #	error "The McEliece parameter set is invalid!"
 #endif
 
+#define MCELIECE_PKGEN_WORKSPACE_SIZE (MCELIECE_PK_NROWS * (MCELIECE_SYS_N / 8))
+#define MCELIECE_CONTROLBITS_WORKSPACE_SIZE ((1ULL << MCELIECE_GFBITS) * ((2 * sizeof(int32_t)) + sizeof(int16_t)))
+#define MCELIECE_WORKSPACE_SIZE ((MCELIECE_PKGEN_WORKSPACE_SIZE > MCELIECE_CONTROLBITS_WORKSPACE_SIZE) ? MCELIECE_PKGEN_WORKSPACE_SIZE : MCELIECE_CONTROLBITS_WORKSPACE_SIZE)
+
 /* gf.c */
 
 typedef uint16_t gf;
@@ -463,129 +468,6 @@ static gf bitrev(gf a)
 #endif
 }
 
-/* sort */
-
-static void int32_minmax(int32_t* a, int32_t* b)
-{
-	int32_t ab;
-	int32_t c;
-
-	ab = *b ^ *a;
-	c = *b - *a;
-	c ^= ab & (c ^ *b);
-	c >>= 31;
-	c &= ab;
-	*a ^= c;
-	*b ^= c;
-}
-
-static void int32_sort(int32_t* x, int64_t n)
-{
-	int64_t top;
-	int64_t r;
-	int64_t i;
-
-	if (n >= 2)
-	{
-		top = 1;
-
-		while (top < n - top)
-		{
-			top += top;
-		}
-
-		for (int64_t p = top; p > 0; p >>= 1)
-		{
-			for (i = 0; i < n - p; ++i)
-			{
-				if ((i & p) == 0)
-				{
-					int32_minmax(&x[i], &x[i + p]);
-				}
-			}
-
-			i = 0;
-
-			for (int64_t q = top; q > p; q >>= 1)
-			{
-				for (; i < n - q; ++i)
-				{
-					if ((i & p) == 0)
-					{
-						int32_t a = x[i + p];
-
-						for (r = q; r > p; r >>= 1)
-						{
-							int32_minmax(&a, &x[i + r]);
-						}
-
-						x[i + p] = a;
-					}
-				}
-			}
-		}
-	}
-}
-
-static void int64_minmax(uint64_t* a, uint64_t* b)
-{
-	uint64_t c = *b - *a;
-
-	c >>= 63;
-	c = ~c + 1;
-	c &= *a ^ *b;
-	*a ^= c;
-	*b ^= c;
-}
-
-static void uint64_sort(uint64_t *x, int64_t n)
-{
-	int64_t top;
-	int64_t r;
-	int64_t i;
-
-	if (n >= 2)
-	{
-		top = 1;
-
-		while (top < n - top)
-		{
-			top += top;
-		}
-
-		for (int64_t p = top; p > 0; p >>= 1)
-		{
-			for (i = 0; i < n - p; ++i)
-			{
-				if ((i & p) == 0)
-				{
-					int64_minmax(&x[i], &x[i + p]);
-				}
-			}
-
-			i = 0;
-
-			for (int64_t q = top; q > p; q >>= 1)
-			{
-				for (; i < n - q; ++i)
-				{
-					if ((i & p) == 0)
-					{
-						uint64_t a = x[i + p];
-
-						for (r = q; r > p; r >>= 1)
-						{
-							int64_minmax(&a, &x[i + r]);
-						}
-
-						x[i + p] = a;
-					}
-				}
-			}
-		}
-	}
-}
-
 /* root.c */
 
 static gf eval(const gf* f, gf a)
@@ -1096,7 +978,7 @@ static void cbrecursion(uint8_t* out, int64_t pos, int64_t step, const int16_t*
 		A[x] = ((pi[x] ^ 1) << 16) | pi[x ^ 1];
 	}
 
-	int32_sort(A, n); /* A = (id<<16)+pibar */
+	qsc_ctsort_int32(A, (size_t)n); /* A = (id<<16)+pibar */
 
 	for (x = 0; x < n; ++x) 
 	{
@@ -1119,14 +1001,14 @@ static void cbrecursion(uint8_t* out, int64_t pos, int64_t step, const int16_t*
 		A[x] = (A[x] << 16) | (int32_t)x; /* A = (pibar<<16)+id */
 	}
 
-	int32_sort(A, n); /* A = (id<<16)+pibar^-1 */
+	qsc_ctsort_int32(A, (size_t)n); /* A = (id<<16)+pibar^-1 */
 
 	for (x = 0; x < n; ++x)
 	{
 		A[x] = (A[x] << 16) + (B[x] >> 16); /* A = (pibar^(-1)<<16)+pibar */
 	}
 
-	int32_sort(A, n); /* A = (id<<16)+pibar^2 */
+	qsc_ctsort_int32(A, (size_t)n); /* A = (id<<16)+pibar^2 */
 
 	if (w <= 10)
 	{
@@ -1144,14 +1026,14 @@ static void cbrecursion(uint8_t* out, int64_t pos, int64_t step, const int16_t*
 				A[x] = ((B[x] & ~0x000003FFL) << 6) | (int32_t)x; /* A = (p<<16)+id */
 			}
 
-			int32_sort(A, n); /* A = (id<<16)+p^{-1} */
+			qsc_ctsort_int32(A, (size_t)n); /* A = (id<<16)+p^{-1} */
 
 			for (x = 0; x < n; ++x)
 			{
 				A[x] = (A[x] << 20) | B[x]; /* A = (p^{-1}<<20)+(p<<10)+c */
 			}
 
-			int32_sort(A, n); /* A = (id<<20)+(pp<<10)+cp */
+			qsc_ctsort_int32(A, (size_t)n); /* A = (id<<20)+(pp<<10)+cp */
 
 			for (x = 0; x < n; ++x)
 			{
@@ -1188,7 +1070,7 @@ static void cbrecursion(uint8_t* out, int64_t pos, int64_t step, const int16_t*
 				A[x] = (B[x] & ~0x0000FFFFL) | (int32_t)x;
 			}
 
-			int32_sort(A, n); /* A = (id<<16)+p^(-1) */
+			qsc_ctsort_int32(A, (size_t)n); /* A = (id<<16)+p^(-1) */
 
 			for (x = 0; x < n; ++x)
 			{
@@ -1206,7 +1088,7 @@ static void cbrecursion(uint8_t* out, int64_t pos, int64_t step, const int16_t*
 
 				/* B = (p^(-1)<<16)+p */
 
-				int32_sort(B, n); /* B = (id<<16)+p^(-2) */
+				qsc_ctsort_int32(B, (size_t)n); /* B = (id<<16)+p^(-2) */
 
 				for (x = 0; x < n; ++x)
 				{
@@ -1215,7 +1097,7 @@ static void cbrecursion(uint8_t* out, int64_t pos, int64_t step, const int16_t*
 				/* B = (p^(-2)<<16)+c */
 			}
 
-			int32_sort(A, n);
+			qsc_ctsort_int32(A, (size_t)n);
 
 			/* A = id<<16+cp */
 			for (x = 0; x < n; ++x)
@@ -1240,7 +1122,7 @@ static void cbrecursion(uint8_t* out, int64_t pos, int64_t step, const int16_t*
 		A[x] = (((int32_t)pi[x]) << 16) + (int32_t)x;
 	}
 
-	int32_sort(A, n); /* A = (id<<16)+pi^(-1) */
+	qsc_ctsort_int32(A, (size_t)n); /* A = (id<<16)+pi^(-1) */
 
 	for (j = 0; j < n / 2; ++j)
 	{
@@ -1257,7 +1139,7 @@ static void cbrecursion(uint8_t* out, int64_t pos, int64_t step, const int16_t*
 	}
 
 	/* B = (pi^(-1)<<16)+F */
-	int32_sort(B, n);
+	qsc_ctsort_int32(B, (size_t)n);
 	/* B = (id<<16)+F(pi) */
 	pos += (2 * w - 3) * step * (n / 2);
 
@@ -1275,7 +1157,7 @@ static void cbrecursion(uint8_t* out, int64_t pos, int64_t step, const int16_t*
 	}
 
 	/* A = (L<<16)+F(pi) */
-	int32_sort(A, n); /* A = (id<<16)+F(pi(L)) = (id<<16)+M */
+	qsc_ctsort_int32(A, (size_t)n); /* A = (id<<16)+F(pi(L)) = (id<<16)+M */
 	pos -= (2 * w - 2) * step * (n / 2);
 
 	for (j = 0; j < n / 2; ++j)
@@ -1318,12 +1200,13 @@ static void cblayer(int16_t* p, const uint8_t* cb, int32_t s, int32_t n)
 	}
 }
 
-static void controlbits_from_permutation(uint8_t* out, const int16_t* pi, int64_t w, int64_t n)
+static void controlbits_from_permutation(uint8_t* out, const int16_t* pi, int64_t w, int64_t n, uint8_t* workspace)
 {
 	/* parameters: 1 <= w <= 14; n = 2^w
 	   input: permutation pi of {0,1,...,n-1}
 	   output: (2m-1)n/2 control bits at positions 0,1,...
-	   output position pos is by definition 1&(out[pos/8]>>(pos&7)) */
+	   output position pos is by definition 1&(out[pos/8]>>(pos&7))
+	   workspace: n * 2 int32 followed by n int16 */
 
 	int32_t* temp;
 	int16_t* pi_test;
@@ -1331,55 +1214,46 @@ static void controlbits_from_permutation(uint8_t* out, const int16_t* pi, int64_
 	int16_t diff;
 	const uint8_t* ptr;
 
-	temp = qsc_memutils_malloc((size_t)n * 2 * sizeof(int32_t));
-	pi_test = qsc_memutils_malloc((size_t)n * sizeof(int16_t));
-
-	assert(temp != NULL);
-	assert(pi_test != NULL);
+	temp = (int32_t*)workspace;
+	pi_test = (int16_t*)(workspace + ((size_t)n * 2 * sizeof(int32_t)));
 
-	if (temp != NULL && pi_test != NULL)
+	while (true)
 	{
-		while (true)
-		{
-			qsc_memutils_clear(out, (size_t)(((2 * w - 1) * n / 2) + 7) / 8);
-			cbrecursion(out, 0, 1, pi, w, n, temp);
+		qsc_memutils_clear(out, (size_t)(((2 * w - 1) * n / 2) + 7) / 8);
+		cbrecursion(out, 0, 1, pi, w, n, temp);
 
-			// check for correctness
+		// check for correctness
 
-			for (i = 0; i < n; ++i)
-			{
-				pi_test[i] = (int16_t)i;
-			}
+		for (i = 0; i < n; ++i)
+		{
+			pi_test[i] = (int16_t)i;
+		}
 
-			ptr = out;
+		ptr = out;
 
-			for (i = 0; i < w; ++i)
-			{
-				cblayer(pi_test, ptr, i, (int32_t)n);
-				ptr += n >> 4;
-			}
+		for (i = 0; i < w; ++i)
+		{
+			cblayer(pi_test, ptr, i, (int32_t)n);
+			ptr += n >> 4;
+		}
 
-			for (i = (int32_t)w - 2; i >= 0; --i)
-			{
-				cblayer(pi_test, ptr, i, (int32_t)n);
-				ptr += n >> 4;
-			}
+		for (i = (int32_t)w - 2; i >= 0; --i)
+		{
+			cblayer(pi_test, ptr, i, (int32_t)n);
+			ptr += n >> 4;
+		}
 
-			diff = 0;
+		diff = 0;
 
-			for (i = 0; i < n; ++i)
-			{
-				diff |= pi[i] ^ pi_test[i];
-			}
-
-			if (diff == 0)
-			{
-				break;
-			}
+		for (i = 0; i < n; ++i)
+		{
+			diff |= pi[i] ^ pi_test[i];
 		}
 
-		qsc_memutils_alloc_free(pi_test);
-		qsc_memutils_alloc_free(temp);
+		if (diff == 0)
+		{
+			break;
+		}
 	}
 }
 
@@ -1653,15 +1527,16 @@ static int32_t check_pk_padding(const uint8_t* pk)
 
 /* pk_gen.c */
 
-static int32_t pk_gen(uint8_t* pk, const uint8_t* sk, const uint32_t* perm, int16_t* pi)
+static int32_t pk_gen(uint8_t* pk, const uint8_t* sk, const uint32_t* perm, int16_t* pi, uint8_t* workspace)
 {
-	/* input: secret key sk output: public key pk */
+	/* input: secret key sk output: public key pk
+	   workspace: MCELIECE_PK_NROWS rows of MCELIECE_SYS_N / 8 bytes */
 
 	uint64_t buf[1 << MCELIECE_GFBITS] = { 0 };
 	gf g[MCELIECE_SYS_T + 1] = { 0 };	/* Goppa polynomial */
 	gf L[MCELIECE_SYS_N] = { 0 };		/* support */
 	gf inv[MCELIECE_SYS_N];
-	uint8_t** mat;
+	uint8_t (*mat)[MCELIECE_SYS_N / 8];
 	size_t i;
 	size_t j;
 	size_t k;
@@ -1670,7 +1545,6 @@ static int32_t pk_gen(uint8_t* pk, const uint8_t* sk, const uint32_t* perm, int1
 	int32_t res;
 	uint8_t b;
 	uint8_t mask;
-	bool balc;
 
 #if defined(QSC_MCELIECE_S6N6960T119)
 	uint8_t *pk_ptr = pk;
@@ -1679,200 +1553,166 @@ static int32_t pk_gen(uint8_t* pk, const uint8_t* sk, const uint32_t* perm, int1
 
 	res = -1;
 
-	mat = (uint8_t**)qsc_memutils_malloc(MCELIECE_PK_NROWS * sizeof(uint8_t*));
-	assert(mat != NULL);
+	mat = (uint8_t (*)[MCELIECE_SYS_N / 8])workspace;
+
+	g[MCELIECE_SYS_T] = 1;
 
-	if (mat != NULL)
+	for (i = 0; i < MCELIECE_SYS_T; ++i)
 	{
-		balc = true;
+		g[i] = load_gf(sk); 
+		sk += 2;
+	}
 
-		for (i = 0; i < MCELIECE_PK_NROWS; ++i)
-		{
-			mat[i] = (uint8_t*)qsc_memutils_malloc(MCELIECE_SYS_N / 8);
+	for (i = 0; i < (1 << MCELIECE_GFBITS); i++)
+	{
+		buf[i] = perm[i];
+		buf[i] <<= 31;
+		buf[i] |= i;
+	}
 
-			if (mat[i] == NULL)
-			{
-				balc = false;
-				break;
-			}
+	qsc_ctsort_uint64(buf, 1 << MCELIECE_GFBITS);
+
+	for (i = 1; i < (1 << MCELIECE_GFBITS); ++i)
+	{
+		if ((buf[i - 1] >> 31) == (buf[i] >> 31))
+		{
+			res = -2;
+			break;
+		}
+	}
+	
+	if (res != -2)
+	{
+		for (i = 0; i < (1 << MCELIECE_GFBITS); ++i)
+		{
+			pi[i] = buf[i] & MCELIECE_GFMASK;
 		}
 
-		if (balc == true)
+		for (i = 0; i < MCELIECE_SYS_N; ++i)
 		{
-			g[MCELIECE_SYS_T] = 1;
+			L[i] = bitrev(pi[i]);
+		}
 
-			for (i = 0; i < MCELIECE_SYS_T; ++i)
-			{
-				g[i] = load_gf(sk); 
-				sk += 2;
-			}
+		/* filling the matrix */
 
-			for (i = 0; i < (1 << MCELIECE_GFBITS); i++)
-			{
-				buf[i] = perm[i];
-				buf[i] <<= 31;
-				buf[i] |= i;
-			}
+		root(inv, g, L);
 
-			uint64_sort(buf, 1 << MCELIECE_GFBITS);
+		for (i = 0; i < MCELIECE_SYS_N; ++i)
+		{
+			inv[i] = gf_inv(inv[i]);
+		}
 
-			for (i = 1; i < (1 << MCELIECE_GFBITS); ++i)
+		for (i = 0; i < MCELIECE_PK_NROWS; ++i)
+		{
+			for (j = 0; j < MCELIECE_SYS_N / 8; ++j)
 			{
-				if ((buf[i - 1] >> 31) == (buf[i] >> 31))
-				{
-					res = -2;
-					break;
-				}
+				mat[i][j] = 0;
 			}
-			
-			if (res != -2)
+		}
+
+		for (i = 0; i < MCELIECE_SYS_T; ++i)
+		{
+			for (j = 0; j < MCELIECE_SYS_N; j += 8)
 			{
-				for (i = 0; i < (1 << MCELIECE_GFBITS); ++i)
+				for (k = 0; k < MCELIECE_GFBITS; ++k)
 				{
-					pi[i] = buf[i] & MCELIECE_GFMASK;
+					b = (inv[j + 7] >> k) & 1;
+					b <<= 1;
+					b |= (inv[j + 6] >> k) & 1;
+					b <<= 1;
+					b |= (inv[j + 5] >> k) & 1;
+					b <<= 1;
+					b |= (inv[j + 4] >> k) & 1;
+					b <<= 1;
+					b |= (inv[j + 3] >> k) & 1;
+					b <<= 1;
+					b |= (inv[j + 2] >> k) & 1;
+					b <<= 1;
+					b |= (inv[j + 1] >> k) & 1;
+					b <<= 1;
+					b |= (inv[j] >> k) & 1;
+
+					mat[i * MCELIECE_GFBITS + k][j / 8] = b;
 				}
+			}
 
-				for (i = 0; i < MCELIECE_SYS_N; ++i)
-				{
-					L[i] = bitrev(pi[i]);
-				}
+			for (j = 0; j < MCELIECE_SYS_N; ++j)
+			{
+				inv[j] = gf_mul(inv[j], L[j]);
+			}
+		}
 
-				/* filling the matrix */
+		/* gaussian elimination */
 
-				root(inv, g, L);
+		for (i = 0; i < (MCELIECE_PK_NROWS + 7) / 8; ++i)
+		{
+			for (j = 0; j < 8; ++j)
+			{
+				row = i * 8 + j;
 
-				for (i = 0; i < MCELIECE_SYS_N; ++i)
+				if (row >= MCELIECE_PK_NROWS)
 				{
-					inv[i] = gf_inv(inv[i]);
+					break;
 				}
 
-				for (i = 0; i < MCELIECE_PK_NROWS; ++i)
+				for (k = row + 1; k < MCELIECE_PK_NROWS; ++k)
 				{
-					for (j = 0; j < MCELIECE_SYS_N / 8; ++j)
+					mask = mat[row][i] ^ mat[k][i];
+					mask >>= j;
+					mask &= 1;
+					mask = -mask;
+
+					for (col = 0; col < MCELIECE_SYS_N / 8; ++col)
 					{
-						mat[i][j] = 0;
+						mat[row][col] ^= mat[k][col] & mask;
 					}
 				}
 
-				for (i = 0; i < MCELIECE_SYS_T; ++i)
+				/* return if not systematic */
+				if (((mat[row][i] >> j) & 1) == 0)
 				{
-					for (j = 0; j < MCELIECE_SYS_N; j += 8)
-					{
-						for (k = 0; k < MCELIECE_GFBITS; ++k)
-						{
-							b = (inv[j + 7] >> k) & 1;
-							b <<= 1;
-							b |= (inv[j + 6] >> k) & 1;
-							b <<= 1;
-							b |= (inv[j + 5] >> k) & 1;
-							b <<= 1;
-							b |= (inv[j + 4] >> k) & 1;
-							b <<= 1;
-							b |= (inv[j + 3] >> k) & 1;
-							b <<= 1;
-							b |= (inv[j + 2] >> k) & 1;
-							b <<= 1;
-							b |= (inv[j + 1] >> k) & 1;
-							b <<= 1;
-							b |= (inv[j] >> k) & 1;
-
-							mat[i * MCELIECE_GFBITS + k][j / 8] = b;
-						}
-					}
-
-					for (j = 0; j < MCELIECE_SYS_N; ++j)
-					{
-						inv[j] = gf_mul(inv[j], L[j]);
-					}
+					return -1;
 				}
 
-				/* gaussian elimination */
-
-				for (i = 0; i < (MCELIECE_PK_NROWS + 7) / 8; ++i)
+				for (k = 0; k < MCELIECE_PK_NROWS; ++k)
 				{
-					for (j = 0; j < 8; ++j)
+					if (k != row)
 					{
-						row = i * 8 + j;
-
-						if (row >= MCELIECE_PK_NROWS)
-						{
-							break;
-						}
-
-						for (k = row + 1; k < MCELIECE_PK_NROWS; ++k)
-						{
-							mask = mat[row][i] ^ mat[k][i];
-							mask >>= j;
-							mask &= 1;
-							mask = -mask;
-
-							for (col = 0; col < MCELIECE_SYS_N / 8; ++col)
-							{
-								mat[row][col] ^= mat[k][col] & mask;
-							}
-						}
-
-						/* return if not systematic */
-						if (((mat[row][i] >> j) & 1) == 0)
-						{
-							for (i = 0; i < MCELIECE_PK_NROWS; ++i)
-							{
-								qsc_memutils_alloc_free(mat[i]);
-							}
+						mask = mat[k][i] >> j;
+						mask &= 1;
+						mask = -mask;
 
-							qsc_memutils_alloc_free(mat);
-
-							return -1;
-						}
-
-						for (k = 0; k < MCELIECE_PK_NROWS; ++k)
+						for (col = 0; col < MCELIECE_SYS_N / 8; ++col)
 						{
-							if (k != row)
-							{
-								mask = mat[k][i] >> j;
-								mask &= 1;
-								mask = -mask;
-
-								for (col = 0; col < MCELIECE_SYS_N / 8; ++col)
-								{
-									mat[k][col] ^= mat[row][col] & mask;
-								}
-							}
+							mat[k][col] ^= mat[row][col] & mask;
 						}
 					}
 				}
+			}
+		}
 
 #if defined(QSC_MCELIECE_S6N6960T119)
-				tail = MCELIECE_PK_NROWS % 8;
-
-				for (i = 0; i < MCELIECE_PK_NROWS; ++i)
-				{
-					for (j = (MCELIECE_PK_NROWS - 1) / 8; j < MCELIECE_SYS_N / 8 - 1; ++j)
-					{
-						*pk_ptr = (uint8_t)((mat[i][j] >> tail) | (mat[i][j + 1] << (8 - tail)));
-						++pk_ptr;
-					}
+		tail = MCELIECE_PK_NROWS % 8;
 
-					*pk_ptr = (mat[i][j] >> tail);
-					++pk_ptr;
-				}
-#else
-				for (i = 0; i < MCELIECE_PK_NROWS; ++i)
-				{
-					qsc_memutils_copy(pk + i * MCELIECE_PK_ROW_BYTES, mat[i] + MCELIECE_PK_NROWS / 8, MCELIECE_PK_ROW_BYTES);
-				}
-#endif
+		for (i = 0; i < MCELIECE_PK_NROWS; ++i)
+		{
+			for (j = (MCELIECE_PK_NROWS - 1) / 8; j < MCELIECE_SYS_N / 8 - 1; ++j)
+			{
+				*pk_ptr = (uint8_t)((mat[i][j] >> tail) | (mat[i][j + 1] << (8 - tail)));
+				++pk_ptr;
 			}
 
-			res = 0;
+			*pk_ptr = (mat[i][j] >> tail);
+			++pk_ptr;
 		}
-
+#else
 		for (i = 0; i < MCELIECE_PK_NROWS; ++i)
 		{
-			qsc_memutils_alloc_free(mat[i]);
+			qsc_memutils_copy(pk + i * MCELIECE_PK_ROW_BYTES, mat[i] + MCELIECE_PK_NROWS / 8, MCELIECE_PK_ROW_BYTES);
 		}
+#endif
 
-		qsc_memutils_alloc_free(mat);
+		res = 0;
 	}
 
 	return res;
@@ -2073,7 +1913,7 @@ int32_t qsc_mceliece_ref_decapsulate(uint8_t* key, const uint8_t* c, const uint8
 #endif
 }
 
-int32_t qsc_mceliece_ref_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
+int32_t qsc_mceliece_ref_generate_keypair_workspace(uint8_t* pk, uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t), uint8_t* workspace)
 {
 	uint32_t perm[1 << MCELIECE_GFBITS] = { 0 };	/* random permutation as 32-bit integers */
 	int16_t pi[1 << MCELIECE_GFBITS];	/* random permutation */
@@ -2129,12 +1969,12 @@ int32_t qsc_mceliece_ref_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_g
 			perm[i] = load4(rp + i * 4);
 		}
 
-		if (pk_gen(pk, skp - MCELIECE_IRR_BYTES, perm, pi) != 0)
+		if (pk_gen(pk, skp - MCELIECE_IRR_BYTES, perm, pi, workspace) != 0)
 		{
 			continue;
 		}
 
-		controlbits_from_permutation(skp, pi, MCELIECE_GFBITS, 1 << MCELIECE_GFBITS);
+		controlbits_from_permutation(skp, pi, MCELIECE_GFBITS, 1 << MCELIECE_GFBITS, workspace);
 		skp += MCELIECE_COND_BYTES;
 
 		/* storing the random string s */
@@ -2150,3 +1990,25 @@ int32_t qsc_mceliece_ref_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_g
 	return 0;
 }
 
+int32_t qsc_mceliece_ref_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
+{
+	uint8_t* wsp;
+	int32_t res;
+
+	res = -1;
+	wsp = (uint8_t*)qsc_memutils_large_alloc(MCELIECE_WORKSPACE_SIZE, QSC_MEMUTILS_NUMA_NODE_ANY);
+	assert(wsp != NULL);
+
+	if (wsp != NULL)
+	{
+		res = qsc_mceliece_ref_generate_keypair_workspace(pk, sk, rng_generate, wsp);
+		qsc_memutils_large_free(wsp, MCELIECE_WORKSPACE_SIZE);
+	}
+
+	return res;
+}
+
+size_t qsc_mceliece_ref_workspace_size(void)
+{
+	return (size_t)MCELIECE_WORKSPACE_SIZE;
+}
@@ -81,6 +81,24 @@ int32_t qsc_mceliece_ref_encapsulate(uint8_t* c, uint8_t* key, const uint8_t* pk
 */
 int32_t qsc_mceliece_ref_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t));
 
+/**
+* \brief Generates public and private key using a caller supplied workspace for the public matrix and control bits
+*
+* \param pk:	[uint8_t*] Pointer to the output public-key array of QSC_MCELIECE_PUBLICKEY_SIZE constant size
+* \param sk:	[uint8_t*] Pointer to output private-key array of QSC_MCELIECE_PRIVATEKEY_SIZE constant size
+* \param rng_generate: [uint8_t*, size_t] Pointer to the random generator function
+* \param workspace: [uint8_t*] Pointer to a 4-byte aligned workspace of qsc_mceliece_ref_workspace_size() bytes
+* \return		[int32_t] Returns 0 for success
+*/
+int32_t qsc_mceliece_ref_generate_keypair_workspace(uint8_t* pk, uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t), uint8_t* workspace);
+
+/**
+* \brief Returns the byte size of the key generation workspace
+*
+* \return		[size_t] The workspace size
+*/
+size_t qsc_mceliece_ref_workspace_size(void);
+
 QSC_CPLUSPLUS_ENABLED_END
 
 /* \endcond */
@@ -1,4 +1,5 @@
 ﻿#include "memutils.h"
+#include "async.h"
 #include <stdlib.h>
 #if defined(QSC_SYSTEM_AVX_INTRINSICS)
 #	include "intrinsics.h"
@@ -14,6 +15,9 @@
 #	include <setjmp.h>
 #	include <unistd.h>
 #	include <errno.h>
+#	if defined(QSC_SYSTEM_OS_LINUX)
+#		include <sys/syscall.h>
+#	endif
 #elif defined(QSC_SYSTEM_OS_WINDOWS)
 #	include <windows.h>
 #endif
@@ -1084,6 +1088,194 @@ bool qsc_memutils_greater_than_le512(const uint8_t* a, const uint8_t* b)
 	return res;
 }
 
+static size_t memutils_large_length(size_t length)
+{
+	const size_t PGESZE = qsc_memutils_page_size();
+	size_t alen;
+
+	/* blocks of at least half a huge page are rounded to whole huge pages, smaller blocks to standard pages */
+	if (length >= QSC_MEMUTILS_LARGE_PAGE_SIZE / 2U)
+	{
+		alen = (length + QSC_MEMUTILS_LARGE_PAGE_SIZE - 1U) & ~(size_t)(QSC_MEMUTILS_LARGE_PAGE_SIZE - 1U);
+	}
+	else
+	{
+		alen = ((length + PGESZE - 1U) / PGESZE) * PGESZE;
+	}
+
+	return alen;
+}
+
+#if defined(QSC_SYSTEM_OS_LINUX) && defined(SYS_mbind)
+static void memutils_large_bind(void* block, size_t length, int32_t node)
+{
+	/* MPOL_PREFERRED: allocate on the node when it has free pages, otherwise fall back to any node */
+	const int32_t MPOLPREF = 1;
+	const size_t NBITS = sizeof(unsigned long) * 8U;
+	unsigned long mask[16] = { 0 };
+
+	if (node >= 0 && (size_t)node < sizeof(mask) * 8U)
+	{
+		mask[(size_t)node / NBITS] = 1UL << ((size_t)node % NBITS);
+		(void)syscall(SYS_mbind, block, length, MPOLPREF, mask, (unsigned long)(sizeof(mask) * 8U), 0U);
+	}
+}
+#endif
+
+void* qsc_memutils_large_alloc(size_t length, int32_t node)
+{
+	assert(length != 0);
+
+#if defined(QSC_SYSTEM_OS_POSIX)
+	uint8_t* base;
+#elif defined(QSC_SYSTEM_OS_WINDOWS)
+	SIZE_T lpgsze;
+	DWORD atype;
+#endif
+	uint8_t* ptr;
+	size_t alen;
+
+	ptr = NULL;
+
+	if (length != 0)
+	{
+		alen = memutils_large_length(length);
+
+#if defined(QSC_SYSTEM_OS_POSIX)
+
+#	if !defined(MAP_ANONYMOUS)
+#		define MAP_ANONYMOUS 0x0002
+#	endif
+
+#	if defined(MAP_HUGETLB)
+		/* explicit huge pages, only available when the administrator has reserved them */
+		if (alen % QSC_MEMUTILS_LARGE_PAGE_SIZE == 0U)
+		{
+			base = (uint8_t*)mmap(NULL, alen, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+			if (base != (uint8_t*)MAP_FAILED)
+			{
+				ptr = base;
+			}
+		}
+#	endif
+
+		if (ptr == NULL && alen % QSC_MEMUTILS_LARGE_PAGE_SIZE == 0U)
+		{
+			/* over-map, then trim to a huge page boundary so transparent huge pages can back the whole block */
+			base = (uint8_t*)mmap(NULL, alen + QSC_MEMUTILS_LARGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+			if (base != (uint8_t*)MAP_FAILED)
+			{
+				size_t head;
+
+				head = (QSC_MEMUTILS_LARGE_PAGE_SIZE - ((uintptr_t)base & (QSC_MEMUTILS_LARGE_PAGE_SIZE - 1U))) & (QSC_MEMUTILS_LARGE_PAGE_SIZE - 1U);
+				ptr = base + head;
+
+				if (head != 0U)
+				{
+					munmap(base, head);
+				}
+
+				munmap(ptr + alen, QSC_MEMUTILS_LARGE_PAGE_SIZE - head);
+
+#	if defined(MADV_HUGEPAGE)
+				madvise(ptr, alen, MADV_HUGEPAGE);
+#	endif
+			}
+		}
+		else if (ptr == NULL)
+		{
+			base = (uint8_t*)mmap(NULL, alen, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+			if (base != (uint8_t*)MAP_FAILED)
+			{
+				ptr = base;
+			}
+		}
+
+		if (ptr != NULL)
+		{
+#	if defined(MADV_DONTDUMP)
+			madvise(ptr, alen, MADV_DONTDUMP);
+#	endif
+
+#	if defined(QSC_SYSTEM_OS_LINUX) && defined(SYS_mbind)
+			/* the policy must be set before the pages are first touched */
+			if (node != QSC_MEMUTILS_NUMA_NODE_ANY)
+			{
+				memutils_large_bind(ptr, alen, node);
+			}
+#	else
+			(void)node;
+#	endif
+		}
+
+#elif defined(QSC_SYSTEM_OS_WINDOWS)
+
+		lpgsze = GetLargePageMinimum();
+		atype = MEM_RESERVE | MEM_COMMIT;
+
+		/* large pages require the SeLockMemoryPrivilege, fall back to standard pages without it */
+		if (lpgsze != 0 && alen % lpgsze == 0U && alen % QSC_MEMUTILS_LARGE_PAGE_SIZE == 0U)
+		{
+			if (node != QSC_MEMUTILS_NUMA_NODE_ANY)
+			{
+				ptr = (uint8_t*)VirtualAllocExNuma(GetCurrentProcess(), NULL, alen, atype | MEM_LARGE_PAGES, PAGE_READWRITE, (DWORD)node);
+			}
+			else
+			{
+				ptr = (uint8_t*)VirtualAlloc(NULL, alen, atype | MEM_LARGE_PAGES, PAGE_READWRITE);
+			}
+		}
+
+		if (ptr == NULL)
+		{
+			if (node != QSC_MEMUTILS_NUMA_NODE_ANY)
+			{
+				ptr = (uint8_t*)VirtualAllocExNuma(GetCurrentProcess(), NULL, alen, atype, PAGE_READWRITE, (DWORD)node);
+			}
+			else
+			{
+				ptr = (uint8_t*)VirtualAlloc(NULL, alen, atype, PAGE_READWRITE);
+			}
+		}
+
+#else
+
+		(void)node;
+		ptr = (uint8_t*)qsc_memutils_aligned_alloc((int32_t)QSC_MEMUTILS_MEMORY_PAGE_SIZE, alen);
+
+		if (ptr != NULL)
+		{
+			qsc_memutils_clear(ptr, alen);
+		}
+
+#endif
+	}
+
+	return ptr;
+}
+
+void qsc_memutils_large_free(void* block, size_t length)
+{
+	assert(block != NULL);
+	assert(length != 0);
+
+	if (block != NULL && length != 0)
+	{
+		qsc_memutils_secure_erase(block, length);
+
+#if defined(QSC_SYSTEM_OS_POSIX)
+		munmap(block, memutils_large_length(length));
+#elif defined(QSC_SYSTEM_OS_WINDOWS)
+		VirtualFree(block, 0, MEM_RELEASE);
+#else
+		qsc_memutils_aligned_free(block);
+#endif
+	}
+}
+
 void qsc_memutils_move(void* output, const void* input, size_t length)
 {
 	assert(output != NULL);
@@ -1097,6 +1289,550 @@ void qsc_memutils_move(void* output, const void* input, size_t length)
 #endif
 }
 
+#define MEMUTILS_POOL_CLASS_COUNT 8U
+#define MEMUTILS_POOL_CLASS_MINIMUM 32U
+#define MEMUTILS_POOL_HEADER_SIZE 16U
+#define MEMUTILS_POOL_SLAB_HEADER_SIZE 64U
+#define MEMUTILS_POOL_SLAB_SIZE 65536U
+#define MEMUTILS_POOL_CLASS_LARGE 0xFFFFFFFFUL
+#define MEMUTILS_POOL_STATE_ALLOCATED 0xA5U
+#define MEMUTILS_POOL_STATE_RELEASED 0x5AU
+
+#if defined(QSC_SYSTEM_COMPILER_MSC)
+#	define MEMUTILS_THREAD_LOCAL __declspec(thread)
+#else
+#	define MEMUTILS_THREAD_LOCAL __thread
+#endif
+
+typedef struct memutils_pool_header
+{
+	uint32_t magic;						/* the owning pool's identifier */
+	uint32_t sclass;					/* the size class index, or MEMUTILS_POOL_CLASS_LARGE */
+	uint32_t state;						/* the allocated or released marker */
+	uint32_t length;					/* the mapped length in pages of a large block */
+} memutils_pool_header;
+
+typedef struct memutils_pool_slab
+{
+	struct memutils_pool_slab* next;	/* the next slab in the pool */
+	size_t length;						/* the mapped slab length */
+} memutils_pool_slab;
+
+typedef struct memutils_pool_cache
+{
+	void* blocks[MEMUTILS_POOL_CLASS_COUNT];	/* the free list heads per size class */
+	size_t allocations;					/* the allocations served by this cache */
+	size_t releases;					/* the releases returned to this cache */
+	size_t inuse;						/* the bytes allocated less the bytes released through this cache */
+	volatile int32_t lock;				/* the cache spin lock */
+	uint8_t padding[(QSC_MEMUTILS_CACHE_LINE_SIZE * 2U) - (sizeof(void*) * MEMUTILS_POOL_CLASS_COUNT) - (sizeof(size_t) * 3U) - sizeof(int32_t)];
+} memutils_pool_cache;
+
+struct qsc_memutils_pool
+{
+	memutils_pool_cache caches[QSC_MEMUTILS_POOL_CACHE_COUNT];	/* the per-thread caches */
+	memutils_pool_slab* slabs;			/* the list of mapped slabs */
+	size_t failures;					/* the failed allocation count */
+	size_t large;						/* the outstanding large block count */
+	size_t reserved;					/* the total bytes mapped by the pool */
+	size_t slabcount;					/* the number of mapped slabs */
+	uint32_t flags;						/* the qsc_memutils_pool_flags options */
+	uint32_t magic;						/* the pool identifier stored in each block header */
+	volatile int32_t lock;				/* the pool spin lock guarding the slab list and counters */
+};
+
+static volatile uint32_t memutils_pool_counter;
+static MEMUTILS_THREAD_LOCAL uint32_t memutils_pool_thread_slot;
+
+static uint32_t memutils_atomic_increment(volatile uint32_t* value)
+{
+#if defined(QSC_SYSTEM_COMPILER_MSC)
+	return (uint32_t)InterlockedIncrement((volatile LONG*)value);
+#else
+	return __atomic_add_fetch(value, 1U, __ATOMIC_RELAXED);
+#endif
+}
+
+static memutils_pool_cache* memutils_pool_thread_cache(qsc_memutils_pool* pool)
+{
+	/* each thread is bound to one cache on first use, spreading threads across the caches */
+	if (memutils_pool_thread_slot == 0U)
+	{
+		memutils_pool_thread_slot = memutils_atomic_increment(&memutils_pool_counter);
+
+		if (memutils_pool_thread_slot == 0U)
+		{
+			memutils_pool_thread_slot = memutils_atomic_increment(&memutils_pool_counter);
+		}
+	}
+
+	return &pool->caches[memutils_pool_thread_slot % QSC_MEMUTILS_POOL_CACHE_COUNT];
+}
+
+static uint32_t memutils_pool_class(size_t length)
+{
+	size_t csize;
+	uint32_t cls;
+
+	cls = 0U;
+	csize = MEMUTILS_POOL_CLASS_MINIMUM;
+
+	while (csize < length)
+	{
+		csize <<= 1U;
+		++cls;
+	}
+
+	return cls;
+}
+
+static size_t memutils_pool_class_size(uint32_t sclass)
+{
+	return (size_t)MEMUTILS_POOL_CLASS_MINIMUM << sclass;
+}
+
+static void* memutils_pool_map(size_t length, uint32_t flags)
+{
+	const size_t PGESZE = qsc_memutils_page_size();
+	uint8_t* base;
+	uint8_t* ptr;
+	size_t glen;
+
+	base = NULL;
+	ptr = NULL;
+	glen = ((flags & qsc_memutils_pool_flag_guarded) != 0U) ? PGESZE : 0U;
+
+#if defined(QSC_SYSTEM_OS_POSIX)
+
+#	if !defined(MAP_ANONYMOUS)
+#		define MAP_ANONYMOUS 0x0002
+#	endif
+
+	base = (uint8_t*)mmap(NULL, length + (glen * 2U), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if (base != (uint8_t*)MAP_FAILED)
+	{
+		ptr = base + glen;
+
+		/* inaccessible pages on either side trap linear overruns */
+		if (glen != 0U && (mprotect(base, glen, PROT_NONE) != 0 || mprotect(ptr + length, glen, PROT_NONE) != 0))
+		{
+			ptr = NULL;
+		}
+
+#	if defined(MADV_DONTDUMP)
+		if (ptr != NULL)
+		{
+			madvise(ptr, length, MADV_DONTDUMP);
+		}
+#	endif
+
+		if (ptr != NULL && (flags & qsc_memutils_pool_flag_locked) != 0U && mlock(ptr, length) != 0)
+		{
+			ptr = NULL;
+		}
+
+		if (ptr == NULL)
+		{
+			munmap(base, length + (glen * 2U));
+		}
+	}
+
+#elif defined(QSC_SYSTEM_OS_WINDOWS)
+
+	DWORD prot;
+
+	base = (uint8_t*)VirtualAlloc(NULL, length + (glen * 2U), MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+	if (base != NULL)
+	{
+		ptr = base + glen;
+
+		if (glen != 0U && (VirtualProtect(base, glen, PAGE_NOACCESS, &prot) == 0 || VirtualProtect(ptr + length, glen, PAGE_NOACCESS, &prot) == 0))
+		{
+			ptr = NULL;
+		}
+
+		if (ptr != NULL && (flags & qsc_memutils_pool_flag_locked) != 0U && VirtualLock(ptr, length) == 0)
+		{
+			ptr = NULL;
+		}
+
+		if (ptr == NULL)
+		{
+			VirtualFree(base, 0, MEM_RELEASE);
+		}
+	}
+
+#else
+
+	(void)base;
+	(void)glen;
+	ptr = (uint8_t*)malloc(length);
+
+	if (ptr != NULL)
+	{
+		qsc_memutils_clear(ptr, length);
+	}
+
+#endif
+
+	return ptr;
+}
+
+static void memutils_pool_unmap(void* block, size_t length, uint32_t flags)
+{
+	const size_t PGESZE = qsc_memutils_page_size();
+	size_t glen;
+
+	glen = ((flags & qsc_memutils_pool_flag_guarded) != 0U) ? PGESZE : 0U;
+	qsc_memutils_secure_erase(block, length);
+
+#if defined(QSC_SYSTEM_OS_POSIX)
+
+	if ((flags & qsc_memutils_pool_flag_locked) != 0U)
+	{
+		munlock(block, length);
+	}
+
+	munmap((uint8_t*)block - glen, length + (glen * 2U));
+
+#elif defined(QSC_SYSTEM_OS_WINDOWS)
+
+	if ((flags & qsc_memutils_pool_flag_locked) != 0U)
+	{
+		VirtualUnlock(block, length);
+	}
+
+	VirtualFree((uint8_t*)block - glen, 0, MEM_RELEASE);
+
+#else
+
+	(void)glen;
+	free(block);
+
+#endif
+}
+
+static void* memutils_pool_slab_create(qsc_memutils_pool* pool, uint32_t sclass, void** chain)
+{
+	memutils_pool_header* hdr;
+	memutils_pool_slab* slab;
+	uint8_t* pblk;
+	void* first;
+	size_t bcnt;
+	size_t stride;
+
+	first = NULL;
+	*chain = NULL;
+	slab = (memutils_pool_slab*)memutils_pool_map(MEMUTILS_POOL_SLAB_SIZE, pool->flags);
+
+	if (slab != NULL)
+	{
+		/* carve the slab into blocks of one size class, each preceded by its header */
+		stride = memutils_pool_class_size(sclass) + MEMUTILS_POOL_HEADER_SIZE;
+		bcnt = (MEMUTILS_POOL_SLAB_SIZE - MEMUTILS_POOL_SLAB_HEADER_SIZE) / stride;
+		pblk = (uint8_t*)slab + MEMUTILS_POOL_SLAB_HEADER_SIZE;
+
+		for (size_t i = 0U; i < bcnt; ++i)
+		{
+			hdr = (memutils_pool_header*)(pblk + (i * stride));
+			hdr->magic = pool->magic;
+			hdr->sclass = sclass;
+			hdr->state = MEMUTILS_POOL_STATE_RELEASED;
+			hdr->length = 0U;
+
+			/* link the free blocks through their first word */
+			*(void**)((uint8_t*)hdr + MEMUTILS_POOL_HEADER_SIZE) = (i + 1U < bcnt) ? (pblk + ((i + 1U) * stride) + MEMUTILS_POOL_HEADER_SIZE) : NULL;
+		}
+
+		first = pblk + MEMUTILS_POOL_HEADER_SIZE;
+		*chain = *(void**)first;
+
+		qsc_async_spinlock_lock(&pool->lock);
+		slab->length = MEMUTILS_POOL_SLAB_SIZE;
+		slab->next = pool->slabs;
+		pool->slabs = slab;
+		++pool->slabcount;
+		pool->reserved += MEMUTILS_POOL_SLAB_SIZE;
+		qsc_async_spinlock_unlock(&pool->lock);
+	}
+
+	return first;
+}
+
+static void memutils_pool_cache_push(memutils_pool_cache* cache, uint32_t sclass, void* chain)
+{
+	void* tail;
+
+	/* splice a linked run of free blocks onto the class free list */
+	if (chain != NULL)
+	{
+		tail = chain;
+
+		while (*(void**)tail != NULL)
+		{
+			tail = *(void**)tail;
+		}
+
+		*(void**)tail = cache->blocks[sclass];
+		cache->blocks[sclass] = chain;
+	}
+}
+
+void* qsc_memutils_pool_alloc(qsc_memutils_pool* pool, size_t length)
+{
+	assert(pool != NULL);
+	assert(length != 0);
+
+	memutils_pool_cache* cache;
+	memutils_pool_header* hdr;
+	void* chain;
+	uint8_t* ptr;
+	size_t mlen;
+	uint32_t sclass;
+
+	ptr = NULL;
+
+	if (pool != NULL && length != 0U)
+	{
+		if (length <= QSC_MEMUTILS_POOL_CLASS_MAXIMUM)
+		{
+			sclass = memutils_pool_class(length);
+			cache = memutils_pool_thread_cache(pool);
+
+			qsc_async_spinlock_lock(&cache->lock);
+			ptr = (uint8_t*)cache->blocks[sclass];
+
+			if (ptr != NULL)
+			{
+				cache->blocks[sclass] = *(void**)ptr;
+			}
+			else
+			{
+				/* the cache is empty, map a new slab and keep the rest of its blocks */
+				qsc_async_spinlock_unlock(&cache->lock);
+				ptr = (uint8_t*)memutils_pool_slab_create(pool, sclass, &chain);
+				qsc_async_spinlock_lock(&cache->lock);
+				memutils_pool_cache_push(cache, sclass, chain);
+			}
+
+			if (ptr != NULL)
+			{
+				++cache->allocations;
+				cache->inuse += memutils_pool_class_size(sclass);
+			}
+
+			qsc_async_spinlock_unlock(&cache->lock);
+		}
+		else if (length < (size_t)-1 - qsc_memutils_page_size() - MEMUTILS_POOL_HEADER_SIZE)
+		{
+			/* large blocks are mapped individually */
+			mlen = length + MEMUTILS_POOL_HEADER_SIZE;
+			mlen = (mlen + qsc_memutils_page_size() - 1U) & ~(qsc_memutils_page_size() - 1U);
+			ptr = (uint8_t*)memutils_pool_map(mlen, pool->flags);
+
+			if (ptr != NULL)
+			{
+				hdr = (memutils_pool_header*)ptr;
+				hdr->magic = pool->magic;
+				hdr->sclass = MEMUTILS_POOL_CLASS_LARGE;
+				hdr->length = (uint32_t)(mlen / qsc_memutils_page_size());
+				ptr += MEMUTILS_POOL_HEADER_SIZE;
+
+				qsc_async_spinlock_lock(&pool->lock);
+				++pool->large;
+				pool->reserved += mlen;
+				qsc_async_spinlock_unlock(&pool->lock);
+
+				cache = memutils_pool_thread_cache(pool);
+				qsc_async_spinlock_lock(&cache->lock);
+				++cache->allocations;
+				cache->inuse += mlen;
+				qsc_async_spinlock_unlock(&cache->lock);
+			}
+		}
+
+		if (ptr != NULL)
+		{
+			/* released blocks are wiped, so only the free list link needs clearing */
+			hdr = (memutils_pool_header*)(ptr - MEMUTILS_POOL_HEADER_SIZE);
+			hdr->state = MEMUTILS_POOL_STATE_ALLOCATED;
+			*(void**)ptr = NULL;
+		}
+		else
+		{
+			qsc_async_spinlock_lock(&pool->lock);
+			++pool->failures;
+			qsc_async_spinlock_unlock(&pool->lock);
+		}
+	}
+
+	return ptr;
+}
+
+qsc_memutils_pool* qsc_memutils_pool_create(uint32_t flags)
+{
+	qsc_memutils_pool* pool;
+
+	pool = (qsc_memutils_pool*)qsc_memutils_aligned_alloc((int32_t)QSC_MEMUTILS_CACHE_LINE_SIZE, sizeof(qsc_memutils_pool));
+
+	if (pool != NULL)
+	{
+		qsc_memutils_clear(pool, sizeof(qsc_memutils_pool));
+		pool->flags = flags;
+		pool->magic = 0x504F4F4CUL ^ (memutils_atomic_increment(&memutils_pool_counter) * 0x9E3779B9UL);
+	}
+
+	return pool;
+}
+
+void qsc_memutils_pool_destroy(qsc_memutils_pool* pool)
+{
+	assert(pool != NULL);
+
+	memutils_pool_slab* next;
+	memutils_pool_slab* slab;
+
+	if (pool != NULL)
+	{
+		slab = pool->slabs;
+
+		while (slab != NULL)
+		{
+			next = slab->next;
+			memutils_pool_unmap(slab, slab->length, pool->flags);
+			slab = next;
+		}
+
+		qsc_memutils_secure_erase(pool, sizeof(qsc_memutils_pool));
+		qsc_memutils_aligned_free(pool);
+	}
+}
+
+void qsc_memutils_pool_free(qsc_memutils_pool* pool, void* block)
+{
+	assert(pool != NULL);
+	assert(block != NULL);
+
+	memutils_pool_cache* cache;
+	memutils_pool_header* hdr;
+	size_t mlen;
+	uint32_t sclass;
+
+	if (pool != NULL && block != NULL)
+	{
+		hdr = (memutils_pool_header*)((uint8_t*)block - MEMUTILS_POOL_HEADER_SIZE);
+
+		/* reject blocks from another pool and repeated releases */
+		assert(hdr->magic == pool->magic && hdr->state == MEMUTILS_POOL_STATE_ALLOCATED);
+
+		if (hdr->magic == pool->magic && hdr->state == MEMUTILS_POOL_STATE_ALLOCATED)
+		{
+			hdr->state = MEMUTILS_POOL_STATE_RELEASED;
+			sclass = hdr->sclass;
+			cache = memutils_pool_thread_cache(pool);
+
+			if (sclass == MEMUTILS_POOL_CLASS_LARGE)
+			{
+				mlen = (size_t)hdr->length * qsc_memutils_page_size();
+				memutils_pool_unmap(hdr, mlen, pool->flags);
+
+				qsc_async_spinlock_lock(&pool->lock);
+				--pool->large;
+				pool->reserved -= mlen;
+				qsc_async_spinlock_unlock(&pool->lock);
+
+				qsc_async_spinlock_lock(&cache->lock);
+				++cache->releases;
+				cache->inuse -= mlen;
+				qsc_async_spinlock_unlock(&cache->lock);
+			}
+			else
+			{
+				/* wipe the block before it is returned to the caller's cache */
+				qsc_memutils_secure_erase(block, memutils_pool_class_size(sclass));
+
+				qsc_async_spinlock_lock(&cache->lock);
+				*(void**)block = cache->blocks[sclass];
+				cache->blocks[sclass] = block;
+				++cache->releases;
+				cache->inuse -= memutils_pool_class_size(sclass);
+				qsc_async_spinlock_unlock(&cache->lock);
+			}
+		}
+	}
+}
+
+bool qsc_memutils_pool_reserve(qsc_memutils_pool* pool, size_t length, size_t count)
+{
+	assert(pool != NULL);
+	assert(length != 0);
+
+	memutils_pool_cache* cache;
+	void* chain;
+	void* first;
+	size_t bcnt;
+	size_t total;
+	uint32_t sclass;
+	bool res;
+
+	res = false;
+
+	if (pool != NULL && length != 0U && length <= QSC_MEMUTILS_POOL_CLASS_MAXIMUM)
+	{
+		sclass = memutils_pool_class(length);
+		bcnt = (MEMUTILS_POOL_SLAB_SIZE - MEMUTILS_POOL_SLAB_HEADER_SIZE) / (memutils_pool_class_size(sclass) + MEMUTILS_POOL_HEADER_SIZE);
+		cache = memutils_pool_thread_cache(pool);
+		res = true;
+
+		/* map and pre-fault enough slabs to serve count blocks from the calling thread's cache */
+		for (total = 0U; total < count; total += bcnt)
+		{
+			first = memutils_pool_slab_create(pool, sclass, &chain);
+
+			if (first == NULL)
+			{
+				res = false;
+				break;
+			}
+
+			qsc_async_spinlock_lock(&cache->lock);
+			memutils_pool_cache_push(cache, sclass, first);
+			qsc_async_spinlock_unlock(&cache->lock);
+		}
+	}
+
+	return res;
+}
+
+void qsc_memutils_pool_statistics(qsc_memutils_pool* pool, qsc_memutils_pool_stats* stats)
+{
+	assert(pool != NULL);
+	assert(stats != NULL);
+
+	if (pool != NULL && stats != NULL)
+	{
+		qsc_memutils_clear(stats, sizeof(qsc_memutils_pool_stats));
+
+		for (size_t i = 0U; i < QSC_MEMUTILS_POOL_CACHE_COUNT; ++i)
+		{
+			qsc_async_spinlock_lock(&pool->caches[i].lock);
+			stats->allocations += pool->caches[i].allocations;
+			stats->releases += pool->caches[i].releases;
+			stats->inuse += pool->caches[i].inuse;
+			qsc_async_spinlock_unlock(&pool->caches[i].lock);
+		}
+
+		qsc_async_spinlock_lock(&pool->lock);
+		stats->failures = pool->failures;
+		stats->large = pool->large;
+		stats->reserved = pool->reserved;
+		stats->slabs = pool->slabcount;
+		qsc_async_spinlock_unlock(&pool->lock);
+	}
+}
+
 #if defined(QSC_SYSTEM_HAS_AVX)
 static void memutils_setval128(void* output, uint8_t value)
 {
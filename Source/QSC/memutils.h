@@ -85,6 +85,65 @@ QSC_CPLUSPLUS_ENABLED_START
  */
 #define QSC_MEMUTILS_MEMORY_PAGE_SIZE 4096ULL
 
+/*!
+ * \def QSC_MEMUTILS_LARGE_PAGE_SIZE
+ * \brief The huge page size used by the large block allocator.
+ * Large block requests of at least half this size are rounded up to a multiple of it.
+ */
+#define QSC_MEMUTILS_LARGE_PAGE_SIZE 2097152ULL
+
+/*!
+ * \def QSC_MEMUTILS_NUMA_NODE_ANY
+ * \brief The large block allocator node hint that leaves page placement to the operating system.
+ */
+#define QSC_MEMUTILS_NUMA_NODE_ANY -1
+
+/*!
+ * \def QSC_MEMUTILS_POOL_CACHE_COUNT
+ * \brief The number of per-thread free list caches in a memory pool.
+ * Each thread is bound to one cache on first use; threads beyond this count share caches.
+ */
+#define QSC_MEMUTILS_POOL_CACHE_COUNT 16U
+
+/*!
+ * \def QSC_MEMUTILS_POOL_CLASS_MAXIMUM
+ * \brief The largest allocation served from the memory pool size-class slabs.
+ * Larger allocations are mapped individually.
+ */
+#define QSC_MEMUTILS_POOL_CLASS_MAXIMUM 4096U
+
+/*!
+ * \enum qsc_memutils_pool_flags
+ * \brief The memory pool options.
+ */
+typedef enum qsc_memutils_pool_flags
+{
+	qsc_memutils_pool_flag_none = 0x00U,		/*!< Pageable memory without guard pages */
+	qsc_memutils_pool_flag_locked = 0x01U,		/*!< Lock the pool memory so it is never swapped; allocation fails if the pages can not be locked */
+	qsc_memutils_pool_flag_guarded = 0x02U,		/*!< Place inaccessible guard pages on either side of every slab and large block */
+} qsc_memutils_pool_flags;
+
+/*!
+ * \struct qsc_memutils_pool
+ * \brief The opaque memory pool state.
+ */
+typedef struct qsc_memutils_pool qsc_memutils_pool;
+
+/*!
+ * \struct qsc_memutils_pool_stats
+ * \brief The memory pool usage statistics.
+ */
+QSC_EXPORT_API typedef struct qsc_memutils_pool_stats
+{
+	size_t allocations;			/*!< The number of allocations served */
+	size_t releases;			/*!< The number of blocks released */
+	size_t inuse;				/*!< The bytes currently allocated, rounded to the size class */
+	size_t reserved;			/*!< The bytes mapped by the pool for slabs and large blocks */
+	size_t slabs;				/*!< The number of slabs mapped */
+	size_t large;				/*!< The number of outstanding large blocks */
+	size_t failures;			/*!< The number of failed allocations */
+} qsc_memutils_pool_stats;
+
 /**
  * \brief Flush a cache line.
  *
@@ -327,6 +386,33 @@ QSC_EXPORT_API bool qsc_memutils_greater_than_le256(const uint8_t* a, const uint
  */
 QSC_EXPORT_API bool qsc_memutils_greater_than_le512(const uint8_t* a, const uint8_t* b);
 
+/**
+ * \brief Allocate a large block of page-mapped memory, backed by huge pages where available.
+ *
+ * \details
+ * Intended for multi-megabyte buffers, such as the SCB memory cost buffer and the McEliece key generation matrix,
+ * which suffer TLB misses when mapped with standard pages.
+ * Requests of at least half of QSC_MEMUTILS_LARGE_PAGE_SIZE are rounded up to whole huge pages and mapped
+ * with explicit huge pages (MAP_HUGETLB or MEM_LARGE_PAGES) when the system has them reserved.
+ * Otherwise the block is mapped on a huge page boundary and marked for transparent huge pages,
+ * falling back to standard pages when neither is available. Smaller requests use standard pages.
+ * The block is zeroed and at least page aligned.
+ *
+ * \param length:	[size_t] The number of bytes requested.
+ * \param node:		[int32_t] The preferred NUMA node, or QSC_MEMUTILS_NUMA_NODE_ANY.
+ *
+ * \return			[void*] Returns the memory block, or NULL on failure.
+ */
+QSC_EXPORT_API void* qsc_memutils_large_alloc(size_t length, int32_t node);
+
+/**
+ * \brief Wipe and release a block allocated with qsc_memutils_large_alloc.
+ *
+ * \param block:	[void*] The memory block.
+ * \param length:	[size_t] The length that was passed to qsc_memutils_large_alloc.
+ */
+QSC_EXPORT_API void qsc_memutils_large_free(void* block, size_t length);
+
 /**
  * \brief Move a block of memory, erasing the previous location.
  *
@@ -336,6 +422,69 @@ QSC_EXPORT_API bool qsc_memutils_greater_than_le512(const uint8_t* a, const uint
  */
 QSC_EXPORT_API void qsc_memutils_move(void* output, const void* input, size_t length);
 
+/**
+ * \brief Allocate a block from a memory pool.
+ *
+ * \details
+ * Requests up to QSC_MEMUTILS_POOL_CLASS_MAXIMUM bytes are rounded up to a power of two size class and served
+ * from the calling thread's cache of recycled blocks; a new slab is mapped only when that cache is empty.
+ * The returned memory is zeroed and 16-byte aligned.
+ *
+ * \param pool:		[qsc_memutils_pool*] The memory pool.
+ * \param length:	[size_t] The number of bytes requested.
+ *
+ * \return			[void*] Returns the memory block, or NULL on failure.
+ */
+QSC_EXPORT_API void* qsc_memutils_pool_alloc(qsc_memutils_pool* pool, size_t length);
+
+/**
+ * \brief Create a memory pool.
+ *
+ * \param flags:	[uint32_t] A combination of qsc_memutils_pool_flags options.
+ *
+ * \return			[qsc_memutils_pool*] Returns the memory pool, or NULL on failure.
+ */
+QSC_EXPORT_API qsc_memutils_pool* qsc_memutils_pool_create(uint32_t flags);
+
+/**
+ * \brief Destroy a memory pool, wiping and releasing all of its slabs.
+ *
+ * \warning Large blocks must be released with qsc_memutils_pool_free before the pool is destroyed.
+ *
+ * \param pool:		[qsc_memutils_pool*] The memory pool.
+ */
+QSC_EXPORT_API void qsc_memutils_pool_destroy(qsc_memutils_pool* pool);
+
+/**
+ * \brief Release a memory pool block.
+ *
+ * \details
+ * The block is wiped and returned to the calling thread's cache, or unmapped if it is a large block.
+ *
+ * \param pool:		[qsc_memutils_pool*] The memory pool that allocated the block.
+ * \param block:	[void*] The memory block.
+ */
+QSC_EXPORT_API void qsc_memutils_pool_free(qsc_memutils_pool* pool, void* block);
+
+/**
+ * \brief Pre-fault enough slabs to serve a number of allocations from the calling thread's cache.
+ *
+ * \param pool:		[qsc_memutils_pool*] The memory pool.
+ * \param length:	[size_t] The allocation size, no larger than QSC_MEMUTILS_POOL_CLASS_MAXIMUM.
+ * \param count:	[size_t] The number of blocks to reserve.
+ *
+ * \return			[bool] Returns true if the slabs were mapped.
+ */
+QSC_EXPORT_API bool qsc_memutils_pool_reserve(qsc_memutils_pool* pool, size_t length, size_t count);
+
+/**
+ * \brief Get the memory pool usage statistics.
+ *
+ * \param pool:		[qsc_memutils_pool*] The memory pool.
+ * \param stats:	[qsc_memutils_pool_stats*] Receives the statistics.
+ */
+QSC_EXPORT_API void qsc_memutils_pool_statistics(qsc_memutils_pool* pool, qsc_memutils_pool_stats* stats);
+
 /**
  * \brief Securely erase a block of memory.
  *
@@ -1,4 +1,5 @@
 #include "ntrubase.h"
+#include "ctsort.h"
 #include "intutils.h"
 #include "memutils.h"
 #include "sha3.h"
@@ -88,136 +89,6 @@ static void ntru_cmov(uint8_t* r, const uint8_t* x, size_t len, uint8_t b)
     }
 }
 
-/* ntru_crypto_sort_int32.c */
-
-static void ntru_int32_minmax(int32_t* a, int32_t* b)
-{
-    int32_t ab;
-    int32_t c;
-
-    ab = *b ^ *a;
-    c = (int32_t)((int64_t)*b - (int64_t)*a);
-    c ^= ab & (c ^ *b);
-    c >>= 31;
-    c &= ab;
-    *a ^= c;
-    *b ^= c;
-}
-
-static void ntru_crypto_sort_int32(int32_t* array, size_t n)
-{
-    /* assume 2 <= n <= 0x40000000 */
-
-    int32_t* x;
-    size_t i;
-    size_t j;
-    size_t r;
-    size_t top;
-    int32_t a;
-    bool res;
-
-    res = true;
-    top = 1;
-    x = array;
-
-    while (top < n - top)
-    {
-        top += top;
-    }
-
-    for (size_t p = top; p >= 1; p >>= 1)
-    {
-        i = 0;
-
-        while (i + (2 * p) <= n)
-        {
-            for (j = i; j < i + p; ++j)
-            {
-                ntru_int32_minmax(&x[j], &x[j + p]);
-            }
-
-            i += 2 * p;
-        }
-
-        for (j = i; j < n - p; ++j)
-        {
-            ntru_int32_minmax(&x[j], &x[j + p]);
-        }
-
-        i = 0;
-        j = 0;
-
-        for (size_t q = top; q > p; q >>= 1)
-        {
-            if (j != i)
-            {
-                while (true)
-                {
-                    if (j == n - q)
-                    {
-                        res = false;
-                        break;
-                    }
-
-                    a = x[j + p];
-
-                    for (r = q; r > p; r >>= 1)
-                    {
-                        ntru_int32_minmax(&a, &x[j + r]);
-                    }
-
-                    x[j + p] = a;
-                    ++j;
-
-                    if (j == i + p)
-                    {
-                        i += 2 * p;
-                        break;
-                    }
-                }
-            }
-
-            if (res == false)
-            {
-                break;
-            }
-
-            while (i + p <= n - q)
-            {
-                for (j = i; j < i + p; ++j)
-                {
-                    a = x[j + p];
-
-                    for (r = q; r > p; r >>= 1)
-                    {
-                        ntru_int32_minmax(&a, &x[j + r]);
-                    }
-
-                    x[j + p] = a;
-                }
-
-                i += 2 * p;
-            }
-
-            /* now i + p > n - q */
-            j = i;
-
-            while (j < n - q)
-            {
-                a = x[j + p];
-
-                for (r = q; r > p; r >>= 1)
-                {
-                    ntru_int32_minmax(&a, &x[j + r]);
-                }
-
-                x[j + p] = a;
-                ++j;
-            }
-        }
-    }
-}
-
 /* poly_mod.c */
 
 static uint16_t ntru_mod3(uint16_t a)
@@ -972,7 +843,7 @@ static void ntru_sample_fixed_type(poly *r, const uint8_t u[NTRU_SAMPLE_FT_BYTES
         s[i] |= 2;
     }
 
-    ntru_crypto_sort_int32(s, NTRU_N - 1);
+    qsc_ctsort_int32(s, NTRU_N - 1);
 
     for (i = 0; i < NTRU_N - 1; ++i)
     {
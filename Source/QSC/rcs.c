@@ -1,4 +1,5 @@
 #include "rcs.h"
+#include "async.h"
 #include "intutils.h"
 #include "memutils.h"
 
@@ -222,6 +223,7 @@ static void rcs_ctr_transform(qsc_rcs_state* ctx, uint8_t* output, const uint8_t
 		__m512i ctrw;
 		__m512i inpw;
 		__m512i otpw;
+		uint64_t wrmd;
 
 		/* initialize and pre-set the nonce */
 		ctrw = _mm512_set1_epi64(0);
@@ -229,9 +231,11 @@ static void rcs_ctr_transform(qsc_rcs_state* ctx, uint8_t* output, const uint8_t
 		qsc_memutils_copy(((uint8_t*)ctrblk + QSC_RCS_BLOCK_SIZE), ctx->nonce, QSC_RCS_BLOCK_SIZE);
 		ctrw = _mm512_load_si512(ctrblk);
 		ctrw = _mm512_add_epi64(ctrw, _mm512_set_epi64(0, 0, 0, 1, 0, 0, 0, 0));
+		/* the lanes do not carry out of the first 64 bits, blocks that would wrap them are left to the 256-bit increment below */
+		wrmd = UINT64_MAX - qsc_intutils_le8to64(ctx->nonce);
 
 		/* process 2 blocks in parallel */
-		while (length >= RCS_AVX512_BLOCK)
+		while (length >= RCS_AVX512_BLOCK && wrmd >= 2U)
 		{
 			/* encrypt the nonce */
 			rcs_transform_512(ctx, &otpw, &ctrw);
@@ -246,6 +250,7 @@ static void rcs_ctr_transform(qsc_rcs_state* ctx, uint8_t* output, const uint8_t
 
 			oft += RCS_AVX512_BLOCK;
 			length -= RCS_AVX512_BLOCK;
+			wrmd -= 2U;
 		}
 
 		/* store the last position of the nonce */
@@ -491,6 +496,115 @@ static void rcs_ctr_transform(qsc_rcs_state* ctx, uint8_t* output, const uint8_t
 
 #endif
 
+static size_t rcs_ctr_resume(qsc_rcs_state* ctx, uint8_t* output, const uint8_t* input, size_t length)
+{
+	const uint8_t zero[QSC_RCS_BLOCK_SIZE] = { 0 };
+	uint8_t tmpb[QSC_RCS_BLOCK_SIZE] = { 0 };
+	size_t i;
+	size_t pos;
+	size_t rlen;
+
+	rlen = 0;
+
+	if (ctx->position != 0 && length != 0)
+	{
+		/* finish the block that a seek positioned the stream within */
+		pos = ctx->position;
+		ctx->position = 0;
+		rcs_ctr_transform(ctx, tmpb, zero, QSC_RCS_BLOCK_SIZE);
+		rlen = qsc_intutils_min(length, QSC_RCS_BLOCK_SIZE - pos);
+
+		for (i = 0; i < rlen; ++i)
+		{
+			output[i] = tmpb[pos + i] ^ input[i];
+		}
+
+		qsc_memutils_clear(tmpb, sizeof(tmpb));
+	}
+
+	return rlen;
+}
+
+typedef struct
+{
+	const qsc_rcs_state* ctx;				/* the caller's cipher state */
+	uint8_t* output;						/* the output array */
+	const uint8_t* input;					/* the input array */
+	size_t length;							/* the total number of bytes */
+	size_t chunk;							/* the number of bytes per thread */
+	bool done[QSC_ASYNC_PARALLEL_MAX];		/* the completed ranges */
+} rcs_parallel_state;
+
+static void rcs_parallel_task(void* context, size_t index)
+{
+	rcs_parallel_state* pstate;
+	qsc_rcs_state lctx;
+	size_t oft;
+
+	pstate = (rcs_parallel_state*)context;
+	oft = index * pstate->chunk;
+
+	if (oft < pstate->length)
+	{
+		qsc_memutils_copy(&lctx, pstate->ctx, sizeof(qsc_rcs_state));
+		qsc_intutils_le8add(lctx.nonce, QSC_RCS_BLOCK_SIZE, (uint64_t)(oft / QSC_RCS_BLOCK_SIZE));
+		rcs_ctr_transform(&lctx, pstate->output + oft, pstate->input + oft, qsc_intutils_min(pstate->chunk, pstate->length - oft));
+		qsc_memutils_secure_erase(&lctx, sizeof(qsc_rcs_state));
+	}
+
+	pstate->done[index] = true;
+}
+
+static void rcs_ctr_transform_parallel(qsc_rcs_state* ctx, uint8_t* output, const uint8_t* input, size_t length, size_t threads)
+{
+	rcs_parallel_state pstate;
+	size_t nblk;
+	size_t oft;
+	size_t i;
+
+	/* finish the partial block left by a seek before dividing the input */
+	oft = rcs_ctr_resume(ctx, output, input, length);
+	output += oft;
+	input += oft;
+	length -= oft;
+
+	if (threads == 0)
+	{
+		threads = qsc_async_processor_count();
+	}
+
+	threads = qsc_intutils_min(threads, length / QSC_ASYNC_PARALLEL_MINIMUM);
+	threads = qsc_intutils_min(threads, QSC_ASYNC_PARALLEL_MAX);
+
+	if (threads <= 1)
+	{
+		rcs_ctr_transform(ctx, output, input, length);
+	}
+	else
+	{
+		qsc_memutils_clear(&pstate, sizeof(pstate));
+		nblk = (length + QSC_RCS_BLOCK_SIZE - 1) / QSC_RCS_BLOCK_SIZE;
+		pstate.ctx = ctx;
+		pstate.output = output;
+		pstate.input = input;
+		pstate.length = length;
+		pstate.chunk = ((nblk + threads - 1) / threads) * QSC_RCS_BLOCK_SIZE;
+
+		qsc_async_parallel_for(&rcs_parallel_task, &pstate, threads);
+
+		/* transform any range whose thread could not be launched */
+		for (i = 0; i < threads; ++i)
+		{
+			if (pstate.done[i] == false)
+			{
+				rcs_parallel_task(&pstate, i);
+			}
+		}
+
+		qsc_intutils_le8add(ctx->nonce, QSC_RCS_BLOCK_SIZE, (uint64_t)nblk);
+	}
+}
+
 #if defined(QSC_RCS_AUTHENTICATED)
 static void rcs_mac_finalize(qsc_rcs_state* ctx, uint8_t* output)
 {
@@ -716,6 +830,7 @@ void qsc_rcs_dispose(qsc_rcs_state* ctx)
 		ctx->ctype = RCS256;
 		ctx->roundkeylen = 0;
 		ctx->rounds = 0;
+		ctx->position = 0;
 		ctx->encrypt = false;
 	}
 }
@@ -732,6 +847,7 @@ void qsc_rcs_initialize(qsc_rcs_state* ctx, const qsc_rcs_keyparams* keyparams,
 	qsc_memutils_copy(ctx->nonce, keyparams->nonce, QSC_RCS_NONCE_SIZE);
 	ctx->counter = 1;
 	ctx->encrypt = encryption;
+	ctx->position = 0;
 
 	if (ctx->ctype == RCS256)
 	{
@@ -779,12 +895,8 @@ void qsc_rcs_store_nonce(const qsc_rcs_state* ctx, uint8_t nonce[QSC_RCS_NONCE_S
 	qsc_memutils_copy(nonce, ctx->nonce, QSC_RCS_NONCE_SIZE);
 }
 
-bool qsc_rcs_transform(qsc_rcs_state* ctx, uint8_t* output, const uint8_t* input, size_t length)
+static bool rcs_authenticated_transform(qsc_rcs_state* ctx, uint8_t* output, const uint8_t* input, size_t length, size_t threads)
 {
-	assert(ctx != NULL);
-	assert(output != NULL);
-	assert(input != NULL);
-
 	bool res;
 
 #if defined(QSC_RCS_AUTHENTICATED)
@@ -800,7 +912,7 @@ bool qsc_rcs_transform(qsc_rcs_state* ctx, uint8_t* output, const uint8_t* input
 	if (ctx->encrypt)
 	{
 		/* transform the plain-text with the counter-mode cipher */
-		rcs_ctr_transform(ctx, output, input, length);
+		rcs_ctr_transform_parallel(ctx, output, input, length, threads);
 
 		/* update the mac with the cipher-text */
 		rcs_mac_update(ctx, output, length);
@@ -825,7 +937,7 @@ bool qsc_rcs_transform(qsc_rcs_state* ctx, uint8_t* output, const uint8_t* input
 			if (qsc_intutils_verify(code, input + length, QSC_RCS256_MAC_SIZE) == 0)
 			{
 				/* transform the plain-text with the counter-mode cipher */
-				rcs_ctr_transform(ctx, output, input, length);
+				rcs_ctr_transform_parallel(ctx, output, input, length, threads);
 				res = true;
 			}
 		}
@@ -837,7 +949,7 @@ bool qsc_rcs_transform(qsc_rcs_state* ctx, uint8_t* output, const uint8_t* input
 
 			if (qsc_intutils_verify(code, input + length, QSC_RCS512_MAC_SIZE) == 0)
 			{
-				rcs_ctr_transform(ctx, output, input, length);
+				rcs_ctr_transform_parallel(ctx, output, input, length, threads);
 				res = true;
 			}
 		}
@@ -845,7 +957,7 @@ bool qsc_rcs_transform(qsc_rcs_state* ctx, uint8_t* output, const uint8_t* input
 
 #else
 
-	rcs_ctr_transform(ctx, output, input, length);
+	rcs_ctr_transform_parallel(ctx, output, input, length, threads);
 	res = true;
 
 #endif
@@ -853,6 +965,55 @@ bool qsc_rcs_transform(qsc_rcs_state* ctx, uint8_t* output, const uint8_t* input
 	return res;
 }
 
+void qsc_rcs_seek(qsc_rcs_state* ctx, const uint8_t nonce[QSC_RCS_NONCE_SIZE], uint64_t offset)
+{
+	assert(ctx != NULL);
+	assert(nonce != NULL);
+
+	if (ctx != NULL && nonce != NULL)
+	{
+		qsc_memutils_copy(ctx->nonce, nonce, QSC_RCS_NONCE_SIZE);
+		qsc_intutils_le8add(ctx->nonce, QSC_RCS_BLOCK_SIZE, offset / QSC_RCS_BLOCK_SIZE);
+		ctx->position = (size_t)(offset % QSC_RCS_BLOCK_SIZE);
+	}
+}
+
+bool qsc_rcs_transform(qsc_rcs_state* ctx, uint8_t* output, const uint8_t* input, size_t length)
+{
+	assert(ctx != NULL);
+	assert(output != NULL);
+	assert(input != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (ctx != NULL && output != NULL && input != NULL)
+	{
+		res = rcs_authenticated_transform(ctx, output, input, length, 1);
+	}
+
+	return res;
+}
+
+bool qsc_rcs_transform_parallel(qsc_rcs_state* ctx, uint8_t* output, const uint8_t* input, size_t length, size_t threads)
+{
+	assert(ctx != NULL);
+	assert(output != NULL);
+	assert(input != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (ctx != NULL && output != NULL && input != NULL)
+	{
+		res = rcs_authenticated_transform(ctx, output, input, length, threads);
+	}
+
+	return res;
+}
+
 bool qsc_rcs_extended_transform(qsc_rcs_state* ctx, uint8_t* output, const uint8_t* input, size_t length, bool finalize)
 {
 	assert(ctx != NULL);
@@ -874,7 +1035,7 @@ bool qsc_rcs_extended_transform(qsc_rcs_state* ctx, uint8_t* output, const uint8
 	if (ctx->encrypt == true)
 	{
 		/* transform the plain-text with the counter-mode cipher */
-		rcs_ctr_transform(ctx, output, input, length);
+		rcs_ctr_transform_parallel(ctx, output, input, length, 1);
 
 		/* update the mac with the cipher-text */
 		rcs_mac_update(ctx, output, length);
@@ -905,7 +1066,7 @@ bool qsc_rcs_extended_transform(qsc_rcs_state* ctx, uint8_t* output, const uint8
 				if (qsc_intutils_verify(code, input + length, QSC_RCS256_MAC_SIZE) == 0)
 				{
 					/* transform the plain-text with the counter-mode cipher */
-					rcs_ctr_transform(ctx, output, input, length);
+					rcs_ctr_transform_parallel(ctx, output, input, length, 1);
 					res = true;
 				}
 			}
@@ -917,7 +1078,7 @@ bool qsc_rcs_extended_transform(qsc_rcs_state* ctx, uint8_t* output, const uint8
 
 				if (qsc_intutils_verify(code, input + length, QSC_RCS512_MAC_SIZE) == 0)
 				{
-					rcs_ctr_transform(ctx, output, input, length);
+					rcs_ctr_transform_parallel(ctx, output, input, length, 1);
 					res = true;
 				}
 			}
@@ -925,14 +1086,14 @@ bool qsc_rcs_extended_transform(qsc_rcs_state* ctx, uint8_t* output, const uint8
 		else
 		{
 			/* transform the plain-text with the counter-mode cipher */
-			rcs_ctr_transform(ctx, output, input, length);
+			rcs_ctr_transform_parallel(ctx, output, input, length, 1);
 			res = true;
 		}
 	}
 
 #else
 
-	rcs_ctr_transform(ctx, output, input, length);
+	rcs_ctr_transform_parallel(ctx, output, input, length, 1);
 	res = true;
 
 #endif
@@ -245,6 +245,7 @@ QSC_EXPORT_API typedef struct
 #endif
 	uint8_t nonce[QSC_RCS_NONCE_SIZE];	/*!< The nonce or initialization vector. */
 	uint64_t counter;					/*!< The processed bytes counter. */
+	size_t position;					/*!< The byte offset within the current block, set by qsc_rcs_seek. */
 	bool encrypt;						/*!< The transformation mode; true for encryption. */
 } qsc_rcs_state;
 
@@ -290,6 +291,21 @@ QSC_EXPORT_API void qsc_rcs_set_associated(qsc_rcs_state* ctx, const uint8_t* da
 */
 QSC_EXPORT_API void qsc_rcs_store_nonce(const qsc_rcs_state* ctx, uint8_t nonce[QSC_RCS_NONCE_SIZE]);
 
+/**
+ * \brief Position the key-stream at a byte offset from the start of a message.
+ *
+ * The nonce is set to the initial nonce plus the number of whole blocks in the offset, and the position
+ * within that block to the remainder. The next transform begins at that byte of the key-stream.
+ *
+ * \warning In authenticated mode the MAC is computed from the seek position over the bytes that follow,
+ * so a seek is only meaningful when each range is encrypted and authenticated as its own message.
+ *
+ * \param ctx:			[qsc_rcs_state*] A pointer to the cipher state structure.
+ * \param nonce:		[const uint8_t*] The initial nonce the message was transformed with.
+ * \param offset:		[uint64_t] The byte offset into the key-stream.
+ */
+QSC_EXPORT_API void qsc_rcs_seek(qsc_rcs_state* ctx, const uint8_t nonce[QSC_RCS_NONCE_SIZE], uint64_t offset);
+
 /**
  * \brief Transform an array of bytes.
  *
@@ -306,6 +322,23 @@ QSC_EXPORT_API void qsc_rcs_store_nonce(const qsc_rcs_state* ctx, uint8_t nonce[
  */
 QSC_EXPORT_API bool qsc_rcs_transform(qsc_rcs_state* ctx, uint8_t* output, const uint8_t* input, size_t length);
 
+/**
+ * \brief Transform an array of bytes, generating the key-stream on multiple threads.
+ *
+ * The input is divided into contiguous ranges of blocks, and each thread transforms one range using a copy of the state
+ * with the nonce advanced to the start of that range. The MAC is computed sequentially.
+ * The output, MAC code, and final nonce are identical to those produced by qsc_rcs_transform.
+ *
+ * \param ctx:			[qsc_rcs_state*] A pointer to the cipher state structure.
+ * \param output:		[uint8_t*] A pointer to the output array.
+ * \param input:		[const uint8_t*] A pointer to the input array.
+ * \param length:		[size_t] The number of bytes to transform.
+ * \param threads:		[size_t] The maximum number of threads; zero uses one thread per processor core.
+ *
+ * \return				[bool] Returns true if the data was transformed successfully, false on failure.
+ */
+QSC_EXPORT_API bool qsc_rcs_transform_parallel(qsc_rcs_state* ctx, uint8_t* output, const uint8_t* input, size_t length, size_t threads);
+
 /**
  * \brief A multi-call transform for a large array of bytes.
  *
@@ -1,5 +1,6 @@
 #include "scb.h"
 #include "acp.h"
+#include "async.h"
 #include "intutils.h"
 #include "memutils.h"
 #include "consoleutils.h"
@@ -7,6 +8,51 @@
 #define QSC_SCB_NAME_SIZE 8ULL
 
 static char scb_name[QSC_SCB_NAME_SIZE] = "SCB v1.d";
+static char scb_parallel_name[QSC_SCB_NAME_SIZE] = "SCB v2.p";
+
+/* the parallel mode memory block is 8 rate-sized duplex blocks */
+#define SCB_BLOCK_RATES 8ULL
+/* each pass is divided into segments, lanes synchronize at segment boundaries */
+#define SCB_SEGMENT_COUNT 4ULL
+/* the minimum lane length in memory blocks, two blocks per segment */
+#define SCB_LANE_MINIMUM (SCB_SEGMENT_COUNT * 2ULL)
+/* the number of indices produced by each address stream permutation */
+#define SCB_ADDRESS_WORDS 16ULL
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+#	define SCB_GROUP_SIZE 8ULL
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+#	define SCB_GROUP_SIZE 4ULL
+#else
+#	define SCB_GROUP_SIZE 1ULL
+#endif
+
+/* a group of lane states, interleaved so that one vector holds the same word of every lane */
+typedef union
+{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	__m512i v[QSC_KECCAK_STATE_SIZE];
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+	__m256i v[QSC_KECCAK_STATE_SIZE];
+#endif
+	uint64_t w[QSC_KECCAK_STATE_SIZE][SCB_GROUP_SIZE];
+} scb_group_state;
+
+typedef struct
+{
+	scb_group_state* groups;
+	uint8_t* buffer;
+	size_t blklen;
+	size_t lblocks;
+	size_t lanes;
+	size_t ngroups;
+	size_t nthreads;
+	size_t pass;
+	size_t passes;
+	size_t rate;
+	size_t segment;
+	bool done[QSC_ASYNC_PARALLEL_MAX];
+} scb_parallel_state;
 
 static void scb_scatter_index_dynamic(size_t* indice, size_t count)
 {
@@ -44,7 +90,7 @@ static void scb_fill_memory(qsc_scb_state* ctx, uint8_t* buffer, size_t buflen,
 	/* get the number of cache lines */
 	lcnt = buflen / QSC_MEMUTILS_CACHE_LINE_SIZE;
 
-    indice = qsc_memutils_malloc(lcnt * sizeof(size_t));
+    indice = qsc_memutils_large_alloc(lcnt * sizeof(size_t), QSC_MEMUTILS_NUMA_NODE_ANY);
 
 	if (indice != NULL)
 	{
@@ -53,8 +99,6 @@ static void scb_fill_memory(qsc_scb_state* ctx, uint8_t* buffer, size_t buflen,
 		uint64_t lidx;
 		uint64_t litr;
 
-		qsc_memutils_clear(indice, lcnt * sizeof(size_t));
-
 		/* create the index based on a scattering pattern */
 		scb_scatter_index_dynamic(indice, lcnt);
 
@@ -86,8 +130,338 @@ static void scb_fill_memory(qsc_scb_state* ctx, uint8_t* buffer, size_t buflen,
 		}
 
 		qsc_keccak_dispose(&kstate);
-		qsc_memutils_alloc_free(indice);
+		qsc_memutils_large_free(indice, lcnt * sizeof(size_t));
+	}
+}
+
+static size_t scb_lane_blocks(size_t memcost, size_t lanes, qsc_keccak_rate rate)
+{
+	size_t lblk;
+
+	/* the lane length is rounded down to a multiple of the segment count */
+	lblk = ((memcost * QSC_SCB_MEMORY_COST_SIZE) / lanes) / ((size_t)rate * SCB_BLOCK_RATES);
+	lblk -= lblk % SCB_SEGMENT_COUNT;
+
+	return lblk;
+}
+
+static void scb_group_permute(scb_group_state* gs)
+{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	qsc_keccak_permute_p8x1600(gs->v, QSC_KECCAK_PERMUTATION_ROUNDS);
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+	qsc_keccak_permute_p4x1600(gs->v, QSC_KECCAK_PERMUTATION_ROUNDS);
+#else
+	qsc_keccak_permute_p1600c(&gs->w[0][0], QSC_KECCAK_PERMUTATION_ROUNDS);
+#endif
+}
+
+static void scb_address_generate(uint64_t* address, const scb_parallel_state* ps, size_t lane, size_t counter)
+{
+	/* the first half of the first pass takes its reference indices from a stream
+	   that depends only on the public parameters, so the access pattern leaks nothing about the seed */
+	uint64_t st[QSC_KECCAK_STATE_SIZE] = { 0 };
+
+	st[0] = (uint64_t)ps->pass;
+	st[1] = (uint64_t)lane;
+	st[2] = (uint64_t)ps->segment;
+	st[3] = (uint64_t)ps->lanes;
+	st[4] = (uint64_t)ps->lblocks;
+	st[5] = (uint64_t)ps->passes;
+	st[6] = (uint64_t)counter;
+	st[7] = (uint64_t)QSC_KECCAK_SCBKDF_DOMAIN_ID;
+
+	qsc_keccak_permute_p1600c(st, QSC_KECCAK_PERMUTATION_ROUNDS);
+	qsc_memutils_copy(address, st, SCB_ADDRESS_WORDS * sizeof(uint64_t));
+}
+
+static uint8_t* scb_reference_block(const scb_parallel_state* ps, size_t lane, size_t index, uint64_t rnd)
+{
+	/* selects a reference block from the region that is complete and not being written by another thread:
+	   the earlier blocks of the lane itself, or the finished segments of another lane */
+	const size_t SEGLEN = ps->lblocks / SCB_SEGMENT_COUNT;
+	size_t count;
+	size_t rlane;
+	size_t start;
+	size_t pos;
+
+	rlane = (ps->pass == 0 && ps->segment == 0) ? lane : (size_t)((rnd >> 32) % ps->lanes);
+
+	if (ps->pass == 0)
+	{
+		start = 0;
+		count = (rlane == lane) ? (ps->segment * SEGLEN) + index - 1 : (ps->segment * SEGLEN) - ((index == 0) ? 1 : 0);
+	}
+	else
+	{
+		start = ((ps->segment + 1) * SEGLEN) % ps->lblocks;
+		count = (rlane == lane) ? ps->lblocks - SEGLEN + index - 1 : ps->lblocks - SEGLEN - ((index == 0) ? 1 : 0);
+	}
+
+	pos = (start + (size_t)((rnd & 0xFFFFFFFFULL) % count)) % ps->lblocks;
+
+	return ps->buffer + (((rlane * ps->lblocks) + pos) * ps->blklen);
+}
+
+static void scb_duplex_block(scb_group_state* gs, uint8_t* const* refs, uint8_t* const* blocks, size_t lcnt, size_t rate, bool overwrite)
+{
+	/* each rate-sized part of the new block is the duplex output after absorbing the
+	   reference block part, and on later passes the part it replaces */
+	const size_t RWORDS = rate / sizeof(uint64_t);
+	size_t oft;
+	uint64_t x;
+
+	for (size_t c = 0; c < SCB_BLOCK_RATES; ++c)
+	{
+		oft = c * rate;
+
+		for (size_t k = 0; k < lcnt; ++k)
+		{
+			for (size_t i = 0; i < RWORDS; ++i)
+			{
+				x = qsc_intutils_le8to64(refs[k] + oft + (i * sizeof(uint64_t)));
+
+				if (overwrite == true)
+				{
+					x ^= qsc_intutils_le8to64(blocks[k] + oft + (i * sizeof(uint64_t)));
+				}
+
+				gs->w[i][k] ^= x;
+			}
+		}
+
+		scb_group_permute(gs);
+
+		for (size_t k = 0; k < lcnt; ++k)
+		{
+			for (size_t i = 0; i < RWORDS; ++i)
+			{
+				qsc_intutils_le64to8(blocks[k] + oft + (i * sizeof(uint64_t)), gs->w[i][k]);
+			}
+		}
+	}
+}
+
+static void scb_fill_segment(scb_parallel_state* ps, size_t group)
+{
+	const size_t SEGLEN = ps->lblocks / SCB_SEGMENT_COUNT;
+	const size_t RWORDS = ps->rate / sizeof(uint64_t);
+	scb_group_state* gs;
+	uint64_t address[SCB_GROUP_SIZE][SCB_ADDRESS_WORDS] = { 0 };
+	uint8_t* blocks[SCB_GROUP_SIZE] = { 0 };
+	uint8_t* lbase[SCB_GROUP_SIZE] = { 0 };
+	uint8_t* refs[SCB_GROUP_SIZE] = { 0 };
+	uint64_t rnd;
+	size_t first;
+	size_t lane;
+	size_t lcnt;
+	size_t prev;
+	size_t pos;
+	bool indep;
+
+	gs = &ps->groups[group];
+	lcnt = qsc_intutils_min(SCB_GROUP_SIZE, ps->lanes - (group * SCB_GROUP_SIZE));
+	indep = (ps->pass == 0 && ps->segment < (SCB_SEGMENT_COUNT / 2));
+	first = 0;
+
+	for (size_t k = 0; k < lcnt; ++k)
+	{
+		lbase[k] = ps->buffer + (((group * SCB_GROUP_SIZE) + k) * ps->lblocks * ps->blklen);
+	}
+
+	if (ps->pass == 0 && ps->segment == 0)
+	{
+		/* the first two blocks of each lane are squeezed from the lane seed */
+		for (size_t c = 0; c < 2 * SCB_BLOCK_RATES; ++c)
+		{
+			scb_group_permute(gs);
+
+			for (size_t k = 0; k < lcnt; ++k)
+			{
+				for (size_t i = 0; i < RWORDS; ++i)
+				{
+					qsc_intutils_le64to8(lbase[k] + (c * ps->rate) + (i * sizeof(uint64_t)), gs->w[i][k]);
+				}
+			}
+		}
+
+		first = 2;
+	}
+
+	for (size_t i = first; i < SEGLEN; ++i)
+	{
+		pos = (ps->segment * SEGLEN) + i;
+
+		for (size_t k = 0; k < lcnt; ++k)
+		{
+			lane = (group * SCB_GROUP_SIZE) + k;
+
+			if (indep == true)
+			{
+				if (i == first || i % SCB_ADDRESS_WORDS == 0)
+				{
+					scb_address_generate(address[k], ps, lane, i / SCB_ADDRESS_WORDS);
+				}
+
+				rnd = address[k][i % SCB_ADDRESS_WORDS];
+			}
+			else
+			{
+				/* the first word of the last duplex output of the previous block */
+				prev = (pos == 0) ? ps->lblocks - 1 : pos - 1;
+				rnd = qsc_intutils_le8to64(lbase[k] + (prev * ps->blklen) + ps->blklen - ps->rate);
+			}
+
+			refs[k] = scb_reference_block(ps, lane, i, rnd);
+			blocks[k] = lbase[k] + (pos * ps->blklen);
+		}
+
+		scb_duplex_block(gs, refs, blocks, lcnt, ps->rate, (ps->pass != 0));
+	}
+}
+
+static void scb_parallel_task(void* state, size_t index)
+{
+	scb_parallel_state* ps = (scb_parallel_state*)state;
+
+	for (size_t g = index; g < ps->ngroups; g += ps->nthreads)
+	{
+		scb_fill_segment(ps, g);
 	}
+
+	ps->done[index] = true;
+}
+
+static bool scb_parallel_cost(qsc_scb_state* ctx)
+{
+	/* fills lanes of the memory in parallel, mixing them at each segment boundary, then
+	   folds the last block of every lane into the key */
+	qsc_keccak_state kstate = { 0 };
+	scb_parallel_state ps = { 0 };
+	uint8_t cust[4 * sizeof(uint64_t)] = { 0 };
+	size_t blen;
+	size_t glen;
+	size_t lane;
+	bool res;
+
+	res = false;
+	ps.lanes = ctx->lanes;
+	ps.passes = ctx->cpuc;
+	ps.rate = (size_t)ctx->rate;
+	ps.blklen = ps.rate * SCB_BLOCK_RATES;
+	ps.lblocks = scb_lane_blocks(ctx->memc, ctx->lanes, ctx->rate);
+	ps.ngroups = (ps.lanes + SCB_GROUP_SIZE - 1) / SCB_GROUP_SIZE;
+	ps.nthreads = (ctx->threads == 0) ? qsc_async_processor_count() : ctx->threads;
+	ps.nthreads = qsc_intutils_min(ps.nthreads, ps.ngroups);
+	ps.nthreads = qsc_intutils_max(qsc_intutils_min(ps.nthreads, QSC_ASYNC_PARALLEL_MAX), 1);
+
+	blen = ps.lanes * ps.lblocks * ps.blklen;
+	glen = ps.ngroups * sizeof(scb_group_state);
+	ps.buffer = (uint8_t*)qsc_memutils_large_alloc(blen, QSC_MEMUTILS_NUMA_NODE_ANY);
+	ps.groups = (scb_group_state*)qsc_memutils_aligned_alloc(QSC_SIMD_ALIGNMENT, glen);
+
+	if (ps.buffer != NULL && ps.groups != NULL && ps.lblocks >= SCB_LANE_MINIMUM)
+	{
+		qsc_memutils_clear(ps.groups, glen);
+
+		/* each lane is keyed with its index and the cost parameters */
+		for (lane = 0; lane < ps.lanes; ++lane)
+		{
+			qsc_intutils_le64to8(cust, (uint64_t)lane);
+			qsc_intutils_le64to8(cust + sizeof(uint64_t), (uint64_t)ps.lanes);
+			qsc_intutils_le64to8(cust + (2 * sizeof(uint64_t)), (uint64_t)ctx->memc);
+			qsc_intutils_le64to8(cust + (3 * sizeof(uint64_t)), (uint64_t)ctx->cpuc);
+			qsc_cshake_initialize(&kstate, ctx->rate, ctx->ckey, ctx->klen, (uint8_t*)scb_parallel_name, QSC_SCB_NAME_SIZE, cust, sizeof(cust));
+
+			for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+			{
+				ps.groups[lane / SCB_GROUP_SIZE].w[i][lane % SCB_GROUP_SIZE] = kstate.state[i];
+			}
+		}
+
+		for (ps.pass = 0; ps.pass < ps.passes; ++ps.pass)
+		{
+			for (ps.segment = 0; ps.segment < SCB_SEGMENT_COUNT; ++ps.segment)
+			{
+				qsc_memutils_clear(ps.done, sizeof(ps.done));
+
+				if (ps.nthreads > 1)
+				{
+					qsc_async_parallel_for(&scb_parallel_task, &ps, ps.nthreads);
+				}
+
+				/* run any task whose thread could not be launched */
+				for (size_t i = 0; i < ps.nthreads; ++i)
+				{
+					if (ps.done[i] == false)
+					{
+						scb_parallel_task(&ps, i);
+					}
+				}
+			}
+		}
+
+		/* the new key is the hash of the old key and the final block of every lane */
+		qsc_sha3_initialize(&kstate);
+		qsc_sha3_update(&kstate, ctx->rate, ctx->ckey, ctx->klen);
+
+		for (lane = 0; lane < ps.lanes; ++lane)
+		{
+			qsc_sha3_update(&kstate, ctx->rate, ps.buffer + (((lane + 1) * ps.lblocks) - 1) * ps.blklen, ps.blklen);
+		}
+
+		qsc_sha3_finalize(&kstate, ctx->rate, ctx->ckey);
+		res = true;
+	}
+
+	qsc_keccak_dispose(&kstate);
+
+	if (ps.groups != NULL)
+	{
+		qsc_memutils_secure_erase(ps.groups, glen);
+		qsc_memutils_aligned_free(ps.groups);
+	}
+
+	if (ps.buffer != NULL)
+	{
+		qsc_memutils_large_free(ps.buffer, blen);
+	}
+
+	return res;
+}
+
+static bool scb_sequential_cost(qsc_scb_state* ctx)
+{
+	qsc_keccak_state hstate = { 0 };
+	uint8_t* cbuf;
+	size_t clen;
+	bool res;
+
+	res = false;
+	clen = ctx->memc * QSC_SCB_MEMORY_COST_SIZE;
+	/* the cost buffer is scattered over at cache-line granularity, huge pages avoid a TLB miss on most accesses */
+	cbuf = qsc_memutils_large_alloc(clen, QSC_MEMUTILS_NUMA_NODE_ANY);
+
+	if (cbuf != NULL)
+	{
+		qsc_sha3_initialize(&hstate);
+
+		for (size_t i = 0; i < ctx->cpuc; ++i)
+		{
+			/* update the SHA3 hash with the key */
+			qsc_sha3_update(&hstate, ctx->rate, ctx->ckey, ctx->klen);
+			/* scatter fill the memory with output from SHAKE */
+			scb_fill_memory(ctx, cbuf, clen, &hstate);
+			/* finalize to the new key */
+			qsc_sha3_finalize(&hstate, ctx->rate, ctx->ckey);
+		}
+
+		qsc_memutils_large_free(cbuf, clen);
+		qsc_keccak_dispose(&hstate);
+		res = true;
+	}
+
+	return res;
 }
 
 void qsc_scb_dispose(qsc_scb_state* ctx)
@@ -99,7 +473,9 @@ void qsc_scb_dispose(qsc_scb_state* ctx)
 		qsc_memutils_clear(ctx->ckey, ctx->klen);
 		ctx->cpuc = 0;
 		ctx->klen = 0;
+		ctx->lanes = 0;
 		ctx->memc = 0;
+		ctx->threads = 0;
 		ctx->rate = qsc_keccak_rate_none;
 	}
 }
@@ -136,6 +512,8 @@ void qsc_scb_initialize(qsc_scb_state* ctx, const uint8_t* seed, size_t seedlen,
 		qsc_memutils_clear(ctx->ckey, ctx->klen);
 		ctx->cpuc = cpucost;
 		ctx->memc = memcost;
+		ctx->lanes = 0;
+		ctx->threads = 0;
 
 		/* intialize shake */
 		qsc_cshake_initialize(&kstate, ctx->rate, seed, seedlen, (uint8_t*)scb_name, QSC_SCB_NAME_SIZE, info, infolen);
@@ -146,6 +524,27 @@ void qsc_scb_initialize(qsc_scb_state* ctx, const uint8_t* seed, size_t seedlen,
 	}
 }
 
+void qsc_scb_initialize_parallel(qsc_scb_state* ctx, const uint8_t* seed, size_t seedlen, const uint8_t* info, size_t infolen, size_t cpucost, size_t memcost, size_t lanes, size_t threads)
+{
+	assert(ctx != NULL);
+	assert(seed != NULL);
+	assert(lanes <= QSC_SCB_LANES_MAXIMUM);
+	assert(lanes >= QSC_SCB_LANES_MINIMUM);
+
+	if (ctx != NULL && seed != NULL && lanes <= QSC_SCB_LANES_MAXIMUM && lanes >= QSC_SCB_LANES_MINIMUM &&
+		memcost <= QSC_SCB_MEMORY_MAXIMUM && memcost >= QSC_SCB_MEMORY_MINIMUM &&
+		scb_lane_blocks(memcost, lanes, (seedlen >= QSC_SCB_512_SEED_SIZE) ? qsc_keccak_rate_512 : qsc_keccak_rate_256) >= SCB_LANE_MINIMUM)
+	{
+		qsc_scb_initialize(ctx, seed, seedlen, info, infolen, cpucost, memcost);
+
+		if (ctx->rate != qsc_keccak_rate_none)
+		{
+			ctx->lanes = lanes;
+			ctx->threads = threads;
+		}
+	}
+}
+
 void qsc_scb_generate(qsc_scb_state* ctx, uint8_t* output, size_t otplen)
 {
 	assert(ctx != NULL);
@@ -155,31 +554,21 @@ void qsc_scb_generate(qsc_scb_state* ctx, uint8_t* output, size_t otplen)
 	if (ctx != NULL && output != NULL && otplen != 0)
 	{
 		qsc_keccak_state hstate = { 0 };
-		uint8_t* cbuf;
-		size_t clen;
+		bool res;
 
-		clen = ctx->memc * QSC_SCB_MEMORY_COST_SIZE;
-		cbuf = qsc_memutils_malloc(clen);
+		if (ctx->lanes != 0)
+		{
+			res = scb_parallel_cost(ctx);
+		}
+		else
+		{
+			res = scb_sequential_cost(ctx);
+		}
 
-		if (cbuf != NULL)
+		if (res == true)
 		{
 			size_t pos;
 
-			qsc_memutils_clear(cbuf, clen);
-			qsc_sha3_initialize(&hstate);
-
-			for (size_t i = 0; i < ctx->cpuc; ++i)
-			{
-				/* update the SHA3 hash with the key */
-				qsc_sha3_update(&hstate, ctx->rate, ctx->ckey, ctx->klen);
-				/* scatter fill the memory with output from SHAKE */
-				scb_fill_memory(ctx, cbuf, clen, &hstate);
-				/* finalize to the new key */
-				qsc_sha3_finalize(&hstate, ctx->rate, ctx->ckey);
-			}
-
-			qsc_memutils_clear(cbuf, clen);
-			qsc_memutils_alloc_free(cbuf);
 			pos = 0;
 
 			/* initialize SHAKE with the derived key */
@@ -55,6 +55,15 @@ QSC_CPLUSPLUS_ENABLED_START
  * cSHAKE-256 (for 32-byte keys) or cSHAKE-512 (for 64-byte keys). Additionally, SCB incorporates a cost mechanism 
  * with configurable CPU and memory costs to resist brute-force attacks.
  *
+ * The parallel mode (SCB v2), selected with qsc_scb_initialize_parallel, divides the memory into independent lanes.
+ * Each lane is a Keccak duplex chain over 8-rate-block memory blocks, and every new block absorbs a reference block
+ * chosen from the lane itself or from the completed segments of other lanes, in the manner of Argon2.
+ * The first half of the first pass selects references from a counter-based address stream that does not depend on the seed,
+ * the remainder uses the previous block contents. Lanes are processed 4 or 8 at a time with the AVX2/AVX-512 Keccak
+ * permutations, and spread across threads between the four synchronization points of each pass.
+ * The output depends on the lane count but not on the thread count or instruction set, so the thread count
+ * can be tuned to the host while the lane count sets the parallel hardness.
+ *
  * \par Example Usage:
  * \code
  * // External key and optional info arrays
@@ -71,6 +80,12 @@ QSC_CPLUSPLUS_ENABLED_START
  * qsc_scb_generate(ctx, rnd, sizeof(rnd));
  * \endcode
  *
+ * \code
+ * // Parallel mode: 2 passes over 64 MiB, in 8 lanes, using all available processor cores
+ * qsc_scb_initialize_parallel(ctx, seed, sizeof(seed), info, sizeof(info), 2, 64, 8, 0);
+ * qsc_scb_generate(ctx, rnd, sizeof(rnd));
+ * \endcode
+ *
  * \section scb_links Reference Links:
  * - <a href="https://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.202.pdf">SHA3 Specification (FIPS 202)</a>
  * - <a href="https://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-90Ar1.pdf">NIST Pseudorandom Generator Guidelines (SP 800-90A)</a>
@@ -124,6 +139,18 @@ QSC_CPLUSPLUS_ENABLED_START
  */
 #define QSC_SCB_CPU_MAXIMUM 1000ULL
 
+/*!
+ * \def QSC_SCB_LANES_MAXIMUM
+ * \brief The maximum number of lanes in the parallel mode.
+ */
+#define QSC_SCB_LANES_MAXIMUM 64ULL
+
+/*!
+ * \def QSC_SCB_LANES_MINIMUM
+ * \brief The minimum number of lanes in the parallel mode.
+ */
+#define QSC_SCB_LANES_MINIMUM 1ULL
+
 /*!
  * \struct qsc_scb_state
  * \brief The SCB state structure.
@@ -136,6 +163,8 @@ QSC_EXPORT_API typedef struct
     size_t cpuc;                            /*!< The CPU cost. */
     size_t memc;                            /*!< The memory cost. */
     size_t klen;                            /*!< The cache key length. */
+    size_t lanes;                           /*!< The parallel lane count, zero selects the sequential v1 mode. */
+    size_t threads;                         /*!< The maximum number of threads used by the parallel mode. */
     qsc_keccak_rate rate;                   /*!< The absorption rate. */
 } qsc_scb_state;
 
@@ -159,6 +188,26 @@ QSC_EXPORT_API void qsc_scb_dispose(qsc_scb_state* ctx);
  */
 QSC_EXPORT_API void qsc_scb_initialize(qsc_scb_state* ctx, const uint8_t* seed, size_t seedlen, const uint8_t* info, size_t infolen, size_t cpucost, size_t memcost);
 
+/**
+ * \brief [void] Initialize the state for the parallel (SCB v2) mode.
+ *
+ * \details
+ * The CPU cost is the number of passes over the memory. Each lane holds memcost / lanes of the memory,
+ * which must be at least 8 memory blocks (4.5 KiB for SCB-512, 8.5 KiB for SCB-256).
+ * The output of the parallel mode differs from the sequential mode for the same seed and costs.
+ *
+ * \param ctx:      [qsc_scb_state*] A pointer to the function state.
+ * \param seed:     [const uint8_t*] A pointer to the random seed (32 bytes instantiates cSHAKE-256; 64 bytes instantiates cSHAKE-512).
+ * \param seedlen:  [size_t] The length of the input seed in bytes.
+ * \param info:     [const uint8_t*] A pointer to the optional personalization string.
+ * \param infolen:  [size_t] The length of the personalization string in bytes.
+ * \param cpucost:  [size_t] The number of passes over the memory.
+ * \param memcost:  [size_t] The memory cost in mebibytes.
+ * \param lanes:    [size_t] The number of independent lanes, QSC_SCB_LANES_MINIMUM to QSC_SCB_LANES_MAXIMUM; changes the output.
+ * \param threads:  [size_t] The maximum number of threads, zero uses the processor count; does not change the output.
+ */
+QSC_EXPORT_API void qsc_scb_initialize_parallel(qsc_scb_state* ctx, const uint8_t* seed, size_t seedlen, const uint8_t* info, size_t infolen, size_t cpucost, size_t memcost, size_t lanes, size_t threads);
+
 /**
  * \brief [void] Generate pseudo-random bytes using the random provider.
  *
@@ -1,7 +1,254 @@
 #include "secrand.h"
+#include "async.h"
+#include "intutils.h"
 #include "memutils.h"
 
-qsc_secrand_state secrand_state;
+#if defined(QSC_SYSTEM_COMPILER_MSC)
+#	define SECRAND_THREAD_LOCAL __declspec(thread)
+#else
+#	define SECRAND_THREAD_LOCAL __thread
+#endif
+
+static const uint8_t secrand_fork_name[8] = { 0x53U, 0x45U, 0x43U, 0x52U, 0x41U, 0x4EU, 0x44U, 0x46U };
+
+typedef struct secrand_instance
+{
+	qsc_secrand_state state;			/* the thread generator */
+	struct secrand_instance* next;		/* the next instance in the master list */
+	uint64_t id;						/* the fork sequence number */
+} secrand_instance;
+
+typedef struct
+{
+	qsc_csg_state master;				/* the master generator the instances are forked from */
+	secrand_instance* instances;		/* the list of live thread instances */
+	uint64_t forks;						/* the number of instances forked */
+	size_t seedlen;						/* the fork seed length */
+	qsc_thread refill;					/* the refill thread handle */
+	volatile uint32_t generation;		/* incremented each time the instances are discarded */
+	volatile int32_t lock;				/* the spin lock guarding the master and the instance list */
+	volatile int32_t running;			/* the refill thread run flag */
+	bool init;							/* the initialized flag */
+} secrand_master_state;
+
+static secrand_master_state secrand_master;
+static SECRAND_THREAD_LOCAL secrand_instance* secrand_thread_instance;
+static SECRAND_THREAD_LOCAL uint64_t secrand_thread_id;
+static SECRAND_THREAD_LOCAL uint32_t secrand_thread_generation;
+
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+static DWORD secrand_thread_key = FLS_OUT_OF_INDEXES;
+#else
+static pthread_key_t secrand_thread_key;
+static bool secrand_key_created;
+#endif
+
+static uint32_t secrand_generation_load(void)
+{
+#if defined(QSC_SYSTEM_COMPILER_MSC)
+	return (uint32_t)InterlockedCompareExchange((volatile LONG*)&secrand_master.generation, 0, 0);
+#else
+	return __atomic_load_n(&secrand_master.generation, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static void secrand_instance_release(secrand_instance* inst)
+{
+	qsc_csg_dispose(&inst->state.hstate);
+	qsc_csg_dispose(&inst->state.rstate);
+	qsc_memutils_secure_erase(inst, sizeof(secrand_instance));
+	qsc_memutils_aligned_free(inst);
+}
+
+static void secrand_instance_unlink(secrand_instance* inst, uint64_t id)
+{
+	secrand_instance** pnode;
+
+	/* the pointer may be stale if the instances were discarded, so it is matched against the list and its id */
+	qsc_async_spinlock_lock(&secrand_master.lock);
+	pnode = &secrand_master.instances;
+
+	while (*pnode != NULL)
+	{
+		if (*pnode == inst && inst->id == id)
+		{
+			*pnode = inst->next;
+			secrand_instance_release(inst);
+			break;
+		}
+
+		pnode = &(*pnode)->next;
+	}
+
+	qsc_async_spinlock_unlock(&secrand_master.lock);
+}
+
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+static VOID WINAPI secrand_thread_exit(PVOID value)
+#else
+static void secrand_thread_exit(void* value)
+#endif
+{
+	/* erase and release the exiting thread's instance */
+	if (value != NULL)
+	{
+		secrand_instance_unlink((secrand_instance*)value, secrand_thread_id);
+		secrand_thread_instance = NULL;
+	}
+}
+
+static secrand_instance* secrand_fork(void)
+{
+	uint8_t seed[QSC_CSG_512_SEED_SIZE * 2U] = { 0 };
+	uint8_t info[sizeof(secrand_fork_name) + sizeof(uint64_t)] = { 0 };
+	secrand_instance* inst;
+	uint32_t gen;
+
+	inst = NULL;
+	qsc_async_spinlock_lock(&secrand_master.lock);
+
+	if (secrand_master.init == true)
+	{
+		inst = (secrand_instance*)qsc_memutils_aligned_alloc(QSC_MEMUTILS_CACHE_LINE_SIZE, sizeof(secrand_instance));
+
+		if (inst != NULL)
+		{
+			qsc_memutils_clear(inst, sizeof(secrand_instance));
+
+			/* draw independent seeds for the owner and refill generators, and bind the fork number */
+			qsc_csg_generate(&secrand_master.master, seed, secrand_master.seedlen * 2U);
+			++secrand_master.forks;
+			inst->id = secrand_master.forks;
+			qsc_memutils_copy(info, secrand_fork_name, sizeof(secrand_fork_name));
+			qsc_intutils_le64to8(info + sizeof(secrand_fork_name), inst->id);
+
+			qsc_csg_initialize(&inst->state.hstate, seed, secrand_master.seedlen, info, sizeof(info), true);
+			qsc_csg_initialize(&inst->state.rstate, seed + secrand_master.seedlen, secrand_master.seedlen, info, sizeof(info), true);
+			qsc_memutils_secure_erase(seed, sizeof(seed));
+
+			inst->state.active = inst->state.cache;
+			inst->state.reserve = inst->state.spare;
+			inst->state.cpos = QSC_SECRAND_CACHE_SIZE;
+			inst->state.ready = 0;
+			inst->state.init = true;
+
+			inst->next = secrand_master.instances;
+			secrand_master.instances = inst;
+			gen = secrand_master.generation;
+
+			secrand_thread_instance = inst;
+			secrand_thread_id = inst->id;
+			secrand_thread_generation = gen;
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+			FlsSetValue(secrand_thread_key, inst);
+#else
+			pthread_setspecific(secrand_thread_key, inst);
+#endif
+		}
+	}
+
+	qsc_async_spinlock_unlock(&secrand_master.lock);
+
+	return inst;
+}
+
+static secrand_instance* secrand_thread_state(void)
+{
+	secrand_instance* inst;
+
+	inst = secrand_thread_instance;
+
+	/* an instance from an earlier initialization was released by dispose or initialize */
+	if (inst == NULL || secrand_thread_generation != secrand_generation_load())
+	{
+		inst = secrand_fork();
+	}
+
+	return inst;
+}
+
+static void secrand_cache_fill(qsc_secrand_state* state)
+{
+	uint8_t* tmp;
+
+	if (qsc_async_atomic_load(&state->ready) == 1)
+	{
+		/* the refill thread has filled the reserve; swap it in and hand the spent cache back */
+		tmp = state->active;
+		state->active = state->reserve;
+		state->reserve = tmp;
+		qsc_async_atomic_store(&state->ready, 0);
+	}
+	else
+	{
+		qsc_csg_generate(&state->hstate, state->active, QSC_SECRAND_CACHE_SIZE);
+	}
+
+	state->cpos = 0U;
+}
+
+static bool secrand_refill_pass(void)
+{
+	secrand_instance* inst;
+	bool filled;
+
+	filled = false;
+	qsc_async_spinlock_lock(&secrand_master.lock);
+	inst = secrand_master.instances;
+
+	while (inst != NULL)
+	{
+		if (qsc_async_atomic_load(&inst->state.ready) == 0)
+		{
+			qsc_csg_generate(&inst->state.rstate, inst->state.reserve, QSC_SECRAND_CACHE_SIZE);
+			qsc_async_atomic_store(&inst->state.ready, 1);
+			filled = true;
+		}
+
+		inst = inst->next;
+	}
+
+	qsc_async_spinlock_unlock(&secrand_master.lock);
+
+	return filled;
+}
+
+static void secrand_refill_worker(void* state)
+{
+	(void)state;
+
+	while (qsc_async_atomic_load(&secrand_master.running) == 1)
+	{
+		if (secrand_refill_pass() == false)
+		{
+			qsc_async_thread_sleep(QSC_SECRAND_REFILL_INTERVAL);
+		}
+	}
+}
+
+static void secrand_release_instances(void)
+{
+	secrand_instance* inst;
+	secrand_instance* next;
+
+	/* caller holds the lock; the instances are freed here, so no thread may be generating concurrently */
+	inst = secrand_master.instances;
+
+	while (inst != NULL)
+	{
+		next = inst->next;
+		secrand_instance_release(inst);
+		inst = next;
+	}
+
+	secrand_master.instances = NULL;
+
+#if defined(QSC_SYSTEM_COMPILER_MSC)
+	InterlockedIncrement((volatile LONG*)&secrand_master.generation);
+#else
+	__atomic_add_fetch(&secrand_master.generation, 1U, __ATOMIC_RELEASE);
+#endif
+}
 
 int8_t qsc_secrand_next_char()
 {
@@ -321,13 +568,19 @@ uint64_t qsc_secrand_next_uint64_maxmin(uint64_t maximum, uint64_t minimum)
 
 void qsc_secrand_dispose()
 {
-	if (secrand_state.init == true)
+	qsc_secrand_refill_stop();
+	qsc_async_spinlock_lock(&secrand_master.lock);
+
+	if (secrand_master.init == true)
 	{
-		qsc_memutils_clear(secrand_state.cache, QSC_SECRAND_CACHE_SIZE);
-		qsc_csg_dispose(&secrand_state.hstate);
-		secrand_state.cpos = 0;
-		secrand_state.init = false;
+		secrand_release_instances();
+		qsc_csg_dispose(&secrand_master.master);
+		secrand_master.forks = 0U;
+		secrand_master.seedlen = 0U;
+		secrand_master.init = false;
 	}
+
+	qsc_async_spinlock_unlock(&secrand_master.lock);
 }
 
 void qsc_secrand_initialize(const uint8_t* seed, size_t seedlen, const uint8_t* custom, size_t custlen)
@@ -335,74 +588,109 @@ void qsc_secrand_initialize(const uint8_t* seed, size_t seedlen, const uint8_t*
 	assert(seed != NULL);
 	assert(seedlen == QSC_CSG_256_SEED_SIZE || seedlen == QSC_CSG_512_SEED_SIZE);
 
-	/* initialize the underlying generator */
-	qsc_csg_initialize(&secrand_state.hstate, seed, seedlen, custom, custlen, true);
+	qsc_async_spinlock_lock(&secrand_master.lock);
+
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+	if (secrand_thread_key == FLS_OUT_OF_INDEXES)
+	{
+		secrand_thread_key = FlsAlloc(&secrand_thread_exit);
+	}
+#else
+	if (secrand_key_created == false)
+	{
+		secrand_key_created = (pthread_key_create(&secrand_thread_key, &secrand_thread_exit) == 0);
+	}
+#endif
+
+	/* discard the instances forked from a previous master */
+	secrand_release_instances();
 
-	/* pre-fill the cache */
-	qsc_csg_generate(&secrand_state.hstate, secrand_state.cache, QSC_SECRAND_CACHE_SIZE);
-	secrand_state.cpos = 0;
-	secrand_state.init = true;
+	/* initialize the master generator */
+	qsc_csg_initialize(&secrand_master.master, seed, seedlen, custom, custlen, true);
+	secrand_master.seedlen = seedlen;
+	secrand_master.init = true;
+
+	qsc_async_spinlock_unlock(&secrand_master.lock);
 }
 
 bool qsc_secrand_generate(uint8_t* output, size_t length)
 {
 	assert(output != NULL);
-	assert(secrand_state.init == true);
+	assert(secrand_master.init == true);
 
-	const size_t BUFLEN = QSC_SECRAND_CACHE_SIZE - secrand_state.cpos;
+	secrand_instance* inst;
+	qsc_secrand_state* state;
+	size_t blen;
 	size_t poft;
 	bool res;
 
 	res = false;
 
-	if (secrand_state.init != true)
+	if (output != NULL && length != 0U)
 	{
-		output = NULL;
-		length = 0;
-	}
+		inst = secrand_thread_state();
 
-	if (length != 0)
-	{
-		if (length > BUFLEN)
+		if (inst != NULL)
 		{
-			poft = 0;
+			state = &inst->state;
 
-			if (BUFLEN > 0)
+			if (length >= QSC_SECRAND_CACHE_SIZE)
 			{
-				qsc_memutils_copy(output, secrand_state.cache + secrand_state.cpos, BUFLEN);
-				length -= BUFLEN;
-				poft += BUFLEN;
-				secrand_state.cpos = QSC_SECRAND_CACHE_SIZE;
+				/* bulk requests are squeezed straight into the output */
+				qsc_csg_generate(&state->hstate, output, length);
 			}
-
-			while (length >= QSC_SECRAND_CACHE_SIZE)
+			else
 			{
-				qsc_csg_generate(&secrand_state.hstate, secrand_state.cache, QSC_SECRAND_CACHE_SIZE);
-				qsc_memutils_copy(output + poft, secrand_state.cache, QSC_SECRAND_CACHE_SIZE);
-				length -= QSC_SECRAND_CACHE_SIZE;
-				poft += QSC_SECRAND_CACHE_SIZE;
+				poft = 0U;
+
+				while (length != 0U)
+				{
+					if (state->cpos == QSC_SECRAND_CACHE_SIZE)
+					{
+						secrand_cache_fill(state);
+					}
+
+					blen = qsc_intutils_min(length, QSC_SECRAND_CACHE_SIZE - state->cpos);
+					qsc_memutils_copy(output + poft, state->active + state->cpos, blen);
+					/* erase only the bytes handed out */
+					qsc_memutils_clear(state->active + state->cpos, blen);
+					state->cpos += blen;
+					poft += blen;
+					length -= blen;
+				}
 			}
 
-			if (length != 0)
-			{
-				qsc_csg_generate(&secrand_state.hstate, secrand_state.cache, QSC_SECRAND_CACHE_SIZE);
-				qsc_memutils_copy(output + poft, secrand_state.cache, length);
-				secrand_state.cpos = length;
-			}
-		}
-		else
-		{
-			qsc_memutils_copy(output, secrand_state.cache + secrand_state.cpos, length);
-			secrand_state.cpos += length;
+			res = true;
 		}
-
-		res = true;
 	}
 
-	if (secrand_state.cpos != 0)
+	return res;
+}
+
+bool qsc_secrand_refill_start()
+{
+	bool res;
+
+	res = false;
+	qsc_async_spinlock_lock(&secrand_master.lock);
+
+	if (secrand_master.init == true && qsc_async_atomic_load(&secrand_master.running) == 0)
 	{
-		qsc_memutils_clear((uint8_t*)secrand_state.cache, secrand_state.cpos);
+		qsc_async_atomic_store(&secrand_master.running, 1);
+		secrand_master.refill = qsc_async_thread_create(&secrand_refill_worker, NULL);
+		res = true;
 	}
 
+	qsc_async_spinlock_unlock(&secrand_master.lock);
+
 	return res;
 }
+
+void qsc_secrand_refill_stop()
+{
+	if (qsc_async_atomic_load(&secrand_master.running) == 1)
+	{
+		qsc_async_atomic_store(&secrand_master.running, 0);
+		qsc_async_thread_wait(secrand_master.refill);
+	}
+}
@@ -58,6 +58,29 @@ QSC_CPLUSPLUS_ENABLED_START
  * arbitrary arrays of random bytes. It relies on the underlying CSG (Custom SHAKE Generator) 
  * for cryptographic strength.
  *
+ * The seed passed to qsc_secrand_initialize() keys a master generator. Each thread that calls into 
+ * the module is given its own generator instance on first use, forked from the master with an 
+ * independent seed, so concurrent callers never share a cache or a Keccak state. After the fork the 
+ * hot path takes no locks. Requests of at least QSC_SECRAND_CACHE_SIZE bytes bypass the cache and are 
+ * generated directly into the output buffer. An optional background thread, started with 
+ * qsc_secrand_refill_start(), keeps a second cache per thread filled so that cache exhaustion costs 
+ * a pointer swap rather than a permutation run. Instances are erased and released when their 
+ * thread exits, or when qsc_secrand_dispose() is called.
+ *
+ * \code
+ * uint8_t seed[QSC_SECRAND_SEED_SIZE];
+ * qsc_acp_generate(seed, sizeof(seed));
+ *
+ * qsc_secrand_initialize(seed, sizeof(seed), NULL, 0);
+ * qsc_secrand_refill_start();
+ *
+ * // safe to call from any number of threads
+ * uint64_t nonce = qsc_secrand_next_uint64();
+ *
+ * qsc_secrand_refill_stop();
+ * qsc_secrand_dispose();
+ * \endcode
+ *
  * \section secrand_links Reference Links:
  * - <a href="https://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-90Ar1.pdf">NIST Pseudorandom Generator Guidelines (SP 800-90A)</a>
  */
@@ -70,19 +93,33 @@ QSC_CPLUSPLUS_ENABLED_START
 
 /*!
  * \def QSC_SECRAND_CACHE_SIZE
- * \brief The internal cache size of the generator.
+ * \brief The size of each per-thread cache of the generator.
+ * Can be overridden at compile time; a multiple of the Keccak rate avoids buffering a partial block.
  */
-#define QSC_SECRAND_CACHE_SIZE 1024ULL
+#if !defined(QSC_SECRAND_CACHE_SIZE)
+#	define QSC_SECRAND_CACHE_SIZE 8704ULL
+#endif
+
+/*!
+ * \def QSC_SECRAND_REFILL_INTERVAL
+ * \brief The number of milliseconds the refill thread sleeps when every cache is full.
+ */
+#define QSC_SECRAND_REFILL_INTERVAL 1U
 
 /*!
  * \struct qsc_secrand_state
- * \brief The internal secrand state array.
+ * \brief The per-thread secrand generator state.
  */
 QSC_EXPORT_API typedef struct
 {
-    qsc_csg_state hstate;                   /*!< The CSG state. */
-    uint8_t cache[QSC_SECRAND_CACHE_SIZE];  /*!< The cache buffer. */
-    size_t cpos;                            /*!< The cache position. */
+    qsc_csg_state hstate;                   /*!< The CSG state used by the owning thread. */
+    qsc_csg_state rstate;                   /*!< The CSG state used by the refill thread. */
+    uint8_t cache[QSC_SECRAND_CACHE_SIZE];  /*!< The first cache buffer. */
+    uint8_t spare[QSC_SECRAND_CACHE_SIZE];  /*!< The second cache buffer. */
+    uint8_t* active;                        /*!< The cache buffer being consumed. */
+    uint8_t* reserve;                       /*!< The cache buffer owned by the refill thread. */
+    size_t cpos;                            /*!< The position in the active cache. */
+    volatile int32_t ready;                 /*!< Set when the reserve cache has been filled. */
     bool init;                              /*!< The initialized flag. */
 } qsc_secrand_state;
 
@@ -252,12 +289,20 @@ QSC_EXPORT_API uint64_t qsc_secrand_next_uint64_max(uint64_t maximum);
 QSC_EXPORT_API uint64_t qsc_secrand_next_uint64_maxmin(uint64_t maximum, uint64_t minimum);
 
 /**
- * \brief Clear the buffer and destroy the internal state.
+ * \brief Erase and release the master generator and every per-thread instance.
+ *
+ * \details
+ * Stops the refill thread if it is running. No other thread may be generating while this is called.
  */
 QSC_EXPORT_API void qsc_secrand_dispose(void);
 
 /**
- * \brief Initialize the random generator with a seed and optional customization array.
+ * \brief Initialize the master generator with a seed and optional customization array.
+ *
+ * \details
+ * Per-thread instances created under a previous initialization are erased and released, and each thread
+ * forks a new instance from this master on its next call. Because those instances are freed immediately,
+ * no other thread may be generating while this is called.
  *
  * \param seed:     [const uint8_t*] The primary seed; must be 32 or 64 bytes in length.
  * \param seedlen:  [size_t]           The byte length of the seed.
@@ -269,12 +314,28 @@ QSC_EXPORT_API void qsc_secrand_initialize(const uint8_t* seed, size_t seedlen,
 /**
  * \brief Generate an array of pseudo-random bytes.
  *
+ * \details
+ * Requests of at least QSC_SECRAND_CACHE_SIZE bytes are squeezed directly from the calling thread's
+ * single-lane CSG state; the wide generator is not used, so throughput does not scale with the SIMD width.
+ *
  * \param output:   [uint8_t*] The destination array.
  * \param length:   [size_t]   The number of bytes to generate.
  * \return          [bool] Returns true if the operation succeeded.
  */
 QSC_EXPORT_API bool qsc_secrand_generate(uint8_t* output, size_t length);
 
+/**
+ * \brief Start the background thread that refills the reserve cache of each thread instance.
+ *
+ * \return          [bool] Returns true if the refill thread was started.
+ */
+QSC_EXPORT_API bool qsc_secrand_refill_start(void);
+
+/**
+ * \brief Stop the background refill thread and wait for it to exit.
+ */
+QSC_EXPORT_API void qsc_secrand_refill_stop(void);
+
 QSC_CPLUSPLUS_ENABLED_END
 
 #endif
@@ -2,12 +2,46 @@
 #include "intrinsics.h"
 #include "intutils.h"
 #include "memutils.h"
+#if defined(QSC_SHA2_SHANI_ENABLED)
+#	include "async.h"
+#	include "cpuidex.h"
+#endif
 
 
 #define SHA2_256_ROUNDS_COUNT 64ULL
 #define SHA2_384_ROUNDS_COUNT 80ULL
 #define SHA2_512_ROUNDS_COUNT 80ULL
 
+#if defined(QSC_SHA2_SHANI_ENABLED)
+#	if defined(QSC_SYSTEM_COMPILER_MSC)
+#		define SHA2_TARGET_SHANI
+#	else
+#		define SHA2_TARGET_SHANI __attribute__((target("sha,ssse3,sse4.1")))
+#	endif
+
+/* 0 = not yet probed, 1 = absent, 2 = present */
+static volatile int32_t sha2_shani_state;
+
+static bool sha2_shani_available(void)
+{
+	int32_t res;
+
+	res = qsc_async_atomic_load(&sha2_shani_state);
+
+	if (res == 0)
+	{
+		qsc_cpuidex_cpu_features cfeat = { 0 };
+
+		/* the probe is idempotent, so concurrent first callers may both run it */
+		res = (qsc_cpuidex_features_set(&cfeat) == true && cfeat.sha256 == true) ? 2 : 1;
+
+		qsc_async_atomic_store(&sha2_shani_state, res);
+	}
+
+	return (res == 2);
+}
+#endif
+
 /* SHA2-256 */
 
 static const uint32_t sha256_iv[8] =
@@ -116,11 +150,9 @@ void qsc_sha256_initialize(qsc_sha256_state* ctx)
 }
 
 #if defined(QSC_SHA2_SHANI_ENABLED)
-void qsc_sha256_permute(uint32_t* output, const uint8_t* message)
+SHA2_TARGET_SHANI
+static void sha256_permute_shani(uint32_t* output, const uint8_t* message)
 {
-	assert(output != NULL);
-	assert(message != NULL);
-
 	__m128i s0;
 	__m128i s1;
 	__m128i t0;
@@ -135,7 +167,7 @@ void qsc_sha256_permute(uint32_t* output, const uint8_t* message)
 
 	/* load initial values */
 	ptmp = _mm_loadu_si128((const __m128i*)output);
-	s1 = _mm_loadu_si128((const __m128i*)(uint32_t*)(output + (4 * sizeof(uint32_t))));
+	s1 = _mm_loadu_si128((const __m128i*)(output + 4));
 	mask = _mm_set_epi64x(0x0C0D0E0F08090A0BULL, 0x0405060700010203ULL);
 	ptmp = _mm_shuffle_epi32(ptmp, 0xB1);
 	s1 = _mm_shuffle_epi32(s1, 0x1B);
@@ -291,14 +323,12 @@ void qsc_sha256_permute(uint32_t* output, const uint8_t* message)
 
 	/* store */
 	_mm_storeu_si128((__m128i*)output, s0);
-	_mm_storeu_si128((__m128i*)(uint32_t*)(output + (4 * sizeof(uint32_t))), s1);
+	_mm_storeu_si128((__m128i*)(output + 4), s1);
 }
-#else
-void qsc_sha256_permute(uint32_t* output, const uint8_t* message)
-{
-	assert(output != NULL);
-	assert(message != NULL);
+#endif
 
+static void sha256_permute_base(uint32_t* output, const uint8_t* message)
+{
 	uint32_t a;
 	uint32_t b;
 	uint32_t c;
@@ -604,7 +634,23 @@ void qsc_sha256_permute(uint32_t* output, const uint8_t* message)
 	output[6] += g;
 	output[7] += h;
 }
+
+void qsc_sha256_permute(uint32_t* output, const uint8_t* message)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+
+#if defined(QSC_SHA2_SHANI_ENABLED)
+	if (sha2_shani_available() == true)
+	{
+		sha256_permute_shani(output, message);
+	}
+	else
 #endif
+	{
+		sha256_permute_base(output, message);
+	}
+}
 
 void qsc_sha256_update(qsc_sha256_state* ctx, const uint8_t* message, size_t msglen)
 {
@@ -920,11 +966,156 @@ void qsc_sha512_initialize(qsc_sha512_state* ctx)
 	ctx->position = 0;
 }
 
-void qsc_sha512_permute(uint64_t* output, const uint8_t* message)
+#if defined(QSC_SYSTEM_HAS_AVX512)
+static QSC_ALIGN(32) const uint64_t sha512_k[80] =
 {
-	assert(output != NULL);
-	assert(message != NULL);
+	0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+	0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+	0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+	0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+	0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+	0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+	0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+	0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+	0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+	0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+	0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+	0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+	0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+	0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+	0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+	0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+	0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+	0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+	0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+	0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+#	define SHA512_ROR256(x, n) _mm256_ror_epi64((x), (n))
+
+#	define SHA512_SIGMA0_256(x) _mm256_xor_si256(_mm256_xor_si256(SHA512_ROR256((x), 1), SHA512_ROR256((x), 8)), _mm256_srli_epi64((x), 7))
+#	define SHA512_SIGMA1_256(x) _mm256_xor_si256(_mm256_xor_si256(SHA512_ROR256((x), 19), SHA512_ROR256((x), 61)), _mm256_srli_epi64((x), 6))
+
+#	define SHA512_ROUND(a, b, c, d, e, f, g, h, k) \
+	r = (h) + ((((e) << 50) | ((e) >> 14)) ^ (((e) << 46) | ((e) >> 18)) ^ (((e) << 23) | ((e) >> 41))) + (((e) & (f)) ^ (~(e) & (g))) + (k); \
+	(d) += r; \
+	(h) = r + ((((a) << 36) | ((a) >> 28)) ^ (((a) << 30) | ((a) >> 34)) ^ (((a) << 25) | ((a) >> 39))) + (((a) & (b)) ^ ((a) & (c)) ^ ((b) & (c)));
+
+static __m256i sha512_schedule_avx512(__m256i x0, __m256i x1, __m256i x2, __m256i x3)
+{
+	/* computes W[t..t+3] from W[t-16..t-1], held oldest first in x0..x3 */
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i s1;
+	__m256i t;
+	__m256i w;
+
+	/* W[t-15..t-12] and W[t-7..t-4] straddle two registers */
+	w = _mm256_permute4x64_epi64(_mm256_blend_epi32(x0, x1, 0x03), 0x39);
+	t = _mm256_add_epi64(x0, SHA512_SIGMA0_256(w));
+	w = _mm256_permute4x64_epi64(_mm256_blend_epi32(x2, x3, 0x03), 0x39);
+	t = _mm256_add_epi64(t, w);
+
+	/* the low two words depend on W[t-2] and W[t-1] */
+	w = _mm256_permute4x64_epi64(x3, 0x0E);
+	s1 = SHA512_SIGMA1_256(w);
+	t = _mm256_add_epi64(t, _mm256_blend_epi32(s1, zero, 0xF0));
+
+	/* the high two words depend on the low two just computed */
+	w = _mm256_permute4x64_epi64(t, 0x40);
+	s1 = SHA512_SIGMA1_256(w);
+	t = _mm256_add_epi64(t, _mm256_blend_epi32(zero, s1, 0xF0));
+
+	return t;
+}
+
+static void sha512_permute_avx512(uint64_t* output, const uint8_t* message)
+{
+	/* the message schedule is computed four words at a time with native 64-bit rotates and interleaved
+	   with the scalar rounds; without vector rotates the scalar schedule is as fast, so AVX2 uses the base code */
+	const __m256i bswap = _mm256_set_epi64x(0x08090A0B0C0D0E0FLL, 0x0001020304050607LL, 0x08090A0B0C0D0E0FLL, 0x0001020304050607LL);
+	QSC_ALIGN(32) uint64_t wk[SHA2_512_ROUNDS_COUNT];
+	__m256i x0;
+	__m256i x1;
+	__m256i x2;
+	__m256i x3;
+	__m256i y;
+	__m256i z;
+	uint64_t a;
+	uint64_t b;
+	uint64_t c;
+	uint64_t d;
+	uint64_t e;
+	uint64_t f;
+	uint64_t g;
+	uint64_t h;
+	uint64_t r;
+	size_t i;
+
+	x0 = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)message), bswap);
+	x1 = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(message + 32)), bswap);
+	x2 = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(message + 64)), bswap);
+	x3 = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(message + 96)), bswap);
+	_mm256_store_si256((__m256i*)wk, _mm256_add_epi64(x0, _mm256_load_si256((const __m256i*)sha512_k)));
+	_mm256_store_si256((__m256i*)(wk + 4), _mm256_add_epi64(x1, _mm256_load_si256((const __m256i*)(sha512_k + 4))));
+	_mm256_store_si256((__m256i*)(wk + 8), _mm256_add_epi64(x2, _mm256_load_si256((const __m256i*)(sha512_k + 8))));
+	_mm256_store_si256((__m256i*)(wk + 12), _mm256_add_epi64(x3, _mm256_load_si256((const __m256i*)(sha512_k + 12))));
+
+	a = output[0];
+	b = output[1];
+	c = output[2];
+	d = output[3];
+	e = output[4];
+	f = output[5];
+	g = output[6];
+	h = output[7];
+
+	/* the schedule for words i + 16 onward is interleaved with rounds i to i + 7 */
+	for (i = 0; i < SHA2_512_ROUNDS_COUNT - 16; i += 8)
+	{
+		y = sha512_schedule_avx512(x0, x1, x2, x3);
+		z = sha512_schedule_avx512(x1, x2, x3, y);
+		_mm256_store_si256((__m256i*)(wk + i + 16), _mm256_add_epi64(y, _mm256_load_si256((const __m256i*)(sha512_k + i + 16))));
+		_mm256_store_si256((__m256i*)(wk + i + 20), _mm256_add_epi64(z, _mm256_load_si256((const __m256i*)(sha512_k + i + 20))));
+		x0 = x2;
+		x1 = x3;
+		x2 = y;
+		x3 = z;
+		SHA512_ROUND(a, b, c, d, e, f, g, h, wk[i]);
+		SHA512_ROUND(h, a, b, c, d, e, f, g, wk[i + 1]);
+		SHA512_ROUND(g, h, a, b, c, d, e, f, wk[i + 2]);
+		SHA512_ROUND(f, g, h, a, b, c, d, e, wk[i + 3]);
+		SHA512_ROUND(e, f, g, h, a, b, c, d, wk[i + 4]);
+		SHA512_ROUND(d, e, f, g, h, a, b, c, wk[i + 5]);
+		SHA512_ROUND(c, d, e, f, g, h, a, b, wk[i + 6]);
+		SHA512_ROUND(b, c, d, e, f, g, h, a, wk[i + 7]);
+	}
+
+	for (; i < SHA2_512_ROUNDS_COUNT; i += 8)
+	{
+		SHA512_ROUND(a, b, c, d, e, f, g, h, wk[i]);
+		SHA512_ROUND(h, a, b, c, d, e, f, g, wk[i + 1]);
+		SHA512_ROUND(g, h, a, b, c, d, e, f, wk[i + 2]);
+		SHA512_ROUND(f, g, h, a, b, c, d, e, wk[i + 3]);
+		SHA512_ROUND(e, f, g, h, a, b, c, d, wk[i + 4]);
+		SHA512_ROUND(d, e, f, g, h, a, b, c, wk[i + 5]);
+		SHA512_ROUND(c, d, e, f, g, h, a, b, wk[i + 6]);
+		SHA512_ROUND(b, c, d, e, f, g, h, a, wk[i + 7]);
+	}
 
+	output[0] += a;
+	output[1] += b;
+	output[2] += c;
+	output[3] += d;
+	output[4] += e;
+	output[5] += f;
+	output[6] += g;
+	output[7] += h;
+
+	qsc_memutils_clear((uint8_t*)wk, sizeof(wk));
+}
+#else
+static void sha512_permute_base(uint64_t* output, const uint8_t* message)
+{
 	uint64_t a;
 	uint64_t b;
 	uint64_t c;
@@ -1295,6 +1486,19 @@ void qsc_sha512_permute(uint64_t* output, const uint8_t* message)
 	output[6] += g;
 	output[7] += h;
 }
+#endif
+
+void qsc_sha512_permute(uint64_t* output, const uint8_t* message)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	sha512_permute_avx512(output, message);
+#else
+	sha512_permute_base(output, message);
+#endif
+}
 
 void qsc_sha512_update(qsc_sha512_state* ctx, const uint8_t* message, size_t msglen)
 {
@@ -1339,6 +1543,15 @@ void qsc_sha512_update(qsc_sha512_state* ctx, const uint8_t* message, size_t msg
 
 /* HMAC-256 */
 
+static void hmac256_load_state(qsc_sha256_state* st, const uint32_t* chain)
+{
+	/* resume the hash from a cached chaining state, one block into the message */
+	qsc_memutils_copy((uint8_t*)st->state, (const uint8_t*)chain, sizeof(st->state));
+	qsc_memutils_clear(st->buffer, sizeof(st->buffer));
+	st->t = QSC_SHA2_256_RATE;
+	st->position = 0;
+}
+
 void qsc_hmac256_compute(uint8_t* output, const uint8_t* message, size_t msglen, const uint8_t* key, size_t keylen)
 {
 	assert(output != NULL);
@@ -1359,8 +1572,7 @@ void qsc_hmac256_dispose(qsc_hmac256_state* ctx)
 	
 	if (ctx != NULL)
 	{
-		qsc_memutils_clear(ctx->ipad, sizeof(ctx->ipad));
-		qsc_memutils_clear(ctx->opad, sizeof(ctx->ipad));
+		qsc_memutils_clear((uint8_t*)ctx->ostate, sizeof(ctx->ostate));
 		qsc_sha256_dispose(&ctx->pstate);
 	}
 }
@@ -1374,10 +1586,10 @@ void qsc_hmac256_finalize(qsc_hmac256_state* ctx, uint8_t* output)
 	uint8_t tmpv[QSC_SHA2_256_HASH_SIZE] = { 0 };
 
 	qsc_sha256_finalize(&ctx->pstate, tmpv);
-	qsc_sha256_initialize(&ctx->pstate);
-	qsc_sha256_update(&ctx->pstate, ctx->opad, sizeof(ctx->opad));
+	hmac256_load_state(&ctx->pstate, ctx->ostate);
 	qsc_sha256_update(&ctx->pstate, tmpv, sizeof(tmpv));
 	qsc_sha256_finalize(&ctx->pstate, output);
+	qsc_memutils_clear(tmpv, sizeof(tmpv));
 	qsc_hmac256_dispose(ctx);
 }
 
@@ -1386,40 +1598,104 @@ void qsc_hmac256_initialize(qsc_hmac256_state* ctx, const uint8_t* key, size_t k
 	assert(ctx != NULL);
 	assert(key != NULL);
 
+	qsc_hmac256_prefix_state pfx;
+
+	qsc_hmac256_prefix_initialize(&pfx, key, keylen);
+	qsc_hmac256_prefix_clone(&pfx, ctx);
+	qsc_hmac256_prefix_dispose(&pfx);
+}
+
+void qsc_hmac256_update(qsc_hmac256_state* ctx, const uint8_t* message, size_t msglen)
+{
+	assert(ctx != NULL);
+	assert(message != NULL);
+
+	qsc_sha256_update(&ctx->pstate, message, msglen);
+}
+
+void qsc_hmac256_prefix_clone(const qsc_hmac256_prefix_state* pfx, qsc_hmac256_state* ctx)
+{
+	assert(pfx != NULL);
+	assert(ctx != NULL);
+
+	if (pfx != NULL && ctx != NULL)
+	{
+		hmac256_load_state(&ctx->pstate, pfx->istate);
+		qsc_memutils_copy((uint8_t*)ctx->ostate, (const uint8_t*)pfx->ostate, sizeof(ctx->ostate));
+	}
+}
+
+void qsc_hmac256_prefix_compute(const qsc_hmac256_prefix_state* pfx, uint8_t* output, const uint8_t* message, size_t msglen)
+{
+	assert(pfx != NULL);
+	assert(output != NULL);
+	assert(message != NULL);
+
+	qsc_hmac256_state ctx;
+
+	qsc_hmac256_prefix_clone(pfx, &ctx);
+	qsc_hmac256_update(&ctx, message, msglen);
+	qsc_hmac256_finalize(&ctx, output);
+}
+
+QSC_SYSTEM_OPTIMIZE_IGNORE
+void qsc_hmac256_prefix_dispose(qsc_hmac256_prefix_state* pfx)
+{
+	assert(pfx != NULL);
+
+	if (pfx != NULL)
+	{
+		qsc_memutils_clear((uint8_t*)pfx->istate, sizeof(pfx->istate));
+		qsc_memutils_clear((uint8_t*)pfx->ostate, sizeof(pfx->ostate));
+	}
+}
+QSC_SYSTEM_OPTIMIZE_RESUME
+
+void qsc_hmac256_prefix_initialize(qsc_hmac256_prefix_state* pfx, const uint8_t* key, size_t keylen)
+{
+	assert(pfx != NULL);
+	assert(key != NULL);
+
 	const uint8_t IPAD = 0x36;
 	const uint8_t OPAD = 0x5C;
-
-	qsc_memutils_clear(ctx->ipad, QSC_SHA2_256_RATE);
+	uint8_t ipad[QSC_SHA2_256_RATE] = { 0 };
+	uint8_t opad[QSC_SHA2_256_RATE] = { 0 };
 
 	if (keylen > QSC_SHA2_256_RATE)
 	{
-		qsc_sha256_initialize(&ctx->pstate);
-		qsc_sha256_update(&ctx->pstate, key, keylen);
-		qsc_sha256_finalize(&ctx->pstate, ctx->ipad);
+		qsc_sha256_compute(ipad, key, keylen);
 	}
 	else
 	{
-		qsc_memutils_copy(ctx->ipad, key, keylen);
+		qsc_memutils_copy(ipad, key, keylen);
 	}
 
-	qsc_memutils_copy(ctx->opad, ctx->ipad, QSC_SHA2_256_RATE);
-	qsc_memutils_xorv(ctx->opad, OPAD, QSC_SHA2_256_RATE);
-	qsc_memutils_xorv(ctx->ipad, IPAD, QSC_SHA2_256_RATE);
-
-	qsc_sha256_initialize(&ctx->pstate);
-	qsc_sha256_update(&ctx->pstate, ctx->ipad, sizeof(ctx->ipad));
-}
+	qsc_memutils_copy(opad, ipad, QSC_SHA2_256_RATE);
+	qsc_memutils_xorv(opad, OPAD, QSC_SHA2_256_RATE);
+	qsc_memutils_xorv(ipad, IPAD, QSC_SHA2_256_RATE);
 
-void qsc_hmac256_update(qsc_hmac256_state* ctx, const uint8_t* message, size_t msglen)
-{
-	assert(ctx != NULL);
-	assert(message != NULL);
+	/* compress the padded key blocks once and cache the chaining states */
+	qsc_memutils_copy((uint8_t*)pfx->istate, (const uint8_t*)sha256_iv, sizeof(pfx->istate));
+	qsc_sha256_permute(pfx->istate, ipad);
+	qsc_memutils_copy((uint8_t*)pfx->ostate, (const uint8_t*)sha256_iv, sizeof(pfx->ostate));
+	qsc_sha256_permute(pfx->ostate, opad);
 
-	qsc_sha256_update(&ctx->pstate, message, msglen);
+	qsc_memutils_clear(ipad, sizeof(ipad));
+	qsc_memutils_clear(opad, sizeof(opad));
 }
 
 /* HMAC-512 */
 
+static void hmac512_load_state(qsc_sha512_state* st, const uint64_t* chain)
+{
+	/* resume the hash from a cached chaining state, one block into the message */
+	qsc_memutils_copy((uint8_t*)st->state, (const uint8_t*)chain, sizeof(st->state));
+	qsc_memutils_clear(st->buffer, sizeof(st->buffer));
+	st->t[0] = QSC_SHA2_512_RATE;
+	st->t[1] = 0;
+	st->position = 0;
+}
+
 void qsc_hmac512_compute(uint8_t* output, const uint8_t* message, size_t msglen, const uint8_t* key, size_t keylen)
 {
 	assert(output != NULL);
@@ -1440,8 +1716,7 @@ void qsc_hmac512_dispose(qsc_hmac512_state* ctx)
 	
 	if (ctx != NULL)
 	{
-		qsc_memutils_clear(ctx->ipad, sizeof(ctx->ipad));
-		qsc_memutils_clear(ctx->opad, sizeof(ctx->ipad));
+		qsc_memutils_clear((uint8_t*)ctx->ostate, sizeof(ctx->ostate));
 		qsc_sha512_dispose(&ctx->pstate);
 	}
 }
@@ -1455,10 +1730,10 @@ void qsc_hmac512_finalize(qsc_hmac512_state* ctx, uint8_t* output)
 	uint8_t tmpv[QSC_SHA2_512_HASH_SIZE] = { 0 };
 
 	qsc_sha512_finalize(&ctx->pstate, tmpv);
-	qsc_sha512_initialize(&ctx->pstate);
-	qsc_sha512_update(&ctx->pstate, ctx->opad, sizeof(ctx->opad));
+	hmac512_load_state(&ctx->pstate, ctx->ostate);
 	qsc_sha512_update(&ctx->pstate, tmpv, sizeof(tmpv));
 	qsc_sha512_finalize(&ctx->pstate, output);
+	qsc_memutils_clear(tmpv, sizeof(tmpv));
 	qsc_hmac512_dispose(ctx);
 }
 
@@ -1467,36 +1742,90 @@ void qsc_hmac512_initialize(qsc_hmac512_state* ctx, const uint8_t* key, size_t k
 	assert(ctx != NULL);
 	assert(key != NULL);
 
+	qsc_hmac512_prefix_state pfx;
+
+	qsc_hmac512_prefix_initialize(&pfx, key, keylen);
+	qsc_hmac512_prefix_clone(&pfx, ctx);
+	qsc_hmac512_prefix_dispose(&pfx);
+}
+
+void qsc_hmac512_update(qsc_hmac512_state* ctx, const uint8_t* message, size_t msglen)
+{
+	assert(ctx != NULL);
+	assert(message != NULL);
+
+	qsc_sha512_update(&ctx->pstate, message, msglen);
+}
+
+void qsc_hmac512_prefix_clone(const qsc_hmac512_prefix_state* pfx, qsc_hmac512_state* ctx)
+{
+	assert(pfx != NULL);
+	assert(ctx != NULL);
+
+	if (pfx != NULL && ctx != NULL)
+	{
+		hmac512_load_state(&ctx->pstate, pfx->istate);
+		qsc_memutils_copy((uint8_t*)ctx->ostate, (const uint8_t*)pfx->ostate, sizeof(ctx->ostate));
+	}
+}
+
+void qsc_hmac512_prefix_compute(const qsc_hmac512_prefix_state* pfx, uint8_t* output, const uint8_t* message, size_t msglen)
+{
+	assert(pfx != NULL);
+	assert(output != NULL);
+	assert(message != NULL);
+
+	qsc_hmac512_state ctx;
+
+	qsc_hmac512_prefix_clone(pfx, &ctx);
+	qsc_hmac512_update(&ctx, message, msglen);
+	qsc_hmac512_finalize(&ctx, output);
+}
+
+QSC_SYSTEM_OPTIMIZE_IGNORE
+void qsc_hmac512_prefix_dispose(qsc_hmac512_prefix_state* pfx)
+{
+	assert(pfx != NULL);
+
+	if (pfx != NULL)
+	{
+		qsc_memutils_clear((uint8_t*)pfx->istate, sizeof(pfx->istate));
+		qsc_memutils_clear((uint8_t*)pfx->ostate, sizeof(pfx->ostate));
+	}
+}
+QSC_SYSTEM_OPTIMIZE_RESUME
+
+void qsc_hmac512_prefix_initialize(qsc_hmac512_prefix_state* pfx, const uint8_t* key, size_t keylen)
+{
+	assert(pfx != NULL);
+	assert(key != NULL);
+
 	const uint8_t IPAD = 0x36;
 	const uint8_t OPAD = 0x5C;
-
-	qsc_memutils_clear(ctx->ipad, QSC_SHA2_512_RATE);
+	uint8_t ipad[QSC_SHA2_512_RATE] = { 0 };
+	uint8_t opad[QSC_SHA2_512_RATE] = { 0 };
 
 	if (keylen > QSC_SHA2_512_RATE)
 	{
-		qsc_sha512_initialize(&ctx->pstate);
-		qsc_sha512_update(&ctx->pstate, key, keylen);
-		qsc_sha512_finalize(&ctx->pstate, ctx->ipad);
+		qsc_sha512_compute(ipad, key, keylen);
 	}
 	else
 	{
-		qsc_memutils_copy(ctx->ipad, key, keylen);
+		qsc_memutils_copy(ipad, key, keylen);
 	}
 
-	qsc_memutils_copy(ctx->opad, ctx->ipad, QSC_SHA2_512_RATE);
-	qsc_memutils_xorv(ctx->opad, OPAD, QSC_SHA2_512_RATE);
-	qsc_memutils_xorv(ctx->ipad, IPAD, QSC_SHA2_512_RATE);
-
-	qsc_sha512_initialize(&ctx->pstate);
-	qsc_sha512_update(&ctx->pstate, ctx->ipad, sizeof(ctx->ipad));
-}
+	qsc_memutils_copy(opad, ipad, QSC_SHA2_512_RATE);
+	qsc_memutils_xorv(opad, OPAD, QSC_SHA2_512_RATE);
+	qsc_memutils_xorv(ipad, IPAD, QSC_SHA2_512_RATE);
 
-void qsc_hmac512_update(qsc_hmac512_state* ctx, const uint8_t* message, size_t msglen)
-{
-	assert(ctx != NULL);
-	assert(message != NULL);
+	/* compress the padded key blocks once and cache the chaining states */
+	qsc_memutils_copy((uint8_t*)pfx->istate, (const uint8_t*)sha512_iv, sizeof(pfx->istate));
+	qsc_sha512_permute(pfx->istate, ipad);
+	qsc_memutils_copy((uint8_t*)pfx->ostate, (const uint8_t*)sha512_iv, sizeof(pfx->ostate));
+	qsc_sha512_permute(pfx->ostate, opad);
 
-	qsc_sha512_update(&ctx->pstate, message, msglen);
+	qsc_memutils_clear(ipad, sizeof(ipad));
+	qsc_memutils_clear(opad, sizeof(opad));
 }
 
 /* HKDF-256 */
@@ -1506,13 +1835,17 @@ void qsc_hkdf256_expand(uint8_t* output, size_t otplen, const uint8_t* key, size
 	assert(output != NULL);
 	assert(key != NULL);
 
+	qsc_hmac256_prefix_state pfx;
 	qsc_hmac256_state ctx;
 	uint8_t buf[QSC_SHA2_256_HASH_SIZE] = { 0 };
 	uint8_t ctr[1] = { 0 };
 
+	/* the key is expanded once; each output block starts from the cached prefix */
+	qsc_hmac256_prefix_initialize(&pfx, key, keylen);
+
 	while (otplen != 0)
 	{
-		qsc_hmac256_initialize(&ctx, key, keylen);
+		qsc_hmac256_prefix_clone(&pfx, &ctx);
 
 		if (ctr[0] != 0)
 		{
@@ -1534,6 +1867,9 @@ void qsc_hkdf256_expand(uint8_t* output, size_t otplen, const uint8_t* key, size
 		otplen -= RMDLEN;
 		output += RMDLEN;
 	}
+
+	qsc_hmac256_prefix_dispose(&pfx);
+	qsc_memutils_clear(buf, sizeof(buf));
 }
 
 void qsc_hkdf256_extract(uint8_t* output, size_t otplen, const uint8_t* key, size_t keylen, const uint8_t* salt, size_t saltlen)
@@ -1567,13 +1903,17 @@ void qsc_hkdf512_expand(uint8_t* output, size_t otplen, const uint8_t* key, size
 	assert(output != NULL);
 	assert(key != NULL);
 
+	qsc_hmac512_prefix_state pfx;
 	qsc_hmac512_state ctx;
 	uint8_t buf[QSC_SHA2_512_HASH_SIZE] = { 0 };
 	uint8_t ctr[1] = { 0 };
 
+	/* the key is expanded once; each output block starts from the cached prefix */
+	qsc_hmac512_prefix_initialize(&pfx, key, keylen);
+
 	while (otplen != 0)
 	{
-		qsc_hmac512_initialize(&ctx, key, keylen);
+		qsc_hmac512_prefix_clone(&pfx, &ctx);
 
 		if (ctr[0] != 0)
 		{
@@ -1595,6 +1935,9 @@ void qsc_hkdf512_expand(uint8_t* output, size_t otplen, const uint8_t* key, size
 		otplen -= RMDLEN;
 		output += RMDLEN;
 	}
+
+	qsc_hmac512_prefix_dispose(&pfx);
+	qsc_memutils_clear(buf, sizeof(buf));
 }
 
 void qsc_hkdf512_extract(uint8_t* output, size_t otplen, const uint8_t* key, size_t keylen, const uint8_t* salt, size_t saltlen)
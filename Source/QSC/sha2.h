@@ -71,8 +71,15 @@ QSC_CPLUSPLUS_ENABLED_START
  * - <a href="https://software.intel.com/sites/default/files/m/b/9/b/aciicmez.pdf">Analysis of SIMD Applicability to SHA Algorithms</a>
  */
 
-#if !defined(QSC_SHA2_SHANI_ENABLED)
-//#define QSC_SHA2_SHANI_ENABLED
+/*!
+ * \def QSC_SHA2_SHANI_ENABLED
+ * \brief Build the SHA-NI accelerated SHA2-256 compression function.
+ * The accelerated path is selected at runtime when the CPU reports the SHA extensions, so it is safe in portable builds.
+ * Define QSC_SHA2_SHANI_DISABLED to build only the reference code.
+ */
+#if !defined(QSC_SHA2_SHANI_ENABLED) && !defined(QSC_SHA2_SHANI_DISABLED) && defined(QSC_SYSTEM_ARCH_IX86) && !defined(QSC_SYSTEM_OS_BSD) && \
+	(defined(QSC_SYSTEM_COMPILER_MSC) || defined(QSC_SYSTEM_COMPILER_GCC))
+#	define QSC_SHA2_SHANI_ENABLED
 #endif
 
 /*!
@@ -376,9 +383,8 @@ QSC_EXPORT_API void qsc_sha512_update(qsc_sha512_state* ctx, const uint8_t* mess
  */
 QSC_EXPORT_API typedef struct
 {
-    qsc_sha256_state pstate;            /*!< The SHA2-256 state. */
-    uint8_t ipad[QSC_SHA2_256_RATE];    /*!< The input pad array. */
-    uint8_t opad[QSC_SHA2_256_RATE];    /*!< The output pad array. */
+    qsc_sha256_state pstate;                  /*!< The SHA2-256 state. */
+    uint32_t ostate[QSC_SHA2_STATE_SIZE];     /*!< The outer chaining state after the opad block. */
 } qsc_hmac256_state;
 
 /*!
@@ -432,6 +438,56 @@ QSC_EXPORT_API void qsc_hmac256_initialize(qsc_hmac256_state* ctx, const uint8_t
  */
 QSC_EXPORT_API void qsc_hmac256_update(qsc_hmac256_state* ctx, const uint8_t* message, size_t msglen);
 
+/*!
+ * \struct qsc_hmac256_prefix_state
+ * \brief The keyed HMAC(SHA2-256) prefix state.
+ *
+ * \details
+ * Caches the compression states after the ipad and opad blocks, so a key used for many messages
+ * is only expanded once. Each message started from the prefix saves two compression calls.
+ */
+QSC_EXPORT_API typedef struct
+{
+    uint32_t istate[QSC_SHA2_STATE_SIZE];     /*!< The inner chaining state after the ipad block. */
+    uint32_t ostate[QSC_SHA2_STATE_SIZE];     /*!< The outer chaining state after the opad block. */
+} qsc_hmac256_prefix_state;
+
+/*!
+ * \brief Copy the keyed prefix into an HMAC-256 state, ready to receive message input.
+ *
+ * \param pfx:      [const qsc_hmac256_prefix_state*] Pointer to the initialized prefix state.
+ * \param ctx:      [qsc_hmac256_state*] Pointer to the MAC state structure; use update and finalize after the call.
+ */
+QSC_EXPORT_API void qsc_hmac256_prefix_clone(const qsc_hmac256_prefix_state* pfx, qsc_hmac256_state* ctx);
+
+/*!
+ * \brief Process a message with a keyed HMAC(SHA2-256) prefix and return the MAC code in the output byte array.
+ *
+ * \warning The output array must be at least 32 bytes in length.
+ *
+ * \param pfx:      [const qsc_hmac256_prefix_state*] Pointer to the initialized prefix state.
+ * \param output:   [uint8_t*] The output byte array; receives the MAC code.
+ * \param message:  [const uint8_t*] The message input byte array.
+ * \param msglen:   [size_t] The number of message bytes to process.
+ */
+QSC_EXPORT_API void qsc_hmac256_prefix_compute(const qsc_hmac256_prefix_state* pfx, uint8_t* output, const uint8_t* message, size_t msglen);
+
+/*!
+ * \brief Dispose of the HMAC-256 prefix state.
+ *
+ * \param pfx:      [qsc_hmac256_prefix_state*] Pointer to the prefix state structure.
+ */
+QSC_EXPORT_API void qsc_hmac256_prefix_dispose(qsc_hmac256_prefix_state* pfx);
+
+/*!
+ * \brief Initialize an HMAC-256 prefix state with a key.
+ *
+ * \param pfx:      [qsc_hmac256_prefix_state*] Pointer to the prefix state structure.
+ * \param key:      [const uint8_t*] Pointer to the secret key array.
+ * \param keylen:   [size_t] The key array length.
+ */
+QSC_EXPORT_API void qsc_hmac256_prefix_initialize(qsc_hmac256_prefix_state* pfx, const uint8_t* key, size_t keylen);
+
 /* HMAC-512 */
 
 /*!
@@ -440,9 +496,8 @@ QSC_EXPORT_API void qsc_hmac256_update(qsc_hmac256_state* ctx, const uint8_t* me
  */
 QSC_EXPORT_API typedef struct
 {
-    qsc_sha512_state pstate;            /*!< The SHA2-512 state. */
-    uint8_t ipad[QSC_SHA2_512_RATE];    /*!< The input pad array. */
-    uint8_t opad[QSC_SHA2_512_RATE];    /*!< The output pad array. */
+    qsc_sha512_state pstate;                  /*!< The SHA2-512 state. */
+    uint64_t ostate[QSC_SHA2_STATE_SIZE];     /*!< The outer chaining state after the opad block. */
 } qsc_hmac512_state;
 
 /*!
@@ -496,6 +551,56 @@ QSC_EXPORT_API void qsc_hmac512_initialize(qsc_hmac512_state* ctx, const uint8_t
  */
 QSC_EXPORT_API void qsc_hmac512_update(qsc_hmac512_state* ctx, const uint8_t* message, size_t msglen);
 
+/*!
+ * \struct qsc_hmac512_prefix_state
+ * \brief The keyed HMAC(SHA2-512) prefix state.
+ *
+ * \details
+ * Caches the compression states after the ipad and opad blocks, so a key used for many messages
+ * is only expanded once. Each message started from the prefix saves two compression calls.
+ */
+QSC_EXPORT_API typedef struct
+{
+    uint64_t istate[QSC_SHA2_STATE_SIZE];     /*!< The inner chaining state after the ipad block. */
+    uint64_t ostate[QSC_SHA2_STATE_SIZE];     /*!< The outer chaining state after the opad block. */
+} qsc_hmac512_prefix_state;
+
+/*!
+ * \brief Copy the keyed prefix into an HMAC-512 state, ready to receive message input.
+ *
+ * \param pfx:      [const qsc_hmac512_prefix_state*] Pointer to the initialized prefix state.
+ * \param ctx:      [qsc_hmac512_state*] Pointer to the MAC state structure; use update and finalize after the call.
+ */
+QSC_EXPORT_API void qsc_hmac512_prefix_clone(const qsc_hmac512_prefix_state* pfx, qsc_hmac512_state* ctx);
+
+/*!
+ * \brief Process a message with a keyed HMAC(SHA2-512) prefix and return the MAC code in the output byte array.
+ *
+ * \warning The output array must be at least 64 bytes in length.
+ *
+ * \param pfx:      [const qsc_hmac512_prefix_state*] Pointer to the initialized prefix state.
+ * \param output:   [uint8_t*] The output byte array; receives the MAC code.
+ * \param message:  [const uint8_t*] The message input byte array.
+ * \param msglen:   [size_t] The number of message bytes to process.
+ */
+QSC_EXPORT_API void qsc_hmac512_prefix_compute(const qsc_hmac512_prefix_state* pfx, uint8_t* output, const uint8_t* message, size_t msglen);
+
+/*!
+ * \brief Dispose of the HMAC-512 prefix state.
+ *
+ * \param pfx:      [qsc_hmac512_prefix_state*] Pointer to the prefix state structure.
+ */
+QSC_EXPORT_API void qsc_hmac512_prefix_dispose(qsc_hmac512_prefix_state* pfx);
+
+/*!
+ * \brief Initialize an HMAC-512 prefix state with a key.
+ *
+ * \param pfx:      [qsc_hmac512_prefix_state*] Pointer to the prefix state structure.
+ * \param key:      [const uint8_t*] Pointer to the secret key array.
+ * \param keylen:   [size_t] The key array length.
+ */
+QSC_EXPORT_API void qsc_hmac512_prefix_initialize(qsc_hmac512_prefix_state* pfx, const uint8_t* key, size_t keylen);
+
 /* HKDF */
 
 /*!
@@ -1,6 +1,11 @@
 #include "sha3.h"
 #include "intutils.h"
 #include "memutils.h"
+#if defined(QSC_KECCAK_AVX512_ENABLED)
+#	include "async.h"
+#	include "cpuidex.h"
+#	include "intrinsics.h"
+#endif
 
 #define KPA_LEAF_HASH128 16ULL
 #define KPA_LEAF_HASH256 32ULL
@@ -1488,14 +1493,143 @@ void qsc_keccak_permute(qsc_keccak_state* ctx, size_t rounds)
 	if (ctx != NULL)
 	{
 #if defined(QSC_KECCAK_UNROLLED_PERMUTATION)
-		qsc_keccak_permute_p1600u(ctx->state)
+		qsc_keccak_permute_p1600u(ctx->state);
 #else
 		qsc_keccak_permute_p1600c(ctx->state, rounds);
 #endif
 	}
 }
 
-void qsc_keccak_permute_p1600c(uint64_t* state, size_t rounds)
+#if defined(QSC_KECCAK_AVX512_ENABLED)
+#	if defined(QSC_SYSTEM_COMPILER_MSC)
+#		define KECCAK_TARGET_AVX512
+#	else
+#		define KECCAK_TARGET_AVX512 __attribute__((target("avx512f")))
+#	endif
+
+/* 0 = not yet probed, 1 = absent, 2 = present */
+static volatile int32_t keccak_avx512_state;
+
+static bool keccak_avx512_available(void)
+{
+	int32_t res;
+
+	res = qsc_async_atomic_load(&keccak_avx512_state);
+
+	if (res == 0)
+	{
+		qsc_cpuidex_cpu_features cfeat = { 0 };
+
+		/* the probe is idempotent, so concurrent first callers may both run it */
+		res = (qsc_cpuidex_features_set(&cfeat) == true && cfeat.avx512f == true) ? 2 : 1;
+
+		qsc_async_atomic_store(&keccak_avx512_state, res);
+	}
+
+	return (res == 2);
+}
+
+KECCAK_TARGET_AVX512
+static void keccak_permute_p1600_avx512(uint64_t* state, size_t rounds)
+{
+	/* each plane (row y) is held in the low five lanes of one register;
+	   theta and chi are three-input xor/andn operations (vpternlogq),
+	   rho is a per-lane variable rotate (vprolvq), and pi is a lane shuffle */
+	const __mmask8 lmask = 0x1FU;
+	const __m512i xm1 = _mm512_setr_epi64(4, 0, 1, 2, 3, 5, 6, 7);
+	const __m512i xp1 = _mm512_setr_epi64(1, 2, 3, 4, 0, 5, 6, 7);
+	const __m512i xp2 = _mm512_setr_epi64(2, 3, 4, 0, 1, 5, 6, 7);
+	const __m512i rho0 = _mm512_setr_epi64(0, 1, 62, 28, 27, 0, 0, 0);
+	const __m512i rho1 = _mm512_setr_epi64(36, 44, 6, 55, 20, 0, 0, 0);
+	const __m512i rho2 = _mm512_setr_epi64(3, 10, 43, 25, 39, 0, 0, 0);
+	const __m512i rho3 = _mm512_setr_epi64(41, 45, 15, 21, 8, 0, 0, 0);
+	const __m512i rho4 = _mm512_setr_epi64(18, 2, 61, 56, 14, 0, 0, 0);
+	/* pi: output plane y, lane x is taken from input plane x, lane (x + 3y) mod 5;
+	   planes 0/1 and 2/3 are interleaved pairwise, then each output plane is gathered
+	   from the two pairs and its fifth lane is inserted from input plane 4 */
+	const __m512i pu01 = _mm512_setr_epi64(0, 9, 3, 12, 1, 10, 4, 8);
+	const __m512i pu23 = _mm512_setr_epi64(2, 11, 0, 9, 3, 12, 1, 10);
+	const __m512i pv01 = _mm512_setr_epi64(2, 11, 0, 0, 0, 0, 0, 0);
+	const __m512i pv23 = _mm512_setr_epi64(4, 8, 0, 0, 0, 0, 0, 0);
+	const __m512i pq0 = _mm512_setr_epi64(0, 1, 8, 9, 0, 0, 0, 0);
+	const __m512i pq1 = _mm512_setr_epi64(2, 3, 10, 11, 0, 0, 0, 0);
+	const __m512i pq2 = _mm512_setr_epi64(4, 5, 12, 13, 0, 0, 0, 0);
+	const __m512i pq3 = _mm512_setr_epi64(6, 7, 14, 15, 0, 0, 0, 0);
+	const __m512i pr0 = _mm512_set1_epi64(4);
+	const __m512i pr1 = _mm512_set1_epi64(2);
+	const __m512i pr2 = _mm512_set1_epi64(0);
+	const __m512i pr3 = _mm512_set1_epi64(3);
+	const __m512i pr4 = _mm512_set1_epi64(1);
+	__m512i a0;
+	__m512i a1;
+	__m512i a2;
+	__m512i a3;
+	__m512i a4;
+	__m512i c;
+	__m512i d;
+	__m512i e;
+	__m512i u01;
+	__m512i u23;
+	__m512i v01;
+	__m512i v23;
+
+	a0 = _mm512_maskz_loadu_epi64(lmask, state);
+	a1 = _mm512_maskz_loadu_epi64(lmask, state + 5);
+	a2 = _mm512_maskz_loadu_epi64(lmask, state + 10);
+	a3 = _mm512_maskz_loadu_epi64(lmask, state + 15);
+	a4 = _mm512_maskz_loadu_epi64(lmask, state + 20);
+
+	for (size_t i = 0; i < rounds; ++i)
+	{
+		/* theta */
+		c = _mm512_ternarylogic_epi64(_mm512_ternarylogic_epi64(a0, a1, a2, 0x96), a3, a4, 0x96);
+		d = _mm512_permutexvar_epi64(xm1, c);
+		e = _mm512_rol_epi64(_mm512_permutexvar_epi64(xp1, c), 1);
+		a0 = _mm512_ternarylogic_epi64(a0, d, e, 0x96);
+		a1 = _mm512_ternarylogic_epi64(a1, d, e, 0x96);
+		a2 = _mm512_ternarylogic_epi64(a2, d, e, 0x96);
+		a3 = _mm512_ternarylogic_epi64(a3, d, e, 0x96);
+		a4 = _mm512_ternarylogic_epi64(a4, d, e, 0x96);
+
+		/* rho */
+		a0 = _mm512_rolv_epi64(a0, rho0);
+		a1 = _mm512_rolv_epi64(a1, rho1);
+		a2 = _mm512_rolv_epi64(a2, rho2);
+		a3 = _mm512_rolv_epi64(a3, rho3);
+		a4 = _mm512_rolv_epi64(a4, rho4);
+
+		/* pi */
+		u01 = _mm512_permutex2var_epi64(a0, pu01, a1);
+		u23 = _mm512_permutex2var_epi64(a2, pu23, a3);
+		v01 = _mm512_permutex2var_epi64(a0, pv01, a1);
+		v23 = _mm512_permutex2var_epi64(a2, pv23, a3);
+		c = a4;
+		a0 = _mm512_mask_permutexvar_epi64(_mm512_permutex2var_epi64(u01, pq0, u23), 0x10U, pr0, c);
+		a1 = _mm512_mask_permutexvar_epi64(_mm512_permutex2var_epi64(u01, pq1, u23), 0x10U, pr1, c);
+		a2 = _mm512_mask_permutexvar_epi64(_mm512_permutex2var_epi64(u01, pq2, u23), 0x10U, pr2, c);
+		a3 = _mm512_mask_permutexvar_epi64(_mm512_permutex2var_epi64(u01, pq3, u23), 0x10U, pr3, c);
+		a4 = _mm512_mask_permutexvar_epi64(_mm512_permutex2var_epi64(v01, pq0, v23), 0x10U, pr4, c);
+
+		/* chi: a ^ (~b & c) */
+		a0 = _mm512_ternarylogic_epi64(a0, _mm512_permutexvar_epi64(xp1, a0), _mm512_permutexvar_epi64(xp2, a0), 0xD2);
+		a1 = _mm512_ternarylogic_epi64(a1, _mm512_permutexvar_epi64(xp1, a1), _mm512_permutexvar_epi64(xp2, a1), 0xD2);
+		a2 = _mm512_ternarylogic_epi64(a2, _mm512_permutexvar_epi64(xp1, a2), _mm512_permutexvar_epi64(xp2, a2), 0xD2);
+		a3 = _mm512_ternarylogic_epi64(a3, _mm512_permutexvar_epi64(xp1, a3), _mm512_permutexvar_epi64(xp2, a3), 0xD2);
+		a4 = _mm512_ternarylogic_epi64(a4, _mm512_permutexvar_epi64(xp1, a4), _mm512_permutexvar_epi64(xp2, a4), 0xD2);
+
+		/* iota */
+		a0 = _mm512_mask_xor_epi64(a0, 0x01U, a0, _mm512_set1_epi64((int64_t)KECCAK_ROUND_CONSTANTS[i]));
+	}
+
+	_mm512_mask_storeu_epi64(state, lmask, a0);
+	_mm512_mask_storeu_epi64(state + 5, lmask, a1);
+	_mm512_mask_storeu_epi64(state + 10, lmask, a2);
+	_mm512_mask_storeu_epi64(state + 15, lmask, a3);
+	_mm512_mask_storeu_epi64(state + 20, lmask, a4);
+}
+#endif
+
+static void keccak_permute_p1600_base(uint64_t* state, size_t rounds)
 {
 	assert(state != NULL);
 	assert(rounds % 2 == 0);
@@ -1809,6 +1943,23 @@ void qsc_keccak_permute_p1600c(uint64_t* state, size_t rounds)
 	state[24] = Asu;
 }
 
+void qsc_keccak_permute_p1600c(uint64_t* state, size_t rounds)
+{
+	assert(state != NULL);
+	assert(rounds % 2 == 0);
+
+#if defined(QSC_KECCAK_AVX512_ENABLED)
+	if (keccak_avx512_available() == true)
+	{
+		keccak_permute_p1600_avx512(state, rounds);
+	}
+	else
+#endif
+	{
+		keccak_permute_p1600_base(state, rounds);
+	}
+}
+
 void qsc_keccak_permute_p1600u(uint64_t* state)
 {
 	assert(state != NULL);
@@ -4399,6 +4550,75 @@ void qsc_cshake_update(qsc_keccak_state* ctx, qsc_keccak_rate rate, const uint8_
 	}
 }
 
+void qsc_cshake_prefix_initialize(qsc_cshake_prefix_state* pfx, qsc_keccak_rate rate, const uint8_t* name, size_t namelen, const uint8_t* custom, size_t custlen)
+{
+	assert(pfx != NULL);
+
+	if (pfx != NULL)
+	{
+		qsc_keccak_initialize_state(&pfx->kstate);
+		qsc_keccak_absorb_custom(&pfx->kstate, rate, custom, custlen, name, namelen, QSC_KECCAK_PERMUTATION_ROUNDS);
+		pfx->rate = rate;
+	}
+}
+
+void qsc_cshake_prefix_clone(const qsc_cshake_prefix_state* pfx, qsc_keccak_state* ctx, const uint8_t* key, size_t keylen)
+{
+	assert(pfx != NULL);
+	assert(ctx != NULL);
+	assert(key != NULL);
+
+	if (pfx != NULL && ctx != NULL && key != NULL)
+	{
+		qsc_memutils_copy(ctx, &pfx->kstate, sizeof(qsc_keccak_state));
+		qsc_keccak_absorb(ctx, pfx->rate, key, keylen, QSC_KECCAK_CSHAKE_DOMAIN_ID, QSC_KECCAK_PERMUTATION_ROUNDS);
+	}
+}
+
+void qsc_cshake_prefix_compute(const qsc_cshake_prefix_state* pfx, uint8_t* output, size_t outlen, const uint8_t* key, size_t keylen)
+{
+	assert(pfx != NULL);
+	assert(output != NULL);
+	assert(key != NULL);
+
+	uint8_t hash[QSC_KECCAK_128_RATE] = { 0 };
+	qsc_keccak_state ctx;
+	size_t nblocks;
+
+	if (pfx != NULL && output != NULL && key != NULL)
+	{
+		nblocks = outlen / (size_t)pfx->rate;
+		qsc_cshake_prefix_clone(pfx, &ctx, key, keylen);
+
+		if (nblocks != 0)
+		{
+			qsc_cshake_squeezeblocks(&ctx, pfx->rate, output, nblocks);
+			output += nblocks * (size_t)pfx->rate;
+			outlen -= nblocks * (size_t)pfx->rate;
+		}
+
+		if (outlen != 0)
+		{
+			qsc_cshake_squeezeblocks(&ctx, pfx->rate, hash, 1);
+			qsc_memutils_copy(output, hash, outlen);
+			qsc_memutils_clear(hash, sizeof(hash));
+		}
+
+		qsc_keccak_dispose(&ctx);
+	}
+}
+
+void qsc_cshake_prefix_dispose(qsc_cshake_prefix_state* pfx)
+{
+	assert(pfx != NULL);
+
+	if (pfx != NULL)
+	{
+		qsc_keccak_dispose(&pfx->kstate);
+		pfx->rate = qsc_keccak_rate_none;
+	}
+}
+
 /* KMAC */
 
 void qsc_kmac128_compute(uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen, const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen)
@@ -4463,754 +4683,973 @@ void qsc_kmac_update(qsc_keccak_state* ctx, qsc_keccak_rate rate, const uint8_t*
 	qsc_keccak_update(ctx, rate, message, msglen, QSC_KECCAK_PERMUTATION_ROUNDS);
 }
 
-/* KPA */
-
-static void kpa_absorb_leaves(uint64_t* state, qsc_keccak_rate rate, const uint8_t* input, size_t inplen)
-{
-	assert(state != NULL);
-	assert(input != NULL);
+/* Batch */
 
-	while (inplen >= (size_t)rate)
-	{
-#if defined(QSC_SYSTEM_IS_LITTLE_ENDIAN)
-		qsc_memutils_xor((uint8_t*)state, input, rate);
+#if defined(QSC_SYSTEM_HAS_AVX512)
+#	define KECCAK_BATCH_LANES 8U
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+#	define KECCAK_BATCH_LANES 4U
 #else
-		for (size_t i = 0; i < rate / sizeof(uint64_t); ++i)
-		{
-			state[i] ^= qsc_intutils_le8to64(input + (sizeof(uint64_t) * i));
-		}
+#	define KECCAK_BATCH_LANES 1U
 #endif
-		qsc_keccak_permute_p1600c(state, QSC_KPA_ROUNDS);
-		inplen -= rate;
-		input += rate;
-	}
 
-	if (inplen != 0)
+#define KECCAK_BATCH_BUCKETS 16U
+
+static size_t keccak_batch_final(uint8_t blocks[2][QSC_KECCAK_STATE_BYTE_SIZE], const uint8_t* tail, size_t tlen, const uint8_t* enc, size_t enclen, uint8_t domain, size_t rate)
+{
+	/* builds the final blocks of a message; a tail that leaves no room for a KMAC
+	   length encoding is absorbed alone, and its bytes remain in the final pad block */
+	size_t nblk;
+	size_t pos;
+
+	qsc_memutils_clear(blocks[0], rate);
+	qsc_memutils_copy(blocks[0], tail, tlen);
+	pos = tlen;
+	nblk = 1;
+
+	if (enclen != 0)
 	{
-#if defined(QSC_SYSTEM_IS_LITTLE_ENDIAN)
-		qsc_memutils_xor((uint8_t*)state, input, inplen);
-#else
-		for (size_t i = 0; i < inplen / sizeof(uint64_t); ++i)
+		if (pos + enclen >= rate)
 		{
-			state[i] ^= qsc_intutils_le8to64(input + (sizeof(uint64_t) * i));
+			qsc_memutils_copy(blocks[1], blocks[0], rate);
+			pos = 0;
+			nblk = 2;
 		}
-#endif
 
-		qsc_keccak_permute_p1600c(state, QSC_KPA_ROUNDS);
+		qsc_memutils_copy(blocks[nblk - 1] + pos, enc, enclen);
 	}
-}
-
-static void kpa_fast_absorbx8(qsc_kpa_state* ctx, const uint8_t* message)
-{
-	assert(ctx != NULL);
-	assert(message != NULL);
 
-#if defined(QSC_SYSTEM_HAS_AVX512)
+	blocks[nblk - 1][pos + enclen] = domain;
+	blocks[nblk - 1][rate - 1] |= 128U;
 
-	const size_t ROFT = (size_t)ctx->rate;
-	__m512i idx;
-	__m512i wbuf;
-	int64_t pos;
+	return nblk;
+}
 
-	idx = _mm512_set_epi64((int64_t)&message[7 * ROFT], (int64_t)&message[6 * ROFT], (int64_t)&message[5 * ROFT],
-		(int64_t)&message[4 * ROFT], (int64_t)&message[3 * ROFT], (int64_t)&message[2 * ROFT], (int64_t)&message[ROFT], (int64_t)&message[0]);
+static void keccak_batch_single(const uint64_t* istate, size_t rate, uint8_t domain, const uint8_t* enc, size_t enclen,
+	uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen)
+{
+	uint8_t pads[2][QSC_KECCAK_STATE_BYTE_SIZE];
+	uint8_t otp[QSC_KECCAK_STATE_BYTE_SIZE];
+	uint64_t state[QSC_KECCAK_STATE_SIZE];
+	size_t blen;
+	size_t nblk;
+	size_t opos;
 
-	pos = 0;
+	qsc_memutils_copy(state, istate, sizeof(state));
 
-	for (size_t i = 0; i < (size_t)ctx->rate / sizeof(uint64_t); ++i)
+	while (msglen >= rate)
 	{
-		wbuf = _mm512_i64gather_epi64(idx, (int64_t*)pos, 1);
-		pos += sizeof(uint64_t);
-		ctx->statew[i] = _mm512_xor_si512(ctx->statew[i], wbuf);
+		keccak_fast_absorb(state, message, rate);
+		qsc_keccak_permute_p1600c(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+		message += rate;
+		msglen -= rate;
 	}
 
-#elif defined(QSC_SYSTEM_HAS_AVX2)
-
-	const size_t ROFT = (size_t)ctx->rate;
-	QSC_ALIGN(32) uint64_t tmp[4] = { 0 };
-	__m256i wbuf;
-	const uint8_t* pmsg = message;
+	nblk = keccak_batch_final(pads, message, msglen, enc, enclen, domain, rate);
 
-	for (size_t i = 0; i < (size_t)ctx->rate / sizeof(uint64_t); ++i)
+	for (size_t b = 0; b < nblk; ++b)
 	{
-		tmp[0] = qsc_intutils_le8to64(pmsg);
-		tmp[1] = qsc_intutils_le8to64(pmsg + ROFT);
-		tmp[2] = qsc_intutils_le8to64(pmsg + (2 * ROFT));
-		tmp[3] = qsc_intutils_le8to64(pmsg + (3 * ROFT));
-		wbuf = _mm256_loadu_si256((const __m256i*)tmp);
-		ctx->statew[0][i] = _mm256_xor_si256(ctx->statew[0][i], wbuf);
-
-		tmp[0] = qsc_intutils_le8to64(pmsg + (4 * ROFT));
-		tmp[1] = qsc_intutils_le8to64(pmsg + (5 * ROFT));
-		tmp[2] = qsc_intutils_le8to64(pmsg + (6 * ROFT));
-		tmp[3] = qsc_intutils_le8to64(pmsg + (7 * ROFT));
-		wbuf = _mm256_loadu_si256((const __m256i*)tmp);
-		ctx->statew[1][i] = _mm256_xor_si256(ctx->statew[1][i], wbuf);
+		if (b != 0)
+		{
+			qsc_keccak_permute_p1600c(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+		}
 
-		pmsg += sizeof(uint64_t);
+		keccak_fast_absorb(state, pads[b], rate);
 	}
 
-#else
+	opos = 0;
 
-	for (size_t i = 0; i < QSC_KPA_PARALLELISM; ++i)
+	while (opos < outlen)
 	{
-#if defined(QSC_SYSTEM_IS_LITTLE_ENDIAN)
-		qsc_memutils_xor((uint8_t*)ctx->state[i], (message + (i * (size_t)ctx->rate)), (size_t)ctx->rate);
-#else
-		for (size_t j = 0; j < (size_t)ctx->rate / sizeof(uint64_t); ++j)
+		qsc_keccak_permute_p1600c(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+
+		for (size_t i = 0; i < rate / sizeof(uint64_t); ++i)
 		{
-			ctx->state[i][j] ^= qsc_intutils_le8to64((message + (i * (size_t)ctx->rate) + (j * sizeof(uint64_t))));
+			qsc_intutils_le64to8(otp + (i * sizeof(uint64_t)), state[i]);
 		}
-#endif
+
+		blen = qsc_intutils_min(rate, outlen - opos);
+		qsc_memutils_copy(output + opos, otp, blen);
+		opos += blen;
 	}
-#endif
+
+	qsc_memutils_clear((uint8_t*)state, sizeof(state));
+	qsc_memutils_clear((uint8_t*)pads, nblk * sizeof(pads[0]));
+	qsc_memutils_clear(otp, sizeof(otp));
 }
 
-static void kpa_permutex8(qsc_kpa_state* ctx)
+#if (KECCAK_BATCH_LANES > 1U)
+
+static size_t keccak_batch_block_count(size_t msglen, size_t enclen, size_t rate)
 {
-	assert(ctx != NULL);
+	return (msglen / rate) + (((msglen % rate) + enclen >= rate) ? 2U : 1U);
+}
 
+static void keccak_batch_lanes(const uint64_t* istate, size_t rate, uint8_t domain, const uint8_t* enc, size_t enclen,
+	uint8_t* const* outputs, size_t outlen, const uint8_t* const* messages, const size_t* msglens, const size_t* index, size_t lcnt, size_t nblocks)
+{
+	uint8_t pads[KECCAK_BATCH_LANES][2][QSC_KECCAK_STATE_BYTE_SIZE];
+	uint8_t otp[KECCAK_BATCH_LANES][QSC_KECCAK_STATE_BYTE_SIZE];
+	uint64_t tmp[KECCAK_BATCH_LANES];
+	const uint8_t* blk[KECCAK_BATCH_LANES];
+	size_t full[KECCAK_BATCH_LANES];
+	size_t blen;
+	size_t opos;
+	size_t k;
 #if defined(QSC_SYSTEM_HAS_AVX512)
-	qsc_keccak_permute_p8x1600(ctx->statew, QSC_KPA_ROUNDS);
-#elif defined(QSC_SYSTEM_HAS_AVX2)
-	qsc_keccak_permute_p4x1600(ctx->statew[0], QSC_KPA_ROUNDS);
-	qsc_keccak_permute_p4x1600(ctx->statew[1], QSC_KPA_ROUNDS);
+	__m512i state[QSC_KECCAK_STATE_SIZE];
 #else
-	for (size_t i = 0; i < QSC_KPA_PARALLELISM; ++i)
+	__m256i state[QSC_KECCAK_STATE_SIZE];
+#endif
+
+	/* broadcast the initial state into every lane; unused lanes repeat the first message */
+	for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
 	{
-		qsc_keccak_permute_p1600c(ctx->state[i], QSC_KPA_ROUNDS);
-	}
+#if defined(QSC_SYSTEM_HAS_AVX512)
+		state[i] = _mm512_set1_epi64((long long)istate[i]);
+#else
+		state[i] = _mm256_set1_epi64x((long long)istate[i]);
 #endif
-}
+	}
 
-static void kpa_squeezeblocks(uint64_t* state, uint8_t* output, size_t nblocks, qsc_keccak_rate rate)
-{
-	assert(state != NULL);
-	assert(output != NULL);
+	for (size_t j = 0; j < KECCAK_BATCH_LANES; ++j)
+	{
+		k = index[(j < lcnt) ? j : 0];
+		full[j] = msglens[k] / rate;
+		keccak_batch_final(pads[j], messages[k] + (full[j] * rate), msglens[k] % rate, enc, enclen, domain, rate);
+	}
 
-	while (nblocks > 0)
+	/* absorb the message blocks, then the final pad blocks, of all lanes together */
+	for (size_t b = 0; b < nblocks; ++b)
 	{
-		qsc_keccak_permute_p1600c(state, QSC_KPA_ROUNDS);
+		for (size_t j = 0; j < KECCAK_BATCH_LANES; ++j)
+		{
+			k = index[(j < lcnt) ? j : 0];
+			blk[j] = (b < full[j]) ? messages[k] + (b * rate) : pads[j][b - full[j]];
+		}
 
-#if defined(QSC_SYSTEM_IS_LITTLE_ENDIAN)
-		qsc_memutils_copy(output, (uint8_t*)state, (size_t)rate);
-#else
-		for (size_t i = 0; i < (rate >> 3); ++i)
+		for (size_t i = 0; i < rate / sizeof(uint64_t); ++i)
 		{
-			qsc_intutils_le64to8((output + sizeof(uint64_t) * i), state[i]);
+			for (size_t j = 0; j < KECCAK_BATCH_LANES; ++j)
+			{
+				tmp[j] = qsc_intutils_le8to64(blk[j] + (i * sizeof(uint64_t)));
+			}
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+			state[i] = _mm512_xor_si512(state[i], _mm512_loadu_si512((const __m512i*)tmp));
+#else
+			state[i] = _mm256_xor_si256(state[i], _mm256_loadu_si256((const __m256i*)tmp));
+#endif
 		}
+
+		if (b + 1 < nblocks)
+		{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+			qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+#else
+			qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
 #endif
-		output += rate;
-		nblocks--;
+		}
 	}
-}
 
-#if defined(QSC_KPA_AVX_PARALLEL)
+	/* squeeze the outputs */
+	opos = 0;
 
-#if defined(KPA_HISTORICAL_ENABLE)
-static void kpa_load_state(qsc_kpa_state* ctx)
-{
-	/* Note: artifact, not currently used */
-	assert(ctx != NULL);
+	while (opos < outlen)
+	{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+		qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+#else
+		qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+#endif
 
+		for (size_t i = 0; i < rate / sizeof(uint64_t); ++i)
+		{
 #if defined(QSC_SYSTEM_HAS_AVX512)
+			_mm512_storeu_si512((__m512i*)tmp, state[i]);
+#else
+			_mm256_storeu_si256((__m256i*)tmp, state[i]);
+#endif
 
-	__m512i idx;
-	int64_t pos;
+			for (size_t j = 0; j < lcnt; ++j)
+			{
+				qsc_intutils_le64to8(otp[j] + (i * sizeof(uint64_t)), tmp[j]);
+			}
+		}
 
-	idx = _mm512_set_epi64((int64_t)&ctx->state[7][0], (int64_t)&ctx->state[6][0], (int64_t)&ctx->state[5][0], (int64_t)&ctx->state[4][0],
-		(int64_t)&ctx->state[3][0], (int64_t)&ctx->state[2][0], (int64_t)&ctx->state[1][0], (int64_t)&ctx->state[0][0]);
+		blen = qsc_intutils_min(rate, outlen - opos);
 
-	pos = 0;
+		for (size_t j = 0; j < lcnt; ++j)
+		{
+			qsc_memutils_copy(outputs[index[j]] + opos, otp[j], blen);
+		}
 
-	for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
-	{
-		ctx->statew[i] = _mm512_i64gather_epi64(idx, (int64_t*)pos, 1);
-		pos += sizeof(uint64_t);
+		opos += blen;
 	}
 
-#elif defined(QSC_SYSTEM_HAS_AVX2)
-
-	QSC_ALIGN(32) uint64_t tmp[4] = { 0 };
+	qsc_memutils_clear((uint8_t*)state, sizeof(state));
+	qsc_memutils_clear((uint8_t*)pads, sizeof(pads));
+	qsc_memutils_clear((uint8_t*)otp, sizeof(otp));
+}
 
-	for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+static void keccak_batch_dispatch(const uint64_t* istate, size_t rate, uint8_t domain, const uint8_t* enc, size_t enclen,
+	uint8_t* const* outputs, size_t outlen, const uint8_t* const* messages, const size_t* msglens, const size_t* index, size_t lcnt, size_t nblocks)
+{
+	if (lcnt >= KECCAK_BATCH_LANES / 2U)
 	{
-		tmp[0] = ctx->state[0][i];
-		tmp[1] = ctx->state[1][i];
-		tmp[2] = ctx->state[2][i];
-		tmp[3] = ctx->state[3][i];
-		ctx->statew[0][i] = _mm256_loadu_si256((const __m256i*)tmp);
-		tmp[0] = ctx->state[4][i];
-		tmp[1] = ctx->state[5][i];
-		tmp[2] = ctx->state[6][i];
-		tmp[3] = ctx->state[7][i];
-		ctx->statew[1][i] = _mm256_loadu_si256((const __m256i*)tmp);
+		keccak_batch_lanes(istate, rate, domain, enc, enclen, outputs, outlen, messages, msglens, index, lcnt, nblocks);
+	}
+	else
+	{
+		/* stragglers that would leave most of the lanes idle are hashed one at a time */
+		for (size_t j = 0; j < lcnt; ++j)
+		{
+			keccak_batch_single(istate, rate, domain, enc, enclen, outputs[index[j]], outlen, messages[index[j]], msglens[index[j]]);
+		}
 	}
-#endif
 }
+
 #endif
 
-static void kpa_store_state(qsc_kpa_state* ctx)
+static void keccak_batch_compute(const uint64_t* istate, size_t rate, uint8_t domain, const uint8_t* enc, size_t enclen,
+	uint8_t* const* outputs, size_t outlen, const uint8_t* const* messages, const size_t* msglens, size_t count)
 {
-	assert(ctx != NULL);
+#if (KECCAK_BATCH_LANES > 1U)
+	size_t bindex[KECCAK_BATCH_BUCKETS][KECCAK_BATCH_LANES];
+	size_t bblocks[KECCAK_BATCH_BUCKETS];
+	size_t bcount[KECCAK_BATCH_BUCKETS];
+	size_t nblocks;
+	size_t slot;
+	size_t used;
+
+	used = 0;
+
+	/* messages are bucketed by their padded block count, and a bucket is hashed across the
+	   lanes as soon as it fills; when every bucket is in use, an empty bucket is reassigned,
+	   or failing that the fullest partial bucket is flushed to make room */
+	for (size_t i = 0; i < count; ++i)
+	{
+		nblocks = keccak_batch_block_count(msglens[i], enclen, rate);
+		slot = used;
 
-#if defined(QSC_SYSTEM_HAS_AVX512)
+		for (size_t s = 0; s < used; ++s)
+		{
+			if (bblocks[s] == nblocks)
+			{
+				slot = s;
+				break;
+			}
+		}
 
-	uint64_t tmp[8] = { 0 };
+		if (slot == used)
+		{
+			if (used == KECCAK_BATCH_BUCKETS)
+			{
+				slot = 0;
 
-	for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
-	{
-		_mm512_storeu_si512((__m512i*)tmp, ctx->statew[i]);
-		ctx->state[0][i] = tmp[0];
-		ctx->state[1][i] = tmp[1];
-		ctx->state[2][i] = tmp[2];
-		ctx->state[3][i] = tmp[3];
-		ctx->state[4][i] = tmp[4];
-		ctx->state[5][i] = tmp[5];
-		ctx->state[6][i] = tmp[6];
-		ctx->state[7][i] = tmp[7];
-	}
+				for (size_t s = 1; s < used; ++s)
+				{
+					if (bcount[s] == 0 || (bcount[slot] != 0 && bcount[s] > bcount[slot]))
+					{
+						slot = s;
+					}
+				}
 
-#elif defined(QSC_SYSTEM_HAS_AVX2)
+				keccak_batch_dispatch(istate, rate, domain, enc, enclen, outputs, outlen, messages, msglens, bindex[slot], bcount[slot], bblocks[slot]);
+			}
+			else
+			{
+				++used;
+			}
 
-	QSC_ALIGN(32) uint64_t tmp[4] = { 0 };
+			bblocks[slot] = nblocks;
+			bcount[slot] = 0;
+		}
 
-	for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
-	{
-		_mm256_storeu_si256((__m256i*)tmp, ctx->statew[0][i]);
-		ctx->state[0][i] = tmp[0];
-		ctx->state[1][i] = tmp[1];
-		ctx->state[2][i] = tmp[2];
-		ctx->state[3][i] = tmp[3];
-		_mm256_storeu_si256((__m256i*)tmp, ctx->statew[1][i]);
-		ctx->state[4][i] = tmp[0];
-		ctx->state[5][i] = tmp[1];
-		ctx->state[6][i] = tmp[2];
-		ctx->state[7][i] = tmp[3];
+		bindex[slot][bcount[slot]] = i;
+		++bcount[slot];
+
+		if (bcount[slot] == KECCAK_BATCH_LANES)
+		{
+			keccak_batch_dispatch(istate, rate, domain, enc, enclen, outputs, outlen, messages, msglens, bindex[slot], bcount[slot], nblocks);
+			bcount[slot] = 0;
+		}
 	}
 
+	/* flush the partially filled buckets */
+	for (size_t s = 0; s < used; ++s)
+	{
+		keccak_batch_dispatch(istate, rate, domain, enc, enclen, outputs, outlen, messages, msglens, bindex[s], bcount[s], bblocks[s]);
+	}
+#else
+	for (size_t i = 0; i < count; ++i)
+	{
+		keccak_batch_single(istate, rate, domain, enc, enclen, outputs[i], outlen, messages[i], msglens[i]);
+	}
 #endif
 }
 
-#endif
-
-void qsc_kpa_dispose(qsc_kpa_state* ctx)
+void qsc_sha3_compute256_batch(uint8_t* const* outputs, const uint8_t* const* messages, const size_t* msglens, size_t count)
 {
-	assert(ctx != NULL);
+	assert(outputs != NULL);
+	assert(messages != NULL);
+	assert(msglens != NULL);
 
-	if (ctx != NULL)
-	{
-		qsc_memutils_clear((uint8_t*)ctx->state, sizeof(ctx->state));
-		qsc_memutils_clear(ctx->buffer, sizeof(ctx->buffer));
-		ctx->position = 0;
-		ctx->processed = 0;
-		ctx->rate = 0;
+	uint64_t istate[QSC_KECCAK_STATE_SIZE] = { 0 };
 
-#if defined(QSC_KPA_AVX_PARALLEL)
-		qsc_memutils_clear((uint8_t*)ctx->statew, sizeof(ctx->statew));
-#endif
+	if (outputs != NULL && messages != NULL && msglens != NULL)
+	{
+		keccak_batch_compute(istate, (size_t)qsc_keccak_rate_256, QSC_KECCAK_SHA3_DOMAIN_ID, NULL, 0, outputs, QSC_SHA3_256_HASH_SIZE, messages, msglens, count);
 	}
 }
 
-void qsc_kpa_finalize(qsc_kpa_state* ctx, uint8_t* output, size_t outlen)
+void qsc_shake256_batch(uint8_t* const* outputs, size_t outlen, const uint8_t* const* messages, const size_t* msglens, size_t count)
 {
-	assert(ctx != NULL);
-	assert(output != NULL);
-	assert(outlen != 0);
-
-	const size_t HASHLEN = (ctx->rate == QSC_KECCAK_512_RATE) ?
-		KPA_LEAF_HASH512 : (ctx->rate == QSC_KECCAK_256_RATE) ?
-		KPA_LEAF_HASH256 : KPA_LEAF_HASH128;
+	assert(outputs != NULL);
+	assert(messages != NULL);
+	assert(msglens != NULL);
 
-	uint8_t fbuf[QSC_KPA_PARALLELISM * KPA_LEAF_HASH512] = { 0 };
-	uint64_t pstate[QSC_KECCAK_STATE_SIZE] = { 0 };
-	uint8_t prcb[2 * sizeof(uint64_t)] = { 0 };
-	size_t bitlen;
+	uint64_t istate[QSC_KECCAK_STATE_SIZE] = { 0 };
 
-	/* clear unused buffer */
-	if (ctx->position != 0)
+	if (outputs != NULL && messages != NULL && msglens != NULL)
 	{
-		qsc_memutils_clear((ctx->buffer + ctx->position), sizeof(ctx->buffer) - ctx->position);
-		kpa_fast_absorbx8(ctx, ctx->buffer);
-		kpa_permutex8(ctx);
+		keccak_batch_compute(istate, (size_t)qsc_keccak_rate_256, QSC_KECCAK_SHAKE_DOMAIN_ID, NULL, 0, outputs, outlen, messages, msglens, count);
 	}
+}
 
-	/* set processed counter to final position */
-	ctx->processed += ctx->position;
+void qsc_kmac256_batch(uint8_t* const* outputs, size_t outlen, const uint8_t* const* messages, const size_t* msglens, size_t count,
+	const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen)
+{
+	assert(outputs != NULL);
+	assert(messages != NULL);
+	assert(msglens != NULL);
+	assert(key != NULL);
 
-#if defined(QSC_KPA_AVX_PARALLEL)
-	kpa_store_state(ctx);
-#endif
+	qsc_keccak_state ctx;
+	uint8_t enc[sizeof(size_t) + 1] = { 0 };
+	size_t enclen;
 
-	/* collect leaf node hashes */
-	for (size_t i = 0; i < QSC_KPA_PARALLELISM; ++i)
+	if (outputs != NULL && messages != NULL && msglens != NULL && key != NULL)
 	{
-		/* copy each of the leaf hashes to the buffer */
-		qsc_memutils_copy((fbuf + (i * HASHLEN)), (uint8_t*)ctx->state[i], HASHLEN);
+		qsc_kmac_initialize(&ctx, qsc_keccak_rate_256, key, keylen, custom, custlen);
+		enclen = keccak_right_encode(enc, outlen * 8);
+		keccak_batch_compute(ctx.state, (size_t)qsc_keccak_rate_256, QSC_KECCAK_KMAC_DOMAIN_ID, enc, enclen, outputs, outlen, messages, msglens, count);
+		qsc_keccak_dispose(&ctx);
 	}
+}
 
-	/* absorb the leaves into the root state and permute */
-	kpa_absorb_leaves(pstate, ctx->rate, fbuf, QSC_KPA_PARALLELISM * HASHLEN);
-
-	/* clear buffer */
-	qsc_memutils_clear(ctx->buffer, sizeof(ctx->buffer));
+/* KMAC prefix */
 
-	/* add total processed bytes and output length to padding string */
-	bitlen = keccak_right_encode(prcb, outlen * 8);
-	bitlen += keccak_right_encode((prcb + bitlen), ctx->processed * 8);
-	/* copy to buffer */
-	qsc_memutils_copy(ctx->buffer, prcb, bitlen);
+void qsc_kmac_prefix_initialize(qsc_kmac_prefix_state* pfx, qsc_keccak_rate rate, const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen)
+{
+	assert(pfx != NULL);
+	assert(key != NULL);
 
-	/* add the domain id */
-	ctx->buffer[bitlen] = QSC_KECCAK_KPA_DOMAIN_ID;
-	/* clamp the last byte */
-	ctx->buffer[(size_t)ctx->rate - 1] |= 128U;
+	if (pfx != NULL && key != NULL)
+	{
+		qsc_kmac_initialize(&pfx->kstate, rate, key, keylen, custom, custlen);
+		pfx->rate = rate;
+	}
+}
 
-	/* absorb the buffer into parent state */
-	keccak_fast_absorb(pstate, ctx->buffer, (size_t)ctx->rate);
+void qsc_kmac_prefix_clone(const qsc_kmac_prefix_state* pfx, qsc_keccak_state* ctx)
+{
+	assert(pfx != NULL);
+	assert(ctx != NULL);
 
-	/* squeeze blocks to produce the output hash */
-	while (outlen >= (size_t)ctx->rate)
+	if (pfx != NULL && ctx != NULL)
 	{
-		kpa_squeezeblocks(pstate, ctx->buffer, 1, ctx->rate);
-		qsc_memutils_copy(output, ctx->buffer, ctx->rate);
-		output += ctx->rate;
-		outlen -= ctx->rate;
+		qsc_memutils_copy(ctx, &pfx->kstate, sizeof(qsc_keccak_state));
 	}
+}
 
-	/* add unaligned hash bytes */
-	if (outlen > 0)
+void qsc_kmac_prefix_compute(const qsc_kmac_prefix_state* pfx, uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen)
+{
+	assert(pfx != NULL);
+	assert(output != NULL);
+	assert(message != NULL);
+
+	qsc_keccak_state ctx;
+
+	if (pfx != NULL && output != NULL && message != NULL)
 	{
-		kpa_squeezeblocks(pstate, ctx->buffer, 1, ctx->rate);
-		qsc_memutils_copy(output, ctx->buffer, outlen);
+		qsc_kmac_prefix_clone(pfx, &ctx);
+		qsc_kmac_update(&ctx, pfx->rate, message, msglen);
+		qsc_kmac_finalize(&ctx, pfx->rate, output, outlen);
+		qsc_keccak_dispose(&ctx);
 	}
-
-	/* reset the buffer and counters */
-	qsc_memutils_clear(ctx->buffer, sizeof(ctx->buffer));
-	ctx->position = 0;
-	ctx->processed = 0;
 }
 
-void qsc_kpa_initialize(qsc_kpa_state* ctx, const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen)
+void qsc_kmac_prefix_compute_batch(const qsc_kmac_prefix_state* pfx, uint8_t* const* outputs, size_t outlen, const uint8_t* const* messages, const size_t* msglens, size_t count)
 {
-	assert(ctx != NULL);
-	assert(key != NULL);
-
-	uint64_t tmps[QSC_KECCAK_STATE_SIZE] = { 0 };
-	uint8_t pad[QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
-	uint8_t algb[8] = { 0x00, 0x00, 0x4B, 0x42, 0x41, 0xAD, 0x31, 0x32 };
-	uint64_t algn;
-	size_t oft;
-	size_t i;
+	assert(pfx != NULL);
+	assert(outputs != NULL);
+	assert(messages != NULL);
+	assert(msglens != NULL);
 
-	/* set state values */
-	ctx->position = 0;
-	ctx->processed = 0;
-	ctx->rate = (keylen == QSC_KPA_128_KEY_SIZE) ?
-		QSC_KECCAK_128_RATE : (keylen == QSC_KPA_256_KEY_SIZE) ?
-		QSC_KECCAK_256_RATE : QSC_KECCAK_512_RATE;
+	if (pfx != NULL && outputs != NULL && messages != NULL && msglens != NULL)
+	{
+		uint8_t enc[sizeof(size_t) + 1] = { 0 };
+		size_t enclen;
 
-	qsc_memutils_clear((uint8_t*)ctx->state, sizeof(ctx->state));
-	qsc_memutils_clear(ctx->buffer, sizeof(ctx->buffer));
+		enclen = keccak_right_encode(enc, outlen * 8);
+		keccak_batch_compute(pfx->kstate.state, (size_t)pfx->rate, QSC_KECCAK_KMAC_DOMAIN_ID, enc, enclen, outputs, outlen, messages, msglens, count);
+	}
+}
 
-	/* stage 1: add customization to state */
+void qsc_kmac_prefix_dispose(qsc_kmac_prefix_state* pfx)
+{
+	assert(pfx != NULL);
 
-	if (custlen != 0)
+	if (pfx != NULL)
 	{
-		oft = keccak_left_encode(pad, ctx->rate);
-		oft += keccak_left_encode((pad + oft), custlen * 8);
+		qsc_keccak_dispose(&pfx->kstate);
+		pfx->rate = qsc_keccak_rate_none;
+	}
+}
 
-		for (i = 0; i < custlen; ++i)
-		{
-			if (oft == (size_t)ctx->rate)
-			{
-				keccak_fast_absorb(tmps, pad, ctx->rate);
-				qsc_keccak_permute_p1600c(tmps, QSC_KPA_ROUNDS);
-				oft = 0;
-			}
+/* KPA */
 
-			pad[oft] = custom[i];
-			++oft;
-		}
+static void kpa_absorb_leaves(uint64_t* state, qsc_keccak_rate rate, const uint8_t* input, size_t inplen)
+{
+	assert(state != NULL);
+	assert(input != NULL);
 
-		if (oft != 0)
+	while (inplen >= (size_t)rate)
+	{
+#if defined(QSC_SYSTEM_IS_LITTLE_ENDIAN)
+		qsc_memutils_xor((uint8_t*)state, input, rate);
+#else
+		for (size_t i = 0; i < rate / sizeof(uint64_t); ++i)
 		{
-			/* absorb custom and name, and permute state */
-			qsc_memutils_clear((pad + oft), (size_t)ctx->rate - oft);
-			keccak_fast_absorb(tmps, pad, ctx->rate);
-			qsc_keccak_permute_p1600c(tmps, QSC_KPA_ROUNDS);
+			state[i] ^= qsc_intutils_le8to64(input + (sizeof(uint64_t) * i));
 		}
+#endif
+		qsc_keccak_permute_p1600c(state, QSC_KPA_ROUNDS);
+		inplen -= rate;
+		input += rate;
 	}
 
-	/* stage 2: add key to state  */
-
-	if (keylen != 0)
+	if (inplen != 0)
 	{
-		qsc_memutils_clear(pad, ctx->rate);
-		oft = keccak_left_encode(pad, ctx->rate);
-		oft += keccak_left_encode((pad + oft), keylen * 8);
-
-		for (i = 0; i < keylen; ++i)
+#if defined(QSC_SYSTEM_IS_LITTLE_ENDIAN)
+		qsc_memutils_xor((uint8_t*)state, input, inplen);
+#else
+		for (size_t i = 0; i < inplen / sizeof(uint64_t); ++i)
 		{
-			if (oft == (size_t)ctx->rate)
-			{
-				keccak_fast_absorb(tmps, pad, ctx->rate);
-				qsc_keccak_permute_p1600c(tmps, QSC_KPA_ROUNDS);
-				oft = 0;
-			}
-
-			pad[oft] = key[i];
-			++oft;
+			state[i] ^= qsc_intutils_le8to64(input + (sizeof(uint64_t) * i));
 		}
+#endif
 
-		if (oft != 0)
-		{
-			/* absorb the key and permute the state */
-			qsc_memutils_clear((pad + oft), (size_t)ctx->rate - oft);
-			keccak_fast_absorb(tmps, pad, ctx->rate);
-			qsc_keccak_permute_p1600c(tmps, QSC_KPA_ROUNDS);
-		}
+		qsc_keccak_permute_p1600c(state, QSC_KPA_ROUNDS);
 	}
+}
 
-	/* stage 3: copy state to leaf nodes, and add leaf-unique name string */
-#if defined(QSC_KPA_AVX_PARALLEL)
-
-	uint64_t tmpi[8] = { 0 };
-
-#	if defined(QSC_SYSTEM_HAS_AVX512)
+static void kpa_fast_absorbx8(qsc_kpa_state* ctx, const uint8_t* message)
+{
+	assert(ctx != NULL);
+	assert(message != NULL);
 
-	for (i = 1; i < QSC_KECCAK_STATE_SIZE; ++i)
-	{
-		ctx->statew[i] = _mm512_set1_epi64(tmps[i]);
-	}
+#if defined(QSC_SYSTEM_HAS_AVX512)
 
-	for (i = 0; i < QSC_KPA_PARALLELISM; ++i)
-	{
-		/* store the state index to the algorithm name */
-		qsc_intutils_be16to8(algb, ((uint16_t)i + 1));
-		/* copy the name to a 64-bit integer */
-		algn = qsc_intutils_be8to64(algb);
-		/* absorb the leafs unique index name */
-		tmpi[i] = tmps[0] ^ algn;
-	}
+	const size_t ROFT = (size_t)ctx->rate;
+	__m512i idx;
+	__m512i wbuf;
+	int64_t pos;
 
-	ctx->statew[0] = _mm512_loadu_si512((const __m512i*)tmpi);
+	idx = _mm512_set_epi64((int64_t)&message[7 * ROFT], (int64_t)&message[6 * ROFT], (int64_t)&message[5 * ROFT],
+		(int64_t)&message[4 * ROFT], (int64_t)&message[3 * ROFT], (int64_t)&message[2 * ROFT], (int64_t)&message[ROFT], (int64_t)&message[0]);
 
-#	else
+	pos = 0;
 
-	for (i = 1; i < QSC_KECCAK_STATE_SIZE; ++i)
+	for (size_t i = 0; i < (size_t)ctx->rate / sizeof(uint64_t); ++i)
 	{
-		ctx->statew[0][i] = _mm256_set1_epi64x(tmps[i]);
-		ctx->statew[1][i] = _mm256_set1_epi64x(tmps[i]);
+		wbuf = _mm512_i64gather_epi64(idx, (int64_t*)pos, 1);
+		pos += sizeof(uint64_t);
+		ctx->statew[i] = _mm512_xor_si512(ctx->statew[i], wbuf);
 	}
 
-	for (i = 0; i < QSC_KPA_PARALLELISM; ++i)
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+
+	const size_t ROFT = (size_t)ctx->rate;
+	QSC_ALIGN(32) uint64_t tmp[4] = { 0 };
+	__m256i wbuf;
+	const uint8_t* pmsg = message;
+
+	for (size_t i = 0; i < (size_t)ctx->rate / sizeof(uint64_t); ++i)
 	{
-		/* store the state index to the algorithm name */
-		qsc_intutils_be16to8(algb, ((uint16_t)i + 1));
-		/* copy the name to a 64-bit integer */
-		algn = qsc_intutils_be8to64(algb);
-		/* absorb the leafs unique index name */
-		tmpi[i] = tmps[0] ^ algn;
-	}
+		tmp[0] = qsc_intutils_le8to64(pmsg);
+		tmp[1] = qsc_intutils_le8to64(pmsg + ROFT);
+		tmp[2] = qsc_intutils_le8to64(pmsg + (2 * ROFT));
+		tmp[3] = qsc_intutils_le8to64(pmsg + (3 * ROFT));
+		wbuf = _mm256_loadu_si256((const __m256i*)tmp);
+		ctx->statew[0][i] = _mm256_xor_si256(ctx->statew[0][i], wbuf);
 
-	ctx->statew[0][0] = _mm256_loadu_si256((const __m256i*)tmpi);
-	ctx->statew[1][0] = _mm256_loadu_si256((const __m256i*) & tmpi[4]);
+		tmp[0] = qsc_intutils_le8to64(pmsg + (4 * ROFT));
+		tmp[1] = qsc_intutils_le8to64(pmsg + (5 * ROFT));
+		tmp[2] = qsc_intutils_le8to64(pmsg + (6 * ROFT));
+		tmp[3] = qsc_intutils_le8to64(pmsg + (7 * ROFT));
+		wbuf = _mm256_loadu_si256((const __m256i*)tmp);
+		ctx->statew[1][i] = _mm256_xor_si256(ctx->statew[1][i], wbuf);
 
-#	endif
+		pmsg += sizeof(uint64_t);
+	}
 
 #else
 
-	for (i = 0; i < QSC_KPA_PARALLELISM; ++i)
+	for (size_t i = 0; i < QSC_KPA_PARALLELISM; ++i)
 	{
-		/* store the state index to the algorithm name */
-		qsc_intutils_be16to8(algb, ((uint16_t)i + 1));
-		/* copy the name to a 64-bit integer */
-		algn = qsc_intutils_be8to64(algb);
-		/* copy the state to each leaf node */
-		qsc_memutils_copy((uint8_t*)ctx->state[i], (uint8_t*)tmps, QSC_KECCAK_STATE_BYTE_SIZE);
-		/* absorb the leafs unique index name */
-		ctx->state[i][0] ^= algn;
+#if defined(QSC_SYSTEM_IS_LITTLE_ENDIAN)
+		qsc_memutils_xor((uint8_t*)ctx->state[i], (message + (i * (size_t)ctx->rate)), (size_t)ctx->rate);
+#else
+		for (size_t j = 0; j < (size_t)ctx->rate / sizeof(uint64_t); ++j)
+		{
+			ctx->state[i][j] ^= qsc_intutils_le8to64((message + (i * (size_t)ctx->rate) + (j * sizeof(uint64_t))));
+		}
+#endif
 	}
-
 #endif
-
-	/* permute leaf nodes */
-	kpa_permutex8(ctx);
 }
 
-void qsc_kpa_update(qsc_kpa_state* ctx, const uint8_t* message, size_t msglen)
+static void kpa_permutex8(qsc_kpa_state* ctx)
 {
 	assert(ctx != NULL);
-	assert(message != NULL);
-
-	const size_t BLKLEN = (size_t)ctx->rate * QSC_KPA_PARALLELISM;
 
-	if (msglen != 0)
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	qsc_keccak_permute_p8x1600(ctx->statew, QSC_KPA_ROUNDS);
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+	qsc_keccak_permute_p4x1600(ctx->statew[0], QSC_KPA_ROUNDS);
+	qsc_keccak_permute_p4x1600(ctx->statew[1], QSC_KPA_ROUNDS);
+#else
+	for (size_t i = 0; i < QSC_KPA_PARALLELISM; ++i)
 	{
-		if (ctx->position != 0 && (ctx->position + msglen >= BLKLEN))
-		{
-			const size_t RMDLEN = BLKLEN - ctx->position;
-
-			if (RMDLEN != 0)
-			{
-				qsc_memutils_copy((ctx->buffer + ctx->position), message, RMDLEN);
-			}
+		qsc_keccak_permute_p1600c(ctx->state[i], QSC_KPA_ROUNDS);
+	}
+#endif
+}
 
-			kpa_fast_absorbx8(ctx, ctx->buffer);
-			kpa_permutex8(ctx);
-			ctx->processed += (size_t)ctx->rate * QSC_KPA_PARALLELISM;
-			ctx->position = 0;
-			message += RMDLEN;
-			msglen -= RMDLEN;
-		}
+static void kpa_squeezeblocks(uint64_t* state, uint8_t* output, size_t nblocks, qsc_keccak_rate rate)
+{
+	assert(state != NULL);
+	assert(output != NULL);
 
-		/* sequential loop through blocks */
-		while (msglen >= BLKLEN)
-		{
-			kpa_fast_absorbx8(ctx, message);
-			kpa_permutex8(ctx);
-			ctx->processed += (size_t)ctx->rate * QSC_KPA_PARALLELISM;
-			message += BLKLEN;
-			msglen -= BLKLEN;
-		}
+	while (nblocks > 0)
+	{
+		qsc_keccak_permute_p1600c(state, QSC_KPA_ROUNDS);
 
-		/* store unaligned bytes */
-		if (msglen != 0)
+#if defined(QSC_SYSTEM_IS_LITTLE_ENDIAN)
+		qsc_memutils_copy(output, (uint8_t*)state, (size_t)rate);
+#else
+		for (size_t i = 0; i < (rate >> 3); ++i)
 		{
-			qsc_memutils_copy((ctx->buffer + ctx->position), message, msglen);
-			ctx->position += msglen;
+			qsc_intutils_le64to8((output + sizeof(uint64_t) * i), state[i]);
 		}
+#endif
+		output += rate;
+		nblocks--;
 	}
 }
 
-/* parallel SHAKE x4 */
-
-#if defined(QSC_SYSTEM_HAS_AVX2)
+#if defined(QSC_KPA_AVX_PARALLEL)
 
-void qsc_keccakx4_absorb(__m256i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
-	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, 
-	size_t inplen, uint8_t domain)
+#if defined(KPA_HISTORICAL_ENABLE)
+static void kpa_load_state(qsc_kpa_state* ctx)
 {
-	assert(inp0 != NULL);
-	assert(inp1 != NULL);
-	assert(inp2 != NULL);
-	assert(inp3 != NULL);
+	/* Note: artifact, not currently used */
+	assert(ctx != NULL);
 
-    // Validate input pointers
-	if (inp0 != NULL || inp1 != NULL || inp2 != NULL || inp3 != NULL)
-	{
-		__m256i t;
-		uint64_t v0;
-		uint64_t v1;
-		uint64_t v2;
-		uint64_t v3;
-		size_t pos;
-		size_t i;
+#if defined(QSC_SYSTEM_HAS_AVX512)
 
-		pos = 0;
+	__m512i idx;
+	int64_t pos;
 
-		/* process full blocks */
-		while (inplen >= (size_t)rate)
-		{
-			for (i = 0; i < (size_t)rate / sizeof(uint64_t); ++i)
-			{
-				v0 = *(const uint64_t*)(inp0 + pos);
-				v1 = *(const uint64_t*)(inp1 + pos);
-				v2 = *(const uint64_t*)(inp2 + pos);
-				v3 = *(const uint64_t*)(inp3 + pos);
+	idx = _mm512_set_epi64((int64_t)&ctx->state[7][0], (int64_t)&ctx->state[6][0], (int64_t)&ctx->state[5][0], (int64_t)&ctx->state[4][0],
+		(int64_t)&ctx->state[3][0], (int64_t)&ctx->state[2][0], (int64_t)&ctx->state[1][0], (int64_t)&ctx->state[0][0]);
 
-				t = _mm256_set_epi64x(v3, v2, v1, v0);
-				state[i] = _mm256_xor_si256(state[i], t);
+	pos = 0;
 
-				pos += sizeof(uint64_t);
-			}
+	for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		ctx->statew[i] = _mm512_i64gather_epi64(idx, (int64_t*)pos, 1);
+		pos += sizeof(uint64_t);
+	}
 
-			qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
-			inplen -= rate;
-		}
+#elif defined(QSC_SYSTEM_HAS_AVX2)
 
-		i = 0;
+	QSC_ALIGN(32) uint64_t tmp[4] = { 0 };
 
-		/* process remaining input */
-		while (inplen >= sizeof(uint64_t))
-		{
-			v0 = *(const uint64_t*)(inp0 + pos);
-			v1 = *(const uint64_t*)(inp1 + pos);
-			v2 = *(const uint64_t*)(inp2 + pos);
-			v3 = *(const uint64_t*)(inp3 + pos);
+	for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		tmp[0] = ctx->state[0][i];
+		tmp[1] = ctx->state[1][i];
+		tmp[2] = ctx->state[2][i];
+		tmp[3] = ctx->state[3][i];
+		ctx->statew[0][i] = _mm256_loadu_si256((const __m256i*)tmp);
+		tmp[0] = ctx->state[4][i];
+		tmp[1] = ctx->state[5][i];
+		tmp[2] = ctx->state[6][i];
+		tmp[3] = ctx->state[7][i];
+		ctx->statew[1][i] = _mm256_loadu_si256((const __m256i*)tmp);
+	}
+#endif
+}
+#endif
 
-			t = _mm256_set_epi64x(v3, v2, v1, v0);
-			state[i] = _mm256_xor_si256(state[i], t);
+static void kpa_store_state(qsc_kpa_state* ctx)
+{
+	assert(ctx != NULL);
 
-			++i;
-			pos += sizeof(uint64_t);
-			inplen -= sizeof(uint64_t);
-		}
+#if defined(QSC_SYSTEM_HAS_AVX512)
 
-		/* partial block */
-		if (inplen != 0)
-		{
-			v0 = 0;
-			v1 = 0;
-			v2 = 0;
-			v3 = 0;
+	uint64_t tmp[8] = { 0 };
 
-			/* copy remaining bytes into temporary variables */
-			for (size_t j = 0; j < inplen; ++j)
-			{
-				((uint8_t*)&v0)[j] = inp0[pos + j];
-				((uint8_t*)&v1)[j] = inp1[pos + j];
-				((uint8_t*)&v2)[j] = inp2[pos + j];
-				((uint8_t*)&v3)[j] = inp3[pos + j];
-			}
+	for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		_mm512_storeu_si512((__m512i*)tmp, ctx->statew[i]);
+		ctx->state[0][i] = tmp[0];
+		ctx->state[1][i] = tmp[1];
+		ctx->state[2][i] = tmp[2];
+		ctx->state[3][i] = tmp[3];
+		ctx->state[4][i] = tmp[4];
+		ctx->state[5][i] = tmp[5];
+		ctx->state[6][i] = tmp[6];
+		ctx->state[7][i] = tmp[7];
+	}
 
-			t = _mm256_set_epi64x(v3, v2, v1, v0);
-			state[i] = _mm256_xor_si256(state[i], t);
-		}
+#elif defined(QSC_SYSTEM_HAS_AVX2)
 
-		/* apply domain separation and padding */
-		t = _mm256_set1_epi64x((int64_t)domain << (sizeof(uint64_t) * inplen));
-		state[i] = _mm256_xor_si256(state[i], t);
-		t = _mm256_set1_epi64x(1ULL << 63);
-		state[(rate / sizeof(uint64_t)) - 1] = _mm256_xor_si256(state[(rate / sizeof(uint64_t)) - 1], t);
+	QSC_ALIGN(32) uint64_t tmp[4] = { 0 };
+
+	for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		_mm256_storeu_si256((__m256i*)tmp, ctx->statew[0][i]);
+		ctx->state[0][i] = tmp[0];
+		ctx->state[1][i] = tmp[1];
+		ctx->state[2][i] = tmp[2];
+		ctx->state[3][i] = tmp[3];
+		_mm256_storeu_si256((__m256i*)tmp, ctx->statew[1][i]);
+		ctx->state[4][i] = tmp[0];
+		ctx->state[5][i] = tmp[1];
+		ctx->state[6][i] = tmp[2];
+		ctx->state[7][i] = tmp[3];
 	}
+
+#endif
 }
 
-void qsc_keccakx4_absorb_aligned(__m256i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
-	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen, uint8_t domain)
+#endif
+
+void qsc_kpa_dispose(qsc_kpa_state* ctx)
 {
-	assert(inp0 != NULL);
-	assert(inp1 != NULL);
-	assert(inp2 != NULL);
-	assert(inp3 != NULL);
+	assert(ctx != NULL);
 
-	__m256i t;
-	__m256i idx = { 0 };
-	int64_t p0;
-	int64_t p1;
-	int64_t p2;
-	int64_t p3;
-	int64_t pos;
-	size_t i;
+	if (ctx != NULL)
+	{
+		qsc_memutils_clear((uint8_t*)ctx->state, sizeof(ctx->state));
+		qsc_memutils_clear(ctx->buffer, sizeof(ctx->buffer));
+		ctx->position = 0;
+		ctx->processed = 0;
+		ctx->rate = 0;
 
-	pos = 0;
-	p0 = (int64_t)(uintptr_t)inp0;
-	p1 = (int64_t)(uintptr_t)inp1;
-	p2 = (int64_t)(uintptr_t)inp2;
-	p3 = (int64_t)(uintptr_t)inp3;
+#if defined(QSC_KPA_AVX_PARALLEL)
+		qsc_memutils_clear((uint8_t*)ctx->statew, sizeof(ctx->statew));
+#endif
+	}
+}
 
-	idx = _mm256_set_epi64x(p3, p2, p1, p0);
+void qsc_kpa_finalize(qsc_kpa_state* ctx, uint8_t* output, size_t outlen)
+{
+	assert(ctx != NULL);
+	assert(output != NULL);
+	assert(outlen != 0);
 
-	while (inplen >= (size_t)rate)
-	{
-		for (i = 0; i < (size_t)rate / sizeof(uint64_t); ++i)
-		{
-			t = _mm256_i64gather_epi64((int64_t*)pos, idx, 1);
-			state[i] = _mm256_xor_si256(state[i], t);
-			pos += sizeof(uint64_t);
-		}
+	const size_t HASHLEN = (ctx->rate == QSC_KECCAK_512_RATE) ?
+		KPA_LEAF_HASH512 : (ctx->rate == QSC_KECCAK_256_RATE) ?
+		KPA_LEAF_HASH256 : KPA_LEAF_HASH128;
 
-		qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
-		inplen -= rate;
+	uint8_t fbuf[QSC_KPA_PARALLELISM * KPA_LEAF_HASH512] = { 0 };
+	uint64_t pstate[QSC_KECCAK_STATE_SIZE] = { 0 };
+	uint8_t prcb[2 * sizeof(uint64_t)] = { 0 };
+	size_t bitlen;
+
+	/* clear unused buffer */
+	if (ctx->position != 0)
+	{
+		qsc_memutils_clear((ctx->buffer + ctx->position), sizeof(ctx->buffer) - ctx->position);
+		kpa_fast_absorbx8(ctx, ctx->buffer);
+		kpa_permutex8(ctx);
 	}
 
-	i = 0;
+	/* set processed counter to final position */
+	ctx->processed += ctx->position;
 
-	while (inplen >= sizeof(uint64_t))
+#if defined(QSC_KPA_AVX_PARALLEL)
+	kpa_store_state(ctx);
+#endif
+
+	/* collect leaf node hashes */
+	for (size_t i = 0; i < QSC_KPA_PARALLELISM; ++i)
 	{
-		t = _mm256_i64gather_epi64((int64_t*)pos, idx, 1);
-		state[i] = _mm256_xor_si256(state[i], t);
+		/* copy each of the leaf hashes to the buffer */
+		qsc_memutils_copy((fbuf + (i * HASHLEN)), (uint8_t*)ctx->state[i], HASHLEN);
+	}
 
-		i++;
-		pos += sizeof(uint64_t);
-		inplen -= sizeof(uint64_t);
+	/* absorb the leaves into the root state and permute */
+	kpa_absorb_leaves(pstate, ctx->rate, fbuf, QSC_KPA_PARALLELISM * HASHLEN);
+
+	/* clear buffer */
+	qsc_memutils_clear(ctx->buffer, sizeof(ctx->buffer));
+
+	/* add total processed bytes and output length to padding string */
+	bitlen = keccak_right_encode(prcb, outlen * 8);
+	bitlen += keccak_right_encode((prcb + bitlen), ctx->processed * 8);
+	/* copy to buffer */
+	qsc_memutils_copy(ctx->buffer, prcb, bitlen);
+
+	/* add the domain id */
+	ctx->buffer[bitlen] = QSC_KECCAK_KPA_DOMAIN_ID;
+	/* clamp the last byte */
+	ctx->buffer[(size_t)ctx->rate - 1] |= 128U;
+
+	/* absorb the buffer into parent state */
+	keccak_fast_absorb(pstate, ctx->buffer, (size_t)ctx->rate);
+
+	/* squeeze blocks to produce the output hash */
+	while (outlen >= (size_t)ctx->rate)
+	{
+		kpa_squeezeblocks(pstate, ctx->buffer, 1, ctx->rate);
+		qsc_memutils_copy(output, ctx->buffer, ctx->rate);
+		output += ctx->rate;
+		outlen -= ctx->rate;
 	}
 
-	if (inplen != 0)
+	/* add unaligned hash bytes */
+	if (outlen > 0)
 	{
-		t = _mm256_i64gather_epi64((int64_t*)pos, idx, 1);
-		idx = _mm256_set1_epi64x((1ULL << (sizeof(uint64_t) * inplen)) - 1);
-		t = _mm256_and_si256(t, idx);
-		state[i] = _mm256_xor_si256(state[i], t);
+		kpa_squeezeblocks(pstate, ctx->buffer, 1, ctx->rate);
+		qsc_memutils_copy(output, ctx->buffer, outlen);
 	}
 
-	t = _mm256_set1_epi64x((int64_t)domain << (sizeof(uint64_t) * inplen));
-	state[i] = _mm256_xor_si256(state[i], t);
-	t = _mm256_set1_epi64x(1ULL << 63);
-	state[(rate / sizeof(uint64_t)) - 1] = _mm256_xor_si256(state[(rate / sizeof(uint64_t)) - 1], t);
+	/* reset the buffer and counters */
+	qsc_memutils_clear(ctx->buffer, sizeof(ctx->buffer));
+	ctx->position = 0;
+	ctx->processed = 0;
 }
 
-void qsc_keccakx4_squeezeblocks(__m256i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
-	uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t nblocks)
+void qsc_kpa_initialize(qsc_kpa_state* ctx, const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen)
 {
-	assert(out0 != NULL);
-	assert(out1 != NULL);
-	assert(out2 != NULL);
-	assert(out3 != NULL);
+	assert(ctx != NULL);
+	assert(key != NULL);
 
-	uint64_t f0;
-	uint64_t f1;
-	uint64_t f2;
-	uint64_t f3;
+	uint64_t tmps[QSC_KECCAK_STATE_SIZE] = { 0 };
+	uint8_t pad[QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	uint8_t algb[8] = { 0x00, 0x00, 0x4B, 0x42, 0x41, 0xAD, 0x31, 0x32 };
+	uint64_t algn;
+	size_t oft;
+	size_t i;
 
-	while (nblocks > 0)
+	/* set state values */
+	ctx->position = 0;
+	ctx->processed = 0;
+	ctx->rate = (keylen == QSC_KPA_128_KEY_SIZE) ?
+		QSC_KECCAK_128_RATE : (keylen == QSC_KPA_256_KEY_SIZE) ?
+		QSC_KECCAK_256_RATE : QSC_KECCAK_512_RATE;
+
+	qsc_memutils_clear((uint8_t*)ctx->state, sizeof(ctx->state));
+	qsc_memutils_clear(ctx->buffer, sizeof(ctx->buffer));
+
+	/* stage 1: add customization to state */
+
+	if (custlen != 0)
 	{
-		qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+		oft = keccak_left_encode(pad, ctx->rate);
+		oft += keccak_left_encode((pad + oft), custlen * 8);
 
-		for (size_t i = 0; i < (size_t)rate / sizeof(uint64_t); ++i)
+		for (i = 0; i < custlen; ++i)
 		{
-#if defined(QSC_SYSTEM_ISWIN64)
-			f0 = _mm256_extract_epi64(state[i], 0);
-			f1 = _mm256_extract_epi64(state[i], 1);
-			f2 = _mm256_extract_epi64(state[i], 2);
-			f3 = _mm256_extract_epi64(state[i], 3);
-#else
-			f0 = (uint64_t)(uint32_t)_mm256_extract_epi32(state[i], 0) | ((uint64_t)(uint32_t)_mm256_extract_epi32(state[i], 1) << 32);
-			f1 = (uint64_t)(uint32_t)_mm256_extract_epi32(state[i], 2) | ((uint64_t)(uint32_t)_mm256_extract_epi32(state[i], 3) << 32);
-			f2 = (uint64_t)(uint32_t)_mm256_extract_epi32(state[i], 4) | ((uint64_t)(uint32_t)_mm256_extract_epi32(state[i], 5) << 32);
-			f3 = (uint64_t)(uint32_t)_mm256_extract_epi32(state[i], 6) | ((uint64_t)(uint32_t)_mm256_extract_epi32(state[i], 7) << 32);
-#endif
-			qsc_intutils_le64to8(out0, f0);
-			qsc_intutils_le64to8(out1, f1);
-			qsc_intutils_le64to8(out2, f2);
-			qsc_intutils_le64to8(out3, f3);
+			if (oft == (size_t)ctx->rate)
+			{
+				keccak_fast_absorb(tmps, pad, ctx->rate);
+				qsc_keccak_permute_p1600c(tmps, QSC_KPA_ROUNDS);
+				oft = 0;
+			}
 
-			out0 += sizeof(uint64_t);
-			out1 += sizeof(uint64_t);
-			out2 += sizeof(uint64_t);
-			out3 += sizeof(uint64_t);
+			pad[oft] = custom[i];
+			++oft;
 		}
 
-		--nblocks;
+		if (oft != 0)
+		{
+			/* absorb custom and name, and permute state */
+			qsc_memutils_clear((pad + oft), (size_t)ctx->rate - oft);
+			keccak_fast_absorb(tmps, pad, ctx->rate);
+			qsc_keccak_permute_p1600c(tmps, QSC_KPA_ROUNDS);
+		}
 	}
-}
 
-#endif
+	/* stage 2: add key to state  */
 
-#if defined(QSC_SYSTEM_HAS_AVX512)
+	if (keylen != 0)
+	{
+		qsc_memutils_clear(pad, ctx->rate);
+		oft = keccak_left_encode(pad, ctx->rate);
+		oft += keccak_left_encode((pad + oft), keylen * 8);
 
-#define _mm512_extract_epi64x(b, i) ( \
-        _mm_extract_epi64(_mm512_extracti64x2_epi64(b, i / 2), i % 2))
+		for (i = 0; i < keylen; ++i)
+		{
+			if (oft == (size_t)ctx->rate)
+			{
+				keccak_fast_absorb(tmps, pad, ctx->rate);
+				qsc_keccak_permute_p1600c(tmps, QSC_KPA_ROUNDS);
+				oft = 0;
+			}
 
-void qsc_keccakx8_absorb(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
-    const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
-    const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, 
+			pad[oft] = key[i];
+			++oft;
+		}
+
+		if (oft != 0)
+		{
+			/* absorb the key and permute the state */
+			qsc_memutils_clear((pad + oft), (size_t)ctx->rate - oft);
+			keccak_fast_absorb(tmps, pad, ctx->rate);
+			qsc_keccak_permute_p1600c(tmps, QSC_KPA_ROUNDS);
+		}
+	}
+
+	/* stage 3: copy state to leaf nodes, and add leaf-unique name string */
+#if defined(QSC_KPA_AVX_PARALLEL)
+
+	uint64_t tmpi[8] = { 0 };
+
+#	if defined(QSC_SYSTEM_HAS_AVX512)
+
+	for (i = 1; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		ctx->statew[i] = _mm512_set1_epi64(tmps[i]);
+	}
+
+	for (i = 0; i < QSC_KPA_PARALLELISM; ++i)
+	{
+		/* store the state index to the algorithm name */
+		qsc_intutils_be16to8(algb, ((uint16_t)i + 1));
+		/* copy the name to a 64-bit integer */
+		algn = qsc_intutils_be8to64(algb);
+		/* absorb the leafs unique index name */
+		tmpi[i] = tmps[0] ^ algn;
+	}
+
+	ctx->statew[0] = _mm512_loadu_si512((const __m512i*)tmpi);
+
+#	else
+
+	for (i = 1; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		ctx->statew[0][i] = _mm256_set1_epi64x(tmps[i]);
+		ctx->statew[1][i] = _mm256_set1_epi64x(tmps[i]);
+	}
+
+	for (i = 0; i < QSC_KPA_PARALLELISM; ++i)
+	{
+		/* store the state index to the algorithm name */
+		qsc_intutils_be16to8(algb, ((uint16_t)i + 1));
+		/* copy the name to a 64-bit integer */
+		algn = qsc_intutils_be8to64(algb);
+		/* absorb the leafs unique index name */
+		tmpi[i] = tmps[0] ^ algn;
+	}
+
+	ctx->statew[0][0] = _mm256_loadu_si256((const __m256i*)tmpi);
+	ctx->statew[1][0] = _mm256_loadu_si256((const __m256i*) & tmpi[4]);
+
+#	endif
+
+#else
+
+	for (i = 0; i < QSC_KPA_PARALLELISM; ++i)
+	{
+		/* store the state index to the algorithm name */
+		qsc_intutils_be16to8(algb, ((uint16_t)i + 1));
+		/* copy the name to a 64-bit integer */
+		algn = qsc_intutils_be8to64(algb);
+		/* copy the state to each leaf node */
+		qsc_memutils_copy((uint8_t*)ctx->state[i], (uint8_t*)tmps, QSC_KECCAK_STATE_BYTE_SIZE);
+		/* absorb the leafs unique index name */
+		ctx->state[i][0] ^= algn;
+	}
+
+#endif
+
+	/* permute leaf nodes */
+	kpa_permutex8(ctx);
+}
+
+void qsc_kpa_update(qsc_kpa_state* ctx, const uint8_t* message, size_t msglen)
+{
+	assert(ctx != NULL);
+	assert(message != NULL);
+
+	const size_t BLKLEN = (size_t)ctx->rate * QSC_KPA_PARALLELISM;
+
+	if (msglen != 0)
+	{
+		if (ctx->position != 0 && (ctx->position + msglen >= BLKLEN))
+		{
+			const size_t RMDLEN = BLKLEN - ctx->position;
+
+			if (RMDLEN != 0)
+			{
+				qsc_memutils_copy((ctx->buffer + ctx->position), message, RMDLEN);
+			}
+
+			kpa_fast_absorbx8(ctx, ctx->buffer);
+			kpa_permutex8(ctx);
+			ctx->processed += (size_t)ctx->rate * QSC_KPA_PARALLELISM;
+			ctx->position = 0;
+			message += RMDLEN;
+			msglen -= RMDLEN;
+		}
+
+		/* sequential loop through blocks */
+		while (msglen >= BLKLEN)
+		{
+			kpa_fast_absorbx8(ctx, message);
+			kpa_permutex8(ctx);
+			ctx->processed += (size_t)ctx->rate * QSC_KPA_PARALLELISM;
+			message += BLKLEN;
+			msglen -= BLKLEN;
+		}
+
+		/* store unaligned bytes */
+		if (msglen != 0)
+		{
+			qsc_memutils_copy((ctx->buffer + ctx->position), message, msglen);
+			ctx->position += msglen;
+		}
+	}
+}
+
+/* parallel SHAKE x4 */
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+void qsc_keccakx4_absorb(__m256i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, 
 	size_t inplen, uint8_t domain)
 {
-    // Validate input pointers
-	if (inp0 != NULL || inp1 != NULL || inp2 != NULL || inp3 != NULL ||
-		inp4 != NULL || inp5 != NULL || inp6 != NULL || inp7 != NULL) {
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
 
-		__m512i t;
+    // Validate input pointers
+	if (inp0 != NULL || inp1 != NULL || inp2 != NULL || inp3 != NULL)
+	{
+		__m256i t;
 		uint64_t v0;
 		uint64_t v1;
 		uint64_t v2;
 		uint64_t v3;
-		uint64_t v4;
-		uint64_t v5;
-		uint64_t v6;
-		uint64_t v7;
 		size_t pos;
 		size_t i;
 
@@ -5225,18 +5664,14 @@ void qsc_keccakx8_absorb(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate r
 				v1 = *(const uint64_t*)(inp1 + pos);
 				v2 = *(const uint64_t*)(inp2 + pos);
 				v3 = *(const uint64_t*)(inp3 + pos);
-				v4 = *(const uint64_t*)(inp4 + pos);
-				v5 = *(const uint64_t*)(inp5 + pos);
-				v6 = *(const uint64_t*)(inp6 + pos);
-				v7 = *(const uint64_t*)(inp7 + pos);
 
-				t = _mm512_set_epi64(v7, v6, v5, v4, v3, v2, v1, v0);
-				state[i] = _mm512_xor_si512(state[i], t);
+				t = _mm256_set_epi64x(v3, v2, v1, v0);
+				state[i] = _mm256_xor_si256(state[i], t);
 
 				pos += sizeof(uint64_t);
 			}
 
-			qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+			qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
 			inplen -= rate;
 		}
 
@@ -5249,104 +5684,79 @@ void qsc_keccakx8_absorb(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate r
 			v1 = *(const uint64_t*)(inp1 + pos);
 			v2 = *(const uint64_t*)(inp2 + pos);
 			v3 = *(const uint64_t*)(inp3 + pos);
-			v4 = *(const uint64_t*)(inp4 + pos);
-			v5 = *(const uint64_t*)(inp5 + pos);
-			v6 = *(const uint64_t*)(inp6 + pos);
-			v7 = *(const uint64_t*)(inp7 + pos);
 
-			t = _mm512_set_epi64(v7, v6, v5, v4, v3, v2, v1, v0);
-			state[i] = _mm512_xor_si512(state[i], t);
+			t = _mm256_set_epi64x(v3, v2, v1, v0);
+			state[i] = _mm256_xor_si256(state[i], t);
 
-			i++;
+			++i;
 			pos += sizeof(uint64_t);
 			inplen -= sizeof(uint64_t);
 		}
 
-		/* handle the remaining partial block */
+		/* partial block */
 		if (inplen != 0)
 		{
 			v0 = 0;
 			v1 = 0;
 			v2 = 0;
 			v3 = 0;
-			v4 = 0;
-			v5 = 0;
-			v6 = 0;
-			v7 = 0;
 
-			/* copy remaining bytes into temporary variables*/
+			/* copy remaining bytes into temporary variables */
 			for (size_t j = 0; j < inplen; ++j)
 			{
 				((uint8_t*)&v0)[j] = inp0[pos + j];
 				((uint8_t*)&v1)[j] = inp1[pos + j];
 				((uint8_t*)&v2)[j] = inp2[pos + j];
 				((uint8_t*)&v3)[j] = inp3[pos + j];
-				((uint8_t*)&v4)[j] = inp4[pos + j];
-				((uint8_t*)&v5)[j] = inp5[pos + j];
-				((uint8_t*)&v6)[j] = inp6[pos + j];
-				((uint8_t*)&v7)[j] = inp7[pos + j];
 			}
 
-			t = _mm512_set_epi64(v7, v6, v5, v4, v3, v2, v1, v0);
-			state[i] = _mm512_xor_si512(state[i], t);
+			t = _mm256_set_epi64x(v3, v2, v1, v0);
+			state[i] = _mm256_xor_si256(state[i], t);
 		}
 
 		/* apply domain separation and padding */
-		t = _mm512_set1_epi64((int64_t)domain << (sizeof(uint64_t) * inplen));
-		state[i] = _mm512_xor_si512(state[i], t);
-		t = _mm512_set1_epi64(1ULL << 63);
-		state[(rate / sizeof(uint64_t)) - 1] = _mm512_xor_si512(state[(rate / sizeof(uint64_t)) - 1], t);
+		t = _mm256_set1_epi64x((int64_t)domain << (sizeof(uint64_t) * inplen));
+		state[i] = _mm256_xor_si256(state[i], t);
+		t = _mm256_set1_epi64x(1ULL << 63);
+		state[(rate / sizeof(uint64_t)) - 1] = _mm256_xor_si256(state[(rate / sizeof(uint64_t)) - 1], t);
 	}
 }
 
-void qsc_keccakx8_absorb_aligned(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
-	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
-	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen, uint8_t domain)
+void qsc_keccakx4_absorb_aligned(__m256i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen, uint8_t domain)
 {
 	assert(inp0 != NULL);
 	assert(inp1 != NULL);
 	assert(inp2 != NULL);
 	assert(inp3 != NULL);
-	assert(inp4 != NULL);
-	assert(inp5 != NULL);
-	assert(inp6 != NULL);
-	assert(inp7 != NULL);
 
-	__m512i t;
-	__m512i idx;
+	__m256i t;
+	__m256i idx = { 0 };
 	int64_t p0;
 	int64_t p1;
 	int64_t p2;
 	int64_t p3;
-	int64_t p4;
-	int64_t p5;
-	int64_t p6;
-	int64_t p7;
 	int64_t pos;
 	size_t i;
 
 	pos = 0;
-	p0 = (int64_t)inp0;
-	p1 = (int64_t)inp1;
-	p2 = (int64_t)inp2;
-	p3 = (int64_t)inp3;
-	p4 = (int64_t)inp4;
-	p5 = (int64_t)inp5;
-	p6 = (int64_t)inp6;
-	p7 = (int64_t)inp7;
+	p0 = (int64_t)(uintptr_t)inp0;
+	p1 = (int64_t)(uintptr_t)inp1;
+	p2 = (int64_t)(uintptr_t)inp2;
+	p3 = (int64_t)(uintptr_t)inp3;
 
-	idx = _mm512_set_epi64(p7, p6, p5, p4, p3, p2, p1, p0);
+	idx = _mm256_set_epi64x(p3, p2, p1, p0);
 
 	while (inplen >= (size_t)rate)
 	{
 		for (i = 0; i < (size_t)rate / sizeof(uint64_t); ++i)
 		{
-			t = _mm512_i64gather_epi64(idx, (int64_t*)pos, 1);
-			state[i] = _mm512_xor_si512(state[i], t);
+			t = _mm256_i64gather_epi64((int64_t*)pos, idx, 1);
+			state[i] = _mm256_xor_si256(state[i], t);
 			pos += sizeof(uint64_t);
 		}
 
-		qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+		qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
 		inplen -= rate;
 	}
 
@@ -5354,8 +5764,8 @@ void qsc_keccakx8_absorb_aligned(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_kecca
 
 	while (inplen >= sizeof(uint64_t))
 	{
-		t = _mm512_i64gather_epi64(idx, (int64_t*)pos, 1);
-		state[i] = _mm512_xor_si512(state[i], t);
+		t = _mm256_i64gather_epi64((int64_t*)pos, idx, 1);
+		state[i] = _mm256_xor_si256(state[i], t);
 
 		i++;
 		pos += sizeof(uint64_t);
@@ -5364,21 +5774,256 @@ void qsc_keccakx8_absorb_aligned(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_kecca
 
 	if (inplen != 0)
 	{
-		t = _mm512_i64gather_epi64(idx, (int64_t*)pos, 1);
-		idx = _mm512_set1_epi64((1ULL << (sizeof(uint64_t) * inplen)) - 1);
-		t = _mm512_and_si512(t, idx);
-		state[i] = _mm512_xor_si512(state[i], t);
+		t = _mm256_i64gather_epi64((int64_t*)pos, idx, 1);
+		idx = _mm256_set1_epi64x((1ULL << (sizeof(uint64_t) * inplen)) - 1);
+		t = _mm256_and_si256(t, idx);
+		state[i] = _mm256_xor_si256(state[i], t);
 	}
 
-	t = _mm512_set1_epi64((int64_t)domain << (sizeof(uint64_t) * inplen));
-	state[i] = _mm512_xor_si512(state[i], t);
-	t = _mm512_set1_epi64(1ULL << 63);
-	state[(rate / sizeof(uint64_t)) - 1] = _mm512_xor_si512(state[(rate / sizeof(uint64_t)) - 1], t);
+	t = _mm256_set1_epi64x((int64_t)domain << (sizeof(uint64_t) * inplen));
+	state[i] = _mm256_xor_si256(state[i], t);
+	t = _mm256_set1_epi64x(1ULL << 63);
+	state[(rate / sizeof(uint64_t)) - 1] = _mm256_xor_si256(state[(rate / sizeof(uint64_t)) - 1], t);
 }
 
-void qsc_keccakx8_squeezeblocks(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
-	uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, uint8_t* out4,
-	uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t nblocks)
+void qsc_keccakx4_squeezeblocks(__m256i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
+	uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t nblocks)
+{
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+
+	uint64_t f0;
+	uint64_t f1;
+	uint64_t f2;
+	uint64_t f3;
+
+	while (nblocks > 0)
+	{
+		qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+
+		for (size_t i = 0; i < (size_t)rate / sizeof(uint64_t); ++i)
+		{
+#if defined(QSC_SYSTEM_ISWIN64)
+			f0 = _mm256_extract_epi64(state[i], 0);
+			f1 = _mm256_extract_epi64(state[i], 1);
+			f2 = _mm256_extract_epi64(state[i], 2);
+			f3 = _mm256_extract_epi64(state[i], 3);
+#else
+			f0 = (uint64_t)(uint32_t)_mm256_extract_epi32(state[i], 0) | ((uint64_t)(uint32_t)_mm256_extract_epi32(state[i], 1) << 32);
+			f1 = (uint64_t)(uint32_t)_mm256_extract_epi32(state[i], 2) | ((uint64_t)(uint32_t)_mm256_extract_epi32(state[i], 3) << 32);
+			f2 = (uint64_t)(uint32_t)_mm256_extract_epi32(state[i], 4) | ((uint64_t)(uint32_t)_mm256_extract_epi32(state[i], 5) << 32);
+			f3 = (uint64_t)(uint32_t)_mm256_extract_epi32(state[i], 6) | ((uint64_t)(uint32_t)_mm256_extract_epi32(state[i], 7) << 32);
+#endif
+			qsc_intutils_le64to8(out0, f0);
+			qsc_intutils_le64to8(out1, f1);
+			qsc_intutils_le64to8(out2, f2);
+			qsc_intutils_le64to8(out3, f3);
+
+			out0 += sizeof(uint64_t);
+			out1 += sizeof(uint64_t);
+			out2 += sizeof(uint64_t);
+			out3 += sizeof(uint64_t);
+		}
+
+		--nblocks;
+	}
+}
+
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+#define _mm512_extract_epi64x(b, i) ( \
+        _mm_extract_epi64(_mm512_extracti64x2_epi64(b, i / 2), i % 2))
+
+void qsc_keccakx8_absorb(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
+    const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
+    const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, 
+	size_t inplen, uint8_t domain)
+{
+    // Validate input pointers
+	if (inp0 != NULL || inp1 != NULL || inp2 != NULL || inp3 != NULL ||
+		inp4 != NULL || inp5 != NULL || inp6 != NULL || inp7 != NULL) {
+
+		__m512i t;
+		uint64_t v0;
+		uint64_t v1;
+		uint64_t v2;
+		uint64_t v3;
+		uint64_t v4;
+		uint64_t v5;
+		uint64_t v6;
+		uint64_t v7;
+		size_t pos;
+		size_t i;
+
+		pos = 0;
+
+		/* process full blocks */
+		while (inplen >= (size_t)rate)
+		{
+			for (i = 0; i < (size_t)rate / sizeof(uint64_t); ++i)
+			{
+				v0 = *(const uint64_t*)(inp0 + pos);
+				v1 = *(const uint64_t*)(inp1 + pos);
+				v2 = *(const uint64_t*)(inp2 + pos);
+				v3 = *(const uint64_t*)(inp3 + pos);
+				v4 = *(const uint64_t*)(inp4 + pos);
+				v5 = *(const uint64_t*)(inp5 + pos);
+				v6 = *(const uint64_t*)(inp6 + pos);
+				v7 = *(const uint64_t*)(inp7 + pos);
+
+				t = _mm512_set_epi64(v7, v6, v5, v4, v3, v2, v1, v0);
+				state[i] = _mm512_xor_si512(state[i], t);
+
+				pos += sizeof(uint64_t);
+			}
+
+			qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+			inplen -= rate;
+		}
+
+		i = 0;
+
+		/* process remaining input */
+		while (inplen >= sizeof(uint64_t))
+		{
+			v0 = *(const uint64_t*)(inp0 + pos);
+			v1 = *(const uint64_t*)(inp1 + pos);
+			v2 = *(const uint64_t*)(inp2 + pos);
+			v3 = *(const uint64_t*)(inp3 + pos);
+			v4 = *(const uint64_t*)(inp4 + pos);
+			v5 = *(const uint64_t*)(inp5 + pos);
+			v6 = *(const uint64_t*)(inp6 + pos);
+			v7 = *(const uint64_t*)(inp7 + pos);
+
+			t = _mm512_set_epi64(v7, v6, v5, v4, v3, v2, v1, v0);
+			state[i] = _mm512_xor_si512(state[i], t);
+
+			i++;
+			pos += sizeof(uint64_t);
+			inplen -= sizeof(uint64_t);
+		}
+
+		/* handle the remaining partial block */
+		if (inplen != 0)
+		{
+			v0 = 0;
+			v1 = 0;
+			v2 = 0;
+			v3 = 0;
+			v4 = 0;
+			v5 = 0;
+			v6 = 0;
+			v7 = 0;
+
+			/* copy remaining bytes into temporary variables*/
+			for (size_t j = 0; j < inplen; ++j)
+			{
+				((uint8_t*)&v0)[j] = inp0[pos + j];
+				((uint8_t*)&v1)[j] = inp1[pos + j];
+				((uint8_t*)&v2)[j] = inp2[pos + j];
+				((uint8_t*)&v3)[j] = inp3[pos + j];
+				((uint8_t*)&v4)[j] = inp4[pos + j];
+				((uint8_t*)&v5)[j] = inp5[pos + j];
+				((uint8_t*)&v6)[j] = inp6[pos + j];
+				((uint8_t*)&v7)[j] = inp7[pos + j];
+			}
+
+			t = _mm512_set_epi64(v7, v6, v5, v4, v3, v2, v1, v0);
+			state[i] = _mm512_xor_si512(state[i], t);
+		}
+
+		/* apply domain separation and padding */
+		t = _mm512_set1_epi64((int64_t)domain << (sizeof(uint64_t) * inplen));
+		state[i] = _mm512_xor_si512(state[i], t);
+		t = _mm512_set1_epi64(1ULL << 63);
+		state[(rate / sizeof(uint64_t)) - 1] = _mm512_xor_si512(state[(rate / sizeof(uint64_t)) - 1], t);
+	}
+}
+
+void qsc_keccakx8_absorb_aligned(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
+	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen, uint8_t domain)
+{
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
+	assert(inp4 != NULL);
+	assert(inp5 != NULL);
+	assert(inp6 != NULL);
+	assert(inp7 != NULL);
+
+	__m512i t;
+	__m512i idx;
+	int64_t p0;
+	int64_t p1;
+	int64_t p2;
+	int64_t p3;
+	int64_t p4;
+	int64_t p5;
+	int64_t p6;
+	int64_t p7;
+	int64_t pos;
+	size_t i;
+
+	pos = 0;
+	p0 = (int64_t)inp0;
+	p1 = (int64_t)inp1;
+	p2 = (int64_t)inp2;
+	p3 = (int64_t)inp3;
+	p4 = (int64_t)inp4;
+	p5 = (int64_t)inp5;
+	p6 = (int64_t)inp6;
+	p7 = (int64_t)inp7;
+
+	idx = _mm512_set_epi64(p7, p6, p5, p4, p3, p2, p1, p0);
+
+	while (inplen >= (size_t)rate)
+	{
+		for (i = 0; i < (size_t)rate / sizeof(uint64_t); ++i)
+		{
+			t = _mm512_i64gather_epi64(idx, (int64_t*)pos, 1);
+			state[i] = _mm512_xor_si512(state[i], t);
+			pos += sizeof(uint64_t);
+		}
+
+		qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+		inplen -= rate;
+	}
+
+	i = 0;
+
+	while (inplen >= sizeof(uint64_t))
+	{
+		t = _mm512_i64gather_epi64(idx, (int64_t*)pos, 1);
+		state[i] = _mm512_xor_si512(state[i], t);
+
+		i++;
+		pos += sizeof(uint64_t);
+		inplen -= sizeof(uint64_t);
+	}
+
+	if (inplen != 0)
+	{
+		t = _mm512_i64gather_epi64(idx, (int64_t*)pos, 1);
+		idx = _mm512_set1_epi64((1ULL << (sizeof(uint64_t) * inplen)) - 1);
+		t = _mm512_and_si512(t, idx);
+		state[i] = _mm512_xor_si512(state[i], t);
+	}
+
+	t = _mm512_set1_epi64((int64_t)domain << (sizeof(uint64_t) * inplen));
+	state[i] = _mm512_xor_si512(state[i], t);
+	t = _mm512_set1_epi64(1ULL << 63);
+	state[(rate / sizeof(uint64_t)) - 1] = _mm512_xor_si512(state[(rate / sizeof(uint64_t)) - 1], t);
+}
+
+void qsc_keccakx8_squeezeblocks(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
+	uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, uint8_t* out4,
+	uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t nblocks)
 {
 	assert(out0 != NULL);
 	assert(out1 != NULL);
@@ -5443,289 +6088,996 @@ void qsc_keccakx8_squeezeblocks(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_keccak
 			qsc_intutils_le64to8(out6, f6);
 			qsc_intutils_le64to8(out7, f7);
 
-			out0 += sizeof(uint64_t);
-			out1 += sizeof(uint64_t);
-			out2 += sizeof(uint64_t);
-			out3 += sizeof(uint64_t);
-			out4 += sizeof(uint64_t);
-			out5 += sizeof(uint64_t);
-			out6 += sizeof(uint64_t);
-			out7 += sizeof(uint64_t);
-		}
+			out0 += sizeof(uint64_t);
+			out1 += sizeof(uint64_t);
+			out2 += sizeof(uint64_t);
+			out3 += sizeof(uint64_t);
+			out4 += sizeof(uint64_t);
+			out5 += sizeof(uint64_t);
+			out6 += sizeof(uint64_t);
+			out7 += sizeof(uint64_t);
+		}
+
+		--nblocks;
+	}
+}
+
+#endif
+
+void qsc_shake_128x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen)
+{
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(inplen != 0);
+	assert(outlen != 0);
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+	size_t i;
+	size_t nblocks = outlen / QSC_KECCAK_128_RATE;
+	uint8_t t[4][QSC_KECCAK_128_RATE] = { 0 };
+	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+
+	qsc_keccakx4_absorb(state, qsc_keccak_rate_128, inp0, inp1, inp2, inp3, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
+
+	if (outlen >= QSC_KECCAK_128_RATE)
+	{
+		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_128, out0, out1, out2, out3, nblocks);
+
+		out0 += nblocks * QSC_KECCAK_128_RATE;
+		out1 += nblocks * QSC_KECCAK_128_RATE;
+		out2 += nblocks * QSC_KECCAK_128_RATE;
+		out3 += nblocks * QSC_KECCAK_128_RATE;
+		outlen -= nblocks * QSC_KECCAK_128_RATE;
+	}
+
+	if (outlen != 0)
+	{
+		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_128, t[0], t[1], t[2], t[3], 1);
+
+		for (i = 0; i < outlen; ++i)
+		{
+			out0[i] = t[0][i];
+			out1[i] = t[1][i];
+			out2[i] = t[2][i];
+			out3[i] = t[3][i];
+		}
+	}
+
+#else
+
+	qsc_shake128_compute(out0, outlen, inp0, inplen);
+	qsc_shake128_compute(out1, outlen, inp1, inplen);
+	qsc_shake128_compute(out2, outlen, inp2, inplen);
+	qsc_shake128_compute(out3, outlen, inp3, inplen);
+
+#endif
+}
+
+void qsc_shake_256x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen)
+{
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(inplen != 0);
+	assert(outlen != 0);
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+	size_t nblocks = outlen / QSC_KECCAK_256_RATE;
+	uint8_t t[4][QSC_KECCAK_256_RATE] = { 0 };
+	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+
+	qsc_keccakx4_absorb(state, qsc_keccak_rate_256, inp0, inp1, inp2, inp3, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
+
+	if (outlen >= QSC_KECCAK_256_RATE)
+	{
+		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_256, out0, out1, out2, out3, nblocks);
+
+		out0 += nblocks * QSC_KECCAK_256_RATE;
+		out1 += nblocks * QSC_KECCAK_256_RATE;
+		out2 += nblocks * QSC_KECCAK_256_RATE;
+		out3 += nblocks * QSC_KECCAK_256_RATE;
+		outlen -= nblocks * QSC_KECCAK_256_RATE;
+	}
+
+	if (outlen != 0)
+	{
+		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_256, t[0], t[1], t[2], t[3], 1);
+
+		for (size_t i = 0; i < outlen; ++i)
+		{
+			out0[i] = t[0][i];
+			out1[i] = t[1][i];
+			out2[i] = t[2][i];
+			out3[i] = t[3][i];
+		}
+	}
+
+#else
+
+	qsc_shake256_compute(out0, outlen, inp0, inplen);
+	qsc_shake256_compute(out1, outlen, inp1, inplen);
+	qsc_shake256_compute(out2, outlen, inp2, inplen);
+	qsc_shake256_compute(out3, outlen, inp3, inplen);
+
+#endif
+}
+
+void qsc_shake_512x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen)
+{
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(inplen != 0);
+	assert(outlen != 0);
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+	size_t nblocks = outlen / QSC_KECCAK_512_RATE;
+	uint8_t t[4][QSC_KECCAK_512_RATE] = { 0 };
+	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+
+	qsc_keccakx4_absorb(state, qsc_keccak_rate_512, inp0, inp1, inp2, inp3, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
+
+	if (outlen >= QSC_KECCAK_512_RATE)
+	{
+		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_512, out0, out1, out2, out3, nblocks);
+
+		out0 += nblocks * QSC_KECCAK_512_RATE;
+		out1 += nblocks * QSC_KECCAK_512_RATE;
+		out2 += nblocks * QSC_KECCAK_512_RATE;
+		out3 += nblocks * QSC_KECCAK_512_RATE;
+		outlen -= nblocks * QSC_KECCAK_512_RATE;
+	}
+
+	if (outlen != 0)
+	{
+		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_512, t[0], t[1], t[2], t[3], 1);
+
+		for (size_t i = 0; i < outlen; ++i)
+		{
+			out0[i] = t[0][i];
+			out1[i] = t[1][i];
+			out2[i] = t[2][i];
+			out3[i] = t[3][i];
+		}
+	}
+
+#else
+
+	qsc_shake512_compute(out0, outlen, inp0, inplen);
+	qsc_shake512_compute(out1, outlen, inp1, inplen);
+	qsc_shake512_compute(out2, outlen, inp2, inplen);
+	qsc_shake512_compute(out3, outlen, inp3, inplen);
+
+#endif
+}
+
+/* parallel shake x8 */
+
+void qsc_shake_128x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
+	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen)
+{
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
+	assert(inp4 != NULL);
+	assert(inp5 != NULL);
+	assert(inp6 != NULL);
+	assert(inp7 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(out4 != NULL);
+	assert(out5 != NULL);
+	assert(out6 != NULL);
+	assert(out7 != NULL);
+	assert(inplen != 0);
+	assert(outlen != 0);
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	size_t nblocks = outlen / QSC_KECCAK_128_RATE;
+	uint8_t t[8][QSC_KECCAK_128_RATE] = { 0 };
+	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+
+	qsc_keccakx8_absorb(state, qsc_keccak_rate_128, inp0, inp1, inp2, inp3, inp4, inp5, inp6, inp7, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
+
+	if (outlen >= QSC_KECCAK_128_RATE)
+	{
+		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_128, out0, out1, out2, out3, out4, out5, out6, out7, nblocks);
+
+		out0 += nblocks * QSC_KECCAK_128_RATE;
+		out1 += nblocks * QSC_KECCAK_128_RATE;
+		out2 += nblocks * QSC_KECCAK_128_RATE;
+		out3 += nblocks * QSC_KECCAK_128_RATE;
+		out4 += nblocks * QSC_KECCAK_128_RATE;
+		out5 += nblocks * QSC_KECCAK_128_RATE;
+		out6 += nblocks * QSC_KECCAK_128_RATE;
+		out7 += nblocks * QSC_KECCAK_128_RATE;
+		outlen -= nblocks * QSC_KECCAK_128_RATE;
+	}
+
+	if (outlen != 0)
+	{
+		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_128, t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7], 1);
+
+		for (size_t i = 0; i < outlen; ++i)
+		{
+			out0[i] = t[0][i];
+			out1[i] = t[1][i];
+			out2[i] = t[2][i];
+			out3[i] = t[3][i];
+			out4[i] = t[4][i];
+			out5[i] = t[5][i];
+			out6[i] = t[6][i];
+			out7[i] = t[7][i];
+		}
+	}
+
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+
+	qsc_shake_128x4(out0, out1, out2, out3, outlen, inp0, inp1, inp2, inp3, inplen);
+	qsc_shake_128x4(out4, out5, out6, out7, outlen, inp4, inp5, inp6, inp7, inplen);
+
+#else
+
+	qsc_shake128_compute(out0, outlen, inp0, inplen);
+	qsc_shake128_compute(out1, outlen, inp1, inplen);
+	qsc_shake128_compute(out2, outlen, inp2, inplen);
+	qsc_shake128_compute(out3, outlen, inp3, inplen);
+	qsc_shake128_compute(out4, outlen, inp4, inplen);
+	qsc_shake128_compute(out5, outlen, inp5, inplen);
+	qsc_shake128_compute(out6, outlen, inp6, inplen);
+	qsc_shake128_compute(out7, outlen, inp7, inplen);
+
+#endif
+}
+
+void qsc_shake_256x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
+	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen)
+{
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
+	assert(inp4 != NULL);
+	assert(inp5 != NULL);
+	assert(inp6 != NULL);
+	assert(inp7 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(out4 != NULL);
+	assert(out5 != NULL);
+	assert(out6 != NULL);
+	assert(out7 != NULL);
+	assert(inplen != 0);
+	assert(outlen != 0);
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	size_t nblocks = outlen / QSC_KECCAK_256_RATE;
+	uint8_t t[8][QSC_KECCAK_256_RATE] = { 0 };
+	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+
+	qsc_keccakx8_absorb(state, qsc_keccak_rate_256, inp0, inp1, inp2, inp3, inp4, inp5, inp6, inp7, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
+
+	if (outlen >= QSC_KECCAK_256_RATE)
+	{
+		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_256, out0, out1, out2, out3, out4, out5, out6, out7, nblocks);
+
+		out0 += nblocks * QSC_KECCAK_256_RATE;
+		out1 += nblocks * QSC_KECCAK_256_RATE;
+		out2 += nblocks * QSC_KECCAK_256_RATE;
+		out3 += nblocks * QSC_KECCAK_256_RATE;
+		out4 += nblocks * QSC_KECCAK_256_RATE;
+		out5 += nblocks * QSC_KECCAK_256_RATE;
+		out6 += nblocks * QSC_KECCAK_256_RATE;
+		out7 += nblocks * QSC_KECCAK_256_RATE;
+		outlen -= nblocks * QSC_KECCAK_256_RATE;
+	}
+
+	if (outlen != 0)
+	{
+		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_256, t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7], 1);
+
+		for (size_t i = 0; i < outlen; ++i)
+		{
+			out0[i] = t[0][i];
+			out1[i] = t[1][i];
+			out2[i] = t[2][i];
+			out3[i] = t[3][i];
+			out4[i] = t[4][i];
+			out5[i] = t[5][i];
+			out6[i] = t[6][i];
+			out7[i] = t[7][i];
+		}
+	}
+
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+
+	qsc_shake_256x4(out0, out1, out2, out3, outlen, inp0, inp1, inp2, inp3, inplen);
+	qsc_shake_256x4(out4, out5, out6, out7, outlen, inp4, inp5, inp6, inp7, inplen);
+
+#else
+
+	qsc_shake256_compute(out0, outlen, inp0, inplen);
+	qsc_shake256_compute(out1, outlen, inp1, inplen);
+	qsc_shake256_compute(out2, outlen, inp2, inplen);
+	qsc_shake256_compute(out3, outlen, inp3, inplen);
+	qsc_shake256_compute(out4, outlen, inp4, inplen);
+	qsc_shake256_compute(out5, outlen, inp5, inplen);
+	qsc_shake256_compute(out6, outlen, inp6, inplen);
+	qsc_shake256_compute(out7, outlen, inp7, inplen);
+
+#endif
+}
+
+void qsc_shake_512x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
+	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen)
+{
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
+	assert(inp4 != NULL);
+	assert(inp5 != NULL);
+	assert(inp6 != NULL);
+	assert(inp7 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(out4 != NULL);
+	assert(out5 != NULL);
+	assert(out6 != NULL);
+	assert(out7 != NULL);
+	assert(inplen != 0);
+	assert(outlen != 0);
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	size_t nblocks = outlen / QSC_KECCAK_512_RATE;
+	uint8_t t[8][QSC_KECCAK_512_RATE] = { 0 };
+	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+
+	qsc_keccakx8_absorb(state, qsc_keccak_rate_512, inp0, inp1, inp2, inp3, inp4, inp5, inp6, inp7, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
+
+	if (outlen >= QSC_KECCAK_512_RATE)
+	{
+		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_512, out0, out1, out2, out3, out4, out5, out6, out7, nblocks);
+
+		out0 += nblocks * QSC_KECCAK_512_RATE;
+		out1 += nblocks * QSC_KECCAK_512_RATE;
+		out2 += nblocks * QSC_KECCAK_512_RATE;
+		out3 += nblocks * QSC_KECCAK_512_RATE;
+		out4 += nblocks * QSC_KECCAK_512_RATE;
+		out5 += nblocks * QSC_KECCAK_512_RATE;
+		out6 += nblocks * QSC_KECCAK_512_RATE;
+		out7 += nblocks * QSC_KECCAK_512_RATE;
+		outlen -= nblocks * QSC_KECCAK_512_RATE;
+	}
+
+	if (outlen != 0)
+	{
+		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_512, t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7], 1);
+
+		for (size_t i = 0; i < outlen; ++i)
+		{
+			out0[i] = t[0][i];
+			out1[i] = t[1][i];
+			out2[i] = t[2][i];
+			out3[i] = t[3][i];
+			out4[i] = t[4][i];
+			out5[i] = t[5][i];
+			out6[i] = t[6][i];
+			out7[i] = t[7][i];
+		}
+	}
+
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+
+	qsc_shake_512x4(out0, out1, out2, out3, outlen, inp0, inp1, inp2, inp3, inplen);
+	qsc_shake_512x4(out4, out5, out6, out7, outlen, inp4, inp5, inp6, inp7, inplen);
+
+#else
+
+	qsc_shake512_compute(out0, outlen, inp0, inplen);
+	qsc_shake512_compute(out1, outlen, inp1, inplen);
+	qsc_shake512_compute(out2, outlen, inp2, inplen);
+	qsc_shake512_compute(out3, outlen, inp3, inplen);
+	qsc_shake512_compute(out4, outlen, inp4, inplen);
+	qsc_shake512_compute(out5, outlen, inp5, inplen);
+	qsc_shake512_compute(out6, outlen, inp6, inplen);
+	qsc_shake512_compute(out7, outlen, inp7, inplen);
+
+#endif
+}
+
+/* parallel kmac x4 */
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+static void kmacx4_fast_absorb(__m256i state[QSC_KECCAK_STATE_SIZE], const uint8_t* inp0, const uint8_t* inp1,
+	const uint8_t* inp2, const uint8_t* inp3, size_t inplen)
+{
+	__m256i t;
+	uint64_t tmps[4] = { 0 };
+	size_t pos;
+
+	pos = 0;
+
+	for (size_t i = 0; i < inplen / sizeof(uint64_t); ++i)
+	{
+		tmps[0] = qsc_intutils_le8to64(inp0 + pos);
+		tmps[1] = qsc_intutils_le8to64(inp1 + pos);
+		tmps[2] = qsc_intutils_le8to64(inp2 + pos);
+		tmps[3] = qsc_intutils_le8to64(inp3 + pos);
+
+		t = _mm256_loadu_si256((const __m256i*)tmps);
+		state[i] = _mm256_xor_si256(state[i], t);
+		pos += 8;
+	}
+}
+
+static void kmacx4_customize(__m256i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen,
+	const uint8_t* name, size_t nmelen)
+{
+	uint8_t pad[4][QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	size_t oft;
+	size_t i;
+
+	/* stage 1: name + custom */
+
+	oft = keccak_left_encode(pad[0], (size_t)rate);
+	oft += keccak_left_encode((pad[0] + oft), nmelen * 8);
+
+	for (i = 0; i < nmelen; ++i)
+	{
+		pad[0][oft + i] = name[i];
+	}
+
+	oft += nmelen;
+	oft += keccak_left_encode((pad[0] + oft), cstlen * 8);
+	qsc_memutils_copy(pad[1], pad[0], oft);
+	qsc_memutils_copy(pad[2], pad[0], oft);
+	qsc_memutils_copy(pad[3], pad[0], oft);
+
+	for (i = 0; i < cstlen; ++i)
+	{
+		if (oft == rate)
+		{
+			kmacx4_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], (size_t)rate);
+			qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+			oft = 0;
+		}
+
+		pad[0][oft] = cst0[i];
+		pad[1][oft] = cst1[i];
+		pad[2][oft] = cst2[i];
+		pad[3][oft] = cst3[i];
+		++oft;
+	}
+
+	kmacx4_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], oft + (sizeof(uint64_t) - oft % sizeof(uint64_t)));
+	qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+
+	/* stage 2: key */
+
+	qsc_memutils_clear(pad[0], oft);
+	qsc_memutils_clear(pad[1], oft);
+	qsc_memutils_clear(pad[2], oft);
+	qsc_memutils_clear(pad[3], oft);
+
+	oft = keccak_left_encode(pad[0], (size_t)rate);
+	oft += keccak_left_encode((pad[0] + oft), keylen * 8);
+	qsc_memutils_copy(pad[1], pad[0], oft);
+	qsc_memutils_copy(pad[2], pad[0], oft);
+	qsc_memutils_copy(pad[3], pad[0], oft);
+
+	for (i = 0; i < keylen; ++i)
+	{
+		if (oft == rate)
+		{
+			kmacx4_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], (size_t)rate);
+			qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+			oft = 0;
+		}
+
+		pad[0][oft] = key0[i];
+		pad[1][oft] = key1[i];
+		pad[2][oft] = key2[i];
+		pad[3][oft] = key3[i];
+		++oft;
+	}
+
+	qsc_memutils_clear((pad[0] + oft), (size_t)rate - oft);
+	qsc_memutils_clear((pad[1] + oft), (size_t)rate - oft);
+	qsc_memutils_clear((pad[2] + oft), (size_t)rate - oft);
+	qsc_memutils_clear((pad[3] + oft), (size_t)rate - oft);
+
+	kmacx4_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], oft + (sizeof(uint64_t) - oft % sizeof(uint64_t)));
+	qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+}
+
+static void kmacx4_finalize(__m256i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
+	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3, size_t msglen,
+	uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen)
+{
+	uint8_t tmps[4][QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	uint8_t buf[sizeof(size_t) + 1] = { 0 };
+	uint8_t pad[4][QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	const size_t BLKCNT = outlen / (size_t)rate;
+	size_t bitlen;
+	size_t i;
+	size_t pos;
+
+	pos = 0;
+
+	while (msglen >= (size_t)rate)
+	{
+		kmacx4_fast_absorb(state, (msg0 + pos), (msg1 + pos), (msg2 + pos), (msg3 + pos), (size_t)rate);
+		qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+		pos += (size_t)rate;
+		msglen -= (size_t)rate;
+	}
+
+	if (msglen > 0)
+	{
+		qsc_memutils_copy(pad[0], (msg0 + pos), msglen);
+		qsc_memutils_copy(pad[1], (msg1 + pos), msglen);
+		qsc_memutils_copy(pad[2], (msg2 + pos), msglen);
+		qsc_memutils_copy(pad[3], (msg3 + pos), msglen);
+	}
+
+	pos = msglen;
+	bitlen = keccak_right_encode(buf, outlen * 8);
+
+	if (pos + bitlen >= (size_t)rate)
+	{
+		kmacx4_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], (size_t)rate);
+		qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+		pos = 0;
+	}
+
+	qsc_memutils_copy((pad[0] + pos), buf, bitlen);
+	pad[0][pos + bitlen] = QSC_KECCAK_KMAC_DOMAIN_ID;
+	pad[0][rate - 1] |= 128U;
+	qsc_memutils_copy((pad[1] + pos), (pad[0] + pos), (size_t)rate - pos);
+	qsc_memutils_copy((pad[2] + pos), (pad[0] + pos), (size_t)rate - pos);
+	qsc_memutils_copy((pad[3] + pos), (pad[0] + pos), (size_t)rate - pos);
 
-		--nblocks;
+	kmacx4_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], (size_t)rate);
+
+	if (outlen > (size_t)rate)
+	{
+		qsc_keccakx4_squeezeblocks(state, rate, out0, out1, out2, out3, BLKCNT);
+
+		out0 += BLKCNT * (size_t)rate;
+		out1 += BLKCNT * (size_t)rate;
+		out2 += BLKCNT * (size_t)rate;
+		out3 += BLKCNT * (size_t)rate;
+		outlen -= BLKCNT * (size_t)rate;
+	}
+
+	if (outlen != 0)
+	{
+		qsc_keccakx4_squeezeblocks(state, rate, tmps[0], tmps[1], tmps[2], tmps[3], 1);
+
+		for (i = 0; i < outlen; ++i)
+		{
+			out0[i] = tmps[0][i];
+			out1[i] = tmps[1][i];
+			out2[i] = tmps[2][i];
+			out3[i] = tmps[3][i];
+		}
 	}
 }
 
 #endif
 
-void qsc_shake_128x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
-	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen)
+void qsc_kmac_128x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen,
+	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3, size_t msglen)
 {
-	assert(inp0 != NULL);
-	assert(inp1 != NULL);
-	assert(inp2 != NULL);
-	assert(inp3 != NULL);
+	assert(key0 != NULL);
+	assert(key1 != NULL);
+	assert(key2 != NULL);
+	assert(key3 != NULL);
+	assert(msg0 != NULL);
+	assert(msg1 != NULL);
+	assert(msg2 != NULL);
+	assert(msg3 != NULL);
 	assert(out0 != NULL);
 	assert(out1 != NULL);
 	assert(out2 != NULL);
 	assert(out3 != NULL);
-	assert(inplen != 0);
+	assert(keylen != 0);
+	assert(msglen != 0);
 	assert(outlen != 0);
 
 #if defined(QSC_SYSTEM_HAS_AVX2)
 
-	size_t i;
-	size_t nblocks = outlen / QSC_KECCAK_128_RATE;
-	uint8_t t[4][QSC_KECCAK_128_RATE] = { 0 };
 	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+	const uint8_t name[] = { 0x4B, 0x4D, 0x41, 0x43 };
 
-	qsc_keccakx4_absorb(state, qsc_keccak_rate_128, inp0, inp1, inp2, inp3, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	kmacx4_customize(state, qsc_keccak_rate_128, key0, key1, key2, key3, keylen, cst0, cst1, cst2, cst3, cstlen, name, sizeof(name));
+	kmacx4_finalize(state, qsc_keccak_rate_128, msg0, msg1, msg2, msg3, msglen, out0, out1, out2, out3, outlen);
 
-	if (outlen >= QSC_KECCAK_128_RATE)
-	{
-		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_128, out0, out1, out2, out3, nblocks);
+#else
 
-		out0 += nblocks * QSC_KECCAK_128_RATE;
-		out1 += nblocks * QSC_KECCAK_128_RATE;
-		out2 += nblocks * QSC_KECCAK_128_RATE;
-		out3 += nblocks * QSC_KECCAK_128_RATE;
-		outlen -= nblocks * QSC_KECCAK_128_RATE;
-	}
+	qsc_kmac128_compute(out0, outlen, msg0, msglen, key0, keylen, cst0, cstlen);
+	qsc_kmac128_compute(out1, outlen, msg1, msglen, key1, keylen, cst1, cstlen);
+	qsc_kmac128_compute(out2, outlen, msg2, msglen, key2, keylen, cst2, cstlen);
+	qsc_kmac128_compute(out3, outlen, msg3, msglen, key3, keylen, cst3, cstlen);
 
-	if (outlen != 0)
-	{
-		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_128, t[0], t[1], t[2], t[3], 1);
+#endif
+}
 
-		for (i = 0; i < outlen; ++i)
-		{
-			out0[i] = t[0][i];
-			out1[i] = t[1][i];
-			out2[i] = t[2][i];
-			out3[i] = t[3][i];
-		}
-	}
+void qsc_kmac_256x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen,
+	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3, size_t msglen)
+{
+	assert(key0 != NULL);
+	assert(key1 != NULL);
+	assert(key2 != NULL);
+	assert(key3 != NULL);
+	assert(msg0 != NULL);
+	assert(msg1 != NULL);
+	assert(msg2 != NULL);
+	assert(msg3 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(keylen != 0);
+	assert(msglen != 0);
+	assert(outlen != 0);
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+	const uint8_t name[] = { 0x4B, 0x4D, 0x41, 0x43 };
+
+	kmacx4_customize(state, qsc_keccak_rate_256, key0, key1, key2, key3, keylen, cst0, cst1, cst2, cst3, cstlen, name, sizeof(name));
+	kmacx4_finalize(state, qsc_keccak_rate_256, msg0, msg1, msg2, msg3, msglen, out0, out1, out2, out3, outlen);
 
 #else
 
-	qsc_shake128_compute(out0, outlen, inp0, inplen);
-	qsc_shake128_compute(out1, outlen, inp1, inplen);
-	qsc_shake128_compute(out2, outlen, inp2, inplen);
-	qsc_shake128_compute(out3, outlen, inp3, inplen);
+	qsc_kmac256_compute(out0, outlen, msg0, msglen, key0, keylen, cst0, cstlen);
+	qsc_kmac256_compute(out1, outlen, msg1, msglen, key1, keylen, cst1, cstlen);
+	qsc_kmac256_compute(out2, outlen, msg2, msglen, key2, keylen, cst2, cstlen);
+	qsc_kmac256_compute(out3, outlen, msg3, msglen, key3, keylen, cst3, cstlen);
 
 #endif
 }
 
-void qsc_shake_256x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
-	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen)
+void qsc_kmac_512x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen,
+	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3, size_t msglen)
 {
-	assert(inp0 != NULL);
-	assert(inp1 != NULL);
-	assert(inp2 != NULL);
-	assert(inp3 != NULL);
+	assert(key0 != NULL);
+	assert(key1 != NULL);
+	assert(key2 != NULL);
+	assert(key3 != NULL);
+	assert(msg0 != NULL);
+	assert(msg1 != NULL);
+	assert(msg2 != NULL);
+	assert(msg3 != NULL);
 	assert(out0 != NULL);
 	assert(out1 != NULL);
 	assert(out2 != NULL);
 	assert(out3 != NULL);
-	assert(inplen != 0);
+	assert(keylen != 0);
+	assert(msglen != 0);
 	assert(outlen != 0);
 
 #if defined(QSC_SYSTEM_HAS_AVX2)
 
-	size_t nblocks = outlen / QSC_KECCAK_256_RATE;
-	uint8_t t[4][QSC_KECCAK_256_RATE] = { 0 };
 	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+	const uint8_t name[] = { 0x4B, 0x4D, 0x41, 0x43 };
 
-	qsc_keccakx4_absorb(state, qsc_keccak_rate_256, inp0, inp1, inp2, inp3, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	kmacx4_customize(state, qsc_keccak_rate_512, key0, key1, key2, key3, keylen, cst0, cst1, cst2, cst3, cstlen, name, sizeof(name));
+	kmacx4_finalize(state, qsc_keccak_rate_512, msg0, msg1, msg2, msg3, msglen, out0, out1, out2, out3, outlen);
 
-	if (outlen >= QSC_KECCAK_256_RATE)
+#else
+
+	qsc_kmac512_compute(out0, outlen, msg0, msglen, key0, keylen, cst0, cstlen);
+	qsc_kmac512_compute(out1, outlen, msg1, msglen, key1, keylen, cst1, cstlen);
+	qsc_kmac512_compute(out2, outlen, msg2, msglen, key2, keylen, cst2, cstlen);
+	qsc_kmac512_compute(out3, outlen, msg3, msglen, key3, keylen, cst3, cstlen);
+
+#endif
+}
+
+/* parallel kmac x8 */
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+static void kmacx8_fast_absorb(__m512i state[QSC_KECCAK_STATE_SIZE],
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
+	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7,
+	size_t inplen)
+{
+	__m512i t;
+	uint64_t tmps[8] = { 0 };
+	size_t pos;
+
+	pos = 0;
+
+	for (size_t i = 0; i < inplen / sizeof(uint64_t); ++i)
 	{
-		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_256, out0, out1, out2, out3, nblocks);
+		tmps[0] = qsc_intutils_le8to64((inp0 + pos));
+		tmps[1] = qsc_intutils_le8to64((inp1 + pos));
+		tmps[2] = qsc_intutils_le8to64((inp2 + pos));
+		tmps[3] = qsc_intutils_le8to64((inp3 + pos));
+		tmps[4] = qsc_intutils_le8to64((inp4 + pos));
+		tmps[5] = qsc_intutils_le8to64((inp5 + pos));
+		tmps[6] = qsc_intutils_le8to64((inp6 + pos));
+		tmps[7] = qsc_intutils_le8to64((inp7 + pos));
 
-		out0 += nblocks * QSC_KECCAK_256_RATE;
-		out1 += nblocks * QSC_KECCAK_256_RATE;
-		out2 += nblocks * QSC_KECCAK_256_RATE;
-		out3 += nblocks * QSC_KECCAK_256_RATE;
-		outlen -= nblocks * QSC_KECCAK_256_RATE;
+		t = _mm512_loadu_si512((const __m512i*)tmps);
+		state[i] = _mm512_xor_si512(state[i], t);
+		pos += 8;
+	}
+}
+
+static void kmacx8_customize(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
+	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
+	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen,
+	const uint8_t* name, size_t nmelen)
+{
+	uint8_t pad[8][QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	size_t oft;
+	size_t i;
+
+	/* stage 1: name + custom */
+
+	oft = keccak_left_encode(pad[0], rate);
+	oft += keccak_left_encode((pad[0] + oft), nmelen * 8);
+
+	for (i = 0; i < nmelen; ++i)
+	{
+		pad[0][oft + i] = name[i];
+	}
+
+	oft += nmelen;
+	oft += keccak_left_encode((pad[0] + oft), cstlen * 8);
+	qsc_memutils_copy(pad[1], pad[0], oft);
+	qsc_memutils_copy(pad[2], pad[0], oft);
+	qsc_memutils_copy(pad[3], pad[0], oft);
+	qsc_memutils_copy(pad[4], pad[0], oft);
+	qsc_memutils_copy(pad[5], pad[0], oft);
+	qsc_memutils_copy(pad[6], pad[0], oft);
+	qsc_memutils_copy(pad[7], pad[0], oft);
+
+	for (i = 0; i < cstlen; ++i)
+	{
+		if (oft == rate)
+		{
+			kmacx8_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7], (size_t)rate);
+			qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+			oft = 0;
+		}
+
+		pad[0][oft] = cst0[i];
+		pad[1][oft] = cst1[i];
+		pad[2][oft] = cst2[i];
+		pad[3][oft] = cst3[i];
+		pad[4][oft] = cst4[i];
+		pad[5][oft] = cst5[i];
+		pad[6][oft] = cst6[i];
+		pad[7][oft] = cst7[i];
+		++oft;
 	}
 
-	if (outlen != 0)
-	{
-		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_256, t[0], t[1], t[2], t[3], 1);
+	kmacx8_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7], oft + (sizeof(uint64_t) - oft % sizeof(uint64_t)));
+	qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
 
-		for (size_t i = 0; i < outlen; ++i)
+	/* stage 2: key */
+
+	qsc_memutils_clear(pad[0], oft);
+	qsc_memutils_clear(pad[1], oft);
+	qsc_memutils_clear(pad[2], oft);
+	qsc_memutils_clear(pad[3], oft);
+	qsc_memutils_clear(pad[4], oft);
+	qsc_memutils_clear(pad[5], oft);
+	qsc_memutils_clear(pad[6], oft);
+	qsc_memutils_clear(pad[7], oft);
+
+	oft = keccak_left_encode(pad[0], rate);
+	oft += keccak_left_encode((pad[0] + oft), keylen * 8);
+	qsc_memutils_copy(pad[1], pad[0], oft);
+	qsc_memutils_copy(pad[2], pad[0], oft);
+	qsc_memutils_copy(pad[3], pad[0], oft);
+	qsc_memutils_copy(pad[4], pad[0], oft);
+	qsc_memutils_copy(pad[5], pad[0], oft);
+	qsc_memutils_copy(pad[6], pad[0], oft);
+	qsc_memutils_copy(pad[7], pad[0], oft);
+
+	for (i = 0; i < keylen; ++i)
+	{
+		if (oft == rate)
 		{
-			out0[i] = t[0][i];
-			out1[i] = t[1][i];
-			out2[i] = t[2][i];
-			out3[i] = t[3][i];
+			kmacx8_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7], rate);
+			qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+			oft = 0;
 		}
-	}
-
-#else
 
-	qsc_shake256_compute(out0, outlen, inp0, inplen);
-	qsc_shake256_compute(out1, outlen, inp1, inplen);
-	qsc_shake256_compute(out2, outlen, inp2, inplen);
-	qsc_shake256_compute(out3, outlen, inp3, inplen);
+		pad[0][oft] = key0[i];
+		pad[1][oft] = key1[i];
+		pad[2][oft] = key2[i];
+		pad[3][oft] = key3[i];
+		pad[4][oft] = key4[i];
+		pad[5][oft] = key5[i];
+		pad[6][oft] = key6[i];
+		pad[7][oft] = key7[i];
+		++oft;
+	}
 
-#endif
+	kmacx8_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7], oft + (sizeof(uint64_t) - oft % sizeof(uint64_t)));
+	qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
 }
 
-void qsc_shake_512x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
-	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen)
+static void kmacx8_finalize(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
+	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3,
+	const uint8_t* msg4, const uint8_t* msg5, const uint8_t* msg6, const uint8_t* msg7, size_t msglen,
+	uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen)
 {
-	assert(inp0 != NULL);
-	assert(inp1 != NULL);
-	assert(inp2 != NULL);
-	assert(inp3 != NULL);
-	assert(out0 != NULL);
-	assert(out1 != NULL);
-	assert(out2 != NULL);
-	assert(out3 != NULL);
-	assert(inplen != 0);
-	assert(outlen != 0);
-
-#if defined(QSC_SYSTEM_HAS_AVX2)
-
-	size_t nblocks = outlen / QSC_KECCAK_512_RATE;
-	uint8_t t[4][QSC_KECCAK_512_RATE] = { 0 };
-	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+	uint8_t tmps[8][QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	uint8_t buf[sizeof(size_t) + 1] = { 0 };
+	uint8_t pad[8][QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	const size_t BLKCNT = outlen / (size_t)rate;
+	size_t bitlen;
+	size_t i;
+	size_t pos;
 
-	qsc_keccakx4_absorb(state, qsc_keccak_rate_512, inp0, inp1, inp2, inp3, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	pos = 0;
 
-	if (outlen >= QSC_KECCAK_512_RATE)
+	while (msglen >= (size_t)rate)
 	{
-		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_512, out0, out1, out2, out3, nblocks);
+		kmacx8_fast_absorb(state, (msg0 + pos), (msg1 + pos), (msg2 + pos), (msg3 + pos),
+			(msg4 + pos), (msg5 + pos), (msg6 + pos), (msg7 + pos), (size_t)rate);
 
-		out0 += nblocks * QSC_KECCAK_512_RATE;
-		out1 += nblocks * QSC_KECCAK_512_RATE;
-		out2 += nblocks * QSC_KECCAK_512_RATE;
-		out3 += nblocks * QSC_KECCAK_512_RATE;
-		outlen -= nblocks * QSC_KECCAK_512_RATE;
+		qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+		pos += (size_t)rate;
+		msglen -= (size_t)rate;
 	}
 
-	if (outlen != 0)
+	if (msglen > 0)
 	{
-		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_512, t[0], t[1], t[2], t[3], 1);
-
-		for (size_t i = 0; i < outlen; ++i)
-		{
-			out0[i] = t[0][i];
-			out1[i] = t[1][i];
-			out2[i] = t[2][i];
-			out3[i] = t[3][i];
-		}
+		qsc_memutils_copy(pad[0], (msg0 + pos), msglen);
+		qsc_memutils_copy(pad[1], (msg1 + pos), msglen);
+		qsc_memutils_copy(pad[2], (msg2 + pos), msglen);
+		qsc_memutils_copy(pad[3], (msg3 + pos), msglen);
+		qsc_memutils_copy(pad[4], (msg4 + pos), msglen);
+		qsc_memutils_copy(pad[5], (msg5 + pos), msglen);
+		qsc_memutils_copy(pad[6], (msg6 + pos), msglen);
+		qsc_memutils_copy(pad[7], (msg7 + pos), msglen);
 	}
 
-#else
-
-	qsc_shake512_compute(out0, outlen, inp0, inplen);
-	qsc_shake512_compute(out1, outlen, inp1, inplen);
-	qsc_shake512_compute(out2, outlen, inp2, inplen);
-	qsc_shake512_compute(out3, outlen, inp3, inplen);
-
-#endif
-}
-
-/* parallel shake x8 */
+	pos = msglen;
+	bitlen = keccak_right_encode(buf, outlen * 8);
 
-void qsc_shake_128x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
-	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen,
-	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
-	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen)
-{
-	assert(inp0 != NULL);
-	assert(inp1 != NULL);
-	assert(inp2 != NULL);
-	assert(inp3 != NULL);
-	assert(inp4 != NULL);
-	assert(inp5 != NULL);
-	assert(inp6 != NULL);
-	assert(inp7 != NULL);
-	assert(out0 != NULL);
-	assert(out1 != NULL);
-	assert(out2 != NULL);
-	assert(out3 != NULL);
-	assert(out4 != NULL);
-	assert(out5 != NULL);
-	assert(out6 != NULL);
-	assert(out7 != NULL);
-	assert(inplen != 0);
-	assert(outlen != 0);
+	if (pos + bitlen >= (size_t)rate)
+	{
+		kmacx8_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7], (size_t)rate);
+		qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+		pos = 0;
+	}
 
-#if defined(QSC_SYSTEM_HAS_AVX512)
+	qsc_memutils_copy((pad[0] + pos), buf, bitlen);
+	pad[0][pos + bitlen] = QSC_KECCAK_KMAC_DOMAIN_ID;
+	pad[0][rate - 1] |= 128U;
 
-	size_t nblocks = outlen / QSC_KECCAK_128_RATE;
-	uint8_t t[8][QSC_KECCAK_128_RATE] = { 0 };
-	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+	qsc_memutils_copy((pad[1] + pos), (pad[0] + pos), (size_t)rate - pos);
+	qsc_memutils_copy((pad[2] + pos), (pad[0] + pos), (size_t)rate - pos);
+	qsc_memutils_copy((pad[3] + pos), (pad[0] + pos), (size_t)rate - pos);
+	qsc_memutils_copy((pad[4] + pos), (pad[0] + pos), (size_t)rate - pos);
+	qsc_memutils_copy((pad[5] + pos), (pad[0] + pos), (size_t)rate - pos);
+	qsc_memutils_copy((pad[6] + pos), (pad[0] + pos), (size_t)rate - pos);
+	qsc_memutils_copy((pad[7] + pos), (pad[0] + pos), (size_t)rate - pos);
 
-	qsc_keccakx8_absorb(state, qsc_keccak_rate_128, inp0, inp1, inp2, inp3, inp4, inp5, inp6, inp7, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	kmacx8_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7], (size_t)rate);
 
-	if (outlen >= QSC_KECCAK_128_RATE)
+	if (outlen > (size_t)rate)
 	{
-		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_128, out0, out1, out2, out3, out4, out5, out6, out7, nblocks);
+		qsc_keccakx8_squeezeblocks(state, rate, out0, out1, out2, out3, out4, out5, out6, out7, BLKCNT);
 
-		out0 += nblocks * QSC_KECCAK_128_RATE;
-		out1 += nblocks * QSC_KECCAK_128_RATE;
-		out2 += nblocks * QSC_KECCAK_128_RATE;
-		out3 += nblocks * QSC_KECCAK_128_RATE;
-		out4 += nblocks * QSC_KECCAK_128_RATE;
-		out5 += nblocks * QSC_KECCAK_128_RATE;
-		out6 += nblocks * QSC_KECCAK_128_RATE;
-		out7 += nblocks * QSC_KECCAK_128_RATE;
-		outlen -= nblocks * QSC_KECCAK_128_RATE;
+		out0 += BLKCNT * (size_t)rate;
+		out1 += BLKCNT * (size_t)rate;
+		out2 += BLKCNT * (size_t)rate;
+		out3 += BLKCNT * (size_t)rate;
+		out4 += BLKCNT * (size_t)rate;
+		out5 += BLKCNT * (size_t)rate;
+		out6 += BLKCNT * (size_t)rate;
+		out7 += BLKCNT * (size_t)rate;
+		outlen -= BLKCNT * (size_t)rate;
 	}
 
 	if (outlen != 0)
 	{
-		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_128, t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7], 1);
+		qsc_keccakx8_squeezeblocks(state, rate, tmps[0], tmps[1], tmps[2], tmps[3], tmps[4], tmps[5], tmps[6], tmps[7], 1);
 
-		for (size_t i = 0; i < outlen; ++i)
+		for (i = 0; i < outlen; ++i)
 		{
-			out0[i] = t[0][i];
-			out1[i] = t[1][i];
-			out2[i] = t[2][i];
-			out3[i] = t[3][i];
-			out4[i] = t[4][i];
-			out5[i] = t[5][i];
-			out6[i] = t[6][i];
-			out7[i] = t[7][i];
+			out0[i] = tmps[0][i];
+			out1[i] = tmps[1][i];
+			out2[i] = tmps[2][i];
+			out3[i] = tmps[3][i];
+			out4[i] = tmps[4][i];
+			out5[i] = tmps[5][i];
+			out6[i] = tmps[6][i];
+			out7[i] = tmps[7][i];
 		}
 	}
-
-#elif defined(QSC_SYSTEM_HAS_AVX2)
-
-	qsc_shake_128x4(out0, out1, out2, out3, outlen, inp0, inp1, inp2, inp3, inplen);
-	qsc_shake_128x4(out4, out5, out6, out7, outlen, inp4, inp5, inp6, inp7, inplen);
-
-#else
-
-	qsc_shake128_compute(out0, outlen, inp0, inplen);
-	qsc_shake128_compute(out1, outlen, inp1, inplen);
-	qsc_shake128_compute(out2, outlen, inp2, inplen);
-	qsc_shake128_compute(out3, outlen, inp3, inplen);
-	qsc_shake128_compute(out4, outlen, inp4, inplen);
-	qsc_shake128_compute(out5, outlen, inp5, inplen);
-	qsc_shake128_compute(out6, outlen, inp6, inplen);
-	qsc_shake128_compute(out7, outlen, inp7, inplen);
+}
 
 #endif
-}
 
-void qsc_shake_256x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+void qsc_kmac_128x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
 	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen,
-	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
-	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen)
-{
-	assert(inp0 != NULL);
-	assert(inp1 != NULL);
-	assert(inp2 != NULL);
-	assert(inp3 != NULL);
-	assert(inp4 != NULL);
-	assert(inp5 != NULL);
-	assert(inp6 != NULL);
-	assert(inp7 != NULL);
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
+	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
+	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen,
+	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3,
+	const uint8_t* msg4, const uint8_t* msg5, const uint8_t* msg6, const uint8_t* msg7, size_t msglen)
+{
+	assert(key0 != NULL);
+	assert(key1 != NULL);
+	assert(key2 != NULL);
+	assert(key3 != NULL);
+	assert(key4 != NULL);
+	assert(key5 != NULL);
+	assert(key6 != NULL);
+	assert(key7 != NULL);
+	assert(msg0 != NULL);
+	assert(msg1 != NULL);
+	assert(msg2 != NULL);
+	assert(msg3 != NULL);
+	assert(msg4 != NULL);
+	assert(msg5 != NULL);
+	assert(msg6 != NULL);
+	assert(msg7 != NULL);
 	assert(out0 != NULL);
 	assert(out1 != NULL);
 	assert(out2 != NULL);
@@ -5734,81 +7086,66 @@ void qsc_shake_256x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
 	assert(out5 != NULL);
 	assert(out6 != NULL);
 	assert(out7 != NULL);
-	assert(inplen != 0);
+	assert(keylen != 0);
+	assert(msglen != 0);
 	assert(outlen != 0);
 
 #if defined(QSC_SYSTEM_HAS_AVX512)
 
-	size_t nblocks = outlen / QSC_KECCAK_256_RATE;
-	uint8_t t[8][QSC_KECCAK_256_RATE] = { 0 };
 	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+	const uint8_t name[] = { 0x4B, 0x4D, 0x41, 0x43 };
 
-	qsc_keccakx8_absorb(state, qsc_keccak_rate_256, inp0, inp1, inp2, inp3, inp4, inp5, inp6, inp7, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
-
-	if (outlen >= QSC_KECCAK_256_RATE)
-	{
-		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_256, out0, out1, out2, out3, out4, out5, out6, out7, nblocks);
-
-		out0 += nblocks * QSC_KECCAK_256_RATE;
-		out1 += nblocks * QSC_KECCAK_256_RATE;
-		out2 += nblocks * QSC_KECCAK_256_RATE;
-		out3 += nblocks * QSC_KECCAK_256_RATE;
-		out4 += nblocks * QSC_KECCAK_256_RATE;
-		out5 += nblocks * QSC_KECCAK_256_RATE;
-		out6 += nblocks * QSC_KECCAK_256_RATE;
-		out7 += nblocks * QSC_KECCAK_256_RATE;
-		outlen -= nblocks * QSC_KECCAK_256_RATE;
-	}
-
-	if (outlen != 0)
-	{
-		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_256, t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7], 1);
-
-		for (size_t i = 0; i < outlen; ++i)
-		{
-			out0[i] = t[0][i];
-			out1[i] = t[1][i];
-			out2[i] = t[2][i];
-			out3[i] = t[3][i];
-			out4[i] = t[4][i];
-			out5[i] = t[5][i];
-			out6[i] = t[6][i];
-			out7[i] = t[7][i];
-		}
-	}
+	kmacx8_customize(state, qsc_keccak_rate_128, key0, key1, key2, key3, key4, key5, key6, key7, keylen,
+		cst0, cst1, cst2, cst3, cst4, cst5, cst6, cst7, cstlen, name, sizeof(name));
+	kmacx8_finalize(state, qsc_keccak_rate_128, msg0, msg1, msg2, msg3, msg4, msg5, msg6, msg7, msglen,
+		out0, out1, out2, out3, out4, out5, out6, out7, outlen);
 
 #elif defined(QSC_SYSTEM_HAS_AVX2)
 
-	qsc_shake_256x4(out0, out1, out2, out3, outlen, inp0, inp1, inp2, inp3, inplen);
-	qsc_shake_256x4(out4, out5, out6, out7, outlen, inp4, inp5, inp6, inp7, inplen);
+	qsc_kmac_128x4(out0, out1, out2, out3, outlen, key0, key1, key2, key3, keylen,
+		cst0, cst1, cst2, cst3, cstlen, msg0, msg1, msg2, msg3, msglen);
+	qsc_kmac_128x4(out4, out5, out6, out7, outlen, key4, key5, key6, key7, keylen,
+		cst4, cst5, cst6, cst7, cstlen, msg4, msg5, msg6, msg7, msglen);
 
 #else
 
-	qsc_shake256_compute(out0, outlen, inp0, inplen);
-	qsc_shake256_compute(out1, outlen, inp1, inplen);
-	qsc_shake256_compute(out2, outlen, inp2, inplen);
-	qsc_shake256_compute(out3, outlen, inp3, inplen);
-	qsc_shake256_compute(out4, outlen, inp4, inplen);
-	qsc_shake256_compute(out5, outlen, inp5, inplen);
-	qsc_shake256_compute(out6, outlen, inp6, inplen);
-	qsc_shake256_compute(out7, outlen, inp7, inplen);
+	qsc_kmac128_compute(out0, outlen, msg0, msglen, key0, keylen, cst0, cstlen);
+	qsc_kmac128_compute(out1, outlen, msg1, msglen, key1, keylen, cst1, cstlen);
+	qsc_kmac128_compute(out2, outlen, msg2, msglen, key2, keylen, cst2, cstlen);
+	qsc_kmac128_compute(out3, outlen, msg3, msglen, key3, keylen, cst3, cstlen);
+	qsc_kmac128_compute(out4, outlen, msg4, msglen, key4, keylen, cst4, cstlen);
+	qsc_kmac128_compute(out5, outlen, msg5, msglen, key5, keylen, cst5, cstlen);
+	qsc_kmac128_compute(out6, outlen, msg6, msglen, key6, keylen, cst6, cstlen);
+	qsc_kmac128_compute(out7, outlen, msg7, msglen, key7, keylen, cst7, cstlen);
 
 #endif
 }
 
-void qsc_shake_512x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+void qsc_kmac_256x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
 	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen,
-	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
-	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen)
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
+	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
+	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen,
+	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3,
+	const uint8_t* msg4, const uint8_t* msg5, const uint8_t* msg6, const uint8_t* msg7, size_t msglen)
 {
-	assert(inp0 != NULL);
-	assert(inp1 != NULL);
-	assert(inp2 != NULL);
-	assert(inp3 != NULL);
-	assert(inp4 != NULL);
-	assert(inp5 != NULL);
-	assert(inp6 != NULL);
-	assert(inp7 != NULL);
+	assert(key0 != NULL);
+	assert(key1 != NULL);
+	assert(key2 != NULL);
+	assert(key3 != NULL);
+	assert(key4 != NULL);
+	assert(key5 != NULL);
+	assert(key6 != NULL);
+	assert(key7 != NULL);
+	assert(msg0 != NULL);
+	assert(msg1 != NULL);
+	assert(msg2 != NULL);
+	assert(msg3 != NULL);
+	assert(msg4 != NULL);
+	assert(msg5 != NULL);
+	assert(msg6 != NULL);
+	assert(msg7 != NULL);
 	assert(out0 != NULL);
 	assert(out1 != NULL);
 	assert(out2 != NULL);
@@ -5817,798 +7154,820 @@ void qsc_shake_512x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
 	assert(out5 != NULL);
 	assert(out6 != NULL);
 	assert(out7 != NULL);
-	assert(inplen != 0);
+	assert(keylen != 0);
+	assert(msglen != 0);
 	assert(outlen != 0);
 
 #if defined(QSC_SYSTEM_HAS_AVX512)
 
-	size_t nblocks = outlen / QSC_KECCAK_512_RATE;
-	uint8_t t[8][QSC_KECCAK_512_RATE] = { 0 };
 	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+	const uint8_t name[] = { 0x4B, 0x4D, 0x41, 0x43 };
 
-	qsc_keccakx8_absorb(state, qsc_keccak_rate_512, inp0, inp1, inp2, inp3, inp4, inp5, inp6, inp7, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
-
-	if (outlen >= QSC_KECCAK_512_RATE)
-	{
-		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_512, out0, out1, out2, out3, out4, out5, out6, out7, nblocks);
-
-		out0 += nblocks * QSC_KECCAK_512_RATE;
-		out1 += nblocks * QSC_KECCAK_512_RATE;
-		out2 += nblocks * QSC_KECCAK_512_RATE;
-		out3 += nblocks * QSC_KECCAK_512_RATE;
-		out4 += nblocks * QSC_KECCAK_512_RATE;
-		out5 += nblocks * QSC_KECCAK_512_RATE;
-		out6 += nblocks * QSC_KECCAK_512_RATE;
-		out7 += nblocks * QSC_KECCAK_512_RATE;
-		outlen -= nblocks * QSC_KECCAK_512_RATE;
-	}
-
-	if (outlen != 0)
-	{
-		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_512, t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7], 1);
-
-		for (size_t i = 0; i < outlen; ++i)
-		{
-			out0[i] = t[0][i];
-			out1[i] = t[1][i];
-			out2[i] = t[2][i];
-			out3[i] = t[3][i];
-			out4[i] = t[4][i];
-			out5[i] = t[5][i];
-			out6[i] = t[6][i];
-			out7[i] = t[7][i];
-		}
-	}
+	kmacx8_customize(state, qsc_keccak_rate_256, key0, key1, key2, key3, key4, key5, key6, key7, keylen,
+		cst0, cst1, cst2, cst3, cst4, cst5, cst6, cst7, cstlen, name, sizeof(name));
+	kmacx8_finalize(state, qsc_keccak_rate_256, msg0, msg1, msg2, msg3, msg4, msg5, msg6, msg7, msglen,
+		out0, out1, out2, out3, out4, out5, out6, out7, outlen);
 
 #elif defined(QSC_SYSTEM_HAS_AVX2)
 
-	qsc_shake_512x4(out0, out1, out2, out3, outlen, inp0, inp1, inp2, inp3, inplen);
-	qsc_shake_512x4(out4, out5, out6, out7, outlen, inp4, inp5, inp6, inp7, inplen);
+	qsc_kmac_256x4(out0, out1, out2, out3, outlen, key0, key1, key2, key3, keylen,
+		cst0, cst1, cst2, cst3, cstlen, msg0, msg1, msg2, msg3, msglen);
+	qsc_kmac_256x4(out4, out5, out6, out7, outlen, key4, key5, key6, key7, keylen,
+		cst4, cst5, cst6, cst7, cstlen, msg4, msg5, msg6, msg7, msglen);
 
 #else
 
-	qsc_shake512_compute(out0, outlen, inp0, inplen);
-	qsc_shake512_compute(out1, outlen, inp1, inplen);
-	qsc_shake512_compute(out2, outlen, inp2, inplen);
-	qsc_shake512_compute(out3, outlen, inp3, inplen);
-	qsc_shake512_compute(out4, outlen, inp4, inplen);
-	qsc_shake512_compute(out5, outlen, inp5, inplen);
-	qsc_shake512_compute(out6, outlen, inp6, inplen);
-	qsc_shake512_compute(out7, outlen, inp7, inplen);
+	qsc_kmac256_compute(out0, outlen, msg0, msglen, key0, keylen, cst0, cstlen);
+	qsc_kmac256_compute(out1, outlen, msg1, msglen, key1, keylen, cst1, cstlen);
+	qsc_kmac256_compute(out2, outlen, msg2, msglen, key2, keylen, cst2, cstlen);
+	qsc_kmac256_compute(out3, outlen, msg3, msglen, key3, keylen, cst3, cstlen);
+	qsc_kmac256_compute(out4, outlen, msg4, msglen, key4, keylen, cst4, cstlen);
+	qsc_kmac256_compute(out5, outlen, msg5, msglen, key5, keylen, cst5, cstlen);
+	qsc_kmac256_compute(out6, outlen, msg6, msglen, key6, keylen, cst6, cstlen);
+	qsc_kmac256_compute(out7, outlen, msg7, msglen, key7, keylen, cst7, cstlen);
 
 #endif
 }
 
-/* parallel kmac x4 */
-
-#if defined(QSC_SYSTEM_HAS_AVX2)
-
-static void kmacx4_fast_absorb(__m256i state[QSC_KECCAK_STATE_SIZE], const uint8_t* inp0, const uint8_t* inp1,
-	const uint8_t* inp2, const uint8_t* inp3, size_t inplen)
+void qsc_kmac_512x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
+	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
+	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen,
+	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3,
+	const uint8_t* msg4, const uint8_t* msg5, const uint8_t* msg6, const uint8_t* msg7, size_t msglen)
 {
-	__m256i t;
-	uint64_t tmps[4] = { 0 };
-	size_t pos;
-
-	pos = 0;
-
-	for (size_t i = 0; i < inplen / sizeof(uint64_t); ++i)
-	{
-		tmps[0] = qsc_intutils_le8to64(inp0 + pos);
-		tmps[1] = qsc_intutils_le8to64(inp1 + pos);
-		tmps[2] = qsc_intutils_le8to64(inp2 + pos);
-		tmps[3] = qsc_intutils_le8to64(inp3 + pos);
+	assert(key0 != NULL);
+	assert(key1 != NULL);
+	assert(key2 != NULL);
+	assert(key3 != NULL);
+	assert(key4 != NULL);
+	assert(key5 != NULL);
+	assert(key6 != NULL);
+	assert(key7 != NULL);
+	assert(msg0 != NULL);
+	assert(msg1 != NULL);
+	assert(msg2 != NULL);
+	assert(msg3 != NULL);
+	assert(msg4 != NULL);
+	assert(msg5 != NULL);
+	assert(msg6 != NULL);
+	assert(msg7 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(out4 != NULL);
+	assert(out5 != NULL);
+	assert(out6 != NULL);
+	assert(out7 != NULL);
+	assert(keylen != 0);
+	assert(msglen != 0);
+	assert(outlen != 0);
 
-		t = _mm256_loadu_si256((const __m256i*)tmps);
-		state[i] = _mm256_xor_si256(state[i], t);
-		pos += 8;
-	}
-}
+#if defined(QSC_SYSTEM_HAS_AVX512)
 
-static void kmacx4_customize(__m256i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
-	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
-	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen,
-	const uint8_t* name, size_t nmelen)
-{
-	uint8_t pad[4][QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
-	size_t oft;
-	size_t i;
+	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+	const uint8_t name[] = { 0x4B, 0x4D, 0x41, 0x43 };
 
-	/* stage 1: name + custom */
+	kmacx8_customize(state, qsc_keccak_rate_512, key0, key1, key2, key3, key4, key5, key6, key7, keylen,
+		cst0, cst1, cst2, cst3, cst4, cst5, cst6, cst7, cstlen, name, sizeof(name));
+	kmacx8_finalize(state, qsc_keccak_rate_512, msg0, msg1, msg2, msg3, msg4, msg5, msg6, msg7, msglen,
+		out0, out1, out2, out3, out4, out5, out6, out7, outlen);
 
-	oft = keccak_left_encode(pad[0], (size_t)rate);
-	oft += keccak_left_encode((pad[0] + oft), nmelen * 8);
+#elif defined(QSC_SYSTEM_HAS_AVX2)
 
-	for (i = 0; i < nmelen; ++i)
-	{
-		pad[0][oft + i] = name[i];
-	}
+	qsc_kmac_512x4(out0, out1, out2, out3, outlen, key0, key1, key2, key3, keylen,
+		cst0, cst1, cst2, cst3, cstlen, msg0, msg1, msg2, msg3, msglen);
+	qsc_kmac_512x4(out4, out5, out6, out7, outlen, key4, key5, key6, key7, keylen,
+		cst4, cst5, cst6, cst7, cstlen, msg4, msg5, msg6, msg7, msglen);
 
-	oft += nmelen;
-	oft += keccak_left_encode((pad[0] + oft), cstlen * 8);
-	qsc_memutils_copy(pad[1], pad[0], oft);
-	qsc_memutils_copy(pad[2], pad[0], oft);
-	qsc_memutils_copy(pad[3], pad[0], oft);
+#else
 
-	for (i = 0; i < cstlen; ++i)
-	{
-		if (oft == rate)
-		{
-			kmacx4_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], (size_t)rate);
-			qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
-			oft = 0;
-		}
+	qsc_kmac512_compute(out0, outlen, msg0, msglen, key0, keylen, cst0, cstlen);
+	qsc_kmac512_compute(out1, outlen, msg1, msglen, key1, keylen, cst1, cstlen);
+	qsc_kmac512_compute(out2, outlen, msg2, msglen, key2, keylen, cst2, cstlen);
+	qsc_kmac512_compute(out3, outlen, msg3, msglen, key3, keylen, cst3, cstlen);
+	qsc_kmac512_compute(out4, outlen, msg4, msglen, key4, keylen, cst4, cstlen);
+	qsc_kmac512_compute(out5, outlen, msg5, msglen, key5, keylen, cst5, cstlen);
+	qsc_kmac512_compute(out6, outlen, msg6, msglen, key6, keylen, cst6, cstlen);
+	qsc_kmac512_compute(out7, outlen, msg7, msglen, key7, keylen, cst7, cstlen);
 
-		pad[0][oft] = cst0[i];
-		pad[1][oft] = cst1[i];
-		pad[2][oft] = cst2[i];
-		pad[3][oft] = cst3[i];
-		++oft;
-	}
+#endif
+}
 
-	kmacx4_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], oft + (sizeof(uint64_t) - oft % sizeof(uint64_t)));
-	qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
 
-	/* stage 2: key */
+/* parallel SHA3 and cSHAKE */
 
-	qsc_memutils_clear(pad[0], oft);
-	qsc_memutils_clear(pad[1], oft);
-	qsc_memutils_clear(pad[2], oft);
-	qsc_memutils_clear(pad[3], oft);
+#if defined(QSC_SYSTEM_HAS_AVX2)
 
-	oft = keccak_left_encode(pad[0], (size_t)rate);
-	oft += keccak_left_encode((pad[0] + oft), keylen * 8);
-	qsc_memutils_copy(pad[1], pad[0], oft);
-	qsc_memutils_copy(pad[2], pad[0], oft);
-	qsc_memutils_copy(pad[3], pad[0], oft);
+static void sha3x4_squeeze(__m256i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
+	uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen)
+{
+	uint8_t t[4][QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	const size_t nblocks = outlen / (size_t)rate;
 
-	for (i = 0; i < keylen; ++i)
+	if (nblocks != 0)
 	{
-		if (oft == rate)
-		{
-			kmacx4_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], (size_t)rate);
-			qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
-			oft = 0;
-		}
+		qsc_keccakx4_squeezeblocks(state, rate, out0, out1, out2, out3, nblocks);
 
-		pad[0][oft] = key0[i];
-		pad[1][oft] = key1[i];
-		pad[2][oft] = key2[i];
-		pad[3][oft] = key3[i];
-		++oft;
+		out0 += nblocks * (size_t)rate;
+		out1 += nblocks * (size_t)rate;
+		out2 += nblocks * (size_t)rate;
+		out3 += nblocks * (size_t)rate;
+		outlen -= nblocks * (size_t)rate;
 	}
 
-	qsc_memutils_clear((pad[0] + oft), (size_t)rate - oft);
-	qsc_memutils_clear((pad[1] + oft), (size_t)rate - oft);
-	qsc_memutils_clear((pad[2] + oft), (size_t)rate - oft);
-	qsc_memutils_clear((pad[3] + oft), (size_t)rate - oft);
+	if (outlen != 0)
+	{
+		qsc_keccakx4_squeezeblocks(state, rate, t[0], t[1], t[2], t[3], 1);
+		qsc_memutils_copy(out0, t[0], outlen);
+		qsc_memutils_copy(out1, t[1], outlen);
+		qsc_memutils_copy(out2, t[2], outlen);
+		qsc_memutils_copy(out3, t[3], outlen);
+	}
 
-	kmacx4_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], oft + (sizeof(uint64_t) - oft % sizeof(uint64_t)));
-	qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+	qsc_memutils_clear((uint8_t*)t, sizeof(t));
 }
 
-static void kmacx4_finalize(__m256i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
-	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3, size_t msglen,
-	uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen)
-{
-	uint8_t tmps[4][QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
-	uint8_t buf[sizeof(size_t) + 1] = { 0 };
-	uint8_t pad[4][QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
-	const size_t BLKCNT = outlen / (size_t)rate;
-	size_t bitlen;
-	size_t i;
-	size_t pos;
+#endif
 
-	pos = 0;
+#if defined(QSC_SYSTEM_HAS_AVX512)
 
-	while (msglen >= (size_t)rate)
+static void sha3x8_squeeze(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
+	uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen)
+{
+	uint8_t t[8][QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	const size_t nblocks = outlen / (size_t)rate;
+
+	if (nblocks != 0)
 	{
-		kmacx4_fast_absorb(state, (msg0 + pos), (msg1 + pos), (msg2 + pos), (msg3 + pos), (size_t)rate);
-		qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
-		pos += (size_t)rate;
-		msglen -= (size_t)rate;
+		qsc_keccakx8_squeezeblocks(state, rate, out0, out1, out2, out3, out4, out5, out6, out7, nblocks);
+
+		out0 += nblocks * (size_t)rate;
+		out1 += nblocks * (size_t)rate;
+		out2 += nblocks * (size_t)rate;
+		out3 += nblocks * (size_t)rate;
+		out4 += nblocks * (size_t)rate;
+		out5 += nblocks * (size_t)rate;
+		out6 += nblocks * (size_t)rate;
+		out7 += nblocks * (size_t)rate;
+		outlen -= nblocks * (size_t)rate;
 	}
 
-	if (msglen > 0)
+	if (outlen != 0)
 	{
-		qsc_memutils_copy(pad[0], (msg0 + pos), msglen);
-		qsc_memutils_copy(pad[1], (msg1 + pos), msglen);
-		qsc_memutils_copy(pad[2], (msg2 + pos), msglen);
-		qsc_memutils_copy(pad[3], (msg3 + pos), msglen);
+		qsc_keccakx8_squeezeblocks(state, rate, t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7], 1);
+		qsc_memutils_copy(out0, t[0], outlen);
+		qsc_memutils_copy(out1, t[1], outlen);
+		qsc_memutils_copy(out2, t[2], outlen);
+		qsc_memutils_copy(out3, t[3], outlen);
+		qsc_memutils_copy(out4, t[4], outlen);
+		qsc_memutils_copy(out5, t[5], outlen);
+		qsc_memutils_copy(out6, t[6], outlen);
+		qsc_memutils_copy(out7, t[7], outlen);
 	}
 
-	pos = msglen;
-	bitlen = keccak_right_encode(buf, outlen * 8);
+	qsc_memutils_clear((uint8_t*)t, sizeof(t));
+}
 
-	if (pos + bitlen >= (size_t)rate)
-	{
-		kmacx4_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], (size_t)rate);
-		qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
-		pos = 0;
-	}
+#endif
 
-	qsc_memutils_copy((pad[0] + pos), buf, bitlen);
-	pad[0][pos + bitlen] = QSC_KECCAK_KMAC_DOMAIN_ID;
-	pad[0][rate - 1] |= 128U;
-	qsc_memutils_copy((pad[1] + pos), (pad[0] + pos), (size_t)rate - pos);
-	qsc_memutils_copy((pad[2] + pos), (pad[0] + pos), (size_t)rate - pos);
-	qsc_memutils_copy((pad[3] + pos), (pad[0] + pos), (size_t)rate - pos);
+#if defined(QSC_SYSTEM_HAS_AVX2)
+static uint8_t cshakex_prefix(uint64_t pstate[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
+	const uint8_t* name, size_t namelen, const uint8_t* custom, size_t custlen)
+{
+	/* absorbs the shared name and customization strings once; without either, cSHAKE is SHAKE */
+	qsc_keccak_state ctx;
+	uint8_t domain;
 
-	kmacx4_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], (size_t)rate);
+	qsc_keccak_initialize_state(&ctx);
 
-	if (outlen > (size_t)rate)
+	if (custlen + namelen != 0)
 	{
-		qsc_keccakx4_squeezeblocks(state, rate, out0, out1, out2, out3, BLKCNT);
-
-		out0 += BLKCNT * (size_t)rate;
-		out1 += BLKCNT * (size_t)rate;
-		out2 += BLKCNT * (size_t)rate;
-		out3 += BLKCNT * (size_t)rate;
-		outlen -= BLKCNT * (size_t)rate;
+		qsc_keccak_absorb_custom(&ctx, rate, custom, custlen, name, namelen, QSC_KECCAK_PERMUTATION_ROUNDS);
+		domain = QSC_KECCAK_CSHAKE_DOMAIN_ID;
 	}
-
-	if (outlen != 0)
+	else
 	{
-		qsc_keccakx4_squeezeblocks(state, rate, tmps[0], tmps[1], tmps[2], tmps[3], 1);
-
-		for (i = 0; i < outlen; ++i)
-		{
-			out0[i] = tmps[0][i];
-			out1[i] = tmps[1][i];
-			out2[i] = tmps[2][i];
-			out3[i] = tmps[3][i];
-		}
+		domain = QSC_KECCAK_SHAKE_DOMAIN_ID;
 	}
-}
 
+	qsc_memutils_copy(pstate, ctx.state, sizeof(ctx.state));
+	qsc_keccak_dispose(&ctx);
+
+	return domain;
+}
 #endif
 
-void qsc_kmac_128x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
-	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
-	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen,
+void qsc_sha3_256x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
 	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3, size_t msglen)
 {
-	assert(key0 != NULL);
-	assert(key1 != NULL);
-	assert(key2 != NULL);
-	assert(key3 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
 	assert(msg0 != NULL);
 	assert(msg1 != NULL);
 	assert(msg2 != NULL);
 	assert(msg3 != NULL);
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+
+	qsc_keccakx4_absorb(state, qsc_keccak_rate_256, msg0, msg1, msg2, msg3, msglen, QSC_KECCAK_SHA3_DOMAIN_ID);
+	sha3x4_squeeze(state, qsc_keccak_rate_256, out0, out1, out2, out3, QSC_SHA3_256_HASH_SIZE);
+
+#else
+
+	qsc_sha3_compute256(out0, msg0, msglen);
+	qsc_sha3_compute256(out1, msg1, msglen);
+	qsc_sha3_compute256(out2, msg2, msglen);
+	qsc_sha3_compute256(out3, msg3, msglen);
+
+#endif
+}
+
+void qsc_cshake_256x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen,
+	const uint8_t* name, size_t namelen, const uint8_t* custom, size_t custlen)
+{
 	assert(out0 != NULL);
 	assert(out1 != NULL);
 	assert(out2 != NULL);
 	assert(out3 != NULL);
-	assert(keylen != 0);
-	assert(msglen != 0);
-	assert(outlen != 0);
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
 
 #if defined(QSC_SYSTEM_HAS_AVX2)
 
-	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
-	const uint8_t name[] = { 0x4B, 0x4D, 0x41, 0x43 };
+	uint64_t pstate[QSC_KECCAK_STATE_SIZE];
+	__m256i state[QSC_KECCAK_STATE_SIZE];
+	uint8_t domain;
 
-	kmacx4_customize(state, qsc_keccak_rate_128, key0, key1, key2, key3, keylen, cst0, cst1, cst2, cst3, cstlen, name, sizeof(name));
-	kmacx4_finalize(state, qsc_keccak_rate_128, msg0, msg1, msg2, msg3, msglen, out0, out1, out2, out3, outlen);
+	domain = cshakex_prefix(pstate, qsc_keccak_rate_256, name, namelen, custom, custlen);
+
+	for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		state[i] = _mm256_set1_epi64x((long long)pstate[i]);
+	}
+
+	qsc_keccakx4_absorb(state, qsc_keccak_rate_256, inp0, inp1, inp2, inp3, inplen, domain);
+	sha3x4_squeeze(state, qsc_keccak_rate_256, out0, out1, out2, out3, outlen);
+	qsc_memutils_clear((uint8_t*)state, sizeof(state));
+	qsc_memutils_clear((uint8_t*)pstate, sizeof(pstate));
 
 #else
 
-	qsc_kmac128_compute(out0, outlen, msg0, msglen, key0, keylen, cst0, cstlen);
-	qsc_kmac128_compute(out1, outlen, msg1, msglen, key1, keylen, cst1, cstlen);
-	qsc_kmac128_compute(out2, outlen, msg2, msglen, key2, keylen, cst2, cstlen);
-	qsc_kmac128_compute(out3, outlen, msg3, msglen, key3, keylen, cst3, cstlen);
+	qsc_cshake256_compute(out0, outlen, inp0, inplen, name, namelen, custom, custlen);
+	qsc_cshake256_compute(out1, outlen, inp1, inplen, name, namelen, custom, custlen);
+	qsc_cshake256_compute(out2, outlen, inp2, inplen, name, namelen, custom, custlen);
+	qsc_cshake256_compute(out3, outlen, inp3, inplen, name, namelen, custom, custlen);
 
 #endif
 }
 
-void qsc_kmac_256x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
-	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
-	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen,
-	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3, size_t msglen)
+void qsc_sha3_256x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7,
+	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3,
+	const uint8_t* msg4, const uint8_t* msg5, const uint8_t* msg6, const uint8_t* msg7, size_t msglen)
 {
-	assert(key0 != NULL);
-	assert(key1 != NULL);
-	assert(key2 != NULL);
-	assert(key3 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(out4 != NULL);
+	assert(out5 != NULL);
+	assert(out6 != NULL);
+	assert(out7 != NULL);
 	assert(msg0 != NULL);
 	assert(msg1 != NULL);
 	assert(msg2 != NULL);
 	assert(msg3 != NULL);
+	assert(msg4 != NULL);
+	assert(msg5 != NULL);
+	assert(msg6 != NULL);
+	assert(msg7 != NULL);
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+
+	qsc_keccakx8_absorb(state, qsc_keccak_rate_256, msg0, msg1, msg2, msg3, msg4, msg5, msg6, msg7, msglen, QSC_KECCAK_SHA3_DOMAIN_ID);
+	sha3x8_squeeze(state, qsc_keccak_rate_256, out0, out1, out2, out3, out4, out5, out6, out7, QSC_SHA3_256_HASH_SIZE);
+
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+
+	qsc_sha3_256x4(out0, out1, out2, out3, msg0, msg1, msg2, msg3, msglen);
+	qsc_sha3_256x4(out4, out5, out6, out7, msg4, msg5, msg6, msg7, msglen);
+
+#else
+
+	qsc_sha3_compute256(out0, msg0, msglen);
+	qsc_sha3_compute256(out1, msg1, msglen);
+	qsc_sha3_compute256(out2, msg2, msglen);
+	qsc_sha3_compute256(out3, msg3, msglen);
+	qsc_sha3_compute256(out4, msg4, msglen);
+	qsc_sha3_compute256(out5, msg5, msglen);
+	qsc_sha3_compute256(out6, msg6, msglen);
+	qsc_sha3_compute256(out7, msg7, msglen);
+
+#endif
+}
+
+void qsc_cshake_256x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
+	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen,
+	const uint8_t* name, size_t namelen, const uint8_t* custom, size_t custlen)
+{
 	assert(out0 != NULL);
 	assert(out1 != NULL);
 	assert(out2 != NULL);
 	assert(out3 != NULL);
-	assert(keylen != 0);
-	assert(msglen != 0);
-	assert(outlen != 0);
+	assert(out4 != NULL);
+	assert(out5 != NULL);
+	assert(out6 != NULL);
+	assert(out7 != NULL);
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
+	assert(inp4 != NULL);
+	assert(inp5 != NULL);
+	assert(inp6 != NULL);
+	assert(inp7 != NULL);
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	uint64_t pstate[QSC_KECCAK_STATE_SIZE];
+	__m512i state[QSC_KECCAK_STATE_SIZE];
+	uint8_t domain;
+
+	domain = cshakex_prefix(pstate, qsc_keccak_rate_256, name, namelen, custom, custlen);
+
+	for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		state[i] = _mm512_set1_epi64((long long)pstate[i]);
+	}
 
-#if defined(QSC_SYSTEM_HAS_AVX2)
+	qsc_keccakx8_absorb(state, qsc_keccak_rate_256, inp0, inp1, inp2, inp3, inp4, inp5, inp6, inp7, inplen, domain);
+	sha3x8_squeeze(state, qsc_keccak_rate_256, out0, out1, out2, out3, out4, out5, out6, out7, outlen);
+	qsc_memutils_clear((uint8_t*)state, sizeof(state));
+	qsc_memutils_clear((uint8_t*)pstate, sizeof(pstate));
 
-	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
-	const uint8_t name[] = { 0x4B, 0x4D, 0x41, 0x43 };
+#elif defined(QSC_SYSTEM_HAS_AVX2)
 
-	kmacx4_customize(state, qsc_keccak_rate_256, key0, key1, key2, key3, keylen, cst0, cst1, cst2, cst3, cstlen, name, sizeof(name));
-	kmacx4_finalize(state, qsc_keccak_rate_256, msg0, msg1, msg2, msg3, msglen, out0, out1, out2, out3, outlen);
+	qsc_cshake_256x4(out0, out1, out2, out3, outlen, inp0, inp1, inp2, inp3, inplen, name, namelen, custom, custlen);
+	qsc_cshake_256x4(out4, out5, out6, out7, outlen, inp4, inp5, inp6, inp7, inplen, name, namelen, custom, custlen);
 
 #else
 
-	qsc_kmac256_compute(out0, outlen, msg0, msglen, key0, keylen, cst0, cstlen);
-	qsc_kmac256_compute(out1, outlen, msg1, msglen, key1, keylen, cst1, cstlen);
-	qsc_kmac256_compute(out2, outlen, msg2, msglen, key2, keylen, cst2, cstlen);
-	qsc_kmac256_compute(out3, outlen, msg3, msglen, key3, keylen, cst3, cstlen);
+	qsc_cshake256_compute(out0, outlen, inp0, inplen, name, namelen, custom, custlen);
+	qsc_cshake256_compute(out1, outlen, inp1, inplen, name, namelen, custom, custlen);
+	qsc_cshake256_compute(out2, outlen, inp2, inplen, name, namelen, custom, custlen);
+	qsc_cshake256_compute(out3, outlen, inp3, inplen, name, namelen, custom, custlen);
+	qsc_cshake256_compute(out4, outlen, inp4, inplen, name, namelen, custom, custlen);
+	qsc_cshake256_compute(out5, outlen, inp5, inplen, name, namelen, custom, custlen);
+	qsc_cshake256_compute(out6, outlen, inp6, inplen, name, namelen, custom, custlen);
+	qsc_cshake256_compute(out7, outlen, inp7, inplen, name, namelen, custom, custlen);
 
 #endif
 }
 
-void qsc_kmac_512x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
-	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
-	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen,
-	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3, size_t msglen)
+/* incremental multi-lane Keccak */
+
+static void keccakx_permute_lanes(qsc_keccakx_state* ctx, uint32_t mask)
 {
-	assert(key0 != NULL);
-	assert(key1 != NULL);
-	assert(key2 != NULL);
-	assert(key3 != NULL);
-	assert(msg0 != NULL);
-	assert(msg1 != NULL);
-	assert(msg2 != NULL);
-	assert(msg3 != NULL);
-	assert(out0 != NULL);
-	assert(out1 != NULL);
-	assert(out2 != NULL);
-	assert(out3 != NULL);
-	assert(keylen != 0);
-	assert(msglen != 0);
-	assert(outlen != 0);
+	/* the lanes selected by the mask are permuted by one SIMD call;
+	   the states of the other lanes are written back unchanged */
+	uint64_t tmp[QSC_KECCAK_STATE_SIZE];
+	size_t lcnt;
+	size_t lidx;
 
-#if defined(QSC_SYSTEM_HAS_AVX2)
+	lcnt = 0;
+	lidx = 0;
 
-	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
-	const uint8_t name[] = { 0x4B, 0x4D, 0x41, 0x43 };
+	for (size_t j = 0; j < ctx->lanes; ++j)
+	{
+		if (((mask >> j) & 1UL) != 0)
+		{
+			lidx = j;
+			++lcnt;
+		}
+	}
 
-	kmacx4_customize(state, qsc_keccak_rate_512, key0, key1, key2, key3, keylen, cst0, cst1, cst2, cst3, cstlen, name, sizeof(name));
-	kmacx4_finalize(state, qsc_keccak_rate_512, msg0, msg1, msg2, msg3, msglen, out0, out1, out2, out3, outlen);
+	if (lcnt == 1)
+	{
+		/* a single lane is cheaper to permute on its own */
+		for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+		{
+			tmp[i] = ctx->state[i][lidx];
+		}
 
-#else
+		qsc_keccak_permute_p1600c(tmp, QSC_KECCAK_PERMUTATION_ROUNDS);
 
-	qsc_kmac512_compute(out0, outlen, msg0, msglen, key0, keylen, cst0, cstlen);
-	qsc_kmac512_compute(out1, outlen, msg1, msglen, key1, keylen, cst1, cstlen);
-	qsc_kmac512_compute(out2, outlen, msg2, msglen, key2, keylen, cst2, cstlen);
-	qsc_kmac512_compute(out3, outlen, msg3, msglen, key3, keylen, cst3, cstlen);
+		for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+		{
+			ctx->state[i][lidx] = tmp[i];
+		}
+
+		qsc_memutils_clear((uint8_t*)tmp, sizeof(tmp));
+	}
+	else if (lcnt != 0)
+	{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+		if (ctx->lanes == 8U)
+		{
+			__m512i wstate[QSC_KECCAK_STATE_SIZE];
+
+			for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+			{
+				wstate[i] = _mm512_loadu_si512((const void*)ctx->state[i]);
+			}
+
+			qsc_keccak_permute_p8x1600(wstate, QSC_KECCAK_PERMUTATION_ROUNDS);
+
+			for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+			{
+				_mm512_mask_storeu_epi64((void*)ctx->state[i], (__mmask8)mask, wstate[i]);
+			}
 
+			qsc_memutils_clear((uint8_t*)wstate, sizeof(wstate));
+		}
+		else
 #endif
-}
+		{
+#if defined(QSC_SYSTEM_HAS_AVX2)
+			for (size_t h = 0; h < ctx->lanes; h += 4)
+			{
+				const uint32_t hmask = (mask >> h) & 0x0FUL;
 
-/* parallel kmac x8 */
+				if (hmask != 0)
+				{
+					__m256i wstate[QSC_KECCAK_STATE_SIZE];
+					const __m256i smask = _mm256_set_epi64x(-(long long)((hmask >> 3) & 1U), -(long long)((hmask >> 2) & 1U),
+						-(long long)((hmask >> 1) & 1U), -(long long)(hmask & 1U));
 
-#if defined(QSC_SYSTEM_HAS_AVX512)
+					for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+					{
+						wstate[i] = _mm256_loadu_si256((const __m256i*)&ctx->state[i][h]);
+					}
 
-static void kmacx8_fast_absorb(__m512i state[QSC_KECCAK_STATE_SIZE],
-	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
-	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7,
-	size_t inplen)
-{
-	__m512i t;
-	uint64_t tmps[8] = { 0 };
-	size_t pos;
+					qsc_keccak_permute_p4x1600(wstate, QSC_KECCAK_PERMUTATION_ROUNDS);
 
-	pos = 0;
+					for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+					{
+						_mm256_maskstore_epi64((long long*)&ctx->state[i][h], smask, wstate[i]);
+					}
 
-	for (size_t i = 0; i < inplen / sizeof(uint64_t); ++i)
-	{
-		tmps[0] = qsc_intutils_le8to64((inp0 + pos));
-		tmps[1] = qsc_intutils_le8to64((inp1 + pos));
-		tmps[2] = qsc_intutils_le8to64((inp2 + pos));
-		tmps[3] = qsc_intutils_le8to64((inp3 + pos));
-		tmps[4] = qsc_intutils_le8to64((inp4 + pos));
-		tmps[5] = qsc_intutils_le8to64((inp5 + pos));
-		tmps[6] = qsc_intutils_le8to64((inp6 + pos));
-		tmps[7] = qsc_intutils_le8to64((inp7 + pos));
+					qsc_memutils_clear((uint8_t*)wstate, sizeof(wstate));
+				}
+			}
+#else
+			for (size_t j = 0; j < ctx->lanes; ++j)
+			{
+				if (((mask >> j) & 1UL) != 0)
+				{
+					for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+					{
+						tmp[i] = ctx->state[i][j];
+					}
+
+					qsc_keccak_permute_p1600c(tmp, QSC_KECCAK_PERMUTATION_ROUNDS);
+
+					for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+					{
+						ctx->state[i][j] = tmp[i];
+					}
+				}
+			}
 
-		t = _mm512_loadu_si512((const __m512i*)tmps);
-		state[i] = _mm512_xor_si512(state[i], t);
-		pos += 8;
+			qsc_memutils_clear((uint8_t*)tmp, sizeof(tmp));
+#endif
+		}
 	}
 }
 
-static void kmacx8_customize(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
-	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
-	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
-	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
-	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen,
-	const uint8_t* name, size_t nmelen)
+static bool keccakx_absorb_round(qsc_keccakx_state* ctx)
 {
-	uint8_t pad[8][QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
-	size_t oft;
-	size_t i;
+	/* absorbs the oldest queued block of every lane that has one, under a single permutation;
+	   returns false when no lane had a block waiting */
+	const size_t RATE = (size_t)ctx->rate;
+	const uint8_t* blk;
+	uint32_t mask;
 
-	/* stage 1: name + custom */
-
-	oft = keccak_left_encode(pad[0], rate);
-	oft += keccak_left_encode((pad[0] + oft), nmelen * 8);
+	mask = 0;
 
-	for (i = 0; i < nmelen; ++i)
+	for (size_t j = 0; j < ctx->lanes; ++j)
 	{
-		pad[0][oft + i] = name[i];
-	}
+		if (ctx->count[j] != 0)
+		{
+			blk = ctx->buffer[j][ctx->head[j]];
 
-	oft += nmelen;
-	oft += keccak_left_encode((pad[0] + oft), cstlen * 8);
-	qsc_memutils_copy(pad[1], pad[0], oft);
-	qsc_memutils_copy(pad[2], pad[0], oft);
-	qsc_memutils_copy(pad[3], pad[0], oft);
-	qsc_memutils_copy(pad[4], pad[0], oft);
-	qsc_memutils_copy(pad[5], pad[0], oft);
-	qsc_memutils_copy(pad[6], pad[0], oft);
-	qsc_memutils_copy(pad[7], pad[0], oft);
+			for (size_t i = 0; i < RATE / sizeof(uint64_t); ++i)
+			{
+				ctx->state[i][j] ^= qsc_intutils_le8to64(blk + (i * sizeof(uint64_t)));
+			}
 
-	for (i = 0; i < cstlen; ++i)
-	{
-		if (oft == rate)
-		{
-			kmacx8_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7], (size_t)rate);
-			qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
-			oft = 0;
+			qsc_memutils_clear(ctx->buffer[j][ctx->head[j]], RATE);
+			ctx->head[j] = (ctx->head[j] + 1) % QSC_KECCAKX_QUEUE_DEPTH;
+			--ctx->count[j];
+			mask |= (1UL << j);
 		}
-
-		pad[0][oft] = cst0[i];
-		pad[1][oft] = cst1[i];
-		pad[2][oft] = cst2[i];
-		pad[3][oft] = cst3[i];
-		pad[4][oft] = cst4[i];
-		pad[5][oft] = cst5[i];
-		pad[6][oft] = cst6[i];
-		pad[7][oft] = cst7[i];
-		++oft;
 	}
 
-	kmacx8_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7], oft + (sizeof(uint64_t) - oft % sizeof(uint64_t)));
-	qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
-
-	/* stage 2: key */
-
-	qsc_memutils_clear(pad[0], oft);
-	qsc_memutils_clear(pad[1], oft);
-	qsc_memutils_clear(pad[2], oft);
-	qsc_memutils_clear(pad[3], oft);
-	qsc_memutils_clear(pad[4], oft);
-	qsc_memutils_clear(pad[5], oft);
-	qsc_memutils_clear(pad[6], oft);
-	qsc_memutils_clear(pad[7], oft);
+	keccakx_permute_lanes(ctx, mask);
 
-	oft = keccak_left_encode(pad[0], rate);
-	oft += keccak_left_encode((pad[0] + oft), keylen * 8);
-	qsc_memutils_copy(pad[1], pad[0], oft);
-	qsc_memutils_copy(pad[2], pad[0], oft);
-	qsc_memutils_copy(pad[3], pad[0], oft);
-	qsc_memutils_copy(pad[4], pad[0], oft);
-	qsc_memutils_copy(pad[5], pad[0], oft);
-	qsc_memutils_copy(pad[6], pad[0], oft);
-	qsc_memutils_copy(pad[7], pad[0], oft);
+	return (mask != 0);
+}
 
-	for (i = 0; i < keylen; ++i)
+static void keccakx_drain(qsc_keccakx_state* ctx)
+{
+	while (keccakx_absorb_round(ctx) == true)
 	{
-		if (oft == rate)
-		{
-			kmacx8_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7], rate);
-			qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
-			oft = 0;
-		}
+	}
+}
 
-		pad[0][oft] = key0[i];
-		pad[1][oft] = key1[i];
-		pad[2][oft] = key2[i];
-		pad[3][oft] = key3[i];
-		pad[4][oft] = key4[i];
-		pad[5][oft] = key5[i];
-		pad[6][oft] = key6[i];
-		pad[7][oft] = key7[i];
-		++oft;
+static size_t keccakx_queue(qsc_keccakx_state* ctx, size_t lane, const uint8_t* input, size_t inplen)
+{
+	/* copies input into the lane's open block and returns the number of bytes taken;
+	   a completed block is queued and the next slot is opened */
+	const size_t RATE = (size_t)ctx->rate;
+	size_t blen;
+	size_t tail;
+
+	tail = (ctx->head[lane] + ctx->count[lane]) % QSC_KECCAKX_QUEUE_DEPTH;
+	blen = qsc_intutils_min(RATE - ctx->position[lane], inplen);
+	qsc_memutils_copy(ctx->buffer[lane][tail] + ctx->position[lane], input, blen);
+	ctx->position[lane] += blen;
+
+	if (ctx->position[lane] == RATE)
+	{
+		++ctx->count[lane];
+		ctx->position[lane] = 0;
 	}
 
-	kmacx8_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7], oft + (sizeof(uint64_t) - oft % sizeof(uint64_t)));
-	qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+	return blen;
 }
 
-static void kmacx8_finalize(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate rate,
-	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3,
-	const uint8_t* msg4, const uint8_t* msg5, const uint8_t* msg6, const uint8_t* msg7, size_t msglen,
-	uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
-	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen)
+static void keccakx_lane_pad(qsc_keccakx_state* ctx, size_t lane)
 {
-	uint8_t tmps[8][QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
-	uint8_t buf[sizeof(size_t) + 1] = { 0 };
-	uint8_t pad[8][QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
-	const size_t BLKCNT = outlen / (size_t)rate;
-	size_t bitlen;
-	size_t i;
-	size_t pos;
-
-	pos = 0;
+	/* the open block is padded and queued behind any full blocks still waiting */
+	const size_t RATE = (size_t)ctx->rate;
+	size_t tail;
 
-	while (msglen >= (size_t)rate)
+	if (ctx->count[lane] == QSC_KECCAKX_QUEUE_DEPTH)
 	{
-		kmacx8_fast_absorb(state, (msg0 + pos), (msg1 + pos), (msg2 + pos), (msg3 + pos),
-			(msg4 + pos), (msg5 + pos), (msg6 + pos), (msg7 + pos), (size_t)rate);
-
-		qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
-		pos += (size_t)rate;
-		msglen -= (size_t)rate;
+		keccakx_absorb_round(ctx);
 	}
 
-	if (msglen > 0)
+	tail = (ctx->head[lane] + ctx->count[lane]) % QSC_KECCAKX_QUEUE_DEPTH;
+	ctx->buffer[lane][tail][ctx->position[lane]] = ctx->domain;
+	ctx->buffer[lane][tail][RATE - 1] |= 128U;
+	++ctx->count[lane];
+	ctx->position[lane] = 0;
+}
+
+static void keccakx_lane_extract(const qsc_keccakx_state* ctx, size_t lane, uint8_t* output, size_t outlen)
+{
+	uint8_t tmp[QSC_KECCAK_STATE_BYTE_SIZE];
+
+	for (size_t i = 0; i < (size_t)ctx->rate / sizeof(uint64_t); ++i)
 	{
-		qsc_memutils_copy(pad[0], (msg0 + pos), msglen);
-		qsc_memutils_copy(pad[1], (msg1 + pos), msglen);
-		qsc_memutils_copy(pad[2], (msg2 + pos), msglen);
-		qsc_memutils_copy(pad[3], (msg3 + pos), msglen);
-		qsc_memutils_copy(pad[4], (msg4 + pos), msglen);
-		qsc_memutils_copy(pad[5], (msg5 + pos), msglen);
-		qsc_memutils_copy(pad[6], (msg6 + pos), msglen);
-		qsc_memutils_copy(pad[7], (msg7 + pos), msglen);
+		qsc_intutils_le64to8(tmp + (i * sizeof(uint64_t)), ctx->state[i][lane]);
 	}
 
-	pos = msglen;
-	bitlen = keccak_right_encode(buf, outlen * 8);
+	qsc_memutils_copy(output, tmp, outlen);
+	qsc_memutils_clear(tmp, sizeof(tmp));
+}
 
-	if (pos + bitlen >= (size_t)rate)
+QSC_SYSTEM_OPTIMIZE_IGNORE
+void qsc_keccakx_dispose(qsc_keccakx_state* ctx)
+{
+	assert(ctx != NULL);
+
+	if (ctx != NULL)
 	{
-		kmacx8_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7], (size_t)rate);
-		qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
-		pos = 0;
+		qsc_memutils_clear((uint8_t*)ctx, sizeof(qsc_keccakx_state));
 	}
+}
+QSC_SYSTEM_OPTIMIZE_RESUME
 
-	qsc_memutils_copy((pad[0] + pos), buf, bitlen);
-	pad[0][pos + bitlen] = QSC_KECCAK_KMAC_DOMAIN_ID;
-	pad[0][rate - 1] |= 128U;
+void qsc_keccakx_finalize(qsc_keccakx_state* ctx, uint8_t* const* outputs, size_t outlen)
+{
+	assert(ctx != NULL);
+	assert(outputs != NULL);
 
-	qsc_memutils_copy((pad[1] + pos), (pad[0] + pos), (size_t)rate - pos);
-	qsc_memutils_copy((pad[2] + pos), (pad[0] + pos), (size_t)rate - pos);
-	qsc_memutils_copy((pad[3] + pos), (pad[0] + pos), (size_t)rate - pos);
-	qsc_memutils_copy((pad[4] + pos), (pad[0] + pos), (size_t)rate - pos);
-	qsc_memutils_copy((pad[5] + pos), (pad[0] + pos), (size_t)rate - pos);
-	qsc_memutils_copy((pad[6] + pos), (pad[0] + pos), (size_t)rate - pos);
-	qsc_memutils_copy((pad[7] + pos), (pad[0] + pos), (size_t)rate - pos);
+	if (ctx != NULL && outputs != NULL)
+	{
+		size_t blen;
+		size_t opos;
+		uint32_t mask;
+
+		mask = 0;
+
+		for (size_t j = 0; j < ctx->lanes; ++j)
+		{
+			if (outputs[j] != NULL)
+			{
+				keccakx_lane_pad(ctx, j);
+				mask |= (1UL << j);
+			}
+		}
 
-	kmacx8_fast_absorb(state, pad[0], pad[1], pad[2], pad[3], pad[4], pad[5], pad[6], pad[7], (size_t)rate);
+		keccakx_drain(ctx);
+		opos = 0;
 
-	if (outlen > (size_t)rate)
-	{
-		qsc_keccakx8_squeezeblocks(state, rate, out0, out1, out2, out3, out4, out5, out6, out7, BLKCNT);
+		/* the finalized lanes are squeezed together, one shared permutation per block */
+		while (opos < outlen)
+		{
+			if (opos != 0)
+			{
+				keccakx_permute_lanes(ctx, mask);
+			}
 
-		out0 += BLKCNT * (size_t)rate;
-		out1 += BLKCNT * (size_t)rate;
-		out2 += BLKCNT * (size_t)rate;
-		out3 += BLKCNT * (size_t)rate;
-		out4 += BLKCNT * (size_t)rate;
-		out5 += BLKCNT * (size_t)rate;
-		out6 += BLKCNT * (size_t)rate;
-		out7 += BLKCNT * (size_t)rate;
-		outlen -= BLKCNT * (size_t)rate;
-	}
+			blen = qsc_intutils_min((size_t)ctx->rate, outlen - opos);
 
-	if (outlen != 0)
-	{
-		qsc_keccakx8_squeezeblocks(state, rate, tmps[0], tmps[1], tmps[2], tmps[3], tmps[4], tmps[5], tmps[6], tmps[7], 1);
+			for (size_t j = 0; j < ctx->lanes; ++j)
+			{
+				if (outputs[j] != NULL)
+				{
+					keccakx_lane_extract(ctx, j, outputs[j] + opos, blen);
+				}
+			}
 
-		for (i = 0; i < outlen; ++i)
+			opos += blen;
+		}
+
+		for (size_t j = 0; j < ctx->lanes; ++j)
 		{
-			out0[i] = tmps[0][i];
-			out1[i] = tmps[1][i];
-			out2[i] = tmps[2][i];
-			out3[i] = tmps[3][i];
-			out4[i] = tmps[4][i];
-			out5[i] = tmps[5][i];
-			out6[i] = tmps[6][i];
-			out7[i] = tmps[7][i];
+			if (outputs[j] != NULL)
+			{
+				qsc_keccakx_lane_reset(ctx, j);
+			}
 		}
 	}
 }
 
-#endif
-
-void qsc_kmac_128x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
-	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen,
-	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
-	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
-	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
-	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen,
-	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3,
-	const uint8_t* msg4, const uint8_t* msg5, const uint8_t* msg6, const uint8_t* msg7, size_t msglen)
+void qsc_keccakx_initialize(qsc_keccakx_state* ctx, size_t lanes, qsc_keccak_rate rate, uint8_t domain)
 {
-	assert(key0 != NULL);
-	assert(key1 != NULL);
-	assert(key2 != NULL);
-	assert(key3 != NULL);
-	assert(key4 != NULL);
-	assert(key5 != NULL);
-	assert(key6 != NULL);
-	assert(key7 != NULL);
-	assert(msg0 != NULL);
-	assert(msg1 != NULL);
-	assert(msg2 != NULL);
-	assert(msg3 != NULL);
-	assert(msg4 != NULL);
-	assert(msg5 != NULL);
-	assert(msg6 != NULL);
-	assert(msg7 != NULL);
-	assert(out0 != NULL);
-	assert(out1 != NULL);
-	assert(out2 != NULL);
-	assert(out3 != NULL);
-	assert(out4 != NULL);
-	assert(out5 != NULL);
-	assert(out6 != NULL);
-	assert(out7 != NULL);
-	assert(keylen != 0);
-	assert(msglen != 0);
-	assert(outlen != 0);
-
-#if defined(QSC_SYSTEM_HAS_AVX512)
-
-	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
-	const uint8_t name[] = { 0x4B, 0x4D, 0x41, 0x43 };
+	assert(ctx != NULL);
+	assert(lanes == 4U || lanes == 8U);
 
-	kmacx8_customize(state, qsc_keccak_rate_128, key0, key1, key2, key3, key4, key5, key6, key7, keylen,
-		cst0, cst1, cst2, cst3, cst4, cst5, cst6, cst7, cstlen, name, sizeof(name));
-	kmacx8_finalize(state, qsc_keccak_rate_128, msg0, msg1, msg2, msg3, msg4, msg5, msg6, msg7, msglen,
-		out0, out1, out2, out3, out4, out5, out6, out7, outlen);
+	if (ctx != NULL && (lanes == 4U || lanes == 8U))
+	{
+		qsc_memutils_clear((uint8_t*)ctx, sizeof(qsc_keccakx_state));
+		ctx->lanes = lanes;
+		ctx->rate = rate;
+		ctx->domain = domain;
+	}
+}
 
-#elif defined(QSC_SYSTEM_HAS_AVX2)
+void qsc_keccakx_initialize_custom(qsc_keccakx_state* ctx, size_t lanes, qsc_keccak_rate rate,
+	const uint8_t* name, size_t namelen, const uint8_t* custom, size_t custlen)
+{
+	assert(ctx != NULL);
+	assert(lanes == 4U || lanes == 8U);
 
-	qsc_kmac_128x4(out0, out1, out2, out3, outlen, key0, key1, key2, key3, keylen,
-		cst0, cst1, cst2, cst3, cstlen, msg0, msg1, msg2, msg3, msglen);
-	qsc_kmac_128x4(out4, out5, out6, out7, outlen, key4, key5, key6, key7, keylen,
-		cst4, cst5, cst6, cst7, cstlen, msg4, msg5, msg6, msg7, msglen);
+	if (ctx != NULL && (lanes == 4U || lanes == 8U))
+	{
+		qsc_keccak_state kctx;
 
-#else
+		qsc_keccakx_initialize(ctx, lanes, rate, QSC_KECCAK_SHAKE_DOMAIN_ID);
 
-	qsc_kmac128_compute(out0, outlen, msg0, msglen, key0, keylen, cst0, cstlen);
-	qsc_kmac128_compute(out1, outlen, msg1, msglen, key1, keylen, cst1, cstlen);
-	qsc_kmac128_compute(out2, outlen, msg2, msglen, key2, keylen, cst2, cstlen);
-	qsc_kmac128_compute(out3, outlen, msg3, msglen, key3, keylen, cst3, cstlen);
-	qsc_kmac128_compute(out4, outlen, msg4, msglen, key4, keylen, cst4, cstlen);
-	qsc_kmac128_compute(out5, outlen, msg5, msglen, key5, keylen, cst5, cstlen);
-	qsc_kmac128_compute(out6, outlen, msg6, msglen, key6, keylen, cst6, cstlen);
-	qsc_kmac128_compute(out7, outlen, msg7, msglen, key7, keylen, cst7, cstlen);
+		/* the name and customization strings are absorbed once and copied into every lane */
+		if (custlen + namelen != 0)
+		{
+			qsc_keccak_initialize_state(&kctx);
+			qsc_keccak_absorb_custom(&kctx, rate, custom, custlen, name, namelen, QSC_KECCAK_PERMUTATION_ROUNDS);
+			qsc_memutils_copy(ctx->istate, kctx.state, sizeof(ctx->istate));
+			qsc_keccak_dispose(&kctx);
+			ctx->domain = QSC_KECCAK_CSHAKE_DOMAIN_ID;
 
-#endif
+			for (size_t j = 0; j < lanes; ++j)
+			{
+				qsc_keccakx_lane_reset(ctx, j);
+			}
+		}
+	}
 }
 
-void qsc_kmac_256x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
-	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen,
-	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
-	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
-	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
-	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen,
-	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3,
-	const uint8_t* msg4, const uint8_t* msg5, const uint8_t* msg6, const uint8_t* msg7, size_t msglen)
+void qsc_keccakx_lane_finalize(qsc_keccakx_state* ctx, size_t lane, uint8_t* output, size_t outlen)
 {
-	assert(key0 != NULL);
-	assert(key1 != NULL);
-	assert(key2 != NULL);
-	assert(key3 != NULL);
-	assert(key4 != NULL);
-	assert(key5 != NULL);
-	assert(key6 != NULL);
-	assert(key7 != NULL);
-	assert(msg0 != NULL);
-	assert(msg1 != NULL);
-	assert(msg2 != NULL);
-	assert(msg3 != NULL);
-	assert(msg4 != NULL);
-	assert(msg5 != NULL);
-	assert(msg6 != NULL);
-	assert(msg7 != NULL);
-	assert(out0 != NULL);
-	assert(out1 != NULL);
-	assert(out2 != NULL);
-	assert(out3 != NULL);
-	assert(out4 != NULL);
-	assert(out5 != NULL);
-	assert(out6 != NULL);
-	assert(out7 != NULL);
-	assert(keylen != 0);
-	assert(msglen != 0);
-	assert(outlen != 0);
+	assert(ctx != NULL);
+	assert(output != NULL);
+	assert(lane < ctx->lanes);
 
-#if defined(QSC_SYSTEM_HAS_AVX512)
+	if (ctx != NULL && output != NULL && lane < ctx->lanes)
+	{
+		size_t blen;
 
-	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
-	const uint8_t name[] = { 0x4B, 0x4D, 0x41, 0x43 };
+		/* the drain also absorbs the blocks queued in the other lanes */
+		keccakx_lane_pad(ctx, lane);
+		keccakx_drain(ctx);
 
-	kmacx8_customize(state, qsc_keccak_rate_256, key0, key1, key2, key3, key4, key5, key6, key7, keylen,
-		cst0, cst1, cst2, cst3, cst4, cst5, cst6, cst7, cstlen, name, sizeof(name));
-	kmacx8_finalize(state, qsc_keccak_rate_256, msg0, msg1, msg2, msg3, msg4, msg5, msg6, msg7, msglen,
-		out0, out1, out2, out3, out4, out5, out6, out7, outlen);
+		while (outlen != 0)
+		{
+			blen = qsc_intutils_min((size_t)ctx->rate, outlen);
+			keccakx_lane_extract(ctx, lane, output, blen);
+			output += blen;
+			outlen -= blen;
 
-#elif defined(QSC_SYSTEM_HAS_AVX2)
+			if (outlen != 0)
+			{
+				keccakx_permute_lanes(ctx, 1UL << lane);
+			}
+		}
 
-	qsc_kmac_256x4(out0, out1, out2, out3, outlen, key0, key1, key2, key3, keylen,
-		cst0, cst1, cst2, cst3, cstlen, msg0, msg1, msg2, msg3, msglen);
-	qsc_kmac_256x4(out4, out5, out6, out7, outlen, key4, key5, key6, key7, keylen,
-		cst4, cst5, cst6, cst7, cstlen, msg4, msg5, msg6, msg7, msglen);
+		qsc_keccakx_lane_reset(ctx, lane);
+	}
+}
 
-#else
+void qsc_keccakx_lane_reset(qsc_keccakx_state* ctx, size_t lane)
+{
+	assert(ctx != NULL);
+	assert(lane < ctx->lanes);
 
-	qsc_kmac256_compute(out0, outlen, msg0, msglen, key0, keylen, cst0, cstlen);
-	qsc_kmac256_compute(out1, outlen, msg1, msglen, key1, keylen, cst1, cstlen);
-	qsc_kmac256_compute(out2, outlen, msg2, msglen, key2, keylen, cst2, cstlen);
-	qsc_kmac256_compute(out3, outlen, msg3, msglen, key3, keylen, cst3, cstlen);
-	qsc_kmac256_compute(out4, outlen, msg4, msglen, key4, keylen, cst4, cstlen);
-	qsc_kmac256_compute(out5, outlen, msg5, msglen, key5, keylen, cst5, cstlen);
-	qsc_kmac256_compute(out6, outlen, msg6, msglen, key6, keylen, cst6, cstlen);
-	qsc_kmac256_compute(out7, outlen, msg7, msglen, key7, keylen, cst7, cstlen);
+	if (ctx != NULL && lane < ctx->lanes)
+	{
+		for (size_t i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+		{
+			ctx->state[i][lane] = ctx->istate[i];
+		}
 
-#endif
+		qsc_memutils_clear((uint8_t*)ctx->buffer[lane], sizeof(ctx->buffer[lane]));
+		ctx->count[lane] = 0;
+		ctx->head[lane] = 0;
+		ctx->position[lane] = 0;
+	}
 }
 
-void qsc_kmac_512x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
-	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen,
-	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
-	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
-	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
-	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen,
-	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3,
-	const uint8_t* msg4, const uint8_t* msg5, const uint8_t* msg6, const uint8_t* msg7, size_t msglen)
+void qsc_keccakx_lane_update(qsc_keccakx_state* ctx, size_t lane, const uint8_t* input, size_t inplen)
 {
-	assert(key0 != NULL);
-	assert(key1 != NULL);
-	assert(key2 != NULL);
-	assert(key3 != NULL);
-	assert(key4 != NULL);
-	assert(key5 != NULL);
-	assert(key6 != NULL);
-	assert(key7 != NULL);
-	assert(msg0 != NULL);
-	assert(msg1 != NULL);
-	assert(msg2 != NULL);
-	assert(msg3 != NULL);
-	assert(msg4 != NULL);
-	assert(msg5 != NULL);
-	assert(msg6 != NULL);
-	assert(msg7 != NULL);
-	assert(out0 != NULL);
-	assert(out1 != NULL);
-	assert(out2 != NULL);
-	assert(out3 != NULL);
-	assert(out4 != NULL);
-	assert(out5 != NULL);
-	assert(out6 != NULL);
-	assert(out7 != NULL);
-	assert(keylen != 0);
-	assert(msglen != 0);
-	assert(outlen != 0);
+	assert(ctx != NULL);
+	assert(input != NULL || inplen == 0);
+	assert(lane < ctx->lanes);
 
-#if defined(QSC_SYSTEM_HAS_AVX512)
+	if (ctx != NULL && input != NULL && lane < ctx->lanes)
+	{
+		size_t blen;
 
-	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
-	const uint8_t name[] = { 0x4B, 0x4D, 0x41, 0x43 };
+		/* a full queue absorbs one block from every lane, so lanes fed in turn stay in step */
+		while (inplen != 0)
+		{
+			if (ctx->count[lane] == QSC_KECCAKX_QUEUE_DEPTH)
+			{
+				keccakx_absorb_round(ctx);
+			}
 
-	kmacx8_customize(state, qsc_keccak_rate_512, key0, key1, key2, key3, key4, key5, key6, key7, keylen,
-		cst0, cst1, cst2, cst3, cst4, cst5, cst6, cst7, cstlen, name, sizeof(name));
-	kmacx8_finalize(state, qsc_keccak_rate_512, msg0, msg1, msg2, msg3, msg4, msg5, msg6, msg7, msglen,
-		out0, out1, out2, out3, out4, out5, out6, out7, outlen);
+			blen = keccakx_queue(ctx, lane, input, inplen);
+			input += blen;
+			inplen -= blen;
+		}
+	}
+}
 
-#elif defined(QSC_SYSTEM_HAS_AVX2)
+void qsc_keccakx_update(qsc_keccakx_state* ctx, const uint8_t* const* inputs, const size_t* inplens)
+{
+	assert(ctx != NULL);
+	assert(inputs != NULL);
+	assert(inplens != NULL);
 
-	qsc_kmac_512x4(out0, out1, out2, out3, outlen, key0, key1, key2, key3, keylen,
-		cst0, cst1, cst2, cst3, cstlen, msg0, msg1, msg2, msg3, msglen);
-	qsc_kmac_512x4(out4, out5, out6, out7, outlen, key4, key5, key6, key7, keylen,
-		cst4, cst5, cst6, cst7, cstlen, msg4, msg5, msg6, msg7, msglen);
+	if (ctx != NULL && inputs != NULL && inplens != NULL)
+	{
+		size_t off[QSC_KECCAKX_LANES_MAX] = { 0 };
+		bool more;
 
-#else
+		/* every lane queue is topped up before a round, so the lanes share the permutations;
+		   lanes with shorter inputs drop out of the rounds */
+		do
+		{
+			more = false;
 
-	qsc_kmac512_compute(out0, outlen, msg0, msglen, key0, keylen, cst0, cstlen);
-	qsc_kmac512_compute(out1, outlen, msg1, msglen, key1, keylen, cst1, cstlen);
-	qsc_kmac512_compute(out2, outlen, msg2, msglen, key2, keylen, cst2, cstlen);
-	qsc_kmac512_compute(out3, outlen, msg3, msglen, key3, keylen, cst3, cstlen);
-	qsc_kmac512_compute(out4, outlen, msg4, msglen, key4, keylen, cst4, cstlen);
-	qsc_kmac512_compute(out5, outlen, msg5, msglen, key5, keylen, cst5, cstlen);
-	qsc_kmac512_compute(out6, outlen, msg6, msglen, key6, keylen, cst6, cstlen);
-	qsc_kmac512_compute(out7, outlen, msg7, msglen, key7, keylen, cst7, cstlen);
+			for (size_t j = 0; j < ctx->lanes; ++j)
+			{
+				if (inputs[j] != NULL)
+				{
+					while (off[j] < inplens[j] && ctx->count[j] < QSC_KECCAKX_QUEUE_DEPTH)
+					{
+						off[j] += keccakx_queue(ctx, j, inputs[j] + off[j], inplens[j] - off[j]);
+					}
+
+					more = (more == true || off[j] < inplens[j]);
+				}
+			}
 
-#endif
+			if (more == true)
+			{
+				keccakx_absorb_round(ctx);
+			}
+		}
+		while (more == true);
+	}
 }
-
@@ -134,6 +134,17 @@ QSC_CPLUSPLUS_ENABLED_START
 */
 #define QSC_KECCAK_PERMUTATION_MIN_ROUNDS 12ULL
 
+/*!
+* \def QSC_KECCAK_AVX512_ENABLED
+* \brief Build the AVX-512 single-state Keccak permutation.
+* The kernel is selected at runtime when the CPU and OS support AVX-512F, so it is safe in portable builds.
+* Define QSC_KECCAK_AVX512_DISABLED to build only the reference permutation.
+*/
+#if !defined(QSC_KECCAK_AVX512_ENABLED) && !defined(QSC_KECCAK_AVX512_DISABLED) && defined(QSC_SYSTEM_ARCH_IX86_64) && !defined(QSC_SYSTEM_OS_BSD) && \
+	(defined(QSC_SYSTEM_COMPILER_MSC) || defined(QSC_SYSTEM_COMPILER_GCC))
+#	define QSC_KECCAK_AVX512_ENABLED
+#endif
+
 /*!
 * \def QSC_KECCAK_SHA3_DOMAIN_ID
 * \brief The SHA3 domain id
@@ -432,6 +443,22 @@ QSC_EXPORT_API void qsc_sha3_compute128(uint8_t* output, const uint8_t* message,
 */
 QSC_EXPORT_API void qsc_sha3_compute256(uint8_t* output, const uint8_t* message, size_t msglen);
 
+/**
+* \brief Compute the SHA3-256 hash codes of a batch of variable length messages.
+* Messages are bucketed by their padded block count, and each bucket is hashed across the lanes
+* of the 8-way (AVX-512) or 4-way (AVX2) Keccak permutation; messages left in a bucket that
+* would fill fewer than half of the lanes are hashed one at a time.
+* The hash codes are identical to those of qsc_sha3_compute256.
+*
+* \warning Each output array must be at least 32 bytes in length.
+*
+* \param outputs:	[uint8_t* const*] The array of hash code output pointers
+* \param messages:	[const uint8_t* const*] The array of message pointers
+* \param msglens:	[const size_t*] The array of message lengths
+* \param count:	[size_t] The number of messages
+*/
+QSC_EXPORT_API void qsc_sha3_compute256_batch(uint8_t* const* outputs, const uint8_t* const* messages, const size_t* msglens, size_t count);
+
 /**
 * \brief Process a message with SHA3-512 and return the hash code in the output byte array.
 * Short form api: processes the entire message and computes the hash code with a single call.
@@ -510,6 +537,19 @@ QSC_EXPORT_API void qsc_shake128_compute(uint8_t* output, size_t outlen, const u
 */
 QSC_EXPORT_API void qsc_shake256_compute(uint8_t* output, size_t outlen, const uint8_t* key, size_t keylen);
 
+/**
+* \brief Generate SHAKE-256 output for a batch of variable length inputs.
+* Inputs are scheduled across the Keccak lanes in the same way as qsc_sha3_compute256_batch,
+* and the output is identical to that of qsc_shake256_compute.
+*
+* \param outputs:	[uint8_t* const*] The array of output pointers
+* \param outlen:	[size_t] The number of output bytes to generate for each input
+* \param messages:	[const uint8_t* const*] The array of input pointers
+* \param msglens:	[const size_t*] The array of input lengths
+* \param count:	[size_t] The number of inputs
+*/
+QSC_EXPORT_API void qsc_shake256_batch(uint8_t* const* outputs, size_t outlen, const uint8_t* const* messages, const size_t* msglens, size_t count);
+
 /**
 * \brief Key a SHAKE-512 instance, and generate an array of pseudo-random bytes.
 * Short form api: processes the key and generates the pseudo-random output with a single call.
@@ -646,6 +686,58 @@ QSC_EXPORT_API void qsc_cshake_squeezeblocks(qsc_keccak_state* ctx, qsc_keccak_r
 */
 QSC_EXPORT_API void qsc_cshake_update(qsc_keccak_state* ctx, qsc_keccak_rate rate, const uint8_t* key, size_t keylen);
 
+/*!
+* \struct qsc_cshake_prefix_state
+* \brief A precomputed cSHAKE prefix; the Keccak state after the name and customization strings are absorbed
+*/
+QSC_EXPORT_API typedef struct
+{
+	qsc_keccak_state kstate;			/*!< The prefix Keccak state  */
+	qsc_keccak_rate rate;				/*!< The absorption rate  */
+} qsc_cshake_prefix_state;
+
+/**
+* \brief Absorb a fixed name and customization string into a reusable cSHAKE prefix.
+*
+* \param pfx:		[qsc_cshake_prefix_state*] A reference to the prefix state
+* \param rate:		[qsc_keccak_rate] The rate of absorption in bytes
+* \param name:		[const uint8_t*] The function name string
+* \param namelen:	[size_t] The byte length of the function name
+* \param custom:	[const uint8_t*] The customization string
+* \param custlen:	[size_t] The byte length of the customization string
+*/
+QSC_EXPORT_API void qsc_cshake_prefix_initialize(qsc_cshake_prefix_state* pfx, qsc_keccak_rate rate, const uint8_t* name, size_t namelen, const uint8_t* custom, size_t custlen);
+
+/**
+* \brief Copy a cSHAKE prefix into a Keccak state and absorb a key.
+* The result is identical to qsc_cshake_initialize with the prefix name and customization strings,
+* and is used with qsc_cshake_squeezeblocks.
+*
+* \param pfx:		[const qsc_cshake_prefix_state*] A reference to the initialized prefix state
+* \param ctx:		[qsc_keccak_state*] A reference to the Keccak state that receives the copy
+* \param key:		[const uint8_t*] The input key byte array
+* \param keylen:	[size_t] The number of key bytes to process
+*/
+QSC_EXPORT_API void qsc_cshake_prefix_clone(const qsc_cshake_prefix_state* pfx, qsc_keccak_state* ctx, const uint8_t* key, size_t keylen);
+
+/**
+* \brief Generate cSHAKE output for a key from a precomputed prefix.
+*
+* \param pfx:		[const qsc_cshake_prefix_state*] A reference to the initialized prefix state
+* \param output:	[uint8_t*] The output byte array
+* \param outlen:	[size_t] The number of output bytes to generate
+* \param key:		[const uint8_t*] The input key byte array
+* \param keylen:	[size_t] The number of key bytes to process
+*/
+QSC_EXPORT_API void qsc_cshake_prefix_compute(const qsc_cshake_prefix_state* pfx, uint8_t* output, size_t outlen, const uint8_t* key, size_t keylen);
+
+/**
+* \brief Erase a cSHAKE prefix state.
+*
+* \param pfx:		[qsc_cshake_prefix_state*] A reference to the prefix state
+*/
+QSC_EXPORT_API void qsc_cshake_prefix_dispose(qsc_cshake_prefix_state* pfx);
+
 /* KMAC */
 
 /**
@@ -680,6 +772,24 @@ QSC_EXPORT_API void qsc_kmac128_compute(uint8_t* output, size_t outlen, const ui
 */
 QSC_EXPORT_API void qsc_kmac256_compute(uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen, const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen);
 
+/**
+* \brief Generate KMAC-256 codes for a batch of variable length messages under one key.
+* The keyed state is computed once, and messages are scheduled across the Keccak lanes
+* in the same way as qsc_sha3_compute256_batch.
+* The codes are identical to those of qsc_kmac256_compute.
+*
+* \param outputs:	[uint8_t* const*] The array of MAC code output pointers
+* \param outlen:	[size_t] The number of MAC code bytes to generate for each message
+* \param messages:	[const uint8_t* const*] The array of message pointers
+* \param msglens:	[const size_t*] The array of message lengths
+* \param count:	[size_t] The number of messages
+* \param key:		[const uint8_t*] The input key byte array
+* \param keylen:	[size_t] The number of key bytes to process
+* \param custom:	[const uint8_t*] The customization string
+* \param custlen:	[size_t] The byte length of the customization string
+*/
+QSC_EXPORT_API void qsc_kmac256_batch(uint8_t* const* outputs, size_t outlen, const uint8_t* const* messages, const size_t* msglens, size_t count, const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen);
+
 /**
 * \brief Key a KMAC-512 instance and generate a MAC code.
 * Short form api: processes the key and custom inputs and generates the MAC code with a single call.
@@ -737,6 +847,71 @@ QSC_EXPORT_API void qsc_kmac_finalize(qsc_keccak_state* ctx, qsc_keccak_rate rat
 */
 QSC_EXPORT_API void qsc_kmac_initialize(qsc_keccak_state* ctx, qsc_keccak_rate rate, const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen);
 
+/*!
+* \struct qsc_kmac_prefix_state
+* \brief A keyed KMAC prefix; the Keccak state after the name, customization string, and key are absorbed.
+* Building the prefix once saves the two or more permutations that keying costs on every message.
+*/
+QSC_EXPORT_API typedef struct
+{
+	qsc_keccak_state kstate;			/*!< The keyed Keccak state  */
+	qsc_keccak_rate rate;				/*!< The absorption rate  */
+} qsc_kmac_prefix_state;
+
+/**
+* \brief Key a reusable KMAC prefix.
+*
+* \param pfx:		[qsc_kmac_prefix_state*] A reference to the prefix state
+* \param rate:		[qsc_keccak_rate] The rate of absorption in bytes
+* \param key:		[const uint8_t*] The input key byte array
+* \param keylen:	[size_t] The number of key bytes to process
+* \param custom:	[const uint8_t*] The customization string
+* \param custlen:	[size_t] The byte length of the customization string
+*/
+QSC_EXPORT_API void qsc_kmac_prefix_initialize(qsc_kmac_prefix_state* pfx, qsc_keccak_rate rate, const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen);
+
+/**
+* \brief Copy a keyed KMAC prefix into a Keccak state.
+* The state is then used with qsc_kmac_update and qsc_kmac_finalize at the prefix rate.
+*
+* \param pfx:		[const qsc_kmac_prefix_state*] A reference to the initialized prefix state
+* \param ctx:		[qsc_keccak_state*] A reference to the Keccak state that receives the copy
+*/
+QSC_EXPORT_API void qsc_kmac_prefix_clone(const qsc_kmac_prefix_state* pfx, qsc_keccak_state* ctx);
+
+/**
+* \brief Generate a MAC code for a message from a keyed KMAC prefix.
+*
+* \param pfx:		[const qsc_kmac_prefix_state*] A reference to the initialized prefix state
+* \param output:	[uint8_t*] The MAC code byte array
+* \param outlen:	[size_t] The number of MAC code bytes to generate
+* \param message:	[const uint8_t*] The message input byte array
+* \param msglen:	[size_t] The number of message bytes to process
+*/
+QSC_EXPORT_API void qsc_kmac_prefix_compute(const qsc_kmac_prefix_state* pfx, uint8_t* output, size_t outlen, const uint8_t* message, size_t msglen);
+
+/**
+* \brief Generate MAC codes for a batch of messages from a keyed KMAC prefix.
+* The prefix is broadcast into the lanes of the 8-way (AVX-512) or 4-way (AVX2) Keccak permutation,
+* and messages that pad to the same number of blocks are processed together.
+* The codes are identical to those of qsc_kmac_prefix_compute.
+*
+* \param pfx:		[const qsc_kmac_prefix_state*] A reference to the initialized prefix state
+* \param outputs:	[uint8_t* const*] The array of MAC code output pointers
+* \param outlen:	[size_t] The number of MAC code bytes to generate for each message
+* \param messages:	[const uint8_t* const*] The array of message pointers
+* \param msglens:	[const size_t*] The array of message lengths
+* \param count:	[size_t] The number of messages
+*/
+QSC_EXPORT_API void qsc_kmac_prefix_compute_batch(const qsc_kmac_prefix_state* pfx, uint8_t* const* outputs, size_t outlen, const uint8_t* const* messages, const size_t* msglens, size_t count);
+
+/**
+* \brief Erase a keyed KMAC prefix state.
+*
+* \param pfx:		[qsc_kmac_prefix_state*] A reference to the prefix state
+*/
+QSC_EXPORT_API void qsc_kmac_prefix_dispose(qsc_kmac_prefix_state* pfx);
+
 /* KPA - Keccak-based Parallel Authentication */
 
 #if defined(QSC_SYSTEM_HAS_AVX512) || defined(QSC_SYSTEM_HAS_AVX2)
@@ -843,6 +1018,14 @@ QSC_EXPORT_API void qsc_kpa_dispose(qsc_kpa_state* ctx);
 
 #if defined(QSC_SYSTEM_HAS_AVX2)
 
+/**
+* \brief The Keccak permutation function, applied to 4 interleaved states using AVX2 instructions.
+*
+* \param state:		[__m256i*] The state array, lane i of each vector holds a word of the ith state
+* \param rounds:	[size_t] The number of permutation rounds, the default and maximum is 24
+*/
+void qsc_keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], size_t rounds);
+
 /**
 * \brief Absorb 4 Keccak instances simultaneously using AVX2 instructions.
 *
@@ -903,6 +1086,14 @@ void qsc_keccakx4_squeezeblocks(__m256i state[QSC_KECCAK_STATE_SIZE], qsc_keccak
 
 #if defined(QSC_SYSTEM_HAS_AVX512)
 
+/**
+* \brief The Keccak permutation function, applied to 8 interleaved states using AVX512 instructions.
+*
+* \param state:		[__m512i*] The state array, lane i of each vector holds a word of the ith state
+* \param rounds:	[size_t] The number of permutation rounds, the default and maximum is 24
+*/
+void qsc_keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], size_t rounds);
+
 /**
 * \brief Absorb 8 Keccak instances simultaneously using AVX512 instructions.
 *
@@ -1380,6 +1571,235 @@ QSC_EXPORT_API void qsc_kmac_512x8(uint8_t* out0, uint8_t* out1, uint8_t* out2,
 	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3,
 	const uint8_t* msg4, const uint8_t* msg5, const uint8_t* msg6, const uint8_t* msg7, size_t msglen);
 
+/* parallel SHA3 and cSHAKE x4 */
+
+/**
+* \brief Process 4 SHA3-256 instances simultaneously using SIMD instructions.
+*
+* \warning The input arrays must be of the same length.
+* Uses the AVX2 instruction set when available, otherwise the sequential function.
+*
+* \param out0:		[uint8_t*] The 1st 32-byte output array
+* \param out1:		[uint8_t*] The 2nd 32-byte output array
+* \param out2:		[uint8_t*] The 3rd 32-byte output array
+* \param out3:		[uint8_t*] The 4th 32-byte output array
+* \param msg0:		[const uint8_t*] The 1st message array
+* \param msg1:		[const uint8_t*] The 2nd message array
+* \param msg2:		[const uint8_t*] The 3rd message array
+* \param msg3:		[const uint8_t*] The 4th message array
+* \param msglen:	[size_t] The length of the message arrays
+*/
+QSC_EXPORT_API void qsc_sha3_256x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3, size_t msglen);
+
+/**
+* \brief Process 4 cSHAKE-256 instances simultaneously using SIMD instructions.
+*
+* \warning The input and output arrays must be of the same length.
+* Uses the AVX2 instruction set when available, otherwise the sequential function.
+*
+* \param out0:		[uint8_t*] The 1st output array
+* \param out1:		[uint8_t*] The 2nd output array
+* \param out2:		[uint8_t*] The 3rd output array
+* \param out3:		[uint8_t*] The 4th output array
+* \param outlen:	[size_t] The length of the output arrays
+* \param inp0:		[const uint8_t*] The 1st input key array
+* \param inp1:		[const uint8_t*] The 2nd input key array
+* \param inp2:		[const uint8_t*] The 3rd input key array
+* \param inp3:		[const uint8_t*] The 4th input key array
+* \param inplen:	[size_t] The length of the input key arrays
+* \param name:		[const uint8_t*] The function name string, shared by all instances
+* \param namelen:	[size_t] The byte length of the function name
+* \param custom:	[const uint8_t*] The customization string, shared by all instances
+* \param custlen:	[size_t] The byte length of the customization string
+*/
+QSC_EXPORT_API void qsc_cshake_256x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t outlen,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen,
+	const uint8_t* name, size_t namelen, const uint8_t* custom, size_t custlen);
+
+/* parallel SHA3 and cSHAKE x8 */
+
+/**
+* \brief Process 8 SHA3-256 instances simultaneously using SIMD instructions.
+*
+* \warning The input arrays must be of the same length.
+* Uses the AVX512 or AVX2 instruction sets when available, otherwise the sequential function.
+*
+* \param out0:		[uint8_t*] The 1st 32-byte output array
+* \param out1:		[uint8_t*] The 2nd 32-byte output array
+* \param out2:		[uint8_t*] The 3rd 32-byte output array
+* \param out3:		[uint8_t*] The 4th 32-byte output array
+* \param out4:		[uint8_t*] The 5th 32-byte output array
+* \param out5:		[uint8_t*] The 6th 32-byte output array
+* \param out6:		[uint8_t*] The 7th 32-byte output array
+* \param out7:		[uint8_t*] The 8th 32-byte output array
+* \param msg0:		[const uint8_t*] The 1st message array
+* \param msg1:		[const uint8_t*] The 2nd message array
+* \param msg2:		[const uint8_t*] The 3rd message array
+* \param msg3:		[const uint8_t*] The 4th message array
+* \param msg4:		[const uint8_t*] The 5th message array
+* \param msg5:		[const uint8_t*] The 6th message array
+* \param msg6:		[const uint8_t*] The 7th message array
+* \param msg7:		[const uint8_t*] The 8th message array
+* \param msglen:	[size_t] The length of the message arrays
+*/
+QSC_EXPORT_API void qsc_sha3_256x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7,
+	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3,
+	const uint8_t* msg4, const uint8_t* msg5, const uint8_t* msg6, const uint8_t* msg7, size_t msglen);
+
+/**
+* \brief Process 8 cSHAKE-256 instances simultaneously using SIMD instructions.
+*
+* \warning The input and output arrays must be of the same length.
+* Uses the AVX512 or AVX2 instruction sets when available, otherwise the sequential function.
+*
+* \param out0:		[uint8_t*] The 1st output array
+* \param out1:		[uint8_t*] The 2nd output array
+* \param out2:		[uint8_t*] The 3rd output array
+* \param out3:		[uint8_t*] The 4th output array
+* \param out4:		[uint8_t*] The 5th output array
+* \param out5:		[uint8_t*] The 6th output array
+* \param out6:		[uint8_t*] The 7th output array
+* \param out7:		[uint8_t*] The 8th output array
+* \param outlen:	[size_t] The length of the output arrays
+* \param inp0:		[const uint8_t*] The 1st input key array
+* \param inp1:		[const uint8_t*] The 2nd input key array
+* \param inp2:		[const uint8_t*] The 3rd input key array
+* \param inp3:		[const uint8_t*] The 4th input key array
+* \param inp4:		[const uint8_t*] The 5th input key array
+* \param inp5:		[const uint8_t*] The 6th input key array
+* \param inp6:		[const uint8_t*] The 7th input key array
+* \param inp7:		[const uint8_t*] The 8th input key array
+* \param inplen:	[size_t] The length of the input key arrays
+* \param name:		[const uint8_t*] The function name string, shared by all instances
+* \param namelen:	[size_t] The byte length of the function name
+* \param custom:	[const uint8_t*] The customization string, shared by all instances
+* \param custlen:	[size_t] The byte length of the customization string
+*/
+QSC_EXPORT_API void qsc_cshake_256x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t outlen,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
+	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen,
+	const uint8_t* name, size_t namelen, const uint8_t* custom, size_t custlen);
+
+/* incremental multi-lane Keccak */
+
+/*!
+* \def QSC_KECCAKX_LANES_MAX
+* \brief The maximum number of lanes in a multi-lane Keccak state
+*/
+#define QSC_KECCAKX_LANES_MAX 8ULL
+
+/*!
+* \def QSC_KECCAKX_QUEUE_DEPTH
+* \brief The number of message blocks queued in each lane.
+* Single-lane updates share the SIMD permutations when their input chunks are shorter than the queue.
+*/
+#define QSC_KECCAKX_QUEUE_DEPTH 8ULL
+
+/*!
+* \struct qsc_keccakx_state
+* \brief The incremental multi-lane Keccak state.
+* Each lane is an independent SHA3, SHAKE, or cSHAKE stream; lanes absorb ragged lengths, finish at different times,
+* and are reset after finalizing so they can be refilled with the next message.
+* Input is queued per lane, and the queued blocks of all lanes are absorbed together with the 4 or 8-way SIMD permutation.
+*/
+QSC_EXPORT_API typedef struct
+{
+	uint64_t state[QSC_KECCAK_STATE_SIZE][QSC_KECCAKX_LANES_MAX];								/*!< The interleaved lane states, word i of lane j is state[i][j]  */
+	uint64_t istate[QSC_KECCAK_STATE_SIZE];														/*!< The initial lane state, restored by a lane reset  */
+	uint8_t buffer[QSC_KECCAKX_LANES_MAX][QSC_KECCAKX_QUEUE_DEPTH][QSC_KECCAK_STATE_BYTE_SIZE];	/*!< The lane block queues  */
+	size_t count[QSC_KECCAKX_LANES_MAX];														/*!< The number of full blocks queued in each lane  */
+	size_t head[QSC_KECCAKX_LANES_MAX];															/*!< The queue slot of each lane's oldest block  */
+	size_t position[QSC_KECCAKX_LANES_MAX];														/*!< The number of bytes in each lane's open block  */
+	size_t lanes;																				/*!< The number of lanes, 4 or 8  */
+	qsc_keccak_rate rate;																		/*!< The absorption rate  */
+	uint8_t domain;																				/*!< The padding domain id  */
+} qsc_keccakx_state;
+
+/**
+* \brief Dispose of the multi-lane Keccak state.
+*
+* \param ctx:		[qsc_keccakx_state*] A reference to the multi-lane state
+*/
+QSC_EXPORT_API void qsc_keccakx_dispose(qsc_keccakx_state* ctx);
+
+/**
+* \brief Finalize every lane that has an output array and squeeze the outputs in parallel.
+* The finalized lanes are reset to the initial state, ready to be refilled.
+*
+* \param ctx:		[qsc_keccakx_state*] A reference to the multi-lane state; must be initialized
+* \param outputs:	[uint8_t* const*] An array of one output pointer per lane; a NULL entry leaves that lane open
+* \param outlen:	[size_t] The number of bytes to generate for each finalized lane
+*/
+QSC_EXPORT_API void qsc_keccakx_finalize(qsc_keccakx_state* ctx, uint8_t* const* outputs, size_t outlen);
+
+/**
+* \brief Initialize a multi-lane SHA3 or SHAKE state.
+*
+* \param ctx:		[qsc_keccakx_state*] A reference to the multi-lane state
+* \param lanes:		[size_t] The number of lanes, 4 or 8
+* \param rate:		[qsc_keccak_rate] The absorption rate
+* \param domain:	[uint8_t] The padding domain, QSC_KECCAK_SHA3_DOMAIN_ID or QSC_KECCAK_SHAKE_DOMAIN_ID
+*/
+QSC_EXPORT_API void qsc_keccakx_initialize(qsc_keccakx_state* ctx, size_t lanes, qsc_keccak_rate rate, uint8_t domain);
+
+/**
+* \brief Initialize a multi-lane cSHAKE state.
+* The function name and customization string are absorbed once and shared by every lane.
+*
+* \param ctx:		[qsc_keccakx_state*] A reference to the multi-lane state
+* \param lanes:		[size_t] The number of lanes, 4 or 8
+* \param rate:		[qsc_keccak_rate] The absorption rate
+* \param name:		[const uint8_t*] The function name string
+* \param namelen:	[size_t] The byte length of the function name
+* \param custom:	[const uint8_t*] The customization string
+* \param custlen:	[size_t] The byte length of the customization string
+*/
+QSC_EXPORT_API void qsc_keccakx_initialize_custom(qsc_keccakx_state* ctx, size_t lanes, qsc_keccak_rate rate,
+	const uint8_t* name, size_t namelen, const uint8_t* custom, size_t custlen);
+
+/**
+* \brief Finalize a single lane and squeeze its output.
+* The lane is reset to the initial state, ready to be refilled.
+*
+* \param ctx:		[qsc_keccakx_state*] A reference to the multi-lane state; must be initialized
+* \param lane:		[size_t] The lane index
+* \param output:	[uint8_t*] The output array
+* \param outlen:	[size_t] The number of bytes to generate
+*/
+QSC_EXPORT_API void qsc_keccakx_lane_finalize(qsc_keccakx_state* ctx, size_t lane, uint8_t* output, size_t outlen);
+
+/**
+* \brief Discard a lane's input and reset it to the initial state.
+*
+* \param ctx:		[qsc_keccakx_state*] A reference to the multi-lane state; must be initialized
+* \param lane:		[size_t] The lane index
+*/
+QSC_EXPORT_API void qsc_keccakx_lane_reset(qsc_keccakx_state* ctx, size_t lane);
+
+/**
+* \brief Absorb input into a single lane.
+* The input is queued, and when the lane queue is full the oldest block of every lane is absorbed under one permutation,
+* so calls that alternate between lanes share the SIMD permutations.
+*
+* \param ctx:		[qsc_keccakx_state*] A reference to the multi-lane state; must be initialized
+* \param lane:		[size_t] The lane index
+* \param input:		[const uint8_t*] The input array
+* \param inplen:	[size_t] The number of input bytes
+*/
+QSC_EXPORT_API void qsc_keccakx_lane_update(qsc_keccakx_state* ctx, size_t lane, const uint8_t* input, size_t inplen);
+
+/**
+* \brief Absorb input into every lane; the lengths may differ.
+*
+* \param ctx:		[qsc_keccakx_state*] A reference to the multi-lane state; must be initialized
+* \param inputs:	[const uint8_t* const*] An array of one input pointer per lane; a NULL entry skips that lane
+* \param inplens:	[const size_t*] An array of one input length per lane
+*/
+QSC_EXPORT_API void qsc_keccakx_update(qsc_keccakx_state* ctx, const uint8_t* const* inputs, const size_t* inplens);
+
 QSC_CPLUSPLUS_ENABLED_END
 
 #endif
@@ -1,4 +1,9 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+	/* required for the sendmmsg and recvmmsg declarations */
+#	define _GNU_SOURCE
+#endif
 #include "socketbase.h"
+#include "fileutils.h"
 #include "intutils.h"
 #include "memutils.h"
 #include "async.h"
@@ -6,10 +11,16 @@
 #if defined(QSC_SYSTEM_OS_POSIX)
 #   include <sys/ioctl.h>
 #   include <sys/select.h>
+#   include <sys/uio.h>
 #	if !defined(PSTR)
 #   	define PSTR char*
 #	endif
 #endif
+#if defined(QSC_SYSTEM_OS_LINUX)
+#   include <fcntl.h>
+#   include <sys/sendfile.h>
+#   include <sys/stat.h>
+#endif
 
 static qsc_socket_exceptions qsc_socket_acceptv4(const qsc_socket* source, qsc_socket* target)
 {
@@ -93,6 +104,83 @@ static qsc_socket_exceptions qsc_socket_acceptv6(const qsc_socket* source, qsc_s
 	return res;
 }
 
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+static void qsc_socket_vector_convert(WSABUF* bufs, const qsc_socket_vector* vectors, size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		bufs[i].buf = (CHAR*)vectors[i].buffer;
+		bufs[i].len = (ULONG)vectors[i].length;
+	}
+}
+#else
+static void qsc_socket_vector_convert(struct iovec* iov, const qsc_socket_vector* vectors, size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		iov[i].iov_base = (void*)vectors[i].buffer;
+		iov[i].iov_len = vectors[i].length;
+	}
+}
+#endif
+
+static int64_t qsc_socket_send_vector_invoke(const qsc_socket* sock, const qsc_socket_vector* vectors, size_t count, qsc_socket_send_flags flag)
+{
+	int64_t res;
+
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+	WSABUF bufs[QSC_SOCKET_VECTOR_MAX];
+	DWORD slen;
+
+	qsc_socket_vector_convert(bufs, vectors, count);
+	slen = 0;
+	res = (WSASend(sock->connection, bufs, (DWORD)count, &slen, (DWORD)flag, NULL, NULL) == 0) ? (int64_t)slen : -1;
+#else
+	struct iovec iov[QSC_SOCKET_VECTOR_MAX];
+	struct msghdr msg;
+
+	qsc_socket_vector_convert(iov, vectors, count);
+	qsc_memutils_clear((uint8_t*)&msg, sizeof(msg));
+	msg.msg_iov = iov;
+	msg.msg_iovlen = count;
+	res = (int64_t)sendmsg(sock->connection, &msg, (int32_t)flag);
+#endif
+
+	return res;
+}
+
+#if defined(QSC_SYSTEM_OS_LINUX)
+static socklen_t socketbase_remote_address(const qsc_socket* sock, struct sockaddr_storage* sa)
+{
+	socklen_t res;
+
+	qsc_memutils_clear((uint8_t*)sa, sizeof(struct sockaddr_storage));
+
+	if (sock->address_family == qsc_socket_address_family_ipv4)
+	{
+		struct sockaddr_in* d;
+
+		d = (struct sockaddr_in*)sa;
+		d->sin_family = AF_INET;
+		d->sin_port = htons(sock->port);
+		inet_pton(AF_INET, (const char*)sock->address, &d->sin_addr);
+		res = sizeof(struct sockaddr_in);
+	}
+	else
+	{
+		struct sockaddr_in6* d;
+
+		d = (struct sockaddr_in6*)sa;
+		d->sin6_family = AF_INET6;
+		d->sin6_port = htons(sock->port);
+		inet_pton(AF_INET6, (const char*)sock->address, &d->sin6_addr);
+		res = sizeof(struct sockaddr_in6);
+	}
+
+	return res;
+}
+#endif
+
 //~~~Accessors~~~//
 
 bool qsc_socket_ipv4_valid_address(const char* address)
@@ -654,6 +742,42 @@ uint32_t qsc_socket_receive_poll(const qsc_socket_receive_poll_state* state)
 	return ctr;
 }
 
+size_t qsc_socket_receive_vector(const qsc_socket* sock, const qsc_socket_vector* vectors, size_t count, qsc_socket_receive_flags flag)
+{
+	assert(sock != NULL);
+	assert(vectors != NULL);
+
+	int64_t res;
+
+	res = 0;
+
+	if (sock != NULL && vectors != NULL && count != 0 && count <= QSC_SOCKET_VECTOR_MAX)
+	{
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+		WSABUF bufs[QSC_SOCKET_VECTOR_MAX];
+		DWORD flags;
+		DWORD rlen;
+
+		qsc_socket_vector_convert(bufs, vectors, count);
+		flags = (DWORD)flag;
+		rlen = 0;
+		res = (WSARecv(sock->connection, bufs, (DWORD)count, &rlen, &flags, NULL, NULL) == 0) ? (int64_t)rlen : 0;
+#else
+		struct iovec iov[QSC_SOCKET_VECTOR_MAX];
+		struct msghdr msg;
+
+		qsc_socket_vector_convert(iov, vectors, count);
+		qsc_memutils_clear((uint8_t*)&msg, sizeof(msg));
+		msg.msg_iov = iov;
+		msg.msg_iovlen = count;
+		res = (int64_t)recvmsg(sock->connection, &msg, (int32_t)flag);
+		res = (res < 0) ? 0 : res;
+#endif
+	}
+
+	return (size_t)res;
+}
+
 size_t qsc_socket_receive_all(const qsc_socket* sock, uint8_t* output, size_t otplen, qsc_socket_receive_flags flag)
 {
 	assert(sock != NULL);
@@ -668,7 +792,7 @@ size_t qsc_socket_receive_all(const qsc_socket* sock, uint8_t* output, size_t ot
 	{
 		while (otplen > 0)
 		{
-			res = recv(sock->connection, (char*)output, (int32_t)otplen, (int32_t)flag);
+			res = recv(sock->connection, (char*)(output + pos), (int32_t)otplen, (int32_t)flag);
 
 			if (res < 1)
 			{
@@ -747,6 +871,70 @@ size_t qsc_socket_receive_from(qsc_socket* sock, char* dest, uint16_t port, uint
 	return (size_t)res;
 }
 
+size_t qsc_socket_receive_batch(const qsc_socket* sock, qsc_socket_vector* datagrams, size_t count, qsc_socket_receive_flags flag)
+{
+	assert(sock != NULL);
+	assert(datagrams != NULL);
+
+	size_t res;
+
+	res = 0;
+
+	if (sock != NULL && datagrams != NULL && count != 0 && count <= QSC_SOCKET_VECTOR_MAX)
+	{
+#if defined(QSC_SYSTEM_OS_LINUX)
+		struct mmsghdr msgs[QSC_SOCKET_VECTOR_MAX];
+		struct iovec iov[QSC_SOCKET_VECTOR_MAX];
+		int32_t mcnt;
+
+		qsc_socket_vector_convert(iov, datagrams, count);
+		qsc_memutils_clear((uint8_t*)msgs, count * sizeof(struct mmsghdr));
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			msgs[i].msg_hdr.msg_iov = &iov[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		/* block for the first datagram, then collect any that are already queued */
+		mcnt = recvmmsg(sock->connection, msgs, (uint32_t)count, (int32_t)flag | MSG_WAITFORONE, NULL);
+
+		if (mcnt > 0)
+		{
+			res = (size_t)mcnt;
+
+			for (size_t i = 0; i < res; ++i)
+			{
+				datagrams[i].length = msgs[i].msg_len;
+			}
+		}
+#else
+		struct timeval tv = { 0 };
+		int32_t mlen;
+
+		while (res < count)
+		{
+			if (res != 0 && qsc_socket_receive_ready(sock, &tv) == false)
+			{
+				break;
+			}
+
+			mlen = recv(sock->connection, (char*)datagrams[res].buffer, (int32_t)datagrams[res].length, (int32_t)flag);
+
+			if (mlen == qsc_socket_exception_error)
+			{
+				break;
+			}
+
+			datagrams[res].length = (size_t)mlen;
+			++res;
+		}
+#endif
+	}
+
+	return res;
+}
+
 size_t qsc_socket_send(const qsc_socket* sock, const uint8_t* input, size_t inplen, qsc_socket_send_flags flag)
 {
 	assert(sock != NULL);
@@ -801,6 +989,64 @@ size_t qsc_socket_send_to(const qsc_socket* sock, const uint8_t* input, size_t i
 	return (size_t)res;
 }
 
+size_t qsc_socket_send_to_batch(const qsc_socket* sock, const qsc_socket_vector* datagrams, size_t count, qsc_socket_send_flags flag)
+{
+	assert(sock != NULL);
+	assert(datagrams != NULL);
+
+	size_t res;
+
+	res = 0;
+
+	if (sock != NULL && datagrams != NULL && count != 0 && count <= QSC_SOCKET_VECTOR_MAX)
+	{
+#if defined(QSC_SYSTEM_OS_LINUX)
+		struct mmsghdr msgs[QSC_SOCKET_VECTOR_MAX];
+		struct iovec iov[QSC_SOCKET_VECTOR_MAX];
+		struct sockaddr_storage sa;
+		socklen_t salen;
+		int32_t mcnt;
+
+		salen = socketbase_remote_address(sock, &sa);
+		qsc_socket_vector_convert(iov, datagrams, count);
+		qsc_memutils_clear((uint8_t*)msgs, count * sizeof(struct mmsghdr));
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			msgs[i].msg_hdr.msg_name = &sa;
+			msgs[i].msg_hdr.msg_namelen = salen;
+			msgs[i].msg_hdr.msg_iov = &iov[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		/* sendmmsg may send part of the batch, resubmit the remainder */
+		while (res < count)
+		{
+			mcnt = sendmmsg(sock->connection, msgs + res, (uint32_t)(count - res), (int32_t)flag);
+
+			if (mcnt < 1)
+			{
+				break;
+			}
+
+			res += (size_t)mcnt;
+		}
+#else
+		while (res < count)
+		{
+			if (qsc_socket_send_to(sock, datagrams[res].buffer, datagrams[res].length, flag) != datagrams[res].length)
+			{
+				break;
+			}
+
+			++res;
+		}
+#endif
+	}
+
+	return res;
+}
+
 size_t qsc_socket_send_all(const qsc_socket* sock, const uint8_t* input, size_t inplen, qsc_socket_send_flags flag)
 {
 	assert(sock != NULL);
@@ -815,7 +1061,7 @@ size_t qsc_socket_send_all(const qsc_socket* sock, const uint8_t* input, size_t
 	{
 		while (inplen > 0)
 		{
-			res = send(sock->connection, (const char*)input, (int32_t)inplen, (int32_t)flag);
+			res = send(sock->connection, (const char*)(input + pos), (int32_t)inplen, (int32_t)flag);
 
 			if (res < 1)
 			{
@@ -831,6 +1077,192 @@ size_t qsc_socket_send_all(const qsc_socket* sock, const uint8_t* input, size_t
 	return (size_t)pos;
 }
 
+size_t qsc_socket_send_file(const qsc_socket* sock, const char* fpath, size_t offset, size_t length)
+{
+	assert(sock != NULL);
+	assert(fpath != NULL);
+
+	size_t pos;
+
+	pos = 0;
+
+	if (sock != NULL && fpath != NULL)
+	{
+#if defined(QSC_SYSTEM_OS_LINUX)
+		struct stat fst;
+		int32_t fd;
+
+		fd = open(fpath, O_RDONLY);
+
+		if (fd >= 0)
+		{
+			if (fstat(fd, &fst) == 0 && offset < (size_t)fst.st_size)
+			{
+				off_t foff;
+				ssize_t slen;
+
+				length = (length == 0 || length > (size_t)fst.st_size - offset) ? (size_t)fst.st_size - offset : length;
+				foff = (off_t)offset;
+
+				/* the kernel copies directly from the page cache to the socket */
+				while (pos < length)
+				{
+					slen = sendfile(sock->connection, fd, &foff, length - pos);
+
+					if (slen < 1)
+					{
+						if (slen < 0 && errno == EINTR)
+						{
+							continue;
+						}
+
+						break;
+					}
+
+					pos += (size_t)slen;
+				}
+			}
+
+			close(fd);
+		}
+#else
+		FILE* fp;
+		uint8_t* pbuf;
+		size_t flen;
+
+		flen = qsc_fileutils_get_size(fpath);
+
+		if (offset < flen)
+		{
+			length = (length == 0 || length > flen - offset) ? flen - offset : length;
+			fp = qsc_fileutils_open(fpath, qsc_fileutils_mode_read, true);
+
+			if (fp != NULL)
+			{
+				pbuf = (uint8_t*)qsc_memutils_malloc(QSC_SOCKET_SEND_FILE_CHUNK);
+
+				if (pbuf != NULL)
+				{
+					size_t blen;
+					size_t boff;
+					size_t slen;
+
+					/* read and send through a bounded buffer */
+					while (pos < length)
+					{
+						blen = qsc_intutils_min(length - pos, QSC_SOCKET_SEND_FILE_CHUNK);
+						blen = qsc_fileutils_read((char*)pbuf, blen, offset + pos, fp);
+
+						if (blen == 0)
+						{
+							break;
+						}
+
+						boff = 0;
+
+						while (boff < blen)
+						{
+							slen = qsc_socket_send(sock, pbuf + boff, blen - boff, qsc_socket_send_flag_none);
+
+							if (slen == 0)
+							{
+								break;
+							}
+
+							boff += slen;
+						}
+
+						pos += boff;
+
+						if (boff != blen)
+						{
+							break;
+						}
+					}
+
+					qsc_memutils_alloc_free(pbuf);
+				}
+
+				qsc_fileutils_close(fp);
+			}
+		}
+#endif
+	}
+
+	return pos;
+}
+
+size_t qsc_socket_send_vector(const qsc_socket* sock, const qsc_socket_vector* vectors, size_t count, qsc_socket_send_flags flag)
+{
+	assert(sock != NULL);
+	assert(vectors != NULL);
+
+	int64_t res;
+
+	res = 0;
+
+	if (sock != NULL && vectors != NULL && count != 0 && count <= QSC_SOCKET_VECTOR_MAX)
+	{
+		res = qsc_socket_send_vector_invoke(sock, vectors, count, flag);
+		res = (res < 0) ? 0 : res;
+	}
+
+	return (size_t)res;
+}
+
+size_t qsc_socket_send_vector_all(const qsc_socket* sock, const qsc_socket_vector* vectors, size_t count, qsc_socket_send_flags flag)
+{
+	assert(sock != NULL);
+	assert(vectors != NULL);
+
+	qsc_socket_vector vtmp[QSC_SOCKET_VECTOR_MAX];
+	size_t idx;
+	size_t pos;
+	int64_t slen;
+
+	pos = 0;
+
+	if (sock != NULL && vectors != NULL && count != 0 && count <= QSC_SOCKET_VECTOR_MAX)
+	{
+		qsc_memutils_copy((uint8_t*)vtmp, (const uint8_t*)vectors, count * sizeof(qsc_socket_vector));
+		idx = 0;
+
+		while (idx < count)
+		{
+			if (vtmp[idx].length == 0)
+			{
+				++idx;
+				continue;
+			}
+
+			slen = qsc_socket_send_vector_invoke(sock, vtmp + idx, count - idx, flag);
+
+			if (slen < 1)
+			{
+				pos = 0;
+				break;
+			}
+
+			pos += (size_t)slen;
+
+			/* advance past the segments that were fully sent, and trim a partial segment */
+			while (idx < count && (size_t)slen >= vtmp[idx].length)
+			{
+				slen -= (int64_t)vtmp[idx].length;
+				++idx;
+			}
+
+			if (idx < count)
+			{
+				vtmp[idx].buffer += slen;
+				vtmp[idx].length -= (size_t)slen;
+			}
+		}
+	}
+
+	return pos;
+}
+
 qsc_socket_exceptions qsc_socket_shut_down(qsc_socket* sock, qsc_socket_shut_down_flags params)
 {
 	assert(sock != NULL);
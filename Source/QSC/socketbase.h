@@ -123,6 +123,18 @@ QSC_SYSTEM_CONDITION_IGNORE(5105)
 */
 #define QSC_SOCKET_RECEIVE_BUFFER_SIZE 1600ULL
 
+/*!
+\def QSC_SOCKET_VECTOR_MAX
+* \brief The maximum number of buffers in a vectored send or receive, or datagrams in a batch
+*/
+#define QSC_SOCKET_VECTOR_MAX 64ULL
+
+/*!
+\def QSC_SOCKET_SEND_FILE_CHUNK
+* \brief The buffer size used by the chunked file send fallback
+*/
+#define QSC_SOCKET_SEND_FILE_CHUNK 65536ULL
+
 /*! \enum qsc_socket_exceptions
 * \brief Socket code enumeration names
 */
@@ -304,6 +316,16 @@ typedef struct
 	uint32_t count;																/*!< The number of active sockets */
 } qsc_socket_receive_poll_state;
 
+/*! \struct qsc_socket_vector
+* \brief A scatter-gather buffer descriptor.
+* Describes one segment of a vectored transfer, or one datagram in a batched transfer.
+*/
+typedef struct
+{
+	uint8_t* buffer;															/*!< A pointer to the segment buffer */
+	size_t length;																/*!< The segment length in bytes */
+} qsc_socket_vector;
+
 /*** Function Prototypes ***/
 
 ///**
@@ -558,6 +580,21 @@ QSC_EXPORT_API size_t qsc_socket_receive_all(const qsc_socket* sock, uint8_t* ou
 */
 QSC_EXPORT_API size_t qsc_socket_receive_from(qsc_socket* sock, char* dest, uint16_t port, uint8_t* output, size_t otplen, qsc_socket_receive_flags flag);
 
+/**
+* \brief Receive a batch of datagrams from a bound connection-less socket.
+* Blocks until at least one datagram is available, then returns it together with any others already queued.
+* On Linux the batch is received with a single recvmmsg call.
+* On input, each vector length is the capacity of its buffer; on output it is set to the size of the datagram received.
+*
+* \param sock:		[const qsc_socket*] The socket instance
+* \param datagrams:	[qsc_socket_vector*] The array of datagram buffers
+* \param count:		[size_t] The number of datagram buffers, at most QSC_SOCKET_VECTOR_MAX
+* \param flag:		[qsc_socket_receive_flags] Flags that influence the behavior of the receive function
+*
+* \return			[size_t] Returns the number of datagrams received
+*/
+QSC_EXPORT_API size_t qsc_socket_receive_batch(const qsc_socket* sock, qsc_socket_vector* datagrams, size_t count, qsc_socket_receive_flags flag);
+
 /**
 * \brief Polls an array of sockets.
 * Fires a callback if a socket is ready to receive data, or an error if socket is disconnected.
@@ -568,6 +605,19 @@ QSC_EXPORT_API size_t qsc_socket_receive_from(qsc_socket* sock, char* dest, uint
 */
 QSC_EXPORT_API uint32_t qsc_socket_receive_poll(const qsc_socket_receive_poll_state* state);
 
+/**
+* \brief Receive data from a connected socket into a set of buffers (scatter read).
+* The buffers are filled in order, with a single system call.
+*
+* \param sock:		[const qsc_socket*] The socket instance
+* \param vectors:	[const qsc_socket_vector*] The array of output buffers
+* \param count:		[size_t] The number of buffers, at most QSC_SOCKET_VECTOR_MAX
+* \param flag:		[qsc_socket_receive_flags] Flags that influence the behavior of the receive function
+*
+* \return			[size_t] Returns the number of bytes received from the remote host
+*/
+QSC_EXPORT_API size_t qsc_socket_receive_vector(const qsc_socket* sock, const qsc_socket_vector* vectors, size_t count, qsc_socket_receive_flags flag);
+
 /**
 * \brief Sends data on a TCP connected socket.
 * Note: The input buffer must be at least 1 byte longer than the input length.
@@ -594,6 +644,19 @@ QSC_EXPORT_API size_t qsc_socket_send(const qsc_socket* sock, const uint8_t* inp
 */
 QSC_EXPORT_API size_t qsc_socket_send_to(const qsc_socket* sock, const uint8_t* input, size_t inplen, qsc_socket_send_flags flag);
 
+/**
+* \brief Send a batch of datagrams on a UDP socket to the sockets remote address.
+* On Linux the batch is sent with a single sendmmsg call.
+*
+* \param sock:		[const qsc_socket*] The socket instance
+* \param datagrams:	[const qsc_socket_vector*] The array of datagrams
+* \param count:		[size_t] The number of datagrams, at most QSC_SOCKET_VECTOR_MAX
+* \param flag:		[qsc_socket_send_flags] Flags that influence the behavior of the send function
+*
+* \return			[size_t] Returns the number of datagrams sent
+*/
+QSC_EXPORT_API size_t qsc_socket_send_to_batch(const qsc_socket* sock, const qsc_socket_vector* datagrams, size_t count, qsc_socket_send_flags flag);
+
 /**
 * \brief Sends a block of data larger than a single packet size, on a TCP socket and returns when sent
 *
@@ -606,6 +669,45 @@ QSC_EXPORT_API size_t qsc_socket_send_to(const qsc_socket* sock, const uint8_t*
 */
 QSC_EXPORT_API size_t qsc_socket_send_all(const qsc_socket* sock, const uint8_t* input, size_t inplen, qsc_socket_send_flags flag);
 
+/**
+* \brief Send a region of a file on a TCP connected socket, and return when it has been sent.
+* On Linux the file is transferred by the kernel with sendfile, without being copied into user space.
+* Other platforms read and send the file in chunks of QSC_SOCKET_SEND_FILE_CHUNK bytes.
+*
+* \param sock:		[const qsc_socket*] The socket instance
+* \param fpath:		[const char*] The full path to the file
+* \param offset:	[size_t] The file offset of the first byte to send
+* \param length:	[size_t] The number of bytes to send, zero sends the remainder of the file
+*
+* \return			[size_t] Returns the number of bytes sent to the remote host
+*/
+QSC_EXPORT_API size_t qsc_socket_send_file(const qsc_socket* sock, const char* fpath, size_t offset, size_t length);
+
+/**
+* \brief Send a set of buffers on a connected socket as one contiguous stream (gather write).
+* The buffers are sent in order with a single system call, and may be partially sent.
+*
+* \param sock:		[const qsc_socket*] The socket instance
+* \param vectors:	[const qsc_socket_vector*] The array of input buffers
+* \param count:		[size_t] The number of buffers, at most QSC_SOCKET_VECTOR_MAX
+* \param flag:		[qsc_socket_send_flags] Flags that influence the behavior of the send function
+*
+* \return			[size_t] Returns the number of bytes sent to the remote host
+*/
+QSC_EXPORT_API size_t qsc_socket_send_vector(const qsc_socket* sock, const qsc_socket_vector* vectors, size_t count, qsc_socket_send_flags flag);
+
+/**
+* \brief Send a set of buffers on a connected socket, and return when all of the data has been sent
+*
+* \param sock:		[const qsc_socket*] The socket instance
+* \param vectors:	[const qsc_socket_vector*] The array of input buffers
+* \param count:		[size_t] The number of buffers, at most QSC_SOCKET_VECTOR_MAX
+* \param flag:		[qsc_socket_send_flags] Flags that influence the behavior of the send function
+*
+* \return			[size_t] Returns the number of bytes sent to the remote host, or zero on failure
+*/
+QSC_EXPORT_API size_t qsc_socket_send_vector_all(const qsc_socket* sock, const qsc_socket_vector* vectors, size_t count, qsc_socket_send_flags flag);
+
 /**
 * \brief Shuts down a socket
 *
@@ -0,0 +1,608 @@
+#include "socketreactor.h"
+#include "intutils.h"
+#include "ipinfo.h"
+#include "memutils.h"
+
+#if defined(QSC_SOCKET_REACTOR_EPOLL)
+#	include <sys/epoll.h>
+#elif defined(QSC_SYSTEM_OS_POSIX)
+#	include <poll.h>
+#endif
+#if defined(QSC_SYSTEM_OS_POSIX)
+#	include <sys/ioctl.h>
+#	include <time.h>
+#endif
+
+#if !defined(QSC_SOCKET_REACTOR_EPOLL)
+#	if defined(QSC_SYSTEM_OS_WINDOWS)
+typedef WSAPOLLFD socket_reactor_pollfd;
+#		define socket_reactor_poll WSAPoll
+#	else
+typedef struct pollfd socket_reactor_pollfd;
+#		define socket_reactor_poll poll
+#	endif
+#endif
+
+#define SOCKET_REACTOR_TABLE_INITIAL 64ULL
+
+static uint64_t socket_reactor_clock(void)
+{
+	uint64_t res;
+
+#if defined(QSC_SYSTEM_OS_WINDOWS)
+	res = (uint64_t)GetTickCount64();
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	res = ((uint64_t)ts.tv_sec * 1000ULL) + ((uint64_t)ts.tv_nsec / 1000000ULL);
+#endif
+
+	return res;
+}
+
+static void socket_reactor_set_nonblocking(qsc_socket* sock)
+{
+	uint32_t arg;
+
+	arg = 1;
+	qsc_socket_ioctl(sock, (int32_t)FIONBIO, &arg);
+}
+
+static void socket_reactor_set_reuse(const qsc_socket* sock)
+{
+#if defined(QSC_SYSTEM_OS_POSIX)
+	int32_t optval;
+
+	/* each loop binds its own listener to the shared port */
+	optval = 1;
+	setsockopt(sock->connection, SOL_SOCKET, SO_REUSEADDR, (const void*)&optval, sizeof(optval));
+#	if defined(QSC_SOCKET_REACTOR_EPOLL)
+	setsockopt(sock->connection, SOL_SOCKET, SO_REUSEPORT, (const void*)&optval, sizeof(optval));
+#	endif
+#else
+	(void)sock;
+#endif
+}
+
+static uint64_t socket_reactor_timers_service(qsc_socket_reactor* reactor)
+{
+	uint64_t now;
+	uint64_t res;
+
+	res = QSC_SOCKET_REACTOR_WAIT_MSEC;
+	now = socket_reactor_clock();
+
+	for (size_t i = 0; i < reactor->tcount; ++i)
+	{
+		qsc_socket_reactor_timer* tmr;
+
+		tmr = &reactor->timers[i];
+
+		if (now >= tmr->deadline)
+		{
+			tmr->callback(tmr->context);
+			now = socket_reactor_clock();
+			tmr->deadline = now + tmr->interval;
+		}
+
+		if (tmr->deadline - now < res)
+		{
+			res = tmr->deadline - now;
+		}
+	}
+
+	return res;
+}
+
+static bool socket_reactor_table_add(qsc_socket_reactor_loop* loop, qsc_socket_reactor_connection* conn)
+{
+	qsc_socket_reactor_connection** ptbl;
+	size_t ncap;
+	bool res;
+
+	res = true;
+
+	if (loop->count == loop->capacity)
+	{
+		if (loop->capacity == 0)
+		{
+			ncap = SOCKET_REACTOR_TABLE_INITIAL;
+			ptbl = (qsc_socket_reactor_connection**)qsc_memutils_malloc(ncap * sizeof(qsc_socket_reactor_connection*));
+		}
+		else
+		{
+			ncap = loop->capacity * 2;
+			ptbl = (qsc_socket_reactor_connection**)qsc_memutils_realloc(loop->connections, ncap * sizeof(qsc_socket_reactor_connection*));
+		}
+
+		if (ptbl != NULL)
+		{
+			loop->connections = ptbl;
+			loop->capacity = ncap;
+		}
+		else
+		{
+			res = false;
+		}
+	}
+
+	if (res == true)
+	{
+		conn->index = loop->count;
+		loop->connections[loop->count] = conn;
+		++loop->count;
+	}
+
+	return res;
+}
+
+static void socket_reactor_release(qsc_socket_reactor_loop* loop, qsc_socket_reactor_connection* conn, qsc_socket_exceptions reason)
+{
+	qsc_socket_reactor* reactor;
+	size_t last;
+
+	reactor = (qsc_socket_reactor*)loop->reactor;
+
+	if (reactor->error != NULL)
+	{
+		reactor->error(&conn->result.target, reason);
+	}
+
+	/* swap the last connection into the vacated slot */
+	last = loop->count - 1;
+	loop->connections[conn->index] = loop->connections[last];
+	loop->connections[conn->index]->index = conn->index;
+	loop->connections[last] = NULL;
+	--loop->count;
+
+#if defined(QSC_SOCKET_REACTOR_EPOLL)
+	epoll_ctl(loop->handle, EPOLL_CTL_DEL, conn->result.target.connection, NULL);
+#endif
+	qsc_socket_close_socket(&conn->result.target);
+	qsc_memutils_alloc_free(conn);
+}
+
+static void socket_reactor_accept(qsc_socket_reactor_loop* loop)
+{
+	qsc_socket_reactor* reactor;
+	qsc_socket_reactor_connection* conn;
+	qsc_socket_exceptions err;
+
+	reactor = (qsc_socket_reactor*)loop->reactor;
+
+	/* the listener is edge-triggered, accept until the backlog is empty */
+	while (reactor->running == true)
+	{
+		conn = (qsc_socket_reactor_connection*)qsc_memutils_malloc(sizeof(qsc_socket_reactor_connection));
+
+		if (conn == NULL)
+		{
+			break;
+		}
+
+		qsc_memutils_clear(conn, sizeof(qsc_socket_reactor_connection));
+		err = qsc_socket_accept(&loop->listener, &conn->result.target);
+
+		if (err != qsc_socket_exception_success)
+		{
+			qsc_memutils_alloc_free(conn);
+
+			if (err != qsc_socket_exception_would_block && err != qsc_socket_exception_blocking_cancelled && reactor->error != NULL)
+			{
+				reactor->error(&loop->listener, err);
+			}
+
+			break;
+		}
+
+		socket_reactor_set_nonblocking(&conn->result.target);
+
+#if defined(QSC_SOCKET_REACTOR_EPOLL)
+		struct epoll_event evt = { 0 };
+
+		evt.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+		evt.data.ptr = conn;
+
+		if (socket_reactor_table_add(loop, conn) == false)
+		{
+			qsc_socket_close_socket(&conn->result.target);
+			qsc_memutils_alloc_free(conn);
+			continue;
+		}
+
+		if (epoll_ctl(loop->handle, EPOLL_CTL_ADD, conn->result.target.connection, &evt) != 0)
+		{
+			socket_reactor_release(loop, conn, qsc_socket_get_last_error());
+			continue;
+		}
+#else
+		if (loop->count >= QSC_SOCKET_REACTOR_POLL_MAX || socket_reactor_table_add(loop, conn) == false)
+		{
+			qsc_socket_close_socket(&conn->result.target);
+			qsc_memutils_alloc_free(conn);
+			continue;
+		}
+#endif
+
+		if (reactor->accept != NULL)
+		{
+			reactor->accept(&conn->result);
+		}
+	}
+}
+
+static bool socket_reactor_drain(qsc_socket_reactor_loop* loop, qsc_socket_reactor_connection* conn)
+{
+	qsc_socket_reactor* reactor;
+	qsc_socket_exceptions err;
+	size_t mlen;
+	int32_t rlen;
+	bool res;
+
+	reactor = (qsc_socket_reactor*)loop->reactor;
+	res = true;
+
+	/* read until the socket would block, the peer closes, or an error occurs */
+	while (true)
+	{
+		rlen = recv(conn->result.target.connection, (char*)loop->buffer, (int32_t)sizeof(loop->buffer), 0);
+
+		if (rlen > 0)
+		{
+			mlen = (size_t)rlen;
+			reactor->callback(&conn->result.target, loop->buffer, &mlen);
+		}
+		else if (rlen == 0)
+		{
+			socket_reactor_release(loop, conn, qsc_socket_exception_shut_down);
+			res = false;
+			break;
+		}
+		else
+		{
+			err = qsc_socket_get_last_error();
+
+			if (err != qsc_socket_exception_blocking_cancelled)
+			{
+				if (err != qsc_socket_exception_would_block)
+				{
+					socket_reactor_release(loop, conn, err);
+					res = false;
+				}
+
+				break;
+			}
+		}
+	}
+
+	return res;
+}
+
+#if defined(QSC_SOCKET_REACTOR_EPOLL)
+static void socket_reactor_loop_invoke(qsc_socket_reactor_loop* loop)
+{
+	struct epoll_event evts[QSC_SOCKET_REACTOR_EVENTS_MAX];
+	qsc_socket_reactor* reactor;
+	qsc_socket_reactor_connection* conn;
+	uint64_t wait;
+	int32_t ecnt;
+
+	reactor = (qsc_socket_reactor*)loop->reactor;
+
+	while (reactor->running == true)
+	{
+		wait = (loop == &reactor->loops[0]) ? socket_reactor_timers_service(reactor) : QSC_SOCKET_REACTOR_WAIT_MSEC;
+		ecnt = epoll_wait(loop->handle, evts, (int32_t)QSC_SOCKET_REACTOR_EVENTS_MAX, (int32_t)wait);
+
+		for (int32_t i = 0; i < ecnt; ++i)
+		{
+			conn = (qsc_socket_reactor_connection*)evts[i].data.ptr;
+
+			if (conn == NULL)
+			{
+				socket_reactor_accept(loop);
+			}
+			else if ((evts[i].events & (EPOLLERR | EPOLLHUP)) != 0 && (evts[i].events & EPOLLIN) == 0)
+			{
+				socket_reactor_release(loop, conn, qsc_socket_exception_shut_down);
+			}
+			else
+			{
+				socket_reactor_drain(loop, conn);
+			}
+		}
+	}
+}
+#else
+static void socket_reactor_loop_invoke(qsc_socket_reactor_loop* loop)
+{
+	socket_reactor_pollfd* pfds;
+	qsc_socket_reactor* reactor;
+	size_t pcnt;
+	uint64_t wait;
+	int32_t ecnt;
+
+	reactor = (qsc_socket_reactor*)loop->reactor;
+	pfds = (socket_reactor_pollfd*)qsc_memutils_malloc((QSC_SOCKET_REACTOR_POLL_MAX + 1) * sizeof(socket_reactor_pollfd));
+
+	if (pfds != NULL)
+	{
+		while (reactor->running == true)
+		{
+			wait = socket_reactor_timers_service(reactor);
+
+			/* the listener occupies the first descriptor, followed by the connection table */
+			pfds[0].fd = loop->listener.connection;
+			pfds[0].events = POLLIN;
+			pfds[0].revents = 0;
+			pcnt = loop->count;
+
+			for (size_t i = 0; i < pcnt; ++i)
+			{
+				pfds[i + 1].fd = loop->connections[i]->result.target.connection;
+				pfds[i + 1].events = POLLIN;
+				pfds[i + 1].revents = 0;
+			}
+
+			ecnt = socket_reactor_poll(pfds, (uint32_t)(pcnt + 1), (int32_t)wait);
+
+			if (ecnt > 0)
+			{
+				/* walk the table backwards, a released slot is refilled from an entry already visited */
+				for (size_t i = pcnt; i > 0; --i)
+				{
+					if (pfds[i].revents != 0)
+					{
+						socket_reactor_drain(loop, loop->connections[i - 1]);
+					}
+				}
+
+				if (pfds[0].revents != 0)
+				{
+					socket_reactor_accept(loop);
+				}
+			}
+		}
+
+		qsc_memutils_alloc_free(pfds);
+	}
+}
+#endif
+
+static qsc_socket_exceptions socket_reactor_listener_create(qsc_socket* sock, const char* address, uint16_t port, qsc_socket_address_families family)
+{
+	qsc_socket_exceptions res;
+
+	res = qsc_socket_invalid_input;
+
+	if (family == qsc_socket_address_family_ipv4)
+	{
+		qsc_ipinfo_ipv4_address addt;
+
+		addt = qsc_ipinfo_ipv4_address_from_string(address);
+
+		if (qsc_ipinfo_ipv4_address_is_valid(&addt))
+		{
+			res = qsc_socket_create(sock, qsc_socket_address_family_ipv4, qsc_socket_transport_stream, qsc_socket_protocol_tcp);
+
+			if (res == qsc_socket_exception_success)
+			{
+				socket_reactor_set_reuse(sock);
+				res = qsc_socket_bind_ipv4(sock, &addt, port);
+			}
+		}
+	}
+	else
+	{
+		qsc_ipinfo_ipv6_address addt;
+
+		addt = qsc_ipinfo_ipv6_address_from_string(address);
+
+		if (qsc_ipinfo_ipv6_address_is_valid(&addt))
+		{
+#if defined(QSC_SOCKET_DUAL_IPV6_STACK)
+			res = qsc_socket_create(sock, qsc_socket_address_family_none, qsc_socket_transport_stream, qsc_socket_protocol_tcp);
+#else
+			res = qsc_socket_create(sock, qsc_socket_address_family_ipv6, qsc_socket_transport_stream, qsc_socket_protocol_tcp);
+#endif
+			if (res == qsc_socket_exception_success)
+			{
+				socket_reactor_set_reuse(sock);
+				res = qsc_socket_bind_ipv6(sock, &addt, port);
+#if defined(QSC_SOCKET_DUAL_IPV6_STACK)
+				qsc_socket_set_option(sock, qsc_socket_protocol_ipv6, qsc_socket_option_ipv6_only, 0);
+#endif
+			}
+		}
+	}
+
+	if (res == qsc_socket_exception_success)
+	{
+		res = qsc_socket_listen(sock, QSC_SOCKET_SERVER_LISTEN_BACKLOG);
+
+		if (res == qsc_socket_exception_success)
+		{
+			sock->connection_status = qsc_socket_state_listening;
+			socket_reactor_set_nonblocking(sock);
+		}
+	}
+
+	if (res != qsc_socket_exception_success)
+	{
+		qsc_socket_close_socket(sock);
+	}
+
+	return res;
+}
+
+static void socket_reactor_loop_dispose(qsc_socket_reactor_loop* loop)
+{
+	while (loop->count > 0)
+	{
+		socket_reactor_release(loop, loop->connections[loop->count - 1], qsc_socket_exception_shut_down);
+	}
+
+	if (loop->connections != NULL)
+	{
+		qsc_memutils_alloc_free(loop->connections);
+		loop->connections = NULL;
+	}
+
+	loop->capacity = 0;
+
+#if defined(QSC_SOCKET_REACTOR_EPOLL)
+	if (loop->handle >= 0)
+	{
+		close(loop->handle);
+		loop->handle = -1;
+	}
+#endif
+
+	qsc_socket_close_socket(&loop->listener);
+	qsc_memutils_clear(loop->buffer, sizeof(loop->buffer));
+}
+
+void qsc_socket_reactor_initialize(qsc_socket_reactor* reactor,
+	void (*accept)(qsc_socket_server_accept_result*),
+	void (*callback)(qsc_socket*, const uint8_t*, size_t*),
+	void (*error)(const qsc_socket*, qsc_socket_exceptions))
+{
+	assert(reactor != NULL);
+	assert(callback != NULL);
+
+	if (reactor != NULL)
+	{
+		qsc_memutils_clear(reactor, sizeof(qsc_socket_reactor));
+		reactor->accept = accept;
+		reactor->callback = callback;
+		reactor->error = error;
+
+		for (size_t i = 0; i < QSC_SOCKET_REACTOR_LOOPS_MAX; ++i)
+		{
+			qsc_socket_clear_socket(&reactor->loops[i].listener);
+			reactor->loops[i].reactor = reactor;
+#if defined(QSC_SOCKET_REACTOR_EPOLL)
+			reactor->loops[i].handle = -1;
+#endif
+		}
+	}
+}
+
+bool qsc_socket_reactor_add_timer(qsc_socket_reactor* reactor, uint32_t interval, void (*callback)(void*), void* context)
+{
+	assert(reactor != NULL);
+	assert(callback != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (reactor != NULL && callback != NULL && interval != 0 && reactor->running == false && reactor->tcount < QSC_SOCKET_REACTOR_TIMERS_MAX)
+	{
+		reactor->timers[reactor->tcount].callback = callback;
+		reactor->timers[reactor->tcount].context = context;
+		reactor->timers[reactor->tcount].interval = interval;
+		reactor->timers[reactor->tcount].deadline = socket_reactor_clock() + interval;
+		++reactor->tcount;
+		res = true;
+	}
+
+	return res;
+}
+
+qsc_socket_exceptions qsc_socket_reactor_start(qsc_socket_reactor* reactor, const char* address, uint16_t port, qsc_socket_address_families family, size_t threads)
+{
+	assert(reactor != NULL);
+	assert(address != NULL);
+
+	qsc_socket_reactor_loop* loop;
+	size_t lcnt;
+	qsc_socket_exceptions res;
+
+	res = qsc_socket_invalid_input;
+
+	if (reactor != NULL && address != NULL && reactor->callback != NULL && reactor->running == false)
+	{
+#if defined(QSC_SOCKET_REACTOR_EPOLL)
+		lcnt = (threads == 0) ? qsc_async_processor_count() : threads;
+		lcnt = qsc_intutils_min(qsc_intutils_max(lcnt, 1), QSC_SOCKET_REACTOR_LOOPS_MAX);
+#else
+		/* without SO_REUSEPORT sharding a single loop services the listener */
+		lcnt = 1;
+		(void)threads;
+#endif
+		res = qsc_socket_exception_success;
+
+		for (size_t i = 0; i < lcnt; ++i)
+		{
+			loop = &reactor->loops[i];
+			res = socket_reactor_listener_create(&loop->listener, address, port, family);
+
+			if (res != qsc_socket_exception_success)
+			{
+				break;
+			}
+
+#if defined(QSC_SOCKET_REACTOR_EPOLL)
+			struct epoll_event evt = { 0 };
+
+			loop->handle = epoll_create1(EPOLL_CLOEXEC);
+			evt.events = EPOLLIN | EPOLLET;
+			evt.data.ptr = NULL;
+
+			if (loop->handle < 0 || epoll_ctl(loop->handle, EPOLL_CTL_ADD, loop->listener.connection, &evt) != 0)
+			{
+				res = qsc_socket_get_last_error();
+				socket_reactor_loop_dispose(loop);
+				break;
+			}
+#endif
+
+			reactor->lcount = i + 1;
+		}
+
+		if (res == qsc_socket_exception_success)
+		{
+			reactor->running = true;
+
+			for (size_t i = 0; i < reactor->lcount; ++i)
+			{
+				reactor->loops[i].thread = qsc_async_thread_create((void*)&socket_reactor_loop_invoke, &reactor->loops[i]);
+			}
+		}
+		else
+		{
+			for (size_t i = 0; i < reactor->lcount; ++i)
+			{
+				socket_reactor_loop_dispose(&reactor->loops[i]);
+			}
+
+			reactor->lcount = 0;
+		}
+	}
+
+	return res;
+}
+
+void qsc_socket_reactor_stop(qsc_socket_reactor* reactor)
+{
+	assert(reactor != NULL);
+
+	if (reactor != NULL && reactor->running == true)
+	{
+		reactor->running = false;
+
+		for (size_t i = 0; i < reactor->lcount; ++i)
+		{
+			qsc_async_thread_wait(reactor->loops[i].thread);
+		}
+
+		for (size_t i = 0; i < reactor->lcount; ++i)
+		{
+			socket_reactor_loop_dispose(&reactor->loops[i]);
+		}
+
+		reactor->lcount = 0;
+	}
+}
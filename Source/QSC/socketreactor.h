@@ -0,0 +1,246 @@
+/*
+ * 2025 Quantum Resistant Cryptographic Solutions Corporation
+ * All Rights Reserved.
+ *
+ * NOTICE: This software and all accompanying materials are the exclusive 
+ * property of Quantum Resistant Cryptographic Solutions Corporation (QRCS).
+ * The intellectual and technical concepts contained within this implementation 
+ * are proprietary to QRCS and its authorized licensors and are protected under 
+ * applicable U.S. and international copyright, patent, and trade secret laws.
+ *
+ * CRYPTOGRAPHIC STANDARDS:
+ * - This software includes implementations of cryptographic algorithms such as 
+ *   SHA3, AES, and others. These algorithms are public domain or standardized 
+ *   by organizations such as NIST and are NOT the property of QRCS.
+ * - However, all source code, optimizations, and implementations in this library 
+ *   are original works of QRCS and are protected under this license.
+ *
+ * RESTRICTIONS:
+ * - Redistribution, modification, or unauthorized distribution of this software, 
+ *   in whole or in part, is strictly prohibited.
+ * - This software is provided for non-commercial, educational, and research 
+ *   purposes only. Commercial use in any form is expressly forbidden.
+ * - Licensing and authorized distribution are solely at the discretion of QRCS.
+ * - Any use of this software implies acceptance of these restrictions.
+ *
+ * DISCLAIMER:
+ * This software is provided "as is," without warranty of any kind, express or 
+ * implied, including but not limited to warranties of merchantability or fitness 
+ * for a particular purpose. QRCS disclaims all liability for any direct, indirect, 
+ * incidental, or consequential damages resulting from the use or misuse of this software.
+ *
+ * FULL LICENSE:
+ * This software is subject to the **Quantum Resistant Cryptographic Solutions 
+ * Proprietary License (QRCS-PL)**. The complete license terms are included 
+ * in the LICENSE.txt file distributed with this software.
+ *
+ * Written by: John G. Underhill
+ * Contact: john.underhill@protonmail.com
+ */
+
+#ifndef QSC_SOCKETREACTOR_H
+#define QSC_SOCKETREACTOR_H
+
+#include "common.h"
+#include "async.h"
+#include "socketbase.h"
+#include "socketserver.h"
+
+QSC_CPLUSPLUS_ENABLED_START
+
+/**
+ * \file socketreactor.h
+ * \brief A readiness-based socket server event loop.
+ *
+ * \details
+ * This header defines an event-driven alternative to the thread-per-connection model used by
+ * qsc_socket_server_listen_async and qsc_socket_receive_async. A reactor owns one or more event loops,
+ * each running on its own thread. Every loop waits on a single readiness handle for all of its sockets,
+ * so a loop can service many thousands of connections without creating a thread per client.
+ *
+ * On Linux, each loop is an edge-triggered epoll instance with its own listening socket; the listeners share
+ * the server port through SO_REUSEPORT, and the kernel distributes new connections across the loops.
+ * On other platforms the reactor uses a single poll (WSAPoll on Windows) loop.
+ * All accepted sockets are placed in non-blocking mode. When a socket becomes readable, the loop drains it
+ * into a per-loop buffer and invokes the receive callback once for each block read.
+ *
+ * The callbacks use the same signatures as the existing server API: the accept callback is the
+ * qsc_socket_server_async_accept_state callback, and the receive and error callbacks are those of
+ * qsc_socket_receive_async_state, so existing handlers can be registered without modification.
+ * The socket passed to the callbacks is owned by the reactor, and remains valid until the error callback reports
+ * that the connection has closed. To drop a client from inside a callback, call qsc_socket_shut_down on the socket;
+ * the loop releases it on the next readiness event. Because sockets are non-blocking, a send may write fewer bytes
+ * than requested, and callers should check the return value of qsc_socket_send.
+ *
+ * Periodic timers are serviced by the first loop, and are dispatched between readiness events.
+ * All callbacks on a loop run on that loop's thread; callbacks on different loops may run concurrently.
+ *
+ * \code
+ * static qsc_socket_reactor reactor;
+ *
+ * qsc_socket_reactor_initialize(&reactor, accept_callback, receive_callback, error_callback);
+ * qsc_socket_reactor_add_timer(&reactor, 1000, housekeeping_callback, NULL);
+ *
+ * // start one loop per processor core, listening on port 8080
+ * if (qsc_socket_reactor_start(&reactor, "0.0.0.0", 8080, qsc_socket_address_family_ipv4, 0) == qsc_socket_exception_success)
+ * {
+ *     // ...
+ *     qsc_socket_reactor_stop(&reactor);
+ * }
+ * \endcode
+ *
+ * \section socketreactor_links Reference Links:
+ * - <a href="https://man7.org/linux/man-pages/man7/epoll.7.html">epoll(7) Linux Manual Page</a>
+ * - <a href="https://man7.org/linux/man-pages/man7/socket.7.html">socket(7) SO_REUSEPORT</a>
+ * - <a href="https://learn.microsoft.com/en-us/windows/win32/api/winsock2/nf-winsock2-wsapoll">WSAPoll Function</a>
+ */
+
+/*!
+* \def QSC_SOCKET_REACTOR_EPOLL
+* \brief The reactor uses the edge-triggered Linux epoll interface
+*/
+#if defined(QSC_SYSTEM_OS_LINUX)
+#	define QSC_SOCKET_REACTOR_EPOLL
+#endif
+
+/*!
+* \def QSC_SOCKET_REACTOR_EVENTS_MAX
+* \brief The maximum number of readiness events retrieved by a single wait
+*/
+#define QSC_SOCKET_REACTOR_EVENTS_MAX 256ULL
+
+/*!
+* \def QSC_SOCKET_REACTOR_LOOPS_MAX
+* \brief The maximum number of event loops in a reactor
+*/
+#define QSC_SOCKET_REACTOR_LOOPS_MAX 64ULL
+
+/*!
+* \def QSC_SOCKET_REACTOR_POLL_MAX
+* \brief The maximum number of connections serviced by the poll event loop
+*/
+#define QSC_SOCKET_REACTOR_POLL_MAX 4096ULL
+
+/*!
+* \def QSC_SOCKET_REACTOR_TIMERS_MAX
+* \brief The maximum number of timers registered with a reactor
+*/
+#define QSC_SOCKET_REACTOR_TIMERS_MAX 16ULL
+
+/*!
+* \def QSC_SOCKET_REACTOR_WAIT_MSEC
+* \brief The maximum time in milliseconds a loop waits before checking the stop condition
+*/
+#define QSC_SOCKET_REACTOR_WAIT_MSEC 100ULL
+
+/*** Structures ***/
+
+/*! \struct qsc_socket_reactor_connection
+* \brief A reactor owned connection.
+* The accept result is the first member, so the socket passed to the callbacks
+* can be mapped back to its connection.
+*/
+typedef struct
+{
+	qsc_socket_server_accept_result result;								/*!< The accepted socket */
+	size_t index;														/*!< The connections slot in the loop connection table */
+} qsc_socket_reactor_connection;
+
+/*! \struct qsc_socket_reactor_timer
+* \brief A periodic reactor timer.
+*/
+typedef struct
+{
+	void (*callback)(void* context);									/*!< A pointer to the timer function */
+	void* context;														/*!< The caller supplied timer context */
+	uint64_t interval;													/*!< The timer interval in milliseconds */
+	uint64_t deadline;													/*!< The next expiry time in milliseconds */
+} qsc_socket_reactor_timer;
+
+/*! \struct qsc_socket_reactor_loop
+* \brief A single event loop state.
+*/
+typedef struct
+{
+	qsc_socket listener;												/*!< The loops listening socket */
+	qsc_thread thread;													/*!< The loops thread handle */
+	void* reactor;														/*!< A pointer to the owning reactor */
+	qsc_socket_reactor_connection** connections;						/*!< The loops connection table */
+	size_t capacity;													/*!< The number of slots in the connection table */
+	size_t count;														/*!< The number of active connections */
+#if defined(QSC_SOCKET_REACTOR_EPOLL)
+	int32_t handle;														/*!< The epoll instance handle */
+#endif
+	uint8_t buffer[QSC_SOCKET_RECEIVE_BUFFER_SIZE];						/*!< The loops receive buffer */
+} qsc_socket_reactor_loop;
+
+/*! \struct qsc_socket_reactor
+* \brief The socket reactor state.
+* The accept callback has the signature of qsc_socket_server_async_accept_state,
+* the receive and error callbacks have the signatures of qsc_socket_receive_async_state.
+*/
+typedef struct
+{
+	qsc_socket_reactor_loop loops[QSC_SOCKET_REACTOR_LOOPS_MAX];		/*!< The event loop states */
+	qsc_socket_reactor_timer timers[QSC_SOCKET_REACTOR_TIMERS_MAX];		/*!< The registered timers */
+	void (*accept)(qsc_socket_server_accept_result* result);			/*!< A pointer to the accept callback function */
+	void (*callback)(qsc_socket* sock, const uint8_t* message, size_t* msglen);	/*!< A pointer to the receive callback function */
+	void (*error)(const qsc_socket* sock, qsc_socket_exceptions exception);	/*!< A pointer to the error function */
+	size_t lcount;														/*!< The number of running loops */
+	size_t tcount;														/*!< The number of registered timers */
+	volatile bool running;												/*!< The reactor running state */
+} qsc_socket_reactor;
+
+/*** Function Prototypes ***/
+
+/**
+* \brief Initialize the reactor state and register the callbacks
+*
+* \param reactor:	[qsc_socket_reactor*] A pointer to the reactor state
+* \param accept:	[void (*)(qsc_socket_server_accept_result*)] The accept callback, can be NULL
+* \param callback:	[void (*)(qsc_socket*, const uint8_t*, size_t*)] The receive callback
+* \param error:		[void (*)(const qsc_socket*, qsc_socket_exceptions)] The error callback, invoked with qsc_socket_exception_shut_down when a connection closes, or with the socket error if it fails, can be NULL
+*/
+QSC_EXPORT_API void qsc_socket_reactor_initialize(qsc_socket_reactor* reactor, 
+	void (*accept)(qsc_socket_server_accept_result*), 
+	void (*callback)(qsc_socket*, const uint8_t*, size_t*), 
+	void (*error)(const qsc_socket*, qsc_socket_exceptions));
+
+/**
+* \brief Register a periodic timer with the reactor.
+* Timers must be added before the reactor is started, and are dispatched on the first event loop.
+*
+* \param reactor:	[qsc_socket_reactor*] A pointer to the reactor state
+* \param interval:	[uint32_t] The timer interval in milliseconds
+* \param callback:	[void (*)(void*)] The timer function
+* \param context:	[void*] A caller supplied context passed to the timer function
+*
+* \return			[bool] Returns true if the timer was registered
+*/
+QSC_EXPORT_API bool qsc_socket_reactor_add_timer(qsc_socket_reactor* reactor, uint32_t interval, void (*callback)(void*), void* context);
+
+/**
+* \brief Bind the listening sockets and start the event loops.
+* On Linux, one loop is started per requested thread, each with an SO_REUSEPORT listener on the same port.
+* Other platforms run a single poll loop.
+*
+* \param reactor:	[qsc_socket_reactor*] A pointer to the initialized reactor state
+* \param address:	[const char*] The servers address
+* \param port:		[uint16_t] The servers port number
+* \param family:	[qsc_socket_address_families] The socket address family
+* \param threads:	[size_t] The number of event loops, a value of zero uses the processor count
+*
+* \return			[qsc_socket_exceptions] Returns an exception code on failure, or success(0)
+*/
+QSC_EXPORT_API qsc_socket_exceptions qsc_socket_reactor_start(qsc_socket_reactor* reactor, const char* address, uint16_t port, qsc_socket_address_families family, size_t threads);
+
+/**
+* \brief Stop the event loops, close all connections and listeners, and release the reactor resources
+*
+* \param reactor:	[qsc_socket_reactor*] A pointer to the reactor state
+*/
+QSC_EXPORT_API void qsc_socket_reactor_stop(qsc_socket_reactor* reactor);
+
+QSC_CPLUSPLUS_ENABLED_END
+
+#endif
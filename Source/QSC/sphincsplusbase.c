@@ -201,6 +201,10 @@
 #   error SPX_D should always divide SPX_FULL_HEIGHT
 #endif
 
+/* Upper bounds of the thash input blocks and treehash heights, used to size the stack buffers. */
+#define SPX_THASH_MAXBLOCKS ((SPX_WOTS_LEN > SPX_FORS_TREES) ? SPX_WOTS_LEN : SPX_FORS_TREES)
+#define SPX_TREEHASH_MAXHEIGHT ((SPX_TREE_HEIGHT > SPX_FORS_HEIGHT) ? SPX_TREE_HEIGHT : SPX_FORS_HEIGHT)
+
 /* Optionally, signing can be made non-deterministic using optrand.
 This can help counter side-channel attacks that would benefit from
 getting a large number of traces when the signer uses the same nodes. */
@@ -445,37 +449,30 @@ static void sphincsplus_thash(uint8_t* out, const uint8_t* in, uint32_t inblocks
     /* Takes an array of inblocks concatenated arrays of SPX_N bytes */
     const size_t BLKLEN = (size_t)inblocks * SPX_N;
     const size_t KEYLEN = SPX_N + SPX_ADDR_BYTES;
-    uint8_t* buf;
-    uint8_t* bitmask;
+    uint8_t buf[SPX_N + SPX_ADDR_BYTES + (SPX_THASH_MAXBLOCKS * SPX_N)];
+    uint8_t bitmask[SPX_THASH_MAXBLOCKS * SPX_N];
 
-    buf = (uint8_t*)qsc_memutils_malloc(KEYLEN + BLKLEN);
-    bitmask = (uint8_t*)qsc_memutils_malloc(BLKLEN);
-    assert(buf != NULL && bitmask != NULL);
+    assert(inblocks <= SPX_THASH_MAXBLOCKS);
 
-    if (buf != NULL && bitmask != NULL)
-    {
-        qsc_memutils_copy(buf, pubseed, SPX_N);
-        qsc_memutils_copy(buf + SPX_N, (uint8_t*)addr, SPX_ADDR_BYTES);
+    qsc_memutils_copy(buf, pubseed, SPX_N);
+    qsc_memutils_copy(buf + SPX_N, (uint8_t*)addr, SPX_ADDR_BYTES);
 
 #if defined(QSC_SPHINCSPLUS_EXTENDED)
 
 #else
-        qsc_shake256_compute(bitmask, BLKLEN, buf, KEYLEN);
+    qsc_shake256_compute(bitmask, BLKLEN, buf, KEYLEN);
 #endif
 
-        for (size_t i = 0; i < BLKLEN; ++i)
-        {
-            buf[KEYLEN + i] = in[i] ^ bitmask[i];
-        }
+    for (size_t i = 0; i < BLKLEN; ++i)
+    {
+        buf[KEYLEN + i] = in[i] ^ bitmask[i];
+    }
 
 #if defined(QSC_SPHINCSPLUS_EXTENDED)
-        qsc_shake512_compute(out, SPX_N, buf, KEYLEN + BLKLEN);
+    qsc_shake512_compute(out, SPX_N, buf, KEYLEN + BLKLEN);
 #else
-        qsc_shake256_compute(out, SPX_N, buf, KEYLEN + BLKLEN);
+    qsc_shake256_compute(out, SPX_N, buf, KEYLEN + BLKLEN);
 #endif
-        qsc_memutils_alloc_free(bitmask);
-        qsc_memutils_alloc_free(buf);
-    }
 }
 
 static void sphincsplus_compute_root(uint8_t* root, const uint8_t* leaf, uint32_t leaf_idx, uint32_t idx_offset, const uint8_t* auth_path,
@@ -550,58 +547,52 @@ static void sphincsplus_treehash(uint8_t* root, uint8_t* auth_path, const uint8_
        Applies the offset idx_offset to indices before building addresses, so that
        it is possible to continue counting indices across trees. */
 
-    uint8_t* stack;
-    uint32_t* heights;
+    uint8_t stack[(SPX_TREEHASH_MAXHEIGHT + 1) * SPX_N];
+    uint32_t heights[SPX_TREEHASH_MAXHEIGHT + 1];
     uint32_t offset;
     uint32_t tree_idx;
 
+    assert(tree_height <= SPX_TREEHASH_MAXHEIGHT);
+
     offset = 0;
-    stack = (uint8_t*)qsc_memutils_malloc(((size_t)tree_height + 1) * SPX_N);
-    heights = (uint32_t*)qsc_memutils_malloc(((size_t)tree_height + 1) * sizeof(uint32_t));
-    assert(stack != NULL && heights != NULL);
 
-    if (stack != NULL && heights != NULL)
+    for (uint32_t idx = 0; idx < (uint32_t)(1 << tree_height); ++idx)
     {
-        for (uint32_t idx = 0; idx < (uint32_t)(1 << tree_height); ++idx)
+        /* Add the next leaf node to the stack. */
+        gen_leaf(stack + offset * SPX_N, sk_seed, pubseed, idx + idx_offset, tree_addr);
+        offset++;
+        heights[offset - 1] = 0;
+
+        /* If this is a node we need for the auth path.. */
+        if ((leaf_idx ^ 0x1) == idx)
         {
-            /* Add the next leaf node to the stack. */
-            gen_leaf(stack + offset * SPX_N, sk_seed, pubseed, idx + idx_offset, tree_addr);
-            offset++;
-            heights[offset - 1] = 0;
+            qsc_memutils_copy(auth_path, stack + (offset - 1) * SPX_N, SPX_N);
+        }
 
-            /* If this is a node we need for the auth path.. */
-            if ((leaf_idx ^ 0x1) == idx)
-            {
-                qsc_memutils_copy(auth_path, stack + (offset - 1) * SPX_N, SPX_N);
-            }
+        /* While the top-most nodes are of equal height.. */
+        while (offset >= 2 && heights[offset - 1] == heights[offset - 2])
+        {
+            /* Compute index of the new node, in the next layer. */
+            tree_idx = (idx >> (heights[offset - 1] + 1));
+
+            /* Set the address of the node we're creating. */
+            sphincsplus_set_tree_height(tree_addr, heights[offset - 1] + 1);
+            sphincsplus_set_tree_index(tree_addr, tree_idx + (idx_offset >> (heights[offset - 1] + 1)));
+            /* Hash the top-most nodes from the stack together. */
+            sphincsplus_thash(stack + (offset - 2) * SPX_N, stack + (offset - 2) * SPX_N, 2, pubseed, tree_addr);
+            --offset;
+            /* Note that the top-most node is now one layer higher. */
+            ++heights[offset - 1];
 
-            /* While the top-most nodes are of equal height.. */
-            while (offset >= 2 && heights[offset - 1] == heights[offset - 2])
+            /* If this is a node we need for the auth path.. */
+            if (((leaf_idx >> heights[offset - 1]) ^ 0x1) == tree_idx)
             {
-                /* Compute index of the new node, in the next layer. */
-                tree_idx = (idx >> (heights[offset - 1] + 1));
-
-                /* Set the address of the node we're creating. */
-                sphincsplus_set_tree_height(tree_addr, heights[offset - 1] + 1);
-                sphincsplus_set_tree_index(tree_addr, tree_idx + (idx_offset >> (heights[offset - 1] + 1)));
-                /* Hash the top-most nodes from the stack together. */
-                sphincsplus_thash(stack + (offset - 2) * SPX_N, stack + (offset - 2) * SPX_N, 2, pubseed, tree_addr);
-                --offset;
-                /* Note that the top-most node is now one layer higher. */
-                ++heights[offset - 1];
-
-                /* If this is a node we need for the auth path.. */
-                if (((leaf_idx >> heights[offset - 1]) ^ 0x1) == tree_idx)
-                {
-                    qsc_memutils_copy(auth_path + heights[offset - 1] * SPX_N, stack + (offset - 1) * SPX_N, SPX_N);
-                }
+                qsc_memutils_copy(auth_path + heights[offset - 1] * SPX_N, stack + (offset - 1) * SPX_N, SPX_N);
             }
         }
-
-        qsc_memutils_copy(root, stack, SPX_N);
-        qsc_memutils_alloc_free(heights);
-        qsc_memutils_alloc_free(stack);
     }
+
+    qsc_memutils_copy(root, stack, SPX_N);
 }
 
 /* fors.c */
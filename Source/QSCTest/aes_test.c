@@ -770,6 +770,215 @@ bool qsctest_aes256_padding_test()
 	return status;
 }
 
+bool qsctest_aes256_ctr_parallel_equality()
+{
+	/* lengths shorter than one thread's share, and lengths that are not a multiple of the block size */
+	const size_t lens[] = { 1U, 15U, 17U, 0x0FFFFU, 0x10001U, 0x30011U, 0x80005U };
+	const size_t thds[] = { 0U, 1U, 3U, 8U };
+	uint8_t key[QSC_AES256_KEY_SIZE] = { 0 };
+	uint8_t ncopy[QSC_AES_BLOCK_SIZE] = { 0 };
+	uint8_t nonce1[QSC_AES_BLOCK_SIZE] = { 0 };
+	uint8_t nonce2[QSC_AES_BLOCK_SIZE] = { 0 };
+	uint8_t* enc1;
+	uint8_t* enc2;
+	uint8_t* msg;
+	const size_t mlen = lens[(sizeof(lens) / sizeof(lens[0])) - 1U];
+	qsc_aes_state state1;
+	qsc_aes_state state2;
+	bool status;
+
+	status = true;
+	enc1 = (uint8_t*)qsc_memutils_malloc(mlen);
+	enc2 = (uint8_t*)qsc_memutils_malloc(mlen);
+	msg = (uint8_t*)qsc_memutils_malloc(mlen);
+
+	if (enc1 != NULL && enc2 != NULL && msg != NULL)
+	{
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(ncopy, sizeof(ncopy));
+		qsc_csp_generate(msg, mlen);
+		/* start near the top of the low counter bytes so the increment carries */
+		qsc_memutils_set_value(ncopy + QSC_AES_BLOCK_SIZE - 3U, 3U, 0xFFU);
+
+		for (size_t i = 0U; i < sizeof(lens) / sizeof(lens[0]) && status == true; ++i)
+		{
+			for (size_t j = 0U; j < sizeof(thds) / sizeof(thds[0]); ++j)
+			{
+				qsc_aes_keyparams kp1 = { key, sizeof(key), nonce1, NULL, 0 };
+				qsc_aes_keyparams kp2 = { key, sizeof(key), nonce2, NULL, 0 };
+
+				qsc_memutils_copy(nonce1, ncopy, sizeof(ncopy));
+				qsc_memutils_copy(nonce2, ncopy, sizeof(ncopy));
+				qsc_aes_initialize(&state1, &kp1, true, qsc_aes_cipher_256);
+				qsc_aes_initialize(&state2, &kp2, true, qsc_aes_cipher_256);
+
+				qsc_aes_ctrbe_transform(&state1, enc1, msg, lens[i]);
+				qsc_aes_ctrbe_transform_parallel(&state2, enc2, msg, lens[i], thds[j]);
+				qsc_aes_dispose(&state1);
+				qsc_aes_dispose(&state2);
+
+				/* the output and the final counter must match the sequential transform */
+				if (qsc_intutils_are_equal8(enc1, enc2, lens[i]) == false ||
+					qsc_intutils_are_equal8(nonce1, nonce2, sizeof(nonce1)) == false)
+				{
+					qsctest_print_safe("Failure! aes256_ctr_parallel_equality: output does not match the sequential transform -AP1 \n");
+					status = false;
+					break;
+				}
+
+				/* transform in place */
+				qsc_memutils_copy(nonce2, ncopy, sizeof(ncopy));
+				qsc_aes_initialize(&state2, &kp2, true, qsc_aes_cipher_256);
+				qsc_memutils_copy(enc2, msg, lens[i]);
+				qsc_aes_ctrbe_transform_parallel(&state2, enc2, enc2, lens[i], thds[j]);
+				qsc_aes_dispose(&state2);
+
+				if (qsc_intutils_are_equal8(enc1, enc2, lens[i]) == false)
+				{
+					qsctest_print_safe("Failure! aes256_ctr_parallel_equality: in-place output does not match the sequential transform -AP2 \n");
+					status = false;
+					break;
+				}
+			}
+		}
+	}
+	else
+	{
+		status = false;
+	}
+
+	if (enc1 != NULL)
+	{
+		qsc_memutils_alloc_free(enc1);
+	}
+
+	if (enc2 != NULL)
+	{
+		qsc_memutils_alloc_free(enc2);
+	}
+
+	if (msg != NULL)
+	{
+		qsc_memutils_alloc_free(msg);
+	}
+
+	return status;
+}
+
+bool qsctest_aes256_ctr_seek()
+{
+	/* offset and length pairs, block-aligned and mid-block, including ranges that cross a block boundary */
+	const size_t rngs[][2] = { { 0U, 1U }, { 1U, 100U }, { 127U, 2U }, { 128U, 0x1000U }, { 129U, 0x10005U },
+		{ 0x20000U, 0x20007U }, { 0x20003U, 0x20004U }, { 0x40006U, 1U } };
+	const size_t mlen = 0x40007U;
+	uint8_t key[QSC_AES256_KEY_SIZE] = { 0 };
+	uint8_t ncopy[QSC_AES_BLOCK_SIZE] = { 0 };
+	uint8_t nonce[QSC_AES_BLOCK_SIZE] = { 0 };
+	uint8_t* enc;
+	uint8_t* msg;
+	uint8_t* otp;
+	qsc_aes_state state;
+	bool status;
+
+	status = true;
+	enc = (uint8_t*)qsc_memutils_malloc(mlen);
+	msg = (uint8_t*)qsc_memutils_malloc(mlen);
+	otp = (uint8_t*)qsc_memutils_malloc(mlen);
+
+	if (enc != NULL && msg != NULL && otp != NULL)
+	{
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(ncopy, sizeof(ncopy));
+		qsc_csp_generate(msg, mlen);
+
+		qsc_aes_keyparams kp = { key, sizeof(key), nonce, NULL, 0 };
+
+		/* the big endian counter, then the little endian counter */
+		for (size_t m = 0U; m < 2U && status == true; ++m)
+		{
+			/* one long sequential key-stream */
+			qsc_memutils_copy(nonce, ncopy, sizeof(nonce));
+			qsc_aes_initialize(&state, &kp, true, qsc_aes_cipher_256);
+
+			if (m == 0U)
+			{
+				qsc_aes_ctrbe_transform(&state, enc, msg, mlen);
+			}
+			else
+			{
+				qsc_aes_ctrle_transform(&state, enc, msg, mlen);
+			}
+
+			qsc_aes_dispose(&state);
+
+			for (size_t i = 0U; i < sizeof(rngs) / sizeof(rngs[0]); ++i)
+			{
+				const size_t oft = rngs[i][0];
+				const size_t len = rngs[i][1];
+
+				qsc_aes_initialize(&state, &kp, true, qsc_aes_cipher_256);
+
+				if (m == 0U)
+				{
+					qsc_aes_ctrbe_seek(&state, ncopy, oft);
+					qsc_aes_ctrbe_transform(&state, otp, msg + oft, len);
+				}
+				else
+				{
+					qsc_aes_ctrle_seek(&state, ncopy, oft);
+					qsc_aes_ctrle_transform(&state, otp, msg + oft, len);
+				}
+
+				qsc_aes_dispose(&state);
+
+				if (qsc_intutils_are_equal8(otp, enc + oft, len) == false)
+				{
+					qsctest_print_safe("Failure! aes256_ctr_seek: output does not match the sequential key-stream -AE1 \n");
+					status = false;
+					break;
+				}
+
+				if (m == 0U)
+				{
+					/* resume the partial block, then divide the rest between threads */
+					qsc_aes_initialize(&state, &kp, true, qsc_aes_cipher_256);
+					qsc_aes_ctrbe_seek(&state, ncopy, oft);
+					qsc_aes_ctrbe_transform_parallel(&state, otp, msg + oft, len, 3U);
+					qsc_aes_dispose(&state);
+
+					if (qsc_intutils_are_equal8(otp, enc + oft, len) == false)
+					{
+						qsctest_print_safe("Failure! aes256_ctr_seek: parallel output does not match the sequential key-stream -AE2 \n");
+						status = false;
+						break;
+					}
+				}
+			}
+		}
+	}
+	else
+	{
+		status = false;
+	}
+
+	if (enc != NULL)
+	{
+		qsc_memutils_alloc_free(enc);
+	}
+
+	if (msg != NULL)
+	{
+		qsc_memutils_alloc_free(msg);
+	}
+
+	if (otp != NULL)
+	{
+		qsc_memutils_alloc_free(otp);
+	}
+
+	return status;
+}
+
 void qsctest_aes_run()
 {
 	if (qsctest_fips_aes128_cbc() == true)
@@ -852,4 +1061,22 @@ void qsctest_aes_run()
 	{
 		qsctest_print_safe("Failure! Failed the PKCS7 padding mode stress test. \n");
 	}
+
+	if (qsctest_aes256_ctr_parallel_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the CTR(AES-256) parallel transform equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the CTR(AES-256) parallel transform equality test. \n");
+	}
+
+	if (qsctest_aes256_ctr_seek() == true)
+	{
+		qsctest_print_safe("Success! Passed the CTR(AES-256) key-stream seek test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the CTR(AES-256) key-stream seek test. \n");
+	}
 }
@@ -86,6 +86,14 @@
  *   byte values might mimic padding.
  *   - `qsctest_aes256_padding_test()` performs these checks.
  *
+ * - **CTR Mode Parallel Equality Test**: This test compares the multi-threaded CTR transform with the sequential
+ *   transform over message lengths that do not divide evenly between threads or into blocks.
+ *   - `qsctest_aes256_ctr_parallel_equality()` performs this comparison.
+ *
+ * - **CTR Mode Seek Test**: This test seeks the CTR key-stream to block-aligned and mid-block offsets and compares
+ *   each range with the same bytes of one long sequential transform.
+ *   - `qsctest_aes256_ctr_seek()` performs this comparison.
+ *
  * - **Comprehensive Test Runner**: Finally, the function `qsctest_aes_run()` executes all of the above tests sequentially,
  *   printing the outcome of each to the console.
  *
@@ -240,6 +248,34 @@ bool qsctest_aes256_hba_stress(void);
  */
 bool qsctest_aes256_padding_test(void);
 
+/**
+ * \brief Tests the parallel AES-256 CTR mode transform for equality with the sequential transform.
+ *
+ * \details
+ * This function encrypts random messages with qsc_aes_ctrbe_transform and with qsc_aes_ctrbe_transform_parallel,
+ * using a range of thread counts, and verifies that:
+ *  - The cipher-text and the final counter are identical, including lengths shorter than one thread's share
+ *    and lengths that are not a multiple of the block size.
+ *  - An in-place parallel transform produces the same cipher-text.
+ *
+ * \return Returns true if the parallel output matches the sequential output; otherwise, false.
+ */
+bool qsctest_aes256_ctr_parallel_equality(void);
+
+/**
+ * \brief Tests positioning the AES-256 CTR mode key-stream at a byte offset.
+ *
+ * \details
+ * This function encrypts one long random message with the big endian and little endian counters, then for
+ * a set of block-aligned and mid-block offsets it:
+ *  - Seeks a new state to the offset with qsc_aes_ctrbe_seek or qsc_aes_ctrle_seek, and transforms a range.
+ *  - Verifies that the output matches the same bytes of the long sequential cipher-text.
+ *  - Repeats the big endian range with qsc_aes_ctrbe_transform_parallel after the seek.
+ *
+ * \return Returns true if every range matches the sequential cipher-text; otherwise, false.
+ */
+bool qsctest_aes256_ctr_seek(void);
+
 /**
  * \brief Runs the complete suite of AES tests.
  *
@@ -255,6 +291,8 @@ bool qsctest_aes256_padding_test(void);
  *  - HBA-RHX AEAD Mode Known Answer Test.
  *  - HBA-RHX AEAD Mode Stress Test.
  *  - PKCS7 Padding Test.
+ *  - CTR Mode Parallel Transform Equality Test.
+ *  - CTR Mode Key-Stream Seek Test.
  *
  * This comprehensive test runner validates both the correctness and the resilience of the AES and AEAD implementations.
  */
@@ -0,0 +1,326 @@
+#include "asyncio_test.h"
+#include "../QSC/asyncio.h"
+#include "../QSC/csp.h"
+#include "../QSC/fileutils.h"
+#include "../QSC/intutils.h"
+#include "../QSC/ipinfo.h"
+#include "../QSC/memutils.h"
+#include "../QSC/socketbase.h"
+#include "../QSC/socketclient.h"
+#include "../QSC/socketserver.h"
+#include "testutils.h"
+
+#define ASYNCIO_TEST_PATH "asyncio_test.tmp"
+#define ASYNCIO_TEST_BLOCK 0x10000U
+#define ASYNCIO_TEST_BLOCKS 16U
+#define ASYNCIO_TEST_MESSAGE 4000U
+#define ASYNCIO_TEST_PORT_URING 38561U
+#define ASYNCIO_TEST_PORT_SYNC 38562U
+
+static bool asyncio_test_file(qsc_asyncio_state* state)
+{
+	qsc_asyncio_completion cmp[ASYNCIO_TEST_BLOCKS + 1U];
+	uint8_t* inp;
+	uint8_t* otp;
+	uint8_t* reg;
+	FILE* fp;
+	size_t clen;
+	size_t rlen;
+	size_t tlen;
+	bool res;
+
+	res = false;
+	inp = (uint8_t*)qsc_memutils_malloc(ASYNCIO_TEST_BLOCK * ASYNCIO_TEST_BLOCKS);
+	otp = (uint8_t*)qsc_memutils_malloc(ASYNCIO_TEST_BLOCK * ASYNCIO_TEST_BLOCKS);
+	reg = (uint8_t*)qsc_memutils_malloc(ASYNCIO_TEST_BLOCK);
+	fp = qsc_fileutils_open(ASYNCIO_TEST_PATH, qsc_fileutils_mode_write_update, true);
+
+	if (inp != NULL && otp != NULL && reg != NULL && fp != NULL)
+	{
+		const size_t rlens[1U] = { ASYNCIO_TEST_BLOCK };
+
+		res = true;
+		qsc_csp_generate(inp, ASYNCIO_TEST_BLOCK * ASYNCIO_TEST_BLOCKS);
+		qsc_memutils_clear(otp, ASYNCIO_TEST_BLOCK * ASYNCIO_TEST_BLOCKS);
+
+		/* registration is an optimization; a failure is not an error, the operations must still complete */
+		qsc_asyncio_register_file(state, fp);
+		qsc_asyncio_register_buffers(state, &reg, rlens, 1U);
+
+		/* write the file in blocks, each block tagged with its index */
+		for (size_t i = 0U; i < ASYNCIO_TEST_BLOCKS; ++i)
+		{
+			if (qsc_asyncio_file_write(state, fp, inp + (i * ASYNCIO_TEST_BLOCK), ASYNCIO_TEST_BLOCK, i * ASYNCIO_TEST_BLOCK, (void*)(uintptr_t)(i + 1U)) == false)
+			{
+				qsctest_print_line("asyncio test: a file write could not be queued.");
+				res = false;
+			}
+		}
+
+		clen = 0U;
+		tlen = 0U;
+
+		while (res == true && clen < ASYNCIO_TEST_BLOCKS)
+		{
+			rlen = qsc_asyncio_wait(state, cmp, ASYNCIO_TEST_BLOCKS, ASYNCIO_TEST_BLOCKS - clen);
+
+			if (rlen == 0U)
+			{
+				res = false;
+				break;
+			}
+
+			for (size_t i = 0U; i < rlen; ++i)
+			{
+				if (cmp[i].operation != qsc_asyncio_operation_file_write || cmp[i].result != (int64_t)ASYNCIO_TEST_BLOCK ||
+					(uintptr_t)cmp[i].context == 0U || (uintptr_t)cmp[i].context > ASYNCIO_TEST_BLOCKS)
+				{
+					res = false;
+				}
+
+				tlen += (cmp[i].result > 0) ? (size_t)cmp[i].result : 0U;
+			}
+
+			clen += rlen;
+		}
+
+		if (res == false || tlen != ASYNCIO_TEST_BLOCK * ASYNCIO_TEST_BLOCKS)
+		{
+			qsctest_print_line("asyncio test: the file write completions are invalid.");
+			res = false;
+		}
+
+		if (res == true)
+		{
+			/* read the file back in blocks, and the second block again into the registered buffer */
+			for (size_t i = 0U; i < ASYNCIO_TEST_BLOCKS; ++i)
+			{
+				res &= qsc_asyncio_file_read(state, fp, otp + (i * ASYNCIO_TEST_BLOCK), ASYNCIO_TEST_BLOCK, i * ASYNCIO_TEST_BLOCK, NULL);
+			}
+
+			res &= qsc_asyncio_file_read(state, fp, reg, ASYNCIO_TEST_BLOCK, ASYNCIO_TEST_BLOCK, (void*)reg);
+			clen = 0U;
+
+			while (res == true && clen < ASYNCIO_TEST_BLOCKS + 1U)
+			{
+				rlen = qsc_asyncio_wait(state, cmp, ASYNCIO_TEST_BLOCKS + 1U, (ASYNCIO_TEST_BLOCKS + 1U) - clen);
+
+				if (rlen == 0U)
+				{
+					res = false;
+					break;
+				}
+
+				for (size_t i = 0U; i < rlen; ++i)
+				{
+					if (cmp[i].operation != qsc_asyncio_operation_file_read || cmp[i].result != (int64_t)ASYNCIO_TEST_BLOCK)
+					{
+						res = false;
+					}
+				}
+
+				clen += rlen;
+			}
+
+			if (res == false || qsc_intutils_are_equal8(otp, inp, ASYNCIO_TEST_BLOCK * ASYNCIO_TEST_BLOCKS) == false ||
+				qsc_intutils_are_equal8(reg, inp + ASYNCIO_TEST_BLOCK, ASYNCIO_TEST_BLOCK) == false)
+			{
+				qsctest_print_line("asyncio test: the file read data does not match the written data.");
+				res = false;
+			}
+		}
+
+		/* release the registration before the buffer is freed */
+		qsc_asyncio_register_buffers(state, &reg, rlens, 0U);
+	}
+
+	if (fp != NULL)
+	{
+		qsc_fileutils_close(fp);
+		qsc_fileutils_delete(ASYNCIO_TEST_PATH);
+	}
+
+	if (inp != NULL)
+	{
+		qsc_memutils_alloc_free(inp);
+	}
+
+	if (otp != NULL)
+	{
+		qsc_memutils_alloc_free(otp);
+	}
+
+	if (reg != NULL)
+	{
+		qsc_memutils_alloc_free(reg);
+	}
+
+	return res;
+}
+
+static bool asyncio_test_socket(qsc_asyncio_state* state, uint16_t port)
+{
+	qsc_asyncio_completion cmp[2U];
+	uint8_t inp[ASYNCIO_TEST_MESSAGE] = { 0U };
+	uint8_t otp[ASYNCIO_TEST_MESSAGE] = { 0U };
+	qsc_ipinfo_ipv4_address addr;
+	qsc_socket acc;
+	qsc_socket clt;
+	qsc_socket srv;
+	size_t rlen;
+	size_t slen;
+	bool res;
+
+	res = false;
+	addr = qsc_ipinfo_ipv4_address_loopback();
+	qsc_socket_server_initialize(&srv);
+	qsc_socket_server_initialize(&acc);
+	qsc_socket_client_initialize(&clt);
+
+	if (qsc_socket_create(&srv, qsc_socket_address_family_ipv4, qsc_socket_transport_stream, qsc_socket_protocol_tcp) == qsc_socket_exception_success &&
+		qsc_socket_bind_ipv4(&srv, &addr, port) == qsc_socket_exception_success &&
+		qsc_socket_listen(&srv, 4) == qsc_socket_exception_success &&
+		qsc_socket_client_connect_ipv4(&clt, &addr, port) == qsc_socket_exception_success &&
+		qsc_socket_accept(&srv, &acc) == qsc_socket_exception_success)
+	{
+		res = true;
+		qsc_csp_generate(inp, sizeof(inp));
+		qsc_asyncio_register_socket(state, &acc);
+		slen = 0U;
+		rlen = 0U;
+
+		/* send from the client and receive on the accepted socket, until the whole message has arrived */
+		while (res == true && rlen < sizeof(inp))
+		{
+			size_t ccnt;
+			size_t ncnt;
+
+			ncnt = 0U;
+
+			if (slen < sizeof(inp))
+			{
+				res &= qsc_asyncio_socket_send(state, &clt, inp + slen, sizeof(inp) - slen, (void*)&clt);
+				++ncnt;
+			}
+
+			res &= qsc_asyncio_socket_receive(state, &acc, otp + rlen, sizeof(otp) - rlen, (void*)&acc);
+			++ncnt;
+			ccnt = 0U;
+
+			while (res == true && ccnt < ncnt)
+			{
+				size_t clen;
+
+				clen = qsc_asyncio_wait(state, cmp, 2U, ncnt - ccnt);
+
+				if (clen == 0U)
+				{
+					res = false;
+					break;
+				}
+
+				for (size_t i = 0U; i < clen; ++i)
+				{
+					if (cmp[i].result <= 0)
+					{
+						res = false;
+					}
+					else if (cmp[i].context == (void*)&clt && cmp[i].operation == qsc_asyncio_operation_socket_send)
+					{
+						slen += (size_t)cmp[i].result;
+					}
+					else if (cmp[i].context == (void*)&acc && cmp[i].operation == qsc_asyncio_operation_socket_receive)
+					{
+						rlen += (size_t)cmp[i].result;
+					}
+					else
+					{
+						res = false;
+					}
+				}
+
+				ccnt += clen;
+			}
+		}
+
+		if (res == false || slen != sizeof(inp) || rlen != sizeof(inp) || qsc_intutils_are_equal8(otp, inp, sizeof(inp)) == false)
+		{
+			qsctest_print_line("asyncio test: the loopback socket data does not match the sent data.");
+			res = false;
+		}
+	}
+	else
+	{
+		qsctest_print_line("asyncio test: the loopback connection could not be established.");
+	}
+
+	qsc_socket_client_shut_down(&clt);
+	qsc_socket_server_shut_down(&acc);
+	qsc_socket_close_socket(&srv);
+
+	return res;
+}
+
+bool qsctest_asyncio_uring_test()
+{
+	qsc_asyncio_state state;
+	bool res;
+
+	res = false;
+
+	if (qsc_asyncio_initialize(&state, 32U) == true)
+	{
+		if (state.uring == false)
+		{
+			qsctest_print_line("io_uring is not available on this system, the synchronous queue was tested.");
+		}
+
+		res = asyncio_test_file(&state);
+		res &= asyncio_test_socket(&state, ASYNCIO_TEST_PORT_URING);
+		qsc_asyncio_dispose(&state);
+	}
+
+	return res;
+}
+
+bool qsctest_asyncio_synchronous_test()
+{
+	qsc_asyncio_state state;
+	bool res;
+
+	res = false;
+
+	if (qsc_asyncio_initialize(&state, 32U) == true)
+	{
+		/* select the synchronous path; an io_uring instance that was created is still released by dispose */
+		state.uring = false;
+		state.fixed = false;
+
+		res = asyncio_test_file(&state);
+		res &= asyncio_test_socket(&state, ASYNCIO_TEST_PORT_SYNC);
+		qsc_asyncio_dispose(&state);
+	}
+
+	return res;
+}
+
+void qsctest_asyncio_run()
+{
+	if (qsctest_asyncio_uring_test() == true)
+	{
+		qsctest_print_line("Success! Passed the io_uring completion queue file and loopback socket tests.");
+	}
+	else
+	{
+		qsctest_print_line("Failure! Failed the io_uring completion queue file and loopback socket tests.");
+	}
+
+	if (qsctest_asyncio_synchronous_test() == true)
+	{
+		qsctest_print_line("Success! Passed the synchronous completion queue file and loopback socket tests.");
+	}
+	else
+	{
+		qsctest_print_line("Failure! Failed the synchronous completion queue file and loopback socket tests.");
+	}
+}
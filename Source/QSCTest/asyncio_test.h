@@ -0,0 +1,85 @@
+/* 2025 Quantum Resistant Cryptographic Solutions Corporation
+ * All Rights Reserved.
+ *
+ * NOTICE: This software and all accompanying materials are the exclusive 
+ * property of Quantum Resistant Cryptographic Solutions Corporation (QRCS).
+ * The intellectual and technical concepts contained within this implementation 
+ * are proprietary to QRCS and its authorized licensors and are protected under 
+ * applicable U.S. and international copyright, patent, and trade secret laws.
+ *
+ * CRYPTOGRAPHIC STANDARDS:
+ * - This software includes implementations of cryptographic algorithms such as 
+ *   SHA3, AES, and others. These algorithms are public domain or standardized 
+ *   by organizations such as NIST and are NOT the property of QRCS.
+ * - However, all source code, optimizations, and implementations in this library 
+ *   are original works of QRCS and are protected under this license.
+ *
+ * RESTRICTIONS:
+ * - Redistribution, modification, or unauthorized distribution of this software, 
+ *   in whole or in part, is strictly prohibited.
+ * - This software is provided for non-commercial, educational, and research 
+ *   purposes only. Commercial use in any form is expressly forbidden.
+ * - Licensing and authorized distribution are solely at the discretion of QRCS.
+ * - Any use of this software implies acceptance of these restrictions.
+ *
+ * DISCLAIMER:
+ * This software is provided "as is," without warranty of any kind, express or 
+ * implied, including but not limited to warranties of merchantability or fitness 
+ * for a particular purpose. QRCS disclaims all liability for any direct, indirect, 
+ * incidental, or consequential damages resulting from the use or misuse of this software.
+ *
+ * FULL LICENSE:
+ * This software is subject to the **Quantum Resistant Cryptographic Solutions 
+ * Proprietary License (QRCS-PL)**. The complete license terms are included 
+ * in the LICENSE.txt file distributed with this software.
+ *
+ * Written by: John G. Underhill
+ * Contact: john.underhill@protonmail.com
+ */
+
+#ifndef QSCTEST_ASYNCIO_TEST_H
+#define QSCTEST_ASYNCIO_TEST_H
+
+#include "../QSC/common.h"
+
+/**
+ * \file asyncio_test.h
+ * \brief Tests the asynchronous completion I/O queue.
+ *
+ * \details
+ * This file contains behavioural tests for the completion queue in asyncio.h. Each test queues positioned file writes and reads
+ * on a temporary file in the working directory, including a read into a registered buffer, and a send and receive
+ * over a loopback TCP connection, then checks every completion record and compares the transferred data with the source.
+ * The io_uring test uses the kernel queue where it is available, and the synchronous test forces the blocking fallback path.
+ */
+
+/**
+ * \brief Tests the io_uring completion queue.
+ *
+ * \details
+ * Runs the file and loopback socket operations through a queue initialized on the io_uring path.
+ * If io_uring is not available on this system, the queue runs on the synchronous path and a notice is printed.
+ *
+ * \return Returns true if every operation completes with the expected result and data; otherwise, false.
+ */
+bool qsctest_asyncio_uring_test(void);
+
+/**
+ * \brief Tests the synchronous completion queue fallback.
+ *
+ * \details
+ * Runs the file and loopback socket operations through a queue with the io_uring path disabled,
+ * so that every operation is executed by the blocking file and socket functions when it is submitted.
+ *
+ * \return Returns true if every operation completes with the expected result and data; otherwise, false.
+ */
+bool qsctest_asyncio_synchronous_test(void);
+
+/**
+ * \brief Runs the asynchronous I/O queue tests.
+ *
+ * This function executes the io_uring and synchronous queue tests and prints the outcome of each test to the console.
+ */
+void qsctest_asyncio_run(void);
+
+#endif
@@ -2,8 +2,10 @@
 #include "testutils.h"
 #include "../QSC/aes.h"
 #include "../QSC/chacha.h"
+#include "../QSC/csg.h"
 #include "../QSC/csp.h"
 #include "../QSC/csx.h"
+#include "../QSC/memutils.h"
 #include "../QSC/qmac.h"
 #include "../QSC/rcs.h"
 #include "../QSC/sha3.h"
@@ -12,6 +14,8 @@
 #define BUFFER_SIZE 1024
 #define SAMPLE_COUNT 1000000
 #define ONE_GIGABYTE 1024000000
+#define BULK_BUFFER_SIZE (64ULL * 1024ULL * 1024ULL)
+#define BULK_SAMPLE_COUNT 16
 
 static void aes128_cbc_benchmark_test()
 {
@@ -271,6 +275,47 @@ static void aes256_ctrle_benchmark_test()
 	qsctest_print_line(" seconds");
 }
 
+static void aes256_ctrle_bulk_benchmark_test()
+{
+	uint8_t key[QSC_AES256_KEY_SIZE] = { 0 };
+	uint8_t iv[QSC_AES_BLOCK_SIZE] = { 0 };
+	qsc_aes_state ctx;
+	uint8_t* buf;
+	size_t tctr;
+	uint64_t start;
+	uint64_t elapsed;
+
+	/* a large buffer exercises the TLB, map it on huge pages where available */
+	buf = (uint8_t*)qsc_memutils_large_alloc(BULK_BUFFER_SIZE, QSC_MEMUTILS_NUMA_NODE_ANY);
+
+	if (buf != NULL)
+	{
+		/* generate the key and iv, the message is the zeroed buffer */
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(iv, sizeof(iv));
+		qsc_aes_keyparams kp = { key, sizeof(key), iv, NULL, 0 };
+
+		tctr = 0;
+		start = qsc_timerex_stopwatch_start();
+
+		qsc_aes_initialize(&ctx, &kp, true, qsc_aes_cipher_256);
+
+		while (tctr < BULK_SAMPLE_COUNT)
+		{
+			qsc_aes_ctrle_transform(&ctx, buf, buf, BULK_BUFFER_SIZE);
+			++tctr;
+		}
+
+		elapsed = qsc_timerex_stopwatch_elapsed(start);
+		qsctest_print_safe("AES-256 qsc_aes_mode_ctrle in-place processed 1GB of data in 64MB blocks in ");
+		qsctest_print_double((double)elapsed / 1000.0);
+		qsctest_print_line(" seconds");
+
+		qsc_aes_dispose(&ctx);
+		qsc_memutils_large_free(buf, BULK_BUFFER_SIZE);
+	}
+}
+
 static void chacha128_benchmark_test()
 {
 	uint8_t enc[BUFFER_SIZE] = { 0 };
@@ -791,6 +836,60 @@ static void kpa512_benchmark()
 	qsctest_print_line(" seconds");
 }
 
+static void csg_benchmark()
+{
+	uint8_t seed[QSC_CSG_256_SEED_SIZE] = { 0 };
+	uint8_t otp[8192] = { 0 };
+	qsc_csg_state ctx;
+	size_t tctr;
+	uint64_t start;
+	uint64_t elapsed;
+
+	tctr = 0;
+	start = qsc_timerex_stopwatch_start();
+
+	qsc_csg_initialize(&ctx, seed, sizeof(seed), NULL, 0, false);
+
+	while (tctr < ONE_GIGABYTE)
+	{
+		qsc_csg_generate(&ctx, otp, sizeof(otp));
+		tctr += sizeof(otp);
+	}
+
+	qsc_csg_dispose(&ctx);
+	elapsed = qsc_timerex_stopwatch_elapsed(start);
+	qsctest_print_safe("CSG-256 generated 1GB of data in ");
+	qsctest_print_double((double)elapsed / 1000.0);
+	qsctest_print_line(" seconds");
+}
+
+static void csg_wide_benchmark()
+{
+	uint8_t seed[QSC_CSG_256_SEED_SIZE] = { 0 };
+	uint8_t otp[8192] = { 0 };
+	qsc_csg_wide_state ctx;
+	size_t tctr;
+	uint64_t start;
+	uint64_t elapsed;
+
+	tctr = 0;
+	start = qsc_timerex_stopwatch_start();
+
+	qsc_csg_wide_initialize(&ctx, seed, sizeof(seed), NULL, 0, false);
+
+	while (tctr < ONE_GIGABYTE)
+	{
+		qsc_csg_wide_generate(&ctx, otp, sizeof(otp));
+		tctr += sizeof(otp);
+	}
+
+	qsc_csg_wide_dispose(&ctx);
+	elapsed = qsc_timerex_stopwatch_elapsed(start);
+	qsctest_print_safe("CSG-256 wide generated 1GB of data in ");
+	qsctest_print_double((double)elapsed / 1000.0);
+	qsctest_print_line(" seconds");
+}
+
 static void shake128_benchmark()
 {
 	uint8_t key[16] = { 0 };
@@ -1053,6 +1152,7 @@ void qsctest_benchmark_aes_run()
 	aes256_cbc_benchmark_test();
 	aes256_ctrbe_benchmark_test();
 	aes256_ctrle_benchmark_test();
+	aes256_ctrle_bulk_benchmark_test();
 }
 
 void qsctest_benchmark_chacha_run()
@@ -1135,6 +1235,12 @@ void qsctest_benchmark_shake_run()
 	qsctest_print_line("Running the SHAKE-512 performance benchmarks.");
 	shake512_benchmark();
 
+	qsctest_print_line("Running the CSG-256 performance benchmarks.");
+	csg_benchmark();
+
+	qsctest_print_line("Running the CSG-256 wide performance benchmarks.");
+	csg_wide_benchmark();
+
 #if defined(QSC_SYSTEM_HAS_AVX2)
 	qsctest_print_line("Running the AVX2 4X SHAKE-128 performance benchmarks.");
 	shake128x4_benchmark();
@@ -263,6 +263,175 @@ bool qsctest_chacha256_wide_equality()
 }
 #endif
 
+bool qsctest_chacha_parallel_equality()
+{
+	/* lengths shorter than one thread's share, and lengths that are not a multiple of the block size */
+	const size_t lens[] = { 1U, 63U, 65U, 0x0FFFFU, 0x10001U, 0x30011U, 0x80005U };
+	const size_t thds[] = { 0U, 1U, 3U, 8U };
+	uint8_t key[QSC_CHACHA_KEY256_SIZE] = { 0 };
+	uint8_t nonce[QSC_CHACHA_NONCE_SIZE] = { 0 };
+	uint8_t* enc1;
+	uint8_t* enc2;
+	uint8_t* msg;
+	const size_t mlen = lens[(sizeof(lens) / sizeof(lens[0])) - 1U];
+	qsc_chacha_state ctx1;
+	qsc_chacha_state ctx2;
+	bool status;
+
+	status = true;
+	enc1 = (uint8_t*)qsc_memutils_malloc(mlen);
+	enc2 = (uint8_t*)qsc_memutils_malloc(mlen);
+	msg = (uint8_t*)qsc_memutils_malloc(mlen);
+
+	if (enc1 != NULL && enc2 != NULL && msg != NULL)
+	{
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(nonce, sizeof(nonce));
+		qsc_csp_generate(msg, mlen);
+
+		qsc_chacha_keyparams kp = { key, sizeof(key), nonce };
+
+		for (size_t i = 0U; i < sizeof(lens) / sizeof(lens[0]) && status == true; ++i)
+		{
+			for (size_t j = 0U; j < sizeof(thds) / sizeof(thds[0]); ++j)
+			{
+				qsc_chacha_initialize(&ctx1, &kp);
+				qsc_chacha_initialize(&ctx2, &kp);
+
+				/* start the low counter word near its limit so the thread offsets carry into the high word */
+				ctx1.state[12U] = 0xFFFFFFF0UL;
+				ctx2.state[12U] = 0xFFFFFFF0UL;
+
+				qsc_chacha_transform(&ctx1, enc1, msg, lens[i]);
+				qsc_chacha_transform_parallel(&ctx2, enc2, msg, lens[i], thds[j]);
+
+				/* the output and the final counter must match the sequential transform */
+				if (qsc_intutils_are_equal8(enc1, enc2, lens[i]) == false ||
+					qsc_intutils_are_equal8((const uint8_t*)ctx1.state, (const uint8_t*)ctx2.state, sizeof(ctx1.state)) == false)
+				{
+					qsctest_print_safe("Failure! chacha_parallel_equality: output does not match the sequential transform -CP1 \n");
+					status = false;
+				}
+
+				qsc_chacha_dispose(&ctx1);
+				qsc_chacha_dispose(&ctx2);
+
+				if (status == false)
+				{
+					break;
+				}
+			}
+		}
+	}
+	else
+	{
+		status = false;
+	}
+
+	if (enc1 != NULL)
+	{
+		qsc_memutils_alloc_free(enc1);
+	}
+
+	if (enc2 != NULL)
+	{
+		qsc_memutils_alloc_free(enc2);
+	}
+
+	if (msg != NULL)
+	{
+		qsc_memutils_alloc_free(msg);
+	}
+
+	return status;
+}
+
+bool qsctest_chacha_seek()
+{
+	/* offset and length pairs, block-aligned and mid-block, including ranges that cross a block boundary */
+	const size_t rngs[][2] = { { 0U, 1U }, { 1U, 100U }, { 127U, 2U }, { 128U, 0x1000U }, { 129U, 0x10005U },
+		{ 0x20000U, 0x20007U }, { 0x20003U, 0x20004U }, { 0x40006U, 1U } };
+	const size_t mlen = 0x40007U;
+	uint8_t key[QSC_CHACHA_KEY256_SIZE] = { 0 };
+	uint8_t nonce[QSC_CHACHA_NONCE_SIZE] = { 0 };
+	uint8_t* enc;
+	uint8_t* msg;
+	uint8_t* otp;
+	qsc_chacha_state ctx;
+	bool status;
+
+	status = true;
+	enc = (uint8_t*)qsc_memutils_malloc(mlen);
+	msg = (uint8_t*)qsc_memutils_malloc(mlen);
+	otp = (uint8_t*)qsc_memutils_malloc(mlen);
+
+	if (enc != NULL && msg != NULL && otp != NULL)
+	{
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(nonce, sizeof(nonce));
+		qsc_csp_generate(msg, mlen);
+
+		qsc_chacha_keyparams kp = { key, sizeof(key), nonce };
+
+		/* one long sequential key-stream */
+		qsc_chacha_initialize(&ctx, &kp);
+		qsc_chacha_transform(&ctx, enc, msg, mlen);
+		qsc_chacha_dispose(&ctx);
+
+		for (size_t i = 0U; i < sizeof(rngs) / sizeof(rngs[0]); ++i)
+		{
+			const size_t oft = rngs[i][0];
+			const size_t len = rngs[i][1];
+
+			qsc_chacha_initialize(&ctx, &kp);
+			qsc_chacha_seek(&ctx, oft);
+			qsc_chacha_transform(&ctx, otp, msg + oft, len);
+			qsc_chacha_dispose(&ctx);
+
+			if (qsc_intutils_are_equal8(otp, enc + oft, len) == false)
+			{
+				qsctest_print_safe("Failure! chacha_seek: output does not match the sequential key-stream -CE1 \n");
+				status = false;
+				break;
+			}
+
+			/* resume the partial block, then divide the rest between threads */
+			qsc_chacha_initialize(&ctx, &kp);
+			qsc_chacha_seek(&ctx, oft);
+			qsc_chacha_transform_parallel(&ctx, otp, msg + oft, len, 3U);
+			qsc_chacha_dispose(&ctx);
+
+			if (qsc_intutils_are_equal8(otp, enc + oft, len) == false)
+			{
+				qsctest_print_safe("Failure! chacha_seek: parallel output does not match the sequential key-stream -CE2 \n");
+				status = false;
+				break;
+			}
+		}
+	}
+	else
+	{
+		status = false;
+	}
+
+	if (enc != NULL)
+	{
+		qsc_memutils_alloc_free(enc);
+	}
+
+	if (msg != NULL)
+	{
+		qsc_memutils_alloc_free(msg);
+	}
+
+	if (otp != NULL)
+	{
+		qsc_memutils_alloc_free(otp);
+	}
+
+	return status;
+}
+
 void qsctest_chacha_run()
 {
 	if (qsctest_chacha128_kat() == true)
@@ -283,6 +452,24 @@ void qsctest_chacha_run()
 		qsctest_print_safe("Failure! Failed the ChaCha 256-bit key known answer test. \n");
 	}
 
+	if (qsctest_chacha_parallel_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the ChaCha parallel transform equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the ChaCha parallel transform equality test. \n");
+	}
+
+	if (qsctest_chacha_seek() == true)
+	{
+		qsctest_print_safe("Success! Passed the ChaCha key-stream seek test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the ChaCha key-stream seek test. \n");
+	}
+
 #if defined(QSCTEST_CHACHA_WIDE_BLOCK_TESTS)
 	if (qsctest_chacha128_wide_equality() == true)
 	{
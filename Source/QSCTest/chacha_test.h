@@ -106,6 +106,24 @@ bool qsctest_chacha128_kat(void);
 */
 bool qsctest_chacha256_kat(void);
 
+/**
+* \brief Tests the parallel ChaCha transform for equality with the sequential transform.
+* Compares the output and the final counter over a range of thread counts, with lengths shorter
+* than one thread's share and lengths that are not a multiple of the block size.
+*
+* \return Returns true for success
+*/
+bool qsctest_chacha_parallel_equality(void);
+
+/**
+* \brief Tests positioning the ChaCha key-stream at a byte offset.
+* Seeks to block-aligned and mid-block offsets, and compares each range, transformed sequentially
+* and in parallel, with the same bytes of one long sequential transform.
+*
+* \return Returns true for success
+*/
+bool qsctest_chacha_seek(void);
+
 
 #if defined(QSCTEST_CHACHA_WIDE_BLOCK_TESTS)
 
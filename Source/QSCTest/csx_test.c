@@ -379,6 +379,249 @@ bool qsctest_csx_wide_equality()
 }
 #endif
 
+bool qsctest_csx_parallel_equality()
+{
+	/* lengths shorter than one thread's share, and lengths that are not a multiple of the block size */
+	const size_t lens[] = { 1U, 127U, 129U, 0x0FFFFU, 0x10001U, 0x30011U, 0x80005U };
+	const size_t thds[] = { 0U, 1U, 3U, 8U };
+#if defined(QSC_CSX_AUTHENTICATED)
+	uint8_t aad[20] = { 0 };
+#endif
+	uint8_t key[QSC_CSX_KEY_SIZE] = { 0 };
+	uint8_t ncopy[QSC_CSX_NONCE_SIZE] = { 0 };
+	uint8_t nonce1[QSC_CSX_NONCE_SIZE] = { 0 };
+	uint8_t nonce2[QSC_CSX_NONCE_SIZE] = { 0 };
+	uint8_t* dec;
+	uint8_t* enc1;
+	uint8_t* enc2;
+	uint8_t* msg;
+	const size_t mlen = lens[(sizeof(lens) / sizeof(lens[0])) - 1U];
+	qsc_csx_state ctx1;
+	qsc_csx_state ctx2;
+	size_t clen;
+	bool status;
+
+	status = true;
+	dec = (uint8_t*)qsc_memutils_malloc(mlen);
+	enc1 = (uint8_t*)qsc_memutils_malloc(mlen + QSC_CSX_MAC_SIZE);
+	enc2 = (uint8_t*)qsc_memutils_malloc(mlen + QSC_CSX_MAC_SIZE);
+	msg = (uint8_t*)qsc_memutils_malloc(mlen);
+
+	if (dec != NULL && enc1 != NULL && enc2 != NULL && msg != NULL)
+	{
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(ncopy, sizeof(ncopy));
+		qsc_csp_generate(msg, mlen);
+#if defined(QSC_CSX_AUTHENTICATED)
+		qsc_csp_generate(aad, sizeof(aad));
+#endif
+
+		qsc_csx_keyparams kp1 = { key, sizeof(key), nonce1, NULL, 0 };
+		qsc_csx_keyparams kp2 = { key, sizeof(key), nonce2, NULL, 0 };
+
+		for (size_t i = 0U; i < sizeof(lens) / sizeof(lens[0]) && status == true; ++i)
+		{
+#if defined(QSC_CSX_AUTHENTICATED)
+			clen = lens[i] + QSC_CSX_MAC_SIZE;
+#else
+			clen = lens[i];
+#endif
+
+			for (size_t j = 0U; j < sizeof(thds) / sizeof(thds[0]); ++j)
+			{
+				/* encrypt sequentially and in parallel */
+				qsc_memutils_copy(nonce1, ncopy, sizeof(ncopy));
+				qsc_memutils_copy(nonce2, ncopy, sizeof(ncopy));
+				qsc_csx_initialize(&ctx1, &kp1, true);
+				qsc_csx_initialize(&ctx2, &kp2, true);
+#if defined(QSC_CSX_AUTHENTICATED)
+				qsc_csx_set_associated(&ctx1, aad, sizeof(aad));
+				qsc_csx_set_associated(&ctx2, aad, sizeof(aad));
+#endif
+
+				if (qsc_csx_transform(&ctx1, enc1, msg, lens[i]) == false ||
+					qsc_csx_transform_parallel(&ctx2, enc2, msg, lens[i], thds[j]) == false)
+				{
+					qsctest_print_safe("Failure! csx_parallel_equality: encryption failure -XP1 \n");
+					status = false;
+				}
+
+				qsc_csx_dispose(&ctx1);
+				qsc_csx_dispose(&ctx2);
+
+				/* the cipher-text, MAC code, and final nonce must match the sequential transform */
+				if (qsc_intutils_are_equal8(enc1, enc2, clen) == false ||
+					qsc_intutils_are_equal8(nonce1, nonce2, sizeof(nonce1)) == false)
+				{
+					qsctest_print_safe("Failure! csx_parallel_equality: output does not match the sequential transform -XP2 \n");
+					status = false;
+				}
+
+				/* decrypt in parallel */
+				qsc_memutils_copy(nonce2, ncopy, sizeof(ncopy));
+				qsc_csx_initialize(&ctx2, &kp2, false);
+#if defined(QSC_CSX_AUTHENTICATED)
+				qsc_csx_set_associated(&ctx2, aad, sizeof(aad));
+#endif
+
+				if (qsc_csx_transform_parallel(&ctx2, dec, enc2, lens[i], thds[j]) == false ||
+					qsc_intutils_are_equal8(dec, msg, lens[i]) == false)
+				{
+					qsctest_print_safe("Failure! csx_parallel_equality: decryption failure -XP3 \n");
+					status = false;
+				}
+
+				qsc_csx_dispose(&ctx2);
+
+				if (status == false)
+				{
+					break;
+				}
+			}
+		}
+	}
+	else
+	{
+		status = false;
+	}
+
+	if (dec != NULL)
+	{
+		qsc_memutils_alloc_free(dec);
+	}
+
+	if (enc1 != NULL)
+	{
+		qsc_memutils_alloc_free(enc1);
+	}
+
+	if (enc2 != NULL)
+	{
+		qsc_memutils_alloc_free(enc2);
+	}
+
+	if (msg != NULL)
+	{
+		qsc_memutils_alloc_free(msg);
+	}
+
+	return status;
+}
+
+bool qsctest_csx_seek()
+{
+	/* offset and length pairs, block-aligned and mid-block, including ranges that cross a block boundary */
+	const size_t rngs[][2] = { { 0U, 1U }, { 1U, 100U }, { 127U, 2U }, { 128U, 0x1000U }, { 129U, 0x10005U },
+		{ 0x20000U, 0x20007U }, { 0x20003U, 0x20004U }, { 0x40006U, 1U } };
+	const size_t mlen = 0x40007U;
+	uint8_t key[QSC_CSX_KEY_SIZE] = { 0 };
+	uint8_t ncopy[QSC_CSX_NONCE_SIZE] = { 0 };
+	uint8_t nonce[QSC_CSX_NONCE_SIZE] = { 0 };
+	uint8_t* dec;
+	uint8_t* enc;
+	uint8_t* msg;
+	uint8_t* otp;
+	qsc_csx_state ctx;
+	bool status;
+
+	status = true;
+	dec = (uint8_t*)qsc_memutils_malloc(mlen);
+	enc = (uint8_t*)qsc_memutils_malloc(mlen + QSC_CSX_MAC_SIZE);
+	msg = (uint8_t*)qsc_memutils_malloc(mlen);
+	otp = (uint8_t*)qsc_memutils_malloc(mlen + QSC_CSX_MAC_SIZE);
+
+	if (dec != NULL && enc != NULL && msg != NULL && otp != NULL)
+	{
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(ncopy, sizeof(ncopy));
+		qsc_csp_generate(msg, mlen);
+
+		qsc_csx_keyparams kp = { key, sizeof(key), nonce, NULL, 0 };
+
+		/* one long sequential key-stream */
+		qsc_memutils_copy(nonce, ncopy, sizeof(nonce));
+		qsc_csx_initialize(&ctx, &kp, true);
+
+		if (qsc_csx_transform(&ctx, enc, msg, mlen) == false)
+		{
+			status = false;
+		}
+
+		qsc_csx_dispose(&ctx);
+
+		for (size_t i = 0U; i < sizeof(rngs) / sizeof(rngs[0]) && status == true; ++i)
+		{
+			const size_t oft = rngs[i][0];
+			const size_t len = rngs[i][1];
+
+			/* the cipher-text of a range encrypted from the seek position */
+			qsc_csx_initialize(&ctx, &kp, true);
+			qsc_csx_seek(&ctx, ncopy, oft);
+
+			if (qsc_csx_transform(&ctx, otp, msg + oft, len) == false ||
+				qsc_intutils_are_equal8(otp, enc + oft, len) == false)
+			{
+				qsctest_print_safe("Failure! csx_seek: output does not match the sequential key-stream -XE1 \n");
+				status = false;
+			}
+
+			qsc_csx_dispose(&ctx);
+
+			/* resume the partial block, then divide the rest between threads */
+			qsc_csx_initialize(&ctx, &kp, true);
+			qsc_csx_seek(&ctx, ncopy, oft);
+
+			if (qsc_csx_transform_parallel(&ctx, otp, msg + oft, len, 3U) == false ||
+				qsc_intutils_are_equal8(otp, enc + oft, len) == false)
+			{
+				qsctest_print_safe("Failure! csx_seek: parallel output does not match the sequential key-stream -XE2 \n");
+				status = false;
+			}
+
+			qsc_csx_dispose(&ctx);
+
+			/* the range authenticates and decrypts as its own message */
+			qsc_csx_initialize(&ctx, &kp, false);
+			qsc_csx_seek(&ctx, ncopy, oft);
+
+			if (qsc_csx_transform(&ctx, dec, otp, len) == false ||
+				qsc_intutils_are_equal8(dec, msg + oft, len) == false)
+			{
+				qsctest_print_safe("Failure! csx_seek: range decryption failure -XE3 \n");
+				status = false;
+			}
+
+			qsc_csx_dispose(&ctx);
+		}
+	}
+	else
+	{
+		status = false;
+	}
+
+	if (dec != NULL)
+	{
+		qsc_memutils_alloc_free(dec);
+	}
+
+	if (enc != NULL)
+	{
+		qsc_memutils_alloc_free(enc);
+	}
+
+	if (msg != NULL)
+	{
+		qsc_memutils_alloc_free(msg);
+	}
+
+	if (otp != NULL)
+	{
+		qsc_memutils_alloc_free(otp);
+	}
+
+	return status;
+}
+
 void qsctest_csx_run()
 {
 	if (qsctest_csx512_kat() == true)
@@ -399,6 +642,24 @@ void qsctest_csx_run()
 		qsctest_print_safe("Failure! Failed the CSX stress tests. \n");
 	}
 
+	if (qsctest_csx_parallel_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the CSX parallel transform equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the CSX parallel transform equality test. \n");
+	}
+
+	if (qsctest_csx_seek() == true)
+	{
+		qsctest_print_safe("Success! Passed the CSX key-stream seek test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the CSX key-stream seek test. \n");
+	}
+
 #if defined(QSCTEST_CSX_WIDE_BLOCK_TESTS)
 	if (qsctest_csx_wide_equality() == true)
 	{
@@ -110,6 +110,28 @@ bool qsctest_csx512_kat(void);
  */
 bool qsctest_csx512_stress(void);
 
+/**
+ * \brief Tests the parallel CSX transform for equality with the sequential transform.
+ *
+ * \return Returns true if the outputs match; false otherwise.
+ *
+ * \remarks
+ * Compares the cipher-text, MAC code, and final nonce over a range of thread counts, with lengths shorter
+ * than one thread's share and lengths that are not a multiple of the block size, then decrypts in parallel.
+ */
+bool qsctest_csx_parallel_equality(void);
+
+/**
+ * \brief Tests positioning the CSX key-stream at a byte offset.
+ *
+ * \return Returns true if every range matches; false otherwise.
+ *
+ * \remarks
+ * Seeks to block-aligned and mid-block offsets, and compares each range, transformed sequentially and in parallel,
+ * with the same bytes of one long sequential transform. Each range is then decrypted as its own message.
+ */
+bool qsctest_csx_seek(void);
+
 #if defined(QSCTEST_CSX_WIDE_BLOCK_TESTS)
 /**
  * \brief Tests the CSX AVX functions by verifying that wide block encryption produces output
@@ -121,7 +143,7 @@ bool qsctest_csx_wide_equality(void);
 #endif
 
 /**
- * \brief Runs all CSX-512 tests, including KAT, stress, and (if enabled) wide block tests.
+ * \brief Runs all CSX-512 tests, including KAT, stress, parallel equality, seek, and (if enabled) wide block tests.
  */
 void qsctest_csx_run(void);
 
@@ -1,5 +1,6 @@
 #include "encoding_test.h"
 #include "testutils.h"
+#include "../QSC/csp.h"
 #include "../QSC/encoding.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -162,6 +163,94 @@ bool qsctest_encoding_der(void)
     return res;
 }
 
+bool qsctest_encoding_der_reader(void)
+{
+    const uint8_t aint[] = { 0x30, 0x39 };
+    const uint8_t abool[] = { 0xFF };
+    const uint8_t apriv[] = { 0x01, 0x02, 0x03 };
+    const uint8_t indef[] = { 0x30, 0x80, 0x00, 0x00 };
+    const uint8_t nonmin[] = { 0x04, 0x81, 0x05, 0x01, 0x02, 0x03, 0x04, 0x05 };
+    uint8_t aoct[200] = { 0 };
+    uint8_t derbuf[512] = { 0 };
+    uint8_t encbuf[512] = { 0 };
+    qsc_encoding_ber_element bint = { QSC_ENCODING_BER_CLASS_UNIVERSAL, false, BER_ASN1_INTEGER, false, sizeof(aint), (uint8_t*)aint, NULL, 0 };
+    qsc_encoding_ber_element boct = { QSC_ENCODING_BER_CLASS_UNIVERSAL, false, BER_ASN1_OCTET_STRING, false, sizeof(aoct), aoct, NULL, 0 };
+    qsc_encoding_ber_element bbool = { QSC_ENCODING_BER_CLASS_UNIVERSAL, false, BER_ASN1_BOOLEAN, false, sizeof(abool), (uint8_t*)abool, NULL, 0 };
+    qsc_encoding_ber_element* cctx[1] = { &bbool };
+    qsc_encoding_ber_element bctx = { QSC_ENCODING_BER_CLASS_CONTEXT_SPECIFIC, true, 0, false, 0, NULL, cctx, 1 };
+    qsc_encoding_ber_element bpriv = { QSC_ENCODING_BER_CLASS_PRIVATE, false, 100, false, sizeof(apriv), (uint8_t*)apriv, NULL, 0 };
+    qsc_encoding_ber_element* cseq[4] = { &bint, &boct, &bctx, &bpriv };
+    qsc_encoding_ber_element bseq = { QSC_ENCODING_BER_CLASS_UNIVERSAL, true, BER_ASN1_SEQUENCE, false, 0, NULL, cseq, 4 };
+    qsc_encoding_der_reader inner;
+    qsc_encoding_der_reader outer;
+    qsc_encoding_der_reader reader;
+    qsc_encoding_der_view view;
+    qsc_encoding_der_writer writer;
+    size_t ctxlen;
+    size_t enclen;
+    size_t seqlen;
+    size_t total;
+    bool res;
+
+    res = false;
+
+    for (size_t i = 0; i < sizeof(aoct); ++i)
+    {
+        aoct[i] = (uint8_t)i;
+    }
+
+    /* precompute the nested lengths, then write the structure in one pass */
+    ctxlen = qsc_encoding_der_element_size(BER_ASN1_BOOLEAN, sizeof(abool));
+    seqlen = qsc_encoding_der_element_size(BER_ASN1_INTEGER, sizeof(aint)) +
+        qsc_encoding_der_element_size(BER_ASN1_OCTET_STRING, sizeof(aoct)) +
+        qsc_encoding_der_element_size(0, ctxlen) +
+        qsc_encoding_der_element_size(100, sizeof(apriv));
+    total = qsc_encoding_der_element_size(BER_ASN1_SEQUENCE, seqlen);
+
+    qsc_encoding_der_writer_initialize(&writer, derbuf, sizeof(derbuf));
+    qsc_encoding_der_writer_header(&writer, QSC_ENCODING_BER_CLASS_UNIVERSAL, true, BER_ASN1_SEQUENCE, seqlen);
+    qsc_encoding_der_writer_element(&writer, QSC_ENCODING_BER_CLASS_UNIVERSAL, BER_ASN1_INTEGER, aint, sizeof(aint));
+    qsc_encoding_der_writer_element(&writer, QSC_ENCODING_BER_CLASS_UNIVERSAL, BER_ASN1_OCTET_STRING, aoct, sizeof(aoct));
+    qsc_encoding_der_writer_header(&writer, QSC_ENCODING_BER_CLASS_CONTEXT_SPECIFIC, true, 0, ctxlen);
+    qsc_encoding_der_writer_element(&writer, QSC_ENCODING_BER_CLASS_UNIVERSAL, BER_ASN1_BOOLEAN, abool, sizeof(abool));
+    qsc_encoding_der_writer_element(&writer, QSC_ENCODING_BER_CLASS_PRIVATE, 100, apriv, sizeof(apriv));
+    enclen = qsc_encoding_der_encode_element(&bseq, encbuf, sizeof(encbuf));
+
+    if (qsc_encoding_der_writer_finalize(&writer) == total && enclen == total && memcmp(derbuf, encbuf, total) == 0)
+    {
+        qsc_encoding_der_reader_initialize(&reader, derbuf, total);
+
+        /* walk the structure, every view must point into the original buffer */
+        if (qsc_encoding_der_reader_expect(&reader, QSC_ENCODING_BER_CLASS_UNIVERSAL, BER_ASN1_SEQUENCE, &view) == true &&
+            qsc_encoding_der_reader_remaining(&reader) == 0 &&
+            qsc_encoding_der_reader_enter(&view, &outer) == true &&
+            qsc_encoding_der_reader_expect(&outer, QSC_ENCODING_BER_CLASS_UNIVERSAL, BER_ASN1_INTEGER, &view) == true &&
+            view.length == sizeof(aint) && memcmp(view.value, aint, sizeof(aint)) == 0 &&
+            qsc_encoding_der_reader_expect(&outer, QSC_ENCODING_BER_CLASS_UNIVERSAL, BER_ASN1_OCTET_STRING, &view) == true &&
+            view.length == sizeof(aoct) && memcmp(view.value, aoct, sizeof(aoct)) == 0 &&
+            view.value >= derbuf && view.value + view.length <= derbuf + total &&
+            qsc_encoding_der_reader_expect(&outer, QSC_ENCODING_BER_CLASS_UNIVERSAL, BER_ASN1_NULL, &view) == false &&
+            qsc_encoding_der_reader_expect(&outer, QSC_ENCODING_BER_CLASS_CONTEXT_SPECIFIC, 0, &view) == true &&
+            qsc_encoding_der_reader_enter(&view, &inner) == true &&
+            qsc_encoding_der_reader_next(&inner, &view) == true &&
+            view.tagnumber == BER_ASN1_BOOLEAN && view.value[0] == abool[0] &&
+            qsc_encoding_der_reader_next(&inner, &view) == false &&
+            qsc_encoding_der_reader_next(&outer, &view) == true &&
+            view.tagclass == QSC_ENCODING_BER_CLASS_PRIVATE && view.tagnumber == 100 &&
+            view.length == sizeof(apriv) && memcmp(view.value, apriv, sizeof(apriv)) == 0 &&
+            qsc_encoding_der_reader_remaining(&outer) == 0)
+        {
+            /* indefinite and non-minimal lengths are not DER */
+            qsc_encoding_der_reader_initialize(&reader, indef, sizeof(indef));
+            res = (qsc_encoding_der_reader_next(&reader, &view) == false);
+            qsc_encoding_der_reader_initialize(&reader, nonmin, sizeof(nonmin));
+            res = (res == true && qsc_encoding_der_reader_next(&reader, &view) == false);
+        }
+    }
+
+    return res;
+}
+
 bool qsctest_encoding_hex(void)
 {
     uint8_t data[] = { 0xDE, 0xAD, 0xBE, 0xEF };
@@ -221,6 +310,105 @@ bool qsctest_encoding_pem(void)
     return res;
 }
 
+bool qsctest_encoding_stress(void)
+{
+    uint8_t data[512U];
+    uint8_t dec[512U];
+    char b64[700U];
+    char hex[1025U];
+    char pem[800U];
+    size_t declen;
+    size_t enclen;
+    bool res;
+
+    res = true;
+    qsc_csp_generate(data, sizeof(data));
+
+    for (size_t i = 1U; i <= sizeof(data); ++i)
+    {
+        /* base64 round-trip, then an invalid character in the first group */
+        enclen = qsc_encoding_base64_encoded_size(i);
+        memset(b64, 0, sizeof(b64));
+        qsc_encoding_base64_encode(b64, sizeof(b64), data, i);
+
+        if (qsc_encoding_base64_decode(dec, sizeof(dec), b64, enclen) == false || memcmp(data, dec, i) != 0)
+        {
+            res = false;
+            break;
+        }
+
+        b64[1] = '*';
+
+        if (qsc_encoding_base64_decode(dec, sizeof(dec), b64, enclen) == true)
+        {
+            res = false;
+            break;
+        }
+
+        /* hex round-trip, then an invalid character in the last pair */
+        if (qsc_encoding_hex_encode(data, i, hex, sizeof(hex)) == false ||
+            qsc_encoding_hex_decode(hex, i * 2U, dec, sizeof(dec), &declen) == false ||
+            declen != i || memcmp(data, dec, i) != 0)
+        {
+            res = false;
+            break;
+        }
+
+        hex[(i * 2U) - 1U] = 'G';
+
+        if (qsc_encoding_hex_decode(hex, i * 2U, dec, sizeof(dec), &declen) == true)
+        {
+            res = false;
+            break;
+        }
+
+        /* pem round-trip into an exactly sized buffer */
+        enclen = qsc_encoding_pem_encoded_size("TEST LABEL", i);
+
+        if (enclen > sizeof(pem) ||
+            qsc_encoding_pem_encode("TEST LABEL", pem, enclen, data, i) == false ||
+            strlen(pem) + 1U != enclen ||
+            qsc_encoding_pem_decode(pem, dec, sizeof(dec), &declen) == false ||
+            declen != i || memcmp(data, dec, i) != 0)
+        {
+            res = false;
+            break;
+        }
+    }
+
+    if (res == true)
+    {
+        char bad[2100U];
+        size_t pos;
+
+        /* an invalid group followed by a long run on the same line */
+        pos = 0U;
+        memcpy(bad, "-----BEGIN TEST LABEL-----\n!!!!AAAA ", 36U);
+        pos += 36U;
+        memset(bad + pos, 'A', 2000U);
+        pos += 2000U;
+        /* the footer copy includes the string terminator */
+        memcpy(bad + pos, "\n-----END TEST LABEL-----\n", 27U);
+
+        if (qsc_encoding_pem_decode(bad, dec, sizeof(dec), &declen) == true)
+        {
+            res = false;
+        }
+
+        /* a valid body decoded into an output buffer that is too small */
+        enclen = qsc_encoding_pem_encoded_size("TEST LABEL", sizeof(data));
+
+        if (enclen > sizeof(pem) ||
+            qsc_encoding_pem_encode("TEST LABEL", pem, enclen, data, sizeof(data)) == false ||
+            qsc_encoding_pem_decode(pem, dec, 8U, &declen) == true)
+        {
+            res = false;
+        }
+    }
+
+    return res;
+}
+
 void qsctest_encoding_run(void)
 {
 	if (qsctest_encoding_base64() == true)
@@ -250,6 +438,15 @@ void qsctest_encoding_run(void)
 		qsctest_print_safe("Failure! Failed the DER Encoding and Decoding test. \n");
 	}
 
+    if (qsctest_encoding_der_reader() == true)
+	{
+		qsctest_print_safe("Success! Passed the DER reader and writer test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the DER reader and writer test. \n");
+	}
+
     if (qsctest_encoding_hex() == true)
 	{
 		qsctest_print_safe("Success! Passed HEX Encoding and Decoding test. \n");
@@ -267,4 +464,13 @@ void qsctest_encoding_run(void)
 	{
 		qsctest_print_safe("Failure! Failed the PEM Encoding and Decoding test. \n");
 	}
+
+    if (qsctest_encoding_stress() == true)
+	{
+		qsctest_print_safe("Success! Passed the Base64, HEX, and PEM block encoding stress test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Base64, HEX, and PEM block encoding stress test. \n");
+	}
 }
@@ -98,6 +98,18 @@ bool qsctest_encoding_ber(void);
  */
 bool qsctest_encoding_der(void);
 
+/*!
+ * \brief Tests the DER reader and writer.
+ *
+ * \details
+ * This function writes a nested structure with the single-pass DER writer, compares it with the output of
+ * qsc_encoding_der_encode_element for the same tree, and then walks it with the DER reader, checking that each view
+ * points into the original buffer. Indefinite and non-minimal lengths must be rejected.
+ *
+ * \return Returns true if the DER reader and writer test passes; otherwise, false.
+ */
+bool qsctest_encoding_der_reader(void);
+
 /*!
  * \brief Tests HEX encoding and decoding.
  *
@@ -120,6 +132,17 @@ bool qsctest_encoding_hex(void);
  */
 bool qsctest_encoding_pem(void);
 
+/*!
+ * \brief Tests the block encoders against lengths that span the vectorized and scalar paths.
+ *
+ * \details
+ * This function round-trips random data of every length from 1 to 512 bytes through the Base64, HEX, and PEM
+ * encoders, and checks that an invalid character placed in the body of an encoding is rejected by the decoder.
+ *
+ * \return Returns true if every round-trip and rejection check passes; otherwise, false.
+ */
+bool qsctest_encoding_stress(void);
+
 /*!
  * \brief Runs all encoding scheme tests.
  *
@@ -344,6 +344,71 @@ bool qsctest_falcon_stress_test2()
 	return ret;
 }
 
+bool qsctest_falcon_workspace_test()
+{
+	uint8_t msg[QSCTEST_FALCON_MLEN] = { 0 };
+	uint8_t mout[QSC_FALCON_SIGNATURE_SIZE + QSCTEST_FALCON_MLEN] = { 0 };
+	uint8_t sig1[QSC_FALCON_SIGNATURE_SIZE + QSCTEST_FALCON_MLEN] = { 0 };
+	uint8_t sig2[QSC_FALCON_SIGNATURE_SIZE + QSCTEST_FALCON_MLEN] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sk1[QSC_FALCON_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t sk2[QSC_FALCON_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t pk1[QSC_FALCON_PUBLICKEY_SIZE] = { 0 };
+	uint8_t pk2[QSC_FALCON_PUBLICKEY_SIZE] = { 0 };
+	uint8_t* wsp;
+	size_t msglen;
+	size_t siglen1;
+	size_t siglen2;
+	size_t wslen;
+	bool ret;
+
+	ret = false;
+	msglen = QSCTEST_FALCON_MLEN;
+	siglen1 = 0;
+	siglen2 = 0;
+	wslen = qsc_falcon_workspace_size();
+	wsp = (uint8_t*)qsc_memutils_aligned_alloc(QSC_SIMD_ALIGNMENT, wslen);
+
+	if (wsp != NULL)
+	{
+		ret = true;
+		qsctest_hex_to_bin("061550234D158C5EC95595FE04EF7A25767F2E24CC2BC479D09D86DC9ABCFDE7056A8C266F9EF97ED08541DBD2E1FFA1", seed, sizeof(seed));
+
+		qsctest_nistrng_prng_initialize(seed, NULL, 0);
+		qsc_falcon_generate_keypair(pk1, sk1, qsctest_nistrng_prng_generate);
+		qsc_falcon_sign(sig1, &siglen1, msg, msglen, sk1, qsctest_nistrng_prng_generate);
+
+		qsctest_nistrng_prng_initialize(seed, NULL, 0);
+
+		if (qsc_falcon_generate_keypair_workspace(pk2, sk2, qsctest_nistrng_prng_generate, wsp, wslen) == false ||
+			qsc_falcon_sign_workspace(sig2, &siglen2, msg, msglen, sk2, qsctest_nistrng_prng_generate, wsp, wslen) == false)
+		{
+			qsctest_print_safe("Failure! falcon workspace: key generation or signing has failed -FWT1 \n");
+			ret = false;
+		}
+
+		if (qsc_intutils_are_equal8(pk1, pk2, sizeof(pk1)) == false ||
+			qsc_intutils_are_equal8(sk1, sk2, sizeof(sk1)) == false ||
+			siglen1 != siglen2 ||
+			qsc_intutils_are_equal8(sig1, sig2, siglen1) == false)
+		{
+			qsctest_print_safe("Failure! falcon workspace: outputs do not match the standard functions -FWT2 \n");
+			ret = false;
+		}
+
+		if (qsc_falcon_verify_workspace(mout, &msglen, sig2, siglen2, pk2, wsp, wslen) == false)
+		{
+			qsctest_print_safe("Failure! falcon workspace: message verification has failed -FWT3 \n");
+			ret = false;
+		}
+
+		qsc_memutils_secure_erase(wsp, wslen);
+		qsc_memutils_aligned_free(wsp);
+	}
+
+	return ret;
+}
+
 void qsctest_falcon_run()
 {
 	if (qsctest_falcon_operations_test() == true)
@@ -390,4 +455,13 @@ void qsctest_falcon_run()
 	{
 		qsctest_print_safe("Failure! Failed the Falcon altered signature test has failed. \n");
 	}
+
+	if (qsctest_falcon_workspace_test() == true)
+	{
+		qsctest_print_safe("Success! Passed the Falcon workspace test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Falcon workspace test has failed. \n");
+	}
 }
@@ -150,6 +150,18 @@ bool qsctest_falcon_stress_test(void);
  */
 bool qsctest_falcon_stress_test2(void);
 
+/**
+ * \brief Tests the caller supplied workspace variants of the Falcon functions.
+ *
+ * \details
+ * Generates a key pair and signature with the standard and the workspace functions from the same
+ * deterministic random seed, checks that the outputs are identical, and verifies the signature
+ * with the workspace verification function.
+ *
+ * \return Returns true if the outputs match and the signature verifies; otherwise, false.
+ */
+bool qsctest_falcon_workspace_test(void);
+
 /**
  * \brief Runs the complete Falcon test suite.
  *
@@ -160,6 +172,7 @@ bool qsctest_falcon_stress_test2(void);
  * - The public key integrity test
  * - The signature integrity test
  * - The stress tests
+ * - The workspace test
  *
  * The results of each test are printed to the console.
  */
@@ -0,0 +1,739 @@
+#include "filecrypto_test.h"
+#include "../QSC/aes.h"
+#include "../QSC/chacha.h"
+#include "../QSC/csp.h"
+#include "../QSC/filecrypto.h"
+#include "../QSC/fileutils.h"
+#include "../QSC/intutils.h"
+#include "../QSC/memutils.h"
+#include "../QSC/rcs.h"
+#include "../QSC/sha3.h"
+#include "testutils.h"
+
+#define FILECRYPTO_TEST_PATH1 "filecrypto_test1.tmp"
+#define FILECRYPTO_TEST_PATH2 "filecrypto_test2.tmp"
+#define FILECRYPTO_TEST_PATH3 "filecrypto_test3.tmp"
+/* larger than one read-ahead segment, and not a multiple of any cipher or hash block size */
+#define FILECRYPTO_TEST_LARGE (QSC_FILECRYPTO_SEGMENT_SIZE + 77U)
+
+static bool filecrypto_write_file(const char* fpath, const uint8_t* input, size_t length)
+{
+	bool res;
+
+	if (length != 0U)
+	{
+		res = qsc_fileutils_copy_stream_to_file(fpath, (const char*)input, length);
+	}
+	else
+	{
+		res = qsc_fileutils_create(fpath);
+	}
+
+	return res;
+}
+
+static bool filecrypto_file_equals(const char* fpath, const uint8_t* expected, size_t length)
+{
+	uint8_t* tmpf;
+	bool res;
+
+	res = false;
+
+	if (qsc_fileutils_exists(fpath) == true && qsc_fileutils_get_size(fpath) == length)
+	{
+		if (length != 0U)
+		{
+			tmpf = (uint8_t*)qsc_memutils_malloc(length);
+
+			if (tmpf != NULL)
+			{
+				if (qsc_fileutils_copy_file_to_stream(fpath, (char*)tmpf, length) == length)
+				{
+					res = qsc_intutils_are_equal8(tmpf, expected, length);
+				}
+
+				qsc_memutils_alloc_free(tmpf);
+			}
+		}
+		else
+		{
+			res = true;
+		}
+	}
+
+	return res;
+}
+
+static void filecrypto_delete_files(void)
+{
+	qsc_fileutils_delete(FILECRYPTO_TEST_PATH1);
+	qsc_fileutils_delete(FILECRYPTO_TEST_PATH2);
+	qsc_fileutils_delete(FILECRYPTO_TEST_PATH3);
+}
+
+bool qsctest_filecrypto_map_test()
+{
+	const size_t lens[] = { 0U, 1U, 4097U, FILECRYPTO_TEST_LARGE };
+	qsc_fileutils_mapped_file map;
+	uint8_t* msg;
+	size_t mlen;
+	bool status;
+
+	status = true;
+	msg = (uint8_t*)qsc_memutils_malloc(FILECRYPTO_TEST_LARGE);
+
+	if (msg != NULL)
+	{
+		qsc_csp_generate(msg, FILECRYPTO_TEST_LARGE);
+
+		for (size_t i = 0U; i < sizeof(lens) / sizeof(lens[0]) && status == true; ++i)
+		{
+			mlen = lens[i];
+
+			/* create the file at its final size and write it through the view */
+			if (qsc_fileutils_map_create(&map, FILECRYPTO_TEST_PATH1, mlen) == true && map.length == mlen)
+			{
+				if (mlen != 0U)
+				{
+					qsc_memutils_copy(map.data, msg, mlen);
+				}
+
+				status = qsc_fileutils_map_flush(&map);
+				qsc_fileutils_unmap(&map);
+			}
+			else
+			{
+				qsctest_print_line("filecrypto map test: the file could not be created and mapped.");
+				status = false;
+			}
+
+			if (status == true && filecrypto_file_equals(FILECRYPTO_TEST_PATH1, msg, mlen) == false)
+			{
+				qsctest_print_line("filecrypto map test: the file does not contain the bytes written to the view.");
+				status = false;
+			}
+
+			/* a read-only view returns the file contents */
+			if (status == true)
+			{
+				if (qsc_fileutils_map(&map, FILECRYPTO_TEST_PATH1, false, qsc_fileutils_map_advice_random) == true && map.length == mlen)
+				{
+					qsc_fileutils_map_advise(&map, 0U, mlen, qsc_fileutils_map_advice_willneed);
+
+					if ((mlen == 0U && map.data != NULL) || (mlen != 0U && qsc_intutils_are_equal8(map.data, msg, mlen) == false))
+					{
+						qsctest_print_line("filecrypto map test: the read-only view does not match the file.");
+						status = false;
+					}
+
+					qsc_fileutils_unmap(&map);
+				}
+				else
+				{
+					qsctest_print_line("filecrypto map test: the file could not be mapped for reading.");
+					status = false;
+				}
+			}
+
+			/* a change made through a writable view reaches the file */
+			if (status == true && mlen != 0U)
+			{
+				if (qsc_fileutils_map(&map, FILECRYPTO_TEST_PATH1, true, qsc_fileutils_map_advice_normal) == true)
+				{
+					map.data[0U] ^= 0x01U;
+					map.data[mlen - 1U] ^= 0x80U;
+					qsc_fileutils_unmap(&map);
+
+					msg[0U] ^= 0x01U;
+					msg[mlen - 1U] ^= 0x80U;
+
+					if (filecrypto_file_equals(FILECRYPTO_TEST_PATH1, msg, mlen) == false)
+					{
+						qsctest_print_line("filecrypto map test: a change to the writable view was not written to the file.");
+						status = false;
+					}
+				}
+				else
+				{
+					qsctest_print_line("filecrypto map test: the file could not be mapped for writing.");
+					status = false;
+				}
+			}
+		}
+
+		qsc_memutils_alloc_free(msg);
+	}
+	else
+	{
+		status = false;
+	}
+
+	filecrypto_delete_files();
+
+	return status;
+}
+
+bool qsctest_filecrypto_hash_test()
+{
+	const size_t lens[] = { 0U, 1U, 136U, 4097U, FILECRYPTO_TEST_LARGE };
+	uint8_t key[QSC_SHA3_256_HASH_SIZE] = { 0 };
+	uint8_t cust[16] = { 0 };
+	uint8_t exp[QSC_SHA3_512_HASH_SIZE] = { 0 };
+	uint8_t otp[QSC_SHA3_512_HASH_SIZE] = { 0 };
+	uint8_t sexp[300] = { 0 };
+	uint8_t sotp[300] = { 0 };
+	uint8_t* msg;
+	size_t mlen;
+	bool status;
+
+	status = true;
+	msg = (uint8_t*)qsc_memutils_malloc(FILECRYPTO_TEST_LARGE);
+
+	if (msg != NULL)
+	{
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(cust, sizeof(cust));
+		qsc_csp_generate(msg, FILECRYPTO_TEST_LARGE);
+
+		for (size_t i = 0U; i < sizeof(lens) / sizeof(lens[0]) && status == true; ++i)
+		{
+			mlen = lens[i];
+
+			if (filecrypto_write_file(FILECRYPTO_TEST_PATH1, msg, mlen) == false)
+			{
+				qsctest_print_line("filecrypto hash test: the input file could not be written.");
+				status = false;
+				break;
+			}
+
+			qsc_sha3_compute256(exp, msg, mlen);
+
+			if (qsc_filecrypto_sha3_compute(otp, qsc_keccak_rate_256, FILECRYPTO_TEST_PATH1) == false ||
+				qsc_intutils_are_equal8(otp, exp, QSC_SHA3_256_HASH_SIZE) == false)
+			{
+				qsctest_print_line("filecrypto hash test: the SHA3-256 file hash does not match.");
+				status = false;
+			}
+
+			qsc_sha3_compute512(exp, msg, mlen);
+
+			if (qsc_filecrypto_sha3_compute(otp, qsc_keccak_rate_512, FILECRYPTO_TEST_PATH1) == false ||
+				qsc_intutils_are_equal8(otp, exp, QSC_SHA3_512_HASH_SIZE) == false)
+			{
+				qsctest_print_line("filecrypto hash test: the SHA3-512 file hash does not match.");
+				status = false;
+			}
+
+			qsc_shake256_compute(sexp, sizeof(sexp), msg, mlen);
+
+			if (qsc_filecrypto_shake_compute(sotp, sizeof(sotp), qsc_keccak_rate_256, FILECRYPTO_TEST_PATH1) == false ||
+				qsc_intutils_are_equal8(sotp, sexp, sizeof(sexp)) == false)
+			{
+				qsctest_print_line("filecrypto hash test: the SHAKE-256 file output does not match.");
+				status = false;
+			}
+
+			qsc_kmac256_compute(sexp, sizeof(sexp), msg, mlen, key, sizeof(key), cust, sizeof(cust));
+
+			if (qsc_filecrypto_kmac_compute(sotp, sizeof(sotp), qsc_keccak_rate_256, key, sizeof(key), cust, sizeof(cust), FILECRYPTO_TEST_PATH1) == false ||
+				qsc_intutils_are_equal8(sotp, sexp, sizeof(sexp)) == false)
+			{
+				qsctest_print_line("filecrypto hash test: the KMAC-256 file code does not match.");
+				status = false;
+			}
+		}
+
+		qsc_memutils_alloc_free(msg);
+	}
+	else
+	{
+		status = false;
+	}
+
+	filecrypto_delete_files();
+
+	return status;
+}
+
+bool qsctest_filecrypto_cipher_test()
+{
+	/* the first file ends within a block, the state must be left positioned for the second */
+	const size_t flen1 = 1000U;
+	const size_t flen2 = FILECRYPTO_TEST_LARGE;
+	uint8_t key[QSC_AES256_KEY_SIZE] = { 0 };
+	uint8_t ncopy[QSC_AES_BLOCK_SIZE] = { 0 };
+	uint8_t nonce1[QSC_AES_BLOCK_SIZE] = { 0 };
+	uint8_t nonce2[QSC_AES_BLOCK_SIZE] = { 0 };
+	uint8_t* enc;
+	uint8_t* msg;
+	qsc_aes_state astate1;
+	qsc_aes_state astate2;
+	qsc_chacha_state cstate1;
+	qsc_chacha_state cstate2;
+	bool status;
+
+	status = false;
+	enc = (uint8_t*)qsc_memutils_malloc(flen1 + flen2);
+	msg = (uint8_t*)qsc_memutils_malloc(flen1 + flen2);
+
+	if (enc != NULL && msg != NULL)
+	{
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(ncopy, sizeof(ncopy));
+		qsc_csp_generate(msg, flen1 + flen2);
+
+		if (filecrypto_write_file(FILECRYPTO_TEST_PATH1, msg, flen1) == true &&
+			filecrypto_write_file(FILECRYPTO_TEST_PATH2, msg + flen1, flen2) == true)
+		{
+			qsc_aes_keyparams akp1 = { key, sizeof(key), nonce1, NULL, 0 };
+			qsc_aes_keyparams akp2 = { key, sizeof(key), nonce2, NULL, 0 };
+
+			status = true;
+
+			/* the expected cipher-text, the same two transforms in memory */
+			qsc_memutils_copy(nonce1, ncopy, sizeof(ncopy));
+			qsc_aes_initialize(&astate1, &akp1, true, qsc_aes_cipher_256);
+			qsc_aes_ctrbe_transform(&astate1, enc, msg, flen1);
+			qsc_aes_ctrbe_transform(&astate1, enc + flen1, msg + flen1, flen2);
+			qsc_aes_dispose(&astate1);
+
+			qsc_memutils_copy(nonce2, ncopy, sizeof(ncopy));
+			qsc_aes_initialize(&astate2, &akp2, true, qsc_aes_cipher_256);
+
+			if (qsc_filecrypto_aes_ctrbe_transform(&astate2, FILECRYPTO_TEST_PATH1, FILECRYPTO_TEST_PATH3) == false ||
+				filecrypto_file_equals(FILECRYPTO_TEST_PATH3, enc, flen1) == false ||
+				qsc_filecrypto_aes_ctrbe_transform(&astate2, FILECRYPTO_TEST_PATH2, FILECRYPTO_TEST_PATH3) == false ||
+				filecrypto_file_equals(FILECRYPTO_TEST_PATH3, enc + flen1, flen2) == false ||
+				qsc_intutils_are_equal8(nonce1, nonce2, sizeof(nonce1)) == false)
+			{
+				qsctest_print_line("filecrypto cipher test: the AES-CTR file cipher-text does not match.");
+				status = false;
+			}
+
+			qsc_aes_dispose(&astate2);
+
+			/* the second file began at the block after the end of the first, decrypt it in place from there */
+			if (status == true)
+			{
+				qsc_aes_initialize(&astate2, &akp2, true, qsc_aes_cipher_256);
+				qsc_aes_ctrbe_seek(&astate2, ncopy, ((flen1 + QSC_AES_BLOCK_SIZE - 1U) / QSC_AES_BLOCK_SIZE) * QSC_AES_BLOCK_SIZE);
+
+				if (qsc_filecrypto_aes_ctrbe_transform(&astate2, FILECRYPTO_TEST_PATH3, FILECRYPTO_TEST_PATH3) == false ||
+					filecrypto_file_equals(FILECRYPTO_TEST_PATH3, msg + flen1, flen2) == false)
+				{
+					qsctest_print_line("filecrypto cipher test: the AES-CTR in-place decryption does not match.");
+					status = false;
+				}
+
+				qsc_aes_dispose(&astate2);
+			}
+
+			/* repeat with ChaCha */
+			if (status == true)
+			{
+				qsc_chacha_keyparams ckp = { key, sizeof(key), ncopy };
+
+				qsc_chacha_initialize(&cstate1, &ckp);
+				qsc_chacha_transform(&cstate1, enc, msg, flen1);
+				qsc_chacha_transform(&cstate1, enc + flen1, msg + flen1, flen2);
+				qsc_chacha_dispose(&cstate1);
+
+				qsc_chacha_initialize(&cstate2, &ckp);
+
+				if (qsc_filecrypto_chacha_transform(&cstate2, FILECRYPTO_TEST_PATH1, FILECRYPTO_TEST_PATH3) == false ||
+					filecrypto_file_equals(FILECRYPTO_TEST_PATH3, enc, flen1) == false ||
+					qsc_filecrypto_chacha_transform(&cstate2, FILECRYPTO_TEST_PATH2, FILECRYPTO_TEST_PATH3) == false ||
+					filecrypto_file_equals(FILECRYPTO_TEST_PATH3, enc + flen1, flen2) == false)
+				{
+					qsctest_print_line("filecrypto cipher test: the ChaCha file cipher-text does not match.");
+					status = false;
+				}
+
+				qsc_chacha_dispose(&cstate2);
+			}
+
+			if (status == true)
+			{
+				qsc_chacha_keyparams ckp = { key, sizeof(key), ncopy };
+
+				qsc_chacha_initialize(&cstate2, &ckp);
+				qsc_chacha_seek(&cstate2, ((flen1 + QSC_CHACHA_BLOCK_SIZE - 1U) / QSC_CHACHA_BLOCK_SIZE) * QSC_CHACHA_BLOCK_SIZE);
+
+				if (qsc_filecrypto_chacha_transform(&cstate2, FILECRYPTO_TEST_PATH3, FILECRYPTO_TEST_PATH3) == false ||
+					filecrypto_file_equals(FILECRYPTO_TEST_PATH3, msg + flen1, flen2) == false)
+				{
+					qsctest_print_line("filecrypto cipher test: the ChaCha in-place decryption does not match.");
+					status = false;
+				}
+
+				qsc_chacha_dispose(&cstate2);
+			}
+		}
+		else
+		{
+			qsctest_print_line("filecrypto cipher test: the input files could not be written.");
+		}
+	}
+
+	if (enc != NULL)
+	{
+		qsc_memutils_alloc_free(enc);
+	}
+
+	if (msg != NULL)
+	{
+		qsc_memutils_alloc_free(msg);
+	}
+
+	filecrypto_delete_files();
+
+	return status;
+}
+
+bool qsctest_filecrypto_aead_test()
+{
+	/* an empty file, a partial segment, and the lengths either side of a segment boundary */
+	const size_t lens[] = { 0U, 1U, QSC_FILECRYPTO_SEGMENT_SIZE - 1U, QSC_FILECRYPTO_SEGMENT_SIZE, QSC_FILECRYPTO_SEGMENT_SIZE + 1U };
+	const size_t klens[] = { QSC_RCS256_KEY_SIZE, QSC_RCS512_KEY_SIZE };
+	uint8_t key[QSC_RCS512_KEY_SIZE] = { 0 };
+	qsc_filecrypto_header header;
+	uint8_t* msg;
+	size_t mlen;
+	bool status;
+
+	status = true;
+	msg = (uint8_t*)qsc_memutils_malloc(QSC_FILECRYPTO_SEGMENT_SIZE + 1U);
+
+	if (msg != NULL)
+	{
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(msg, QSC_FILECRYPTO_SEGMENT_SIZE + 1U);
+
+		for (size_t k = 0U; k < sizeof(klens) / sizeof(klens[0]) && status == true; ++k)
+		{
+			for (size_t i = 0U; i < sizeof(lens) / sizeof(lens[0]) && status == true; ++i)
+			{
+				mlen = lens[i];
+
+				if (filecrypto_write_file(FILECRYPTO_TEST_PATH1, msg, mlen) == false ||
+					qsc_filecrypto_encrypt(key, klens[k], FILECRYPTO_TEST_PATH1, FILECRYPTO_TEST_PATH2, i) == false)
+				{
+					qsctest_print_line("filecrypto aead test: the file could not be encrypted.");
+					status = false;
+					break;
+				}
+
+				if (qsc_filecrypto_header_read(&header, FILECRYPTO_TEST_PATH2) == false ||
+					header.length != mlen || header.segment != QSC_FILECRYPTO_SEGMENT_SIZE)
+				{
+					qsctest_print_line("filecrypto aead test: the header does not describe the message.");
+					status = false;
+				}
+
+				if (qsc_filecrypto_decrypt(key, klens[k], FILECRYPTO_TEST_PATH2, FILECRYPTO_TEST_PATH3, 0U) == false ||
+					filecrypto_file_equals(FILECRYPTO_TEST_PATH3, msg, mlen) == false)
+				{
+					qsctest_print_line("filecrypto aead test: the decrypted file does not match the message.");
+					status = false;
+				}
+			}
+		}
+
+		qsc_memutils_alloc_free(msg);
+	}
+	else
+	{
+		status = false;
+	}
+
+	filecrypto_delete_files();
+
+	return status;
+}
+
+bool qsctest_filecrypto_tamper_test()
+{
+	/* three segments, the last one partial */
+	const size_t mlen = (2U * QSC_FILECRYPTO_SEGMENT_SIZE) + 100U;
+	const size_t cseg = QSC_FILECRYPTO_SEGMENT_SIZE + QSC_RCS256_MAC_SIZE;
+	const size_t clen = QSC_FILECRYPTO_HEADER_SIZE + mlen + (3U * QSC_RCS256_MAC_SIZE);
+	uint8_t key[QSC_RCS256_KEY_SIZE] = { 0 };
+	uint8_t* enc;
+	uint8_t* msg;
+	uint8_t* tmpe;
+	bool status;
+
+	status = false;
+	enc = (uint8_t*)qsc_memutils_malloc(clen);
+	msg = (uint8_t*)qsc_memutils_malloc(mlen);
+	tmpe = (uint8_t*)qsc_memutils_malloc(clen);
+
+	if (enc != NULL && msg != NULL && tmpe != NULL)
+	{
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(msg, mlen);
+
+		if (filecrypto_write_file(FILECRYPTO_TEST_PATH1, msg, mlen) == true &&
+			qsc_filecrypto_encrypt(key, sizeof(key), FILECRYPTO_TEST_PATH1, FILECRYPTO_TEST_PATH2, 0U) == true &&
+			qsc_fileutils_get_size(FILECRYPTO_TEST_PATH2) == clen &&
+			qsc_fileutils_copy_file_to_stream(FILECRYPTO_TEST_PATH2, (char*)enc, clen) == clen)
+		{
+			status = true;
+
+			for (size_t i = 0U; i < 7U && status == true; ++i)
+			{
+				size_t tlen;
+
+				qsc_memutils_copy(tmpe, enc, clen);
+				tlen = clen;
+
+				if (i == 0U)
+				{
+					/* flip a cipher-text byte in the second segment */
+					tmpe[QSC_FILECRYPTO_HEADER_SIZE + cseg + 17U] ^= 0x01U;
+				}
+				else if (i == 1U)
+				{
+					/* flip a MAC code byte of the first segment */
+					tmpe[QSC_FILECRYPTO_HEADER_SIZE + QSC_FILECRYPTO_SEGMENT_SIZE] ^= 0x80U;
+				}
+				else if (i == 2U)
+				{
+					/* truncate the final segment */
+					tlen = clen - 1U;
+				}
+				else if (i == 3U)
+				{
+					/* drop the final segment */
+					tlen = QSC_FILECRYPTO_HEADER_SIZE + (2U * cseg);
+				}
+				else if (i == 4U)
+				{
+					/* swap the first and second segments */
+					qsc_memutils_copy(tmpe + QSC_FILECRYPTO_HEADER_SIZE, enc + QSC_FILECRYPTO_HEADER_SIZE + cseg, cseg);
+					qsc_memutils_copy(tmpe + QSC_FILECRYPTO_HEADER_SIZE + cseg, enc + QSC_FILECRYPTO_HEADER_SIZE, cseg);
+				}
+				else if (i == 5U)
+				{
+					uint64_t inv;
+
+					/* forge a one byte segment and a length for which the header size + 33 * length wraps to the file size;
+					   the file is shortened by one byte so the body is not a multiple of 33, and the forged length exceeds the file.
+					   the inverse of the segment and mac length sum modulo 2^64 is found by Newton iteration */
+					inv = 33U;
+
+					for (size_t j = 0U; j < 6U; ++j)
+					{
+						inv *= 2U - (33U * inv);
+					}
+
+					tlen = clen - 1U;
+					qsc_intutils_le32to8(tmpe + 8U, 1U);
+					qsc_intutils_le64to8(tmpe + 16U, (uint64_t)(tlen - QSC_FILECRYPTO_HEADER_SIZE) * inv);
+				}
+				else
+				{
+					/* declare a segment larger than the format maximum */
+					qsc_intutils_le32to8(tmpe + 8U, (uint32_t)(QSC_FILECRYPTO_SEGMENT_SIZE * 2U));
+				}
+
+				if (filecrypto_write_file(FILECRYPTO_TEST_PATH2, tmpe, tlen) == false)
+				{
+					status = false;
+					break;
+				}
+
+				/* the file is rejected, and no plain-text output is left behind */
+				if (qsc_filecrypto_decrypt(key, sizeof(key), FILECRYPTO_TEST_PATH2, FILECRYPTO_TEST_PATH3, 0U) == true ||
+					qsc_fileutils_exists(FILECRYPTO_TEST_PATH3) == true)
+				{
+					qsctest_print_line("filecrypto tamper test: a modified file was decrypted.");
+					status = false;
+				}
+
+				if (i >= 5U)
+				{
+					qsc_filecrypto_header header;
+
+					/* a forged header is rejected before any segment is read */
+					if (qsc_filecrypto_header_read(&header, FILECRYPTO_TEST_PATH2) == true ||
+						qsc_filecrypto_decrypt_range(tmpe, 0U, 100U, key, sizeof(key), FILECRYPTO_TEST_PATH2) == true)
+					{
+						qsctest_print_line("filecrypto tamper test: a forged header was accepted.");
+						status = false;
+					}
+				}
+
+				if (i == 0U)
+				{
+					/* a range within the intact first segment is still readable, a range in the modified segment is not */
+					if (qsc_filecrypto_decrypt_range(tmpe, 10U, 100U, key, sizeof(key), FILECRYPTO_TEST_PATH2) == false ||
+						qsc_intutils_are_equal8(tmpe, msg + 10U, 100U) == false ||
+						qsc_filecrypto_decrypt_range(tmpe, QSC_FILECRYPTO_SEGMENT_SIZE + 10U, 100U, key, sizeof(key), FILECRYPTO_TEST_PATH2) == true)
+					{
+						qsctest_print_line("filecrypto tamper test: a range read did not authenticate only its own segments.");
+						status = false;
+					}
+				}
+			}
+		}
+		else
+		{
+			qsctest_print_line("filecrypto tamper test: the file could not be encrypted.");
+		}
+	}
+
+	if (enc != NULL)
+	{
+		qsc_memutils_alloc_free(enc);
+	}
+
+	if (msg != NULL)
+	{
+		qsc_memutils_alloc_free(msg);
+	}
+
+	if (tmpe != NULL)
+	{
+		qsc_memutils_alloc_free(tmpe);
+	}
+
+	filecrypto_delete_files();
+
+	return status;
+}
+
+bool qsctest_filecrypto_range_test()
+{
+	const size_t mlen = (2U * QSC_FILECRYPTO_SEGMENT_SIZE) + 100U;
+	/* offset and length pairs; within one segment, across one and two segment boundaries, and the whole file */
+	const size_t rngs[][2] = { { 0U, 1U }, { 5U, 1000U }, { QSC_FILECRYPTO_SEGMENT_SIZE - 10U, 20U },
+		{ QSC_FILECRYPTO_SEGMENT_SIZE, QSC_FILECRYPTO_SEGMENT_SIZE }, { QSC_FILECRYPTO_SEGMENT_SIZE - 1U, QSC_FILECRYPTO_SEGMENT_SIZE + 2U },
+		{ (2U * QSC_FILECRYPTO_SEGMENT_SIZE) + 99U, 1U }, { 0U, (2U * QSC_FILECRYPTO_SEGMENT_SIZE) + 100U } };
+	uint8_t key[QSC_RCS512_KEY_SIZE] = { 0 };
+	uint8_t* dec;
+	uint8_t* msg;
+	uint8_t* otp;
+	bool status;
+
+	status = false;
+	dec = (uint8_t*)qsc_memutils_malloc(mlen);
+	msg = (uint8_t*)qsc_memutils_malloc(mlen);
+	otp = (uint8_t*)qsc_memutils_malloc(mlen);
+
+	if (dec != NULL && msg != NULL && otp != NULL)
+	{
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(msg, mlen);
+
+		/* the reference is a full decryption of the file */
+		if (filecrypto_write_file(FILECRYPTO_TEST_PATH1, msg, mlen) == true &&
+			qsc_filecrypto_encrypt(key, sizeof(key), FILECRYPTO_TEST_PATH1, FILECRYPTO_TEST_PATH2, 3U) == true &&
+			qsc_filecrypto_decrypt(key, sizeof(key), FILECRYPTO_TEST_PATH2, FILECRYPTO_TEST_PATH3, 3U) == true &&
+			qsc_fileutils_copy_file_to_stream(FILECRYPTO_TEST_PATH3, (char*)dec, mlen) == mlen &&
+			qsc_intutils_are_equal8(dec, msg, mlen) == true)
+		{
+			status = true;
+
+			for (size_t i = 0U; i < sizeof(rngs) / sizeof(rngs[0]); ++i)
+			{
+				qsc_memutils_clear(otp, mlen);
+
+				if (qsc_filecrypto_decrypt_range(otp, rngs[i][0], rngs[i][1], key, sizeof(key), FILECRYPTO_TEST_PATH2) == false ||
+					qsc_intutils_are_equal8(otp, dec + rngs[i][0], rngs[i][1]) == false)
+				{
+					qsctest_print_line("filecrypto range test: a decrypted range does not match the full decryption.");
+					status = false;
+					break;
+				}
+			}
+
+			/* a range that extends past the end of the file is rejected */
+			if (qsc_filecrypto_decrypt_range(otp, mlen - 1U, 2U, key, sizeof(key), FILECRYPTO_TEST_PATH2) == true)
+			{
+				qsctest_print_line("filecrypto range test: a range past the end of the file was accepted.");
+				status = false;
+			}
+		}
+		else
+		{
+			qsctest_print_line("filecrypto range test: the file could not be encrypted and decrypted.");
+		}
+	}
+
+	if (dec != NULL)
+	{
+		qsc_memutils_alloc_free(dec);
+	}
+
+	if (msg != NULL)
+	{
+		qsc_memutils_alloc_free(msg);
+	}
+
+	if (otp != NULL)
+	{
+		qsc_memutils_alloc_free(otp);
+	}
+
+	filecrypto_delete_files();
+
+	return status;
+}
+
+void qsctest_filecrypto_run()
+{
+	if (qsctest_filecrypto_map_test() == true)
+	{
+		qsctest_print_line("Success! Passed the memory-mapped file view tests.");
+	}
+	else
+	{
+		qsctest_print_line("Failure! Failed the memory-mapped file view tests.");
+	}
+
+	if (qsctest_filecrypto_hash_test() == true)
+	{
+		qsctest_print_line("Success! Passed the SHA3, SHAKE, and KMAC file hashing tests.");
+	}
+	else
+	{
+		qsctest_print_line("Failure! Failed the SHA3, SHAKE, and KMAC file hashing tests.");
+	}
+
+	if (qsctest_filecrypto_cipher_test() == true)
+	{
+		qsctest_print_line("Success! Passed the AES-CTR and ChaCha file transform tests.");
+	}
+	else
+	{
+		qsctest_print_line("Failure! Failed the AES-CTR and ChaCha file transform tests.");
+	}
+
+	if (qsctest_filecrypto_aead_test() == true)
+	{
+		qsctest_print_line("Success! Passed the segmented file encryption round trip tests.");
+	}
+	else
+	{
+		qsctest_print_line("Failure! Failed the segmented file encryption round trip tests.");
+	}
+
+	if (qsctest_filecrypto_tamper_test() == true)
+	{
+		qsctest_print_line("Success! Passed the segmented file encryption tamper rejection tests.");
+	}
+	else
+	{
+		qsctest_print_line("Failure! Failed the segmented file encryption tamper rejection tests.");
+	}
+
+	if (qsctest_filecrypto_range_test() == true)
+	{
+		qsctest_print_line("Success! Passed the segmented file encryption range decryption tests.");
+	}
+	else
+	{
+		qsctest_print_line("Failure! Failed the segmented file encryption range decryption tests.");
+	}
+}
@@ -0,0 +1,137 @@
+/* 2025 Quantum Resistant Cryptographic Solutions Corporation
+ * All Rights Reserved.
+ *
+ * NOTICE: This software and all accompanying materials are the exclusive 
+ * property of Quantum Resistant Cryptographic Solutions Corporation (QRCS).
+ * The intellectual and technical concepts contained within this implementation 
+ * are proprietary to QRCS and its authorized licensors and are protected under 
+ * applicable U.S. and international copyright, patent, and trade secret laws.
+ *
+ * CRYPTOGRAPHIC STANDARDS:
+ * - This software includes implementations of cryptographic algorithms such as 
+ *   SHA3, AES, and others. These algorithms are public domain or standardized 
+ *   by organizations such as NIST and are NOT the property of QRCS.
+ * - However, all source code, optimizations, and implementations in this library 
+ *   are original works of QRCS and are protected under this license.
+ *
+ * RESTRICTIONS:
+ * - Redistribution, modification, or unauthorized distribution of this software, 
+ *   in whole or in part, is strictly prohibited.
+ * - This software is provided for non-commercial, educational, and research 
+ *   purposes only. Commercial use in any form is expressly forbidden.
+ * - Licensing and authorized distribution are solely at the discretion of QRCS.
+ * - Any use of this software implies acceptance of these restrictions.
+ *
+ * DISCLAIMER:
+ * This software is provided "as is," without warranty of any kind, express or 
+ * implied, including but not limited to warranties of merchantability or fitness 
+ * for a particular purpose. QRCS disclaims all liability for any direct, indirect, 
+ * incidental, or consequential damages resulting from the use or misuse of this software.
+ *
+ * FULL LICENSE:
+ * This software is subject to the **Quantum Resistant Cryptographic Solutions 
+ * Proprietary License (QRCS-PL)**. The complete license terms are included 
+ * in the LICENSE.txt file distributed with this software.
+ *
+ * Written by: John G. Underhill
+ * Contact: john.underhill@protonmail.com
+ */
+
+#ifndef QSCTEST_FILECRYPTO_TEST_H
+#define QSCTEST_FILECRYPTO_TEST_H
+
+#include "../QSC/common.h"
+
+/**
+ * \file filecrypto_test.h
+ * \brief Tests the memory-mapped file views and the file hashing and cipher functions.
+ *
+ * \details
+ * This file contains behavioural tests for the mapped file functions in fileutils.h, and the file functions in filecrypto.h.
+ * Mapped views are checked for reads and writes through the view, and the file hash, SHAKE, KMAC, AES-CTR, and ChaCha
+ * functions are compared with the same functions applied to the file contents in memory.
+ * The segmented authenticated file format is checked for round trips, for rejection of modified, truncated, and reordered files,
+ * and for range reads that match a full decryption.
+ * The tests create temporary files in the working directory and delete them when they complete.
+ */
+
+/**
+ * \brief Tests the memory-mapped file views.
+ *
+ * \details
+ * Creates files of several sizes, including an empty file, with qsc_fileutils_map_create, writes them through the view,
+ * and checks that a read-only view of the file returns the same bytes. A byte changed through a writable view
+ * must be visible when the file is read with the stream functions.
+ *
+ * \return Returns true if the mapped views behave as expected; otherwise, false.
+ */
+bool qsctest_filecrypto_map_test(void);
+
+/**
+ * \brief Tests the file hashing functions.
+ *
+ * \details
+ * Compares the SHA3-256, SHA3-512, SHAKE-256, and KMAC-256 outputs of files of several sizes, including an empty file
+ * and a file larger than one read-ahead segment, with the outputs of the same functions computed over the file contents in memory.
+ *
+ * \return Returns true if the file and memory outputs are identical; otherwise, false.
+ */
+bool qsctest_filecrypto_hash_test(void);
+
+/**
+ * \brief Tests the AES-CTR and ChaCha file transforms.
+ *
+ * \details
+ * Encrypts two files with one cipher state and compares the output files with the same two transforms of the file contents
+ * in memory, checking that the state is left positioned for the second file. The second cipher-text file is then
+ * decrypted in place and compared with the message.
+ *
+ * \return Returns true if the file transforms match the memory transforms; otherwise, false.
+ */
+bool qsctest_filecrypto_cipher_test(void);
+
+/**
+ * \brief Tests the segmented authenticated file encryption round trip.
+ *
+ * \details
+ * Encrypts and decrypts files of zero bytes, one byte, and one byte less than, equal to, and one byte more than
+ * the segment size, with both RCS key sizes and several worker thread counts. The header of each encrypted file must describe
+ * the message, and the decrypted file must be identical to the message.
+ *
+ * \return Returns true if every file decrypts to the message; otherwise, false.
+ */
+bool qsctest_filecrypto_aead_test(void);
+
+/**
+ * \brief Tests that modified encrypted files are rejected.
+ *
+ * \details
+ * Encrypts a three segment file, and checks that the decryption fails and leaves no output file when a cipher-text byte
+ * or a MAC code byte is flipped, when the final segment is truncated or removed, when two segments are swapped,
+ * and when the header declares a forged length or a segment larger than the format maximum.
+ * A range read within an unmodified segment must still succeed, and a range read within a modified segment must fail.
+ *
+ * \return Returns true if every modified file is rejected; otherwise, false.
+ */
+bool qsctest_filecrypto_tamper_test(void);
+
+/**
+ * \brief Tests the decryption of a range of an encrypted file.
+ *
+ * \details
+ * Decrypts ranges within one segment, across one and two segment boundaries, at the end of the file, and over the whole file
+ * with qsc_filecrypto_decrypt_range, and compares each range with the same bytes of a full decryption.
+ * A range that extends past the end of the file must be rejected.
+ *
+ * \return Returns true if every range matches the full decryption; otherwise, false.
+ */
+bool qsctest_filecrypto_range_test(void);
+
+/**
+ * \brief Runs the file cryptography tests.
+ *
+ * This function executes the mapped file, file hashing, file cipher, and segmented file encryption tests and prints the outcome of each test to the console.
+ */
+void qsctest_filecrypto_run(void);
+
+#endif
@@ -0,0 +1,242 @@
+#include "memutils_test.h"
+#include "../QSC/async.h"
+#include "../QSC/memutils.h"
+#include "testutils.h"
+
+#define MEMUTILS_TEST_BLOCKS 48U
+#define MEMUTILS_TEST_THREADS 4U
+
+/* \cond */
+
+typedef struct
+{
+	qsc_memutils_pool* pool;
+	size_t seed;
+	bool status;
+} memutils_pool_task;
+
+/* \endcond */
+
+static bool memutils_is_zeroed(const uint8_t* block, size_t length)
+{
+	uint8_t c;
+
+	c = 0;
+
+	for (size_t i = 0; i < length; ++i)
+	{
+		c |= block[i];
+	}
+
+	return (c == 0);
+}
+
+static bool memutils_pool_blocks(qsc_memutils_pool* pool, size_t seed)
+{
+	uint8_t* blocks[MEMUTILS_TEST_BLOCKS] = { 0 };
+	size_t lens[MEMUTILS_TEST_BLOCKS] = { 0 };
+	size_t i;
+	size_t j;
+	bool res;
+
+	res = true;
+
+	/* every size class, and large blocks beyond the largest class */
+	for (i = 0; i < MEMUTILS_TEST_BLOCKS; ++i)
+	{
+		lens[i] = 1U + (((i * 131U) + (seed * 17U)) % (QSC_MEMUTILS_POOL_CLASS_MAXIMUM + 2048U));
+	}
+
+	for (size_t r = 0; r < 2; ++r)
+	{
+		for (i = 0; i < MEMUTILS_TEST_BLOCKS; ++i)
+		{
+			blocks[i] = (uint8_t*)qsc_memutils_pool_alloc(pool, lens[i]);
+
+			if (blocks[i] == NULL)
+			{
+				qsctest_print_line("memutils pool test: allocation failed.");
+				res = false;
+				continue;
+			}
+
+			/* new and recycled blocks are zeroed, and 16-byte aligned */
+			if (memutils_is_zeroed(blocks[i], lens[i]) == false || ((uintptr_t)blocks[i] % 16U) != 0)
+			{
+				qsctest_print_line("memutils pool test: the block is not zeroed or aligned.");
+				res = false;
+			}
+
+			qsc_memutils_set_value(blocks[i], lens[i], (uint8_t)(i + 1U));
+		}
+
+		/* a block overlapping another would have been overwritten */
+		for (i = 0; i < MEMUTILS_TEST_BLOCKS; ++i)
+		{
+			if (blocks[i] != NULL)
+			{
+				for (j = 0; j < lens[i]; ++j)
+				{
+					if (blocks[i][j] != (uint8_t)(i + 1U))
+					{
+						qsctest_print_line("memutils pool test: two blocks overlap.");
+						res = false;
+						break;
+					}
+				}
+			}
+		}
+
+		for (i = 0; i < MEMUTILS_TEST_BLOCKS; ++i)
+		{
+			if (blocks[i] != NULL)
+			{
+				qsc_memutils_pool_free(pool, blocks[i]);
+				blocks[i] = NULL;
+			}
+		}
+	}
+
+	return res;
+}
+
+static void memutils_pool_worker(void* state)
+{
+	memutils_pool_task* task;
+
+	task = (memutils_pool_task*)state;
+	task->status = memutils_pool_blocks(task->pool, task->seed);
+}
+
+bool qsctest_memutils_pool_test()
+{
+	const uint32_t flags[2] = { (uint32_t)qsc_memutils_pool_flag_none, (uint32_t)qsc_memutils_pool_flag_guarded };
+	memutils_pool_task tasks[MEMUTILS_TEST_THREADS] = { 0 };
+	qsc_memutils_pool_stats stats = { 0 };
+	qsc_memutils_pool* pool;
+	bool res;
+
+	res = true;
+
+	for (size_t f = 0; f < 2; ++f)
+	{
+		pool = qsc_memutils_pool_create(flags[f]);
+
+		if (pool == NULL)
+		{
+			qsctest_print_line("memutils pool test: the pool could not be created.");
+			res = false;
+			continue;
+		}
+
+		if (memutils_pool_blocks(pool, 0) == false)
+		{
+			res = false;
+		}
+
+		if (qsc_memutils_pool_reserve(pool, 1568, 32) == false)
+		{
+			qsctest_print_line("memutils pool test: the reservation failed.");
+			res = false;
+		}
+
+		/* threads allocate from their own caches of the shared pool */
+		for (size_t i = 0; i < MEMUTILS_TEST_THREADS; ++i)
+		{
+			tasks[i].pool = pool;
+			tasks[i].seed = i + 1U;
+			tasks[i].status = false;
+		}
+
+		qsc_async_launch_parallel_threads(&memutils_pool_worker, MEMUTILS_TEST_THREADS, &tasks[0], &tasks[1], &tasks[2], &tasks[3]);
+
+		for (size_t i = 0; i < MEMUTILS_TEST_THREADS; ++i)
+		{
+			if (tasks[i].status == false)
+			{
+				qsctest_print_line("memutils pool test: a worker thread failed.");
+				res = false;
+			}
+		}
+
+		/* every block has been released */
+		qsc_memutils_pool_statistics(pool, &stats);
+
+		if (stats.allocations != stats.releases || stats.allocations == 0 || stats.inuse != 0 ||
+			stats.large != 0 || stats.slabs == 0 || stats.failures != 0)
+		{
+			qsctest_print_line("memutils pool test: the pool statistics do not balance.");
+			res = false;
+		}
+
+		qsc_memutils_pool_destroy(pool);
+	}
+
+	return res;
+}
+
+bool qsctest_memutils_large_test()
+{
+	/* a standard page request, a request rounded up to whole huge pages, and a multi-page request */
+	const size_t lens[3] = { 65536U, (size_t)(QSC_MEMUTILS_LARGE_PAGE_SIZE / 2U) + 1U, (size_t)(3U * QSC_MEMUTILS_LARGE_PAGE_SIZE) };
+	const int32_t nodes[2] = { QSC_MEMUTILS_NUMA_NODE_ANY, 0 };
+	uint8_t* block;
+	bool res;
+
+	res = true;
+
+	for (size_t n = 0; n < 2; ++n)
+	{
+		for (size_t i = 0; i < 3; ++i)
+		{
+			block = (uint8_t*)qsc_memutils_large_alloc(lens[i], nodes[n]);
+
+			if (block == NULL)
+			{
+				qsctest_print_line("memutils large block test: allocation failed.");
+				res = false;
+				continue;
+			}
+
+			if (memutils_is_zeroed(block, lens[i]) == false || ((uintptr_t)block % 4096U) != 0)
+			{
+				qsctest_print_line("memutils large block test: the block is not zeroed or page aligned.");
+				res = false;
+			}
+
+			/* the whole requested length is writable */
+			qsc_memutils_set_value(block, lens[i], (uint8_t)(i + 0x5AU));
+
+			if (block[0] != (uint8_t)(i + 0x5AU) || block[lens[i] - 1U] != (uint8_t)(i + 0x5AU))
+			{
+				qsctest_print_line("memutils large block test: the block could not be written.");
+				res = false;
+			}
+
+			qsc_memutils_large_free(block, lens[i]);
+		}
+	}
+
+	return res;
+}
+
+void qsctest_memutils_run()
+{
+	if (qsctest_memutils_pool_test() == true)
+	{
+		qsctest_print_line("Success! Passed the memory pool tests.");
+	}
+	else
+	{
+		qsctest_print_line("Failure! Failed the memory pool tests.");
+	}
+
+	if (qsctest_memutils_large_test() == true)
+	{
+		qsctest_print_line("Success! Passed the large block allocator tests.");
+	}
+	else
+	{
+		qsctest_print_line("Failure! Failed the large block allocator tests.");
+	}
+}
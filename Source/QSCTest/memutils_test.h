@@ -0,0 +1,87 @@
+/* 2025 Quantum Resistant Cryptographic Solutions Corporation
+ * All Rights Reserved.
+ *
+ * NOTICE: This software and all accompanying materials are the exclusive 
+ * property of Quantum Resistant Cryptographic Solutions Corporation (QRCS).
+ * The intellectual and technical concepts contained within this implementation 
+ * are proprietary to QRCS and its authorized licensors and are protected under 
+ * applicable U.S. and international copyright, patent, and trade secret laws.
+ *
+ * CRYPTOGRAPHIC STANDARDS:
+ * - This software includes implementations of cryptographic algorithms such as 
+ *   SHA3, AES, and others. These algorithms are public domain or standardized 
+ *   by organizations such as NIST and are NOT the property of QRCS.
+ * - However, all source code, optimizations, and implementations in this library 
+ *   are original works of QRCS and are protected under this license.
+ *
+ * RESTRICTIONS:
+ * - Redistribution, modification, or unauthorized distribution of this software, 
+ *   in whole or in part, is strictly prohibited.
+ * - This software is provided for non-commercial, educational, and research 
+ *   purposes only. Commercial use in any form is expressly forbidden.
+ * - Licensing and authorized distribution are solely at the discretion of QRCS.
+ * - Any use of this software implies acceptance of these restrictions.
+ *
+ * DISCLAIMER:
+ * This software is provided "as is," without warranty of any kind, express or 
+ * implied, including but not limited to warranties of merchantability or fitness 
+ * for a particular purpose. QRCS disclaims all liability for any direct, indirect, 
+ * incidental, or consequential damages resulting from the use or misuse of this software.
+ *
+ * FULL LICENSE:
+ * This software is subject to the **Quantum Resistant Cryptographic Solutions 
+ * Proprietary License (QRCS-PL)**. The complete license terms are included 
+ * in the LICENSE.txt file distributed with this software.
+ *
+ * Written by: John G. Underhill
+ * Contact: john.underhill@protonmail.com
+ */
+
+#ifndef QSCTEST_MEMUTILS_TEST_H
+#define QSCTEST_MEMUTILS_TEST_H
+
+#include "../QSC/common.h"
+
+/**
+ * \file memutils_test.h
+ * \brief Tests the memory pool and allocator functions.
+ *
+ * \details
+ * This file contains behavioural tests for the memory allocators provided by memutils.h.
+ * The size-class pool is exercised with pageable and guard-paged slabs, from one thread and from several
+ * threads sharing a pool, checking that blocks are zeroed, aligned, do not overlap, are wiped when recycled,
+ * and that the usage statistics balance when every block has been released.
+ * The large block allocator is checked for zeroed, page aligned, and writable blocks.
+ */
+
+/**
+ * \brief Tests the size-class memory pool.
+ *
+ * \details
+ * Allocates blocks of every size class and large blocks, checks zeroing, alignment, and that no two blocks
+ * overlap, then releases them and checks that recycled blocks are wiped and that the statistics balance.
+ * The test runs with and without guard pages, and repeats the allocation pattern from four threads.
+ *
+ * \return Returns true if the pool behaves as expected; otherwise, false.
+ */
+bool qsctest_memutils_pool_test(void);
+
+/**
+ * \brief Tests the large block allocator.
+ *
+ * \details
+ * Allocates standard page and huge page sized blocks with and without a NUMA node hint,
+ * and checks that each block is zeroed, page aligned, and writable over its full length.
+ *
+ * \return Returns true if the large blocks behave as expected; otherwise, false.
+ */
+bool qsctest_memutils_large_test(void);
+
+/**
+ * \brief Runs the memory utilities tests.
+ *
+ * This function executes the memory pool and large block allocator tests and prints the outcome of each test to the console.
+ */
+void qsctest_memutils_run(void);
+
+#endif
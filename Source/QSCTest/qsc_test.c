@@ -58,6 +58,7 @@
 #include "aes_test.h"
 #include "aesavs_test.h"
 #include "async_test.h"
+#include "asyncio_test.h"
 #include "benchmark.h"
 #include "chacha_test.h"
 #include "common.h"
@@ -67,8 +68,10 @@
 #include "ecdsa_test.h"
 #include "encoding_test.h"
 #include "falcon_test.h"
+#include "filecrypto_test.h"
 #include "kyber_test.h"
 #include "mceliece_test.h"
+#include "memutils_test.h"
 #include "netutils_test.h"
 #include "ntru_test.h"
 #include "poly1305_test.h"
@@ -78,6 +81,7 @@
 #include "secrand_test.h"
 #include "sha2_test.h"
 #include "sha3_test.h"
+#include "socket_test.h"
 #include "sphincsplus_test.h"
 #include "testutils.h"
 
@@ -276,6 +280,22 @@ int32_t main(void)
 			qsctest_encoding_run();
 			qsctest_print_line("");
 
+			qsctest_print_line("*** Test the memory pool and large block allocators ***");
+			qsctest_memutils_run();
+			qsctest_print_line("");
+
+			qsctest_print_line("*** Test the memory-mapped file views, the file hashing and cipher functions, and the segmented file encryption ***");
+			qsctest_filecrypto_run();
+			qsctest_print_line("");
+
+			qsctest_print_line("*** Test the asynchronous completion queue with file and loopback socket I/O ***");
+			qsctest_asyncio_run();
+			qsctest_print_line("");
+
+			qsctest_print_line("*** Test the socket reactor and the vectored, batched, and file socket transfers over loopback ***");
+			qsctest_socket_run();
+			qsctest_print_line("");
+
 			qsctest_print_line("*** Test the ECDH implementation using stress, validity checks, and known answer tests ***");
 			qsctest_ecdh_run();
 			qsctest_print_line("");
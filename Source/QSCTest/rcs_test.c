@@ -467,6 +467,260 @@ bool qsctest_rcs512_stress_test()
 	return status;
 }
 
+bool qsctest_rcs_parallel_equality()
+{
+	/* lengths shorter than one thread's share, and lengths that are not a multiple of the block size */
+	const size_t lens[] = { 1U, 31U, 33U, 0x0FFFFU, 0x10001U, 0x30011U, 0x80005U };
+	const size_t thds[] = { 0U, 1U, 3U, 8U };
+	const size_t klens[] = { QSC_RCS256_KEY_SIZE, QSC_RCS512_KEY_SIZE };
+#if defined(QSC_RCS_AUTHENTICATED)
+	const size_t mlens[] = { QSC_RCS256_MAC_SIZE, QSC_RCS512_MAC_SIZE };
+	uint8_t aad[20] = { 0 };
+#endif
+	uint8_t key[QSC_RCS512_KEY_SIZE] = { 0 };
+	uint8_t ncopy[QSC_RCS_NONCE_SIZE] = { 0 };
+	uint8_t nonce1[QSC_RCS_NONCE_SIZE] = { 0 };
+	uint8_t nonce2[QSC_RCS_NONCE_SIZE] = { 0 };
+	uint8_t* dec;
+	uint8_t* enc1;
+	uint8_t* enc2;
+	uint8_t* msg;
+	const size_t mlen = lens[(sizeof(lens) / sizeof(lens[0])) - 1U];
+	qsc_rcs_state ctx1;
+	qsc_rcs_state ctx2;
+	size_t clen;
+	bool status;
+
+	status = true;
+	dec = (uint8_t*)qsc_memutils_malloc(mlen);
+	enc1 = (uint8_t*)qsc_memutils_malloc(mlen + QSC_RCS512_MAC_SIZE);
+	enc2 = (uint8_t*)qsc_memutils_malloc(mlen + QSC_RCS512_MAC_SIZE);
+	msg = (uint8_t*)qsc_memutils_malloc(mlen);
+
+	if (dec != NULL && enc1 != NULL && enc2 != NULL && msg != NULL)
+	{
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(ncopy, sizeof(ncopy));
+		qsc_csp_generate(msg, mlen);
+#if defined(QSC_RCS_AUTHENTICATED)
+		qsc_csp_generate(aad, sizeof(aad));
+#endif
+		/* start the low nonce bytes near their limit so the counter carries */
+		qsc_memutils_set_value(ncopy, sizeof(uint64_t), 0xFFU);
+
+		for (size_t k = 0U; k < sizeof(klens) / sizeof(klens[0]) && status == true; ++k)
+		{
+			qsc_rcs_keyparams kp1 = { key, klens[k], nonce1, NULL, 0 };
+			qsc_rcs_keyparams kp2 = { key, klens[k], nonce2, NULL, 0 };
+
+			for (size_t i = 0U; i < sizeof(lens) / sizeof(lens[0]) && status == true; ++i)
+			{
+#if defined(QSC_RCS_AUTHENTICATED)
+				clen = lens[i] + mlens[k];
+#else
+				clen = lens[i];
+#endif
+
+				for (size_t j = 0U; j < sizeof(thds) / sizeof(thds[0]); ++j)
+				{
+					/* encrypt sequentially and in parallel */
+					qsc_memutils_copy(nonce1, ncopy, sizeof(ncopy));
+					qsc_memutils_copy(nonce2, ncopy, sizeof(ncopy));
+					qsc_rcs_initialize(&ctx1, &kp1, true);
+					qsc_rcs_initialize(&ctx2, &kp2, true);
+#if defined(QSC_RCS_AUTHENTICATED)
+					qsc_rcs_set_associated(&ctx1, aad, sizeof(aad));
+					qsc_rcs_set_associated(&ctx2, aad, sizeof(aad));
+#endif
+
+					if (qsc_rcs_transform(&ctx1, enc1, msg, lens[i]) == false ||
+						qsc_rcs_transform_parallel(&ctx2, enc2, msg, lens[i], thds[j]) == false)
+					{
+						qsctest_print_safe("Failure! rcs_parallel_equality: encryption failure -RP1 \n");
+						status = false;
+					}
+
+					qsc_rcs_dispose(&ctx1);
+					qsc_rcs_dispose(&ctx2);
+
+					/* the cipher-text, MAC code, and final nonce must match the sequential transform */
+					if (qsc_intutils_are_equal8(enc1, enc2, clen) == false ||
+						qsc_intutils_are_equal8(nonce1, nonce2, sizeof(nonce1)) == false)
+					{
+						qsctest_print_safe("Failure! rcs_parallel_equality: output does not match the sequential transform -RP2 \n");
+						status = false;
+					}
+
+					/* decrypt in parallel */
+					qsc_memutils_copy(nonce2, ncopy, sizeof(ncopy));
+					qsc_rcs_initialize(&ctx2, &kp2, false);
+#if defined(QSC_RCS_AUTHENTICATED)
+					qsc_rcs_set_associated(&ctx2, aad, sizeof(aad));
+#endif
+
+					if (qsc_rcs_transform_parallel(&ctx2, dec, enc2, lens[i], thds[j]) == false ||
+						qsc_intutils_are_equal8(dec, msg, lens[i]) == false)
+					{
+						qsctest_print_safe("Failure! rcs_parallel_equality: decryption failure -RP3 \n");
+						status = false;
+					}
+
+					qsc_rcs_dispose(&ctx2);
+
+					if (status == false)
+					{
+						break;
+					}
+				}
+			}
+		}
+	}
+	else
+	{
+		status = false;
+	}
+
+	if (dec != NULL)
+	{
+		qsc_memutils_alloc_free(dec);
+	}
+
+	if (enc1 != NULL)
+	{
+		qsc_memutils_alloc_free(enc1);
+	}
+
+	if (enc2 != NULL)
+	{
+		qsc_memutils_alloc_free(enc2);
+	}
+
+	if (msg != NULL)
+	{
+		qsc_memutils_alloc_free(msg);
+	}
+
+	return status;
+}
+
+bool qsctest_rcs_seek()
+{
+	/* offset and length pairs, block-aligned and mid-block, including ranges that cross a block boundary */
+	const size_t rngs[][2] = { { 0U, 1U }, { 1U, 100U }, { 127U, 2U }, { 128U, 0x1000U }, { 129U, 0x10005U },
+		{ 0x20000U, 0x20007U }, { 0x20003U, 0x20004U }, { 0x40006U, 1U } };
+	const size_t klens[] = { QSC_RCS256_KEY_SIZE, QSC_RCS512_KEY_SIZE };
+	const size_t mlen = 0x40007U;
+	uint8_t key[QSC_RCS512_KEY_SIZE] = { 0 };
+	uint8_t ncopy[QSC_RCS_NONCE_SIZE] = { 0 };
+	uint8_t nonce[QSC_RCS_NONCE_SIZE] = { 0 };
+	uint8_t* dec;
+	uint8_t* enc;
+	uint8_t* msg;
+	uint8_t* otp;
+	qsc_rcs_state ctx;
+	bool status;
+
+	status = true;
+	dec = (uint8_t*)qsc_memutils_malloc(mlen);
+	enc = (uint8_t*)qsc_memutils_malloc(mlen + QSC_RCS512_MAC_SIZE);
+	msg = (uint8_t*)qsc_memutils_malloc(mlen);
+	otp = (uint8_t*)qsc_memutils_malloc(mlen + QSC_RCS512_MAC_SIZE);
+
+	if (dec != NULL && enc != NULL && msg != NULL && otp != NULL)
+	{
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(ncopy, sizeof(ncopy));
+		qsc_csp_generate(msg, mlen);
+
+		for (size_t k = 0U; k < sizeof(klens) / sizeof(klens[0]) && status == true; ++k)
+		{
+			qsc_rcs_keyparams kp = { key, klens[k], nonce, NULL, 0 };
+
+			/* one long sequential key-stream */
+			qsc_memutils_copy(nonce, ncopy, sizeof(nonce));
+			qsc_rcs_initialize(&ctx, &kp, true);
+
+			if (qsc_rcs_transform(&ctx, enc, msg, mlen) == false)
+			{
+				status = false;
+			}
+
+			qsc_rcs_dispose(&ctx);
+
+			for (size_t i = 0U; i < sizeof(rngs) / sizeof(rngs[0]) && status == true; ++i)
+			{
+				const size_t oft = rngs[i][0];
+				const size_t len = rngs[i][1];
+
+				/* the cipher-text of a range encrypted from the seek position */
+				qsc_rcs_initialize(&ctx, &kp, true);
+				qsc_rcs_seek(&ctx, ncopy, oft);
+
+				if (qsc_rcs_transform(&ctx, otp, msg + oft, len) == false ||
+					qsc_intutils_are_equal8(otp, enc + oft, len) == false)
+				{
+					qsctest_print_safe("Failure! rcs_seek: output does not match the sequential key-stream -RE1 \n");
+					status = false;
+				}
+
+				qsc_rcs_dispose(&ctx);
+
+				/* resume the partial block, then divide the rest between threads */
+				qsc_rcs_initialize(&ctx, &kp, true);
+				qsc_rcs_seek(&ctx, ncopy, oft);
+
+				if (qsc_rcs_transform_parallel(&ctx, otp, msg + oft, len, 3U) == false ||
+					qsc_intutils_are_equal8(otp, enc + oft, len) == false)
+				{
+					qsctest_print_safe("Failure! rcs_seek: parallel output does not match the sequential key-stream -RE2 \n");
+					status = false;
+				}
+
+				qsc_rcs_dispose(&ctx);
+
+				/* the range authenticates and decrypts as its own message */
+				qsc_rcs_initialize(&ctx, &kp, false);
+				qsc_rcs_seek(&ctx, ncopy, oft);
+
+				if (qsc_rcs_transform(&ctx, dec, otp, len) == false ||
+					qsc_intutils_are_equal8(dec, msg + oft, len) == false)
+				{
+					qsctest_print_safe("Failure! rcs_seek: range decryption failure -RE3 \n");
+					status = false;
+				}
+
+				qsc_rcs_dispose(&ctx);
+			}
+		}
+	}
+	else
+	{
+		status = false;
+	}
+
+	if (dec != NULL)
+	{
+		qsc_memutils_alloc_free(dec);
+	}
+
+	if (enc != NULL)
+	{
+		qsc_memutils_alloc_free(enc);
+	}
+
+	if (msg != NULL)
+	{
+		qsc_memutils_alloc_free(msg);
+	}
+
+	if (otp != NULL)
+	{
+		qsc_memutils_alloc_free(otp);
+	}
+
+	return status;
+}
+
 void qsctest_rcs_run()
 {
 	if (qsctest_rcs256_kat() == true)
@@ -504,4 +758,22 @@ void qsctest_rcs_run()
 	{
 		qsctest_print_safe("Failure! Failed the RCS-512 stress test. \n");
 	}
+
+	if (qsctest_rcs_parallel_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the RCS parallel transform equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the RCS parallel transform equality test. \n");
+	}
+
+	if (qsctest_rcs_seek() == true)
+	{
+		qsctest_print_safe("Success! Passed the RCS key-stream seek test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the RCS key-stream seek test. \n");
+	}
 }
@@ -138,6 +138,31 @@ bool qsctest_rcs512_stress_test(void);
  */
 bool qsctest_extended_cipher_test(void);
 
+/**
+ * \brief Tests the parallel RCS transform for equality with the sequential transform.
+ *
+ * \details
+ * Using both RCS-256 and RCS-512 keys and a range of thread counts, this function checks that
+ * qsc_rcs_transform_parallel produces the same cipher-text, MAC code, and final nonce as qsc_rcs_transform,
+ * including lengths shorter than one thread's share and lengths that are not a multiple of the block size,
+ * and that the parallel decryption recovers the message.
+ *
+ * \return Returns true if the outputs are equal; otherwise, false.
+ */
+bool qsctest_rcs_parallel_equality(void);
+
+/**
+ * \brief Tests positioning the RCS key-stream at a byte offset.
+ *
+ * \details
+ * Using both RCS-256 and RCS-512 keys, this function seeks to block-aligned and mid-block offsets, and compares
+ * each range, transformed sequentially and in parallel, with the same bytes of one long sequential transform.
+ * Each range is then decrypted as its own message.
+ *
+ * \return Returns true if every range matches; otherwise, false.
+ */
+bool qsctest_rcs_seek(void);
+
 #if defined(QSCTEST_RCS_WIDE_BLOCK_TESTS)
 /**
  * \brief Tests the RCS AVX functions for equality with sequential processing.
@@ -159,6 +184,8 @@ bool qsctest_rcs_wide_equality(void);
  * - The Known Answer Tests (KAT) for RCS-256 and RCS-512.
  * - Stress tests for both RCS-256 and RCS-512 using random inputs.
  * - The extended transform API test.
+ * - The parallel transform equality test.
+ * - The key-stream seek test.
  * - Optionally, wide block equality tests if enabled.
  *
  * Test results are printed to the console.
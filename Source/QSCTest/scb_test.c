@@ -69,6 +69,47 @@ bool qsctest_scb_512_kat()
 	return status;
 }
 
+bool qsctest_scb_parallel_kat()
+{
+	uint8_t exp[32] = { 0 };
+	uint8_t hash[32] = { 0 };
+	uint8_t seed[QSC_SCB_256_SEED_SIZE] = { 0 };
+	bool status;
+	qsc_scb_state ctx = { 0 };
+
+	qsctest_hex_to_bin("669F050E1EEE1EE50FC09AEF37D7374EF96B96F19723E6B2489016E1EAA0766E", exp, sizeof(exp));
+	qsctest_hex_to_bin("000102030405060708090A0B0C0D0E0F000102030405060708090A0B0C0D0E0F", seed, sizeof(seed));
+
+	status = true;
+
+	/* two passes over 1 MiB in 4 lanes, on a single thread */
+	qsc_scb_initialize_parallel(&ctx, seed, sizeof(seed), NULL, 0, 2, 1, 4, 1);
+	qsc_scb_generate(&ctx, hash, sizeof(hash));
+
+	if (qsc_intutils_are_equal8(hash, exp, sizeof(exp)) == false)
+	{
+		qsctest_print_safe("Failure! scb_parallel_kat: output does not match the expected answer -SK3 \n");
+		status = false;
+	}
+
+	qsc_scb_dispose(&ctx);
+
+	/* the thread count must not change the output */
+	qsc_memutils_clear(hash, sizeof(hash));
+	qsc_scb_initialize_parallel(&ctx, seed, sizeof(seed), NULL, 0, 2, 1, 4, 4);
+	qsc_scb_generate(&ctx, hash, sizeof(hash));
+
+	if (qsc_intutils_are_equal8(hash, exp, sizeof(exp)) == false)
+	{
+		qsctest_print_safe("Failure! scb_parallel_kat: multi-threaded output does not match the expected answer -SK4 \n");
+		status = false;
+	}
+
+	qsc_scb_dispose(&ctx);
+
+	return status;
+}
+
 void qsctest_scb_run()
 {
 	if (qsctest_scb_256_kat() == true)
@@ -88,4 +129,13 @@ void qsctest_scb_run()
 	{
 		qsctest_print_safe("Failure! Failed the SCB-512 known answer tests. \n");
 	}
+
+	if (qsctest_scb_parallel_kat() == true)
+	{
+		qsctest_print_safe("Success! Passed the SCB parallel mode known answer tests. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the SCB parallel mode known answer tests. \n");
+	}
 }
@@ -88,11 +88,22 @@ bool qsctest_scb_256_kat(void);
  */
 bool qsctest_scb_512_kat(void);
 
+/**
+ * \brief Tests the SCB parallel mode against a known answer.
+ *
+ * \details
+ * Derives 32 bytes with 4 lanes over 1 MiB and two passes, first on one thread and then on four threads,
+ * and compares both outputs to the expected value.
+ *
+ * \return Returns true if both outputs match; otherwise, false.
+ */
+bool qsctest_scb_parallel_kat(void);
+
 /**
  * \brief Runs all SCB tests.
  *
  * \details
- * This function executes the complete set of SCB tests, including both the SCB-256 and SCB-512 known
+ * This function executes the complete set of SCB tests, including the SCB-256, SCB-512, and parallel mode known
  * answer tests. It prints the results of each test to the console.
  */
 void qsctest_scb_run(void);
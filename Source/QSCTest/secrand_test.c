@@ -1,6 +1,7 @@
 #include "secrand_test.h"
 #include "testutils.h"
 #include "../QSC/acp.h"
+#include "../QSC/async.h"
 #include "../QSC/csg.h"
 #include "../QSC/csp.h"
 #include "../QSC/hcg.h"
@@ -11,6 +12,9 @@
 #include "../QSC/secrand.h"
 #include "../QSC/sysutils.h"
 
+#define SECRAND_TEST_THREADS 4U
+#define SECRAND_TEST_REGION (QSCTEST_SECRAND_SAMPLE_SIZE / SECRAND_TEST_THREADS)
+
 static const double Z_MAX = 6.0;
 static const double LOG_SQRT_PI = 0.5723649429247000870717135;
 static const double I_SQRT_PI = 0.5641895835477562869480795;
@@ -365,13 +369,97 @@ void qsctest_secrand_csg_evaluate()
 	qsctest_secrand_evaluate("CSG", smp, sizeof(smp));
 }
 
+bool qsctest_secrand_csg_wide_lanes()
+{
+	const size_t BLKLEN = QSC_KECCAK_256_RATE * QSC_CSG_WIDE_LANES;
+	uint8_t cust[sizeof(uint64_t)] = { 0 };
+	uint8_t info[4] = { 0x69, 0x6E, 0x66, 0x6F };
+	uint8_t lane[4 * QSC_KECCAK_256_RATE] = { 0 };
+	uint8_t seed[QSC_CSG_256_SEED_SIZE] = { 0 };
+	uint8_t exp[4 * QSC_KECCAK_256_RATE * QSC_CSG_WIDE_LANES] = { 0 };
+	uint8_t otp[4 * QSC_KECCAK_256_RATE * QSC_CSG_WIDE_LANES] = { 0 };
+	qsc_csg_wide_state ctx;
+	size_t len;
+	size_t pos;
+	bool res;
+
+	for (size_t i = 0; i < sizeof(seed); ++i)
+	{
+		seed[i] = (uint8_t)i;
+	}
+
+	/* lane i is cSHAKE-256 keyed with the seed, named with the info, and customized with the lane index;
+	   the output is one rate block from each lane in turn */
+	for (size_t i = 0; i < QSC_CSG_WIDE_LANES; ++i)
+	{
+		qsc_intutils_le64to8(cust, (uint64_t)i);
+		qsc_cshake256_compute(lane, sizeof(lane), seed, sizeof(seed), info, sizeof(info), cust, sizeof(cust));
+
+		for (size_t j = 0; j < 4; ++j)
+		{
+			qsc_memutils_copy(exp + (j * BLKLEN) + (i * QSC_KECCAK_256_RATE), lane + (j * QSC_KECCAK_256_RATE), QSC_KECCAK_256_RATE);
+		}
+	}
+
+	/* small requests through the cache, then a bulk request squeezed directly into the output */
+	qsc_csg_wide_initialize(&ctx, seed, sizeof(seed), info, sizeof(info), false);
+	pos = 0;
+	len = 1;
+
+	while (pos + len <= BLKLEN + 17)
+	{
+		qsc_csg_wide_generate(&ctx, otp + pos, len);
+		pos += len;
+		len = (len % 97) + 1;
+	}
+
+	qsc_csg_wide_generate(&ctx, otp + pos, sizeof(otp) - pos);
+	qsc_csg_wide_dispose(&ctx);
+
+	res = qsc_intutils_are_equal8(otp, exp, sizeof(exp));
+
+	return res;
+}
+
+void qsctest_secrand_csg_wide_evaluate()
+{
+	uint8_t seed[QSC_CSG_512_SEED_SIZE] = { 0 };
+	uint8_t smp[QSCTEST_SECRAND_SAMPLE_SIZE] = { 0 };
+	qsc_csg_wide_state ctx;
+
+	qsc_csp_generate(seed, sizeof(seed));
+
+	qsc_csg_wide_initialize(&ctx, seed, sizeof(seed), NULL, 0, true);
+	qsc_csg_wide_generate(&ctx, smp, sizeof(smp));
+	qsc_csg_wide_dispose(&ctx);
+
+	qsctest_secrand_evaluate("CSG wide", smp, sizeof(smp));
+}
+
 void qsctest_secrand_csp_evaluate()
 {
 	uint8_t smp[QSCTEST_SECRAND_SAMPLE_SIZE] = { 0 };
+	size_t len;
+	size_t pos;
 
 	qsc_csp_generate(smp, sizeof(smp));
 
 	qsctest_secrand_evaluate("CSP", smp, sizeof(smp));
+
+	/* small requests served from the batched pool, crossing refill boundaries */
+	qsc_memutils_clear(smp, sizeof(smp));
+	pos = 0U;
+	len = 1U;
+
+	while (pos < sizeof(smp))
+	{
+		len = qsc_intutils_min(len, sizeof(smp) - pos);
+		qsc_csp_pool_generate(smp + pos, len);
+		pos += len;
+		len = (len % 67U) + 1U;
+	}
+
+	qsctest_secrand_evaluate("CSP pool", smp, sizeof(smp));
 }
 
 void qsctest_secrand_hcg_evaluate()
@@ -572,6 +660,106 @@ bool qsctest_secrand_stress()
 	return res;
 }
 
+static void secrand_thread_task(void* state, size_t index)
+{
+	uint8_t* smp;
+	size_t len;
+	size_t pos;
+
+	smp = (uint8_t*)state + (index * SECRAND_TEST_REGION);
+	pos = 0U;
+	len = 1U;
+
+	/* mix small requests that cross cache boundaries with one bulk request */
+	while (pos + len < SECRAND_TEST_REGION / 2U)
+	{
+		qsc_secrand_generate(smp + pos, len);
+		pos += len;
+		len = (len % 61U) + 1U;
+	}
+
+	qsc_secrand_generate(smp + pos, SECRAND_TEST_REGION - pos);
+}
+
+static bool secrand_threads_check(const uint8_t* smp)
+{
+	const uint8_t zero[64U] = { 0 };
+	size_t i;
+	size_t j;
+	bool res;
+
+	res = true;
+
+	for (i = 0U; i < SECRAND_TEST_THREADS; ++i)
+	{
+		/* every thread must draw from an independent instance */
+		if (qsc_intutils_are_equal8(smp + (i * SECRAND_TEST_REGION), zero, sizeof(zero)) == true ||
+			qsc_intutils_are_equal8(smp + ((i + 1U) * SECRAND_TEST_REGION) - sizeof(zero), zero, sizeof(zero)) == true)
+		{
+			res = false;
+		}
+
+		for (j = i + 1U; j < SECRAND_TEST_THREADS; ++j)
+		{
+			if (qsc_intutils_are_equal8(smp + (i * SECRAND_TEST_REGION), smp + (j * SECRAND_TEST_REGION), 64U) == true)
+			{
+				res = false;
+			}
+		}
+	}
+
+	return res;
+}
+
+bool qsctest_secrand_threads()
+{
+	uint8_t seed[QSC_SECRAND_SEED_SIZE] = { 0 };
+	uint8_t* smp;
+	bool res;
+
+	res = false;
+	smp = (uint8_t*)qsc_memutils_malloc(QSCTEST_SECRAND_SAMPLE_SIZE);
+
+	if (smp != NULL)
+	{
+		qsc_acp_generate(seed, sizeof(seed));
+		qsc_secrand_initialize(seed, sizeof(seed), NULL, 0);
+
+		/* concurrent callers, each refilling its own cache */
+		qsc_memutils_clear(smp, QSCTEST_SECRAND_SAMPLE_SIZE);
+		qsc_async_parallel_for(&secrand_thread_task, smp, SECRAND_TEST_THREADS);
+		res = secrand_threads_check(smp);
+
+		if (res == true)
+		{
+			qsctest_secrand_evaluate("Secrand threads", smp, QSCTEST_SECRAND_SAMPLE_SIZE);
+		}
+
+		/* the same with the background refill thread swapping in reserve caches */
+		if (res == true && qsc_secrand_refill_start() == true)
+		{
+			qsc_memutils_clear(smp, QSCTEST_SECRAND_SAMPLE_SIZE);
+			qsc_async_parallel_for(&secrand_thread_task, smp, SECRAND_TEST_THREADS);
+			qsc_secrand_refill_stop();
+			res = secrand_threads_check(smp);
+
+			if (res == true)
+			{
+				qsctest_secrand_evaluate("Secrand refill", smp, QSCTEST_SECRAND_SAMPLE_SIZE);
+			}
+		}
+		else
+		{
+			res = false;
+		}
+
+		qsc_secrand_dispose();
+		qsc_memutils_alloc_free(smp);
+	}
+
+	return res;
+}
+
 void qsctest_secrand_run()
 {
 	qsctest_print_safe("*** Note: Random generators will ocassionally fail this test. \n");
@@ -587,6 +775,15 @@ void qsctest_secrand_run()
 		qsctest_print_safe("Failure! Failed the secrand stress and wellness test. \n");
 	}
 
+	if (qsctest_secrand_threads() == true)
+	{
+		qsctest_print_safe("Success! Passed the secrand multi-threaded generation test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the secrand multi-threaded generation test. \n");
+	}
+
 	qsctest_print_safe("*** Testing random entropy providers *** \n");
 	qsctest_secrand_acp_evaluate();
 	qsctest_secrand_csp_evaluate();
@@ -595,6 +792,17 @@ void qsctest_secrand_run()
 #endif
 	qsctest_print_safe("*** Testing deterministic random bit generators *** \n");
 	qsctest_secrand_csg_evaluate();
+	qsctest_secrand_csg_wide_evaluate();
+
+	if (qsctest_secrand_csg_wide_lanes() == true)
+	{
+		qsctest_print_safe("Success! Passed the wide CSG lane equivalence test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the wide CSG lane equivalence test. \n");
+	}
+
 	qsctest_secrand_hcg_evaluate();
 
 	qsctest_print_safe("*** Testing key derivation functions *** \n");
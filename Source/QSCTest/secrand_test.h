@@ -94,11 +94,31 @@ void qsctest_secrand_acp_evaluate(void);
  */
 void qsctest_secrand_csg_evaluate(void);
 
+/**
+ * \brief Tests that the wide CSG output matches its single-lane definition.
+ *
+ * \details
+ * Computes each lane as an independent cSHAKE-256 instance, interleaves the lane blocks, and compares the
+ * result with the output of the wide generator, drawn through both the cache and the bulk path.
+ *
+ * \return Returns true if the outputs match; otherwise, false.
+ */
+bool qsctest_secrand_csg_wide_lanes(void);
+
+/**
+ * \brief Evaluates the output of the wide multi-lane CSG DRBG.
+ *
+ * \details
+ * This function generates a random sample using the wide CSG DRBG and performs statistical evaluations on the sample.
+ */
+void qsctest_secrand_csg_wide_evaluate(void);
+
 /**
  * \brief Evaluates the output of the CSP random provider.
  *
  * \details
- * This function collects a random sample using the CSP provider and then assesses its statistical properties.
+ * This function collects a random sample using the CSP provider, and a second sample from many small
+ * requests to the batched CSP pool, and then assesses their statistical properties.
  */
 void qsctest_secrand_csp_evaluate(void);
 
@@ -140,12 +160,24 @@ void qsctest_secrand_scb_evaluate(void);
  */
 bool qsctest_secrand_stress(void);
 
+/**
+ * \brief Tests concurrent generation from several threads.
+ *
+ * \details
+ * Each thread fills its own region of a sample with small and bulk requests, first with the per-thread
+ * caches refilled inline and then with the background refill thread running. The regions must be non-zero
+ * and distinct, and each sample is passed to \c qsctest_secrand_evaluate().
+ *
+ * \return Returns true if both passes succeed; otherwise, false.
+ */
+bool qsctest_secrand_threads(void);
+
 /**
  * \brief Runs all secure random (entropy provider) tests.
  *
  * \details
  * This function executes a comprehensive test suite for secure random number generators and key derivation
- * functions. It first runs a stress test on the PRNG, then evaluates the output of various random providers,
+ * functions. It first runs the stress and multi-threaded tests on the PRNG, then evaluates the output of various random providers,
  * including:
  * - ACP and CSP (and optionally RDP if available)
  * - Deterministic random bit generators (CSG and HCG)
@@ -1,6 +1,7 @@
 #include "sha2_test.h"
 #include "testutils.h"
 #include "../QSC/intutils.h"
+#include "../QSC/memutils.h"
 #include "../QSC/sha2.h"
 #include <stdio.h>
 
@@ -408,6 +409,155 @@ bool qsctest_hmac_512_kat()
 	return status;
 }
 
+bool qsctest_hmac_prefix_equality()
+{
+	const size_t keylens[6] = { 0, 20, 64, 100, 128, 200 };
+	uint8_t exp[QSC_SHA2_512_HASH_SIZE] = { 0 };
+	uint8_t inr[QSC_SHA2_512_HASH_SIZE] = { 0 };
+	uint8_t kpad[QSC_SHA2_512_RATE] = { 0 };
+	uint8_t key[200] = { 0 };
+	uint8_t msg[300] = { 0 };
+	uint8_t otp[QSC_SHA2_512_HASH_SIZE] = { 0 };
+	qsc_hmac256_prefix_state pfx256;
+	qsc_hmac512_prefix_state pfx512;
+	qsc_hmac256_state hctx256;
+	qsc_hmac512_state hctx512;
+	qsc_sha256_state sctx256;
+	qsc_sha512_state sctx512;
+	size_t i;
+	size_t klen;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < sizeof(key); ++i)
+	{
+		key[i] = (uint8_t)(i * 3U);
+	}
+
+	for (i = 0; i < sizeof(msg); ++i)
+	{
+		msg[i] = (uint8_t)(i * 5U);
+	}
+
+	for (size_t k = 0; k < 6; ++k)
+	{
+		klen = keylens[k];
+		qsc_hmac256_prefix_initialize(&pfx256, key, klen);
+		qsc_hmac512_prefix_initialize(&pfx512, key, klen);
+
+		/* one prefix serves every message; the reference is built from the hash functions directly */
+		for (size_t mlen = 0; mlen <= sizeof(msg); mlen += 23)
+		{
+			/* HMAC(SHA2-256) */
+			qsc_memutils_clear(kpad, sizeof(kpad));
+
+			if (klen > QSC_SHA2_256_RATE)
+			{
+				qsc_sha256_compute(kpad, key, klen);
+			}
+			else
+			{
+				qsc_memutils_copy(kpad, key, klen);
+			}
+
+			qsc_memutils_xorv(kpad, 0x36, QSC_SHA2_256_RATE);
+			qsc_sha256_initialize(&sctx256);
+			qsc_sha256_update(&sctx256, kpad, QSC_SHA2_256_RATE);
+			qsc_sha256_update(&sctx256, msg, mlen);
+			qsc_sha256_finalize(&sctx256, inr);
+			qsc_memutils_xorv(kpad, 0x36 ^ 0x5C, QSC_SHA2_256_RATE);
+			qsc_sha256_initialize(&sctx256);
+			qsc_sha256_update(&sctx256, kpad, QSC_SHA2_256_RATE);
+			qsc_sha256_update(&sctx256, inr, QSC_SHA2_256_HASH_SIZE);
+			qsc_sha256_finalize(&sctx256, exp);
+
+			qsc_hmac256_prefix_compute(&pfx256, otp, msg, mlen);
+
+			if (qsc_intutils_are_equal8(exp, otp, QSC_SHA2_256_HASH_SIZE) == false)
+			{
+				qsctest_print_safe("Failure! hmac_prefix_equality: output does not match the known answer -HP1 \n");
+				status = false;
+			}
+
+			/* incremental updates from a cloned state */
+			qsc_hmac256_prefix_clone(&pfx256, &hctx256);
+			qsc_hmac256_update(&hctx256, msg, mlen / 2);
+			qsc_hmac256_update(&hctx256, msg + (mlen / 2), mlen - (mlen / 2));
+			qsc_hmac256_finalize(&hctx256, otp);
+
+			if (qsc_intutils_are_equal8(exp, otp, QSC_SHA2_256_HASH_SIZE) == false)
+			{
+				qsctest_print_safe("Failure! hmac_prefix_equality: output does not match the known answer -HP2 \n");
+				status = false;
+			}
+
+			qsc_hmac256_compute(otp, msg, mlen, key, klen);
+
+			if (qsc_intutils_are_equal8(exp, otp, QSC_SHA2_256_HASH_SIZE) == false)
+			{
+				qsctest_print_safe("Failure! hmac_prefix_equality: output does not match the known answer -HP3 \n");
+				status = false;
+			}
+
+			/* HMAC(SHA2-512) */
+			qsc_memutils_clear(kpad, sizeof(kpad));
+
+			if (klen > QSC_SHA2_512_RATE)
+			{
+				qsc_sha512_compute(kpad, key, klen);
+			}
+			else
+			{
+				qsc_memutils_copy(kpad, key, klen);
+			}
+
+			qsc_memutils_xorv(kpad, 0x36, QSC_SHA2_512_RATE);
+			qsc_sha512_initialize(&sctx512);
+			qsc_sha512_update(&sctx512, kpad, QSC_SHA2_512_RATE);
+			qsc_sha512_update(&sctx512, msg, mlen);
+			qsc_sha512_finalize(&sctx512, inr);
+			qsc_memutils_xorv(kpad, 0x36 ^ 0x5C, QSC_SHA2_512_RATE);
+			qsc_sha512_initialize(&sctx512);
+			qsc_sha512_update(&sctx512, kpad, QSC_SHA2_512_RATE);
+			qsc_sha512_update(&sctx512, inr, QSC_SHA2_512_HASH_SIZE);
+			qsc_sha512_finalize(&sctx512, exp);
+
+			qsc_hmac512_prefix_compute(&pfx512, otp, msg, mlen);
+
+			if (qsc_intutils_are_equal8(exp, otp, QSC_SHA2_512_HASH_SIZE) == false)
+			{
+				qsctest_print_safe("Failure! hmac_prefix_equality: output does not match the known answer -HP4 \n");
+				status = false;
+			}
+
+			qsc_hmac512_prefix_clone(&pfx512, &hctx512);
+			qsc_hmac512_update(&hctx512, msg, mlen / 2);
+			qsc_hmac512_update(&hctx512, msg + (mlen / 2), mlen - (mlen / 2));
+			qsc_hmac512_finalize(&hctx512, otp);
+
+			if (qsc_intutils_are_equal8(exp, otp, QSC_SHA2_512_HASH_SIZE) == false)
+			{
+				qsctest_print_safe("Failure! hmac_prefix_equality: output does not match the known answer -HP5 \n");
+				status = false;
+			}
+
+			qsc_hmac512_compute(otp, msg, mlen, key, klen);
+
+			if (qsc_intutils_are_equal8(exp, otp, QSC_SHA2_512_HASH_SIZE) == false)
+			{
+				qsctest_print_safe("Failure! hmac_prefix_equality: output does not match the known answer -HP6 \n");
+				status = false;
+			}
+		}
+
+		qsc_hmac256_prefix_dispose(&pfx256);
+		qsc_hmac512_prefix_dispose(&pfx512);
+	}
+
+	return status;
+}
+
 bool qsctest_sha2_256_kat()
 {
 	uint8_t exp0[QSC_SHA2_256_HASH_SIZE] = { 0 };
@@ -833,4 +983,13 @@ void qsctest_sha2_run()
 	{
 		qsctest_print_safe("Failure! Failed the HMAC(SHA2-512) KAT test. \n");
 	}
+
+	if (qsctest_hmac_prefix_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the HMAC keyed prefix equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the HMAC keyed prefix equality test. \n");
+	}
 }
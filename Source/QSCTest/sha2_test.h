@@ -128,6 +128,17 @@ bool qsctest_hmac_256_kat(void);
  */
 bool qsctest_hmac_512_kat(void);
 
+/**
+ * \brief Tests the keyed HMAC prefix functions against HMAC built directly from the SHA2 hash functions.
+ *
+ * \details
+ * Uses short, block-sized, and hashed (longer than the rate) keys, reuses one prefix across many messages,
+ * and checks the prefix compute, clone with incremental updates, and the one-call HMAC functions.
+ *
+ * \return Returns true if all outputs match the reference; otherwise, false.
+ */
+bool qsctest_hmac_prefix_equality(void);
+
 /**
  * \brief Tests the SHA2-256 message digest algorithm.
  *
@@ -1,6 +1,7 @@
 #include "sha3_test.h"
 #include "testutils.h"
 #include "../QSC/intutils.h"
+#include "../QSC/memutils.h"
 #include "../QSC/sha3.h"
 
 bool qsctest_sha3_256_kat()
@@ -1096,6 +1097,555 @@ bool qsctest_kpa_512_kat()
 	return status;
 }
 
+bool qsctest_cshake_prefix_equality()
+{
+	const qsc_keccak_rate rates[3] = { qsc_keccak_rate_128, qsc_keccak_rate_256, qsc_keccak_rate_512 };
+	uint8_t cst[16] = { 0 };
+	uint8_t exp[200] = { 0 };
+	uint8_t key[64] = { 0 };
+	uint8_t name[4] = { 0x51, 0x53, 0x43, 0x31 };
+	uint8_t otp[200] = { 0 };
+	qsc_cshake_prefix_state pfx;
+	size_t i;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < sizeof(key); ++i)
+	{
+		key[i] = (uint8_t)i;
+	}
+
+	for (i = 0; i < sizeof(cst); ++i)
+	{
+		cst[i] = (uint8_t)(0xA0U + i);
+	}
+
+	for (size_t r = 0; r < 3; ++r)
+	{
+		qsc_cshake_prefix_initialize(&pfx, rates[r], name, sizeof(name), cst, sizeof(cst));
+
+		/* vary the key length and the output length, including multi-block output */
+		for (size_t klen = 16; klen <= sizeof(key); klen += 16)
+		{
+			if (rates[r] == qsc_keccak_rate_128)
+			{
+				qsc_cshake128_compute(exp, sizeof(exp), key, klen, name, sizeof(name), cst, sizeof(cst));
+			}
+			else if (rates[r] == qsc_keccak_rate_256)
+			{
+				qsc_cshake256_compute(exp, sizeof(exp), key, klen, name, sizeof(name), cst, sizeof(cst));
+			}
+			else
+			{
+				qsc_cshake512_compute(exp, sizeof(exp), key, klen, name, sizeof(name), cst, sizeof(cst));
+			}
+
+			qsc_cshake_prefix_compute(&pfx, otp, sizeof(otp), key, klen);
+
+			if (qsc_intutils_are_equal8(exp, otp, sizeof(exp)) == false)
+			{
+				qsctest_print_safe("Failure! qsctest_cshake_prefix_equality: output does not match the known answer -CP1 \n");
+				status = false;
+			}
+		}
+
+		qsc_cshake_prefix_dispose(&pfx);
+	}
+
+	return status;
+}
+
+bool qsctest_keccak_permutation_equality()
+{
+	uint64_t exp[QSC_KECCAK_STATE_SIZE] = { 0 };
+	uint64_t otp[QSC_KECCAK_STATE_SIZE] = { 0 };
+	size_t i;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		exp[i] = 0x9E3779B97F4A7C15ULL * (uint64_t)(i + 1);
+		otp[i] = exp[i];
+	}
+
+	/* chain the permutations so every lane and round constant is exercised */
+	for (i = 0; i < 1000; ++i)
+	{
+		qsc_keccak_permute_p1600u(exp);
+		qsc_keccak_permute_p1600c(otp, QSC_KECCAK_PERMUTATION_ROUNDS);
+
+		if (qsc_intutils_are_equal8((const uint8_t*)exp, (const uint8_t*)otp, sizeof(exp)) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccak_permutation_equality: output does not match the known answer -KP1 \n");
+			status = false;
+			break;
+		}
+	}
+
+	return status;
+}
+
+static void keccakx_lane_expected(uint8_t* output, size_t outlen, size_t mode, const uint8_t* message, size_t msglen,
+	const uint8_t* name, size_t namelen, const uint8_t* custom, size_t custlen)
+{
+	if (mode == 0)
+	{
+		qsc_sha3_compute256(output, message, msglen);
+	}
+	else if (mode == 1)
+	{
+		qsc_shake128_compute(output, outlen, message, msglen);
+	}
+	else
+	{
+		qsc_cshake256_compute(output, outlen, message, msglen, name, namelen, custom, custlen);
+	}
+}
+
+bool qsctest_sha3x_equality()
+{
+	const size_t lens[7] = { 0, 1, 135, 136, 137, 300, 1000 };
+	uint8_t cst[20] = { 0 };
+	uint8_t exp[200] = { 0 };
+	/* one byte longer than the longest length, the cSHAKE inputs hash lens[k] + 1 bytes */
+	uint8_t msg[8][1001] = { 0 };
+	uint8_t name[4] = { 0x51, 0x53, 0x43, 0x31 };
+	uint8_t otp[8][200] = { 0 };
+	size_t clen;
+	size_t i;
+	size_t j;
+	size_t olen;
+	bool status;
+
+	status = true;
+
+	for (j = 0; j < 8; ++j)
+	{
+		for (i = 0; i < sizeof(msg[j]); ++i)
+		{
+			msg[j][i] = (uint8_t)((i * 31U) + (j * 7U) + 1U);
+		}
+	}
+
+	for (i = 0; i < sizeof(cst); ++i)
+	{
+		cst[i] = (uint8_t)(0xA0U + i);
+	}
+
+	for (size_t k = 0; k < 7; ++k)
+	{
+		qsc_sha3_256x4(otp[0], otp[1], otp[2], otp[3], msg[0], msg[1], msg[2], msg[3], lens[k]);
+
+		for (j = 0; j < 4; ++j)
+		{
+			qsc_sha3_compute256(exp, msg[j], lens[k]);
+
+			if (qsc_intutils_are_equal8(exp, otp[j], QSC_SHA3_256_HASH_SIZE) == false)
+			{
+				qsctest_print_safe("Failure! qsctest_sha3x_equality: output does not match the known answer -SX1 \n");
+				status = false;
+			}
+		}
+
+		qsc_sha3_256x8(otp[0], otp[1], otp[2], otp[3], otp[4], otp[5], otp[6], otp[7],
+			msg[0], msg[1], msg[2], msg[3], msg[4], msg[5], msg[6], msg[7], lens[k]);
+
+		for (j = 0; j < 8; ++j)
+		{
+			qsc_sha3_compute256(exp, msg[j], lens[k]);
+
+			if (qsc_intutils_are_equal8(exp, otp[j], QSC_SHA3_256_HASH_SIZE) == false)
+			{
+				qsctest_print_safe("Failure! qsctest_sha3x_equality: output does not match the known answer -SX2 \n");
+				status = false;
+			}
+		}
+
+		/* single-block and multi-block outputs, with and without a customization string */
+		olen = (k % 2 == 0) ? 32 : sizeof(exp);
+		clen = (k % 3 == 0) ? 0 : sizeof(cst);
+
+		qsc_cshake_256x4(otp[0], otp[1], otp[2], otp[3], olen, msg[0], msg[1], msg[2], msg[3], lens[k] + 1,
+			name, sizeof(name), cst, clen);
+
+		for (j = 0; j < 4; ++j)
+		{
+			qsc_cshake256_compute(exp, olen, msg[j], lens[k] + 1, name, sizeof(name), cst, clen);
+
+			if (qsc_intutils_are_equal8(exp, otp[j], olen) == false)
+			{
+				qsctest_print_safe("Failure! qsctest_sha3x_equality: output does not match the known answer -SX3 \n");
+				status = false;
+			}
+		}
+
+		qsc_cshake_256x8(otp[0], otp[1], otp[2], otp[3], otp[4], otp[5], otp[6], otp[7], olen,
+			msg[0], msg[1], msg[2], msg[3], msg[4], msg[5], msg[6], msg[7], lens[k] + 1, name, sizeof(name), cst, clen);
+
+		for (j = 0; j < 8; ++j)
+		{
+			qsc_cshake256_compute(exp, olen, msg[j], lens[k] + 1, name, sizeof(name), cst, clen);
+
+			if (qsc_intutils_are_equal8(exp, otp[j], olen) == false)
+			{
+				qsctest_print_safe("Failure! qsctest_sha3x_equality: output does not match the known answer -SX4 \n");
+				status = false;
+			}
+		}
+	}
+
+	return status;
+}
+
+bool qsctest_keccakx_incremental_equality()
+{
+	const qsc_keccak_rate rates[3] = { qsc_keccak_rate_256, qsc_keccak_rate_128, qsc_keccak_rate_256 };
+	uint8_t cst[20] = { 0 };
+	uint8_t exp[300] = { 0 };
+	uint8_t msg[8][1200] = { 0 };
+	uint8_t name[4] = { 0x51, 0x53, 0x43, 0x31 };
+	uint8_t otp[8][300] = { 0 };
+	uint8_t* outs[QSC_KECCAKX_LANES_MAX] = { 0 };
+	const uint8_t* inps[QSC_KECCAKX_LANES_MAX] = { 0 };
+	size_t ilen[QSC_KECCAKX_LANES_MAX] = { 0 };
+	size_t mlen[QSC_KECCAKX_LANES_MAX] = { 0 };
+	size_t off[QSC_KECCAKX_LANES_MAX] = { 0 };
+	qsc_keccakx_state ctx;
+	size_t blen;
+	size_t olen;
+	size_t i;
+	size_t j;
+	bool more;
+	bool status;
+
+	status = true;
+
+	for (j = 0; j < 8; ++j)
+	{
+		for (i = 0; i < sizeof(msg[j]); ++i)
+		{
+			msg[j][i] = (uint8_t)((i * 13U) + (j * 101U) + 5U);
+		}
+	}
+
+	for (i = 0; i < sizeof(cst); ++i)
+	{
+		cst[i] = (uint8_t)(0xC0U + i);
+	}
+
+	for (size_t lanes = 4; lanes <= QSC_KECCAKX_LANES_MAX; lanes += 4)
+	{
+		for (size_t mode = 0; mode < 3; ++mode)
+		{
+			if (mode == 0)
+			{
+				qsc_keccakx_initialize(&ctx, lanes, rates[mode], QSC_KECCAK_SHA3_DOMAIN_ID);
+				olen = QSC_SHA3_256_HASH_SIZE;
+			}
+			else if (mode == 1)
+			{
+				qsc_keccakx_initialize(&ctx, lanes, rates[mode], QSC_KECCAK_SHAKE_DOMAIN_ID);
+				olen = sizeof(exp);
+			}
+			else
+			{
+				qsc_keccakx_initialize_custom(&ctx, lanes, rates[mode], name, sizeof(name), cst, sizeof(cst));
+				olen = 100;
+			}
+
+			/* single-lane updates in turn, with a different chunk length in every lane */
+			for (j = 0; j < lanes; ++j)
+			{
+				mlen[j] = ((j * 173U) + 59U) % sizeof(msg[j]);
+				off[j] = 0;
+			}
+
+			do
+			{
+				more = false;
+
+				for (j = 0; j < lanes; ++j)
+				{
+					blen = qsc_intutils_min(((j * 37U) + 11U) % 200U + 1U, mlen[j] - off[j]);
+					qsc_keccakx_lane_update(&ctx, j, msg[j] + off[j], blen);
+					off[j] += blen;
+					more = (more == true || off[j] < mlen[j]);
+				}
+			}
+			while (more == true);
+
+			for (j = 0; j < lanes; ++j)
+			{
+				qsc_keccakx_lane_finalize(&ctx, j, otp[j], olen);
+				keccakx_lane_expected(exp, olen, mode, msg[j], mlen[j], name, sizeof(name), cst, sizeof(cst));
+
+				if (qsc_intutils_are_equal8(exp, otp[j], olen) == false)
+				{
+					qsctest_print_safe("Failure! qsctest_keccakx_incremental_equality: output does not match the known answer -IX1 \n");
+					status = false;
+				}
+			}
+
+			/* refilled lanes, one multi-lane update with ragged lengths and a shared finalize */
+			for (j = 0; j < lanes; ++j)
+			{
+				mlen[j] = ((j * 211U) + 7U) % sizeof(msg[j]);
+				inps[j] = msg[j];
+				ilen[j] = mlen[j];
+				outs[j] = otp[j];
+			}
+
+			qsc_keccakx_update(&ctx, inps, ilen);
+			qsc_keccakx_finalize(&ctx, outs, olen);
+
+			for (j = 0; j < lanes; ++j)
+			{
+				keccakx_lane_expected(exp, olen, mode, msg[j], mlen[j], name, sizeof(name), cst, sizeof(cst));
+
+				if (qsc_intutils_are_equal8(exp, otp[j], olen) == false)
+				{
+					qsctest_print_safe("Failure! qsctest_keccakx_incremental_equality: output does not match the known answer -IX2 \n");
+					status = false;
+				}
+			}
+
+			/* mixed updates; the odd lanes finish early on their own, then the even lanes finish together */
+			for (j = 0; j < lanes; ++j)
+			{
+				mlen[j] = ((j * 97U) + 300U) % sizeof(msg[j]);
+				inps[j] = msg[j];
+				ilen[j] = mlen[j] / 2;
+				outs[j] = ((j & 1U) == 0) ? otp[j] : NULL;
+			}
+
+			qsc_keccakx_update(&ctx, inps, ilen);
+
+			for (j = 1; j < lanes; j += 2)
+			{
+				qsc_keccakx_lane_update(&ctx, j, msg[j] + ilen[j], mlen[j] - ilen[j]);
+				qsc_keccakx_lane_finalize(&ctx, j, otp[j], olen);
+			}
+
+			for (j = 0; j < lanes; j += 2)
+			{
+				qsc_keccakx_lane_update(&ctx, j, msg[j] + ilen[j], mlen[j] - ilen[j]);
+			}
+
+			qsc_keccakx_finalize(&ctx, outs, olen);
+
+			for (j = 0; j < lanes; ++j)
+			{
+				keccakx_lane_expected(exp, olen, mode, msg[j], mlen[j], name, sizeof(name), cst, sizeof(cst));
+
+				if (qsc_intutils_are_equal8(exp, otp[j], olen) == false)
+				{
+					qsctest_print_safe("Failure! qsctest_keccakx_incremental_equality: output does not match the known answer -IX3 \n");
+					status = false;
+				}
+			}
+
+			qsc_keccakx_dispose(&ctx);
+		}
+	}
+
+	return status;
+}
+
+bool qsctest_kmac_prefix_equality()
+{
+	const qsc_keccak_rate rates[3] = { qsc_keccak_rate_128, qsc_keccak_rate_256, qsc_keccak_rate_512 };
+	const size_t outlens[2] = { 32, 200 };
+	uint8_t cst[16] = { 0 };
+	uint8_t key[32] = { 0 };
+	uint8_t msg[400] = { 0 };
+	uint8_t exp[40][200] = { 0 };
+	uint8_t otp[40][200] = { 0 };
+	uint8_t* outputs[40] = { 0 };
+	const uint8_t* messages[40] = { 0 };
+	size_t msglens[40] = { 0 };
+	qsc_kmac_prefix_state pfx;
+	size_t i;
+	size_t olen;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < sizeof(key); ++i)
+	{
+		key[i] = (uint8_t)i;
+	}
+
+	for (i = 0; i < sizeof(cst); ++i)
+	{
+		cst[i] = (uint8_t)(0xA0U + i);
+	}
+
+	for (i = 0; i < sizeof(msg); ++i)
+	{
+		msg[i] = (uint8_t)(i * 7U);
+	}
+
+	for (i = 0; i < 40; ++i)
+	{
+		outputs[i] = otp[i];
+		messages[i] = msg + i;
+		/* runs of equal lengths, lengths that straddle a rate boundary, and empty messages */
+		msglens[i] = (i < 16) ? 48 : (i < 24) ? (i * 9) % 360 : (i < 28) ? 0 : 160 + (i % 12);
+	}
+
+	for (size_t r = 0; r < 3; ++r)
+	{
+		qsc_kmac_prefix_initialize(&pfx, rates[r], key, sizeof(key), cst, sizeof(cst));
+
+		for (size_t o = 0; o < 2; ++o)
+		{
+			olen = outlens[o];
+
+			for (i = 0; i < 40; ++i)
+			{
+				if (rates[r] == qsc_keccak_rate_128)
+				{
+					qsc_kmac128_compute(exp[i], olen, messages[i], msglens[i], key, sizeof(key), cst, sizeof(cst));
+				}
+				else if (rates[r] == qsc_keccak_rate_256)
+				{
+					qsc_kmac256_compute(exp[i], olen, messages[i], msglens[i], key, sizeof(key), cst, sizeof(cst));
+				}
+				else
+				{
+					qsc_kmac512_compute(exp[i], olen, messages[i], msglens[i], key, sizeof(key), cst, sizeof(cst));
+				}
+
+				qsc_kmac_prefix_compute(&pfx, otp[i], olen, messages[i], msglens[i]);
+
+				if (qsc_intutils_are_equal8(exp[i], otp[i], olen) == false)
+				{
+					qsctest_print_safe("Failure! qsctest_kmac_prefix_equality: output does not match the known answer -KR1 \n");
+					status = false;
+				}
+			}
+
+			qsc_memutils_clear((uint8_t*)otp, sizeof(otp));
+			qsc_kmac_prefix_compute_batch(&pfx, outputs, olen, messages, msglens, 40);
+
+			for (i = 0; i < 40; ++i)
+			{
+				if (qsc_intutils_are_equal8(exp[i], otp[i], olen) == false)
+				{
+					qsctest_print_safe("Failure! qsctest_kmac_prefix_equality: batch output does not match the known answer -KR2 \n");
+					status = false;
+				}
+			}
+		}
+
+		qsc_kmac_prefix_dispose(&pfx);
+	}
+
+	return status;
+}
+
+bool qsctest_keccak_batch_equality()
+{
+	const size_t outlens[2] = { 32, 300 };
+	uint8_t cst[16] = { 0 };
+	uint8_t key[32] = { 0 };
+	uint8_t msg[3200] = { 0 };
+	uint8_t exp[96][300] = { 0 };
+	uint8_t otp[96][300] = { 0 };
+	uint8_t* outputs[96] = { 0 };
+	const uint8_t* messages[96] = { 0 };
+	size_t msglens[96] = { 0 };
+	size_t i;
+	size_t olen;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < sizeof(key); ++i)
+	{
+		key[i] = (uint8_t)i;
+	}
+
+	for (i = 0; i < sizeof(cst); ++i)
+	{
+		cst[i] = (uint8_t)(0xB0U + i);
+	}
+
+	for (i = 0; i < sizeof(msg); ++i)
+	{
+		msg[i] = (uint8_t)(i * 13U);
+	}
+
+	for (i = 0; i < 96; ++i)
+	{
+		outputs[i] = otp[i];
+		messages[i] = msg + i;
+		/* equal length leaves, empty messages, more distinct block counts than there are buckets,
+		   and lengths on either side of the rate boundary */
+		msglens[i] = (i < 32) ? 64 : (i < 38) ? 0 : (i < 86) ? (i * 131) % 3000 : 134 + (i % 5);
+	}
+
+	for (i = 0; i < 96; ++i)
+	{
+		qsc_sha3_compute256(exp[i], messages[i], msglens[i]);
+	}
+
+	qsc_sha3_compute256_batch(outputs, messages, msglens, 96);
+
+	for (i = 0; i < 96; ++i)
+	{
+		if (qsc_intutils_are_equal8(exp[i], otp[i], QSC_SHA3_256_HASH_SIZE) == false)
+		{
+			qsctest_print_safe("Failure! qsctest_keccak_batch_equality: output does not match the known answer -KB1 \n");
+			status = false;
+		}
+	}
+
+	for (size_t o = 0; o < 2; ++o)
+	{
+		olen = outlens[o];
+
+		for (i = 0; i < 96; ++i)
+		{
+			qsc_shake256_compute(exp[i], olen, messages[i], msglens[i]);
+		}
+
+		qsc_memutils_clear((uint8_t*)otp, sizeof(otp));
+		qsc_shake256_batch(outputs, olen, messages, msglens, 96);
+
+		for (i = 0; i < 96; ++i)
+		{
+			if (qsc_intutils_are_equal8(exp[i], otp[i], olen) == false)
+			{
+				qsctest_print_safe("Failure! qsctest_keccak_batch_equality: output does not match the known answer -KB2 \n");
+				status = false;
+			}
+		}
+
+		for (i = 0; i < 96; ++i)
+		{
+			qsc_kmac256_compute(exp[i], olen, messages[i], msglens[i], key, sizeof(key), cst, sizeof(cst));
+		}
+
+		qsc_memutils_clear((uint8_t*)otp, sizeof(otp));
+		qsc_kmac256_batch(outputs, olen, messages, msglens, 96, key, sizeof(key), cst, sizeof(cst));
+
+		for (i = 0; i < 96; ++i)
+		{
+			if (qsc_intutils_are_equal8(exp[i], otp[i], olen) == false)
+			{
+				qsctest_print_safe("Failure! qsctest_keccak_batch_equality: output does not match the known answer -KB3 \n");
+				status = false;
+			}
+		}
+	}
+
+	return status;
+}
+
 #if defined(QSC_SYSTEM_HAS_AVX2)
 bool qsctest_kmac128x4_equality()
 {
@@ -2284,6 +2834,60 @@ void qsctest_sha3_run()
 		qsctest_print_safe("Failure! Failed the KPA-512 KAT test. \n");
 	}
 
+	if (qsctest_cshake_prefix_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the cSHAKE prefix equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the cSHAKE prefix equality test. \n");
+	}
+
+	if (qsctest_kmac_prefix_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the KMAC prefix and batch equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the KMAC prefix and batch equality test. \n");
+	}
+
+	if (qsctest_keccak_batch_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the SHA3-256, SHAKE-256, and KMAC-256 batch equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the SHA3-256, SHAKE-256, and KMAC-256 batch equality test. \n");
+	}
+
+	if (qsctest_keccak_permutation_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the Keccak permutation equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Keccak permutation equality test. \n");
+	}
+
+	if (qsctest_sha3x_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the SHA3-256 and cSHAKE-256 x4 and x8 equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the SHA3-256 and cSHAKE-256 x4 and x8 equality test. \n");
+	}
+
+	if (qsctest_keccakx_incremental_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the incremental multi-lane Keccak equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the incremental multi-lane Keccak equality test. \n");
+	}
+
 #if defined(QSC_SYSTEM_HAS_AVX2)
 
 	if (qsctest_kmac128x4_equality() == true)
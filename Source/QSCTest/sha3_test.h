@@ -228,6 +228,59 @@ bool qsctest_kpa_256_kat(void);
  */
 bool qsctest_kpa_512_kat(void);
 
+/**
+ * \brief Tests the cSHAKE prefix functions for equality with the one-call cSHAKE functions.
+ *
+ * \return Returns true if the prefix outputs match for every rate and key length; otherwise, false.
+ */
+bool qsctest_cshake_prefix_equality(void);
+
+/**
+ * \brief Tests the keyed KMAC prefix and batch functions for equality with the one-call KMAC functions.
+ *
+ * \details
+ * Uses runs of equal and mixed message lengths, empty messages, and single and multi-block outputs at every rate.
+ *
+ * \return Returns true if the prefix and batch outputs match; otherwise, false.
+ */
+bool qsctest_kmac_prefix_equality(void);
+
+/**
+ * \brief Tests the SHA3-256, SHAKE-256, and KMAC-256 batch functions for equality with the one-call functions.
+ *
+ * \details
+ * Uses runs of equal length messages, empty messages, more distinct block counts than the scheduler has buckets,
+ * and single and multi-block outputs.
+ *
+ * \return Returns true if the batch outputs match; otherwise, false.
+ */
+bool qsctest_keccak_batch_equality(void);
+
+/**
+ * \brief Tests the runtime-selected compact Keccak permutation for equality with the unrolled reference permutation.
+ *
+ * \return Returns true if the permuted states match; otherwise, false.
+ */
+bool qsctest_keccak_permutation_equality(void);
+
+/**
+ * \brief Tests the SHA3-256 and cSHAKE-256 x4 and x8 functions for equality with the sequential functions.
+ *
+ * \return Returns true if the parallel outputs match; otherwise, false.
+ */
+bool qsctest_sha3x_equality(void);
+
+/**
+ * \brief Tests the incremental multi-lane Keccak functions for equality with the sequential functions.
+ *
+ * \details
+ * Feeds 4 and 8 lanes of SHA3-256, SHAKE-128, and cSHAKE-256 with ragged chunk lengths, using single-lane and
+ * multi-lane updates and finalizers, and refills every lane with new messages.
+ *
+ * \return Returns true if every lane output matches; otherwise, false.
+ */
+bool qsctest_keccakx_incremental_equality(void);
+
 #if defined(QSC_SYSTEM_HAS_AVX2)
 /**
  * \brief Tests the KMAC-128 AVX2 intrinsics implementation for equality with the sequential version.
@@ -0,0 +1,576 @@
+#include "socket_test.h"
+#include "../QSC/async.h"
+#include "../QSC/csp.h"
+#include "../QSC/fileutils.h"
+#include "../QSC/intutils.h"
+#include "../QSC/ipinfo.h"
+#include "../QSC/memutils.h"
+#include "../QSC/socketbase.h"
+#include "../QSC/socketclient.h"
+#include "../QSC/socketreactor.h"
+#include "../QSC/socketserver.h"
+#include "testutils.h"
+
+#define SOCKET_TEST_CLIENTS 8U
+#define SOCKET_TEST_MESSAGE 3000U
+#define SOCKET_TEST_REACTOR_PORT 38563U
+#define SOCKET_TEST_VECTOR_PORT 38564U
+#define SOCKET_TEST_DATAGRAM_PORT 38565U
+#define SOCKET_TEST_DATAGRAMS 10U
+#define SOCKET_TEST_FILE_PATH "socket_test.tmp"
+#define SOCKET_TEST_FILE_PORT 38566U
+#define SOCKET_TEST_FILE_SIZE 0x100007U
+#define SOCKET_TEST_FILE_OFFSET 12345U
+#define SOCKET_TEST_LARGE 0x80000U
+#define SOCKET_TEST_WAIT_MSEC 5000U
+
+typedef struct
+{
+	qsc_mutex mtx;
+	size_t accepted;
+	size_t closed;
+	size_t received;
+	size_t ticks;
+} socket_test_reactor_state;
+
+typedef struct
+{
+	const qsc_socket* sock;
+	uint8_t* output;
+	size_t length;
+	size_t received;
+} socket_test_receiver_state;
+
+static socket_test_reactor_state m_socket_reactor_state;
+static qsc_socket_reactor m_socket_reactor;
+
+static void socket_test_reactor_count(size_t* counter, size_t value)
+{
+	qsc_async_mutex_lock(m_socket_reactor_state.mtx);
+	*counter += value;
+	qsc_async_mutex_unlock(m_socket_reactor_state.mtx);
+}
+
+static size_t socket_test_reactor_read(const size_t* counter)
+{
+	size_t res;
+
+	qsc_async_mutex_lock(m_socket_reactor_state.mtx);
+	res = *counter;
+	qsc_async_mutex_unlock(m_socket_reactor_state.mtx);
+
+	return res;
+}
+
+static bool socket_test_reactor_wait(const size_t* counter, size_t expected)
+{
+	size_t msec;
+
+	msec = 0U;
+
+	/* the callbacks run on the reactor threads, poll the counter until it reaches the expected value */
+	while (socket_test_reactor_read(counter) < expected && msec < SOCKET_TEST_WAIT_MSEC)
+	{
+		qsc_async_thread_sleep(10U);
+		msec += 10U;
+	}
+
+	return (socket_test_reactor_read(counter) == expected);
+}
+
+static void socket_test_reactor_accept(qsc_socket_server_accept_result* result)
+{
+	(void)result;
+	socket_test_reactor_count(&m_socket_reactor_state.accepted, 1U);
+}
+
+static void socket_test_reactor_receive(qsc_socket* sock, const uint8_t* message, size_t* msglen)
+{
+	size_t slen;
+
+	socket_test_reactor_count(&m_socket_reactor_state.received, *msglen);
+	slen = 0U;
+
+	/* the reactor socket is non-blocking, retry a partial send */
+	while (slen < *msglen)
+	{
+		size_t plen;
+
+		plen = qsc_socket_send(sock, message + slen, *msglen - slen, qsc_socket_send_flag_none);
+
+		if (plen == 0U)
+		{
+			break;
+		}
+
+		slen += plen;
+	}
+}
+
+static void socket_test_reactor_error(const qsc_socket* sock, qsc_socket_exceptions error)
+{
+	(void)sock;
+
+	if (error == qsc_socket_exception_shut_down)
+	{
+		socket_test_reactor_count(&m_socket_reactor_state.closed, 1U);
+	}
+}
+
+static void socket_test_reactor_timer(void* context)
+{
+	(void)context;
+	socket_test_reactor_count(&m_socket_reactor_state.ticks, 1U);
+}
+
+static bool socket_test_connect(qsc_socket* srv, qsc_socket* clt, qsc_socket* acc, uint16_t port)
+{
+	qsc_ipinfo_ipv4_address addr;
+	bool res;
+
+	addr = qsc_ipinfo_ipv4_address_loopback();
+	qsc_socket_server_initialize(srv);
+	qsc_socket_server_initialize(acc);
+	qsc_socket_client_initialize(clt);
+
+	res = (qsc_socket_create(srv, qsc_socket_address_family_ipv4, qsc_socket_transport_stream, qsc_socket_protocol_tcp) == qsc_socket_exception_success &&
+		qsc_socket_bind_ipv4(srv, &addr, port) == qsc_socket_exception_success &&
+		qsc_socket_listen(srv, 4) == qsc_socket_exception_success &&
+		qsc_socket_client_connect_ipv4(clt, &addr, port) == qsc_socket_exception_success &&
+		qsc_socket_accept(srv, acc) == qsc_socket_exception_success);
+
+	if (res == false)
+	{
+		qsctest_print_line("socket test: the loopback connection could not be established.");
+	}
+
+	return res;
+}
+
+static void socket_test_close(qsc_socket* srv, qsc_socket* clt, qsc_socket* acc)
+{
+	qsc_socket_client_shut_down(clt);
+	qsc_socket_server_shut_down(acc);
+	qsc_socket_close_socket(srv);
+}
+
+static void socket_test_receiver(void* state)
+{
+	socket_test_receiver_state* prcv;
+
+	prcv = (socket_test_receiver_state*)state;
+	prcv->received = qsc_socket_receive_all(prcv->sock, prcv->output, prcv->length, qsc_socket_receive_flag_none);
+}
+
+bool qsctest_socket_reactor_test()
+{
+	qsc_socket clts[SOCKET_TEST_CLIENTS];
+	uint8_t msg[SOCKET_TEST_MESSAGE] = { 0U };
+	uint8_t otp[SOCKET_TEST_MESSAGE] = { 0U };
+	qsc_ipinfo_ipv4_address addr;
+	bool res;
+
+	res = false;
+	qsc_memutils_clear(&m_socket_reactor_state, sizeof(m_socket_reactor_state));
+	m_socket_reactor_state.mtx = qsc_async_mutex_create();
+	addr = qsc_ipinfo_ipv4_address_loopback();
+	qsc_csp_generate(msg, sizeof(msg));
+
+	for (size_t i = 0U; i < SOCKET_TEST_CLIENTS; ++i)
+	{
+		qsc_socket_client_initialize(&clts[i]);
+	}
+
+	qsc_socket_reactor_initialize(&m_socket_reactor, &socket_test_reactor_accept, &socket_test_reactor_receive, &socket_test_reactor_error);
+	qsc_socket_reactor_add_timer(&m_socket_reactor, 10U, &socket_test_reactor_timer, NULL);
+
+	if (qsc_socket_reactor_start(&m_socket_reactor, "127.0.0.1", SOCKET_TEST_REACTOR_PORT, qsc_socket_address_family_ipv4, 2U) == qsc_socket_exception_success)
+	{
+		res = true;
+
+		for (size_t i = 0U; i < SOCKET_TEST_CLIENTS; ++i)
+		{
+			if (qsc_socket_client_connect_ipv4(&clts[i], &addr, SOCKET_TEST_REACTOR_PORT) != qsc_socket_exception_success)
+			{
+				qsctest_print_line("socket reactor test: a client could not connect to the reactor.");
+				res = false;
+			}
+		}
+
+		/* each client sends a message and reads back the echo from the receive callback */
+		for (size_t i = 0U; i < SOCKET_TEST_CLIENTS && res == true; ++i)
+		{
+			msg[0U] = (uint8_t)i;
+			qsc_memutils_clear(otp, sizeof(otp));
+
+			if (qsc_socket_send_all(&clts[i], msg, sizeof(msg), qsc_socket_send_flag_none) != sizeof(msg) ||
+				qsc_socket_receive_all(&clts[i], otp, sizeof(otp), qsc_socket_receive_flag_none) != sizeof(otp) ||
+				qsc_intutils_are_equal8(otp, msg, sizeof(msg)) == false)
+			{
+				qsctest_print_line("socket reactor test: the echoed message does not match the sent message.");
+				res = false;
+			}
+		}
+
+		if (res == true && (socket_test_reactor_wait(&m_socket_reactor_state.accepted, SOCKET_TEST_CLIENTS) == false ||
+			socket_test_reactor_read(&m_socket_reactor_state.received) != SOCKET_TEST_CLIENTS * SOCKET_TEST_MESSAGE))
+		{
+			qsctest_print_line("socket reactor test: the accept or receive callback counts are invalid.");
+			res = false;
+		}
+
+		/* disconnect half of the clients, the reactor must release each connection */
+		for (size_t i = 0U; i < SOCKET_TEST_CLIENTS / 2U; ++i)
+		{
+			qsc_socket_client_shut_down(&clts[i]);
+		}
+
+		if (res == true && socket_test_reactor_wait(&m_socket_reactor_state.closed, SOCKET_TEST_CLIENTS / 2U) == false)
+		{
+			qsctest_print_line("socket reactor test: a client disconnection was not reported.");
+			res = false;
+		}
+
+		/* allow several timer intervals to elapse */
+		qsc_async_thread_sleep(50U);
+
+		if (res == true && socket_test_reactor_read(&m_socket_reactor_state.ticks) == 0U)
+		{
+			qsctest_print_line("socket reactor test: the reactor timer was not dispatched.");
+			res = false;
+		}
+
+		/* stopping the reactor releases the remaining connections and the event loops */
+		qsc_socket_reactor_stop(&m_socket_reactor);
+
+		if (res == true && (socket_test_reactor_read(&m_socket_reactor_state.closed) != SOCKET_TEST_CLIENTS ||
+			m_socket_reactor.lcount != 0U || m_socket_reactor.running == true))
+		{
+			qsctest_print_line("socket reactor test: the reactor did not release its connections when stopped.");
+			res = false;
+		}
+	}
+	else
+	{
+		qsctest_print_line("socket reactor test: the reactor could not be started.");
+	}
+
+	for (size_t i = SOCKET_TEST_CLIENTS / 2U; i < SOCKET_TEST_CLIENTS; ++i)
+	{
+		qsc_socket_client_shut_down(&clts[i]);
+	}
+
+	qsc_async_mutex_destroy(m_socket_reactor_state.mtx);
+
+	return res;
+}
+
+bool qsctest_socket_vector_test()
+{
+	uint8_t hdr[4U] = { 0U };
+	uint8_t mac[16U] = { 0U };
+	uint8_t rhdr[4U] = { 0U };
+	uint8_t rmac[16U] = { 0U };
+	qsc_socket_vector rvec[3U];
+	qsc_socket_vector svec[4U];
+	socket_test_receiver_state rcv;
+	qsc_socket acc;
+	qsc_socket clt;
+	qsc_socket srv;
+	qsc_thread thd;
+	uint8_t* msg;
+	uint8_t* otp;
+	size_t rlen;
+	bool res;
+
+	res = false;
+	msg = (uint8_t*)qsc_memutils_malloc(SOCKET_TEST_LARGE);
+	otp = (uint8_t*)qsc_memutils_malloc(SOCKET_TEST_LARGE);
+
+	if (msg != NULL && otp != NULL)
+	{
+		qsc_csp_generate(hdr, sizeof(hdr));
+		qsc_csp_generate(mac, sizeof(mac));
+		qsc_csp_generate(msg, SOCKET_TEST_LARGE);
+		qsc_memutils_clear(otp, SOCKET_TEST_LARGE);
+
+		if (socket_test_connect(&srv, &clt, &acc, SOCKET_TEST_VECTOR_PORT) == true)
+		{
+			res = true;
+
+			/* gather a header, a body, and a mac code into one send, and scatter them into three buffers */
+			svec[0U].buffer = hdr;
+			svec[0U].length = sizeof(hdr);
+			svec[1U].buffer = msg;
+			svec[1U].length = 1000U;
+			svec[2U].buffer = mac;
+			svec[2U].length = sizeof(mac);
+			rvec[0U].buffer = rhdr;
+			rvec[0U].length = sizeof(rhdr);
+			rvec[1U].buffer = otp;
+			rvec[1U].length = 1000U;
+			rvec[2U].buffer = rmac;
+			rvec[2U].length = sizeof(rmac);
+
+			if (qsc_socket_send_vector(&clt, svec, 3U, qsc_socket_send_flag_none) != sizeof(hdr) + 1000U + sizeof(mac))
+			{
+				qsctest_print_line("socket vector test: the gathered send is incomplete.");
+				res = false;
+			}
+
+			rlen = qsc_socket_receive_vector(&acc, rvec, 3U, qsc_socket_receive_flag_none);
+
+			if (rlen != sizeof(hdr) + 1000U + sizeof(mac) || qsc_intutils_are_equal8(rhdr, hdr, sizeof(hdr)) == false ||
+				qsc_intutils_are_equal8(otp, msg, 1000U) == false || qsc_intutils_are_equal8(rmac, mac, sizeof(mac)) == false)
+			{
+				qsctest_print_line("socket vector test: the scattered receive does not match the gathered send.");
+				res = false;
+			}
+
+			/* send a message larger than the socket buffers, including an empty segment, while a thread receives it */
+			qsc_memutils_clear(otp, SOCKET_TEST_LARGE);
+			svec[0U].buffer = msg;
+			svec[0U].length = 1U;
+			svec[1U].buffer = msg + 1U;
+			svec[1U].length = 0U;
+			svec[2U].buffer = msg + 1U;
+			svec[2U].length = (SOCKET_TEST_LARGE / 2U) - 1U;
+			svec[3U].buffer = msg + (SOCKET_TEST_LARGE / 2U);
+			svec[3U].length = SOCKET_TEST_LARGE / 2U;
+			rcv.sock = &acc;
+			rcv.output = otp;
+			rcv.length = SOCKET_TEST_LARGE;
+			rcv.received = 0U;
+			thd = qsc_async_thread_create(&socket_test_receiver, &rcv);
+
+			if (qsc_socket_send_vector_all(&clt, svec, 4U, qsc_socket_send_flag_none) != SOCKET_TEST_LARGE)
+			{
+				qsctest_print_line("socket vector test: the vectored send of a large message is incomplete.");
+				res = false;
+			}
+
+			qsc_async_thread_wait(thd);
+
+			if (rcv.received != SOCKET_TEST_LARGE || qsc_intutils_are_equal8(otp, msg, SOCKET_TEST_LARGE) == false)
+			{
+				qsctest_print_line("socket vector test: the received large message does not match the vectored send.");
+				res = false;
+			}
+		}
+
+		socket_test_close(&srv, &clt, &acc);
+	}
+
+	if (msg != NULL)
+	{
+		qsc_memutils_alloc_free(msg);
+	}
+
+	if (otp != NULL)
+	{
+		qsc_memutils_alloc_free(otp);
+	}
+
+	return res;
+}
+
+bool qsctest_socket_datagram_batch_test()
+{
+	uint8_t msg[SOCKET_TEST_DATAGRAMS * 100U] = { 0U };
+	uint8_t otp[SOCKET_TEST_DATAGRAMS][200U] = { 0U };
+	qsc_socket_vector rdgm[SOCKET_TEST_DATAGRAMS];
+	qsc_socket_vector sdgm[SOCKET_TEST_DATAGRAMS];
+	qsc_ipinfo_ipv4_address addr;
+	qsc_socket rcvr;
+	qsc_socket sndr;
+	size_t rcnt;
+	bool res;
+
+	res = false;
+	addr = qsc_ipinfo_ipv4_address_loopback();
+	qsc_socket_client_initialize(&sndr);
+	qsc_socket_server_initialize(&rcvr);
+	qsc_csp_generate(msg, sizeof(msg));
+
+	/* datagrams of distinct lengths, so a reordered or truncated datagram is detected */
+	for (size_t i = 0U; i < SOCKET_TEST_DATAGRAMS; ++i)
+	{
+		sdgm[i].buffer = msg + (i * 100U);
+		sdgm[i].length = 50U + i;
+		rdgm[i].buffer = otp[i];
+		rdgm[i].length = sizeof(otp[i]);
+	}
+
+	/* the sender is connected, so the batch is addressed to the receivers port */
+	if (qsc_socket_create(&rcvr, qsc_socket_address_family_ipv4, qsc_socket_transport_datagram, qsc_socket_protocol_udp) == qsc_socket_exception_success &&
+		qsc_socket_bind_ipv4(&rcvr, &addr, SOCKET_TEST_DATAGRAM_PORT) == qsc_socket_exception_success &&
+		qsc_socket_create(&sndr, qsc_socket_address_family_ipv4, qsc_socket_transport_datagram, qsc_socket_protocol_udp) == qsc_socket_exception_success &&
+		qsc_socket_connect_ipv4(&sndr, &addr, SOCKET_TEST_DATAGRAM_PORT) == qsc_socket_exception_success)
+	{
+		res = true;
+
+		if (qsc_socket_send_to_batch(&sndr, sdgm, SOCKET_TEST_DATAGRAMS, qsc_socket_send_flag_none) != SOCKET_TEST_DATAGRAMS)
+		{
+			qsctest_print_line("socket datagram test: the datagram batch was not sent.");
+			res = false;
+		}
+
+		rcnt = 0U;
+
+		/* a batch receive returns the datagrams already queued, repeat until all have arrived */
+		while (res == true && rcnt < SOCKET_TEST_DATAGRAMS)
+		{
+			size_t ncnt;
+
+			ncnt = qsc_socket_receive_batch(&rcvr, rdgm + rcnt, SOCKET_TEST_DATAGRAMS - rcnt, qsc_socket_receive_flag_none);
+
+			if (ncnt == 0U)
+			{
+				res = false;
+				break;
+			}
+
+			rcnt += ncnt;
+		}
+
+		for (size_t i = 0U; i < SOCKET_TEST_DATAGRAMS && res == true; ++i)
+		{
+			if (rdgm[i].length != sdgm[i].length || qsc_intutils_are_equal8(otp[i], sdgm[i].buffer, sdgm[i].length) == false)
+			{
+				res = false;
+			}
+		}
+
+		if (res == false)
+		{
+			qsctest_print_line("socket datagram test: the received datagrams do not match the sent batch.");
+		}
+	}
+	else
+	{
+		qsctest_print_line("socket datagram test: the datagram sockets could not be created.");
+	}
+
+	qsc_socket_close_socket(&sndr);
+	qsc_socket_close_socket(&rcvr);
+
+	return res;
+}
+
+bool qsctest_socket_send_file_test()
+{
+	/* the remainder of the file from an offset, followed by a short region from the start of the file */
+	const size_t flen1 = SOCKET_TEST_FILE_SIZE - SOCKET_TEST_FILE_OFFSET;
+	const size_t flen2 = 100U;
+	socket_test_receiver_state rcv;
+	qsc_socket acc;
+	qsc_socket clt;
+	qsc_socket srv;
+	qsc_thread thd;
+	uint8_t* msg;
+	uint8_t* otp;
+	bool res;
+
+	res = false;
+	msg = (uint8_t*)qsc_memutils_malloc(SOCKET_TEST_FILE_SIZE);
+	otp = (uint8_t*)qsc_memutils_malloc(flen1 + flen2);
+
+	if (msg != NULL && otp != NULL)
+	{
+		qsc_csp_generate(msg, SOCKET_TEST_FILE_SIZE);
+		qsc_memutils_clear(otp, flen1 + flen2);
+
+		if (qsc_fileutils_copy_stream_to_file(SOCKET_TEST_FILE_PATH, (const char*)msg, SOCKET_TEST_FILE_SIZE) == true &&
+			socket_test_connect(&srv, &clt, &acc, SOCKET_TEST_FILE_PORT) == true)
+		{
+			res = true;
+			rcv.sock = &acc;
+			rcv.output = otp;
+			rcv.length = flen1 + flen2;
+			rcv.received = 0U;
+			thd = qsc_async_thread_create(&socket_test_receiver, &rcv);
+
+			if (qsc_socket_send_file(&clt, SOCKET_TEST_FILE_PATH, SOCKET_TEST_FILE_OFFSET, 0U) != flen1 ||
+				qsc_socket_send_file(&clt, SOCKET_TEST_FILE_PATH, 7U, flen2) != flen2)
+			{
+				qsctest_print_line("socket send file test: a file region was not completely sent.");
+				res = false;
+			}
+
+			qsc_async_thread_wait(thd);
+
+			if (rcv.received != flen1 + flen2 || qsc_intutils_are_equal8(otp, msg + SOCKET_TEST_FILE_OFFSET, flen1) == false ||
+				qsc_intutils_are_equal8(otp + flen1, msg + 7U, flen2) == false)
+			{
+				qsctest_print_line("socket send file test: the received data does not match the file regions.");
+				res = false;
+			}
+
+			/* an offset at the end of the file, or a missing file, sends nothing */
+			if (qsc_socket_send_file(&clt, SOCKET_TEST_FILE_PATH, SOCKET_TEST_FILE_SIZE, 0U) != 0U ||
+				qsc_socket_send_file(&clt, "socket_test_missing.tmp", 0U, 0U) != 0U)
+			{
+				qsctest_print_line("socket send file test: an invalid file region was sent.");
+				res = false;
+			}
+		}
+		else
+		{
+			qsctest_print_line("socket send file test: the test file could not be created.");
+		}
+
+		socket_test_close(&srv, &clt, &acc);
+		qsc_fileutils_delete(SOCKET_TEST_FILE_PATH);
+	}
+
+	if (msg != NULL)
+	{
+		qsc_memutils_alloc_free(msg);
+	}
+
+	if (otp != NULL)
+	{
+		qsc_memutils_alloc_free(otp);
+	}
+
+	return res;
+}
+
+void qsctest_socket_run()
+{
+	if (qsctest_socket_reactor_test() == true)
+	{
+		qsctest_print_line("Success! Passed the socket reactor loopback echo test.");
+	}
+	else
+	{
+		qsctest_print_line("Failure! Failed the socket reactor loopback echo test.");
+	}
+
+	if (qsctest_socket_vector_test() == true)
+	{
+		qsctest_print_line("Success! Passed the socket vectored send and receive tests.");
+	}
+	else
+	{
+		qsctest_print_line("Failure! Failed the socket vectored send and receive tests.");
+	}
+
+	if (qsctest_socket_datagram_batch_test() == true)
+	{
+		qsctest_print_line("Success! Passed the socket batched datagram tests.");
+	}
+	else
+	{
+		qsctest_print_line("Failure! Failed the socket batched datagram tests.");
+	}
+
+	if (qsctest_socket_send_file_test() == true)
+	{
+		qsctest_print_line("Success! Passed the socket send file tests.");
+	}
+	else
+	{
+		qsctest_print_line("Failure! Failed the socket send file tests.");
+	}
+}
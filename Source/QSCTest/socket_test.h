@@ -0,0 +1,111 @@
+/* 2025 Quantum Resistant Cryptographic Solutions Corporation
+ * All Rights Reserved.
+ *
+ * NOTICE: This software and all accompanying materials are the exclusive 
+ * property of Quantum Resistant Cryptographic Solutions Corporation (QRCS).
+ * The intellectual and technical concepts contained within this implementation 
+ * are proprietary to QRCS and its authorized licensors and are protected under 
+ * applicable U.S. and international copyright, patent, and trade secret laws.
+ *
+ * CRYPTOGRAPHIC STANDARDS:
+ * - This software includes implementations of cryptographic algorithms such as 
+ *   SHA3, AES, and others. These algorithms are public domain or standardized 
+ *   by organizations such as NIST and are NOT the property of QRCS.
+ * - However, all source code, optimizations, and implementations in this library 
+ *   are original works of QRCS and are protected under this license.
+ *
+ * RESTRICTIONS:
+ * - Redistribution, modification, or unauthorized distribution of this software, 
+ *   in whole or in part, is strictly prohibited.
+ * - This software is provided for non-commercial, educational, and research 
+ *   purposes only. Commercial use in any form is expressly forbidden.
+ * - Licensing and authorized distribution are solely at the discretion of QRCS.
+ * - Any use of this software implies acceptance of these restrictions.
+ *
+ * DISCLAIMER:
+ * This software is provided "as is," without warranty of any kind, express or 
+ * implied, including but not limited to warranties of merchantability or fitness 
+ * for a particular purpose. QRCS disclaims all liability for any direct, indirect, 
+ * incidental, or consequential damages resulting from the use or misuse of this software.
+ *
+ * FULL LICENSE:
+ * This software is subject to the **Quantum Resistant Cryptographic Solutions 
+ * Proprietary License (QRCS-PL)**. The complete license terms are included 
+ * in the LICENSE.txt file distributed with this software.
+ *
+ * Written by: John G. Underhill
+ * Contact: john.underhill@protonmail.com
+ */
+
+#ifndef QSCTEST_SOCKET_TEST_H
+#define QSCTEST_SOCKET_TEST_H
+
+#include "../QSC/common.h"
+
+/**
+ * \file socket_test.h
+ * \brief Tests the socket reactor and the socket transfer functions over loopback connections.
+ *
+ * \details
+ * This file contains behavioural tests for the socket server functions in socketreactor.h,
+ * and the vectored, batched datagram, and file transfer functions in socketbase.h.
+ * The tests bind to the IPv4 loopback address on fixed test ports, and close every socket they open when they complete.
+ * The file transfer test creates a temporary file in the working directory and deletes it when it completes.
+ */
+
+/**
+ * \brief Tests the socket reactor with a loopback echo server.
+ *
+ * \details
+ * Starts a reactor with two event loops and a periodic timer, connects a set of clients, and echoes a message from each client
+ * through the receive callback. Half of the clients then disconnect, and the error callback must report each closed connection.
+ * The reactor is stopped with the remaining clients still connected; it must report those connections as closed,
+ * and leave no event loops running.
+ *
+ * \return Returns true if every message is echoed and every connection is accepted and released; otherwise, false.
+ */
+bool qsctest_socket_reactor_test(void);
+
+/**
+ * \brief Tests the vectored send and receive functions.
+ *
+ * \details
+ * Sends a header, a body, and a MAC code with qsc_socket_send_vector and receives them into three separate buffers
+ * with qsc_socket_receive_vector. A message larger than the socket buffers, split into segments that include an empty segment,
+ * is then sent with qsc_socket_send_vector_all while a second thread receives it, and must arrive intact.
+ *
+ * \return Returns true if the received data matches the vectored sends; otherwise, false.
+ */
+bool qsctest_socket_vector_test(void);
+
+/**
+ * \brief Tests the batched datagram send and receive functions.
+ *
+ * \details
+ * Sends a batch of UDP datagrams of distinct lengths with qsc_socket_send_to_batch, receives them with qsc_socket_receive_batch,
+ * and checks that each datagram arrives with its original length and contents.
+ *
+ * \return Returns true if every datagram in the batch is received intact; otherwise, false.
+ */
+bool qsctest_socket_datagram_batch_test(void);
+
+/**
+ * \brief Tests the socket file transfer function.
+ *
+ * \details
+ * Sends the remainder of a file larger than the socket buffers from an offset, followed by a short region from the start of the file,
+ * with qsc_socket_send_file while a second thread receives them, and compares the received data with the file regions.
+ * An offset at the end of the file, and a file that does not exist, must send nothing.
+ *
+ * \return Returns true if the received data matches the file regions; otherwise, false.
+ */
+bool qsctest_socket_send_file_test(void);
+
+/**
+ * \brief Runs the socket tests.
+ *
+ * This function executes the socket reactor, vectored transfer, batched datagram, and file transfer tests and prints the outcome of each test to the console.
+ */
+void qsctest_socket_run(void);
+
+#endif